@@ -1222,6 +1222,7 @@ TRDP_ERR_T sizeWriteDatasetInTrafficStore (
             marshallConfig.pRefCon,
             pDataset->id,
             pTempSrcDataset,
+            TRDP_MAX_MD_DATA_SIZE,
             &datasetNetworkByteSize,
             &pDataset);
     if (err != TRDP_NO_ERR)
@@ -1242,9 +1243,10 @@ TRDP_ERR_T sizeWriteDatasetInTrafficStore (
 
     /* Get Host Byte order of Dataset Size(size of unmarshall dataset) by tau_unmarshallDs() */
     err = tau_unmarshallDs(
-            &marshallConfig.pRefCon,                /* pointer to user context */
+            marshallConfig.pRefCon,                 /* pointer to user context */
             pDataset->id,                           /* datasetId */
             pTempSrcDataset,                        /* source pointer to received original message */
+            TRDP_MAX_MD_DATA_SIZE,                  /* source Buffer Size */
             pTempDestDataset,                       /* destination pointer to a buffer for the treated message */
             pDatasetSize,                           /* destination Buffer Size */
             &pDataset);                         /* pointer to pointer of cached dataset */
@@ -3611,7 +3613,7 @@ void tau_ldRecvPdDs (
             /* unmarshalling */
             tau_ldLockTrafficStore();
             err = tau_unmarshall(
-                    &marshallConfig.pRefCon,                                            /* pointer to user context*/
+                    marshallConfig.pRefCon,                                            /* pointer to user context*/
                     pPDInfo->comId,                                                     /* comId */
                     pData,                                                              /* source pointer to received
                                                                                           original message */
@@ -18,6 +18,11 @@
  /*
  * $Id: tau_dnr.h 1977 2019-08-13 14:06:25Z s-bender $
  *
+ *      AG 2026-10-17: tau_uri2Addr: host part of the URI (TRDP_URI_HOST_T), the size cached
+ *      AG 2026-10-17: tau_uri2AddrAsync: host part of the URI (TRDP_URI_HOST_T), as queued
+ *      AG 2026-10-17: tau_uri2AddrAsync: TRDP_PARAM_ERR with standard DNS, which would block
+ *      AG 2026-10-17: tau_uri2AddrAsync: non-blocking resolution, batched TCN-DNS requests
+ *      AG 2026-10-17: Growable URI hash cache, entries invalidated per generation (topocount change)
  *      SB 2019-08-13: Ticket #268 Handling Redundancy Switchover of DNS/ECSP server
  *      SB 2019-02-11: Ticket #237: tau_initDnr: Parameter waitForDnr to reduce wait times added
  *      BL 2018-08-07: Ticket #183 tau_getOwnIds moved here
@@ -33,6 +38,7 @@
  */
 
 #include "trdp_types.h"
+#include "vos_thread.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,7 +52,10 @@ extern "C" {
 #define __cdecl
 #endif
 
-#define TAU_MAX_NO_CACHE_ENTRY      50u
+#define TAU_DNR_CACHE_START_SIZE    64u     /**< Initial no of cache slots, must be 2^n                          */
+#ifndef TAU_MAX_NO_CACHE_ENTRY
+#define TAU_MAX_NO_CACHE_ENTRY      512u    /**< Max. no of cached URIs (2^n), least recently used are replaced  */
+#endif
 
 /***********************************************************************************************************************
  * TYPEDEFS
@@ -68,13 +77,40 @@ typedef enum TRDP_DNR_OPTS {
 
 typedef struct tau_dnr_cache
 {
-    CHAR8           uri[TRDP_MAX_URI_HOST_LEN];
+    CHAR8           uri[TRDP_MAX_URI_HOST_LEN];     /**< empty for a free slot                      */
     TRDP_IP_ADDR_T  ipAddr;
     UINT32          etbTopoCnt;
     UINT32          opTrnTopoCnt;
+    UINT32          generation;                     /**< cache generation of ipAddr, 0 = outdated   */
+    UINT32          lastUse;                        /**< value of useCnt at last hit                */
     BOOL8           fixedEntry;
 } TAU_DNR_ENTRY_T;
 
+/**********************************************************************************************************************/
+/**    Callback for tau_uri2AddrAsync
+ *
+ *  @param[in]      pRefCon         user supplied context pointer
+ *  @param[in]      appHandle       application handle
+ *  @param[in]      pUri            URI asked for
+ *  @param[in]      ipAddr          resolved IP address, VOS_INADDR_ANY if not resolved
+ *  @param[in]      result          TRDP_NO_ERR, TRDP_UNRESOLVED_ERR or error of the TCN-DNS request
+ *
+ */
+typedef void (*TAU_DNR_CALLBACK_T)(
+    void                *pRefCon,
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pUri,
+    TRDP_IP_ADDR_T      ipAddr,
+    TRDP_ERR_T          result);
+
+typedef struct tau_dnr_pending
+{
+    struct tau_dnr_pending  *pNext;
+    TRDP_URI_HOST_T         uri;
+    TAU_DNR_CALLBACK_T      pfCbFunction;
+    void                    *pRefCon;
+} TAU_DNR_PENDING_T;
+
 typedef struct tau_dnr_data
 {
     TRDP_IP_ADDR_T  dnsIpAddr;                      /**< IP address of the resolver                 */
@@ -82,7 +118,16 @@ typedef struct tau_dnr_data
     UINT8           timeout;                        /**< timeout for requests (in seconds)          */
     TRDP_DNR_OPTS_T useTCN_DNS;                     /**< how to use TCN DNR                         */
     UINT32          noOfCachedEntries;              /**< no of items currently in the cache         */
-    TAU_DNR_ENTRY_T cache[TAU_MAX_NO_CACHE_ENTRY];  /**< if != 0 use TCN DNS as resolver            */
+    UINT32          cacheSize;                      /**< no of slots (2^n), at most half are used   */
+    UINT32          generation;                     /**< incremented on each topocount change       */
+    UINT32          etbTopoCnt;                     /**< topocounts of the current generation       */
+    UINT32          opTrnTopoCnt;
+    UINT32          useCnt;                         /**< lookup counter for replacement             */
+    VOS_MUTEX_T     mutex;                          /**< cache is updated from the MD callback      */
+    TAU_DNR_ENTRY_T *pCache;                        /**< hash table keyed on the URI                */
+    TAU_DNR_PENDING_T   *pQueued;                   /**< async lookups waiting for the next request */
+    TAU_DNR_PENDING_T   *pInFlight;                 /**< async lookups of the running request       */
+    TRDP_UUID_T         asyncSessionId;             /**< MD session of the running request          */
 } TAU_DNR_DATA_T;
     
 /***********************************************************************************************************************
@@ -113,6 +158,7 @@ EXT_DECL TRDP_ERR_T tau_initDnr (
 
 /**********************************************************************************************************************/
 /**    Release any resources allocated by DNR
+ *  Pending asynchronous lookups are dropped without calling their callback.
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
  *
@@ -159,7 +205,7 @@ EXT_DECL  TRDP_IP_ADDR_T tau_getOwnAddr (
  * 
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
  *  @param[out]     pAddr           Pointer to return the IP address
- *  @param[in]      pUri            Pointer to a URI or an IP Address string, NULL==own URI
+ *  @param[in]      pUri            Host part of a URI or an IP Address string, NULL==own URI
  *
  *  @retval         TRDP_NO_ERR     no error
  *  @retval         TRDP_PARAM_ERR  Parameter error
@@ -168,12 +214,37 @@ EXT_DECL  TRDP_IP_ADDR_T tau_getOwnAddr (
 EXT_DECL TRDP_ERR_T tau_uri2Addr (
     TRDP_APP_SESSION_T   appHandle,
     TRDP_IP_ADDR_T      *pAddr,
-    const TRDP_URI_T     pUri);
+    const TRDP_URI_HOST_T pUri);
 
 EXT_DECL TRDP_IP_ADDR_T tau_ipFromURI (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_URI_HOST_T     uri);
 
+/**********************************************************************************************************************/
+/**    Function to convert a URI to an IP address without blocking.
+ *  On a cache hit the callback is called before returning. Otherwise the URI is queued and all queued URIs are
+ *  asked in one TCN-DNS request; the callback is called from tlc_process()/tlm_process() when the reply arrives
+ *  or times out.
+ *  Only one request is outstanding at a time, URIs queued meanwhile are sent with the next one.
+ *  Standard DNS queries block, TRDP_DNR_STANDARD_DNS is not supported (use tau_uri2Addr()).
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[in]      pUri            Host part of a URI or an IP Address string, NULL==own URI
+ *  @param[in]      pfCbFunction    Callback receiving the result, called exactly once if TRDP_NO_ERR is returned
+ *  @param[in]      pRefCon         user supplied context pointer passed to the callback
+ *
+ *  @retval         TRDP_NO_ERR     resolved or queued
+ *  @retval         TRDP_PARAM_ERR  Parameter error or TRDP_DNR_STANDARD_DNS
+ *  @retval         TRDP_NOINIT_ERR DNR not initialised
+ *  @retval         TRDP_MEM_ERR    out of memory
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_uri2AddrAsync (
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_URI_HOST_T   pUri,
+    TAU_DNR_CALLBACK_T      pfCbFunction,
+    void                    *pRefCon);
+
 /**********************************************************************************************************************/
 /**    Function to convert an IP address to a URI.
  *  Receives an IP-Address and translates it into the host part of the corresponding URI.
@@ -20,6 +20,9 @@
  * $Id: tau_marshall.h 1916 2019-06-19 14:37:27Z bloehr $
  *
  *
+ *      AG 2026-10-17: Plans by default, tau_initMarshallPlans() replaced by tau_initMarshallInterpreted()
+ *      AG 2026-10-17: Marshalling context via pRefCon (mandatory), tau_deInitMarshall() added
+ *      AG 2026-10-17: tau_initMarshallPlans() added
  *      BL 2015-12-14: Ticket #33: source size check for marshalling
  */
 
@@ -63,7 +66,13 @@ extern "C" {
 
 /**********************************************************************************************************************/
 /**    Function to initialise the marshalling/unmarshalling.
- *
+ *    A marshalling context with sorted copies of the tables is created and returned via ppRefCon; the supplied
+ *    arrays are not modified. The context is not changed afterwards, the marshalling functions can be called for
+ *    it from several threads at the same time. Release it with tau_deInitMarshall().
+ *    Every dataset is compiled into a flat list of copy and byte swap operations, runs of fixed size elements
+ *    are fused into blocks. The marshalling functions run these plans and interpret the dataset only where a
+ *    plan does not apply (no memory for it, misaligned or too small buffers).
+ *    The marshalling functions return TRDP_PARAM_ERR if their pRefCon is NULL.
  *
  *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
  *  @param[in]      numComId         Number of datasets found in the configuration
@@ -84,6 +93,42 @@ EXT_DECL TRDP_ERR_T tau_initMarshall(
     UINT32 numDataSet,
     TRDP_DATASET_T         * pDataset[]);
 
+/**********************************************************************************************************************/
+/**    Function to initialise the marshalling/unmarshalling without compiled plans.
+ *    Like tau_initMarshall(), but the datasets are interpreted on every call. For targets where the memory
+ *    of the plans matters and to compare the plans with the interpreter.
+ *
+ *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
+ *  @param[in]      numComId         Number of datasets found in the configuration
+ *  @param[in]      pComIdDsIdMap    Pointer to an array of structures of type TRDP_DATASET_T
+ *  @param[in]      numDataSet       Number of datasets found in the configuration
+ *  @param[in]      pDataset         Pointer to an array of pointers to structures of type TRDP_DATASET_T
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_MEM_ERR     provided buffer to small
+ *  @retval         TRDP_PARAM_ERR   Parameter error
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_initMarshallInterpreted(
+    void * *ppRefCon,
+    UINT32 numComId,
+    TRDP_COMID_DSID_MAP_T  * pComIdDsIdMap,
+    UINT32 numDataSet,
+    TRDP_DATASET_T         * pDataset[]);
+
+/**********************************************************************************************************************/
+/**    Release a marshalling context.
+ *
+ *  @param[in]      pRefCon         Reference context returned by tau_initMarshall()
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  not a marshalling context
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_deInitMarshall(
+    void *pRefCon);
 
 
 /**********************************************************************************************************************/
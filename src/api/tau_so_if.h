@@ -17,6 +17,7 @@
  *
  * $Id: tau_so_if.h 2091 2019-10-15 08:48:18Z s-bender $
  *
+ *      AG 2026-10-17: tau_addServices(), tau_delServices(), service cache (tau_initSrvCache() etc.)
  */
 
 #ifndef TRDP_IF_SOA_H
@@ -48,6 +49,18 @@ EXT_DECL TRDP_ERR_T tau_updService (
     SRM_SERVICE_INFO_T  *pServiceToAdd,
     BOOL8               waitForCompletion);
 
+EXT_DECL TRDP_ERR_T tau_addServices (
+    TRDP_APP_SESSION_T  appHandle,
+    SRM_SERVICE_INFO_T  *pServicesToAdd,
+    UINT32              noOfServices,
+    BOOL8               waitForCompletion);
+
+EXT_DECL TRDP_ERR_T tau_delServices (
+    TRDP_APP_SESSION_T  appHandle,
+    SRM_SERVICE_INFO_T  *pServicesToRemove,
+    UINT32              noOfServices,
+    BOOL8               waitForCompletion);
+
 EXT_DECL TRDP_ERR_T tau_getServicesList (
     TRDP_APP_SESSION_T      appHandle,
     SRM_SERVICE_ENTRIES_T   * *ppServicesToAdd,
@@ -56,6 +69,24 @@ EXT_DECL TRDP_ERR_T tau_getServicesList (
 
 EXT_DECL void tau_freeServicesList (
     SRM_SERVICE_ENTRIES_T *pServicesListBuffer);
+
+EXT_DECL TRDP_ERR_T tau_initSrvCache (
+    TRDP_APP_SESSION_T appHandle);
+
+EXT_DECL void tau_deInitSrvCache (
+    TRDP_APP_SESSION_T appHandle);
+
+EXT_DECL TRDP_ERR_T tau_syncSrvCache (
+    TRDP_APP_SESSION_T appHandle);
+
+EXT_DECL TRDP_ERR_T tau_getCachedService (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              serviceId,
+    SRM_SERVICE_INFO_T  *pServiceInfo);
+
+EXT_DECL UINT32 tau_getSrvCacheVersion (
+    TRDP_APP_SESSION_T appHandle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,6 +20,7 @@
  * $Id: tau_tti.h 1916 2019-06-19 14:37:27Z bloehr $
  *
  *
+ *      AG 2026-10-17: tau_getFctInfo(), tau_getCstInfoVersion()
  *      BL 2019-05-15: Ticket #254 API of TTI to get OwnOpCstNo and OwnTrnCstNo
  *      BL 2018-08-07: Ticket #183 tau_getOwnIds moved here
  *      BL 2016-02-18: Ticket #7: Add train topology information support
@@ -301,11 +302,13 @@ EXT_DECL TRDP_ERR_T tau_getCstFctInfo (
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
  *  @param[out]     pVehInfo        Pointer to the vehicle info to be returned. 
- *  @param[in]      pVehLabel       Pointer to a vehicle label. NULL means own vehicle  if cstLabel refers to own consist.
+ *  @param[in]      pVehLabel       Pointer to a vehicle label. NULL means own vehicle  if cstLabel refers to own consist,
+ *                                  first vehicle otherwise.
  *  @param[in]      pCstLabel       Pointer to a consist label. NULL means own consist.
  *
  *  @retval         TRDP_NO_ERR     no error
- *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_PARAM_ERR  Parameter error or unknown vehicle
+ *  @retval         TRDP_NODATA_ERR Try again
  *
  */
 EXT_DECL TRDP_ERR_T tau_getVehInfo (
@@ -315,6 +318,29 @@ EXT_DECL TRDP_ERR_T tau_getVehInfo (
     const TRDP_LABEL_T      pCstLabel);
 
 
+/**********************************************************************************************************************/
+/**    Function to retrieve the information of a single function of a consist.
+ *
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[out]     pFctInfo        Pointer to the function info to be returned.
+ *  @param[in]      fctId           Function ID, used if pFctLabel is NULL.
+ *  @param[in]      pFctLabel       Pointer to a function label. NULL means search by fctId.
+ *  @param[in]      pCstLabel       Pointer to a consist label. NULL means own consist.
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  Parameter error or unknown function
+ *  @retval         TRDP_NODATA_ERR Try again
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_getFctInfo (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_FUNCTION_INFO_T   *pFctInfo,
+    UINT16                  fctId,
+    const TRDP_LABEL_T      pFctLabel,
+    const TRDP_LABEL_T      pCstLabel);
+
+
 /**********************************************************************************************************************/
 /**    Function to retrieve the consist information of a train's consist.
  *
@@ -405,6 +431,19 @@ EXT_DECL UINT8 tau_getOwnOpCstNo (
 EXT_DECL UINT8 tau_getOwnTrnCstNo (
     TRDP_APP_SESSION_T appHandle);
 
+/**********************************************************************************************************************/
+/** Get the version of the cached consist infos.
+ *  The version is incremented whenever a consist info is stored or dropped. Callers polling the consist infos may
+ *  compare it to the version seen last and skip re-reading unchanged data.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_init
+ *
+ *  @retval         version             current version of the consist infos
+ *                  0                   on error or if no consist info was received yet
+ */
+EXT_DECL UINT32 tau_getCstInfoVersion (
+    TRDP_APP_SESSION_T appHandle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,6 +19,7 @@
  /*
  * $Id: tau_xml.h 2171 2020-05-12 06:20:31Z artem-rudskyy $
  *
+ *      AG 2026-10-17: tau_calcArenaConfig() sizes a fixed footprint session from the telegram configuration
  *      AR 2020-05-08: Added attribute 'name' to event, method, field and instance structures used for service oriented interface
  *      SB 2020-01-27: Added parsing for dummyService flag to Service definitions and MD option for events
  *     CKH 2019-10-11: Ticket #2: TRDPXML: Support of mapped devices missing (XLS #64)
@@ -412,6 +413,22 @@ EXT_DECL void tau_freeTelegrams (
     UINT32                      numExchgPar,
     TRDP_EXCHG_PAR_T            *pExchgPar);
 
+/**********************************************************************************************************************/
+/**    Compute the arena sizes for tlc_presetArenaSession from the telegram configuration
+ *
+ *  @param[in]      numExchgPar       Number of telegram configurations in the array
+ *  @param[in]      pExchgPar         Pointer to array of telegram configurations
+ *  @param[out]     pArenaConfig      Computed sizes, the memory pointer is set to NULL
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_calcArenaConfig (
+    UINT32                      numExchgPar,
+    const TRDP_EXCHG_PAR_T      *pExchgPar,
+    TRDP_ARENA_CONFIG_T         *pArenaConfig);
+
 /**********************************************************************************************************************/
 /**    Function to read the TRDP device service definitions out of the XML configuration file.
  *  The user must release the memory for pServiceDefs (using vos_memFree)
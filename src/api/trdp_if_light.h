@@ -18,6 +18,10 @@
 * $Id: trdp_if_light.h 2221 2020-09-08 12:51:21Z bloehr $
 *
 *
+*      AG 2026-10-17: tlc_processEvents() and tlc_getPollHandle() for an event driven work loop
+*      AG 2026-10-17: tlc_presetArenaSession() and tlc_arenaSize() for fixed footprint sessions
+*      AG 2026-10-17: tlp_putBegin() and tlp_putCommit() for zero-copy writing of PD
+*      AG 2026-10-17: tlp_getRef() and tlp_releaseRef() for zero-copy reading of received PD
 *      BL 2020-09-08: Ticket #343 userStatus parameter size in tlm_reply and tlm_replyQuery
 *      BL 2020-08-05: tlc_freeBuffer() declaration removed, it was never defined!
 *      BL 2020-07-29: Ticket #286 tlm_reply() is missing a sourceURI parameter as defined in the standard
@@ -100,6 +104,13 @@ EXT_DECL TRDP_ERR_T tlc_presetIndexSession (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_IDX_TABLE_T    *pIndexTableSizes);
 
+EXT_DECL TRDP_ERR_T tlc_presetArenaSession (
+    TRDP_APP_SESSION_T          appHandle,
+    const TRDP_ARENA_CONFIG_T   *pArenaConfig);
+
+EXT_DECL UINT32 tlc_arenaSize (
+    const TRDP_ARENA_CONFIG_T *pArenaConfig);
+
 EXT_DECL TRDP_ERR_T tlc_closeSession (
     TRDP_APP_SESSION_T appHandle);
 
@@ -130,6 +141,14 @@ EXT_DECL TRDP_ERR_T tlc_process (
     TRDP_FDS_T          *pRfds,
     INT32               *pCount);
 
+EXT_DECL TRDP_ERR_T tlc_getPollHandle (
+    TRDP_APP_SESSION_T  appHandle,
+    SOCKET              *pDesc);
+
+EXT_DECL TRDP_ERR_T tlc_processEvents (
+    TRDP_APP_SESSION_T  appHandle,
+    const TRDP_TIME_T   *pMaxWait);
+
 EXT_DECL TRDP_IP_ADDR_T tlc_getOwnIpAddress (
     TRDP_APP_SESSION_T appHandle);
 
@@ -185,6 +204,17 @@ EXT_DECL TRDP_ERR_T tlp_put (
     const UINT8         *pData,
     UINT32              dataSize);
 
+EXT_DECL TRDP_ERR_T tlp_putBegin (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    UINT8               * *ppData,
+    UINT32              *pMaxSize);
+
+EXT_DECL TRDP_ERR_T tlp_putCommit (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    UINT32              dataSize);
+
 EXT_DECL TRDP_ERR_T tlp_putImmediate (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_PUB_T          pubHandle,
@@ -261,6 +291,17 @@ EXT_DECL TRDP_ERR_T tlp_get (
     UINT8               *pData,
     UINT32              *pDataSize);
 
+EXT_DECL TRDP_ERR_T tlp_getRef (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    TRDP_PD_INFO_T      *pPdInfo,
+    const UINT8         * *ppData,
+    UINT32              *pDataSize);
+
+EXT_DECL TRDP_ERR_T tlp_releaseRef (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle);
+
 #if MD_SUPPORT
 
 EXT_DECL TRDP_ERR_T tlm_process (
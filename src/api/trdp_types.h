@@ -15,6 +15,12 @@
  *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2015-2020. All rights reserved.
  */
 /*
+ *      AG 2026-10-17: shareTcp appended to TRDP_MD_CONFIG_T
+ *      AG 2026-10-17: TRDP_ARENA_CONFIG_T: separate publisher and subscriber sizes, full size sequence counter lists
+ *      AG 2026-10-17: numSeqCntEvict appended to TRDP_STATISTICS_T
+ *      AG 2026-10-17: TRDP_MD_TIMER_STATISTICS_T appended to TRDP_STATISTICS_T
+ *      AG 2026-10-17: TRDP_ARENA_CONFIG_T for fixed footprint sessions
+ *      AG 2026-10-17: TRDP_MEM_CLASS_STATISTICS_T appended to TRDP_STATISTICS_T
  *      BL 2020-07-10: Ticket #321 Move TRDP_TIMER_GRANULARITY to public API
  *      BL 2019-10-15: Ticket #282 Preset index table size and depth to prevent memory fragmentation
  *      BL 2019-08-23: Option flag added to detect default process config (needed for HL + cyclic thread)
@@ -420,6 +426,28 @@ typedef struct
     UINT32  usedBlockSize[VOS_MEM_NBLOCKSIZES];         /**< used memory blocks */
 } GNU_PACKED TRDP_MEM_STATISTICS_T;
 
+/** Structure containing memory statistics per block size (same order as TRDP_MEM_STATISTICS_T.blockSize). */
+typedef struct
+{
+    UINT32  used[VOS_MEM_NBLOCKSIZES];                  /**< blocks currently allocated */
+    UINT32  peak[VOS_MEM_NBLOCKSIZES];                  /**< max. blocks allocated at the same time */
+    UINT32  fallback[VOS_MEM_NBLOCKSIZES];              /**< requests served by a bigger block size */
+    UINT32  failed[VOS_MEM_NBLOCKSIZES];                /**< requests which could not be served */
+} GNU_PACKED TRDP_MEM_CLASS_STATISTICS_T;
+
+#define TRDP_MD_TIMER_LEVELS  4u                        /**< levels of the MD timer wheel (1ms, 64ms, 4s, 4min slots) */
+
+/** Structure containing the occupancy of the MD timer wheel and the list of armed MD sessions. */
+typedef struct
+{
+    UINT32  numTimers;                                  /**< MD sessions waiting for a timeout */
+    UINT32  maxTimers;                                  /**< max. MD sessions waiting at the same time */
+    UINT32  numPerLevel[TRDP_MD_TIMER_LEVELS];          /**< MD sessions waiting per level of the wheel */
+    UINT32  numReady;                                   /**< MD sessions armed for sending */
+    UINT32  numExpired;                                 /**< timeouts handed to the MD state machine */
+    UINT32  numCascaded;                                /**< timers moved down to a finer level */
+} GNU_PACKED TRDP_MD_TIMER_STATISTICS_T;
+
 
 /** Structure containing all general PD statistics information. */
 typedef struct
@@ -479,6 +507,9 @@ typedef struct
     TRDP_PD_STATISTICS_T    pd;           /**< pd statistics */
     TRDP_MD_STATISTICS_T    udpMd;        /**< UDP md statistics */
     TRDP_MD_STATISTICS_T    tcpMd;        /**< TCP md statistics */
+    TRDP_MEM_CLASS_STATISTICS_T memClass; /**< memory statistics per block size, appended to keep the layout above */
+    TRDP_MD_TIMER_STATISTICS_T  mdTimer;  /**< MD timer wheel occupancy */
+    UINT32                  numSeqCntEvict; /**< senders dropped from the full sequence counter table of a subscription */
 } GNU_PACKED TRDP_STATISTICS_T;
 
 /** Table containing particular PD subscription information. */
@@ -692,6 +723,8 @@ typedef struct
     UINT16              udpPort;                /**< Port to be used for UDP MD communication (default: 17225)  */
     UINT16              tcpPort;                /**< Port to be used for TCP MD communication (default: 17225)  */
     UINT32              maxNumSessions;         /**< Maximal number of replier sessions         */
+    BOOL8               shareTcp;               /**< Concurrent sender sessions to the same peer share one TCP
+                                                     connection (default: FALSE, one connection each)   */
 } TRDP_MD_CONFIG_T;
 
 
@@ -762,6 +795,22 @@ typedef struct
     UINT32  maxNoOfExtPublishers;               /**< Max. number of expected publishers with intervals > 10000ms    */
 } TRDP_IDX_TABLE_T;
 
+/** Sizes of the fixed footprint arena of a session (see tlc_presetArenaSession) */
+typedef struct
+{
+    UINT8   *p;                                 /**< pointer to static memory or NULL to allocate it                */
+    UINT32  size;                               /**< size of static memory (see tlc_arenaSize)                      */
+    UINT32  maxNoOfPublishers;                  /**< Max. number of publishers and PD requests                      */
+    UINT32  maxNoOfPubFrames;                   /**< Max. number of their frames: one per publisher or request,
+                                                     one more for each publisher using tlp_putBegin                 */
+    UINT32  maxNoOfSubscribers;                 /**< Max. number of subscribers                                     */
+    UINT32  maxNoOfSubFrames;                   /**< Max. number of their frames: one per subscriber, one more for
+                                                     each subscriber using tlp_getRef                               */
+    UINT32  maxNoOfSeqCntLists;                 /**< Max. number of subscriptions with received telegrams           */
+    UINT32  maxNoOfFullSeqCntLists;             /**< Max. number of subscriptions with more than 32 senders         */
+    UINT32  maxNoOfMdElements;                  /**< Max. number of concurrent MD sessions                          */
+} TRDP_ARENA_CONFIG_T;
+
 
 #ifdef __cplusplus
 }
@@ -17,6 +17,10 @@
  /*
  * $Id: tau_dnr.c 2181 2020-07-28 15:38:01Z bloehr $
  *
+ *      AG 2026-10-17: tau_uri2Addr: host part of the URI (TRDP_URI_HOST_T), the size cached
+ *      AG 2026-10-17: tau_uri2AddrAsync: host part of the URI (TRDP_URI_HOST_T), as queued
+ *      AG 2026-10-17: tau_uri2AddrAsync: TRDP_PARAM_ERR with standard DNS, which would block
+ *      AG 2026-10-17: Growable URI hash cache, lazy invalidation per generation, prefetch from TCN-DNS reply
 *       SB 2019-08-15: Moved TAU_MAX_NO_CACHE_ENTRY to header file
  *      SB 2019-08-13: Ticket #268 Handling Redundancy Switchover of DNS/ECSP server
  *      SB 2019-03-01: Ticket #237: tau_initDnr: Fixed comparison of readHostFile return value
@@ -225,22 +229,225 @@ static void changetoDnsNameFormat (UINT8 *pDns, CHAR8 *pHost)
 
 static int compareURI ( const void *arg1, const void *arg2 )
 {
-    return vos_strnicmp((const CHAR8 *)arg1, (const CHAR8 *)arg2, TRDP_MAX_URI_HOST_LEN);
+    return vos_strnicmp((const CHAR8 *)arg1, (const CHAR8 *)arg2, TRDP_MAX_URI_HOST_LEN - 1u);
 }
 
 static void printDNRcache (TAU_DNR_DATA_T *pDNR)
 {
     UINT32 i;
-    for (i = 0u; i < pDNR->noOfCachedEntries; i++)
+    for (i = 0u; i < pDNR->cacheSize; i++)
     {
+        if (pDNR->pCache[i].uri[0] == '\0')
+        {
+            continue;
+        }
         vos_printLog(VOS_LOG_DBG, "%03u:\t%0u.%0u.%0u.%0u\t%s\t(topo: 0x%08x/0x%08x)\n", i,
-                     pDNR->cache[i].ipAddr >> 24u,
-                     (pDNR->cache[i].ipAddr >> 16u) & 0xFFu,
-                     (pDNR->cache[i].ipAddr >> 8u) & 0xFFu,
-                     pDNR->cache[i].ipAddr & 0xFFu,
-                     pDNR->cache[i].uri,
-                     pDNR->cache[i].etbTopoCnt,
-                     pDNR->cache[i].opTrnTopoCnt);
+                     pDNR->pCache[i].ipAddr >> 24u,
+                     (pDNR->pCache[i].ipAddr >> 16u) & 0xFFu,
+                     (pDNR->pCache[i].ipAddr >> 8u) & 0xFFu,
+                     pDNR->pCache[i].ipAddr & 0xFFu,
+                     pDNR->pCache[i].uri,
+                     pDNR->pCache[i].etbTopoCnt,
+                     pDNR->pCache[i].opTrnTopoCnt);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Compute the home slot of an URI, case is ignored as in compareURI
+ *
+ *  @param[in]      pUri            URI host part
+ *  @param[in]      mask            cache size - 1
+ *
+ *  @retval         slot index
+ */
+static UINT32 cacheSlot (
+    const CHAR8 *pUri,
+    UINT32      mask)
+{
+    UINT32  hash = 2166136261u;                     /* FNV-1a */
+    UINT32  i;
+
+    for (i = 0u; (i < (TRDP_MAX_URI_HOST_LEN - 1u)) && (pUri[i] != '\0'); i++)
+    {
+        hash = (hash ^ (UINT32) tolower((unsigned char) pUri[i])) * 16777619u;
+    }
+    return (hash ^ (hash >> 16u)) & mask;
+}
+
+/**********************************************************************************************************************/
+/**    Find the slot of an URI, or the free slot ending its probe sequence
+ *
+ *  @param[in]      pDNR            DNR context
+ *  @param[in]      pUri            URI host part
+ *
+ *  @retval         slot index
+ */
+static UINT32 cacheFind (
+    const TAU_DNR_DATA_T    *pDNR,
+    const CHAR8             *pUri)
+{
+    UINT32  mask    = pDNR->cacheSize - 1u;
+    UINT32  idx     = cacheSlot(pUri, mask);
+
+    while ((pDNR->pCache[idx].uri[0] != '\0') && (compareURI(pDNR->pCache[idx].uri, pUri) != 0))
+    {
+        idx = (idx + 1u) & mask;
+    }
+    return idx;
+}
+
+/**********************************************************************************************************************/
+/**    Remove the least recently used entry, following entries of the cluster are moved back (no tombstones).
+ *  Entries from the hosts file are kept.
+ *
+ *  @param[in]      pDNR            DNR context
+ *
+ *  @retval         TRUE            an entry was removed
+ *  @retval         FALSE           all entries are fixed
+ */
+static BOOL8 cacheEvict (
+    TAU_DNR_DATA_T *pDNR)
+{
+    UINT32  mask    = pDNR->cacheSize - 1u;
+    UINT32  idx     = pDNR->cacheSize;
+    UINT32  oldest  = 0u;
+    UINT32  next;
+
+    for (next = 0u; next <= mask; next++)
+    {
+        if ((pDNR->pCache[next].uri[0] != '\0') &&
+            (pDNR->pCache[next].fixedEntry == FALSE) &&
+            ((pDNR->useCnt - pDNR->pCache[next].lastUse) >= oldest))
+        {
+            oldest  = pDNR->useCnt - pDNR->pCache[next].lastUse;
+            idx     = next;
+        }
+    }
+    if (idx > mask)
+    {
+        return FALSE;
+    }
+    vos_printLog(VOS_LOG_DBG, "DNR cache full, %s replaced\n", pDNR->pCache[idx].uri);
+
+    for (next = (idx + 1u) & mask; pDNR->pCache[next].uri[0] != '\0'; next = (next + 1u) & mask)
+    {
+        UINT32 home = cacheSlot(pDNR->pCache[next].uri, mask);
+
+        /* Move the entry into the gap if its home slot is not between the gap and its current position */
+        if (((next - home) & mask) >= ((next - idx) & mask))
+        {
+            pDNR->pCache[idx]   = pDNR->pCache[next];
+            idx                 = next;
+        }
+    }
+    memset(&pDNR->pCache[idx], 0, sizeof(TAU_DNR_ENTRY_T));
+    pDNR->noOfCachedEntries--;
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/**    Double the number of cache slots
+ *
+ *  @param[in]      pDNR            DNR context
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T cacheGrow (
+    TAU_DNR_DATA_T *pDNR)
+{
+    TAU_DNR_ENTRY_T *pOld       = pDNR->pCache;
+    UINT32          oldSize     = pDNR->cacheSize;
+    TAU_DNR_ENTRY_T *pNew;
+    UINT32          idx;
+
+    pNew = (TAU_DNR_ENTRY_T *) vos_memAlloc(2u * oldSize * sizeof(TAU_DNR_ENTRY_T));
+    if (pNew == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pDNR->pCache    = pNew;
+    pDNR->cacheSize = 2u * oldSize;
+    for (idx = 0u; idx < oldSize; idx++)
+    {
+        if (pOld[idx].uri[0] != '\0')
+        {
+            pNew[cacheFind(pDNR, pOld[idx].uri)] = pOld[idx];
+        }
+    }
+    vos_memFree(pOld);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Get the cache entry of an URI, add an unresolved one if it is not cached yet.
+ *  Entry pointers are valid until the next call only, the cache might grow.
+ *
+ *  @param[in]      pDNR            DNR context
+ *  @param[in]      pUri            URI host part
+ *
+ *  @retval         pointer to the entry, NULL if the cache is full
+ */
+static TAU_DNR_ENTRY_T *cacheGet (
+    TAU_DNR_DATA_T  *pDNR,
+    const CHAR8     *pUri)
+{
+    UINT32 idx = cacheFind(pDNR, pUri);
+
+    if (pDNR->pCache[idx].uri[0] != '\0')
+    {
+        return &pDNR->pCache[idx];
+    }
+
+    /* Keep the table at most half full */
+    if (2u * (pDNR->noOfCachedEntries + 1u) > pDNR->cacheSize)
+    {
+        if (pDNR->noOfCachedEntries < TAU_MAX_NO_CACHE_ENTRY)
+        {
+            if (cacheGrow(pDNR) != TRDP_NO_ERR)
+            {
+                vos_printLogStr(VOS_LOG_ERROR, "DNR cache could not grow\n");
+                return NULL;
+            }
+        }
+        else if (cacheEvict(pDNR) == FALSE)
+        {
+            return NULL;
+        }
+        idx = cacheFind(pDNR, pUri);
+    }
+    vos_strncpy(pDNR->pCache[idx].uri, pUri, TRDP_MAX_URI_HOST_LEN - 1u);
+    pDNR->pCache[idx].ipAddr        = VOS_INADDR_ANY;
+    pDNR->pCache[idx].etbTopoCnt    = 0u;
+    pDNR->pCache[idx].opTrnTopoCnt  = 0u;
+    pDNR->pCache[idx].generation    = 0u;
+    pDNR->pCache[idx].lastUse       = pDNR->useCnt;
+    pDNR->pCache[idx].fixedEntry    = FALSE;
+    pDNR->noOfCachedEntries++;
+    return &pDNR->pCache[idx];
+}
+
+/**********************************************************************************************************************/
+/**    Start a new cache generation if the topocounts changed. Entries are not touched, they are outdated lazily
+ *  by their generation.
+ *
+ *  @param[in]      appHandle       Session context
+ *  @param[in]      pDNR            DNR context
+ */
+static void cacheSyncGeneration (
+    TRDP_APP_SESSION_T  appHandle,
+    TAU_DNR_DATA_T      *pDNR)
+{
+    if ((pDNR->etbTopoCnt != appHandle->etbTopoCnt) ||
+        (pDNR->opTrnTopoCnt != appHandle->opTrnTopoCnt))
+    {
+        pDNR->etbTopoCnt    = appHandle->etbTopoCnt;
+        pDNR->opTrnTopoCnt  = appHandle->opTrnTopoCnt;
+        pDNR->generation++;
+        if (pDNR->generation == 0u)
+        {
+            pDNR->generation = 1u;                  /* 0 marks outdated entries */
+        }
     }
 }
 
@@ -271,9 +478,12 @@ static TRDP_ERR_T readHostsFile (
             /* get a line from the file */
             if (fgets(line, TAU_MAX_HOSTS_LINE_LENGTH, fp) != NULL)
             {
-                UINT32  start       = 0u;
-                UINT32  l_index       = 0u;
-                UINT32  maxIndex    = (UINT32) strlen(line);
+                UINT32          start       = 0u;
+                UINT32          l_index     = 0u;
+                UINT32          maxIndex    = (UINT32) strlen(line);
+                TRDP_IP_ADDR_T  ipAddr;
+                TRDP_URI_HOST_T uri;
+                TAU_DNR_ENTRY_T *pEntry;
 
                 /* Skip empty lines, comment lines */
                 if (line[l_index] == '#' ||
@@ -284,9 +494,9 @@ static TRDP_ERR_T readHostsFile (
                 }
 
                 /* Try to get IP */
-                pDNR->cache[pDNR->noOfCachedEntries].ipAddr = vos_dottedIP(&line[l_index]);
+                ipAddr = vos_dottedIP(&line[l_index]);
 
-                if (pDNR->cache[pDNR->noOfCachedEntries].ipAddr == VOS_INADDR_ANY)
+                if (ipAddr == VOS_INADDR_ANY)
                 {
                     continue;
                 }
@@ -310,22 +520,25 @@ static TRDP_ERR_T readHostsFile (
                 {
                     l_index++;
                 }
-                if (l_index < maxIndex)
+                memset(uri, 0, sizeof(uri));
+                if ((l_index < maxIndex) && (l_index - start < TRDP_MAX_URI_HOST_LEN))
                 {
-                    vos_strncpy(pDNR->cache[pDNR->noOfCachedEntries].uri, &line[start], l_index - start);
+                    vos_strncpy(uri, &line[start], l_index - start);
                 }
-                /* increment only if entry is valid */
-                if (strlen(pDNR->cache[pDNR->noOfCachedEntries].uri) > 0u)
+                /* add only if entry is valid */
+                if (strlen(uri) > 0u)
                 {
-                    pDNR->cache[pDNR->noOfCachedEntries].etbTopoCnt     = 0u;
-                    pDNR->cache[pDNR->noOfCachedEntries].opTrnTopoCnt   = 0u;
-                    pDNR->cache[pDNR->noOfCachedEntries].fixedEntry     = TRUE;
-                    pDNR->noOfCachedEntries++;
+                    pEntry = cacheGet(pDNR, uri);
+                    if (pEntry == NULL)
+                    {
+                        break;
+                    }
+                    pEntry->ipAddr      = ipAddr;
+                    pEntry->fixedEntry  = TRUE;
                 }
             }
         }
         vos_printLog(VOS_LOG_DBG, "readHostsFile: %d entries processed\n", pDNR->noOfCachedEntries);
-        vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
         fclose(fp);
         printDNRcache(pDNR);
         err = TRDP_NO_ERR;
@@ -555,7 +768,6 @@ static void parseResponse (
 /**    Query the DNS server for the addresses
  *
  *  @param[in]      appHandle           Handle returned by tlc_openSession()
- *  @param[in]      pTemp               Last entry which was invalid, can be NULL
  *  @param[in]      pUri                Pointer to host name
  *
  *  @retval         TRDP_NO_ERR     no error
@@ -565,7 +777,6 @@ static void parseResponse (
  */
 static void updateDNSentry (
     TRDP_APP_SESSION_T  appHandle,
-    TAU_DNR_ENTRY_T     *pTemp,
     const CHAR8         *pUri)
 {
     SOCKET          my_socket;
@@ -632,41 +843,23 @@ static void updateDNSentry (
             /*  Get and convert response */
             parseResponse(packetBuffer, size, id, querySize, &ip_addr);
 
-            if ((pTemp != NULL) &&
-                (ip_addr != VOS_INADDR_ANY) &&
-                (pTemp->fixedEntry == FALSE))
+            if (ip_addr != VOS_INADDR_ANY)
             {
-                /* Overwrite outdated entry */
-                pTemp->ipAddr       = ip_addr;
-                pTemp->etbTopoCnt   = appHandle->etbTopoCnt;
-                pTemp->opTrnTopoCnt = appHandle->opTrnTopoCnt;
-                break;
-            }
-            else /* It's a new one, update our cache */
-            {
-                UINT32 cacheEntry = pDNR->noOfCachedEntries;
+                TAU_DNR_ENTRY_T *pTemp;
 
-                if (cacheEntry >= TAU_MAX_NO_CACHE_ENTRY)   /* Cache is full! */
-                {
-                    cacheEntry = 0u;                        /* Overwrite first */
-                    // tbd: cacheEntry = cacheGetOldest();
-                }
-                else
+                (void) vos_mutexLock(pDNR->mutex);
+                pTemp = cacheGet(pDNR, pUri);
+                if ((pTemp != NULL) && (pTemp->fixedEntry == FALSE))
                 {
-                    pDNR->noOfCachedEntries++;
+                    /* Overwrite outdated entry */
+                    pTemp->ipAddr       = ip_addr;
+                    pTemp->etbTopoCnt   = appHandle->etbTopoCnt;
+                    pTemp->opTrnTopoCnt = appHandle->opTrnTopoCnt;
+                    pTemp->generation   = pDNR->generation;
                 }
-
-                /* Position found, store everything */
-                vos_strncpy(pDNR->cache[cacheEntry].uri, pUri, TRDP_MAX_URI_HOST_LEN-1);
-                pDNR->cache[cacheEntry].ipAddr          = ip_addr;
-                pDNR->cache[cacheEntry].etbTopoCnt      = appHandle->etbTopoCnt;
-                pDNR->cache[cacheEntry].opTrnTopoCnt    = appHandle->opTrnTopoCnt;
-                pDNR->cache[cacheEntry].fixedEntry      = FALSE;
-
-                /* Sort the entries to get faster hits  */
-                vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
-                break;
+                (void) vos_mutexUnlock(pDNR->mutex);
             }
+            break;
         }
         else
         {
@@ -680,47 +873,89 @@ exit:
 }
 
 /**********************************************************************************************************************/
-/**    Build the request payload
+/**    Prepare the request header, no URIs listed
  *
- *  @param[in]      pDNR            Reference Context
- *  @param[in]      pRequest        Handle returned by tlc_openSession()
- *  @param[out]     pSize           Pointer to Message Info
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
+ *  @param[in]      pRequest        Request payload
  *
  */
-static void buildRequest (
+static void requestInit (
     TRDP_APP_SESSION_T  appHandle,
-    TAU_DNR_DATA_T      *pDNR,
-    TRDP_DNS_REQUEST_T  *pRequest,
-    UINT32              *pSize)
+    TRDP_DNS_REQUEST_T  *pRequest)
 {
-    UINT32  cacheEntry;
-
-    /* Prepare header */
     memset(pRequest, 0u, sizeof(TRDP_DNS_REQUEST_T));  /*  pRequest->tcnUriCnt = 0; */
     pRequest->version.ver = 1u;
     vos_strncpy(pRequest->deviceName, appHandle->stats.hostName, TRDP_MAX_LABEL_LEN-1);
-    pRequest->etbTopoCnt = appHandle->etbTopoCnt;
-    pRequest->opTrnTopoCnt = appHandle->opTrnTopoCnt;
+    pRequest->etbTopoCnt = vos_htonl(appHandle->etbTopoCnt);
+    pRequest->opTrnTopoCnt = vos_htonl(appHandle->opTrnTopoCnt);
     pRequest->etbId = 255u;            /* don't care */
+}
+
+/**********************************************************************************************************************/
+/**    Add an URI to the request, if it is not listed yet
+ *
+ *  @param[in]      pRequest        Request payload
+ *  @param[in]      pUri            URI to resolve
+ *
+ *  @retval         TRUE            URI is listed
+ *  @retval         FALSE           request is full
+ */
+static BOOL8 requestAddUri (
+    TRDP_DNS_REQUEST_T  *pRequest,
+    const CHAR8         *pUri)
+{
+    UINT32 i;
+
+    for (i = 0u; i < pRequest->tcnUriCnt; i++)
+    {
+        if (compareURI(pRequest->tcnUriList[i].tcnUriStr, pUri) == 0)
+        {
+            return TRUE;
+        }
+    }
+    if (pRequest->tcnUriCnt >= 255u)
+    {
+        return FALSE;
+    }
+    /* Make sure the string is not longer than 79 chars (+ trailing zero) */
+    vos_strncpy(pRequest->tcnUriList[pRequest->tcnUriCnt].tcnUriStr, pUri, TRDP_MAX_URI_HOST_LEN-1);
+    pRequest->tcnUriCnt++;
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/**    Build the request payload.
+ *  The asked URIs are listed already, the request is filled up with the outdated cache entries to prefetch them.
+ *
+ *  @param[in]      pDNR            Reference Context
+ *  @param[in]      pRequest        Request payload
+ *  @param[out]     pSize           Pointer to payload size
+ *
+ */
+static void buildRequest (
+    TAU_DNR_DATA_T      *pDNR,
+    TRDP_DNS_REQUEST_T  *pRequest,
+    UINT32              *pSize)
+{
+    UINT32          cacheEntry;
+    TAU_DNR_ENTRY_T *pEntry;
 
     /* Walk over the cache entries */
-    for (cacheEntry = 0u; (cacheEntry < pDNR->noOfCachedEntries) && (pRequest->tcnUriCnt < 255u); cacheEntry++)
+    for (cacheEntry = 0u; (cacheEntry < pDNR->cacheSize) && (pRequest->tcnUriCnt < 255u); cacheEntry++)
     {
-        /* Needs update? No, if it is a fixed entry (hostsfile) or it is a consist local adress */
-        if ((pDNR->cache[cacheEntry].fixedEntry == TRUE) ||
-            ((pDNR->cache[cacheEntry].ipAddr != 0u) &&
-             (pDNR->cache[cacheEntry].etbTopoCnt == 0u) && (pDNR->cache[cacheEntry].opTrnTopoCnt == 0u)))
+        pEntry = &pDNR->pCache[cacheEntry];
+
+        /* Needs update? No, if it is a free slot, a fixed entry (hostsfile) or a consist local adress */
+        if ((pEntry->uri[0] == '\0') ||
+            (pEntry->fixedEntry == TRUE) ||
+            ((pEntry->ipAddr != 0u) && (pEntry->etbTopoCnt == 0u) && (pEntry->opTrnTopoCnt == 0u)))
         {
             continue;
         }
-        /* Needs update? Only when there is no address or the topocounts do not match */
-        else if ((pDNR->cache[cacheEntry].ipAddr == 0u) ||
-            ((pDNR->cache[cacheEntry].etbTopoCnt != appHandle->etbTopoCnt) ||
-            (pDNR->cache[cacheEntry].opTrnTopoCnt != appHandle->opTrnTopoCnt)))
+        /* Needs update? Only when there is no address or it stems from an older generation */
+        else if ((pEntry->ipAddr == 0u) || (pEntry->generation != pDNR->generation))
         {
-            /* Make sure the string is not longer than 79 chars (+ trailing zero) */
-            vos_strncpy(pRequest->tcnUriList[pRequest->tcnUriCnt].tcnUriStr, pDNR->cache[cacheEntry].uri, TRDP_MAX_URI_HOST_LEN-1);
-            pRequest->tcnUriCnt++;
+            (void) requestAddUri(pRequest, pEntry->uri);
         }
     }
     /* tbd: add SDT trailer
@@ -731,49 +966,83 @@ static void buildRequest (
 }
 
 /**********************************************************************************************************************/
-/**    Add an entry to the DNS cache to be resolved
+/**    Look up a valid cache entry, the mutex must be held
  *
  *  @param[in]      appHandle       Session context
  *  @param[in]      pDNR            DNR context
- *  @param[in]      pURI            URI to add
- *
+ *  @param[in]      pUri            URI host part
+ *  @param[out]     pAddr           Pointer to return the IP address
  *
+ *  @retval         TRUE            address valid
+ *  @retval         FALSE           address is not known or out of date (topocounts differ)
  */
-static void addEntry (
+static BOOL8 cacheLookup (
     TRDP_APP_SESSION_T  appHandle,
     TAU_DNR_DATA_T      *pDNR,
-    const CHAR8         *pURI)
+    const CHAR8         *pUri,
+    TRDP_IP_ADDR_T      *pAddr)
 {
-    /* It's a new one, update our cache */
-    UINT32 cacheEntry = pDNR->noOfCachedEntries;
+    TAU_DNR_ENTRY_T *pTemp;
 
-    if (cacheEntry >= TAU_MAX_NO_CACHE_ENTRY)   /* Cache is full! */
-    {
-        cacheEntry = 0u;                        /* Overwrite first */
-        // tbd: cacheEntry = cacheGetOldest();
-    }
-    else
+    cacheSyncGeneration(appHandle, pDNR);
+    pDNR->useCnt++;
+    pTemp = &pDNR->pCache[cacheFind(pDNR, pUri)];
+    if ((pTemp->uri[0] != '\0') &&
+        ((pTemp->fixedEntry == TRUE) ||
+            (pTemp->generation == pDNR->generation) ||                      /* Resolved since last change?  */
+            ((appHandle->etbTopoCnt == 0u) && (appHandle->opTrnTopoCnt == 0u))) &&   /* Or do we not care?  */
+        (pTemp->ipAddr != 0))                                               /* 0 is only a placeholder */
     {
-        pDNR->noOfCachedEntries++;
+        pTemp->lastUse  = pDNR->useCnt;
+        *pAddr          = pTemp->ipAddr;
+        return TRUE;
     }
+    return FALSE;
+}
 
-    /* Position found, store everything */
-    vos_strncpy(pDNR->cache[cacheEntry].uri, pURI, TRDP_MAX_URI_HOST_LEN-1);
-    pDNR->cache[cacheEntry].ipAddr          = 0u;
-    pDNR->cache[cacheEntry].etbTopoCnt      = appHandle->etbTopoCnt;
-    pDNR->cache[cacheEntry].opTrnTopoCnt    = appHandle->opTrnTopoCnt;
-    pDNR->cache[cacheEntry].fixedEntry      = FALSE;
+/**********************************************************************************************************************/
+/**    Call the callbacks of asynchronous lookups and release them
+ *
+ *  @param[in]      appHandle       Session context
+ *  @param[in]      pDNR            DNR context
+ *  @param[in]      pList           List of lookups
+ *  @param[in]      err             Result of the TCN-DNS request
+ */
+static void completeLookups (
+    TRDP_APP_SESSION_T  appHandle,
+    TAU_DNR_DATA_T      *pDNR,
+    TAU_DNR_PENDING_T   *pList,
+    TRDP_ERR_T          err)
+{
+    while (pList != NULL)
+    {
+        TAU_DNR_PENDING_T   *pNext  = pList->pNext;
+        TRDP_IP_ADDR_T      ipAddr  = VOS_INADDR_ANY;
+        TRDP_ERR_T          result  = err;
 
-    /* Sort the entries to get faster hits  */
-    vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
+        if (result == TRDP_NO_ERR)
+        {
+            (void) vos_mutexLock(pDNR->mutex);
+            if (cacheLookup(appHandle, pDNR, pList->uri, &ipAddr) == FALSE)
+            {
+                result = TRDP_UNRESOLVED_ERR;
+            }
+            (void) vos_mutexUnlock(pDNR->mutex);
+        }
+        pList->pfCbFunction(pList->pRefCon, appHandle, pList->uri, ipAddr, result);
+        vos_memFree(pList);
+        pList = pNext;
+    }
 }
 
 /**********************************************************************************************************************/
-/**    Parse the reply payload and update the DNS cache
+/**    Parse the reply payload and update the DNS cache.
+ *  All resolved URIs of the reply are stored, also those which were not asked for.
+ *  Answers for other topocounts than the current ones are stored as outdated.
  *
  *  @param[in]      pDNR            DNR context
- *  @param[in]      pReply          Handle returned by tlc_openSession()
- *  @param[in]      size            Pointer to Message Info
+ *  @param[in]      pReply          TCN-DNS reply payload
+ *  @param[in]      size            Size of payload
  *
  *
  */
@@ -782,45 +1051,62 @@ static void parseUpdateTCNResponse (
                                     TRDP_DNS_REPLY_T    *pReply,
                                     UINT32              size)
 {
-    UINT32  i;
+    UINT32          i;
     TAU_DNR_ENTRY_T *pTemp;
+    UINT32          etbTopoCnt      = vos_ntohl(pReply->etbTopoCnt);
+    UINT32          opTrnTopoCnt    = vos_ntohl(pReply->opTrnTopoCnt);
+    UINT32          generation      = 0u;
+    CHAR8           uri[TRDP_MAX_URI_HOST_LEN];
 
-    size = size;
+    if (size < (sizeof(TRDP_DNS_REPLY_T) - 255u * sizeof(TCN_URI_T)) ||
+        size < (sizeof(TRDP_DNS_REPLY_T) - (255u - pReply->tcnUriCnt) * sizeof(TCN_URI_T)))
+    {
+        vos_printLog(VOS_LOG_WARNING, "TCN-DNS reply too short (%u Bytes)\n", size);
+        return;
+    }
+
+    (void) vos_mutexLock(pDNR->mutex);
+
+    if ((etbTopoCnt == pDNR->etbTopoCnt) && (opTrnTopoCnt == pDNR->opTrnTopoCnt))
+    {
+        generation = pDNR->generation;
+    }
 
     for (i = 0u; i < pReply->tcnUriCnt; i++)
     {
+        /* The URI string of the reply need not be terminated */
+        vos_strncpy(uri, pReply->tcnUriList[i].tcnUriStr, TRDP_MAX_URI_HOST_LEN - 1u);
+        uri[TRDP_MAX_URI_HOST_LEN - 1u] = '\0';
+
         if (pReply->tcnUriList[i].resolvState != -1)
         {
-            pTemp = (TAU_DNR_ENTRY_T *) vos_bsearch(pReply->tcnUriList[i].tcnUriStr,
-                                                pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T),
-                                                compareURI);
-            if (pTemp != NULL)
+            pTemp = cacheGet(pDNR, uri);
+            if ((pTemp != NULL) && (pTemp->fixedEntry == FALSE))
             {
                 /* Position found, store everything */
-                vos_strncpy(pTemp->uri, pReply->tcnUriList[i].tcnUriStr, TRDP_MAX_URI_HOST_LEN-1);
                 pTemp->ipAddr          = vos_ntohl(pReply->tcnUriList[i].tcnUriIpAddr);
-                pTemp->etbTopoCnt      = vos_ntohl(pReply->etbTopoCnt);
-                pTemp->opTrnTopoCnt    = vos_ntohl(pReply->opTrnTopoCnt);
-                pTemp->fixedEntry      = FALSE;
+                pTemp->etbTopoCnt      = etbTopoCnt;
+                pTemp->opTrnTopoCnt    = opTrnTopoCnt;
+                pTemp->generation      = generation;
                 if (pTemp->ipAddr == VOS_INADDR_ANY)
                 {
-                    vos_printLog(VOS_LOG_WARNING, "%s resolved to INADDR_ANY\n", pReply->tcnUriList[i].tcnUriStr);
+                    vos_printLog(VOS_LOG_WARNING, "%s resolved to INADDR_ANY\n", uri);
                 }
             }
-            else
-            {
-                vos_printLog(VOS_LOG_INFO, "%s was not asked for!\n", pReply->tcnUriList[i].tcnUriStr);
-            }
         }
         else
         {
-            vos_printLog(VOS_LOG_WARNING, "%s could not be resolved\n", pReply->tcnUriList[i].tcnUriStr);
+            vos_printLog(VOS_LOG_WARNING, "%s could not be resolved\n", uri);
         }
     }
-    /* Sort the entries to get faster hits  */
-    vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
+
+    (void) vos_mutexUnlock(pDNR->mutex);
 }
 
+static void sendQueuedRequest (
+    TRDP_APP_SESSION_T  appHandle,
+    TAU_DNR_DATA_T      *pDNR);
+
 /**********************************************************************************************************************/
 /**    MD Callback for the TCN-DNS Reply
  *
@@ -840,15 +1126,47 @@ static void dnrMDCallback (
     UINT32                  dataSize)
 {
 
+    TAU_DNR_DATA_T *pDNR;
+
     if ((appHandle == NULL) ||
-         (pData == NULL) ||
-         (dataSize == 0u) ||
+         (appHandle->pUser == NULL) ||
          (pMsg == NULL))
     {
          return;
     }
 
     pRefCon = pRefCon;
+    pDNR    = (TAU_DNR_DATA_T *) appHandle->pUser;
+
+    /* reply (or time out) of the asynchronous lookups */
+    if (pMsg->pUserRef == (const void *) pDNR)
+    {
+        TAU_DNR_PENDING_T   *pDone;
+        TRDP_ERR_T          result = pMsg->resultCode;
+
+        if ((pMsg->comId == TCN_DNS_REP_COMID) && (result == TRDP_NO_ERR) && (pData != NULL))
+        {
+            parseUpdateTCNResponse(pDNR, (TRDP_DNS_REPLY_T *)pData, dataSize);
+        }
+        else if (result != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_WARNING, "dnrMDCallback error (resultCode = %d)\n", pMsg->resultCode);
+        }
+        (void) vos_mutexLock(pDNR->mutex);
+        pDone = pDNR->pInFlight;
+        pDNR->pInFlight = NULL;
+        (void) vos_mutexUnlock(pDNR->mutex);
+
+        sendQueuedRequest(appHandle, pDNR);     /* lookups queued meanwhile */
+        completeLookups(appHandle, pDNR, pDone, result);
+        return;
+    }
+
+    if ((pData == NULL) ||
+        (dataSize == 0u))
+    {
+        return;
+    }
 
     /* we await TCN-DNS reply */
     if ((pMsg->comId == TCN_DNS_REP_COMID) &&
@@ -860,7 +1178,7 @@ static void dnrMDCallback (
         // if (sdt_isvalid(appHandle, pData, dataSize)) ...
 
         /* update the cache */
-        parseUpdateTCNResponse((TAU_DNR_DATA_T *) appHandle->pUser, (TRDP_DNS_REPLY_T *)pData, dataSize);
+        parseUpdateTCNResponse(pDNR, (TRDP_DNS_REPLY_T *)pData, dataSize);
 
         (void) vos_semaGive(*pDnsSema);
     }
@@ -874,7 +1192,6 @@ static void dnrMDCallback (
 /**    Query the TCN-DNS server for the addresses
  *
  *  @param[in]      appHandle           Handle returned by tlc_openSession()
- *  @param[in]      pTemp               Last entry which was invalid, can be NULL
  *  @param[in]      pUri                Pointer to host name
  *
  *  @retval         TRDP_NO_ERR     no error
@@ -884,7 +1201,6 @@ static void dnrMDCallback (
  */
 static void updateTCNDNSentry (
     TRDP_APP_SESSION_T  appHandle,
-    TAU_DNR_ENTRY_T     *pTemp,
     const CHAR8         *pUri)
 {
     TRDP_ERR_T      err;
@@ -909,13 +1225,18 @@ static void updateTCNDNSentry (
 
     /* Is this URI already in the cache? If not, add it! Eventually remove the oldest  */
 
-    if (pTemp == NULL)
+    (void) vos_mutexLock(pDNR->mutex);
+    if (cacheGet(pDNR, pUri) == NULL)
     {
-        addEntry(appHandle, pDNR, pUri);
+        vos_printLogStr(VOS_LOG_WARNING, "updateTCNDNSentry: DNR cache full\n");
     }
+
     /* build the request telegram with all possible outdated entries */
 
-    buildRequest(appHandle, pDNR, pDNS_REQ, &querySize);
+    requestInit(appHandle, pDNS_REQ);
+    (void) requestAddUri(pDNS_REQ, pUri);
+    buildRequest(pDNR, pDNS_REQ, &querySize);
+    (void) vos_mutexUnlock(pDNR->mutex);
 
     if (querySize == 0u)
     {
@@ -1008,6 +1329,86 @@ exit:
     return;
 }
 
+/**********************************************************************************************************************/
+/**    Send the queued asynchronous lookups as one TCN-DNS request, if no request is running.
+ *  The request is filled up with outdated cache entries. Lookups which could not be sent are completed with the error.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in]      pDNR                DNR context
+ *
+ */
+static void sendQueuedRequest (
+    TRDP_APP_SESSION_T  appHandle,
+    TAU_DNR_DATA_T      *pDNR)
+{
+    TRDP_DNS_REQUEST_T  *pRequest;
+    TAU_DNR_PENDING_T   **ppLast;
+    TAU_DNR_PENDING_T   *pFailed;
+    UINT32              querySize   = 0u;
+    TRDP_ERR_T          err         = TRDP_MEM_ERR;
+
+    pRequest = (TRDP_DNS_REQUEST_T *) vos_memAlloc(sizeof(TRDP_DNS_REQUEST_T));
+
+    (void) vos_mutexLock(pDNR->mutex);
+    if ((pDNR->pInFlight != NULL) || (pDNR->pQueued == NULL))
+    {
+        (void) vos_mutexUnlock(pDNR->mutex);
+        if (pRequest != NULL)
+        {
+            vos_memFree(pRequest);
+        }
+        return;
+    }
+    if (pRequest == NULL)
+    {
+        /* fail all of them */
+        pDNR->pInFlight = pDNR->pQueued;
+        pDNR->pQueued   = NULL;
+    }
+    else
+    {
+        /* Move as many queued lookups into the request as fit, keeping their order */
+        requestInit(appHandle, pRequest);
+        ppLast = &pDNR->pInFlight;
+        while ((pDNR->pQueued != NULL) && (requestAddUri(pRequest, pDNR->pQueued->uri) == TRUE))
+        {
+            *ppLast         = pDNR->pQueued;
+            pDNR->pQueued   = pDNR->pQueued->pNext;
+            ppLast          = &(*ppLast)->pNext;
+            *ppLast         = NULL;
+        }
+        buildRequest(pDNR, pRequest, &querySize);
+    }
+    (void) vos_mutexUnlock(pDNR->mutex);
+
+    /* The session mutex must not be taken while holding the DNR mutex */
+    if (pRequest != NULL)
+    {
+        err = tlm_request(appHandle, pDNR, dnrMDCallback, &pDNR->asyncSessionId, TCN_DNS_REQ_COMID,
+                          0u, 0u,
+                          VOS_INADDR_ANY, pDNR->dnsIpAddr,
+                          TRDP_FLAGS_CALLBACK,
+                          1u,
+                          TCN_DNS_REQ_TO_US,
+                          NULL,
+                          (UINT8 *) pRequest,
+                          querySize,
+                          NULL,
+                          NULL);
+        vos_memFree(pRequest);
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "sendQueuedRequest failed to send request (Err: %d)\n", err);
+        (void) vos_mutexLock(pDNR->mutex);
+        pFailed         = pDNR->pInFlight;
+        pDNR->pInFlight = NULL;
+        (void) vos_mutexUnlock(pDNR->mutex);
+        completeLookups(appHandle, pDNR, pFailed, err);
+        sendQueuedRequest(appHandle, pDNR);     /* those which did not fit */
+    }
+}
+
 #pragma mark ----------------------- Public -----------------------------
 
 /***********************************************************************************************************************
@@ -1075,6 +1476,19 @@ EXT_DECL TRDP_ERR_T tau_initDnr (
 
     pDNR->useTCN_DNS = dnsOptions;
     pDNR->noOfCachedEntries = 0u;
+    pDNR->generation = 1u;
+    pDNR->etbTopoCnt = appHandle->etbTopoCnt;
+    pDNR->opTrnTopoCnt = appHandle->opTrnTopoCnt;
+    pDNR->cacheSize = TAU_DNR_CACHE_START_SIZE;
+    pDNR->pCache = (TAU_DNR_ENTRY_T *) vos_memAlloc(TAU_DNR_CACHE_START_SIZE * sizeof(TAU_DNR_ENTRY_T));
+    if ((pDNR->pCache == NULL) ||
+        (vos_mutexCreate(&pDNR->mutex) != VOS_NO_ERR))
+    {
+        vos_memFree(pDNR->pCache);
+        vos_memFree(pDNR);
+        appHandle->pUser = NULL;
+        return TRDP_MEM_ERR;
+    }
     
     if (waitForDnr > 0)
     {
@@ -1113,6 +1527,33 @@ EXT_DECL void tau_deInitDnr (
 
     if (appHandle != NULL && appHandle->pUser != NULL)
     {
+        TAU_DNR_DATA_T      *pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+        TAU_DNR_PENDING_T   *pList[2];
+        TAU_DNR_PENDING_T   *pNext;
+        UINT32              i;
+
+        /* Drop the asynchronous lookups, the running request must not call back */
+        (void) vos_mutexLock(pDNR->mutex);
+        pList[0]        = pDNR->pQueued;
+        pList[1]        = pDNR->pInFlight;
+        pDNR->pQueued   = NULL;
+        pDNR->pInFlight = NULL;
+        (void) vos_mutexUnlock(pDNR->mutex);
+        if (pList[1] != NULL)
+        {
+            (void) tlm_abortSession(appHandle, (const TRDP_UUID_T *)&pDNR->asyncSessionId); /*lint !e545 suspicious use of & */
+        }
+        for (i = 0u; i < 2u; i++)
+        {
+            for (; pList[i] != NULL; pList[i] = pNext)
+            {
+                pNext = pList[i]->pNext;
+                vos_memFree(pList[i]);
+            }
+        }
+
+        vos_mutexDelete(pDNR->mutex);
+        vos_memFree(pDNR->pCache);
         vos_memFree(appHandle->pUser);
         appHandle->pUser = NULL;
     }
@@ -1208,7 +1649,7 @@ EXT_DECL TRDP_IP_ADDR_T tau_getOwnAddr (
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession()
  *  @param[out]     pAddr           Pointer to return the IP address
- *  @param[in]      pUri            Pointer to an URI or an IP Address string, NULL==own URI
+ *  @param[in]      pUri            Host part of a URI or an IP Address string, NULL==own URI
  *
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      Parameter error
@@ -1219,10 +1660,10 @@ EXT_DECL TRDP_IP_ADDR_T tau_getOwnAddr (
 EXT_DECL TRDP_ERR_T tau_uri2Addr (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_IP_ADDR_T      *pAddr,
-    const TRDP_URI_T    pUri)
+    const TRDP_URI_HOST_T pUri)
 {
     TAU_DNR_DATA_T  *pDNR;
-    TAU_DNR_ENTRY_T *pTemp;
+    BOOL8           hit;
     int i;
 
     if (appHandle == NULL ||
@@ -1251,27 +1692,23 @@ EXT_DECL TRDP_ERR_T tau_uri2Addr (
         /* Look inside the cache    */
         for (i = 0; i < 2; ++i)
         {
-            pTemp = (TAU_DNR_ENTRY_T *) vos_bsearch(pUri, pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T),
-                                                    compareURI);
-            if ((pTemp != NULL) &&
-                ((pTemp->fixedEntry == TRUE) ||
-                (pTemp->etbTopoCnt == appHandle->etbTopoCnt) ||                    /* Do the topocounts match? */
-                    (pTemp->opTrnTopoCnt == appHandle->opTrnTopoCnt) ||
-                    ((appHandle->etbTopoCnt == 0u) && (appHandle->opTrnTopoCnt == 0u))) &&   /* Or do we not care?       */
-                    (pTemp->ipAddr != 0))                                                 /* 0 is only a placeholder */
+            (void) vos_mutexLock(pDNR->mutex);
+            hit = cacheLookup(appHandle, pDNR, pUri, pAddr);
+            (void) vos_mutexUnlock(pDNR->mutex);
+
+            if (hit == TRUE)
             {
-                *pAddr = pTemp->ipAddr;
                 return TRDP_NO_ERR;
             }
             else    /* address is not known or out of date (topocounts differ)  */
             {
                 if (pDNR->useTCN_DNS != TRDP_DNR_STANDARD_DNS)
                 {
-                    updateTCNDNSentry(appHandle, pTemp, pUri);   /* Update everything, at least this URI */
+                    updateTCNDNSentry(appHandle, pUri);   /* Update at least this URI, prefetch outdated ones */
                 }
                 else
                 {
-                    updateDNSentry(appHandle, pTemp, pUri);
+                    updateDNSentry(appHandle, pUri);
                 }
                 /* try resolving again... */
             }
@@ -1282,6 +1719,94 @@ EXT_DECL TRDP_ERR_T tau_uri2Addr (
     return TRDP_UNRESOLVED_ERR;
 }
 
+/**********************************************************************************************************************/
+/**    Function to convert a URI to an IP address without blocking.
+ *  On a cache hit the callback is called before returning. Otherwise the URI is queued and all queued URIs are
+ *  asked in one TCN-DNS request; the callback is called from tlc_process()/tlm_process() when the reply arrives
+ *  or times out.
+ *  Standard DNS queries block, TRDP_DNR_STANDARD_DNS is not supported (use tau_uri2Addr()).
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
+ *  @param[in]      pUri            Host part of a URI or an IP Address string, NULL==own URI
+ *  @param[in]      pfCbFunction    Callback receiving the result, called exactly once if TRDP_NO_ERR is returned
+ *  @param[in]      pRefCon         user supplied context pointer passed to the callback
+ *
+ *  @retval         TRDP_NO_ERR     resolved or queued
+ *  @retval         TRDP_PARAM_ERR  Parameter error or TRDP_DNR_STANDARD_DNS
+ *  @retval         TRDP_NOINIT_ERR DNR not initialised
+ *  @retval         TRDP_MEM_ERR    out of memory
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_uri2AddrAsync (
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_URI_HOST_T   pUri,
+    TAU_DNR_CALLBACK_T      pfCbFunction,
+    void                    *pRefCon)
+{
+    TAU_DNR_DATA_T      *pDNR;
+    TAU_DNR_PENDING_T   *pPending;
+    TAU_DNR_PENDING_T   **ppLast;
+    TRDP_IP_ADDR_T      ipAddr = VOS_INADDR_ANY;
+    BOOL8               hit;
+
+    if ((appHandle == NULL) ||
+        (pfCbFunction == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /* Own address and dotted IP addresses need no lookup */
+    if ((pUri == NULL) || ((ipAddr = vos_dottedIP(pUri)) != VOS_INADDR_ANY))
+    {
+        (void) tau_uri2Addr(appHandle, &ipAddr, pUri);
+        pfCbFunction(pRefCon, appHandle, pUri, ipAddr, TRDP_NO_ERR);
+        return TRDP_NO_ERR;
+    }
+
+    pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+    if (pDNR == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /* updateDNSentry() waits for the DNS server, it can not be queued */
+    if (pDNR->useTCN_DNS == TRDP_DNR_STANDARD_DNS)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    (void) vos_mutexLock(pDNR->mutex);
+    hit = cacheLookup(appHandle, pDNR, pUri, &ipAddr);
+    (void) vos_mutexUnlock(pDNR->mutex);
+
+    if (hit == TRUE)
+    {
+        pfCbFunction(pRefCon, appHandle, pUri, ipAddr, TRDP_NO_ERR);
+        return TRDP_NO_ERR;
+    }
+
+    /* Queue it for the next TCN-DNS request */
+    pPending = (TAU_DNR_PENDING_T *) vos_memAlloc(sizeof(TAU_DNR_PENDING_T));
+    if (pPending == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    vos_strncpy(pPending->uri, pUri, TRDP_MAX_URI_HOST_LEN - 1u);
+    pPending->pfCbFunction  = pfCbFunction;
+    pPending->pRefCon       = pRefCon;
+
+    (void) vos_mutexLock(pDNR->mutex);
+    for (ppLast = &pDNR->pQueued; *ppLast != NULL; ppLast = &(*ppLast)->pNext)
+    {
+        ;
+    }
+    *ppLast = pPending;
+    (void) vos_mutexUnlock(pDNR->mutex);
+
+    sendQueuedRequest(appHandle, pDNR);
+    return TRDP_NO_ERR;
+}
+
 EXT_DECL TRDP_IP_ADDR_T tau_ipFromURI (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_URI_HOST_T     uri)
@@ -1323,16 +1848,21 @@ EXT_DECL TRDP_ERR_T tau_addr2Uri (
     if ((addr != VOS_INADDR_ANY) && (pDNR != NULL))
     {
         UINT32 i;
-        for (i = 0u; i < pDNR->noOfCachedEntries; ++i)
+
+        (void) vos_mutexLock(pDNR->mutex);
+        for (i = 0u; i < pDNR->cacheSize; ++i)
         {
-            if ((pDNR->cache[i].ipAddr == addr) &&
-                ((appHandle->etbTopoCnt == 0u) || (pDNR->cache[i].etbTopoCnt == appHandle->etbTopoCnt)) &&
-                ((appHandle->opTrnTopoCnt == 0u) || (pDNR->cache[i].opTrnTopoCnt == appHandle->opTrnTopoCnt)))
+            if ((pDNR->pCache[i].uri[0] != '\0') &&
+                (pDNR->pCache[i].ipAddr == addr) &&
+                ((appHandle->etbTopoCnt == 0u) || (pDNR->pCache[i].etbTopoCnt == appHandle->etbTopoCnt)) &&
+                ((appHandle->opTrnTopoCnt == 0u) || (pDNR->pCache[i].opTrnTopoCnt == appHandle->opTrnTopoCnt)))
             {
-                vos_strncpy(pUri, pDNR->cache[i].uri, TRDP_MAX_URI_HOST_LEN - 1);
+                vos_strncpy(pUri, pDNR->pCache[i].uri, TRDP_MAX_URI_HOST_LEN - 1);
+                (void) vos_mutexUnlock(pDNR->mutex);
                 return TRDP_NO_ERR;
             }
         }
+        (void) vos_mutexUnlock(pDNR->mutex);
         /* address not in cache: Make reverse request */
         /* tbd */
 
@@ -17,6 +17,11 @@
  /*
  * $Id: tau_marshall.c 2197 2020-08-12 14:07:33Z bloehr $
  *
+ *      AG 2026-10-17: Plans by default, runs of fixed size elements fused into blocks, tau_initMarshallInterpreted()
+ *      AG 2026-10-17: Marshalling context returned via ppRefCon, immutable lookup tables, no pCachedDS writes
+ *      AG 2026-10-17: No fallback to the last context initialised, pRefCon NULL returns TRDP_PARAM_ERR
+ *      AG 2026-10-17: Plans per context by tau_initMarshallPlans(), global tau_setMarshallPlans() removed
+ *      AG 2026-10-17: Compiled marshalling plans built by tau_initMarshall(), interpreter used as fallback
  *      BL 2020-08-12: Warning output moved (to before aligning source pointer on return from possible recursion)
  *      SB 2019-08-15: Compiler warning (pointer compared to integer)
  *      SB 2019-08-14: Ticket #265: Incorrect alignment in nested datasets
@@ -50,6 +55,57 @@
 
 #include "tau_marshall.h"
 
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define TAU_MARSHALL_MAGIC  0x4D41524Cu  /**< marks a valid marshalling context                        */
+
+/* Operations of a compiled marshalling plan */
+#define TAU_OP_COPY         0u      /**< 8 bit items, copied                                            */
+#define TAU_OP_SWAP16       1u      /**< 16 bit items, byte swapped on little endian hosts              */
+#define TAU_OP_SWAP32       2u      /**< 32 bit items, byte swapped on little endian hosts              */
+#define TAU_OP_SWAP64       3u      /**< 64 bit items, byte swapped on little endian hosts              */
+#define TAU_OP_TD48         4u      /**< TIMEDATE48 items, 6 bytes on the wire, padded on the host      */
+#define TAU_OP_TD64         5u      /**< TIMEDATE64 items of variable count (two 32 bit items each)     */
+#define TAU_OP_REPEAT       6u      /**< repeat the ops up to the matching TAU_OP_END                   */
+#define TAU_OP_END          7u      /**< end of a repeated block                                        */
+#define TAU_OP_DONE         8u      /**< end of the plan                                                */
+#define TAU_OP_BLOCK        9u      /**< fused short operations, count is the index of the block        */
+
+#define TAU_PLAN_MAX_VARS   32u     /**< max. variable sized elements per plan                          */
+#define TAU_PLAN_MAX_OPS    1024u   /**< larger datasets are handled by the interpreter                 */
+#define TAU_PLAN_UNROLL_OPS 64u     /**< nested datasets with fixed count are unrolled up to this size  */
+#define TAU_PLAN_FUSE_ITEMS 32u     /**< operations up to this count are fused into blocks              */
+
+/* Host size of one TIMEDATE48 (UINT32 seconds, UINT16 ticks, padding) */
+#define TAU_TD48_HOST_SIZE  ((6u + ALIGNOF(TIMEDATE48_STRUCT_T) - 1u) & ~(ALIGNOF(TIMEDATE48_STRUCT_T) - 1u))
+
+/* Item access of the plan runner, fixed size copies are inlined even with -fno-builtin */
+#if defined(__GNUC__)
+#define TAU_SWAP16(x)   __builtin_bswap16(x)
+#define TAU_SWAP32(x)   __builtin_bswap32(x)
+#define TAU_SWAP64(x)   __builtin_bswap64(x)
+#define TAU_COPY(d, s, n)   __builtin_memcpy((d), (s), (n))
+#else
+#define TAU_SWAP16(x)   ((UINT16) (((UINT16)(x) << 8u) | ((UINT16)(x) >> 8u)))
+#define TAU_SWAP32(x)   ((((UINT32)(x) & 0x000000FFu) << 24u) | (((UINT32)(x) & 0x0000FF00u) << 8u) | \
+                         (((UINT32)(x) & 0x00FF0000u) >> 8u) | (((UINT32)(x) & 0xFF000000u) >> 24u))
+#define TAU_SWAP64(x)   (((UINT64) TAU_SWAP32((UINT32)(x)) << 32u) | (UINT64) TAU_SWAP32((UINT32)((x) >> 32u)))
+#define TAU_COPY(d, s, n)   memcpy((d), (s), (n))
+#endif
+
+/* Host to wire order of one item */
+#ifdef B_ENDIAN
+#define TAU_NET16(x)    (x)
+#define TAU_NET32(x)    (x)
+#define TAU_NET64(x)    (x)
+#else
+#define TAU_NET16(x)    TAU_SWAP16(x)
+#define TAU_NET32(x)    TAU_SWAP32(x)
+#define TAU_NET64(x)    TAU_SWAP64(x)
+#endif
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -64,6 +120,79 @@ typedef struct
     UINT8   *pDstEnd;       /**< last destination        */
 } TAU_MARSHALL_INFO_T;
 
+/** One operation of a compiled plan.
+    Host alignment is resolved when the plan is built: hostPad bytes are skipped before the operation. Only behind
+    variable sized elements the host offset is unknown, then hostAlign is applied at run time. */
+typedef struct
+{
+    UINT8   code;           /**< TAU_OP_...                                                     */
+    UINT8   hostPad;        /**< host bytes to skip before the operation                        */
+    UINT8   hostAlign;      /**< host alignment to apply at run time, 1 if resolved             */
+    UINT8   setVar;         /**< 0 or index + 1 of the variable size set by this element        */
+    UINT8   useVar;         /**< 0 or index + 1 of the variable size giving the count           */
+    UINT32  count;          /**< number of items or repetitions, if useVar == 0                 */
+} TAU_PLAN_OP_T;
+
+/** One item of a block, the offsets are relative to the start of the block */
+typedef struct
+{
+    UINT16  offset[2];      /**< host and wire offset                                           */
+} TAU_PLAN_ITEM_T;
+
+/** A block of fused operations.
+    Consecutive short operations with a fixed layout are replaced by their items, sorted by size. The block is
+    run by one counted loop per item size, with a single size check for all of it. */
+typedef struct
+{
+    UINT32  hostSize;       /**< host bytes of the block, including padding                    */
+    UINT32  wireSize;       /**< wire bytes of the block                                        */
+    UINT32  first;          /**< index of the first item                                        */
+    UINT16  noOfItems[4];   /**< number of 8, 16, 32 and 64 bit items, in this order            */
+} TAU_PLAN_BLOCK_T;
+
+/** One dataset of a marshalling context, resolved by tau_initMarshall() */
+typedef struct TAU_DS_ENTRY
+{
+    TRDP_DATASET_T          *pDataset;      /**< the dataset                                            */
+    UINT32                  hostAlign;      /**< alignment of the dataset (its largest member)          */
+    struct TAU_DS_ENTRY     * *ppNested;    /**< per element: nested dataset, NULL if none or unknown   */
+    UINT32                  noOfOps;        /**< number of plan operations                              */
+    TAU_PLAN_OP_T           *pOps;          /**< compiled plan, NULL if the dataset is interpreted      */
+    TAU_PLAN_BLOCK_T        *pBlocks;       /**< fused blocks of the plan, may be NULL                  */
+    TAU_PLAN_ITEM_T         *pItems;        /**< items of the fused blocks                              */
+} TAU_DS_ENTRY_T;
+
+/** Marshalling context, returned by tau_initMarshall() as reference context.
+    It is not changed after initialisation, so it can be used by several threads at the same time. */
+typedef struct
+{
+    UINT32                  magic;          /**< TAU_MARSHALL_MAGIC                                     */
+    BOOL8                   usePlans;       /**< run the compiled plans, FALSE for tau_initMarshallInterpreted() */
+    UINT32                  numComId;       /**< number of comId mappings                               */
+    TRDP_COMID_DSID_MAP_T   *pComIdMap;     /**< comId mappings, sorted by comId                        */
+    TAU_DS_ENTRY_T          * *ppComIdDs;   /**< dataset of each comId mapping                          */
+    UINT32                  numEntries;     /**< number of datasets                                     */
+    TAU_DS_ENTRY_T          *pEntries;      /**< datasets, sorted by dataset ID                         */
+    TAU_DS_ENTRY_T          * *ppNested;    /**< storage of the nested dataset references               */
+    UINT32                  hashMask;       /**< size of pHash - 1                                      */
+    UINT32                  *pHash;         /**< dataset pointer -> index into pEntries + 1             */
+} TAU_MARSHALL_CONTEXT_T;
+
+/** State while building a plan */
+typedef struct
+{
+    TAU_PLAN_OP_T   *pOps;          /**< operations built so far                                */
+    UINT32          maxOps;         /**< allocated operations                                   */
+    UINT32          noOfOps;        /**< used operations                                        */
+    UINT32          noOfVars;       /**< variable sizes referenced                              */
+    UINT32          hostAlign;      /**< alignment of the host buffer                           */
+    BOOL8           known;          /**< host offset is known                                   */
+    UINT32          offset;         /**< host offset, if known                                  */
+    UINT32          aligned;        /**< guaranteed alignment of the host pointer if not known  */
+    UINT32          pad;            /**< host bytes to skip before the next operation           */
+    UINT32          align;          /**< run time alignment before the next operation           */
+} TAU_PLAN_BUILD_T;
+
 /* structure type definitions for alignment calculation */
 typedef struct
 {
@@ -86,11 +215,6 @@ typedef struct
  * LOCALS
  */
 
-static TRDP_COMID_DSID_MAP_T    *sComIdDsIdMap = NULL;
-static UINT32                   sNumComId = 0u;
-
-static TRDP_DATASET_T           * *sDataSets = NULL;
-static UINT32                   sNumEntries = 0u;
 
 /***********************************************************************************************************************
  * LOCAL FUNCTIONS
@@ -191,7 +315,7 @@ static INLINE void packedCopy64 (
 }
 
 /**********************************************************************************************************************/
-/**    Dataset compare function
+/**    Dataset entry compare function
  *
  *  @param[in]      pArg1        Pointer to first element
  *  @param[in]      pArg2        Pointer to second element
@@ -204,8 +328,8 @@ static int compareDataset (
     const void  *pArg1,
     const void  *pArg2)
 {
-    TRDP_DATASET_T  *p1 = *(TRDP_DATASET_T * *)pArg1;
-    TRDP_DATASET_T  *p2 = *(TRDP_DATASET_T * *)pArg2;
+    const TRDP_DATASET_T    *p1 = ((const TAU_DS_ENTRY_T *)pArg1)->pDataset;
+    const TRDP_DATASET_T    *p2 = ((const TAU_DS_ENTRY_T *)pArg2)->pDataset;
 
     if (p1->id < p2->id)
     {
@@ -222,27 +346,24 @@ static int compareDataset (
 }
 
 /**********************************************************************************************************************/
-/**    Dataset compare function
+/**    ComId/dataset mapping compare function
  *
- *  @param[in]      pArg1        Pointer to key
- *  @param[in]      pArg2        Pointer to array element
+ *  @param[in]      pArg1        Pointer to first element
+ *  @param[in]      pArg2        Pointer to second element
  *
  *  @retval         -1 if arg1 < arg2
  *  @retval          0 if arg1 == arg2
  *  @retval          1 if arg1 > arg2
  */
-static int compareDatasetDeref (
+static int compareComId (
     const void  *pArg1,
     const void  *pArg2)
 {
-    TRDP_DATASET_T  *p1 = (TRDP_DATASET_T *)pArg1;
-    TRDP_DATASET_T  *p2 = *(TRDP_DATASET_T * *)pArg2;
-
-    if (p1->id < p2->id)
+    if ((((TRDP_COMID_DSID_MAP_T *)pArg1)->comId) < (((TRDP_COMID_DSID_MAP_T *)pArg2)->comId))
     {
         return -1;
     }
-    else if (p1->id > p2->id)
+    else if ((((TRDP_COMID_DSID_MAP_T *)pArg1)->comId) > (((TRDP_COMID_DSID_MAP_T *)pArg2)->comId))
     {
         return 1;
     }
@@ -253,127 +374,179 @@ static int compareDatasetDeref (
 }
 
 /**********************************************************************************************************************/
-/**    ComId/dataset mapping compare function
+/**    Check the reference context passed to the marshalling functions.
  *
- *  @param[in]      pArg1        Pointer to first element
- *  @param[in]      pArg2        Pointer to second element
+ *  @param[in]      pRefCon     Reference context from tau_initMarshall(), not NULL
  *
- *  @retval         -1 if arg1 < arg2
- *  @retval          0 if arg1 == arg2
- *  @retval          1 if arg1 > arg2
+ *  @retval         NULL if not a marshalling context
+ *  @retval         pointer to the context
  */
-static int compareComId (
-    const void  *pArg1,
-    const void  *pArg2)
+static const TAU_MARSHALL_CONTEXT_T *getContext (
+    void *pRefCon)
 {
-    if ((((TRDP_COMID_DSID_MAP_T *)pArg1)->comId) < (((TRDP_COMID_DSID_MAP_T *)pArg2)->comId))
-    {
-        return -1;
-    }
-    else if ((((TRDP_COMID_DSID_MAP_T *)pArg1)->comId) > (((TRDP_COMID_DSID_MAP_T *)pArg2)->comId))
+    const TAU_MARSHALL_CONTEXT_T *pContext = (const TAU_MARSHALL_CONTEXT_T *) pRefCon;
+
+    if (pContext->magic != TAU_MARSHALL_MAGIC)
     {
-        return 1;
+        return NULL;
     }
-    else
+    return pContext;
+}
+
+/**********************************************************************************************************************/
+/**    Return the dataset for the datasetID
+ *
+ *
+ *  @param[in]      pContext                Marshalling context
+ *  @param[in]      datasetId               dataset ID to find
+ *
+ *  @retval         NULL if not found
+ *  @retval         pointer to dataset entry
+ */
+static TAU_DS_ENTRY_T *findDs (
+    const TAU_MARSHALL_CONTEXT_T    *pContext,
+    UINT32                          datasetId)
+{
+    UINT32  lower   = 0u;
+    UINT32  upper   = pContext->numEntries;
+
+    while (lower < upper)
     {
-        return 0;
+        UINT32 middle = lower + (upper - lower) / 2u;
+
+        if (pContext->pEntries[middle].pDataset->id < datasetId)
+        {
+            lower = middle + 1u;
+        }
+        else if (pContext->pEntries[middle].pDataset->id > datasetId)
+        {
+            upper = middle;
+        }
+        else
+        {
+            return &pContext->pEntries[middle];
+        }
     }
+    return NULL;
 }
 
-
 /**********************************************************************************************************************/
 /**    Return the dataset for the comID
  *
  *
+ *  @param[in]      pContext    Marshalling context
  *  @param[in]      comId       ComId to find
  *
  *  @retval         NULL if not found
- *  @retval         pointer to dataset
+ *  @retval         pointer to dataset entry
  */
-static TRDP_DATASET_T *findDSFromComId (
-    UINT32 comId)
+static TAU_DS_ENTRY_T *findDSFromComId (
+    const TAU_MARSHALL_CONTEXT_T    *pContext,
+    UINT32                          comId)
 {
     TRDP_COMID_DSID_MAP_T   key1;
-    TRDP_DATASET_T          * *key3;
     TRDP_COMID_DSID_MAP_T   *key2;
 
     key1.comId      = comId;
     key1.datasetId  = 0u;
 
     key2 = (TRDP_COMID_DSID_MAP_T *) vos_bsearch(&key1,
-                                                 sComIdDsIdMap,
-                                                 sNumComId,
+                                                 pContext->pComIdMap,
+                                                 pContext->numComId,
                                                  sizeof(TRDP_COMID_DSID_MAP_T),
                                                  compareComId);
-
     if (key2 != NULL)
     {
-        TRDP_DATASET_T key22 = {0u, 0u, 0u};
+        return pContext->ppComIdDs[key2 - pContext->pComIdMap];
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/**    Return the entry of a dataset pointer (as cached by the caller)
+ *
+ *
+ *  @param[in]      pContext    Marshalling context
+ *  @param[in]      pDataset    Pointer to the dataset
+ *
+ *  @retval         NULL if not part of this context
+ *  @retval         pointer to dataset entry
+ */
+static TAU_DS_ENTRY_T *findDsEntry (
+    const TAU_MARSHALL_CONTEXT_T    *pContext,
+    const TRDP_DATASET_T            *pDataset)
+{
+    UINT32 i;
 
-        key22.id    = key2->datasetId;
-        key3        = (TRDP_DATASET_T * *) vos_bsearch(&key22,
-                                                       sDataSets,
-                                                       sNumEntries,
-                                                       sizeof(TRDP_DATASET_T *),
-                                                       compareDatasetDeref);
-        if (key3 != NULL)
+    for (i = (UINT32) (((uintptr_t) pDataset >> 3u) * 2654435761u) & pContext->hashMask;
+         pContext->pHash[i] != 0u;
+         i = (i + 1u) & pContext->hashMask)
+    {
+        if (pContext->pEntries[pContext->pHash[i] - 1u].pDataset == pDataset)
         {
-            return *key3;
+            return &pContext->pEntries[pContext->pHash[i] - 1u];
         }
     }
-
     return NULL;
 }
 
 /**********************************************************************************************************************/
-/**    Return the dataset for the datasetID
+/**    Find the dataset for a call, using and updating the dataset pointer cached by the caller.
  *
  *
- *  @param[in]      datasetId               dataset ID to find
+ *  @param[in]      pContext        Marshalling context
+ *  @param[in]      byComId         TRUE: id is a comId, FALSE: id is a dataset ID
+ *  @param[in]      id              ComId or dataset ID
+ *  @param[in,out]  ppDSPointer     pointer to pointer to cached dataset, may be NULL
  *
  *  @retval         NULL if not found
- *  @retval         pointer to dataset
+ *  @retval         pointer to dataset entry
  */
-static TRDP_DATASET_T *findDs (
-    UINT32 datasetId)
+static TAU_DS_ENTRY_T *lookupDs (
+    const TAU_MARSHALL_CONTEXT_T    *pContext,
+    BOOL8                           byComId,
+    UINT32                          id,
+    TRDP_DATASET_T                  * *ppDSPointer)
 {
-    if ((sDataSets != NULL) && (sNumEntries != 0u))
-    {
-        TRDP_DATASET_T  key2 = {0u, 0u, 0u};
-        TRDP_DATASET_T  * *key3;
-
-        key2.id = datasetId;
-        key3    = (TRDP_DATASET_T * *) vos_bsearch(&key2,
-                                                   sDataSets,
-                                                   sNumEntries,
-                                                   sizeof(TRDP_DATASET_T *),
-                                                   compareDatasetDeref);
-        if (key3 != NULL)
+    TAU_DS_ENTRY_T *pEntry = NULL;
+
+    /* Can we use the formerly cached value? */
+    if ((NULL != ppDSPointer) && (NULL != *ppDSPointer))
+    {
+        pEntry = findDsEntry(pContext, *ppDSPointer);
+    }
+    if (NULL == pEntry)
+    {
+        pEntry = (byComId == TRUE) ? findDSFromComId(pContext, id) : findDs(pContext, id);
+        if ((NULL != pEntry) && (NULL != ppDSPointer))
         {
-            return *key3;
+            *ppDSPointer = pEntry->pDataset;
         }
     }
-
-    return NULL;
+    return pEntry;
 }
 
 /**********************************************************************************************************************/
 /**    Return the size of the largest member of this dataset.
  *
- *  @param[in]      pDataset        Pointer to one dataset
+ *  @param[in]      pEntry          Pointer to one dataset entry
+ *  @param[in]      level           Nesting level
  *
  *  @retval         1,2,4,8
  *
  */
 static UINT8 maxAlignOfDSMember (
-    TRDP_DATASET_T *pDataset)
+    const TAU_DS_ENTRY_T    *pEntry,
+    UINT32                  level)
 {
     UINT16  lIndex;
     UINT8   maxSize = 1;
     UINT8   elemSize = 1;
 
-    if (pDataset != NULL)
+    if ((pEntry != NULL) && (level <= TAU_MAX_DS_LEVEL))
     {
+        const TRDP_DATASET_T *pDataset = pEntry->pDataset;
+
         /*    Loop over all datasets in the array    */
         for (lIndex = 0u; lIndex < pDataset->numElement; ++lIndex)
         {
@@ -427,7 +600,7 @@ static UINT8 maxAlignOfDSMember (
             }
             else    /* recurse if nested dataset */
             {
-                elemSize = maxAlignOfDSMember(findDs(pDataset->pElement[lIndex].type));
+                elemSize = maxAlignOfDSMember(pEntry->ppNested[lIndex], level + 1u);
             }
             if (maxSize < elemSize)
             {
@@ -442,7 +615,7 @@ static UINT8 maxAlignOfDSMember (
 /**    Marshall one dataset.
  *
  *  @param[in,out]  pInfo           Pointer with src & dest info
- *  @param[in]      pDataset        Pointer to one dataset
+ *  @param[in]      pEntry          Pointer to one dataset entry
  *
  *  @retval         TRDP_NO_ERR     no error
  *  @retval         TRDP_MEM_ERR    provided buffer to small
@@ -453,8 +626,9 @@ static UINT8 maxAlignOfDSMember (
 
 static TRDP_ERR_T marshallDs (
     TAU_MARSHALL_INFO_T *pInfo,
-    TRDP_DATASET_T      *pDataset)
+    TAU_DS_ENTRY_T      *pEntry)
 {
+    TRDP_DATASET_T  *pDataset = pEntry->pDataset;
     TRDP_ERR_T  err;
     UINT16      lIndex;
     UINT32      var_size = 0u;
@@ -474,7 +648,7 @@ static TRDP_ERR_T marshallDs (
             "A struct is always aligned to the largest types alignment requirements"
         Only, at this point we do need to know the size of the largest member to follow! */
 
-    pSrc = alignePtr(pInfo->pSrc, maxAlignOfDSMember(pDataset));
+    pSrc = alignePtr(pInfo->pSrc, pEntry->hostAlign);
 
     /*    Loop over all datasets in the array    */
     for (lIndex = 0u; (lIndex < pDataset->numElement) && (pInfo->pSrcEnd > pInfo->pSrc); ++lIndex)
@@ -493,20 +667,14 @@ static TRDP_ERR_T marshallDs (
             {
                 /* Dataset, call ourself recursively */
 
-                /* Never used before?  */
-                if (NULL == pDataset->pElement[lIndex].pCachedDS)
-                {
-                    /* Look for it   */
-                    pDataset->pElement[lIndex].pCachedDS = findDs(pDataset->pElement[lIndex].type);
-                }
-
-                if (NULL == pDataset->pElement[lIndex].pCachedDS)      /* Not in our DB    */
+                /* Resolved by tau_initMarshall() */
+                if (NULL == pEntry->ppNested[lIndex])      /* Not in our DB    */
                 {
                     vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", pDataset->pElement[lIndex].type);
                     return TRDP_COMID_ERR;
                 }
 
-                err = marshallDs(pInfo, pDataset->pElement[lIndex].pCachedDS);
+                err = marshallDs(pInfo, pEntry->ppNested[lIndex]);
                 if (err != TRDP_NO_ERR)
                 {
                     return err;
@@ -666,7 +834,7 @@ static TRDP_ERR_T marshallDs (
     }
 
     /* Align to possible next dataset. Needed when returning from recursion! */
-    pInfo->pSrc = alignePtr(pInfo->pSrc, maxAlignOfDSMember(pDataset));
+    pInfo->pSrc = alignePtr(pInfo->pSrc, pEntry->hostAlign);
 
     /* Decrement recursion counter. Note: Recursion counter will not decrement in case of error */
     pInfo->level--;
@@ -678,7 +846,7 @@ static TRDP_ERR_T marshallDs (
 /**    Unmarshall one dataset.
  *
  *  @param[in,out]  pInfo           Pointer with src & dest info
- *  @param[in]      pDataset        Pointer to one dataset
+ *  @param[in]      pEntry          Pointer to one dataset entry
  *
  *  @retval         TRDP_NO_ERR             no error
  *  @retval         TRDP_MEM_ERR            provided buffer to small
@@ -690,8 +858,9 @@ static TRDP_ERR_T marshallDs (
 
 static TRDP_ERR_T unmarshallDs (
     TAU_MARSHALL_INFO_T *pInfo,
-    TRDP_DATASET_T      *pDataset)
+    TAU_DS_ENTRY_T      *pEntry)
 {
+    TRDP_DATASET_T  *pDataset = pEntry->pDataset;
     TRDP_ERR_T  err;
     UINT16      lIndex;
     UINT32      var_size    = 0u;
@@ -705,7 +874,7 @@ static TRDP_ERR_T unmarshallDs (
         return TRDP_STATE_ERR;
     }
 
-    pDst = alignePtr(pInfo->pDst, maxAlignOfDSMember(pDataset));
+    pDst = alignePtr(pInfo->pDst, pEntry->hostAlign);
 
     /*    Loop over all datasets in the array    */
     for (lIndex = 0u; (lIndex < pDataset->numElement) && (pInfo->pSrcEnd > pInfo->pSrc); ++lIndex)
@@ -722,20 +891,14 @@ static TRDP_ERR_T unmarshallDs (
             while (noOfItems-- > 0u)
             {
                 /* Dataset, call ourself recursively */
-                /* Never used before?  */
-                if (NULL == pDataset->pElement[lIndex].pCachedDS)
-                {
-                    /* Look for it   */
-                    pDataset->pElement[lIndex].pCachedDS = findDs(pDataset->pElement[lIndex].type);
-                }
-
-                if (NULL == pDataset->pElement[lIndex].pCachedDS)      /* Not in our DB    */
+                /* Resolved by tau_initMarshall() */
+                if (NULL == pEntry->ppNested[lIndex])      /* Not in our DB    */
                 {
                     vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", pDataset->pElement[lIndex].type);
                     return TRDP_COMID_ERR;
                 }
 
-                err = unmarshallDs(pInfo, pDataset->pElement[lIndex].pCachedDS);
+                err = unmarshallDs(pInfo, pEntry->ppNested[lIndex]);
                 if (err != TRDP_NO_ERR)
                 {
                     return err;
@@ -886,7 +1049,7 @@ static TRDP_ERR_T unmarshallDs (
         }
     }
 
-    pInfo->pDst = alignePtr(pInfo->pDst, maxAlignOfDSMember(pDataset));
+    pInfo->pDst = alignePtr(pInfo->pDst, pEntry->hostAlign);
 
     if (pInfo->pSrc > pInfo->pSrcEnd)
     {
@@ -903,7 +1066,7 @@ static TRDP_ERR_T unmarshallDs (
 /**    Compute unmarshalled size of one dataset.
  *
  *  @param[in,out]  pInfo           Pointer with src & dest info
- *  @param[in]      pDataset        Pointer to one dataset
+ *  @param[in]      pEntry          Pointer to one dataset entry
  *
  *  @retval         TRDP_NO_ERR             no error
  *  @retval         TRDP_MEM_ERR            provided buffer to small
@@ -915,8 +1078,9 @@ static TRDP_ERR_T unmarshallDs (
 
 static TRDP_ERR_T size_unmarshall (
     TAU_MARSHALL_INFO_T *pInfo,
-    TRDP_DATASET_T      *pDataset)
+    TAU_DS_ENTRY_T      *pEntry)
 {
+    TRDP_DATASET_T  *pDataset = pEntry->pDataset;
     TRDP_ERR_T  err;
     UINT16      lIndex;
     UINT32      var_size    = 0u;
@@ -930,7 +1094,7 @@ static TRDP_ERR_T size_unmarshall (
         return TRDP_STATE_ERR;
     }
 
-    pDst = alignePtr(pInfo->pDst, maxAlignOfDSMember(pDataset));
+    pDst = alignePtr(pInfo->pDst, pEntry->hostAlign);
 
     /*    Loop over all datasets in the array    */
     for (lIndex = 0u; (lIndex < pDataset->numElement) && (pInfo->pSrcEnd > pInfo->pSrc); ++lIndex)
@@ -948,20 +1112,14 @@ static TRDP_ERR_T size_unmarshall (
             while (noOfItems-- > 0u)
             {
                 /* Dataset, call ourself recursively */
-                /* Never used before?  */
-                if (NULL == pDataset->pElement[lIndex].pCachedDS)
-                {
-                    /* Look for it   */
-                    pDataset->pElement[lIndex].pCachedDS = findDs(pDataset->pElement[lIndex].type);
-                }
-
-                if (NULL == pDataset->pElement[lIndex].pCachedDS)      /* Not in our DB    */
+                /* Resolved by tau_initMarshall() */
+                if (NULL == pEntry->ppNested[lIndex])      /* Not in our DB    */
                 {
                     vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", pDataset->pElement[lIndex].type);
                     return TRDP_COMID_ERR;
                 }
 
-                err = size_unmarshall(pInfo, pDataset->pElement[lIndex].pCachedDS);
+                err = size_unmarshall(pInfo, pEntry->ppNested[lIndex]);
                 if (err != TRDP_NO_ERR)
                 {
                     return err;
@@ -1078,7 +1236,7 @@ static TRDP_ERR_T size_unmarshall (
         }
     }
 
-    pInfo->pDst = alignePtr(pDst, maxAlignOfDSMember(pDataset));
+    pInfo->pDst = alignePtr(pDst, pEntry->hostAlign);
 
     if (pInfo->pSrc > pInfo->pSrcEnd)
     {
@@ -1091,210 +1249,1601 @@ static TRDP_ERR_T size_unmarshall (
     return TRDP_NO_ERR;
 }
 
-/**********************************************************************************************************************
- * GLOBAL FUNCTIONS
+/**********************************************************************************************************************/
+/**    Host and wire size of one item of a plan operation.
+ *
+ *  @param[in]      code            TAU_OP_...
+ *  @param[out]     pWireSize       Pointer to the wire size, may be NULL
+ *
+ *  @retval         host size of one item, 0 for control operations
  */
+static UINT32 planItemSize (
+    UINT8   code,
+    UINT32  *pWireSize)
+{
+    UINT32  hostSize;
+    UINT32  wireSize;
+
+    switch (code)
+    {
+       case TAU_OP_COPY:
+           hostSize = wireSize = 1u;
+           break;
+       case TAU_OP_SWAP16:
+           hostSize = wireSize = 2u;
+           break;
+       case TAU_OP_SWAP32:
+           hostSize = wireSize = 4u;
+           break;
+       case TAU_OP_SWAP64:
+       case TAU_OP_TD64:
+           hostSize = wireSize = 8u;
+           break;
+       case TAU_OP_TD48:
+           hostSize = TAU_TD48_HOST_SIZE;
+           wireSize = 6u;
+           break;
+       default:
+           hostSize = wireSize = 0u;
+           break;
+    }
+    if (pWireSize != NULL)
+    {
+        *pWireSize = wireSize;
+    }
+    return hostSize;
+}
 
 /**********************************************************************************************************************/
-/**    Function to initialise the marshalling/unmarshalling.
- *    The supplied array must be sorted by ComIds. The array must exist during the use of the marshalling
- *    functions (until tlc_terminate()).
- *
- *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
- *  @param[in]      numComId         Number of datasets found in the configuration
- *  @param[in]      pComIdDsIdMap    Pointer to an array of structures of type TRDP_DATASET_T
- *  @param[in]      numDataSet       Number of datasets found in the configuration
- *  @param[in]      pDataset         Pointer to an array of pointers to structures of type TRDP_DATASET_T
+/**    Map a primitive element type to a plan operation.
  *
- *  @retval         TRDP_NO_ERR      no error
- *  @retval         TRDP_MEM_ERR     provided buffer to small
- *  @retval         TRDP_PARAM_ERR   Parameter error
+ *  @param[in]      type            TRDP_BOOL8 ... TRDP_TIMEDATE64
+ *  @param[in]      fixed           The element has a fixed number of items
+ *  @param[out]     pCode           Pointer to the operation
+ *  @param[out]     pAlign          Pointer to the host alignment
+ *  @param[out]     pPerItem        Pointer to the operation items per element item
  *
+ *  @retval         TRUE if the type sets the size of a following variable sized element
  */
-
-EXT_DECL TRDP_ERR_T tau_initMarshall (
-    void                    * *ppRefCon,
-    UINT32                  numComId,
-    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap,
-    UINT32                  numDataSet,
-    TRDP_DATASET_T          *pDataset[])
+static BOOL8 planPrimitive (
+    UINT32  type,
+    BOOL8   fixed,
+    UINT8   *pCode,
+    UINT32  *pAlign,
+    UINT32  *pPerItem)
 {
-    UINT32 i, j;
+    BOOL8 isVarSource = FALSE;
 
-    ppRefCon = ppRefCon;
-
-    if ((pDataset == NULL) || (numDataSet == 0u) || (numComId == 0u) || (pComIdDsIdMap == NULL))
+    *pPerItem = 1u;
+    switch (type)
     {
-        return TRDP_PARAM_ERR;
+       case TRDP_BOOL8:
+       case TRDP_CHAR8:
+       case TRDP_INT8:
+       case TRDP_UINT8:
+           *pCode       = TAU_OP_COPY;
+           *pAlign      = 1u;
+           isVarSource  = TRUE;
+           break;
+       case TRDP_UTF16:
+       case TRDP_INT16:
+       case TRDP_UINT16:
+           *pCode       = TAU_OP_SWAP16;
+           *pAlign      = ALIGNOF(UINT16);
+           isVarSource  = TRUE;
+           break;
+       case TRDP_INT32:
+       case TRDP_UINT32:
+       case TRDP_REAL32:
+       case TRDP_TIMEDATE32:
+           *pCode       = TAU_OP_SWAP32;
+           *pAlign      = ALIGNOF(UINT32);
+           isVarSource  = TRUE;
+           break;
+       case TRDP_TIMEDATE48:
+           *pCode       = TAU_OP_TD48;
+           *pAlign      = ALIGNOF(TIMEDATE48_STRUCT_T);
+           break;
+       case TRDP_TIMEDATE64:
+           /* two 32 bit values, a fixed number is handled as a run of UINT32 */
+           *pCode       = (fixed == TRUE) ? TAU_OP_SWAP32 : TAU_OP_TD64;
+           *pAlign      = ALIGNOF(TIMEDATE64_STRUCT_T);
+           *pPerItem    = (fixed == TRUE) ? 2u : 1u;
+           break;
+       default:     /* TRDP_INT64, TRDP_UINT64, TRDP_REAL64 */
+           *pCode       = TAU_OP_SWAP64;
+           *pAlign      = ALIGNOF(UINT64);
+           break;
     }
+    return isVarSource;
+}
 
-    /*    Save the pointer to the comId mapping table    */
-    sComIdDsIdMap   = pComIdDsIdMap;
-    sNumComId       = numComId;
-
-    /* sort the table    */
-    vos_qsort(pComIdDsIdMap, numComId, sizeof(TRDP_COMID_DSID_MAP_T), compareComId);
+/**********************************************************************************************************************/
+/**    Check if a dataset is one run of equal items without padding, e.g. a structure of UINT32.
+ *
+ *  @param[in]      pEntry          Pointer to the dataset entry
+ *  @param[in]      level           Nesting level
+ *  @param[out]     pCode           Pointer to the operation
+ *  @param[out]     pAlign          Pointer to the host alignment
+ *  @param[out]     pNoOfItems      Pointer to the number of items
+ *
+ *  @retval         TRUE if the dataset can be handled by a single operation
+ */
+static BOOL8 planUniform (
+    TAU_DS_ENTRY_T  *pEntry,
+    UINT32          level,
+    UINT8           *pCode,
+    UINT32          *pAlign,
+    UINT32          *pNoOfItems)
+{
+    UINT16  lIndex;
+    UINT8   code;
+    UINT32  align;
+    UINT32  noOfItems;
 
-    /*    Save the pointer to the table    */
-    sDataSets   = pDataset;
-    sNumEntries = numDataSet;
+    if ((pEntry == NULL) || (level > TAU_MAX_DS_LEVEL) || (pEntry->pDataset->numElement == 0u))
+    {
+        return FALSE;
+    }
 
-    /* invalidate the cache */
-    for (i = 0u; i < numDataSet; i++)
+    *pNoOfItems = 0u;
+    for (lIndex = 0u; lIndex < pEntry->pDataset->numElement; ++lIndex)
     {
-        for (j = 0u; j < pDataset[i]->numElement; j++)
+        UINT32 type = pEntry->pDataset->pElement[lIndex].type;
+        UINT32 size = pEntry->pDataset->pElement[lIndex].size;
+
+        if ((size == TRDP_VAR_SIZE) || (size > 0xFFFFu))
         {
-            pDataset[i]->pElement[j].pCachedDS = NULL;
+            return FALSE;
+        }
+        if (type > (UINT32) TRDP_TYPE_MAX)
+        {
+            if (planUniform(pEntry->ppNested[lIndex], level + 1u, &code, &align, &noOfItems) == FALSE)
+            {
+                return FALSE;
+            }
+        }
+        else if ((type >= TRDP_BOOL8) && (type <= TRDP_TIMEDATE64))
+        {
+            (void) planPrimitive(type, TRUE, &code, &align, &noOfItems);
+        }
+        else
+        {
+            return FALSE;
         }
-    }
-    /* sort the table    */
-    vos_qsort(pDataset, numDataSet, sizeof(TRDP_DATASET_T *), compareDataset);
 
-    return TRDP_NO_ERR;
+        if ((lIndex > 0u) && ((code != *pCode) || (align != *pAlign)))
+        {
+            return FALSE;
+        }
+        *pCode          = code;
+        *pAlign         = align;
+        *pNoOfItems    += size * noOfItems;
+        if (*pNoOfItems > 0xFFFFu)
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
 }
 
 /**********************************************************************************************************************/
-/**    marshall function.
- *
- *  @param[in]      pRefCon         pointer to user context
- *  @param[in]      comId           ComId to identify the structure out of a configuration
- *  @param[in]      pSrc            pointer to received original message
- *  @param[in]      srcSize         size of the source buffer
- *  @param[in]      pDest           pointer to a buffer for the treated message
- *  @param[in,out]  pDestSize       size of the provide buffer / size of the treated message
- *  @param[in,out]  ppDSPointer     pointer to pointer to cached dataset
- *                                  set NULL if not used, set content NULL if unknown
+/**    Current guaranteed alignment of the host position while building a plan.
  *
- *  @retval         TRDP_NO_ERR             no error
- *  @retval         TRDP_MEM_ERR            provided buffer to small
- *  @retval         TRDP_PARAM_ERR          Parameter error
- *  @retval         TRDP_STATE_ERR          Too deep recursion
- *  @retval         TRDP_MARSHALLING_ERR    dataset/source size mismatch
+ *  @param[in]      pBuild          Pointer to the build state
  *
+ *  @retval         1, 2, 4, 8
  */
-
-EXT_DECL TRDP_ERR_T tau_marshall (
-    void            *pRefCon,
-    UINT32          comId,
-    UINT8           *pSrc,
-    UINT32          srcSize,
-    UINT8           *pDest,
-    UINT32          *pDestSize,
-    TRDP_DATASET_T  * *ppDSPointer)
+static UINT32 planCurAlign (
+    const TAU_PLAN_BUILD_T *pBuild)
 {
-    TRDP_ERR_T          err;
-    TRDP_DATASET_T      *pDataset;
-    TAU_MARSHALL_INFO_T info;
-
-    pRefCon = pRefCon;
+    UINT32 align = pBuild->hostAlign;
 
-    if ((0u == comId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
+    if (pBuild->known == FALSE)
     {
-        return TRDP_PARAM_ERR;
+        return pBuild->aligned;
     }
-
-    /* Can we use the formerly cached value? */
-    if (NULL != ppDSPointer)
+    while ((align > 1u) && ((pBuild->offset & (align - 1u)) != 0u))
     {
-        if (NULL == *ppDSPointer)
-        {
-            *ppDSPointer = findDSFromComId(comId);
-        }
-        pDataset = *ppDSPointer;
+        align >>= 1u;
     }
-    else
+    return align;
+}
+
+/**********************************************************************************************************************/
+/**    Align the host position while building a plan.
+ *  A known offset is padded statically, otherwise the alignment is done at run time by the next operation.
+ *
+ *  @param[in,out]  pBuild          Pointer to the build state
+ *  @param[in]      align           1, 2, 4, 8
+ *
+ *  @retval         none
+ */
+static void planAlign (
+    TAU_PLAN_BUILD_T    *pBuild,
+    UINT32              align)
+{
+    if (align <= 1u)
     {
-        pDataset = findDSFromComId(comId);
+        return;
     }
+    if (pBuild->known == TRUE)
+    {
+        UINT32 offset = (pBuild->offset + align - 1u) & ~(align - 1u);
 
-    if (NULL == pDataset)   /* Not in our DB    */
+        pBuild->pad     += offset - pBuild->offset;
+        pBuild->offset  = offset;
+    }
+    else if (pBuild->aligned < align)
     {
-        vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", comId);
-        return TRDP_COMID_ERR;
+        if (pBuild->align < align)
+        {
+            pBuild->align = align;
+        }
+        pBuild->aligned = align;
     }
-
-    info.level      = 0u;
-    info.pSrc       = pSrc;
-    info.pSrcEnd    = pSrc + srcSize;
-    info.pDst       = pDest;
-    info.pDstEnd    = pDest + *pDestSize;
-
-    err = marshallDs(&info, pDataset);
-
-    *pDestSize = (UINT32) (info.pDst - pDest);
-
-    return err;
 }
 
 /**********************************************************************************************************************/
-/**    unmarshall function.
- *
- *  @param[in]      pRefCon         pointer to user context
- *  @param[in]      comId           ComId to identify the structure out of a configuration
- *  @param[in]      pSrc            pointer to received original message
- *  @param[in]      srcSize         size of the source buffer
- *  @param[in]      pDest           pointer to a buffer for the treated message
- *  @param[in,out]  pDestSize       size of the provide buffer / size of the treated message
- *  @param[in,out]  ppDSPointer     pointer to pointer to cached dataset
- *                                  set NULL if not used, set content NULL if unknown
+/**    Append an operation to a plan.
+ *  Consecutive runs of the same kind are merged into one.
  *
- *  @retval         TRDP_INIT_ERR           marshalling not initialised
- *  @retval         TRDP_NO_ERR             no error
- *  @retval         TRDP_MEM_ERR            provided buffer to small
- *  @retval         TRDP_PARAM_ERR          Parameter error
- *  @retval         TRDP_STATE_ERR          Too deep recursion
- *  @retval         TRDP_COMID_ERR          comid not existing
- *  @retval         TRDP_MARSHALLING_ERR    dataset/source size mismatch
+ *  @param[in,out]  pBuild          Pointer to the build state
+ *  @param[in]      code            TAU_OP_...
+ *  @param[in]      count           Number of items or repetitions
+ *  @param[in]      useVar          0 or variable size giving the count
+ *  @param[in]      setVar          0 or variable size set by this operation
  *
+ *  @retval         pointer to the operation, NULL if the plan is too large
  */
-
-EXT_DECL TRDP_ERR_T tau_unmarshall (
-    void            *pRefCon,
-    UINT32          comId,
-    UINT8           *pSrc,
-    UINT32          srcSize,
-    UINT8           *pDest,
-    UINT32          *pDestSize,
-    TRDP_DATASET_T  * *ppDSPointer)
+static TAU_PLAN_OP_T *planEmit (
+    TAU_PLAN_BUILD_T    *pBuild,
+    UINT8               code,
+    UINT32              count,
+    UINT8               useVar,
+    UINT8               setVar)
 {
-    TRDP_ERR_T          err;
-    TRDP_DATASET_T      *pDataset;
-    TAU_MARSHALL_INFO_T info;
-
-    pRefCon = pRefCon;
+    TAU_PLAN_OP_T   *pOp        = NULL;
+    UINT32          hostSize    = planItemSize(code, NULL);
 
-    if ((0u == comId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
+    if (count > 0xFFFFFFu)
     {
-        return TRDP_PARAM_ERR;
+        return NULL;
     }
-
-    /* Can we use the formerly cached value? */
-    if (NULL != ppDSPointer)
+    if (pBuild->noOfOps > 0u)
     {
-        if (NULL == *ppDSPointer)
+        pOp = &pBuild->pOps[pBuild->noOfOps - 1u];
+        if ((pOp->code != code) || (hostSize == 0u) || (pBuild->pad != 0u) || (pBuild->align > 1u) ||
+            (useVar != 0u) || (setVar != 0u) || (pOp->useVar != 0u) || (pOp->setVar != 0u))
         {
-            *ppDSPointer = findDSFromComId(comId);
+            pOp = NULL;
         }
-        pDataset = *ppDSPointer;
+    }
+
+    if (pOp != NULL)
+    {
+        pOp->count += count;
     }
     else
     {
-        pDataset = findDSFromComId(comId);
+        if (pBuild->noOfOps >= pBuild->maxOps)
+        {
+            return NULL;
+        }
+        pOp             = &pBuild->pOps[pBuild->noOfOps++];
+        pOp->code       = code;
+        pOp->hostPad    = (UINT8) pBuild->pad;
+        pOp->hostAlign  = (UINT8) ((pBuild->align > 1u) ? pBuild->align : 1u);
+        pOp->setVar     = setVar;
+        pOp->useVar     = useVar;
+        pOp->count      = count;
     }
+    pBuild->pad     = 0u;
+    pBuild->align   = 1u;
 
-    if (NULL == pDataset)   /* Not in our DB    */
+    if (hostSize == 0u)
+    {
+        /* Control operation, the caller updates the state */
+    }
+    else if (useVar != 0u)
+    {
+        /* The host offset is unknown from now on */
+        UINT32 align = planCurAlign(pBuild);
+
+        while ((align > 1u) && ((hostSize & (align - 1u)) != 0u))
+        {
+            align >>= 1u;
+        }
+        pBuild->known   = FALSE;
+        pBuild->aligned = align;
+    }
+    else if (pBuild->known == TRUE)
+    {
+        pBuild->offset += count * hostSize;
+    }
+    else
+    {
+        while ((pBuild->aligned > 1u) && (((count * hostSize) & (pBuild->aligned - 1u)) != 0u))
+        {
+            pBuild->aligned >>= 1u;
+        }
+    }
+    return pOp;
+}
+
+static BOOL8 planCompileDs (
+    TAU_PLAN_BUILD_T    *pBuild,
+    TAU_DS_ENTRY_T      *pEntry,
+    UINT32              level);
+
+/**********************************************************************************************************************/
+/**    Build the operations of a nested dataset element.
+ *  Datasets consisting of equal items become one run, small ones are unrolled, all others are repeated.
+ *
+ *  @param[in,out]  pBuild          Pointer to the build state
+ *  @param[in]      pEntry          Pointer to the nested dataset entry
+ *  @param[in]      count           Number of repetitions, if useVar is 0
+ *  @param[in]      useVar          0 or variable size giving the number of repetitions
+ *  @param[in]      level           Nesting level of the nested dataset
+ *
+ *  @retval         TRUE if successful
+ */
+static BOOL8 planCompileNested (
+    TAU_PLAN_BUILD_T    *pBuild,
+    TAU_DS_ENTRY_T      *pEntry,
+    UINT32              count,
+    UINT8               useVar,
+    UINT32              level)
+{
+    TAU_PLAN_BUILD_T    saved = *pBuild;
+    TAU_PLAN_OP_T       lastOp;
+    UINT8               code;
+    UINT32              align;
+    UINT32              noOfItems;
+    UINT32              dsAlign;
+    UINT32              i;
+
+    if (pEntry == NULL)
+    {
+        return FALSE;
+    }
+    if (useVar == 0u)
+    {
+        if (planUniform(pEntry, level, &code, &align, &noOfItems) == TRUE)
+        {
+            planAlign(pBuild, align);
+            return (planEmit(pBuild, code, count * noOfItems, 0u, 0u) != NULL) ? TRUE : FALSE;
+        }
+
+        /* Try to unroll, the last operation may get merged */
+        if (pBuild->noOfOps > 0u)
+        {
+            lastOp = pBuild->pOps[pBuild->noOfOps - 1u];
+        }
+        if (planCompileDs(pBuild, pEntry, level) == FALSE)
+        {
+            return FALSE;
+        }
+        if ((count <= TAU_PLAN_UNROLL_OPS) &&
+            (count * (pBuild->noOfOps - saved.noOfOps) <= TAU_PLAN_UNROLL_OPS))
+        {
+            for (i = 1u; i < count; i++)
+            {
+                if (planCompileDs(pBuild, pEntry, level) == FALSE)
+                {
+                    return FALSE;
+                }
+            }
+            return TRUE;
+        }
+        *pBuild = saved;
+        if (pBuild->noOfOps > 0u)
+        {
+            pBuild->pOps[pBuild->noOfOps - 1u] = lastOp;
+        }
+    }
+
+    dsAlign = pEntry->hostAlign;
+    if (planEmit(pBuild, TAU_OP_REPEAT, count, useVar, 0u) == NULL)
+    {
+        return FALSE;
+    }
+
+    /* Every repetition but the first starts aligned to the dataset */
+    align           = planCurAlign(pBuild);
+    pBuild->known   = FALSE;
+    pBuild->aligned = (align < dsAlign) ? align : dsAlign;
+
+    if ((planCompileDs(pBuild, pEntry, level) == FALSE) ||
+        (planEmit(pBuild, TAU_OP_END, 0u, 0u, 0u) == NULL))
+    {
+        return FALSE;
+    }
+    pBuild->known   = FALSE;
+    pBuild->aligned = dsAlign;
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/**    Build the operations of one dataset.
+ *  Mirrors the alignment rules of marshallDs() and unmarshallDs().
+ *
+ *  @param[in,out]  pBuild          Pointer to the build state
+ *  @param[in]      pEntry          Pointer to the dataset entry
+ *  @param[in]      level           Nesting level
+ *
+ *  @retval         TRUE if successful
+ *  @retval         FALSE if the dataset has to be interpreted
+ */
+static BOOL8 planCompileDs (
+    TAU_PLAN_BUILD_T    *pBuild,
+    TAU_DS_ENTRY_T      *pEntry,
+    UINT32              level)
+{
+    TRDP_DATASET_T  *pDataset = pEntry->pDataset;
+    UINT16          lIndex;
+    UINT32          dsAlign;
+    UINT32          pending;
+    UINT8           varSlot = 0u;
+
+    if ((level > TAU_MAX_DS_LEVEL) || (pDataset->numElement == 0u))
+    {
+        return FALSE;
+    }
+
+    /* The dataset alignment applies at the first element, unless this is a nested dataset */
+    dsAlign = pEntry->hostAlign;
+    pending = dsAlign;
+
+    for (lIndex = 0u; lIndex < pDataset->numElement; ++lIndex)
+    {
+        UINT32  type    = pDataset->pElement[lIndex].type;
+        UINT32  size    = pDataset->pElement[lIndex].size;
+        UINT8   useVar  = 0u;
+
+        if (size == TRDP_VAR_SIZE)
+        {
+            if (varSlot == 0u)
+            {
+                return FALSE;
+            }
+            useVar = varSlot;
+        }
+        else if (size > 0xFFFFu)
+        {
+            return FALSE;
+        }
+
+        if (type > (UINT32) TRDP_TYPE_MAX)
+        {
+            pending = 1u;
+            if (planCompileNested(pBuild, pEntry->ppNested[lIndex], size, useVar, level + 1u) == FALSE)
+            {
+                return FALSE;
+            }
+        }
+        else if ((type >= TRDP_BOOL8) && (type <= TRDP_TIMEDATE64))
+        {
+            UINT8   code;
+            UINT32  align;
+            UINT32  perItem;
+            UINT8   setVar = 0u;
+
+            planAlign(pBuild, pending);
+            pending = 1u;
+
+            if (planPrimitive(type, (useVar == 0u) ? TRUE : FALSE, &code, &align, &perItem) == TRUE)
+            {
+                /* Does a variable sized element follow, before the next possible size element? */
+                UINT16 next;
+
+                for (next = lIndex + 1u; next < pDataset->numElement; ++next)
+                {
+                    UINT32 nextType = pDataset->pElement[next].type;
+
+                    if (pDataset->pElement[next].size == TRDP_VAR_SIZE)
+                    {
+                        if (pBuild->noOfVars >= TAU_PLAN_MAX_VARS)
+                        {
+                            return FALSE;
+                        }
+                        setVar = (UINT8) ++pBuild->noOfVars;
+                        break;
+                    }
+                    if ((nextType >= TRDP_BOOL8) && (nextType <= TRDP_TIMEDATE32))
+                    {
+                        break;
+                    }
+                }
+                varSlot = setVar;
+            }
+
+            planAlign(pBuild, align);
+            if (planEmit(pBuild, code, size * perItem, useVar, setVar) == NULL)
+            {
+                return FALSE;
+            }
+        }
+        else
+        {
+            return FALSE;
+        }
+    }
+
+    /* Align to possible next dataset */
+    planAlign(pBuild, dsAlign);
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/**    Find the end of a block of operations that can be fused.
+ *  Short fixed size operations follow each other, only the first one may need run time alignment.
+ *
+ *  @param[in]      pOps            Pointer to the operations
+ *  @param[in]      start           First operation of the block
+ *  @param[out]     pHostSize       Pointer to the host size of the block
+ *  @param[out]     pWireSize       Pointer to the wire size of the block
+ *  @param[out]     pNoOfItems      Pointer to the number of items of the block
+ *
+ *  @retval         index behind the last operation of the block
+ */
+static UINT32 planBlockEnd (
+    const TAU_PLAN_OP_T *pOps,
+    UINT32              start,
+    UINT32              *pHostSize,
+    UINT32              *pWireSize,
+    UINT32              *pNoOfItems)
+{
+    UINT32 end;
+
+    *pHostSize  = 0u;
+    *pWireSize  = 0u;
+    *pNoOfItems = 0u;
+    for (end = start; ; end++)
+    {
+        const TAU_PLAN_OP_T *pOp = &pOps[end];
+        UINT32              hostSize;
+        UINT32              wireSize;
+        UINT32              pad = (end == start) ? 0u : pOp->hostPad;
+
+        if ((pOp->code > TAU_OP_TD48) || (pOp->useVar != 0u) || (pOp->setVar != 0u) ||
+            (pOp->count > TAU_PLAN_FUSE_ITEMS) || ((end != start) && (pOp->hostAlign > 1u)))
+        {
+            return end;
+        }
+        hostSize = planItemSize(pOp->code, &wireSize);
+        if ((*pHostSize + pad + pOp->count * hostSize) > 0xFFFFu)
+        {
+            return end;
+        }
+        *pHostSize  += pad + pOp->count * hostSize;
+        *pWireSize  += pOp->count * wireSize;
+        *pNoOfItems += (pOp->code == TAU_OP_TD48) ? (2u * pOp->count) : pOp->count;
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Fuse consecutive short operations of a plan into blocks.
+ *  The operations are replaced in place by TAU_OP_BLOCK, the blocks and their items are allocated for the entry.
+ *  Without memory the plan is kept unfused.
+ *
+ *  @param[in,out]  pEntry          Pointer to the dataset entry
+ *  @param[in,out]  pOps            Pointer to the operations, ending with TAU_OP_DONE
+ *  @param[in,out]  pNoOfOps        Pointer to the number of operations
+ *
+ *  @retval         none
+ */
+static void planFuse (
+    TAU_DS_ENTRY_T  *pEntry,
+    TAU_PLAN_OP_T   *pOps,
+    UINT32          *pNoOfOps)
+{
+    static const UINT8  kind[] = {0u, 1u, 2u, 3u, 2u};     /* item size index of TAU_OP_COPY ... TAU_OP_TD48 */
+    UINT32              noOfBlocks  = 0u;
+    UINT32              noOfItems   = 0u;
+    UINT32              hostSize;
+    UINT32              wireSize;
+    UINT32              items;
+    UINT32              i;
+    UINT32              end;
+    UINT32              out;
+
+    for (i = 0u; i < *pNoOfOps; i = (end > i + 1u) ? end : (i + 1u))
+    {
+        end = planBlockEnd(pOps, i, &hostSize, &wireSize, &items);
+        if (end > i + 1u)
+        {
+            noOfBlocks++;
+            noOfItems += items;
+        }
+    }
+    if (noOfBlocks == 0u)
+    {
+        return;
+    }
+    pEntry->pBlocks = (TAU_PLAN_BLOCK_T *) vos_memAlloc(noOfBlocks * sizeof(TAU_PLAN_BLOCK_T));
+    pEntry->pItems  = (TAU_PLAN_ITEM_T *) vos_memAlloc(noOfItems * sizeof(TAU_PLAN_ITEM_T));
+    if ((pEntry->pBlocks == NULL) || (pEntry->pItems == NULL))
+    {
+        if (pEntry->pBlocks != NULL)
+        {
+            vos_memFree(pEntry->pBlocks);
+            pEntry->pBlocks = NULL;
+        }
+        if (pEntry->pItems != NULL)
+        {
+            vos_memFree(pEntry->pItems);
+            pEntry->pItems = NULL;
+        }
+        return;
+    }
+
+    noOfBlocks  = 0u;
+    noOfItems   = 0u;
+    out         = 0u;
+    for (i = 0u; i < *pNoOfOps; i = end)
+    {
+        TAU_PLAN_BLOCK_T    *pBlock = &pEntry->pBlocks[noOfBlocks];
+        UINT32              k;
+        UINT32              j;
+
+        end = planBlockEnd(pOps, i, &hostSize, &wireSize, &items);
+        if (end <= i + 1u)
+        {
+            pOps[out++] = pOps[i];
+            end         = i + 1u;
+            continue;
+        }
+
+        pBlock->hostSize    = hostSize;
+        pBlock->wireSize    = wireSize;
+        pBlock->first       = noOfItems;
+
+        /* Items sorted by size, a TIMEDATE48 gives a 32 and a 16 bit item */
+        for (k = 0u; k < 4u; k++)
+        {
+            UINT32 first = noOfItems;
+
+            hostSize = 0u;
+            wireSize = 0u;
+            for (j = i; j < end; j++)
+            {
+                UINT32 itemWire;
+                UINT32 itemHost = planItemSize(pOps[j].code, &itemWire);
+                UINT32 n;
+
+                hostSize += (j == i) ? 0u : pOps[j].hostPad;
+                for (n = 0u; n < pOps[j].count; n++)
+                {
+                    UINT32 host = hostSize + n * itemHost;
+                    UINT32 wire = wireSize + n * itemWire;
+
+                    if (kind[pOps[j].code] == k)
+                    {
+                        pEntry->pItems[noOfItems].offset[0] = (UINT16) host;
+                        pEntry->pItems[noOfItems].offset[1] = (UINT16) wire;
+                        noOfItems++;
+                    }
+                    if ((pOps[j].code == TAU_OP_TD48) && (k == 1u))
+                    {
+                        pEntry->pItems[noOfItems].offset[0] = (UINT16) (host + sizeof(UINT32));
+                        pEntry->pItems[noOfItems].offset[1] = (UINT16) (wire + sizeof(UINT32));
+                        noOfItems++;
+                    }
+                }
+                hostSize += pOps[j].count * itemHost;
+                wireSize += pOps[j].count * itemWire;
+            }
+            pBlock->noOfItems[k] = (UINT16) (noOfItems - first);
+        }
+
+        pOps[out]       = pOps[i];
+        pOps[out].code  = TAU_OP_BLOCK;
+        pOps[out].count = noOfBlocks++;
+        out++;
+    }
+    *pNoOfOps = out;
+}
+
+/**********************************************************************************************************************/
+/**    Build the plan of one dataset.
+ *  Datasets which cannot be compiled (unknown types, missing nested datasets, too large) stay interpreted.
+ *
+ *  @param[in,out]  pEntry          Pointer to the dataset entry
+ *  @param[in]      pScratch        Pointer to TAU_PLAN_MAX_OPS operations to build the plan in
+ *
+ *  @retval         none
+ */
+static void planBuild (
+    TAU_DS_ENTRY_T  *pEntry,
+    TAU_PLAN_OP_T   *pScratch)
+{
+    TAU_PLAN_BUILD_T build;
+
+    build.pOps      = pScratch;
+    build.maxOps    = TAU_PLAN_MAX_OPS - 1u;    /* room for TAU_OP_DONE */
+    build.noOfOps   = 0u;
+    build.noOfVars  = 0u;
+    build.hostAlign = pEntry->hostAlign;
+    build.known     = TRUE;
+    build.offset    = 0u;
+    build.aligned   = pEntry->hostAlign;
+    build.pad       = 0u;
+    build.align     = 1u;
+
+    if (planCompileDs(&build, pEntry, 1u) == TRUE)
+    {
+        build.maxOps++;
+        (void) planEmit(&build, TAU_OP_DONE, 0u, 0u, 0u);
+        planFuse(pEntry, build.pOps, &build.noOfOps);
+        pEntry->pOps = (TAU_PLAN_OP_T *) vos_memAlloc(build.noOfOps * sizeof(TAU_PLAN_OP_T));
+        if (pEntry->pOps != NULL)
+        {
+            memcpy(pEntry->pOps, build.pOps, build.noOfOps * sizeof(TAU_PLAN_OP_T));
+            pEntry->noOfOps = build.noOfOps;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Run a block of fused operations, the size of the buffers has been checked.
+ *
+ *  @param[in]      pEntry          Pointer to the dataset entry
+ *  @param[in]      pBlock          Pointer to the block
+ *  @param[in,out]  pHost           Pointer to the host data of the block
+ *  @param[in,out]  pWire           Pointer to the wire data of the block
+ *  @param[in]      marshall        TRUE: host to wire, FALSE: wire to host
+ *
+ *  @retval         none
+ */
+static void planRunBlock (
+    const TAU_DS_ENTRY_T    *pEntry,
+    const TAU_PLAN_BLOCK_T  *pBlock,
+    UINT8                   *pHost,
+    UINT8                   *pWire,
+    BOOL8                   marshall)
+{
+    const TAU_PLAN_ITEM_T   *pItem  = &pEntry->pItems[pBlock->first];
+    UINT8                   *pTo    = (marshall == TRUE) ? pWire : pHost;
+    const UINT8             *pFrom  = (marshall == TRUE) ? pHost : pWire;
+    UINT32                  from    = (marshall == TRUE) ? 0u : 1u;
+    UINT32                  to      = 1u - from;
+    UINT32                  i;
+    UINT16                  val16;
+    UINT32                  val32;
+    UINT64                  val64;
+
+    for (i = pBlock->noOfItems[0]; i > 0u; i--, pItem++)
+    {
+        pTo[pItem->offset[to]] = pFrom[pItem->offset[from]];
+    }
+    for (i = pBlock->noOfItems[1]; i > 0u; i--, pItem++)
+    {
+        TAU_COPY(&val16, pFrom + pItem->offset[from], sizeof(UINT16));
+        val16 = TAU_NET16(val16);
+        TAU_COPY(pTo + pItem->offset[to], &val16, sizeof(UINT16));
+    }
+    for (i = pBlock->noOfItems[2]; i > 0u; i--, pItem++)
+    {
+        TAU_COPY(&val32, pFrom + pItem->offset[from], sizeof(UINT32));
+        val32 = TAU_NET32(val32);
+        TAU_COPY(pTo + pItem->offset[to], &val32, sizeof(UINT32));
+    }
+    for (i = pBlock->noOfItems[3]; i > 0u; i--, pItem++)
+    {
+        TAU_COPY(&val64, pFrom + pItem->offset[from], sizeof(UINT64));
+        val64 = TAU_NET64(val64);
+        TAU_COPY(pTo + pItem->offset[to], &val64, sizeof(UINT64));
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Check that items fit into the rest of a buffer.
+ *
+ *  @param[in]      p               Current position
+ *  @param[in]      pEnd            End of the buffer
+ *  @param[in]      noOfItems       Number of items, variable counts may be as large as 32 bits
+ *  @param[in]      size            Size of one item
+ *
+ *  @retval         TRUE if the items fit
+ */
+static INLINE BOOL8 planFits (
+    const UINT8 *p,
+    const UINT8 *pEnd,
+    UINT32      noOfItems,
+    UINT32      size)
+{
+    return ((p <= pEnd) && (((UINT64) noOfItems * size) <= (UINT64) (pEnd - p))) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/**    Run a compiled plan from host to wire.
+ *  Any run time condition the plan does not cover (misaligned host buffer, empty variable array, buffer too small)
+ *  makes it return FALSE before reporting a result, the caller then uses the interpreter which handles the error
+ *  cases exactly as before.
+ *  Like marshallDs() the operations are handled by one switch, items are copied in place without helper calls.
+ *
+ *  @param[in]      pEntry          Pointer to the dataset entry with the plan
+ *  @param[in]      pSrc            Pointer to the host data
+ *  @param[in]      srcSize         Size of the host data
+ *  @param[in]      pDest           Pointer to the wire buffer
+ *  @param[in,out]  pDestSize       Size of the wire buffer / size of the result
+ *
+ *  @retval         TRUE if done
+ */
+static BOOL8 planMarshall (
+    const TAU_DS_ENTRY_T    *pEntry,
+    UINT8                   *pSrc,
+    UINT32                  srcSize,
+    UINT8                   *pDest,
+    UINT32                  *pDestSize)
+{
+    struct
+    {
+        const TAU_PLAN_OP_T *pRepeat;
+        UINT32              left;
+    }                       loop[TAU_MAX_DS_LEVEL + 1];
+    UINT32                  depth       = 0u;
+    UINT32                  var[TAU_PLAN_MAX_VARS];
+    const TAU_PLAN_OP_T     *pOp;
+    const TAU_PLAN_BLOCK_T  *pBlock;
+    UINT8                   *pHost      = pSrc;
+    UINT8                   *pHostEnd   = pSrc + srcSize;
+    UINT8                   *pWire      = pDest;
+    UINT8                   *pWireEnd   = pDest + *pDestSize;
+    UINT32                  i;
+    UINT16                  val16;
+    UINT32                  val32;
+    UINT64                  val64;
+
+    if (((uintptr_t) pHost & (pEntry->hostAlign - 1u)) != 0u)
+    {
+        return FALSE;
+    }
+
+    for (pOp = pEntry->pOps;; pOp++)
+    {
+        UINT32 count = pOp->count;
+
+        if (pOp->useVar != 0u)
+        {
+            count = var[pOp->useVar - 1u];
+            if (count == 0u)
+            {
+                return FALSE;
+            }
+        }
+        pHost += pOp->hostPad;
+        if (pOp->hostAlign > 1u)
+        {
+            pHost = alignePtr(pHost, pOp->hostAlign);
+        }
+
+        switch (pOp->code)
+        {
+           case TAU_OP_COPY:
+               if ((planFits(pHost, pHostEnd, count, 1u) == FALSE) || (planFits(pWire, pWireEnd, count, 1u) == FALSE))
+               {
+                   return FALSE;
+               }
+               /* Like the interpreter: the first item gives the size of a following variable element */
+               if (pOp->setVar != 0u)
+               {
+                   var[pOp->setVar - 1u] = *pHost;
+               }
+               for (i = 0u; i < count; i++)
+               {
+                   *pWire++ = *pHost++;
+               }
+               break;
+           case TAU_OP_SWAP16:
+               if ((planFits(pHost, pHostEnd, count, 2u) == FALSE) || (planFits(pWire, pWireEnd, count, 2u) == FALSE))
+               {
+                   return FALSE;
+               }
+               if (pOp->setVar != 0u)
+               {
+                   TAU_COPY(&val16, pHost, sizeof(UINT16));
+                   var[pOp->setVar - 1u] = val16;
+               }
+               for (i = 0u; i < count; i++)
+               {
+                   TAU_COPY(&val16, pHost, sizeof(UINT16));
+                   val16 = TAU_NET16(val16);
+                   TAU_COPY(pWire, &val16, sizeof(UINT16));
+                   pHost   += sizeof(UINT16);
+                   pWire   += sizeof(UINT16);
+               }
+               break;
+           case TAU_OP_TD64:
+               count *= 2u;     /* two 32 bit values */
+               /* FALLTHRU */
+           case TAU_OP_SWAP32:
+               if ((planFits(pHost, pHostEnd, count, 4u) == FALSE) || (planFits(pWire, pWireEnd, count, 4u) == FALSE))
+               {
+                   return FALSE;
+               }
+               if (pOp->setVar != 0u)
+               {
+                   TAU_COPY(&val32, pHost, sizeof(UINT32));
+                   var[pOp->setVar - 1u] = val32;
+               }
+               for (i = 0u; i < count; i++)
+               {
+                   TAU_COPY(&val32, pHost, sizeof(UINT32));
+                   val32 = TAU_NET32(val32);
+                   TAU_COPY(pWire, &val32, sizeof(UINT32));
+                   pHost   += sizeof(UINT32);
+                   pWire   += sizeof(UINT32);
+               }
+               break;
+           case TAU_OP_SWAP64:
+               if ((planFits(pHost, pHostEnd, count, 8u) == FALSE) || (planFits(pWire, pWireEnd, count, 8u) == FALSE))
+               {
+                   return FALSE;
+               }
+               for (i = 0u; i < count; i++)
+               {
+                   TAU_COPY(&val64, pHost, sizeof(UINT64));
+                   val64 = TAU_NET64(val64);
+                   TAU_COPY(pWire, &val64, sizeof(UINT64));
+                   pHost   += sizeof(UINT64);
+                   pWire   += sizeof(UINT64);
+               }
+               break;
+           case TAU_OP_TD48:
+               if ((planFits(pHost, pHostEnd, count, TAU_TD48_HOST_SIZE) == FALSE) ||
+                   (planFits(pWire, pWireEnd, count, 6u) == FALSE))
+               {
+                   return FALSE;
+               }
+               /* Only the seconds and ticks, padding bytes of the host structure are skipped */
+               for (i = 0u; i < count; i++)
+               {
+                   TAU_COPY(&val32, pHost, sizeof(UINT32));
+                   TAU_COPY(&val16, pHost + sizeof(UINT32), sizeof(UINT16));
+                   val32   = TAU_NET32(val32);
+                   val16   = TAU_NET16(val16);
+                   TAU_COPY(pWire, &val32, sizeof(UINT32));
+                   TAU_COPY(pWire + sizeof(UINT32), &val16, sizeof(UINT16));
+                   pHost   += TAU_TD48_HOST_SIZE;
+                   pWire   += 6u;
+               }
+               break;
+           case TAU_OP_BLOCK:
+               pBlock = &pEntry->pBlocks[count];
+               if ((planFits(pHost, pHostEnd, 1u, pBlock->hostSize) == FALSE) ||
+                   (planFits(pWire, pWireEnd, 1u, pBlock->wireSize) == FALSE))
+               {
+                   return FALSE;
+               }
+               planRunBlock(pEntry, pBlock, pHost, pWire, TRUE);
+               pHost   += pBlock->hostSize;
+               pWire   += pBlock->wireSize;
+               break;
+           case TAU_OP_REPEAT:
+               if ((count == 0u) || (depth > TAU_MAX_DS_LEVEL))
+               {
+                   return FALSE;
+               }
+               loop[depth].pRepeat = pOp;
+               loop[depth].left    = count;
+               depth++;
+               break;
+           case TAU_OP_END:
+               if (--loop[depth - 1u].left > 0u)
+               {
+                   pOp = loop[depth - 1u].pRepeat;
+               }
+               else
+               {
+                   depth--;
+               }
+               break;
+           default:     /* TAU_OP_DONE */
+               *pDestSize = (UINT32) (pWire - pDest);
+               return TRUE;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Run a compiled plan from wire to host.
+ *  Counterpart of planMarshall(), like unmarshallDs() the last item gives the size of a following variable element.
+ *
+ *  @param[in]      pEntry          Pointer to the dataset entry with the plan
+ *  @param[in]      pSrc            Pointer to the wire data
+ *  @param[in]      srcSize         Size of the wire data
+ *  @param[in]      pDest           Pointer to the host buffer
+ *  @param[in,out]  pDestSize       Size of the host buffer / size of the result
+ *
+ *  @retval         TRUE if done
+ */
+static BOOL8 planUnmarshall (
+    const TAU_DS_ENTRY_T    *pEntry,
+    UINT8                   *pSrc,
+    UINT32                  srcSize,
+    UINT8                   *pDest,
+    UINT32                  *pDestSize)
+{
+    struct
+    {
+        const TAU_PLAN_OP_T *pRepeat;
+        UINT32              left;
+    }                       loop[TAU_MAX_DS_LEVEL + 1];
+    UINT32                  depth       = 0u;
+    UINT32                  var[TAU_PLAN_MAX_VARS];
+    const TAU_PLAN_OP_T     *pOp;
+    const TAU_PLAN_BLOCK_T  *pBlock;
+    UINT8                   *pHost      = pDest;
+    UINT8                   *pHostEnd   = pDest + *pDestSize;
+    UINT8                   *pWire      = pSrc;
+    UINT8                   *pWireEnd   = pSrc + srcSize;
+    UINT32                  i;
+    UINT16                  val16 = 0u;
+    UINT32                  val32 = 0u;
+    UINT64                  val64;
+
+    if (((uintptr_t) pHost & (pEntry->hostAlign - 1u)) != 0u)
+    {
+        return FALSE;
+    }
+
+    for (pOp = pEntry->pOps;; pOp++)
+    {
+        UINT32 count = pOp->count;
+
+        if (pOp->useVar != 0u)
+        {
+            count = var[pOp->useVar - 1u];
+            if (count == 0u)
+            {
+                return FALSE;
+            }
+        }
+        pHost += pOp->hostPad;
+        if (pOp->hostAlign > 1u)
+        {
+            pHost = alignePtr(pHost, pOp->hostAlign);
+        }
+
+        switch (pOp->code)
+        {
+           case TAU_OP_COPY:
+               if ((planFits(pHost, pHostEnd, count, 1u) == FALSE) || (planFits(pWire, pWireEnd, count, 1u) == FALSE))
+               {
+                   return FALSE;
+               }
+               for (i = 0u; i < count; i++)
+               {
+                   *pHost++ = *pWire++;
+               }
+               if (pOp->setVar != 0u)
+               {
+                   var[pOp->setVar - 1u] = pHost[-1];
+               }
+               break;
+           case TAU_OP_SWAP16:
+               if ((planFits(pHost, pHostEnd, count, 2u) == FALSE) || (planFits(pWire, pWireEnd, count, 2u) == FALSE))
+               {
+                   return FALSE;
+               }
+               for (i = 0u; i < count; i++)
+               {
+                   TAU_COPY(&val16, pWire, sizeof(UINT16));
+                   val16 = TAU_NET16(val16);
+                   TAU_COPY(pHost, &val16, sizeof(UINT16));
+                   pHost   += sizeof(UINT16);
+                   pWire   += sizeof(UINT16);
+               }
+               if (pOp->setVar != 0u)
+               {
+                   var[pOp->setVar - 1u] = val16;
+               }
+               break;
+           case TAU_OP_TD64:
+               count *= 2u;     /* two 32 bit values */
+               /* FALLTHRU */
+           case TAU_OP_SWAP32:
+               if ((planFits(pHost, pHostEnd, count, 4u) == FALSE) || (planFits(pWire, pWireEnd, count, 4u) == FALSE))
+               {
+                   return FALSE;
+               }
+               for (i = 0u; i < count; i++)
+               {
+                   TAU_COPY(&val32, pWire, sizeof(UINT32));
+                   val32 = TAU_NET32(val32);
+                   TAU_COPY(pHost, &val32, sizeof(UINT32));
+                   pHost   += sizeof(UINT32);
+                   pWire   += sizeof(UINT32);
+               }
+               if (pOp->setVar != 0u)
+               {
+                   var[pOp->setVar - 1u] = val32;
+               }
+               break;
+           case TAU_OP_SWAP64:
+               if ((planFits(pHost, pHostEnd, count, 8u) == FALSE) || (planFits(pWire, pWireEnd, count, 8u) == FALSE))
+               {
+                   return FALSE;
+               }
+               for (i = 0u; i < count; i++)
+               {
+                   TAU_COPY(&val64, pWire, sizeof(UINT64));
+                   val64 = TAU_NET64(val64);
+                   TAU_COPY(pHost, &val64, sizeof(UINT64));
+                   pHost   += sizeof(UINT64);
+                   pWire   += sizeof(UINT64);
+               }
+               break;
+           case TAU_OP_TD48:
+               if ((planFits(pHost, pHostEnd, count, TAU_TD48_HOST_SIZE) == FALSE) ||
+                   (planFits(pWire, pWireEnd, count, 6u) == FALSE))
+               {
+                   return FALSE;
+               }
+               /* Only the seconds and ticks, padding bytes of the host structure are left untouched */
+               for (i = 0u; i < count; i++)
+               {
+                   TAU_COPY(&val32, pWire, sizeof(UINT32));
+                   TAU_COPY(&val16, pWire + sizeof(UINT32), sizeof(UINT16));
+                   val32   = TAU_NET32(val32);
+                   val16   = TAU_NET16(val16);
+                   TAU_COPY(pHost, &val32, sizeof(UINT32));
+                   TAU_COPY(pHost + sizeof(UINT32), &val16, sizeof(UINT16));
+                   pHost   += TAU_TD48_HOST_SIZE;
+                   pWire   += 6u;
+               }
+               break;
+           case TAU_OP_BLOCK:
+               pBlock = &pEntry->pBlocks[count];
+               if ((planFits(pHost, pHostEnd, 1u, pBlock->hostSize) == FALSE) ||
+                   (planFits(pWire, pWireEnd, 1u, pBlock->wireSize) == FALSE))
+               {
+                   return FALSE;
+               }
+               planRunBlock(pEntry, pBlock, pHost, pWire, FALSE);
+               pHost   += pBlock->hostSize;
+               pWire   += pBlock->wireSize;
+               break;
+           case TAU_OP_REPEAT:
+               if ((count == 0u) || (depth > TAU_MAX_DS_LEVEL))
+               {
+                   return FALSE;
+               }
+               loop[depth].pRepeat = pOp;
+               loop[depth].left    = count;
+               depth++;
+               break;
+           case TAU_OP_END:
+               if (--loop[depth - 1u].left > 0u)
+               {
+                   pOp = loop[depth - 1u].pRepeat;
+               }
+               else
+               {
+                   depth--;
+               }
+               break;
+           default:     /* TAU_OP_DONE */
+               *pDestSize = (UINT32) (pHost - pDest);
+               return TRUE;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Release a marshalling context.
+ *
+ *  @param[in]      pContext        Pointer to the context, may be partly built
+ *
+ *  @retval         none
+ */
+static void freeContext (
+    TAU_MARSHALL_CONTEXT_T *pContext)
+{
+    UINT32 i;
+
+    pContext->magic = 0u;
+    if (pContext->pEntries != NULL)
+    {
+        for (i = 0u; i < pContext->numEntries; i++)
+        {
+            if (pContext->pEntries[i].pOps != NULL)
+            {
+                vos_memFree(pContext->pEntries[i].pOps);
+            }
+            if (pContext->pEntries[i].pBlocks != NULL)
+            {
+                vos_memFree(pContext->pEntries[i].pBlocks);
+            }
+            if (pContext->pEntries[i].pItems != NULL)
+            {
+                vos_memFree(pContext->pEntries[i].pItems);
+            }
+        }
+        vos_memFree(pContext->pEntries);
+    }
+    if (pContext->ppNested != NULL)
+    {
+        vos_memFree(pContext->ppNested);
+    }
+    if (pContext->pComIdMap != NULL)
+    {
+        vos_memFree(pContext->pComIdMap);
+    }
+    if (pContext->ppComIdDs != NULL)
+    {
+        vos_memFree(pContext->ppComIdDs);
+    }
+    if (pContext->pHash != NULL)
+    {
+        vos_memFree(pContext->pHash);
+    }
+    vos_memFree(pContext);
+}
+
+/**********************************************************************************************************************/
+/**    Create a marshalling context.
+ *
+ *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
+ *  @param[in]      numComId         Number of datasets found in the configuration
+ *  @param[in]      pComIdDsIdMap    Pointer to an array of structures of type TRDP_DATASET_T
+ *  @param[in]      numDataSet       Number of datasets found in the configuration
+ *  @param[in]      pDataset         Pointer to an array of pointers to structures of type TRDP_DATASET_T
+ *  @param[in]      usePlans         TRUE to compile and run marshalling plans
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_MEM_ERR     provided buffer to small
+ *  @retval         TRDP_PARAM_ERR   Parameter error
+ *
+ */
+
+static TRDP_ERR_T initContext (
+    void                    * *ppRefCon,
+    UINT32                  numComId,
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap,
+    UINT32                  numDataSet,
+    TRDP_DATASET_T          *pDataset[],
+    BOOL8                   usePlans)
+{
+    TAU_MARSHALL_CONTEXT_T  *pContext;
+    TAU_PLAN_OP_T           *pScratch;
+    UINT32                  numElements = 0u;
+    UINT32                  hashSize    = 4u;
+    UINT32                  i, j;
+
+    if ((pDataset == NULL) || (numDataSet == 0u) || (numComId == 0u) || (pComIdDsIdMap == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    for (i = 0u; i < numDataSet; i++)
+    {
+        if (pDataset[i] == NULL)
+        {
+            return TRDP_PARAM_ERR;
+        }
+        numElements += pDataset[i]->numElement;
+    }
+    while (hashSize < 2u * numDataSet)
+    {
+        hashSize <<= 1u;
+    }
+
+    pContext = (TAU_MARSHALL_CONTEXT_T *) vos_memAlloc(sizeof(TAU_MARSHALL_CONTEXT_T));
+    if (pContext == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pContext->numComId      = numComId;
+    pContext->numEntries    = numDataSet;
+    pContext->hashMask      = hashSize - 1u;
+    pContext->pComIdMap     = (TRDP_COMID_DSID_MAP_T *) vos_memAlloc(numComId * sizeof(TRDP_COMID_DSID_MAP_T));
+    pContext->ppComIdDs     = (TAU_DS_ENTRY_T * *) vos_memAlloc(numComId * sizeof(TAU_DS_ENTRY_T *));
+    pContext->pEntries      = (TAU_DS_ENTRY_T *) vos_memAlloc(numDataSet * sizeof(TAU_DS_ENTRY_T));
+    pContext->pHash         = (UINT32 *) vos_memAlloc(hashSize * sizeof(UINT32));
+    pContext->ppNested      = (numElements == 0u) ? NULL :
+        (TAU_DS_ENTRY_T * *) vos_memAlloc(numElements * sizeof(TAU_DS_ENTRY_T *));
+
+    if ((pContext->pComIdMap == NULL) || (pContext->ppComIdDs == NULL) || (pContext->pEntries == NULL) ||
+        (pContext->pHash == NULL) || ((pContext->ppNested == NULL) && (numElements != 0u)))
+    {
+        freeContext(pContext);
+        return TRDP_MEM_ERR;
+    }
+
+    /*    Sorted copies of the tables    */
+    memcpy(pContext->pComIdMap, pComIdDsIdMap, numComId * sizeof(TRDP_COMID_DSID_MAP_T));
+    vos_qsort(pContext->pComIdMap, numComId, sizeof(TRDP_COMID_DSID_MAP_T), compareComId);
+
+    for (i = 0u; i < numDataSet; i++)
+    {
+        pContext->pEntries[i].pDataset = pDataset[i];
+    }
+    vos_qsort(pContext->pEntries, numDataSet, sizeof(TAU_DS_ENTRY_T), compareDataset);
+
+    /*    Resolve the nested datasets and the comIds once    */
+    numElements = 0u;
+    for (i = 0u; i < numDataSet; i++)
+    {
+        TAU_DS_ENTRY_T *pEntry = &pContext->pEntries[i];
+
+        pEntry->ppNested = &pContext->ppNested[numElements];
+        for (j = 0u; j < pEntry->pDataset->numElement; j++)
+        {
+            pEntry->ppNested[j] = (pEntry->pDataset->pElement[j].type > (UINT32) TRDP_TYPE_MAX) ?
+                findDs(pContext, pEntry->pDataset->pElement[j].type) : NULL;
+        }
+        numElements += pEntry->pDataset->numElement;
+
+        for (j = (UINT32) (((uintptr_t) pEntry->pDataset >> 3u) * 2654435761u) & pContext->hashMask;
+             pContext->pHash[j] != 0u;
+             j = (j + 1u) & pContext->hashMask)
+        {
+            ;
+        }
+        pContext->pHash[j] = i + 1u;
+    }
+    for (i = 0u; i < numDataSet; i++)
+    {
+        pContext->pEntries[i].hostAlign = maxAlignOfDSMember(&pContext->pEntries[i], 1u);
+    }
+    for (i = 0u; i < numComId; i++)
+    {
+        pContext->ppComIdDs[i] = findDs(pContext, pContext->pComIdMap[i].datasetId);
+    }
+
+    /*    Compile the datasets    */
+    pContext->usePlans = usePlans;
+    pScratch = (usePlans == TRUE) ? (TAU_PLAN_OP_T *) vos_memAlloc(TAU_PLAN_MAX_OPS * sizeof(TAU_PLAN_OP_T)) : NULL;
+    if (pScratch != NULL)
+    {
+        for (i = 0u; i < numDataSet; i++)
+        {
+            planBuild(&pContext->pEntries[i], pScratch);
+        }
+        vos_memFree(pScratch);
+    }
+    else if (usePlans == TRUE)
+    {
+        vos_printLogStr(VOS_LOG_WARNING, "No memory for marshalling plans, using interpreter\n");
+    }
+
+    pContext->magic = TAU_MARSHALL_MAGIC;
+    if (ppRefCon != NULL)
+    {
+        *ppRefCon = pContext;
+    }
+
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/**    Function to initialise the marshalling/unmarshalling.
+ *    A marshalling context with sorted copies of the tables is created and returned via ppRefCon; the supplied
+ *    arrays are not modified. The datasets themselves must exist during the use of the marshalling functions.
+ *    The context is not changed afterwards, the marshalling functions can be called for it from several threads
+ *    at the same time. Release it with tau_deInitMarshall().
+ *    Every dataset is compiled into a flat list of copy and byte swap operations, runs of fixed size elements
+ *    are fused into blocks. The marshalling functions run these plans and interpret the dataset only where a
+ *    plan does not apply (no memory for it, misaligned or too small buffers).
+ *    The marshalling functions return TRDP_PARAM_ERR if their pRefCon is NULL.
+ *
+ *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
+ *  @param[in]      numComId         Number of datasets found in the configuration
+ *  @param[in]      pComIdDsIdMap    Pointer to an array of structures of type TRDP_DATASET_T
+ *  @param[in]      numDataSet       Number of datasets found in the configuration
+ *  @param[in]      pDataset         Pointer to an array of pointers to structures of type TRDP_DATASET_T
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_MEM_ERR     provided buffer to small
+ *  @retval         TRDP_PARAM_ERR   Parameter error
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_initMarshall (
+    void                    * *ppRefCon,
+    UINT32                  numComId,
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap,
+    UINT32                  numDataSet,
+    TRDP_DATASET_T          *pDataset[])
+{
+    return initContext(ppRefCon, numComId, pComIdDsIdMap, numDataSet, pDataset, TRUE);
+}
+
+/**********************************************************************************************************************/
+/**    Function to initialise the marshalling/unmarshalling without compiled plans.
+ *    Like tau_initMarshall(), but the datasets are interpreted on every call. For targets where the memory
+ *    of the plans matters and to compare the plans with the interpreter.
+ *
+ *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
+ *  @param[in]      numComId         Number of datasets found in the configuration
+ *  @param[in]      pComIdDsIdMap    Pointer to an array of structures of type TRDP_DATASET_T
+ *  @param[in]      numDataSet       Number of datasets found in the configuration
+ *  @param[in]      pDataset         Pointer to an array of pointers to structures of type TRDP_DATASET_T
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_MEM_ERR     provided buffer to small
+ *  @retval         TRDP_PARAM_ERR   Parameter error
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_initMarshallInterpreted (
+    void                    * *ppRefCon,
+    UINT32                  numComId,
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap,
+    UINT32                  numDataSet,
+    TRDP_DATASET_T          *pDataset[])
+{
+    return initContext(ppRefCon, numComId, pComIdDsIdMap, numDataSet, pDataset, FALSE);
+}
+
+/**********************************************************************************************************************/
+/**    Release a marshalling context.
+ *
+ *  @param[in]      pRefCon         Reference context returned by tau_initMarshall()
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  not a marshalling context
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_deInitMarshall (
+    void *pRefCon)
+{
+    TAU_MARSHALL_CONTEXT_T *pContext = (TAU_MARSHALL_CONTEXT_T *) pRefCon;
+
+    if ((pContext == NULL) || (pContext->magic != TAU_MARSHALL_MAGIC))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    freeContext(pContext);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    marshall function.
+ *
+ *  @param[in]      pRefCon         pointer to user context
+ *  @param[in]      comId           ComId to identify the structure out of a configuration
+ *  @param[in]      pSrc            pointer to received original message
+ *  @param[in]      srcSize         size of the source buffer
+ *  @param[in]      pDest           pointer to a buffer for the treated message
+ *  @param[in,out]  pDestSize       size of the provide buffer / size of the treated message
+ *  @param[in,out]  ppDSPointer     pointer to pointer to cached dataset
+ *                                  set NULL if not used, set content NULL if unknown
+ *
+ *  @retval         TRDP_NO_ERR             no error
+ *  @retval         TRDP_MEM_ERR            provided buffer to small
+ *  @retval         TRDP_PARAM_ERR          Parameter error
+ *  @retval         TRDP_STATE_ERR          Too deep recursion
+ *  @retval         TRDP_MARSHALLING_ERR    dataset/source size mismatch
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_marshall (
+    void            *pRefCon,
+    UINT32          comId,
+    UINT8           *pSrc,
+    UINT32          srcSize,
+    UINT8           *pDest,
+    UINT32          *pDestSize,
+    TRDP_DATASET_T  * *ppDSPointer)
+{
+    TRDP_ERR_T                      err;
+    TAU_DS_ENTRY_T                  *pEntry;
+    TAU_MARSHALL_INFO_T             info;
+    const TAU_MARSHALL_CONTEXT_T    *pContext;
+
+    if ((NULL == pRefCon) || (0u == comId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    pContext = getContext(pRefCon);
+    if (NULL == pContext)
+    {
+        return TRDP_INIT_ERR;
+    }
+
+    pEntry = lookupDs(pContext, TRUE, comId, ppDSPointer);
+
+    if (NULL == pEntry)     /* Not in our DB    */
+    {
+        vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", comId);
+        return TRDP_COMID_ERR;
+    }
+
+    if ((pContext->usePlans == TRUE) && (pEntry->pOps != NULL) && (planMarshall(pEntry, pSrc, srcSize, pDest, pDestSize) == TRUE))
+    {
+        return TRDP_NO_ERR;
+    }
+
+    info.level      = 0u;
+    info.pSrc       = pSrc;
+    info.pSrcEnd    = pSrc + srcSize;
+    info.pDst       = pDest;
+    info.pDstEnd    = pDest + *pDestSize;
+
+    err = marshallDs(&info, pEntry);
+
+    *pDestSize = (UINT32) (info.pDst - pDest);
+
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    unmarshall function.
+ *
+ *  @param[in]      pRefCon         pointer to user context
+ *  @param[in]      comId           ComId to identify the structure out of a configuration
+ *  @param[in]      pSrc            pointer to received original message
+ *  @param[in]      srcSize         size of the source buffer
+ *  @param[in]      pDest           pointer to a buffer for the treated message
+ *  @param[in,out]  pDestSize       size of the provide buffer / size of the treated message
+ *  @param[in,out]  ppDSPointer     pointer to pointer to cached dataset
+ *                                  set NULL if not used, set content NULL if unknown
+ *
+ *  @retval         TRDP_INIT_ERR           marshalling not initialised
+ *  @retval         TRDP_NO_ERR             no error
+ *  @retval         TRDP_MEM_ERR            provided buffer to small
+ *  @retval         TRDP_PARAM_ERR          Parameter error
+ *  @retval         TRDP_STATE_ERR          Too deep recursion
+ *  @retval         TRDP_COMID_ERR          comid not existing
+ *  @retval         TRDP_MARSHALLING_ERR    dataset/source size mismatch
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_unmarshall (
+    void            *pRefCon,
+    UINT32          comId,
+    UINT8           *pSrc,
+    UINT32          srcSize,
+    UINT8           *pDest,
+    UINT32          *pDestSize,
+    TRDP_DATASET_T  * *ppDSPointer)
+{
+    TRDP_ERR_T                      err;
+    TAU_DS_ENTRY_T                  *pEntry;
+    TAU_MARSHALL_INFO_T             info;
+    const TAU_MARSHALL_CONTEXT_T    *pContext;
+
+    if ((NULL == pRefCon) || (0u == comId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    pContext = getContext(pRefCon);
+    if (NULL == pContext)
+    {
+        return TRDP_INIT_ERR;
+    }
+
+    pEntry = lookupDs(pContext, TRUE, comId, ppDSPointer);
+
+    if (NULL == pEntry)     /* Not in our DB    */
     {
         vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", comId);
         return TRDP_COMID_ERR;
     }
 
+    if ((pContext->usePlans == TRUE) && (pEntry->pOps != NULL) && (planUnmarshall(pEntry, pSrc, srcSize, pDest, pDestSize) == TRUE))
+    {
+        return TRDP_NO_ERR;
+    }
+
     info.level      = 0u;
     info.pSrc       = pSrc;
     info.pSrcEnd    = pSrc + srcSize;
     info.pDst       = pDest;
     info.pDstEnd    = pDest + *pDestSize;
 
-    err = unmarshallDs(&info, pDataset);
+    err = unmarshallDs(&info, pEntry);
 
     *pDestSize = (UINT32) (info.pDst - pDest);
 
@@ -1333,44 +2882,42 @@ EXT_DECL TRDP_ERR_T tau_marshallDs (
     UINT32          *pDestSize,
     TRDP_DATASET_T  * *ppDSPointer)
 {
-    TRDP_ERR_T          err;
-    TRDP_DATASET_T      *pDataset;
-    TAU_MARSHALL_INFO_T info;
+    TRDP_ERR_T                      err;
+    TAU_DS_ENTRY_T                  *pEntry;
+    TAU_MARSHALL_INFO_T             info;
+    const TAU_MARSHALL_CONTEXT_T    *pContext;
 
-    pRefCon = pRefCon;
-
-    if ((0u == dsId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
+    if ((NULL == pRefCon) || (0u == dsId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
     {
         return TRDP_PARAM_ERR;
     }
 
-    /* Can we use the formerly cached value? */
-    if (NULL != ppDSPointer)
-    {
-        if (NULL == *ppDSPointer)
-        {
-            *ppDSPointer = findDs(dsId);
-        }
-        pDataset = *ppDSPointer;
-    }
-    else
+    pContext = getContext(pRefCon);
+    if (NULL == pContext)
     {
-        pDataset = findDs(dsId);
+        return TRDP_INIT_ERR;
     }
 
-    if (NULL == pDataset)   /* Not in our DB    */
+    pEntry = lookupDs(pContext, FALSE, dsId, ppDSPointer);
+
+    if (NULL == pEntry)     /* Not in our DB    */
     {
         vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", dsId);
         return TRDP_COMID_ERR;
     }
 
+    if ((pContext->usePlans == TRUE) && (pEntry->pOps != NULL) && (planMarshall(pEntry, pSrc, srcSize, pDest, pDestSize) == TRUE))
+    {
+        return TRDP_NO_ERR;
+    }
+
     info.level      = 0u;
     info.pSrc       = pSrc;
     info.pSrcEnd    = pSrc + srcSize;
     info.pDst       = pDest;
     info.pDstEnd    = pDest + *pDestSize;
 
-    err = marshallDs(&info, pDataset);
+    err = marshallDs(&info, pEntry);
 
     *pDestSize = (UINT32) (info.pDst - pDest);
 
@@ -1408,44 +2955,42 @@ EXT_DECL TRDP_ERR_T tau_unmarshallDs (
     UINT32          *pDestSize,
     TRDP_DATASET_T  * *ppDSPointer)
 {
-    TRDP_ERR_T          err;
-    TRDP_DATASET_T      *pDataset;
-    TAU_MARSHALL_INFO_T info;
-
-    pRefCon = pRefCon;
+    TRDP_ERR_T                      err;
+    TAU_DS_ENTRY_T                  *pEntry;
+    TAU_MARSHALL_INFO_T             info;
+    const TAU_MARSHALL_CONTEXT_T    *pContext;
 
-    if ((0u == dsId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
+    if ((NULL == pRefCon) || (0u == dsId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
     {
         return TRDP_PARAM_ERR;
     }
 
-    /* Can we use the formerly cached value? */
-    if (NULL != ppDSPointer)
-    {
-        if (NULL == *ppDSPointer)
-        {
-            *ppDSPointer = findDs(dsId);
-        }
-        pDataset = *ppDSPointer;
-    }
-    else
+    pContext = getContext(pRefCon);
+    if (NULL == pContext)
     {
-        pDataset = findDs(dsId);
+        return TRDP_INIT_ERR;
     }
 
-    if (NULL == pDataset)   /* Not in our DB    */
+    pEntry = lookupDs(pContext, FALSE, dsId, ppDSPointer);
+
+    if (NULL == pEntry)     /* Not in our DB    */
     {
         vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", dsId);
         return TRDP_COMID_ERR;
     }
 
+    if ((pContext->usePlans == TRUE) && (pEntry->pOps != NULL) && (planUnmarshall(pEntry, pSrc, srcSize, pDest, pDestSize) == TRUE))
+    {
+        return TRDP_NO_ERR;
+    }
+
     info.level      = 0u;
     info.pSrc       = pSrc;
     info.pSrcEnd    = pSrc + srcSize;
     info.pDst       = pDest;
     info.pDstEnd    = pDest + *pDestSize;
 
-    err = unmarshallDs(&info, pDataset);
+    err = unmarshallDs(&info, pEntry);
 
     *pDestSize = (UINT32) (info.pDst - pDest);
 
@@ -1482,32 +3027,25 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSize (
     UINT32          *pDestSize,
     TRDP_DATASET_T  * *ppDSPointer)
 {
-    TRDP_ERR_T          err;
-    TRDP_DATASET_T      *pDataset;
-    TAU_MARSHALL_INFO_T info;
+    TRDP_ERR_T                      err;
+    TAU_DS_ENTRY_T                  *pEntry;
+    TAU_MARSHALL_INFO_T             info;
+    const TAU_MARSHALL_CONTEXT_T    *pContext;
 
-    pRefCon = pRefCon;
-
-    if ((0u == dsId) || (NULL == pSrc) || (NULL == pDestSize))
+    if ((NULL == pRefCon) || (0u == dsId) || (NULL == pSrc) || (NULL == pDestSize))
     {
         return TRDP_PARAM_ERR;
     }
 
-    /* Can we use the formerly cached value? */
-    if (NULL != ppDSPointer)
-    {
-        if (NULL == *ppDSPointer)
-        {
-            *ppDSPointer = findDs(dsId);
-        }
-        pDataset = *ppDSPointer;
-    }
-    else
+    pContext = getContext(pRefCon);
+    if (NULL == pContext)
     {
-        pDataset = findDs(dsId);
+        return TRDP_INIT_ERR;
     }
 
-    if (NULL == pDataset)   /* Not in our DB    */
+    pEntry = lookupDs(pContext, FALSE, dsId, ppDSPointer);
+
+    if (NULL == pEntry)     /* Not in our DB    */
     {
         vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", dsId);
         return TRDP_COMID_ERR;
@@ -1518,7 +3056,7 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSize (
     info.pSrcEnd    = pSrc + srcSize;
     info.pDst       = 0u;
 
-    err = size_unmarshall(&info, pDataset);
+    err = size_unmarshall(&info, pEntry);
 
     *pDestSize = (UINT32) (info.pDst - (UINT8*) NULL);  /*lint !e413 Subtract pointer to emphasize size calculation */
 
@@ -1554,32 +3092,25 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSizeByComId (
     UINT32          *pDestSize,
     TRDP_DATASET_T  * *ppDSPointer)
 {
-    TRDP_ERR_T          err;
-    TRDP_DATASET_T      *pDataset;
-    TAU_MARSHALL_INFO_T info;
+    TRDP_ERR_T                      err;
+    TAU_DS_ENTRY_T                  *pEntry;
+    TAU_MARSHALL_INFO_T             info;
+    const TAU_MARSHALL_CONTEXT_T    *pContext;
 
-    pRefCon = pRefCon;
-
-    if ((0u == comId) || (NULL == pSrc) || (NULL == pDestSize))
+    if ((NULL == pRefCon) || (0u == comId) || (NULL == pSrc) || (NULL == pDestSize))
     {
         return TRDP_PARAM_ERR;
     }
 
-    /* Can we use the formerly cached value? */
-    if (NULL != ppDSPointer)
-    {
-        if (NULL == *ppDSPointer)
-        {
-            *ppDSPointer = findDSFromComId(comId);
-        }
-        pDataset = *ppDSPointer;
-    }
-    else
+    pContext = getContext(pRefCon);
+    if (NULL == pContext)
     {
-        pDataset = findDSFromComId(comId);
+        return TRDP_INIT_ERR;
     }
 
-    if (NULL == pDataset)   /* Not in our DB    */
+    pEntry = lookupDs(pContext, TRUE, comId, ppDSPointer);
+
+    if (NULL == pEntry)     /* Not in our DB    */
     {
         vos_printLog(VOS_LOG_ERROR, "ComID/DatasetID (%u) unknown\n", comId);
         return TRDP_COMID_ERR;
@@ -1590,7 +3121,7 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSizeByComId (
     info.pSrcEnd    = pSrc + srcSize;
     info.pDst       = 0u;
 
-    err = size_unmarshall(&info, pDataset);
+    err = size_unmarshall(&info, pEntry);
 
     *pDestSize = (UINT32) (info.pDst - (UINT8*) NULL); /*lint !e413 Subtract pointer to emphasize size calculation */
 
@@ -20,6 +20,8 @@
 /*
 * $Id: tau_so_if.c 2109 2019-11-01 17:43:14Z bloehr $
 *
+*      AG 2026-10-17: SRM URIs resolved by tau_uri2AddrAsync(), TRDP_NODATA_ERR until the address is known
+*      AG 2026-10-17: Service cache keyed by serviceId, synced by srvTopoCnt; tau_addServices()/tau_delServices()
 *      SB 2019-10-15: Added option for filtering requested services.
 *      SB 2019-10-02: Fixed bug with reply callback triggered after timeout with now invalid context.
 *      SB 2019-09-17: Fixed bug, with semaphores not valid during callback (including MR retries triggering cb).
@@ -37,9 +39,12 @@
 #include <stdio.h>
 
 #include "trdp_if_light.h"
+#include "trdp_private.h"
 #include "tau_dnr.h"
+#include "tau_tti.h"
 #include "tau_so_if.h"
 #include "vos_utils.h"
+#include "vos_sock.h"
 
 #ifndef SOA_SUPPORT
 #if (defined WIN32 || defined WIN64)
@@ -56,6 +61,21 @@
  * DEFINES
  */
 
+/** Size of version and noOfEntries of SRM_SERVICE_ENTRIES_T */
+#define SRM_ENTRIES_HDR_SIZE    (sizeof(SRM_SERVICE_ENTRIES_T) - sizeof(SRM_SERVICE_INFO_T))
+
+/** Max. number of service entries in one request telegram, longer lists are split */
+#define SRM_MAX_ENTRIES_PER_MSG ((TRDP_MAX_MD_DATA_SIZE - SRM_ENTRIES_HDR_SIZE) / sizeof(SRM_SERVICE_INFO_T))
+
+#define SRM_SRV_FLAG_UPDATE     0x08u       /**< srvFlags Bit3: service list update                 */
+#define SRM_SRV_FLAG_DELETE     0x10u       /**< srvFlags Bit4: delete service (update only)        */
+
+#define SRM_ADDR_ECSP           0u          /**< srmAddr slot of the ECSP (service registry requests) */
+#define SRM_ADDR_GROUP          1u          /**< srmAddr slot of the SRM multicast group              */
+
+#define SRM_CACHE_MIN_SIZE      64u                         /**< initial number of cache slots (power of 2)     */
+#define SRM_CACHE_MAX_SERVICES  (TRDP_MAX_CST_CNT * 512u)   /**< 512 services per consist at most               */
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -66,8 +86,40 @@ typedef struct mdData
     SRM_SERVICE_ENTRIES_T   *pServiceEntry;     /**< pointer to request/reply data          */
     UINT32                  bufferSize;         /**< buffer size if provided by application */
     TRDP_ERR_T              returnVal;          /**< error return                           */
+    UINT32                  noOfEntries;        /**< entries returned by the reply          */
 } TAU_CB_BLOCK_T;
 
+/** Consist of the service cache, one per SRM_CST_SRV_INFO_T sender */
+typedef struct
+{
+    BOOL8           valid;                      /**< slot in use                                        */
+    BOOL8           received;                   /**< srvTopoCnt is from a received service list         */
+    TRDP_UUID_T     cstUUID;                    /**< UUID of the consist                                */
+    UINT32          srvTopoCnt;                 /**< srvTopoCnt of the cached service list              */
+    UINT32          trnTopoCnt;                 /**< trnTopoCnt of the last service list                */
+    UINT32          listCnt;                    /**< complete lists received, marks their entries       */
+} TAU_SRV_CST_T;
+
+/** Service cache entry */
+typedef struct
+{
+    SRM_SERVICE_INFO_T  srvInfo;                /**< service info in host representation                */
+    UINT32              listCnt;                /**< listCnt of the consist when stored                 */
+    UINT8               cstSlot;                /**< consist slot + 1, 0 = free entry                   */
+} TAU_SRV_ENTRY_T;
+
+/** Service cache of a session, open addressed on the serviceId */
+typedef struct TAU_SRV_CACHE
+{
+    VOS_MUTEX_T     mutex;                      /**< protects the cache, it is updated by the MD callback */
+    TRDP_LIS_T      listener;                   /**< listener for SRM_SRVINFO_NOTIFY                    */
+    UINT32          version;                    /**< incremented on every change                        */
+    UINT32          noOfEntries;                /**< cached services                                    */
+    UINT32          size;                       /**< number of slots, power of 2                        */
+    TAU_SRV_ENTRY_T *pEntry;                    /**< the slots                                          */
+    TAU_SRV_CST_T   cst[TRDP_MAX_CST_CNT];      /**< consists the services came from                    */
+} TAU_SRV_CACHE_T;
+
 typedef enum
 {
     SRM_ADD,
@@ -78,6 +130,34 @@ typedef enum
  *   Locals
  */
 
+/**********************************************************************************************************************/
+/**    Marshall/Unmarshall a service entry
+ *
+ *  @param[in]      pDest           Destination entry
+ *  @param[in]      pSource         Source entry
+ *
+ *  @retval         none
+ *
+ */
+
+static void srvInfoCpy (
+    SRM_SERVICE_INFO_T          *pDest,
+    const SRM_SERVICE_INFO_T    *pSource)
+{
+    if (pDest != pSource)
+    {
+        *pDest = *pSource;
+    }
+
+    /* Swap the ints > 8Bit */
+    pDest->serviceId        = vos_htonl(pSource->serviceId);
+    pDest->srvTTL.tv_sec    = vos_htonl(pSource->srvTTL.tv_sec);
+    pDest->srvTTL.tv_usec   = (INT32) vos_htonl((UINT32) pSource->srvTTL.tv_usec);
+    pDest->addInfo[0]       = vos_htonl(pSource->addInfo[0]);
+    pDest->addInfo[1]       = vos_htonl(pSource->addInfo[1]);
+    pDest->addInfo[2]       = vos_htonl(pSource->addInfo[2]);
+}
+
 /**********************************************************************************************************************/
 /**    Marshall/Unmarshall a service telegram
  *
@@ -94,27 +174,25 @@ static void netcpy (
     const SRM_SERVICE_ENTRIES_T *pSource,
     UINT32                      srcSize)
 {
-    UINT16 idx, noOfEntries = (UINT16) srcSize / sizeof(SRM_SERVICE_INFO_T);
+    UINT32  idx, noOfEntries;
 
-    if (noOfEntries == 0u)
+    if (srcSize < sizeof(SRM_SERVICE_ENTRIES_T))
     {
         return;
     }
+    noOfEntries = (srcSize - SRM_ENTRIES_HDR_SIZE) / sizeof(SRM_SERVICE_INFO_T);
 
     /* first: copy everything */
-    memcpy(pDest, pSource, srcSize);
+    if (pDest != pSource)
+    {
+        memcpy(pDest, pSource, srcSize);
+    }
 
     pDest->noOfEntries = vos_htons(pSource->noOfEntries);
 
     for (idx = 0; idx < noOfEntries; idx++)
     {
-        /* Swap the ints > 8Bit */
-        pDest->serviceEntry[idx].serviceId      = vos_htonl(pSource->serviceEntry[idx].serviceId);
-        pDest->serviceEntry[idx].srvTTL.tv_sec  = vos_htonl(pSource->serviceEntry[idx].srvTTL.tv_sec);
-        pDest->serviceEntry[idx].srvTTL.tv_usec = (INT32) vos_htonl((UINT32) pSource->serviceEntry[idx].srvTTL.tv_usec);
-        pDest->serviceEntry[idx].addInfo[0]     = vos_htonl(pSource->serviceEntry[idx].addInfo[0]);
-        pDest->serviceEntry[idx].addInfo[1]     = vos_htonl(pSource->serviceEntry[idx].addInfo[1]);
-        pDest->serviceEntry[idx].addInfo[2]     = vos_htonl(pSource->serviceEntry[idx].addInfo[2]);
+        srvInfoCpy(&pDest->serviceEntry[idx], &pSource->serviceEntry[idx]);
     }
 }
 
@@ -170,10 +248,19 @@ static void soMDCallback (
         if (pMsg->comId == SRM_SERVICE_ADD_REP_COMID)           /* Reply from ECSP */
         {
             if ((pContext->waitForResponse != NULL) &&          /* In case the SRM has changed something... */
-                (pData != NULL) && (dataSize > 0))
+                (pData != NULL) && (dataSize >= sizeof(SRM_SERVICE_ENTRIES_T)))
             {
-                /*  (un)marshall reply data */
+                /*  (un)marshall reply data, not more than the request held */
+                if (dataSize > pContext->bufferSize)
+                {
+                    dataSize = pContext->bufferSize;
+                }
                 netcpy(pContext->pServiceEntry, (SRM_SERVICE_ENTRIES_T *) pData, dataSize);
+                pContext->noOfEntries = pContext->pServiceEntry->noOfEntries;
+                if (pContext->noOfEntries > (dataSize - SRM_ENTRIES_HDR_SIZE) / sizeof(SRM_SERVICE_INFO_T))
+                {
+                    pContext->noOfEntries = (dataSize - SRM_ENTRIES_HDR_SIZE) / sizeof(SRM_SERVICE_INFO_T);
+                }
             }
             pContext->returnVal = pMsg->resultCode;
         }
@@ -195,6 +282,11 @@ static void soMDCallback (
                 {
                     /*  (un)marshall reply data */
                     netcpy(pSrvList, (SRM_SERVICE_ENTRIES_T *) pData, dataSize);
+                    if (pSrvList->noOfEntries > (dataSize - SRM_ENTRIES_HDR_SIZE) / sizeof(SRM_SERVICE_INFO_T))
+                    {
+                        pSrvList->noOfEntries = (UINT16) ((dataSize - SRM_ENTRIES_HDR_SIZE) /
+                                                          sizeof(SRM_SERVICE_INFO_T));
+                    }
                     pContext->pServiceEntry = pSrvList;
                     pContext->returnVal     = TRDP_NO_ERR;
                 }
@@ -220,18 +312,487 @@ static void soMDCallback (
     }
 }
 
+/**********************************************************************************************************************/
+/**    Compute the home slot of a serviceId
+ *
+ *  @param[in]      serviceId       serviceId (instance and type)
+ *  @param[in]      mask            cache size - 1
+ *
+ *  @retval         slot index
+ */
+static UINT32 srvSlot (
+    UINT32  serviceId,
+    UINT32  mask)
+{
+    UINT32 hash = serviceId * 0x9E3779B1u;
+
+    return (hash ^ (hash >> 16u)) & mask;
+}
+
+/**********************************************************************************************************************/
+/**    Find the slot of a serviceId, or the free slot ending its probe sequence
+ *
+ *  @param[in]      pCache          service cache
+ *  @param[in]      serviceId       serviceId to look for
+ *
+ *  @retval         slot index
+ */
+static UINT32 srvFind (
+    const TAU_SRV_CACHE_T   *pCache,
+    UINT32                  serviceId)
+{
+    UINT32  mask    = pCache->size - 1u;
+    UINT32  idx     = srvSlot(serviceId, mask);
+
+    while ((pCache->pEntry[idx].cstSlot != 0u) && (pCache->pEntry[idx].srvInfo.serviceId != serviceId))
+    {
+        idx = (idx + 1u) & mask;
+    }
+    return idx;
+}
+
+/**********************************************************************************************************************/
+/**    Remove a cache entry, following entries of the cluster are moved back (no tombstones)
+ *
+ *  @param[in]      pCache          service cache
+ *  @param[in]      idx             slot of the entry
+ */
+static void srvRemove (
+    TAU_SRV_CACHE_T *pCache,
+    UINT32          idx)
+{
+    UINT32 mask = pCache->size - 1u;
+    UINT32 next;
+
+    for (next = (idx + 1u) & mask; pCache->pEntry[next].cstSlot != 0u; next = (next + 1u) & mask)
+    {
+        UINT32 home = srvSlot(pCache->pEntry[next].srvInfo.serviceId, mask);
+
+        /* Move the entry into the gap if its home slot is not between the gap and its current position */
+        if (((next - home) & mask) >= ((next - idx) & mask))
+        {
+            pCache->pEntry[idx] = pCache->pEntry[next];
+            idx = next;
+        }
+    }
+    memset(&pCache->pEntry[idx], 0, sizeof(TAU_SRV_ENTRY_T));
+    pCache->noOfEntries--;
+}
+
+/**********************************************************************************************************************/
+/**    Double the number of cache slots
+ *
+ *  @param[in]      pCache          service cache
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T srvGrow (
+    TAU_SRV_CACHE_T *pCache)
+{
+    TAU_SRV_ENTRY_T *pOld       = pCache->pEntry;
+    UINT32          oldSize     = pCache->size;
+    TAU_SRV_ENTRY_T *pNew;
+    UINT32          idx;
+
+    pNew = (TAU_SRV_ENTRY_T *) vos_memAlloc(2u * oldSize * sizeof(TAU_SRV_ENTRY_T));
+    if (pNew == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pCache->pEntry  = pNew;
+    pCache->size    = 2u * oldSize;
+    for (idx = 0u; idx < oldSize; idx++)
+    {
+        if (pOld[idx].cstSlot != 0u)
+        {
+            pNew[srvFind(pCache, pOld[idx].srvInfo.serviceId)] = pOld[idx];
+        }
+    }
+    vos_memFree(pOld);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Add or update a service of a consist
+ *
+ *  @param[in]      pCache          service cache
+ *  @param[in]      pSrvInfo        service info in host representation
+ *  @param[in]      slot            consist slot
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    cache is full
+ */
+static TRDP_ERR_T srvPut (
+    TAU_SRV_CACHE_T             *pCache,
+    const SRM_SERVICE_INFO_T    *pSrvInfo,
+    UINT32                      slot)
+{
+    UINT32 idx = srvFind(pCache, pSrvInfo->serviceId);
+
+    if (pCache->pEntry[idx].cstSlot == 0u)
+    {
+        /* Keep the table at most half full */
+        if (2u * (pCache->noOfEntries + 1u) > pCache->size)
+        {
+            if ((pCache->noOfEntries >= SRM_CACHE_MAX_SERVICES) ||
+                (srvGrow(pCache) != TRDP_NO_ERR))
+            {
+                return TRDP_MEM_ERR;
+            }
+            idx = srvFind(pCache, pSrvInfo->serviceId);
+        }
+        pCache->noOfEntries++;
+    }
+    pCache->pEntry[idx].srvInfo = *pSrvInfo;
+    pCache->pEntry[idx].listCnt = pCache->cst[slot].listCnt;
+    pCache->pEntry[idx].cstSlot = (UINT8) (slot + 1u);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Remove the services of a consist which were not part of its last complete list
+ *
+ *  @param[in]      pCache          service cache
+ *  @param[in]      slot            consist slot
+ */
+static void srvSweep (
+    TAU_SRV_CACHE_T *pCache,
+    UINT32          slot)
+{
+    UINT32 idx = 0u;
+
+    while (idx < pCache->size)
+    {
+        if ((pCache->pEntry[idx].cstSlot == slot + 1u) &&
+            (pCache->pEntry[idx].listCnt != pCache->cst[slot].listCnt))
+        {
+            srvRemove(pCache, idx);         /* a following entry might have moved into this slot */
+        }
+        else
+        {
+            idx++;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Find the slot of a consist, optionally take a free one
+ *
+ *  @param[in]      pCache          service cache
+ *  @param[in]      cstUUID         UUID of the consist
+ *  @param[in]      create          take a free slot if the consist is unknown
+ *
+ *  @retval         slot index, TRDP_MAX_CST_CNT if not found
+ */
+static UINT32 srvFindCst (
+    TAU_SRV_CACHE_T     *pCache,
+    const TRDP_UUID_T   cstUUID,
+    BOOL8               create)
+{
+    UINT32  slot;
+    UINT32  freeSlot = TRDP_MAX_CST_CNT;
+
+    for (slot = 0u; slot < TRDP_MAX_CST_CNT; slot++)
+    {
+        if (pCache->cst[slot].valid == FALSE)
+        {
+            freeSlot = (freeSlot == TRDP_MAX_CST_CNT) ? slot : freeSlot;
+        }
+        else if (memcmp(pCache->cst[slot].cstUUID, cstUUID, sizeof(TRDP_UUID_T)) == 0)
+        {
+            return slot;
+        }
+    }
+    if ((create == TRUE) && (freeSlot < TRDP_MAX_CST_CNT))
+    {
+        memset(&pCache->cst[freeSlot], 0, sizeof(TAU_SRV_CST_T));
+        memcpy(pCache->cst[freeSlot].cstUUID, cstUUID, sizeof(TRDP_UUID_T));
+        pCache->cst[freeSlot].valid = TRUE;
+    }
+    return freeSlot;
+}
+
+/**********************************************************************************************************************/
+/**    Forget a consist and its services
+ *
+ *  @param[in]      pCache          service cache
+ *  @param[in]      slot            consist slot
+ */
+static void srvDropCst (
+    TAU_SRV_CACHE_T *pCache,
+    UINT32          slot)
+{
+    pCache->cst[slot].listCnt++;            /* outdates all its entries */
+    srvSweep(pCache, slot);
+    memset(&pCache->cst[slot], 0, sizeof(TAU_SRV_CST_T));
+    pCache->version++;
+}
+
+/**********************************************************************************************************************/
+/**    Store the service list of a consist.
+ *  Nothing is done if its srvTopoCnt did not change. A complete list replaces the cached services of the consist,
+ *  the entries of an update list (srvFlags Bit3) are added or deleted (Bit4) one by one.
+ *
+ *  @param[in]      pCache          service cache
+ *  @param[in]      pTelegram       SRM_CST_SRV_INFO_T in network representation
+ *  @param[in]      dataSize        size of the telegram
+ */
+static void srvStoreCstSrvInfo (
+    TAU_SRV_CACHE_T             *pCache,
+    const SRM_CST_SRV_INFO_T    *pTelegram,
+    UINT32                      dataSize)
+{
+    UINT32              srvTopoCnt  = vos_ntohl(pTelegram->srvTopoCnt);
+    UINT32              srvCnt      = vos_ntohs(pTelegram->srvCnt);
+    UINT32              maxCnt      = (dataSize - sizeof(SRM_CST_SRV_INFO_T)) / sizeof(SRM_SERVICE_INFO_T);
+    UINT32              slot        = srvFindCst(pCache, pTelegram->cstUUID, TRUE);
+    BOOL8               update;
+    UINT32              i;
+    SRM_SERVICE_INFO_T  srvInfo;
+
+    if (slot == TRDP_MAX_CST_CNT)
+    {
+        vos_printLogStr(VOS_LOG_WARNING, "Service cache: no room for another consist\n");
+        return;
+    }
+    if ((pCache->cst[slot].received == TRUE) &&
+        (pCache->cst[slot].srvTopoCnt == srvTopoCnt))
+    {
+        return;                             /* service list did not change */
+    }
+    if (srvCnt > maxCnt)
+    {
+        vos_printLog(VOS_LOG_WARNING, "Service cache: %u of %u services received\n", maxCnt, srvCnt);
+        srvCnt = maxCnt;
+    }
+
+    update = ((srvCnt > 0u) && ((pTelegram->srvInfoList[0].srvFlags & SRM_SRV_FLAG_UPDATE) != 0u)) ? TRUE : FALSE;
+    if (update == FALSE)
+    {
+        pCache->cst[slot].listCnt++;
+    }
+    for (i = 0u; i < srvCnt; i++)
+    {
+        srvInfoCpy(&srvInfo, &pTelegram->srvInfoList[i]);
+        if ((update == TRUE) && ((srvInfo.srvFlags & SRM_SRV_FLAG_DELETE) != 0u))
+        {
+            UINT32 idx = srvFind(pCache, srvInfo.serviceId);
+
+            if (pCache->pEntry[idx].cstSlot == slot + 1u)
+            {
+                srvRemove(pCache, idx);
+            }
+        }
+        else if (srvPut(pCache, &srvInfo, slot) != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_WARNING, "Service cache full, service %08x not stored\n", srvInfo.serviceId);
+        }
+    }
+    if (update == FALSE)
+    {
+        srvSweep(pCache, slot);
+    }
+    pCache->cst[slot].received      = TRUE;
+    pCache->cst[slot].srvTopoCnt    = srvTopoCnt;
+    pCache->cst[slot].trnTopoCnt    = vos_ntohl(pTelegram->trnTopoCnt);
+    pCache->version++;
+    vos_printLog(VOS_LOG_DBG, "Service cache: %s of %u services stored (srvTopoCnt %08x), %u cached\n",
+                 (update == TRUE) ? "update" : "list", srvCnt, srvTopoCnt, pCache->noOfEntries);
+}
+
+/**********************************************************************************************************************/
+/**    Function called on reception of a consist service list (SRM_SRVINFO_NOTIFY)
+ *
+ *  @param[in]      pRefCon         unused.
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[in]      pMsg            Pointer to the message info (header etc.)
+ *  @param[in]      pData           Pointer to the network buffer.
+ *  @param[in]      dataSize        Size of the received data
+ *
+ *  @retval         none
+ *
+ */
+static void soSrvInfoCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    TAU_SRV_CACHE_T *pCache = (TAU_SRV_CACHE_T *) pMsg->pUserRef;
+
+    (void) pRefCon;
+    (void) appHandle;
+
+    if ((pCache == NULL) ||
+        (pMsg->resultCode != TRDP_NO_ERR) ||
+        (pMsg->comId != SRM_SRVINFO_NOTIFY_COMID) ||
+        (pData == NULL) ||
+        (dataSize < sizeof(SRM_CST_SRV_INFO_T)))
+    {
+        return;
+    }
+    if (vos_mutexLock(pCache->mutex) == VOS_NO_ERR)
+    {
+        srvStoreCstSrvInfo(pCache, (const SRM_CST_SRV_INFO_T *) pData, dataSize);
+        (void) vos_mutexUnlock(pCache->mutex);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Copy the cached services into a list as returned by tau_getServicesList
+ *
+ *  @param[in]      pCache          service cache or NULL
+ *  @param[out]     ppServicesList  Pointer to pointer containing the list, to be vos_memfree'd
+ *  @param[out]     pNoOfServices   Pointer to no. of services in returned list
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_NODATA_ERR no service list received yet
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T srvCacheList (
+    TAU_SRV_CACHE_T         *pCache,
+    SRM_SERVICE_ENTRIES_T   * *ppServicesList,
+    UINT32                  *pNoOfServices)
+{
+    TRDP_ERR_T              err = TRDP_NODATA_ERR;
+    SRM_SERVICE_ENTRIES_T   *pList;
+    UINT32                  slot;
+    UINT32                  idx;
+    UINT32                  cnt = 0u;
+
+    if ((pCache == NULL) ||
+        (vos_mutexLock(pCache->mutex) != VOS_NO_ERR))
+    {
+        return TRDP_NODATA_ERR;
+    }
+    for (slot = 0u; slot < TRDP_MAX_CST_CNT; slot++)
+    {
+        if (pCache->cst[slot].received == TRUE)
+        {
+            err = TRDP_NO_ERR;
+            break;
+        }
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        pList = (SRM_SERVICE_ENTRIES_T *) vos_memAlloc(SRM_ENTRIES_HDR_SIZE +
+                                                       ((pCache->noOfEntries > 0u) ? pCache->noOfEntries : 1u) *
+                                                       sizeof(SRM_SERVICE_INFO_T));
+        if (pList == NULL)
+        {
+            err = TRDP_MEM_ERR;
+        }
+        else
+        {
+            for (idx = 0u; idx < pCache->size; idx++)
+            {
+                if (pCache->pEntry[idx].cstSlot != 0u)
+                {
+                    pList->serviceEntry[cnt++] = pCache->pEntry[idx].srvInfo;
+                }
+            }
+            pList->version.ver  = 1u;
+            pList->noOfEntries  = (UINT16) cnt;
+            *ppServicesList     = pList;
+            if (pNoOfServices != NULL)
+            {
+                *pNoOfServices = cnt;
+            }
+        }
+    }
+    (void) vos_mutexUnlock(pCache->mutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    DNR callback of srmResolve(), stores the address in the srmAddr slot of the session
+ *
+ *  @param[in]      pRefCon         srmAddr slot
+ *  @param[in]      appHandle       application handle
+ *  @param[in]      pUri            URI asked for
+ *  @param[in]      ipAddr          resolved IP address, VOS_INADDR_ANY if not resolved
+ *  @param[in]      result          result of the lookup
+ *
+ */
+static void srmResolved (
+    void                *pRefCon,
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pUri,
+    TRDP_IP_ADDR_T      ipAddr,
+    TRDP_ERR_T          result)
+{
+    (void) appHandle;
+    (void) pUri;
+    (void) result;
+    *(TRDP_IP_ADDR_T *) pRefCon = ipAddr;
+}
+
+/**********************************************************************************************************************/
+/**    Resolve an SRM URI without blocking
+ *  A cached address is returned at once. Otherwise the URI is queued with the DNR and TRDP_NODATA_ERR is returned,
+ *  the reply is cached by the DNR for the next call. Only standard DNS, which can not be queued, is asked
+ *  synchronously.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
+ *  @param[in]      pUri            URI of the ECSP or the SRM group
+ *  @param[in]      slot            SRM_ADDR_ECSP or SRM_ADDR_GROUP
+ *  @param[out]     pAddr           resolved address
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NODATA_ERR     lookup queued, try again later
+ *  @retval         TRDP_UNRESOLVED_ERR could not be resolved (or the DNR is not initialised)
+ *
+ */
+static TRDP_ERR_T srmResolve (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pUri,
+    UINT32              slot,
+    TRDP_IP_ADDR_T      *pAddr)
+{
+    TRDP_IP_ADDR_T  *pSlot = &appHandle->srmAddr[slot];
+    TRDP_URI_HOST_T uri;
+    TRDP_ERR_T      err;
+
+    memset(uri, 0, sizeof(uri));
+    vos_strncpy(uri, pUri, sizeof(uri) - 1u);
+
+    /* A cache hit calls back before returning, a queued lookup later from tlc_process() */
+    *pSlot  = VOS_INADDR_ANY;
+    err     = tau_uri2AddrAsync(appHandle, uri, srmResolved, pSlot);
+    if (err == TRDP_PARAM_ERR)
+    {
+        err = tau_uri2Addr(appHandle, pSlot, uri);
+    }
+
+    *pAddr = *pSlot;
+    if (*pAddr != VOS_INADDR_ANY)
+    {
+        return TRDP_NO_ERR;
+    }
+    return (err == TRDP_NO_ERR) ? TRDP_NODATA_ERR : TRDP_UNRESOLVED_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Function to access the service registry of the local ECSP.
+ *  All services are sent with one request, lists too long for one telegram are split into several requests which
+ *  are all sent before waiting for the replies.
+ *  The ECSP URI is resolved by srmResolve(), which does not wait for the DNS reply: TRDP_NODATA_ERR is returned
+ *  until the address is known.
  *
  *
  *  @param[in]          selector            Function selection
  *  @param[in]          appHandle           Handle returned by tlc_openSession().
- *  @param[in,out]      pServiceToAdd       Pointer to a service registry structure to be set and/or updated (returned)
+ *  @param[in,out]      pServices           Pointer to an array of service registry structures to be set and/or
+ *                                          updated (returned)
+ *  @param[in]          noOfServices        Number of services in the array
  *  @param[in]          waitForCompletion   if true, block for reply
  *
  *  @retval             TRDP_NO_ERR         no error
  *  @retval             TRDP_PARAM_ERR      Parameter error
- *  @retval             TRDP_NODATA_ERR     Data currently not available, try again later
+ *  @retval             TRDP_NODATA_ERR     ECSP address not known yet, try again later
+ *  @retval             TRDP_UNRESOLVED_ERR ECSP address could not be resolved
  *  @retval             TRDP_TIMEOUT_ERR    Reply timed out
  *  @retval             TRDP_SEMA_ERR       Semaphore could not be aquired
  *
@@ -239,107 +800,166 @@ static void soMDCallback (
 static TRDP_ERR_T requestServices (
     SRM_REQ_SELECTOR_T  selector,
     TRDP_APP_SESSION_T  appHandle,
-    SRM_SERVICE_INFO_T  *pServiceToAdd,
+    SRM_SERVICE_INFO_T  *pServices,
+    UINT32              noOfServices,
     BOOL8               waitForCompletion)
 {
-    TRDP_ERR_T      err;
-    SRM_SERVICE_ENTRIES_T *pPrivateBuffer = NULL;
-    UINT32          dataSize;
-    TAU_CB_BLOCK_T  context = {NULL, NULL, 0u, TRDP_NO_ERR};
-    void            *pContext = NULL;
-    TRDP_UUID_T     sessionId;
+    TRDP_ERR_T      err = TRDP_NO_ERR;
+    TAU_CB_BLOCK_T  *pContext;
+    TRDP_UUID_T     *pSessionId;
+    VOS_SEMA_T      waitForResponse = NULL;
+    UINT32          comId;
+    UINT32          timeout;
+    TRDP_IP_ADDR_T  destIpAddr;
+    UINT32          noOfMsgs;
+    UINT32          noOfSent = 0u;
+    UINT32          msg;
 
     if ((appHandle == NULL) ||
-        (pServiceToAdd == NULL))
+        (pServices == NULL) ||
+        (noOfServices == 0u))
     {
         return TRDP_PARAM_ERR;
     }
 
-    /* Compute the size of the data */;
-    dataSize = sizeof(SRM_SERVICE_ENTRIES_T);
-
-    memset(&sessionId, 0u, sizeof(sessionId));
-
+    switch (selector)
     {
-        pPrivateBuffer = (SRM_SERVICE_ENTRIES_T *) vos_memAlloc(dataSize);
-        if (pPrivateBuffer == NULL)
-        {
-            err = TRDP_MEM_ERR;
-            goto cleanup;
-        }
-
-        /* marshall request data */
-        pPrivateBuffer->version.ver     = 1u;
-        pPrivateBuffer->noOfEntries     = 1u;
-        pPrivateBuffer->serviceEntry[0] = *pServiceToAdd;
-        netcpy(pPrivateBuffer, pPrivateBuffer, sizeof(SRM_SERVICE_ENTRIES_T));
-        context.pServiceEntry = pPrivateBuffer;
+        case SRM_ADD:
+            /* add data */
+            comId       = SRM_SERVICE_ADD_REQ_COMID;
+            timeout     = SRM_SERVICE_ADD_REQ_TO;
+            err         = srmResolve(appHandle, SRM_SERVICE_ADD_REQ_URI, SRM_ADDR_ECSP, &destIpAddr);
+            break;
+        case SRM_DEL:
+            /* request the deletion */
+            comId       = SRM_SERVICE_DEL_REQ_COMID;
+            timeout     = SRM_SERVICE_DEL_REQ_TO;
+            err         = srmResolve(appHandle, SRM_SERVICE_DEL_REQ_URI, SRM_ADDR_ECSP, &destIpAddr);
+            break;
+        default:
+            return TRDP_PARAM_ERR;
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
     }
 
-    context.returnVal = TRDP_NO_ERR;
+    /* One context and session ID per request telegram */
+    noOfMsgs    = (noOfServices + SRM_MAX_ENTRIES_PER_MSG - 1u) / SRM_MAX_ENTRIES_PER_MSG;
+    pContext    = (TAU_CB_BLOCK_T *) vos_memAlloc(noOfMsgs * (sizeof(TAU_CB_BLOCK_T) + sizeof(TRDP_UUID_T)));
+    if (pContext == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pSessionId = (TRDP_UUID_T *) &pContext[noOfMsgs];
 
     /* if we should wait for the reply, create a semaphore and pass it to the callback routine */
     if (waitForCompletion)
     {
-        VOS_ERR_T vos_err = vos_semaCreate(&context.waitForResponse, VOS_SEMA_EMPTY);
+        VOS_ERR_T vos_err = vos_semaCreate(&waitForResponse, VOS_SEMA_EMPTY);
         if (vos_err != VOS_NO_ERR)
         {
             err = TRDP_SEMA_ERR;
             goto cleanup;
         }
-        pContext = (void*) &context;
     }
 
-    switch (selector)
+    for (msg = 0u; msg < noOfMsgs; msg++)
     {
-        case SRM_ADD:
-            /* add data */
-            err = tlm_request(appHandle, pContext, soMDCallback, &sessionId,
-                              SRM_SERVICE_ADD_REQ_COMID, 0u,
-                              0u, 0u, tau_ipFromURI(appHandle, SRM_SERVICE_ADD_REQ_URI), TRDP_FLAGS_CALLBACK, 1,
-                              SRM_SERVICE_ADD_REQ_TO, NULL, (UINT8 *)context.pServiceEntry, dataSize, NULL, NULL);
-            break;
-        case SRM_DEL:
-            /* request the deletion */
-            err = tlm_request(appHandle, pContext, soMDCallback, &sessionId,
-                              SRM_SERVICE_DEL_REQ_COMID, 0u,
-                              0u, 0u, tau_ipFromURI(appHandle, SRM_SERVICE_DEL_REQ_URI), TRDP_FLAGS_CALLBACK, 1,
-                              SRM_SERVICE_DEL_REQ_TO, NULL, (UINT8 *)context.pServiceEntry, dataSize, NULL, NULL);
-            break;
-        default:
-            err = TRDP_PARAM_ERR;
+        UINT32                  first       = msg * SRM_MAX_ENTRIES_PER_MSG;
+        UINT32                  noOfEntries = noOfServices - first;
+        UINT32                  dataSize;
+        SRM_SERVICE_ENTRIES_T   *pPrivateBuffer;
+
+        if (noOfEntries > SRM_MAX_ENTRIES_PER_MSG)
+        {
+            noOfEntries = SRM_MAX_ENTRIES_PER_MSG;
+        }
+
+        /* Compute the size of the data */
+        dataSize        = SRM_ENTRIES_HDR_SIZE + noOfEntries * sizeof(SRM_SERVICE_INFO_T);
+        pPrivateBuffer  = (SRM_SERVICE_ENTRIES_T *) vos_memAlloc(dataSize);
+        if (pPrivateBuffer == NULL)
+        {
+            err = TRDP_MEM_ERR;
             goto cleanup;
-    }
+        }
 
-    if (err != TRDP_NO_ERR)
-    {
-        goto cleanup;
+        /* marshall request data */
+        pPrivateBuffer->version.ver = 1u;
+        pPrivateBuffer->noOfEntries = (UINT16) noOfEntries;
+        memcpy(pPrivateBuffer->serviceEntry, &pServices[first], noOfEntries * sizeof(SRM_SERVICE_INFO_T));
+        netcpy(pPrivateBuffer, pPrivateBuffer, dataSize);
+
+        pContext[msg].waitForResponse   = waitForResponse;
+        pContext[msg].pServiceEntry     = pPrivateBuffer;
+        pContext[msg].bufferSize        = dataSize;
+        pContext[msg].returnVal         = TRDP_NO_ERR;
+
+        err = tlm_request(appHandle, (waitForCompletion) ? &pContext[msg] : NULL, soMDCallback, &pSessionId[msg],
+                          comId, 0u,
+                          0u, 0u, destIpAddr, TRDP_FLAGS_CALLBACK, 1,
+                          timeout, NULL, (UINT8 *)pPrivateBuffer, dataSize, NULL, NULL);
+        if (err != TRDP_NO_ERR)
+        {
+            goto cleanup;
+        }
+        noOfSent++;
     }
-    else if (waitForCompletion)
+
+    if (waitForCompletion)
     {
         /* Make sure the request is sent now: */
         /* (void) tlm_process(appHandle, NULL, NULL); */
 
-        /* wait on semaphore or timeout */
-        VOS_ERR_T vos_err = vos_semaTake(context.waitForResponse, SRM_SERVICE_ADD_REQ_TO);
-        if (vos_err == VOS_SEMA_ERR)
+        /* wait on semaphore or timeout, the requests run in parallel */
+        for (msg = 0u; msg < noOfSent; msg++)
         {
-            err = TRDP_TIMEOUT_ERR;
-            goto cleanup;
+            VOS_ERR_T vos_err = vos_semaTake(waitForResponse, timeout);
+            if (vos_err != VOS_NO_ERR)
+            {
+                err = TRDP_TIMEOUT_ERR;
+                goto cleanup;
+            }
+        }
+
+        for (msg = 0u; msg < noOfSent; msg++)
+        {
+            UINT32 first = msg * SRM_MAX_ENTRIES_PER_MSG;
+
+            if (pContext[msg].returnVal != TRDP_NO_ERR)
+            {
+                err = pContext[msg].returnVal;
+            }
+            else if ((selector == SRM_ADD) &&
+                     (pContext[msg].noOfEntries > 0u) &&
+                     (pContext[msg].noOfEntries <= (noOfServices - first)))
+            {
+                /* In case the SRM has changed something... */
+                memcpy(&pServices[first], pContext[msg].pServiceEntry->serviceEntry,
+                       pContext[msg].noOfEntries * sizeof(SRM_SERVICE_INFO_T));
+            }
         }
     }
 
 cleanup:
 
-    if (waitForCompletion)
+    for (msg = 0u; msg < noOfMsgs; msg++)
     {
-        (void)tlm_abortSession(appHandle, &sessionId);
-        vos_semaDelete(context.waitForResponse);
+        if ((waitForCompletion) && (msg < noOfSent))
+        {
+            (void)tlm_abortSession(appHandle, &pSessionId[msg]);
+        }
+        if (pContext[msg].pServiceEntry != NULL)
+        {
+            vos_memFree(pContext[msg].pServiceEntry);
+        }
     }
-    if (pPrivateBuffer != NULL)
+    if (waitForResponse != NULL)
     {
-        vos_memFree(pPrivateBuffer);
+        vos_semaDelete(waitForResponse);
     }
+    vos_memFree(pContext);
     return err;
 }
 
@@ -371,7 +991,7 @@ EXT_DECL TRDP_ERR_T tau_addService (
     SRM_SERVICE_INFO_T  *pServiceToAdd,
     BOOL8               waitForCompletion)
 {
-    return requestServices(SRM_ADD, appHandle, pServiceToAdd, waitForCompletion);
+    return requestServices(SRM_ADD, appHandle, pServiceToAdd, 1u, waitForCompletion);
 }
 
 /**********************************************************************************************************************/
@@ -396,7 +1016,7 @@ EXT_DECL TRDP_ERR_T tau_delService (
     BOOL8               waitForCompletion)
 {
     (void) waitForCompletion;
-    return requestServices(SRM_DEL, appHandle, pServiceToRemove, FALSE);
+    return requestServices(SRM_DEL, appHandle, pServiceToRemove, 1u, FALSE);
 }
 
 /**********************************************************************************************************************/
@@ -420,12 +1040,67 @@ EXT_DECL TRDP_ERR_T tau_updService (
     SRM_SERVICE_INFO_T  *pServiceToUpdate,
     BOOL8               waitForCompletion)
 {
-    return requestServices(SRM_ADD, appHandle, pServiceToUpdate, waitForCompletion);
+    return requestServices(SRM_ADD, appHandle, pServiceToUpdate, 1u, waitForCompletion);
+}
+
+/**********************************************************************************************************************/
+/** Add several services to the service registry of the consist-local SRM with one request.
+ *  Lists exceeding the size of one telegram are split, all requests are sent before waiting for the replies.
+ *  Note: If waitForCompletion == TRUE, this function will block until completion (or timeout).
+ *
+ *  @param[in]          appHandle           Handle returned by tlc_openSession().
+ *  @param[in,out]      pServicesToAdd      Pointer to an array of service registry structures to be set and/or
+ *                                          updated (returned)
+ *  @param[in]          noOfServices        Number of services in the array
+ *  @param[in]          waitForCompletion   if true, block for reply
+ *
+ *  @retval             TRDP_NO_ERR         no error
+ *  @retval             TRDP_PARAM_ERR      Parameter error
+ *  @retval             TRDP_MEM_ERR        Out of memory
+ *  @retval             TRDP_NODATA_ERR     ECSP address not known yet, try again later
+ *  @retval             TRDP_TIMEOUT_ERR    Reply timed out
+ *  @retval             TRDP_SEMA_ERR       Semaphore could not be aquired
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_addServices (
+    TRDP_APP_SESSION_T  appHandle,
+    SRM_SERVICE_INFO_T  *pServicesToAdd,
+    UINT32              noOfServices,
+    BOOL8               waitForCompletion)
+{
+    return requestServices(SRM_ADD, appHandle, pServicesToAdd, noOfServices, waitForCompletion);
+}
+
+/**********************************************************************************************************************/
+/** Remove several services from the service registry of the consist-local SRM with one request.
+ *  Note: waitForCompletion is currently ignored, this function does not block (see tau_delService).
+ *
+ *  @param[in]          appHandle           Handle returned by tlc_openSession().
+ *  @param[in]          pServicesToRemove   Pointer to an array of service registry structures
+ *  @param[in]          noOfServices        Number of services in the array
+ *  @param[in]          waitForCompletion   if true, block for reply
+ *
+ *  @retval             TRDP_NO_ERR         no error
+ *  @retval             TRDP_PARAM_ERR      Parameter error
+ *  @retval             TRDP_MEM_ERR        Out of memory
+ *  @retval             TRDP_NODATA_ERR     ECSP address not known yet, try again later
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_delServices (
+    TRDP_APP_SESSION_T  appHandle,
+    SRM_SERVICE_INFO_T  *pServicesToRemove,
+    UINT32              noOfServices,
+    BOOL8               waitForCompletion)
+{
+    (void) waitForCompletion;
+    return requestServices(SRM_DEL, appHandle, pServicesToRemove, noOfServices, FALSE);
 }
 
 /**********************************************************************************************************************/
 /**  Get a list of the services known by the service registry of the local TTDB / SRM.
  *  Note: This function will block until completion (or timeout). The buffer must be provided by the caller.
+ *  If the service cache is initialised (tau_initSrvCache) and holds the service list of at least one consist,
+ *  an unfiltered list is returned from the cache without a request.
  *
  *
  *  @param[in]          appHandle               Handle returned by tlc_openSession().
@@ -446,10 +1121,9 @@ EXT_DECL TRDP_ERR_T tau_getServicesList (
     SRM_SERVICE_ENTRIES_T   *pFilterEntry)
 {
     TRDP_ERR_T      err;
-    TAU_CB_BLOCK_T  context = {0, NULL, 0u, TRDP_NO_ERR};
+    TAU_CB_BLOCK_T  context = {0, NULL, 0u, TRDP_NO_ERR, 0u};
     TRDP_UUID_T     sessionId;
     TRDP_IP_ADDR_T  serviceIp;
-    int             count   = 10;
     UINT32          dataSize = sizeof(SRM_SERVICE_ENTRIES_T);
 
     if ((appHandle == NULL) ||
@@ -458,28 +1132,26 @@ EXT_DECL TRDP_ERR_T tau_getServicesList (
         return TRDP_PARAM_ERR;
     }
 
-    memset(&sessionId, 0u, sizeof(sessionId));
+    /* Unfiltered lists are taken from the service cache, once it holds the list of a consist */
+    if ((pFilterEntry == NULL) &&
+        (srvCacheList(appHandle->pSrvCache, ppServicesListBuffer, pNoOfServices) == TRDP_NO_ERR))
+    {
+        return TRDP_NO_ERR;
+    }
 
-    VOS_ERR_T vos_err = vos_semaCreate(&context.waitForResponse, VOS_SEMA_EMPTY);
-    if (vos_err != VOS_NO_ERR)
+    /* Resolved before the MD exchange, the lookup is not waited for */
+    err = srmResolve(appHandle, SRM_SERVICE_READ_REQ_URI, SRM_ADDR_ECSP, &serviceIp);
+    if (err != TRDP_NO_ERR)
     {
-        err = TRDP_SEMA_ERR;
-        goto cleanup;
+        return err;
     }
 
-    /* wait at least 1 second before giving up! */
-    do {
-        serviceIp = tau_ipFromURI(appHandle, SRM_SERVICE_READ_REQ_URI);
-        if (serviceIp != VOS_INADDR_ANY)
-        {
-            break;
-        }
-        vos_threadDelay(100000);
-    } while (count--) ;
+    memset(&sessionId, 0u, sizeof(sessionId));
 
-    if (serviceIp == VOS_INADDR_ANY)
+    VOS_ERR_T vos_err = vos_semaCreate(&context.waitForResponse, VOS_SEMA_EMPTY);
+    if (vos_err != VOS_NO_ERR)
     {
-        err = TRDP_UNRESOLVED_ERR;
+        err = TRDP_SEMA_ERR;
         goto cleanup;
     }
     if (pFilterEntry == NULL)
@@ -541,3 +1213,257 @@ EXT_DECL void tau_freeServicesList (
 {
     vos_memFree(pServicesListBuffer);
 }
+
+/**********************************************************************************************************************/
+/*    Service cache - follows the service lists distributed by the SRMs                                              */
+/**********************************************************************************************************************/
+
+/**********************************************************************************************************************/
+/** Initialise the service cache of a session.
+ *  The cache listens to the consist service lists (SRM_SRVINFO_NOTIFY) and keeps the services keyed by their
+ *  serviceId. A list is only processed if the srvTopoCnt of its consist changed. The SRMs are asked for their
+ *  lists by tau_syncSrvCache(), which is called once from here.
+ *  Note: The DNR must be initialised to resolve the SRM multicast groups. The group is not waited for,
+ *        TRDP_NODATA_ERR asks to call again once tlc_process() has received the DNS reply.
+ *
+ *  @param[in]          appHandle           Handle returned by tlc_openSession().
+ *
+ *  @retval             TRDP_NO_ERR         no error
+ *  @retval             TRDP_PARAM_ERR      Parameter error
+ *  @retval             TRDP_MEM_ERR        Out of memory
+ *  @retval             TRDP_NODATA_ERR     SRM group not known yet, try again later
+ *  @retval             TRDP_UNRESOLVED_ERR SRM group could not be resolved
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_initSrvCache (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TAU_SRV_CACHE_T *pCache;
+    TRDP_IP_ADDR_T  mcGroup;
+    TRDP_ERR_T      err;
+
+    if (appHandle == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (appHandle->pSrvCache != NULL)
+    {
+        return TRDP_NO_ERR;
+    }
+    err = srmResolve(appHandle, SRM_SRVINFO_NOTIFY_URI, SRM_ADDR_GROUP, &mcGroup);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+
+    pCache = (TAU_SRV_CACHE_T *) vos_memAlloc(sizeof(TAU_SRV_CACHE_T));
+    if (pCache == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pCache->size    = SRM_CACHE_MIN_SIZE;
+    pCache->pEntry  = (TAU_SRV_ENTRY_T *) vos_memAlloc(SRM_CACHE_MIN_SIZE * sizeof(TAU_SRV_ENTRY_T));
+    if ((pCache->pEntry == NULL) ||
+        (vos_mutexCreate(&pCache->mutex) != VOS_NO_ERR))
+    {
+        vos_memFree(pCache->pEntry);
+        vos_memFree(pCache);
+        return TRDP_MEM_ERR;
+    }
+
+    if (tlm_addListener(appHandle,
+                        &pCache->listener,
+                        pCache,
+                        soSrvInfoCallback,
+                        TRUE,
+                        SRM_SRVINFO_NOTIFY_COMID,
+                        0u,
+                        0u,
+                        VOS_INADDR_ANY, VOS_INADDR_ANY,
+                        vos_isMulticast(mcGroup) ? mcGroup : VOS_INADDR_ANY,
+                        TRDP_FLAGS_CALLBACK, NULL, NULL) != TRDP_NO_ERR)
+    {
+        vos_mutexDelete(pCache->mutex);
+        vos_memFree(pCache->pEntry);
+        vos_memFree(pCache);
+        return TRDP_INIT_ERR;
+    }
+    appHandle->pSrvCache = pCache;
+
+    return tau_syncSrvCache(appHandle);
+}
+
+/**********************************************************************************************************************/
+/** Release the service cache of a session.
+ *
+ *  @param[in]          appHandle           Handle returned by tlc_openSession().
+ *
+ *  @retval             none
+ *
+ */
+EXT_DECL void tau_deInitSrvCache (
+    TRDP_APP_SESSION_T appHandle)
+{
+    if ((appHandle != NULL) && (appHandle->pSrvCache != NULL))
+    {
+        (void) tlm_delListener(appHandle, appHandle->pSrvCache->listener);
+        vos_mutexDelete(appHandle->pSrvCache->mutex);
+        vos_memFree(appHandle->pSrvCache->pEntry);
+        vos_memFree(appHandle->pSrvCache);
+        appHandle->pSrvCache = NULL;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Ask the SRMs to resend their service lists (SRM_SRV_REQ_NOTIFY).
+ *  If the train directory is available from the TTI, the cached srvTopoCnt of each consist is sent along, so only
+ *  consists with a changed service list answer; consists which left the train are removed from the cache.
+ *  Otherwise all consists are asked.
+ *
+ *  @param[in]          appHandle           Handle returned by tlc_openSession().
+ *
+ *  @retval             TRDP_NO_ERR         no error
+ *  @retval             TRDP_PARAM_ERR      Parameter error, cache not initialised
+ *  @retval             TRDP_MUTEX_ERR      Cache could not be locked
+ *  @retval             TRDP_NODATA_ERR     SRM group not known yet, try again later
+ *  @retval             TRDP_UNRESOLVED_ERR SRM group could not be resolved
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_syncSrvCache (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TAU_SRV_CACHE_T     *pCache;
+    TRDP_TRAIN_DIR_T    trnDir;
+    UINT8               buffer[sizeof(SRM_SRV_INFO_REQ_T) + TRDP_MAX_CST_CNT * sizeof(UINT32)];
+    SRM_SRV_INFO_REQ_T  *pRequest   = (SRM_SRV_INFO_REQ_T *) buffer;
+    UINT32              dataSize    = sizeof(SRM_SRV_INFO_REQ_T);
+    TRDP_IP_ADDR_T      destIpAddr;
+    TRDP_ERR_T          err;
+    UINT32              slot;
+    UINT32              i;
+
+    if ((appHandle == NULL) ||
+        (appHandle->pSrvCache == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    pCache  = appHandle->pSrvCache;
+    err     = srmResolve(appHandle, SRM_SRV_REQ_NOTIFY_URI, SRM_ADDR_GROUP, &destIpAddr);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+
+    memset(buffer, 0, sizeof(buffer));
+    pRequest->version.ver   = 1u;
+    pRequest->cstCnt        = 255u;         /* all consists resend their list */
+
+    if ((tau_getTrDirectory(appHandle, &trnDir) == TRDP_NO_ERR) &&
+        (trnDir.cstCnt > 0u) &&
+        (trnDir.cstCnt <= TRDP_MAX_CST_CNT))
+    {
+        if (vos_mutexLock(pCache->mutex) != VOS_NO_ERR)
+        {
+            return TRDP_MUTEX_ERR;
+        }
+
+        /* Forget the consists which left the train */
+        for (slot = 0u; slot < TRDP_MAX_CST_CNT; slot++)
+        {
+            if (pCache->cst[slot].valid == TRUE)
+            {
+                for (i = 0u; i < trnDir.cstCnt; i++)
+                {
+                    if (memcmp(pCache->cst[slot].cstUUID, trnDir.cstList[i].cstUUID, sizeof(TRDP_UUID_T)) == 0)
+                    {
+                        break;
+                    }
+                }
+                if (i == trnDir.cstCnt)
+                {
+                    srvDropCst(pCache, slot);
+                }
+            }
+        }
+
+        /* Ordered list starting with trnCstNo = 1, 0 if unknown */
+        for (i = 0u; i < trnDir.cstCnt; i++)
+        {
+            slot = srvFindCst(pCache, trnDir.cstList[i].cstUUID, FALSE);
+            pRequest->srvTcList[i] = vos_htonl(((slot < TRDP_MAX_CST_CNT) && (pCache->cst[slot].received == TRUE)) ?
+                                               pCache->cst[slot].srvTopoCnt : 0u);
+        }
+        (void) vos_mutexUnlock(pCache->mutex);
+
+        pRequest->trnTopoCnt    = vos_htonl(trnDir.trnTopoCnt);
+        pRequest->cstCnt        = trnDir.cstCnt;
+        dataSize                += trnDir.cstCnt * sizeof(UINT32);
+    }
+
+    return tlm_notify(appHandle, NULL, NULL, SRM_SRV_REQ_NOTIFY_COMID, 0u, 0u, VOS_INADDR_ANY, destIpAddr,
+                      TRDP_FLAGS_NONE, NULL, buffer, dataSize, NULL, NULL);
+}
+
+/**********************************************************************************************************************/
+/** Get a service from the service cache.
+ *
+ *  @param[in]          appHandle           Handle returned by tlc_openSession().
+ *  @param[in]          serviceId           serviceId (instanceId and serviceTypeId) of the service
+ *  @param[out]         pServiceInfo        Pointer to the service info to be returned
+ *
+ *  @retval             TRDP_NO_ERR         no error
+ *  @retval             TRDP_PARAM_ERR      Parameter error, cache not initialised
+ *  @retval             TRDP_NODATA_ERR     Service not cached
+ *  @retval             TRDP_MUTEX_ERR      Cache could not be locked
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_getCachedService (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              serviceId,
+    SRM_SERVICE_INFO_T  *pServiceInfo)
+{
+    TAU_SRV_CACHE_T *pCache;
+    UINT32          idx;
+    TRDP_ERR_T      err = TRDP_NODATA_ERR;
+
+    if ((appHandle == NULL) ||
+        (appHandle->pSrvCache == NULL) ||
+        (pServiceInfo == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    pCache = appHandle->pSrvCache;
+    if (vos_mutexLock(pCache->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    idx = srvFind(pCache, serviceId);
+    if (pCache->pEntry[idx].cstSlot != 0u)
+    {
+        *pServiceInfo   = pCache->pEntry[idx].srvInfo;
+        err             = TRDP_NO_ERR;
+    }
+    (void) vos_mutexUnlock(pCache->mutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Get the version of the service cache.
+ *  The version is incremented on every change of the cached services, a caller can poll it to see if a list
+ *  fetched by tau_getServicesList() is still current.
+ *
+ *  @param[in]          appHandle           Handle returned by tlc_openSession().
+ *
+ *  @retval             version, 0 if the cache is not initialised
+ *
+ */
+EXT_DECL UINT32 tau_getSrvCacheVersion (
+    TRDP_APP_SESSION_T appHandle)
+{
+    if ((appHandle == NULL) ||
+        (appHandle->pSrvCache == NULL))
+    {
+        return 0u;
+    }
+    return appHandle->pSrvCache->version;
+}
@@ -6,7 +6,7 @@
  *
  * @details         The TTI subsystem maintains a pointer to the TAU_TTDB struct in the TRDP session struct.
  *                  That TAU_TTDB struct keeps the subscription and listener handles, the current TTDB directories and
- *                  a pointer list to consist infos (in network format). On init, most TTDB data is requested from the
+ *                  a pointer list to consist infos (decoded on arrival, indexed by consist, vehicle and function). On init, most TTDB data is requested from the
  *                  ECSP plus the own consist info.
  *                  This data is automatically updated if an inauguration is detected. Additional consist infos are
  *                  requested on demand, only.
@@ -26,6 +26,8 @@
 /*
 * $Id: tau_tti.c 2174 2020-07-10 13:45:53Z bloehr $
 *
+*      AG 2026-10-17: New train directory refreshes only consist infos whose UUID or cstTopoCnt changed
+*      AG 2026-10-17: Consist infos decoded once into host order, O(1) lookups by label/ID, tau_getCstInfoVersion()
 *      BL 2020-07-10: Ticket #292 tau_getTrnVehCnt( ) not working if OpTrnDir is not already valid
 *      BL 2020-07-09: Ticket #298 Create consist info entry error -> check for false data and empty arrays
 *      BL 2020-07-08: Ticket #297 Store Operation Train Dir error
@@ -65,6 +67,7 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <ctype.h>
 
 #include "trdp_if_light.h"
 #include "trdp_utils.h"
@@ -80,11 +83,22 @@
  */
 
 #define TTI_CACHED_CONSISTS  8u             /**< We hold this number of consist infos (ca. 105kB) */
+#define TTI_CST_INDEX_SIZE   16u            /**< Consist label index, power of 2, twice TTI_CACHED_CONSISTS */
+#define TTI_NO_INDEX         0xFFFFu        /**< Free slot of a vehicle / function index */
 
 /***********************************************************************************************************************
  * TYPEDEFS
  */
 
+/** Lookup tables of a consist info, open addressed and at most half full */
+typedef struct TTI_CST_INDEX
+{
+    UINT32  mask;                           /**< size of each table - 1                         */
+    UINT16  *pVehId;                        /**< vehId -> index into pVehInfoList               */
+    UINT16  *pFctId;                        /**< fctId -> index into pFctInfoList               */
+    UINT16  *pFctName;                      /**< fctName -> index into pFctInfoList             */
+} TTI_CST_INDEX_T;
+
 typedef struct TAU_TTDB
 {
     TRDP_SUB_T                      pd100SubHandle1;
@@ -97,8 +111,12 @@ typedef struct TAU_TTDB
     TRDP_TRAIN_NET_DIR_T            trnNetDir;
     UINT32                          noOfCachedCst;
     UINT32                          cstSize[TRDP_MAX_CST_CNT];
-    TRDP_CONSIST_INFO_T             *cstInfo[TRDP_MAX_CST_CNT];     /**< NOTE: the consist info is a variable sized
-                                                            struct / array and is stored in network representation */
+    TRDP_CONSIST_INFO_T             *cstInfo[TRDP_MAX_CST_CNT];     /**< NOTE: the consist info is decoded into host
+                                                            representation on arrival, entry 0 is the own consist */
+    TTI_CST_INDEX_T                 cstIndex[TRDP_MAX_CST_CNT];     /**< vehicle / function lookup per consist */
+    UINT32                          cstStamp[TRDP_MAX_CST_CNT];     /**< cstVersion when stored, oldest is replaced */
+    UINT8                           cstLabelIdx[TTI_CST_INDEX_SIZE];    /**< cstId -> entry + 1, 0 = free       */
+    UINT32                          cstVersion;                     /**< incremented on any consist info change */
 } TAU_TTDB_T;
 
 /***********************************************************************************************************************
@@ -109,6 +127,11 @@ static void ttiRequestTTDBdata (TRDP_APP_SESSION_T  appHandle,
                                 UINT32              comID,
                                 const TRDP_UUID_T   cstUUID);
 
+static void ttiSendCstInfoRequest (TRDP_APP_SESSION_T   appHandle,
+                                   const TRDP_UUID_T    cstUUID);
+
+static void ttiRefreshCstInfo (TRDP_APP_SESSION_T appHandle);
+
 static void ttiGetUUIDfromLabel (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_UUID_T         cstUUID,
@@ -526,7 +549,7 @@ static TRDP_ERR_T ttiCreateCstInfoEntry (
     pDest->reserved03   = vos_ntohs(*(UINT16 *)pData);
     pData += sizeof(UINT16);
 
-    if (pData > pEnd)
+    if ((pData + sizeof(UINT16)) > pEnd)
     {
         return TRDP_PACKET_ERR;
     }
@@ -535,6 +558,11 @@ static TRDP_ERR_T ttiCreateCstInfoEntry (
     pDest->etbCnt   = vos_ntohs(*(UINT16 *)pData);
     pData           += sizeof(UINT16);
 
+    if ((pData + 4u * pDest->etbCnt + 2u * sizeof(UINT16)) > pEnd)     /* incl. reserved04, vehCnt */
+    {
+        return TRDP_PACKET_ERR;
+    }
+
     pDest->pEtbInfoList = (TRDP_ETB_INFO_T *) vos_memAlloc(sizeof(TRDP_ETB_INFO_T) * pDest->etbCnt);
     if (pDest->pEtbInfoList == NULL)
     {
@@ -543,9 +571,9 @@ static TRDP_ERR_T ttiCreateCstInfoEntry (
     }
     for (idx = 0u; idx < pDest->etbCnt; idx++)
     {
-        pDest->pEtbInfoList->etbId      = *pData++;
-        pDest->pEtbInfoList->cnCnt      = *pData++;
-        pDest->pEtbInfoList->reserved01 = vos_ntohs(*(UINT16 *)pData);
+        pDest->pEtbInfoList[idx].etbId      = *pData++;
+        pDest->pEtbInfoList[idx].cnCnt      = *pData++;
+        pDest->pEtbInfoList[idx].reserved01 = vos_ntohs(*(UINT16 *)pData);
         pData += sizeof(UINT16);
     }
     /* pData += sizeof(TRDP_ETB_INFO_T) * pDest->etbCnt; */ /* Incremented while copying */
@@ -562,6 +590,11 @@ static TRDP_ERR_T ttiCreateCstInfoEntry (
     pDest->vehCnt   = vos_ntohs(*(UINT16 *)pData);
     pData           += sizeof(UINT16);
 
+    if ((pData + 40u * pDest->vehCnt + 2u * sizeof(UINT16)) > pEnd)   /* without properties */
+    {
+        return TRDP_PACKET_ERR;
+    }
+
     pDest->pVehInfoList = (TRDP_VEHICLE_INFO_T *) vos_memAlloc(sizeof(TRDP_VEHICLE_INFO_T) * pDest->vehCnt);
     if (pDest->pVehInfoList == NULL)
     {
@@ -574,22 +607,26 @@ static TRDP_ERR_T ttiCreateCstInfoEntry (
     /* copy the vehicle list */
     for (idx = 0u; idx < pDest->vehCnt; idx++)
     {
-        memcpy(pDest->pVehInfoList->vehId, pData, sizeof(TRDP_NET_LABEL_T));
+        TRDP_VEHICLE_INFO_T *pVeh = &pDest->pVehInfoList[idx];
+
+        memcpy(pVeh->vehId, pData, sizeof(TRDP_NET_LABEL_T));
         pData += sizeof(TRDP_NET_LABEL_T);
-        memcpy(pDest->pVehInfoList->vehType, pData, sizeof(TRDP_NET_LABEL_T));
+        memcpy(pVeh->vehType, pData, sizeof(TRDP_NET_LABEL_T));
         pData += sizeof(TRDP_NET_LABEL_T);
-        pDest->pVehInfoList->vehOrient          = *pData++;
-        pDest->pVehInfoList->cstVehNo           = *pData++;
-        pDest->pVehInfoList->tractVeh           = *pData++;
-        pDest->pVehInfoList->reserved01         = *pData++;
-        pDest->pVehInfoList->vehProp.ver.ver    = *pData++;
-        pDest->pVehInfoList->vehProp.ver.rel    = *pData++;
-        pDest->pVehInfoList->vehProp.len        = vos_ntohs(*(UINT16 *)pData);
+        pVeh->vehOrient         = *pData++;
+        pVeh->cstVehNo          = *pData++;
+        pVeh->tractVeh          = *pData++;
+        pVeh->reserved01        = *pData++;
+        pVeh->vehProp.ver.ver   = *pData++;
+        pVeh->vehProp.ver.rel   = *pData++;
+        pVeh->vehProp.len       = vos_ntohs(*(UINT16 *)pData);
         pData += sizeof(UINT16);
-        if (pDest->pVehInfoList->vehProp.len != 0u)
+        pVeh->vehProp.prop[0]   = 0;            /* Note: properties are not supported (no room in vehProp) */
+        pData += pVeh->vehProp.len;             /* we need to account for them anyway */
+        pVeh->vehProp.len = 0;
+        if ((pData + 2u * sizeof(UINT16)) > pEnd)                       /* incl. reserved05, fctCnt */
         {
-            memcpy(pDest->pVehInfoList->vehProp.prop, pData, pDest->pVehInfoList->vehProp.len);
-            pData += pDest->pVehInfoList->vehProp.len;
+            return TRDP_PACKET_ERR;
         }
     }
 
@@ -603,6 +640,11 @@ static TRDP_ERR_T ttiCreateCstInfoEntry (
     pDest->fctCnt   = vos_ntohs(*(UINT16 *)pData);
     pData           += sizeof(UINT16);
 
+    if ((pData + 24u * pDest->fctCnt + 2u * sizeof(UINT16)) > pEnd)    /* incl. reserved06, cltrCstCnt */
+    {
+        return TRDP_PACKET_ERR;
+    }
+
     if (pDest->fctCnt > 0)
     {
         pDest->pFctInfoList = (TRDP_FUNCTION_INFO_T *) vos_memAlloc(sizeof(TRDP_FUNCTION_INFO_T) * pDest->fctCnt);
@@ -620,16 +662,18 @@ static TRDP_ERR_T ttiCreateCstInfoEntry (
 
         for (idx = 0u; idx < pDest->fctCnt; idx++)
         {
-            memcpy(pDest->pFctInfoList->fctName, pData, sizeof(TRDP_NET_LABEL_T));
+            TRDP_FUNCTION_INFO_T *pFct = &pDest->pFctInfoList[idx];
+
+            memcpy(pFct->fctName, pData, sizeof(TRDP_NET_LABEL_T));
             pData += sizeof(TRDP_NET_LABEL_T);
-            pDest->pFctInfoList->fctId = vos_ntohs(*(UINT16 *)pData);
+            pFct->fctId = vos_ntohs(*(UINT16 *)pData);
             pData += sizeof(UINT16);
-            pDest->pFctInfoList->grp        = *pData++;
-            pDest->pFctInfoList->reserved01 = *pData++;
-            pDest->pFctInfoList->cstVehNo   = *pData++;
-            pDest->pFctInfoList->etbId      = *pData++;
-            pDest->pFctInfoList->cnId       = *pData++;
-            pDest->pFctInfoList->reserved02 = *pData++;
+            pFct->grp           = *pData++;
+            pFct->reserved01    = *pData++;
+            pFct->cstVehNo      = *pData++;
+            pFct->etbId         = *pData++;
+            pFct->cnId          = *pData++;
+            pFct->reserved02    = *pData++;
         }
         /* pData += sizeof(TRDP_FUNCTION_INFO_T) * pDest->fctCnt; */ /* Incremented while copying */
     }
@@ -642,6 +686,11 @@ static TRDP_ERR_T ttiCreateCstInfoEntry (
     pDest->cltrCstCnt = vos_ntohs(*(UINT16 *)pData);
     pData += sizeof(UINT16);
 
+    if ((pData + 20u * pDest->cltrCstCnt + sizeof(UINT32)) > pEnd)     /* incl. cstTopoCnt */
+    {
+        return TRDP_PACKET_ERR;
+    }
+
     if (pDest->cltrCstCnt > 0)
     {
         pDest->pCltrCstInfoList = (TRDP_CLTR_CST_INFO_T *) vos_memAlloc(sizeof(TRDP_CLTR_CST_INFO_T) * pDest->cltrCstCnt);
@@ -662,11 +711,11 @@ static TRDP_ERR_T ttiCreateCstInfoEntry (
 
         for (idx = 0u; idx < pDest->cltrCstCnt; idx++)
         {
-            memcpy(pDest->pCltrCstInfoList->cltrCstUUID, pData, sizeof(TRDP_UUID_T));
+            memcpy(pDest->pCltrCstInfoList[idx].cltrCstUUID, pData, sizeof(TRDP_UUID_T));
             pData += sizeof(TRDP_UUID_T);
-            pDest->pCltrCstInfoList->cltrCstOrient  = *pData++;
-            pDest->pCltrCstInfoList->cltrCstNo      = *pData++;
-            pDest->pCltrCstInfoList->reserved01     = vos_ntohs(*(UINT16 *)pData);
+            pDest->pCltrCstInfoList[idx].cltrCstOrient  = *pData++;
+            pDest->pCltrCstInfoList[idx].cltrCstNo      = *pData++;
+            pDest->pCltrCstInfoList[idx].reserved01     = vos_ntohs(*(UINT16 *)pData);
             pData += sizeof(UINT16);
         }
 
@@ -676,10 +725,324 @@ static TRDP_ERR_T ttiCreateCstInfoEntry (
     return TRDP_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Hash value of a label, case insensitive like vos_strnicmp()
+ *
+ *  @param[in]      pLabel          label, not necessarily zero terminated
+ *
+ *  @retval         hash value
+ */
+static UINT32 ttiLabelHash (
+    const CHAR8 *pLabel)
+{
+    UINT32  hash = 2166136261u;                     /* FNV-1a */
+    UINT32  i;
+
+    for (i = 0u; (i < TRDP_MAX_LABEL_LEN) && (pLabel[i] != '\0'); i++)
+    {
+        hash = (hash ^ (UINT32) tolower((unsigned char) pLabel[i])) * 16777619u;
+    }
+    return hash ^ (hash >> 16u);
+}
+
+/**********************************************************************************************************************/
+/** Hash value of a function ID
+ *
+ *  @param[in]      fctId           function / device ID
+ *
+ *  @retval         hash value
+ */
+static UINT32 ttiIdHash (
+    UINT16 fctId)
+{
+    UINT32 hash = (UINT32) fctId * 0x9E3779B1u;
+
+    return hash ^ (hash >> 16u);
+}
+
+/**********************************************************************************************************************/
+/** Insert a list index into a lookup table
+ *
+ *  @param[in]      pTable          lookup table
+ *  @param[in]      mask            table size - 1
+ *  @param[in]      hash            hash value of the key
+ *  @param[in]      idx             list index to store
+ *
+ *  @retval         none
+ */
+static void ttiIndexInsert (
+    UINT16  *pTable,
+    UINT32  mask,
+    UINT32  hash,
+    UINT32  idx)
+{
+    UINT32 slot = hash & mask;
+
+    while (pTable[slot] != TTI_NO_INDEX)
+    {
+        slot = (slot + 1u) & mask;
+    }
+    pTable[slot] = (UINT16) idx;
+}
+
+/**********************************************************************************************************************/
+/** Build the vehicle and function lookup tables of a consist info
+ *
+ *  @param[out]     pIndex          lookup tables to build
+ *  @param[in]      pCstInfo        decoded consist info
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T ttiIndexCstInfo (
+    TTI_CST_INDEX_T             *pIndex,
+    const TRDP_CONSIST_INFO_T   *pCstInfo)
+{
+    UINT32  size    = 4u;
+    UINT32  cnt     = (pCstInfo->vehCnt > pCstInfo->fctCnt) ? pCstInfo->vehCnt : pCstInfo->fctCnt;
+    UINT32  idx;
+
+    while (size < 2u * cnt)
+    {
+        size <<= 1u;
+    }
+    pIndex->pVehId = (UINT16 *) vos_memAlloc(3u * size * sizeof(UINT16));
+    if (pIndex->pVehId == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    memset(pIndex->pVehId, 0xFF, 3u * size * sizeof(UINT16));      /* all TTI_NO_INDEX */
+    pIndex->pFctId      = pIndex->pVehId + size;
+    pIndex->pFctName    = pIndex->pFctId + size;
+    pIndex->mask        = size - 1u;
+
+    for (idx = 0u; idx < pCstInfo->vehCnt; idx++)
+    {
+        ttiIndexInsert(pIndex->pVehId, pIndex->mask, ttiLabelHash(pCstInfo->pVehInfoList[idx].vehId), idx);
+    }
+    for (idx = 0u; idx < pCstInfo->fctCnt; idx++)
+    {
+        ttiIndexInsert(pIndex->pFctId, pIndex->mask, ttiIdHash(pCstInfo->pFctInfoList[idx].fctId), idx);
+        ttiIndexInsert(pIndex->pFctName, pIndex->mask, ttiLabelHash(pCstInfo->pFctInfoList[idx].fctName), idx);
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Rebuild the consist label index over all cached consist infos
+ *
+ *  @param[in]      pTTDB           TTDB
+ *
+ *  @retval         none
+ */
+static void ttiIndexConsists (
+    TAU_TTDB_T *pTTDB)
+{
+    UINT32 l_index;
+
+    memset(pTTDB->cstLabelIdx, 0, sizeof(pTTDB->cstLabelIdx));
+    for (l_index = 0u; l_index < TTI_CACHED_CONSISTS; l_index++)
+    {
+        if (pTTDB->cstInfo[l_index] != NULL)
+        {
+            UINT32 slot = ttiLabelHash(pTTDB->cstInfo[l_index]->cstId) & (TTI_CST_INDEX_SIZE - 1u);
+
+            while (pTTDB->cstLabelIdx[slot] != 0u)
+            {
+                slot = (slot + 1u) & (TTI_CST_INDEX_SIZE - 1u);
+            }
+            pTTDB->cstLabelIdx[slot] = (UINT8) (l_index + 1u);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Find a cached consist info
+ *
+ *  @param[in]      pTTDB           TTDB
+ *  @param[in]      pCstLabel       consist label, NULL means own consist
+ *
+ *  @retval         entry index, TTI_CACHED_CONSISTS if not cached
+ */
+static UINT32 ttiFindCst (
+    const TAU_TTDB_T    *pTTDB,
+    const CHAR8         *pCstLabel)
+{
+    UINT32 slot;
+
+    if (pCstLabel == NULL)
+    {
+        return (pTTDB->cstInfo[0] != NULL) ? 0u : TTI_CACHED_CONSISTS;
+    }
+    for (slot = ttiLabelHash(pCstLabel) & (TTI_CST_INDEX_SIZE - 1u);
+         pTTDB->cstLabelIdx[slot] != 0u;
+         slot = (slot + 1u) & (TTI_CST_INDEX_SIZE - 1u))
+    {
+        UINT32 l_index = pTTDB->cstLabelIdx[slot] - 1u;
+
+        if (vos_strnicmp(pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
+        {
+            return l_index;
+        }
+    }
+    return TTI_CACHED_CONSISTS;
+}
+
+/**********************************************************************************************************************/
+/** Find a cached consist info by its UUID
+ *
+ *  @param[in]      pTTDB           TTDB
+ *  @param[in]      cstUUID         consist UUID
+ *
+ *  @retval         entry index, TTI_CACHED_CONSISTS if not cached
+ */
+static UINT32 ttiFindCstByUUID (
+    const TAU_TTDB_T    *pTTDB,
+    const TRDP_UUID_T   cstUUID)
+{
+    UINT32 l_index;
+
+    for (l_index = 0u; l_index < TTI_CACHED_CONSISTS; l_index++)
+    {
+        if ((pTTDB->cstInfo[l_index] != NULL) &&
+            (memcmp(pTTDB->cstInfo[l_index]->cstUUID, cstUUID, sizeof(TRDP_UUID_T)) == 0))
+        {
+            break;
+        }
+    }
+    return l_index;
+}
+
+/**********************************************************************************************************************/
+/** Find a vehicle of a cached consist info
+ *
+ *  @param[in]      pTTDB           TTDB
+ *  @param[in]      cstEntry        entry index of the consist
+ *  @param[in]      pVehLabel       vehicle label
+ *
+ *  @retval         index into pVehInfoList, TTI_NO_INDEX if not found
+ */
+static UINT32 ttiFindVeh (
+    const TAU_TTDB_T    *pTTDB,
+    UINT32              cstEntry,
+    const CHAR8         *pVehLabel)
+{
+    const TTI_CST_INDEX_T       *pIndex     = &pTTDB->cstIndex[cstEntry];
+    const TRDP_CONSIST_INFO_T   *pCstInfo   = pTTDB->cstInfo[cstEntry];
+    UINT32 slot;
+
+    for (slot = ttiLabelHash(pVehLabel) & pIndex->mask;
+         pIndex->pVehId[slot] != TTI_NO_INDEX;
+         slot = (slot + 1u) & pIndex->mask)
+    {
+        if (vos_strnicmp(pCstInfo->pVehInfoList[pIndex->pVehId[slot]].vehId, pVehLabel,
+                         sizeof(TRDP_NET_LABEL_T)) == 0)
+        {
+            return pIndex->pVehId[slot];
+        }
+    }
+    return TTI_NO_INDEX;
+}
+
+/**********************************************************************************************************************/
+/** Find a function of a cached consist info
+ *
+ *  @param[in]      pTTDB           TTDB
+ *  @param[in]      cstEntry        entry index of the consist
+ *  @param[in]      fctId           function ID, used if pFctLabel is NULL
+ *  @param[in]      pFctLabel       function label or NULL
+ *
+ *  @retval         index into pFctInfoList, TTI_NO_INDEX if not found
+ */
+static UINT32 ttiFindFct (
+    const TAU_TTDB_T    *pTTDB,
+    UINT32              cstEntry,
+    UINT16              fctId,
+    const CHAR8         *pFctLabel)
+{
+    const TTI_CST_INDEX_T       *pIndex     = &pTTDB->cstIndex[cstEntry];
+    const TRDP_CONSIST_INFO_T   *pCstInfo   = pTTDB->cstInfo[cstEntry];
+    const UINT16                *pTable     = (pFctLabel == NULL) ? pIndex->pFctId : pIndex->pFctName;
+    UINT32 slot = ((pFctLabel == NULL) ? ttiIdHash(fctId) : ttiLabelHash(pFctLabel)) & pIndex->mask;
+
+    for (; pTable[slot] != TTI_NO_INDEX; slot = (slot + 1u) & pIndex->mask)
+    {
+        const TRDP_FUNCTION_INFO_T *pFct = &pCstInfo->pFctInfoList[pTable[slot]];
+
+        if ((pFctLabel == NULL) ?
+            (pFct->fctId == fctId) :
+            (vos_strnicmp(pFct->fctName, pFctLabel, sizeof(TRDP_NET_LABEL_T)) == 0))
+        {
+            return pTable[slot];
+        }
+    }
+    return TTI_NO_INDEX;
+}
+
+/**********************************************************************************************************************/
+/** Remove a consist info entry and its lookup tables
+ *  The consist label index must be rebuilt by the caller.
+ *
+ *  @param[in]      pTTDB           TTDB
+ *  @param[in]      cstEntry        entry index of the consist
+ *
+ *  @retval         none
+ */
+static void ttiDropCstInfo (
+    TAU_TTDB_T  *pTTDB,
+    UINT32      cstEntry)
+{
+    if (pTTDB->cstInfo[cstEntry] != NULL)
+    {
+        ttiFreeCstInfoEntry(pTTDB->cstInfo[cstEntry]);
+        vos_memFree(pTTDB->cstInfo[cstEntry]);
+        pTTDB->cstInfo[cstEntry]    = NULL;
+        pTTDB->cstSize[cstEntry]    = 0u;
+        pTTDB->noOfCachedCst--;
+        pTTDB->cstVersion++;
+    }
+    if (pTTDB->cstIndex[cstEntry].pVehId != NULL)
+    {
+        vos_memFree(pTTDB->cstIndex[cstEntry].pVehId);
+        memset(&pTTDB->cstIndex[cstEntry], 0, sizeof(TTI_CST_INDEX_T));
+    }
+}
+
+/**********************************************************************************************************************/
+/** Request a consist info which is not cached
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[in]      pCstLabel       consist label, NULL means own consist
+ *
+ *  @retval         none
+ */
+static void ttiRequestCstInfo (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pCstLabel)
+{
+    TRDP_UUID_T cstUUID;
+    UINT8       ownTrnCstNo = appHandle->pTTDB->opTrnState.ownTrnCstNo;
+
+    if (pCstLabel != NULL)
+    {
+        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
+    }
+    else if ((ownTrnCstNo != 0u) && (ownTrnCstNo <= TRDP_MAX_CST_CNT))
+    {
+        memcpy(cstUUID, appHandle->pTTDB->trnNetDir.trnNetDir[ownTrnCstNo - 1u].cstUUID, sizeof(TRDP_UUID_T));
+    }
+    else
+    {
+        memset(cstUUID, 0, sizeof(TRDP_UUID_T));
+    }
+    ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
+}
+
 /**********************************************************************************************************************/
 /** Store the received consist info
  *
- *  Find an appropriate location to store the received consist info
+ *  Decode the consist info, build its lookup tables and put it into the entry of the same consist, into a free
+ *  entry or over the oldest one. The own consist always goes to entry 0.
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
  *  @param[in]      pData           Pointer to the network buffer.
@@ -693,56 +1056,65 @@ static void ttiStoreCstInfo (
     UINT8               *pData,
     UINT32              dataSize)
 {
-    TRDP_CONSIST_INFO_T *pTelegram = (TRDP_CONSIST_INFO_T *) pData;
-    UINT32 curEntry = 0;
+    TAU_TTDB_T          *pTTDB      = appHandle->pTTDB;
+    TRDP_CONSIST_INFO_T *pTelegram  = (TRDP_CONSIST_INFO_T *) pData;
+    TRDP_CONSIST_INFO_T *pCstInfo;
+    UINT32 curEntry = 0u;
 
-    if (ttiIsOwnCstInfo(appHandle, pTelegram) == TRUE)
-    {
-        if (appHandle->pTTDB->cstInfo[curEntry] != NULL)
-        {
-            ttiFreeCstInfoEntry(appHandle->pTTDB->cstInfo[curEntry]);
-            vos_memFree(appHandle->pTTDB->cstInfo[curEntry]);
-            appHandle->pTTDB->cstInfo[curEntry] = NULL;
-        }
-    }
-    else
+    if (ttiIsOwnCstInfo(appHandle, pTelegram) == FALSE)
     {
         UINT32 l_index;
-        curEntry = 1;
-        /* check if already loaded */
-        for (l_index = 1; l_index < TRDP_MAX_CST_CNT; l_index++)
+        curEntry = 1u;
+        /* check if already loaded, else take the first free or the oldest entry */
+        for (l_index = 1u; l_index < TTI_CACHED_CONSISTS; l_index++)
         {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                appHandle->pTTDB->cstInfo[l_index]->cstTopoCnt != 0 &&
-                memcmp(appHandle->pTTDB->cstInfo[l_index]->cstUUID, pTelegram->cstUUID, sizeof(TRDP_UUID_T)) == 0)
+            if (pTTDB->cstInfo[l_index] == NULL)
+            {
+                if (pTTDB->cstInfo[curEntry] != NULL)
+                {
+                    curEntry = l_index;
+                }
+            }
+            else if (memcmp(pTTDB->cstInfo[l_index]->cstUUID, pTelegram->cstUUID, sizeof(TRDP_UUID_T)) == 0)
             {
-                ttiFreeCstInfoEntry(appHandle->pTTDB->cstInfo[l_index]);
-                vos_memFree(appHandle->pTTDB->cstInfo[l_index]);
-                appHandle->pTTDB->cstInfo[l_index] = NULL;
                 curEntry = l_index;
                 break;
             }
+            else if ((pTTDB->cstInfo[curEntry] != NULL) &&
+                     (pTTDB->cstStamp[l_index] < pTTDB->cstStamp[curEntry]))
+            {
+                curEntry = l_index;
+            }
         }
     }
+    ttiDropCstInfo(pTTDB, curEntry);
 
     /* Allocate space for the consist info */
-    appHandle->pTTDB->cstInfo[curEntry] = (TRDP_CONSIST_INFO_T *) vos_memAlloc(sizeof(TRDP_CONSIST_INFO_T));
-    if (appHandle->pTTDB->cstInfo[curEntry] == NULL)
+    pCstInfo = (TRDP_CONSIST_INFO_T *) vos_memAlloc(sizeof(TRDP_CONSIST_INFO_T));
+    if (pCstInfo == NULL)
     {
+        ttiIndexConsists(pTTDB);
         vos_printLogStr(VOS_LOG_ERROR, "Consist info could not be stored!");
         return;
     }
 
     /* We do convert and allocate more memory for the several parts of the consist info inside. */
 
-    if (ttiCreateCstInfoEntry(appHandle->pTTDB->cstInfo[curEntry], pData, dataSize) != TRDP_NO_ERR)
+    if ((ttiCreateCstInfoEntry(pCstInfo, pData, dataSize) != TRDP_NO_ERR) ||
+        (ttiIndexCstInfo(&pTTDB->cstIndex[curEntry], pCstInfo) != TRDP_NO_ERR))
     {
-        vos_memFree(appHandle->pTTDB->cstInfo[curEntry]);
-        appHandle->pTTDB->cstSize[curEntry] = 0u;
+        ttiFreeCstInfoEntry(pCstInfo);
+        vos_memFree(pCstInfo);
+        ttiIndexConsists(pTTDB);
         vos_printLogStr(VOS_LOG_ERROR, "Parts of consist info could not be stored!");
         return;
     }
-    appHandle->pTTDB->cstSize[curEntry] = sizeof(TRDP_CONSIST_INFO_T);
+    pTTDB->cstInfo[curEntry]    = pCstInfo;
+    pTTDB->cstSize[curEntry]    = sizeof(TRDP_CONSIST_INFO_T);
+    pTTDB->noOfCachedCst++;
+    pTTDB->cstVersion++;
+    pTTDB->cstStamp[curEntry] = pTTDB->cstVersion;
+    ttiIndexConsists(pTTDB);
 }
 
 /**********************************************************************************************************************/
@@ -790,27 +1162,9 @@ static void ttiMDCallback (
         {
             if (dataSize <= sizeof(TRDP_TRAIN_DIR_T))
             {
-                UINT32 i;
                 ttiStoreTrnDir(appHandle, pData);
-                /* Request consist infos now (fill cache)   */
-                for (i = 0; i < TTI_CACHED_CONSISTS; i++)
-                {
-                    /* invalidate entry */
-                    if (appHandle->pTTDB->cstInfo[i] != NULL)
-                    {
-                        vos_memFree(appHandle->pTTDB->cstInfo[i]);
-                        appHandle->pTTDB->cstInfo[i] = NULL;
-                    }
-                    ;
-                }
-                for (i = 0; i < TTI_CACHED_CONSISTS; i++)
-                {
-                    if (appHandle->pTTDB->trnDir.cstList[i].cstTopoCnt == 0)
-                    {
-                        break;  /* no of available consists reached   */
-                    }
-                    ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, appHandle->pTTDB->trnDir.cstList[i].cstUUID);
-                }
+                /* Request changed consist infos now (fill cache)   */
+                ttiRefreshCstInfo(appHandle);
             }
         }
         else if (pMsg->comId == TTDB_NET_DIR_REP_COMID)
@@ -850,6 +1204,7 @@ static void ttiMDCallback (
                 (void) ttiStoreOpTrnDir(appHandle, (UINT8 *) &pTelegram->opTrnDir);
                 ttiStoreTrnDir(appHandle, (UINT8 *) &pTelegram->trnDir);
                 ttiStoreTrnNetDir(appHandle, (UINT8 *) &pTelegram->trnNetDir);
+                ttiRefreshCstInfo(appHandle);
             }
         }
         else if (pMsg->comId == TTDB_STAT_CST_REP_COMID)
@@ -883,6 +1238,81 @@ static void ttiMDCallback (
     }
 }
 
+/**********************************************************************************************************************/
+/**    Send a consist info request to the ECSP
+ *  The request is queued only, it goes out with the next tlc_process() / tlm_process() cycle.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[in]      cstUUID         UUID of the consist
+ *
+ *  @retval         none
+ *
+ */
+static void ttiSendCstInfoRequest (
+    TRDP_APP_SESSION_T  appHandle,
+    const TRDP_UUID_T   cstUUID)
+{
+    (void) tlm_request(appHandle, NULL, ttiMDCallback, NULL, TTDB_STAT_CST_REQ_COMID, appHandle->etbTopoCnt,
+                       appHandle->opTrnTopoCnt, 0, tau_ipFromURI(appHandle,
+                                                             TTDB_STAT_CST_REQ_URI), TRDP_FLAGS_CALLBACK, 1,
+                       TTDB_STAT_CST_REQ_TO_US, NULL, cstUUID, sizeof(TRDP_UUID_T), NULL, NULL);
+}
+
+/**********************************************************************************************************************/
+/**    Bring the cached consist infos in line with a new train directory
+ *
+ *  Consist infos of consists which left the train or whose cstTopoCnt changed are dropped, all others are kept.
+ *  Consists not cached yet are requested, as many as fit into the cache. These requests are sent together and are
+ *  in flight in parallel; coupling or decoupling fetches the changed consists only.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *
+ *  @retval         none
+ *
+ */
+static void ttiRefreshCstInfo (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TAU_TTDB_T  *pTTDB      = appHandle->pTTDB;
+    UINT32      requested   = 0u;
+    UINT32      dropped     = 0u;
+    UINT32      l_index, i;
+
+    for (l_index = 0u; l_index < TTI_CACHED_CONSISTS; l_index++)
+    {
+        if (pTTDB->cstInfo[l_index] != NULL)
+        {
+            for (i = 0u; i < pTTDB->trnDir.cstCnt; i++)
+            {
+                if (memcmp(pTTDB->trnDir.cstList[i].cstUUID, pTTDB->cstInfo[l_index]->cstUUID,
+                           sizeof(TRDP_UUID_T)) == 0)
+                {
+                    break;
+                }
+            }
+            if ((i == pTTDB->trnDir.cstCnt) ||
+                (pTTDB->trnDir.cstList[i].cstTopoCnt != pTTDB->cstInfo[l_index]->cstTopoCnt))
+            {
+                ttiDropCstInfo(pTTDB, l_index);
+                dropped++;
+            }
+        }
+    }
+    ttiIndexConsists(pTTDB);
+
+    for (i = 0u; (i < pTTDB->trnDir.cstCnt) && ((pTTDB->noOfCachedCst + requested) < TTI_CACHED_CONSISTS); i++)
+    {
+        if ((pTTDB->trnDir.cstList[i].cstTopoCnt != 0u) &&         /* 0: no consist info available */
+            (ttiFindCstByUUID(pTTDB, pTTDB->trnDir.cstList[i].cstUUID) == TTI_CACHED_CONSISTS))
+        {
+            ttiSendCstInfoRequest(appHandle, pTTDB->trnDir.cstList[i].cstUUID);
+            requested++;
+        }
+    }
+    vos_printLog(VOS_LOG_INFO, "Train directory: %u consist infos kept, %u dropped, %u requested\n",
+                 pTTDB->noOfCachedCst, dropped, requested);
+}
+
 /**********************************************************************************************************************/
 /**    Function to request TTDB data from ECSP
  *
@@ -941,10 +1371,7 @@ static void ttiRequestTTDBdata (
         break;
         case TTDB_STAT_CST_REQ_COMID:
         {
-            (void) tlm_request(appHandle, NULL, ttiMDCallback, NULL, TTDB_STAT_CST_REQ_COMID, appHandle->etbTopoCnt,
-                               appHandle->opTrnTopoCnt, 0, tau_ipFromURI(appHandle,
-                                                                     TTDB_STAT_CST_REQ_URI), TRDP_FLAGS_CALLBACK, 1,
-                               TTDB_STAT_CST_REQ_TO_US, NULL, cstUUID, sizeof(TRDP_UUID_T), NULL, NULL);
+            ttiSendCstInfoRequest(appHandle, cstUUID);
         }
         break;
 
@@ -1086,13 +1513,9 @@ EXT_DECL void tau_deInitTTI (
     if (appHandle->pTTDB != NULL)
     {
         UINT32 i;
-        for (i = 0; i < appHandle->pTTDB->noOfCachedCst; i++)
+        for (i = 0; i < TTI_CACHED_CONSISTS; i++)
         {
-            if (appHandle->pTTDB->cstInfo[i] != NULL)
-            {
-                vos_memFree(appHandle->pTTDB->cstInfo[i]);
-                appHandle->pTTDB->cstInfo[i] = NULL;
-            }
+            ttiDropCstInfo(appHandle->pTTDB, i);
         }
         (void) tlm_delListener(appHandle, appHandle->pTTDB->md101Listener1);
         (void) tlp_unsubscribe(appHandle, appHandle->pTTDB->pd100SubHandle1);
@@ -1236,14 +1659,7 @@ EXT_DECL TRDP_ERR_T tau_getStaticCstInfo (
     else
     {
         /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
-        {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                memcmp(appHandle->pTTDB->cstInfo[l_index]->cstUUID, cstUUID, sizeof(TRDP_UUID_T)) == 0)
-            {
-                break;
-            }
-        }
+        l_index = ttiFindCstByUUID(appHandle->pTTDB, cstUUID);
     }
     if (l_index < TTI_CACHED_CONSISTS &&
         appHandle->pTTDB->cstInfo[l_index] != NULL)
@@ -1402,31 +1818,15 @@ EXT_DECL TRDP_ERR_T tau_getCstVehCnt (
         return TRDP_PARAM_ERR;
     }
 
-    if (pCstLabel == NULL)
-    {
-        l_index = 0;
-    }
-    else
-    {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
-        {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
-        }
-    }
+    /* find the consist in our cache list */
+    l_index = ttiFindCst(appHandle->pTTDB, pCstLabel);
     if (l_index < TTI_CACHED_CONSISTS)
     {
-        *pCstVehCnt = vos_ntohs(appHandle->pTTDB->cstInfo[l_index]->vehCnt);
+        *pCstVehCnt = appHandle->pTTDB->cstInfo[l_index]->vehCnt;
     }
     else    /* not found, get it and return directly */
     {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
-        ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
+        ttiRequestCstInfo(appHandle, pCstLabel);
         return TRDP_NODATA_ERR;
     }
     return TRDP_NO_ERR;
@@ -1458,31 +1858,15 @@ EXT_DECL TRDP_ERR_T tau_getCstFctCnt (
         return TRDP_PARAM_ERR;
     }
 
-    if (pCstLabel == NULL)
-    {
-        l_index = 0;
-    }
-    else
-    {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
-        {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
-        }
-    }
+    /* find the consist in our cache list */
+    l_index = ttiFindCst(appHandle->pTTDB, pCstLabel);
     if (l_index < TTI_CACHED_CONSISTS)
     {
-        *pCstFctCnt = vos_ntohs(appHandle->pTTDB->cstInfo[l_index]->fctCnt);
+        *pCstFctCnt = appHandle->pTTDB->cstInfo[l_index]->fctCnt;
     }
     else    /* not found, get it and return directly */
     {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
-        ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
+        ttiRequestCstInfo(appHandle, pCstLabel);
         return TRDP_NODATA_ERR;
     }
     return TRDP_NO_ERR;
@@ -1511,7 +1895,7 @@ EXT_DECL TRDP_ERR_T tau_getCstFctInfo (
     const TRDP_LABEL_T      pCstLabel,
     UINT16                  maxFctCnt)
 {
-    UINT32 l_index, l_index2;
+    UINT32 l_index;
     if ((appHandle == NULL) ||
         (appHandle->pTTDB == NULL) ||
         (pFctInfo == NULL) ||
@@ -1520,36 +1904,21 @@ EXT_DECL TRDP_ERR_T tau_getCstFctInfo (
         return TRDP_PARAM_ERR;
     }
 
-    if (pCstLabel == NULL)
-    {
-        l_index = 0;
-    }
-    else
-    {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
-        {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
-        }
-    }
+    /* find the consist in our cache list */
+    l_index = ttiFindCst(appHandle->pTTDB, pCstLabel);
     if (l_index < TTI_CACHED_CONSISTS)
     {
-        for (l_index2 = 0; l_index2 < vos_ntohs(appHandle->pTTDB->cstInfo[l_index]->fctCnt) &&
-             l_index2 < maxFctCnt; ++l_index2)
+        UINT32 cnt = appHandle->pTTDB->cstInfo[l_index]->fctCnt;
+
+        if (cnt > maxFctCnt)
         {
-            pFctInfo[l_index2]          = appHandle->pTTDB->cstInfo[l_index]->pFctInfoList[l_index2];
-            pFctInfo[l_index2].fctId    = vos_ntohs(pFctInfo[l_index2].fctId);
+            cnt = maxFctCnt;
         }
+        memcpy(pFctInfo, appHandle->pTTDB->cstInfo[l_index]->pFctInfoList, cnt * sizeof(TRDP_FUNCTION_INFO_T));
     }
     else    /* not found, get it and return directly */
     {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
-        ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
+        ttiRequestCstInfo(appHandle, pCstLabel);
         return TRDP_NODATA_ERR;
     }
     return TRDP_NO_ERR;
@@ -1562,11 +1931,13 @@ EXT_DECL TRDP_ERR_T tau_getCstFctInfo (
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
  *  @param[out]     pVehInfo        Pointer to the vehicle info to be returned.
- *  @param[in]      pVehLabel       Pointer to a vehicle label. NULL means own vehicle  if cstLabel refers to own consist.
+ *  @param[in]      pVehLabel       Pointer to a vehicle label. NULL means own vehicle  if cstLabel refers to own consist,
+ *                                  first vehicle otherwise.
  *  @param[in]      pCstLabel       Pointer to a consist label. NULL means own consist.
  *
  *  @retval         TRDP_NO_ERR     no error
- *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_PARAM_ERR  Parameter error or unknown vehicle
+ *  @retval         TRDP_NODATA_ERR Try again
  *
  */
 EXT_DECL TRDP_ERR_T tau_getVehInfo (
@@ -1583,39 +1954,85 @@ EXT_DECL TRDP_ERR_T tau_getVehInfo (
         return TRDP_PARAM_ERR;
     }
 
-    if (pCstLabel == NULL)
-    {
-        l_index = 0;
-    }
-    else
+    /* find the consist in our cache list */
+    l_index = ttiFindCst(appHandle->pTTDB, pCstLabel);
+    if (l_index < TTI_CACHED_CONSISTS)
     {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
+        const TRDP_CONSIST_INFO_T *pCstInfo = appHandle->pTTDB->cstInfo[l_index];
+
+        if (pVehLabel != NULL)
         {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
+            l_index2 = ttiFindVeh(appHandle->pTTDB, l_index, pVehLabel);
         }
+        else
+        {
+            /* own vehicle: the one hosting our own device, else the first one */
+            l_index2 = (l_index == 0u) ?
+                ttiFindFct(appHandle->pTTDB, l_index, (UINT16) (appHandle->realIP & 0x00000FFF), NULL) : TTI_NO_INDEX;
+            l_index2 = ((l_index2 != TTI_NO_INDEX) &&
+                        (pCstInfo->pFctInfoList[l_index2].cstVehNo != 0u) &&
+                        (pCstInfo->pFctInfoList[l_index2].cstVehNo <= pCstInfo->vehCnt)) ?
+                (pCstInfo->pFctInfoList[l_index2].cstVehNo - 1u) : 0u;
+        }
+        if ((l_index2 == TTI_NO_INDEX) || (l_index2 >= pCstInfo->vehCnt))
+        {
+            return TRDP_PARAM_ERR;
+        }
+        *pVehInfo = pCstInfo->pVehInfoList[l_index2];
+    }
+    else    /* not found, get it and return directly */
+    {
+        ttiRequestCstInfo(appHandle, pCstLabel);
+        return TRDP_NODATA_ERR;
     }
+    return TRDP_NO_ERR;
+}
+
+
+/**********************************************************************************************************************/
+/**    Function to retrieve the information of a single function of a consist.
+ *
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[out]     pFctInfo        Pointer to the function info to be returned.
+ *  @param[in]      fctId           Function ID, used if pFctLabel is NULL.
+ *  @param[in]      pFctLabel       Pointer to a function label. NULL means search by fctId.
+ *  @param[in]      pCstLabel       Pointer to a consist label. NULL means own consist.
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  Parameter error or unknown function
+ *  @retval         TRDP_NODATA_ERR Try again
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_getFctInfo (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_FUNCTION_INFO_T    *pFctInfo,
+    UINT16                  fctId,
+    const TRDP_LABEL_T      pFctLabel,
+    const TRDP_LABEL_T      pCstLabel)
+{
+    UINT32 l_index, l_index2;
+    if ((appHandle == NULL) ||
+        (appHandle->pTTDB == NULL) ||
+        (pFctInfo == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /* find the consist in our cache list */
+    l_index = ttiFindCst(appHandle->pTTDB, pCstLabel);
     if (l_index < TTI_CACHED_CONSISTS)
     {
-        for (l_index2 = 0; l_index2 < vos_ntohs(appHandle->pTTDB->cstInfo[l_index]->vehCnt); ++l_index2)
+        l_index2 = ttiFindFct(appHandle->pTTDB, l_index, fctId, pFctLabel);
+        if (l_index2 == TTI_NO_INDEX)
         {
-            if (pVehLabel == NULL ||
-                vos_strnicmp(pVehLabel, appHandle->pTTDB->cstInfo[l_index]->pVehInfoList[l_index2].vehId,
-                             sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                *pVehInfo = appHandle->pTTDB->cstInfo[l_index]->pVehInfoList[l_index2];
-            }
+            return TRDP_PARAM_ERR;
         }
+        *pFctInfo = appHandle->pTTDB->cstInfo[l_index]->pFctInfoList[l_index2];
     }
     else    /* not found, get it and return directly */
     {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
-        ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
+        ttiRequestCstInfo(appHandle, pCstLabel);
         return TRDP_NODATA_ERR;
     }
     return TRDP_NO_ERR;
@@ -1647,34 +2064,15 @@ EXT_DECL TRDP_ERR_T tau_getCstInfo (
         return TRDP_PARAM_ERR;
     }
 
-    if (pCstLabel == NULL)
-    {
-        l_index = 0;
-    }
-    else
-    {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
-        {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
-        }
-    }
+    /* find the consist in our cache list */
+    l_index = ttiFindCst(appHandle->pTTDB, pCstLabel);
     if (l_index < TTI_CACHED_CONSISTS)
     {
-        *pCstInfo           = *appHandle->pTTDB->cstInfo[l_index];
-        pCstInfo->etbCnt    = vos_ntohs(pCstInfo->etbCnt);
-        pCstInfo->vehCnt    = vos_ntohs(pCstInfo->vehCnt);
-        pCstInfo->fctCnt    = vos_ntohs(pCstInfo->fctCnt);
+        *pCstInfo = *appHandle->pTTDB->cstInfo[l_index];
     }
     else    /* not found, get it and return directly */
     {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
-        ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
+        ttiRequestCstInfo(appHandle, pCstLabel);
         return TRDP_NODATA_ERR;
     }
     return TRDP_NO_ERR;
@@ -1725,22 +2123,8 @@ EXT_DECL TRDP_ERR_T tau_getVehOrient (
     *pVehOrient = 0;
     *pCstOrient = 0;
 
-    if (pCstLabel == NULL)
-    {
-        l_index = 0;
-    }
-    else
-    {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
-        {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
-        }
-    }
+    /* find the consist in our cache list */
+    l_index = ttiFindCst(appHandle->pTTDB, pCstLabel);
     if (l_index < TTI_CACHED_CONSISTS)
     {
         /* Search the vehicles in the OP_TRAIN_DIR for a matching vehID */
@@ -1767,9 +2151,7 @@ EXT_DECL TRDP_ERR_T tau_getVehOrient (
     }
     else    /* not found, get it and return directly */
     {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
-        ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
+        ttiRequestCstInfo(appHandle, pCstLabel);
         return TRDP_NODATA_ERR;
     }
     return TRDP_NO_ERR;
@@ -1810,40 +2192,38 @@ EXT_DECL TRDP_ERR_T tau_getOwnIds (
     }
 
     /* if not already there, get the consist info for our consist */
-    if (appHandle->pTTDB->noOfCachedCst == 0)                 /* own Consist info  */
+    if (appHandle->pTTDB->cstInfo[0] == NULL)                 /* own Consist info  */
     {    /* not found, get it and return immediately */
-        ttiRequestTTDBdata(appHandle, TRDP_TTDB_STATIC_CST_INF_REQ_COMID,
-                           appHandle->pTTDB->trnNetDir.trnNetDir[appHandle->pTTDB->opTrnState.ownTrnCstNo - 1].cstUUID);
+        ttiRequestCstInfo(appHandle, NULL);
         return TRDP_NODATA_ERR;
     }
 
     /* here we should have all the infos we need to fullfill the request */
 
-    if (pDevId != NULL)
+    if ((pDevId != NULL) || (pVehId != NULL))
     {
-        unsigned int    index;
+        const TRDP_CONSIST_INFO_T *pCstInfo = appHandle->pTTDB->cstInfo[0];
         /* deduct our device / function ID from our IP address */
         UINT16          ownIP = (UINT16) (appHandle->realIP & 0x00000FFF);
         /* Problem: What if it is not set? Default interface is 0! */
+        UINT32          index = ttiFindFct(appHandle->pTTDB, 0u, ownIP, NULL);
 
-        /* we traverse the consist info's functions */
-        for (index = 0; index < appHandle->pTTDB->cstInfo[0]->fctCnt; index++)
+        if (index != TTI_NO_INDEX)
         {
-            if (ownIP == appHandle->pTTDB->cstInfo[0]->pFctInfoList[index].fctId)
+            /* Get the name */
+            if (pDevId != NULL)
             {
-                /* Get the name */
-                if (pDevId != NULL)
-                {
-                    memcpy(pDevId, appHandle->pTTDB->cstInfo[0]->pFctInfoList[index].fctName, TRDP_MAX_LABEL_LEN);
-                }
+                memcpy(pDevId, pCstInfo->pFctInfoList[index].fctName, TRDP_MAX_LABEL_LEN);
+            }
 
-                /* Get the vehicle name this device is in */
-                if (pVehId != NULL)
+            /* Get the vehicle name this device is in (cstVehNo counts from 1) */
+            if (pVehId != NULL)
+            {
+                UINT8 vehNo = pCstInfo->pFctInfoList[index].cstVehNo;
+                if ((vehNo != 0u) && (vehNo <= pCstInfo->vehCnt))
                 {
-                    UINT8 vehNo = appHandle->pTTDB->cstInfo[0]->pFctInfoList[index].cstVehNo;
-                    memcpy(pVehId, appHandle->pTTDB->cstInfo[0]->pVehInfoList[vehNo].vehId, TRDP_MAX_LABEL_LEN);
+                    memcpy(pVehId, pCstInfo->pVehInfoList[vehNo - 1u].vehId, TRDP_MAX_LABEL_LEN);
                 }
-                break;
             }
         }
     }
@@ -1892,3 +2272,24 @@ EXT_DECL UINT8 tau_getOwnTrnCstNo (
     }
     return 0u;
 }
+
+/**********************************************************************************************************************/
+/** Get the version of the cached consist infos.
+ *  The version is incremented whenever a consist info is stored or dropped. Callers polling the consist infos may
+ *  compare it to the version seen last and skip re-reading unchanged data.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_init
+ *
+ *  @retval         version             current version of the consist infos
+ *                  0                   on error or if no consist info was received yet
+ */
+EXT_DECL UINT32 tau_getCstInfoVersion (
+    TRDP_APP_SESSION_T appHandle)
+{
+    if ((appHandle != NULL) &&
+        (appHandle->pTTDB != NULL))
+    {
+        return appHandle->pTTDB->cstVersion;
+    }
+    return 0u;
+}
@@ -17,6 +17,8 @@
  /*
  * $Id: tau_xml.c 2172 2020-06-29 14:12:06Z s-bender $
  *
+ *      AG 2026-10-17: tau_calcArenaConfig(): separate publisher/subscriber sizes, full size sequence counter lists
+ *      AG 2026-10-17: tau_calcArenaConfig() sizes a fixed footprint session from the telegram configuration
  *      SB 2020-06-29: Ticket #338: Attribute Callback always does not work
  *      AR 2020-05-08: Added parsing for attribute 'name' of event, method, field and instance elements used in service oriented interface
  *      SB 2020-01-27: Added parsing for dummyService flag to Service definitions and MD option for events
@@ -1619,6 +1621,66 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
     return result;
 }
 
+/**********************************************************************************************************************/
+/**    Compute the arena sizes of a fixed footprint session from the telegram configuration
+ *  Each destination of a published and each source of a subscribed telegram is one PD element (at least one per
+ *  telegram), each PD element gets a spare frame for tlp_getRef/tlp_putBegin. A subscribed telegram without sources
+ *  may hear any number of senders and gets a full size sequence counter list. MD telegrams are counted as one caller
+ *  and one replier session per destination/source.
+ *
+ *  @param[in]      numExchgPar       Number of telegram configurations in the array
+ *  @param[in]      pExchgPar         Pointer to array of telegram configurations (from tau_readXmlInterfaceConfig)
+ *  @param[out]     pArenaConfig      Sizes for tlc_presetArenaSession, the memory pointer is set to NULL
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_calcArenaConfig (
+    UINT32                  numExchgPar,
+    const TRDP_EXCHG_PAR_T  *pExchgPar,
+    TRDP_ARENA_CONFIG_T     *pArenaConfig)
+{
+    UINT32  idxEP;
+    UINT32  noOfPub, noOfSub;
+
+    if ((pArenaConfig == NULL) || ((numExchgPar != 0u) && (pExchgPar == NULL)))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    memset(pArenaConfig, 0, sizeof(TRDP_ARENA_CONFIG_T));
+
+    for (idxEP = 0u; idxEP < numExchgPar; idxEP++)
+    {
+        noOfPub = noOfSub = 0u;
+        if ((pExchgPar[idxEP].type == TRDP_EXCHG_SOURCE) || (pExchgPar[idxEP].type == TRDP_EXCHG_SOURCESINK))
+        {
+            noOfPub = (pExchgPar[idxEP].destCnt == 0u) ? 1u : pExchgPar[idxEP].destCnt;
+        }
+        if ((pExchgPar[idxEP].type == TRDP_EXCHG_SINK) || (pExchgPar[idxEP].type == TRDP_EXCHG_SOURCESINK))
+        {
+            noOfSub = (pExchgPar[idxEP].srcCnt == 0u) ? 1u : pExchgPar[idxEP].srcCnt;
+        }
+        if (pExchgPar[idxEP].pMdPar != NULL)
+        {
+            pArenaConfig->maxNoOfMdElements += noOfPub + noOfSub;
+        }
+        else
+        {
+            pArenaConfig->maxNoOfPublishers     += noOfPub;
+            pArenaConfig->maxNoOfSubscribers    += noOfSub;
+            pArenaConfig->maxNoOfSeqCntLists    += noOfSub;
+            if ((noOfSub != 0u) && (pExchgPar[idxEP].srcCnt == 0u))
+            {
+                pArenaConfig->maxNoOfFullSeqCntLists++;
+            }
+        }
+    }
+    pArenaConfig->maxNoOfPubFrames  = 2u * pArenaConfig->maxNoOfPublishers;
+    pArenaConfig->maxNoOfSubFrames  = 2u * pArenaConfig->maxNoOfSubscribers;
+    return TRDP_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /**    Free array of telegram configurations allocated by tau_readXmlInterfaceConfig
  *
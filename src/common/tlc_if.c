@@ -17,6 +17,16 @@
 /*
 * $Id: tlc_if.c 2202 2020-08-18 13:12:43Z bloehr $
 *
+*      AG 2026-10-17: A configured MD sendingTimeout is taken (default 0 as before), shareTcp
+*      AG 2026-10-17: Free the send queues of the TCP connections on tlc_closeSession()
+*      AG 2026-10-17: tlc_processEvents() and tlc_getPollHandle(): event driven work loop on a VOS poll set (epoll)
+*      AG 2026-10-17: Free the receive buffers of the TCP connections on tlc_closeSession()
+*      AG 2026-10-17: Free the MD listener index on tlc_closeSession()
+*      AG 2026-10-17: Free the sessionID indices of the MD queues on tlc_closeSession()
+*      AG 2026-10-17: tlc_presetArenaSession() and tlc_arenaSize() for fixed footprint sessions
+*      AG 2026-10-17: Free the buffers of tlp_getRef() and tlp_putBegin() on tlc_closeSession()
+*      AG 2026-10-17: Free the subscriber hash index on tlc_closeSession()
+*      AG 2026-10-17: Allocate ring of PD receive buffers for batched reception
 *      BL 2020-07-29: tlc_init() marks version info with 'trunk' (if vers.evo != 0)
 *      BL 2020-01-10: Undoing svn revision output, would reflect file revision, only.
 *      BL 2019-11-06: Ticket #289: Changed the max. returnedwait time of tlc_getInterval to 1s (instead of 1000s)
@@ -116,6 +126,21 @@
 extern "C" {
 #endif
 
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#ifndef HIGH_PERF_INDEXED
+/** Max. number of readable sockets fetched by one wait of tlc_processEvents()   */
+#define TRDP_POLL_EVENTS            32u
+
+/** Reference of a socket in the poll set of the session: socket pool and index in the pool    */
+#define TRDP_POLL_REF_PD            0x00000u
+#define TRDP_POLL_REF_MD            0x10000u
+#define TRDP_POLL_REF_LISTEN        0x20000u
+#define TRDP_POLL_REF_IDX_MASK      0x0FFFFu
+#endif
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -455,6 +480,7 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
     pSession->mdDefault.sendParam.retries   = TRDP_MD_DEFAULT_RETRIES;
     pSession->mdDefault.maxNumSessions      = TRDP_MD_MAX_NUM_SESSIONS;
     pSession->tcpFd.listen_sd               = VOS_INVALID_SOCKET;
+    pSession->tcpFd.poll_sd                 = VOS_INVALID_SOCKET;
 
 #endif
 
@@ -487,8 +513,6 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
 
 #if MD_SUPPORT
     trdp_initSockets(pSession->ifaceMD, TRDP_MAX_MD_SOCKET_CNT);
-    /* Initialize pointers to Null in the incomplete message structure */
-    trdp_initUncompletedTCP(pSession);
 #endif
 
     /*    Clear the statistics for this session */
@@ -506,11 +530,21 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
         return TRDP_MEM_ERR;
     }
 
+    /*  Get the buffers to receive several PDs with one call   */
+    if (trdp_allocRcvRing(pSession) != TRDP_NO_ERR)
+    {
+        vos_memFree(pSession->pNewFrame);
+        vos_memFree(pSession);
+        vos_printLogStr(VOS_LOG_ERROR, "Out of meory!\n");
+        return TRDP_MEM_ERR;
+    }
+
     /*    Queue the session in    */
     ret = (TRDP_ERR_T) vos_mutexLock(sSessionMutex);
 
     if (ret != TRDP_NO_ERR)
     {
+        trdp_freeRcvRing(pSession);
         vos_memFree(pSession->pNewFrame);
         vos_memFree(pSession);
         vos_printLog(VOS_LOG_ERROR, "vos_mutexLock() failed (Err: %d)\n", ret);
@@ -773,7 +807,7 @@ EXT_DECL TRDP_ERR_T tlc_configSession (
             pSession->mdDefault.connectTimeout = pMdDefault->connectTimeout;
         }
 
-        if ((pSession->mdDefault.sendingTimeout == TRDP_MD_DEFAULT_SENDING_TIMEOUT) &&
+        if ((pSession->mdDefault.sendingTimeout == 0u) &&
             (pMdDefault->sendingTimeout != 0u))
         {
             pSession->mdDefault.sendingTimeout = pMdDefault->sendingTimeout;
@@ -791,6 +825,11 @@ EXT_DECL TRDP_ERR_T tlc_configSession (
             pSession->mdDefault.maxNumSessions = pMdDefault->maxNumSessions;
         }
 
+        if (pMdDefault->shareTcp == TRUE)
+        {
+            pSession->mdDefault.shareTcp = TRUE;
+        }
+
     }
 
     /* Set some statistic defaults here */
@@ -914,6 +953,78 @@ EXT_DECL TRDP_ERR_T tlc_presetIndexSession (
     return ret;
 } /* lint !w438 return value not used */
 
+/**********************************************************************************************************************/
+/** Preset a fixed memory footprint for a session.
+ *
+ *  tlc_presetArenaSession reserves one contiguous arena for the PD and MD elements, PD frames and sequence counter
+ *  lists of a session and sizes the subscriber index for maxNoOfSubscribers subscriptions. Elements are taken from
+ *  the arena in O(1) and returned to it on removal; after tlc_updateSession no further memory is allocated as
+ *  long as the configured numbers are not exceeded (if they are, vos_memAlloc is used as before).
+ *  Publishers and subscribers have separate slabs, guarded by the send and receive mutexes they are handled under.
+ *  The sizes can be computed from the XML configuration with tau_calcArenaConfig(). If no memory is supplied, the
+ *  arena is taken from vos_memAlloc, with a memory pool it must then fit into its largest block size.
+ *  This function must be called right after the session has been opened, before the first publish/subscribe.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      pArenaConfig        Number of elements, optionally memory of at least tlc_arenaSize() bytes
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_INIT_ERR       not yet inited
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_STATE_ERR      the session has already an arena
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+EXT_DECL TRDP_ERR_T tlc_presetArenaSession (
+    TRDP_APP_SESSION_T          appHandle,
+    const TRDP_ARENA_CONFIG_T   *pArenaConfig)
+{
+    TRDP_ERR_T ret;
+
+    if (pArenaConfig == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /*  Stop any ongoing communication by getting the mutexes */
+
+    ret = trdp_getAccess(appHandle, FALSE);
+
+    if (ret == TRDP_NO_ERR)
+    {
+        if (appHandle->arena.pArea != NULL)
+        {
+            ret = TRDP_STATE_ERR;
+        }
+        else
+        {
+            ret = trdp_arenaCreate(appHandle, pArenaConfig);
+        }
+        if (ret == TRDP_NO_ERR)
+        {
+            ret = trdp_subIndexReserve(appHandle, pArenaConfig->maxNoOfSubscribers);
+        }
+        trdp_releaseAccess(appHandle);
+    }
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Return the size of the arena needed by tlc_presetArenaSession.
+ *
+ *  @param[in]      pArenaConfig        Number of elements
+ *
+ *  @retval         size in bytes, 0 on parameter error
+ */
+EXT_DECL UINT32 tlc_arenaSize (
+    const TRDP_ARENA_CONFIG_T *pArenaConfig)
+{
+    if (pArenaConfig == NULL)
+    {
+        return 0u;
+    }
+    return trdp_arenaSize(pArenaConfig);
+}
+
 /**********************************************************************************************************************/
 /** Close a session.
  *  Clean up and release all resources of that session
@@ -993,7 +1104,9 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                 trdp_indexDeInit(pSession);
 #endif
                 /*    Release all allocated sockets and memory    */
-                vos_memFree(pSession->pNewFrame);
+                trdp_arenaFree(pSession, TRDP_ARENA_SUB_FRAME, pSession->pNewFrame);
+                trdp_freeRcvRing(pSession);
+                trdp_subIndexFree(pSession);
 
                 while (pSession->pSndQueue != NULL)
                 {
@@ -1004,14 +1117,15 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                      */
                     if (pSession->pSndQueue->pSeqCntList != NULL)
                     {
-                        vos_memFree(pSession->pSndQueue->pSeqCntList);
+                        trdp_seqCntFree(pSession, pSession->pSndQueue->pSeqCntList);
                     }
-                    vos_memFree(pSession->pSndQueue->pFrame);
+                    trdp_pdFreeRefFrames(pSession, pSession->pSndQueue, TRDP_ARENA_PUB_FRAME);
+                    trdp_arenaFree(pSession, TRDP_ARENA_PUB_FRAME, pSession->pSndQueue->pFrame);
 
                     /*    Only close socket if not used anymore    */
                     trdp_releaseSocket(pSession->ifacePD, pSession->pSndQueue->socketIdx, 0, FALSE, VOS_INADDR_ANY);
 
-                    vos_memFree(pSession->pSndQueue);
+                    trdp_arenaFree(pSession, TRDP_ARENA_PUB_ELE, pSession->pSndQueue);
                     pSession->pSndQueue = pNext;
                 }
 
@@ -1024,13 +1138,14 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     trdp_releaseSocket(pSession->ifacePD, pSession->pRcvQueue->socketIdx, 0, FALSE, VOS_INADDR_ANY);
                     if (pSession->pRcvQueue->pSeqCntList != NULL)
                     {
-                        vos_memFree(pSession->pRcvQueue->pSeqCntList);
+                        trdp_seqCntFree(pSession, pSession->pRcvQueue->pSeqCntList);
                     }
+                    trdp_pdFreeRefFrames(pSession, pSession->pRcvQueue, TRDP_ARENA_SUB_FRAME);
                     if (pSession->pRcvQueue->pFrame != NULL)
                     {
-                        vos_memFree(pSession->pRcvQueue->pFrame);
+                        trdp_arenaFree(pSession, TRDP_ARENA_SUB_FRAME, pSession->pRcvQueue->pFrame);
                     }
-                    vos_memFree(pSession->pRcvQueue);
+                    trdp_arenaFree(pSession, TRDP_ARENA_SUB_ELE, pSession->pRcvQueue);
                     pSession->pRcvQueue = pNext;
                 }
 
@@ -1041,7 +1156,7 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     {
                         vos_memFree(pSession->pMDRcvEle->pPacket);
                     }
-                    vos_memFree(pSession->pMDRcvEle);
+                    trdp_arenaFree(pSession, TRDP_ARENA_MD_ELE, pSession->pMDRcvEle);
                     pSession->pMDRcvEle = NULL;
                 }
 
@@ -1056,7 +1171,7 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                                        pSession->mdDefault.connectTimeout,
                                        FALSE,
                                        VOS_INADDR_ANY);
-                    trdp_mdFreeSession(pSession->pMDSndQueue);
+                    trdp_mdFreeSession(pSession, pSession->pMDSndQueue);
                     pSession->pMDSndQueue = pNext;
                 }
                 /*    Release all allocated sockets and memory    */
@@ -1070,9 +1185,11 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                                        pSession->mdDefault.connectTimeout,
                                        FALSE,
                                        VOS_INADDR_ANY);
-                    trdp_mdFreeSession(pSession->pMDRcvQueue);
+                    trdp_mdFreeSession(pSession, pSession->pMDRcvQueue);
                     pSession->pMDRcvQueue = pNext;
                 }
+                trdp_MDqueueFreeIndex(&pSession->mdSndIndex);
+                trdp_MDqueueFreeIndex(&pSession->mdRcvIndex);
                 /*    Release all allocated sockets and memory    */
                 while (pSession->pMDListenQueue != NULL)
                 {
@@ -1090,6 +1207,16 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     vos_memFree(pSession->pMDListenQueue);
                     pSession->pMDListenQueue = pNext;
                 }
+                trdp_lisIndexFree(pSession);
+                {
+                    INT32 lIndex;
+
+                    for (lIndex = 0; lIndex < TRDP_MAX_MD_SOCKET_CNT; lIndex++)
+                    {
+                        trdp_releaseTcpRcv(&pSession->ifaceMD[lIndex]);
+                        trdp_releaseTcpSnd(&pSession->ifaceMD[lIndex]);
+                    }
+                }
                 /* Ticket #137: close TCP listener socket */
                 if (pSession->tcpFd.listen_sd != VOS_INVALID_SOCKET)
                 {
@@ -1097,6 +1224,11 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     pSession->tcpFd.listen_sd = VOS_INVALID_SOCKET;
                 }
 #endif
+                if (pSession->pollSet != NULL)
+                {
+                    (void) vos_pollDestroy(pSession->pollSet);
+                    pSession->pollSet = NULL;
+                }
                 trdp_releaseAccess(pSession);
 
                 vos_mutexDelete(pSession->mutex);
@@ -1105,6 +1237,7 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
 #if MD_SUPPORT
                 vos_mutexDelete(pSession->mutexMD);
 #endif
+                trdp_arenaDestroy(pSession);
                 vos_memFree(pSession);
             }
 
@@ -1443,6 +1576,421 @@ EXT_DECL TRDP_ERR_T tlc_process (
 #endif
 }
 
+#ifndef HIGH_PERF_INDEXED
+/**********************************************************************************************************************/
+/** Bring the poll set in line with a socket pool
+ *  Sockets closed in the meantime have left the set already (their pollSock was reset by trdp_releaseSocket()).
+ *
+ *  @param[in]      appHandle          session pointer
+ *  @param[in,out]  iface              socket pool (ifacePD or ifaceMD)
+ *  @param[in]      type               TRDP_SOCK_PD or TRDP_SOCK_MD_UDP
+ *  @param[in]      refBase            TRDP_POLL_REF_PD or TRDP_POLL_REF_MD
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_SOCK_ERR      a socket could not be added
+ */
+static TRDP_ERR_T tlc_pollSyncSockets (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_SOCKETS_T      iface[],
+    TRDP_SOCK_TYPE_T    type,
+    UINT32              refBase)
+{
+    TRDP_ERR_T  result = TRDP_NO_ERR;
+    INT32       lIndex;
+
+    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(type); lIndex++)
+    {
+        SOCKET wanted = iface[lIndex].sock;
+
+        /*  Same choice as trdp_pdCheckPending()/trdp_mdCheckPending(): TCP connections only when established  */
+        if ((type != TRDP_SOCK_PD) &&
+            ((iface[lIndex].type == TRDP_SOCK_PD) ||
+             ((iface[lIndex].type == TRDP_SOCK_MD_TCP) && (iface[lIndex].tcpParams.addFileDesc == FALSE))))
+        {
+            wanted = VOS_INVALID_SOCKET;
+        }
+
+        if (iface[lIndex].pollSock != wanted)
+        {
+            if (iface[lIndex].pollSock != VOS_INVALID_SOCKET)
+            {
+                (void) vos_pollDel(appHandle->pollSet, iface[lIndex].pollSock);
+                iface[lIndex].pollSock = VOS_INVALID_SOCKET;
+            }
+            if (wanted != VOS_INVALID_SOCKET)
+            {
+                if (vos_pollAdd(appHandle->pollSet, wanted, refBase | (UINT32) lIndex) == VOS_NO_ERR)
+                {
+                    iface[lIndex].pollSock = wanted;
+                }
+                else
+                {
+                    vos_printLog(VOS_LOG_ERROR, "vos_pollAdd() failed (Socket: %d)\n", (int) wanted);
+                    result = TRDP_SOCK_ERR;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Create the poll set of a session on first use and bring it in line with the sockets of the session
+ *
+ *  @param[in]      appHandle          session pointer, locked
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_SOCK_ERR      poll set not available or a socket could not be added
+ */
+static TRDP_ERR_T tlc_pollSync (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_ERR_T result;
+
+    if (appHandle->pollSet == NULL)
+    {
+        if (vos_pollCreate(&appHandle->pollSet, TRDP_MAX_PD_SOCKET_CNT + TRDP_MAX_MD_SOCKET_CNT + 1u) != VOS_NO_ERR)
+        {
+            appHandle->pollSet = NULL;
+            return TRDP_SOCK_ERR;
+        }
+    }
+
+    result = tlc_pollSyncSockets(appHandle, appHandle->ifacePD, TRDP_SOCK_PD, TRDP_POLL_REF_PD);
+
+#if MD_SUPPORT
+    if (appHandle->tcpFd.poll_sd != appHandle->tcpFd.listen_sd)
+    {
+        appHandle->tcpFd.poll_sd = VOS_INVALID_SOCKET;
+        if ((appHandle->tcpFd.listen_sd != VOS_INVALID_SOCKET) &&
+            (vos_pollAdd(appHandle->pollSet, appHandle->tcpFd.listen_sd, TRDP_POLL_REF_LISTEN) == VOS_NO_ERR))
+        {
+            appHandle->tcpFd.poll_sd = appHandle->tcpFd.listen_sd;
+        }
+    }
+    if (tlc_pollSyncSockets(appHandle, appHandle->ifaceMD, TRDP_SOCK_MD_UDP, TRDP_POLL_REF_MD) != TRDP_NO_ERR)
+    {
+        result = TRDP_SOCK_ERR;
+    }
+#endif
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Time until the stack has to send or check for time outs next
+ *  PD: the next send or receive time out (trdp_pdCheckPending), MD: the timer wheel. The MD sockets are checked with
+ *  the MD management cycle as long as TCP connections exist (connection time outs are not kept by the wheel).
+ *
+ *  @param[in]      appHandle          session pointer, locked
+ *  @param[in]      pMaxWait           upper limit or NULL
+ *  @param[out]     pInterval          time to wait
+ */
+static void tlc_eventInterval (
+    TRDP_SESSION_PT     appHandle,
+    const TRDP_TIME_T   *pMaxWait,
+    TRDP_TIME_T         *pInterval)
+{
+    TRDP_TIME_T now;
+    TRDP_TIME_T limit = {1u, 0};                /* 1000ms if no timeout is set */
+
+    if (pMaxWait != NULL)
+    {
+        limit = *pMaxWait;
+    }
+
+    vos_getTime(&now);
+    trdp_pdCheckPending(appHandle, NULL, NULL, TRUE);
+
+    if (timerisset(&appHandle->nextJob))
+    {
+        if (timercmp(&now, &appHandle->nextJob, <))
+        {
+            vos_subTime(&appHandle->nextJob, &now);
+        }
+        else
+        {
+            vos_clearTime(&appHandle->nextJob);  /* 0ms if time is over (were we delayed?) */
+        }
+        if (timercmp(&appHandle->nextJob, &limit, <))
+        {
+            limit = appHandle->nextJob;
+        }
+    }
+
+#if MD_SUPPORT
+    {
+        TRDP_TIME_T mdInterval;
+        INT32       lIndex;
+
+        if ((trdp_mdTimerInterval(appHandle, &now, &mdInterval) == TRUE) &&
+            timercmp(&mdInterval, &limit, <))
+        {
+            limit = mdInterval;
+        }
+
+        for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP); lIndex++)
+        {
+            if ((appHandle->ifaceMD[lIndex].sock != VOS_INVALID_SOCKET) &&
+                (appHandle->ifaceMD[lIndex].type == TRDP_SOCK_MD_TCP))
+            {
+                if ((limit.tv_sec > 0) || (limit.tv_usec > (INT32) TRDP_MD_MAN_CYCLE_TIME))
+                {
+                    limit.tv_sec    = 0;
+                    limit.tv_usec   = TRDP_MD_MAN_CYCLE_TIME;
+                }
+                break;
+            }
+        }
+    }
+#endif
+    *pInterval = limit;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Get a descriptor which becomes readable as soon as a socket of the session has data.
+ *  To be used to nest the session into the application's own select()/epoll loop, instead of tlc_getInterval()
+ *  with the descriptor set of all sockets. When the descriptor is readable, call tlc_processEvents() with a zero
+ *  wait. Sockets opened in the meantime are added to the set by the next tlc_processEvents() call.
+ *  Only available where VOS provides an epoll like poll set (Linux).
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *  @param[out]     pDesc              pointer to the descriptor
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_PARAM_ERR     parameter error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid (or HIGH_PERF_INDEXED)
+ *  @retval         TRDP_SOCK_ERR      not supported by the target
+ */
+EXT_DECL TRDP_ERR_T tlc_getPollHandle (
+    TRDP_APP_SESSION_T  appHandle,
+    SOCKET              *pDesc)
+{
+#ifdef HIGH_PERF_INDEXED
+    (void) appHandle;
+    (void) pDesc;
+    vos_printLogStr(VOS_LOG_ERROR, "####   tlc_getPollHandle() is not supported when using HIGH_PERF_INDEXED!  ####\n");
+    return TRDP_NOINIT_ERR;
+#else
+    TRDP_ERR_T ret;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (pDesc == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    ret = tlc_pollSync(appHandle);
+    if ((appHandle->pollSet == NULL) ||
+        (vos_pollGetDesc(appHandle->pollSet, pDesc) != VOS_NO_ERR))
+    {
+        ret = TRDP_SOCK_ERR;
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return ret;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Event driven work loop of the TRDP handler.
+ *    Waits until a socket of the session is readable or the stack has to send or check for time outs, but not longer
+ *    than pMaxWait. Only the sockets reported readable are served, then the due PDs and MDs are sent and the time
+ *    outs are checked - like tlc_process() without tlc_getInterval()/vos_select() and the scan of all sockets.
+ *
+ *  Note:
+ *      Calls of the API from other threads do not wake up the wait, limit pMaxWait to the latency needed.
+ *      Do not use tlc_process(), tlp_process*() and tlm_process() at the same time!
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *  @param[in]      pMaxWait           max. time to wait, NULL: up to 1s, zero: do not wait
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid (or HIGH_PERF_INDEXED)
+ *  @retval         TRDP_SOCK_ERR      poll set not supported by the target, use tlc_process()
+ */
+EXT_DECL TRDP_ERR_T tlc_processEvents (
+    TRDP_APP_SESSION_T  appHandle,
+    const TRDP_TIME_T   *pMaxWait)
+{
+#ifdef HIGH_PERF_INDEXED
+    (void) appHandle;
+    (void) pMaxWait;
+    vos_printLogStr(VOS_LOG_ERROR, "####   tlc_processEvents() is not supported when using HIGH_PERF_INDEXED!  ####\n");
+    vos_printLogStr(VOS_LOG_ERROR, "####  Use tlp_processSend/tlp_processReceive()/tlm_process() instead!   ####\n");
+    return TRDP_NOINIT_ERR;
+#else
+    TRDP_ERR_T          result = TRDP_NO_ERR;
+    TRDP_ERR_T          err;
+    TRDP_TIME_T         interval;
+    VOS_POLL_EVENT_T    events[TRDP_POLL_EVENTS];
+    UINT32              noOfEvents = TRDP_POLL_EVENTS;
+    UINT32              i;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /*  Poll set and time out from the state left by the previous call   */
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    tlc_eventInterval(appHandle, pMaxWait, &interval);
+    err = tlc_pollSync(appHandle);
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    if (appHandle->pollSet == NULL)
+    {
+        return TRDP_SOCK_ERR;
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        result = err;
+    }
+
+    /*  Wait without holding the session   */
+    if (vos_pollWait(appHandle->pollSet, events, &noOfEvents, &interval) != VOS_NO_ERR)
+    {
+        noOfEvents = 0u;
+        result = TRDP_IO_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /******************************************************
+     Serve the readable sockets only
+     ******************************************************/
+    for (i = 0u; i < noOfEvents; i++)
+    {
+        UINT32 idx = events[i].ref & TRDP_POLL_REF_IDX_MASK;
+
+        switch (events[i].ref & ~TRDP_POLL_REF_IDX_MASK)
+        {
+            case TRDP_POLL_REF_PD:
+                if (vos_mutexLock(appHandle->mutexRxPD) == VOS_NO_ERR)
+                {
+                    /*  A socket closed and reopened by an earlier callback is served with its next event  */
+                    if ((idx < TRDP_MAX_PD_SOCKET_CNT) && (appHandle->ifacePD[idx].sock == events[i].sock))
+                    {
+                        err = trdp_pdReceiveSocket(appHandle, idx);
+                        if (err != TRDP_NO_ERR)
+                        {
+                            result = err;
+                        }
+                    }
+                    if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
+                    {
+                        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+                    }
+                }
+                break;
+#if MD_SUPPORT
+            case TRDP_POLL_REF_MD:
+            case TRDP_POLL_REF_LISTEN:
+                if (vos_mutexLock(appHandle->mutexMD) == VOS_NO_ERR)
+                {
+                    if (events[i].ref == TRDP_POLL_REF_LISTEN)
+                    {
+                        if (appHandle->tcpFd.listen_sd == events[i].sock)
+                        {
+                            trdp_mdAcceptConnections(appHandle, NULL, NULL);
+                        }
+                    }
+                    else if ((idx < TRDP_MAX_MD_SOCKET_CNT) && (appHandle->ifaceMD[idx].sock == events[i].sock))
+                    {
+                        trdp_mdReceiveSocket(appHandle, (INT32) idx);
+                    }
+                    if (vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR)
+                    {
+                        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+                    }
+                }
+                break;
+#endif
+            default:
+                break;
+        }
+    }
+
+    /******************************************************
+     Send what is due and check for time outs
+     ******************************************************/
+    if (vos_mutexTryLock(appHandle->mutexTxPD) == VOS_NO_ERR)
+    {
+        err = trdp_pdSendQueued(appHandle);
+        if (err != TRDP_NO_ERR)
+        {
+            /*  We do not break here, only report error */
+            result = err;
+        }
+        if (vos_mutexUnlock(appHandle->mutexTxPD) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+
+    if (vos_mutexLock(appHandle->mutexRxPD) == VOS_NO_ERR)
+    {
+        trdp_pdHandleTimeOuts(appHandle);
+
+        if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+
+#if MD_SUPPORT
+    if (vos_mutexLock(appHandle->mutexMD) == VOS_NO_ERR)
+    {
+        err = trdp_mdSend(appHandle);
+        if (err != TRDP_NO_ERR)
+        {
+            if (err == TRDP_IO_ERR)
+            {
+                vos_printLogStr(VOS_LOG_INFO, "trdp_mdSend() incomplete \n");
+            }
+            else
+            {
+                result = err;
+                vos_printLog(VOS_LOG_ERROR, "trdp_mdSend() failed (Err: %d)\n", err);
+            }
+        }
+
+        trdp_mdCheckTimeouts(appHandle);
+
+        if (vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+#endif
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return result;
+#endif
+}
+
 /**********************************************************************************************************************/
 /** Return a human readable version representation.
  *    Return string in the form 'v.r.u.b'
@@ -17,6 +17,8 @@
 /*
 * $Id: tlm_if.c 2221 2020-09-08 12:51:21Z bloehr $
 *
+*      AG 2026-10-17: tlm_notify/request/reply/replyQuery may return TRDP_QUEUE_FULL_ERR for a busy TCP connection
+*      AG 2026-10-17: Listeners are kept in the comId/URI index (trdp_lisIndexAdd/Remove)
 *      BL 2020-09-08: Ticket #343 userStatus parameter size in tlm_reply and tlm_replyQuery
 *      BL 2020-08-10: Ticket #309 revisited: tlm_abortSession shall return noError if morituri is not set
 *      BL 2020-07-29: Ticket #286 tlm_reply() is missing a sourceURI parameter as defined in the standard
@@ -215,6 +217,7 @@ EXT_DECL TRDP_ERR_T tlm_process (
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
  *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_QUEUE_FULL_ERR send queue of the TCP connection full, try again later
  *  @retval         TRDP_NOINIT_ERR     handle invalid
  */
 EXT_DECL TRDP_ERR_T tlm_notify (
@@ -298,6 +301,7 @@ EXT_DECL TRDP_ERR_T tlm_notify (
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
  *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_QUEUE_FULL_ERR send queue of the TCP connection full, try again later
  *  @retval         TRDP_NOINIT_ERR     handle invalid
  */
 EXT_DECL TRDP_ERR_T tlm_request (
@@ -525,6 +529,7 @@ EXT_DECL TRDP_ERR_T  tlm_addListener (
                     /* Insert into list */
                     pNewElement->pNext          = appHandle->pMDListenQueue;
                     appHandle->pMDListenQueue   = pNewElement;
+                    trdp_lisIndexAdd(appHandle, pNewElement);
 
                     /* Statistics */
                     if ((pNewElement->pktFlags & TRDP_FLAGS_TCP) != 0)
@@ -620,6 +625,8 @@ EXT_DECL TRDP_ERR_T tlm_delListener (
 
         if (TRUE == dequeued)
         {
+            trdp_lisIndexRemove(appHandle, pDelete);
+
             /* cleanup instance */
             if (pDelete->socketIdx != -1)
             {
@@ -640,7 +647,7 @@ EXT_DECL TRDP_ERR_T tlm_delListener (
                 if (pIterMD->pListener == pDelete)
                 {
                     pIterMD->pfCbFunction = NULL;
-                    pIterMD->morituri = TRUE;
+                    trdp_mdSetMorituri(appHandle, pIterMD);
                 }
             }
             /* free memory space for element */
@@ -727,7 +734,7 @@ EXT_DECL TRDP_ERR_T tlm_readdListener (
                 if (pIterMD->pListener == pListener)
                 {
                     pIterMD->pfCbFunction = NULL;
-                    pIterMD->morituri = TRUE;
+                    trdp_mdSetMorituri(appHandle, pIterMD);
                 }
             }
             /*  Find the correct socket    */
@@ -788,6 +795,7 @@ EXT_DECL TRDP_ERR_T tlm_readdListener (
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
  *  @retval         TRDP_MEM_ERR        Out of memory
+ *  @retval         TRDP_QUEUE_FULL_ERR send queue of the TCP connection full, try again later
  *  @retval         TRDP_NO_SESSION_ERR no such session
  *  @retval         TRDP_NOINIT_ERR     handle invalid
  */
@@ -844,6 +852,7 @@ EXT_DECL TRDP_ERR_T tlm_reply (
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
  *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_QUEUE_FULL_ERR send queue of the TCP connection full, try again later
  *  @retval         TRDP_NO_SESSION_ERR no such session
  *  @retval         TRDP_NOINIT_ERR     handle invalid
  */
@@ -981,7 +990,7 @@ EXT_DECL TRDP_ERR_T tlm_abortSession (
                 (iterMD->morituri == FALSE))
             {
                 iterMD->pfCbFunction = NULL;
-                iterMD->morituri = TRUE;
+                trdp_mdSetMorituri(appHandle, iterMD);
                 err = TRDP_NO_ERR;
             }
             iterMD = iterMD->pNext;
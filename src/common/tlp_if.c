@@ -17,6 +17,14 @@
 /*
 * $Id: tlp_if.c 2178 2020-07-27 12:24:16Z bloehr $
 *
+*      AG 2026-10-17: tlp_resubscribe: index room reserved before the key is removed, subscription unchanged on TRDP_MEM_ERR
+*      AG 2026-10-17: tlp_releaseRef() marks the frame without mutex, tlp_getRef() checks the session
+*      AG 2026-10-17: tlp_putBegin() unlocked with a spare frame, tlp_putCommit() relies on its session check
+*      AG 2026-10-17: Publishers/requests and subscribers take separate arena slabs
+*      AG 2026-10-17: PD elements and frames are taken from the session arena (tlc_presetArenaSession)
+*      AG 2026-10-17: tlp_putBegin()/tlp_putCommit() for zero-copy writing of PD
+*      AG 2026-10-17: tlp_getRef()/tlp_releaseRef() for zero-copy reading of received PD
+*      AG 2026-10-17: Subscriptions are kept in the subscriber hash index of the session
 *      BL 2020-07-27: Ticket #304 The reception of any incorrect message causes it to exit the loop
 *      BL 2020-07-10: Ticket #328 tlp_put() writes out of memory for TSN telegrams
 *      BL 2020-07-10: Ticket #315 tlp_publish and heap allocation failed leads to wrong error behaviour
@@ -72,6 +80,73 @@ extern "C" {
  * LOCAL FUNCTIONS
  */
 
+/**********************************************************************************************************************/
+/** Read all pending PDs of the socket of a subscription, if we are in non blocking mode.
+ *  Must be called with mutexRxPD held.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pElement            subscription
+ */
+static void tlp_receivePending (
+    TRDP_APP_SESSION_T  appHandle,
+    PD_ELE_T            *pElement)
+{
+    if (!(appHandle->option & TRDP_OPTION_BLOCK))
+    {
+        TRDP_ERR_T  err;
+        /* read all you can get, return value checked for recoverable errors (Ticket #304) */
+        do
+        {
+            err = trdp_pdReceive(appHandle, appHandle->ifacePD[pElement->socketIdx].sock);
+
+            switch (err)
+            {
+                case TRDP_NO_ERR:
+                case TRDP_NOSUB_ERR:         /* missing subscription should not lead to extensive error output */
+                case TRDP_NODATA_ERR:
+                case TRDP_BLOCK_ERR:
+                    break;
+                case TRDP_PARAM_ERR:
+                    vos_printLog(VOS_LOG_ERROR, "trdp_pdReceive() failed (Err: %d)\n", err);
+                    break;
+                case TRDP_WIRE_ERR:
+                case TRDP_CRC_ERR:
+                case TRDP_MEM_ERR:
+                default:
+                    vos_printLog(VOS_LOG_WARNING, "trdp_pdReceive() failed (Err: %d)\n", err);
+                    break;
+             }
+         }
+        while ((err != TRDP_NODATA_ERR) && (err != TRDP_BLOCK_ERR)); /* as long as there are messages or a timeout is received */
+    }
+}
+
+/**********************************************************************************************************************/
+/** Fill the application's info buffer from the current frame of a subscription
+ *
+ *  @param[in]      pElement            subscription
+ *  @param[out]     pPdInfo             pointer to application's info buffer
+ *  @param[in]      resultCode          result to report
+ */
+static void tlp_setPdInfo (
+    const PD_ELE_T  *pElement,
+    TRDP_PD_INFO_T  *pPdInfo,
+    TRDP_ERR_T      resultCode)
+{
+    pPdInfo->comId          = pElement->addr.comId;
+    pPdInfo->srcIpAddr      = pElement->lastSrcIP;
+    pPdInfo->destIpAddr     = pElement->addr.destIpAddr;
+    pPdInfo->etbTopoCnt     = vos_ntohl(pElement->pFrame->frameHead.etbTopoCnt);
+    pPdInfo->opTrnTopoCnt   = vos_ntohl(pElement->pFrame->frameHead.opTrnTopoCnt);
+    pPdInfo->msgType        = (TRDP_MSG_T) vos_ntohs(pElement->pFrame->frameHead.msgType);
+    pPdInfo->seqCount       = pElement->curSeqCnt;
+    pPdInfo->protVersion    = vos_ntohs(pElement->pFrame->frameHead.protocolVersion);
+    pPdInfo->replyComId     = vos_ntohl(pElement->pFrame->frameHead.replyComId);
+    pPdInfo->replyIpAddr    = vos_ntohl(pElement->pFrame->frameHead.replyIpAddress);
+    pPdInfo->pUserRef       = pElement->pUserRef;
+    pPdInfo->resultCode     = resultCode;
+}
+
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -510,7 +585,7 @@ EXT_DECL TRDP_ERR_T tlp_publish (
         }
         else
         {
-            pNewElement = (PD_ELE_T *) vos_memAlloc(sizeof(PD_ELE_T));
+            pNewElement = (PD_ELE_T *) trdp_arenaAlloc(appHandle, TRDP_ARENA_PUB_ELE, sizeof(PD_ELE_T));
             if (pNewElement == NULL)
             {
                 ret = TRDP_MEM_ERR;
@@ -589,16 +664,25 @@ EXT_DECL TRDP_ERR_T tlp_publish (
                 /* If we couldn't get a socket, we release the used memory and exit */
                 if (ret != TRDP_NO_ERR)
                 {
-                    vos_memFree(pNewElement);
+                    trdp_arenaFree(appHandle, TRDP_ARENA_PUB_ELE, pNewElement);
                     pNewElement = NULL;
                 }
                 else
                 {
-                    /*  Alloc the corresponding data buffer  */
-                    pNewElement->pFrame = (PD_PACKET_T *) vos_memAlloc(pNewElement->grossSize);
+                    /*  Alloc the corresponding data buffer, with an arena take a full frame for later size changes */
+                    if (appHandle->arena.pArea != NULL)
+                    {
+                        pNewElement->pFrame = (PD_PACKET_T *) trdp_arenaAlloc(appHandle, TRDP_ARENA_PUB_FRAME,
+                                                                              TRDP_MAX_PD_PACKET_SIZE);
+                        pNewElement->privFlags |= TRDP_MAX_FRAME;
+                    }
+                    else
+                    {
+                        pNewElement->pFrame = (PD_PACKET_T *) vos_memAlloc(pNewElement->grossSize);
+                    }
                     if (pNewElement->pFrame == NULL)
                     {
-                        vos_memFree(pNewElement);
+                        trdp_arenaFree(appHandle, TRDP_ARENA_PUB_ELE, pNewElement);
                         pNewElement = NULL;
                         ret = TRDP_MEM_ERR;
                     }
@@ -826,10 +910,11 @@ EXT_DECL TRDP_ERR_T  tlp_unpublish (
         pElement->magic = 0u;
         if (pElement->pSeqCntList != NULL)
         {
-            vos_memFree(pElement->pSeqCntList);
+            trdp_seqCntFree(appHandle, pElement->pSeqCntList);
         }
-        vos_memFree(pElement->pFrame);
-        vos_memFree(pElement);
+        trdp_pdFreeRefFrames(appHandle, pElement, TRDP_ARENA_PUB_FRAME);
+        trdp_arenaFree(appHandle, TRDP_ARENA_PUB_FRAME, pElement->pFrame);
+        trdp_arenaFree(appHandle, TRDP_ARENA_PUB_ELE, pElement);
 
 #ifndef HIGH_PERF_INDEXED
         /* Re-compute distribution times */
@@ -906,7 +991,7 @@ EXT_DECL TRDP_ERR_T tlp_put (
     if ( ret == TRDP_NO_ERR )
     {
         /*    Find the published queue entry    */
-        ret = trdp_pdPut(pElement,
+        ret = trdp_pdPut(appHandle, pElement,
                          appHandle->marshall.pfCbMarshall,
                          appHandle->marshall.pRefCon,
                          pData,
@@ -921,6 +1006,137 @@ EXT_DECL TRDP_ERR_T tlp_put (
     return ret;
 }
 
+/**********************************************************************************************************************/
+/** Get a buffer to write the next process data to send in place (zero-copy).
+ *  The application writes the complete data (network representation, no marshalling) into the returned buffer and
+ *  calls tlp_putCommit() to make it the data to send. Until then the previous data is sent.
+ *  The buffer does not contain the current data.
+ *  Only the first call allocates the buffer under the PD mutex; afterwards the buffer is the application's until
+ *  the commit, which alone takes the mutex. Call both for one publication from the same thread.
+ *
+ *  @param[in]      appHandle          the handle returned by tlc_openSession
+ *  @param[in]      pubHandle          the handle returned by publish
+ *  @param[out]     ppData             pointer to the buffer to write to
+ *  @param[out]     pMaxSize           size of the buffer (TRDP_MAX_PD_DATA_SIZE)
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_PARAM_ERR     parameter error, marshalled or TSN publication
+ *  @retval         TRDP_NOPUB_ERR     not published
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_MEM_ERR       out of memory
+ *  @retval         TRDP_INUSE_ERR     the previous buffer was not committed
+ */
+EXT_DECL TRDP_ERR_T tlp_putBegin (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    UINT8               * *ppData,
+    UINT32              *pMaxSize)
+{
+    PD_ELE_T    *pElement   = (PD_ELE_T *)pubHandle;
+    TRDP_ERR_T  ret         = TRDP_NO_ERR;
+
+    if ((pElement == NULL) || (ppData == NULL) || (pMaxSize == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (pElement->magic != TRDP_MAGIC_PUB_HNDL_VALUE)
+    {
+        return TRDP_NOPUB_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /* The data is sent as written */
+    if ((pElement->privFlags & TRDP_IS_TSN) ||
+        ((pElement->pktFlags & TRDP_FLAGS_MARSHALL) && (appHandle->marshall.pfCbMarshall != NULL)))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /*    The spare frame belongs to the application, the sender never references it    */
+    if (pElement->pSpareFrame != NULL)
+    {
+        return trdp_pdPutBegin(appHandle, pElement, ppData, pMaxSize);
+    }
+
+    /*    Reserve mutual access for allocating the first frame    */
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutexTxPD);
+    if ( ret == TRDP_NO_ERR )
+    {
+        ret = trdp_pdPutBegin(appHandle, pElement, ppData, pMaxSize);
+
+        if ( vos_mutexUnlock(appHandle->mutexTxPD) != VOS_NO_ERR )
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Commit the process data written into the buffer of tlp_putBegin().
+ *  The buffer becomes the frame to send and must not be used afterwards. The new telegram will be sent earliest
+ *  when tlc_process is called.
+ *
+ *  @param[in]      appHandle          the handle returned by tlc_openSession
+ *  @param[in]      pubHandle          the handle returned by publish
+ *  @param[in]      dataSize           size of the data written
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_PARAM_ERR     parameter error, dataSize too large (the buffer stays valid)
+ *  @retval         TRDP_NOPUB_ERR     not published
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_STATE_ERR     tlp_putBegin() was not called
+ */
+EXT_DECL TRDP_ERR_T tlp_putCommit (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    UINT32              dataSize)
+{
+    PD_ELE_T    *pElement   = (PD_ELE_T *)pubHandle;
+    TRDP_ERR_T  ret         = TRDP_NO_ERR;
+
+    if (pElement == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (pElement->magic != TRDP_MAGIC_PUB_HNDL_VALUE)
+    {
+        return TRDP_NOPUB_ERR;
+    }
+
+    /*    The session was checked by tlp_putBegin()    */
+    if (pElement->pRefFrame == NULL)
+    {
+        return TRDP_STATE_ERR;
+    }
+
+    if (appHandle == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /*    Reserve mutual access for swapping the frame in    */
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutexTxPD);
+    if ( ret == TRDP_NO_ERR )
+    {
+        ret = trdp_pdPutCommit(appHandle, pElement, dataSize);
+
+        if ( vos_mutexUnlock(appHandle->mutexTxPD) != VOS_NO_ERR )
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+
+    return ret;
+}
+
 /**********************************************************************************************************************/
 /** Update and send process data.
  *  Update previously published data. The new telegram will be sent immediatly or at txTime, if txTime != 0 and TSN == 1
@@ -1085,7 +1301,7 @@ EXT_DECL TRDP_ERR_T tlp_request (
          */
 
         /*  Get a new element   */
-        pReqElement = (PD_ELE_T *) vos_memAlloc(sizeof(PD_ELE_T));
+        pReqElement = (PD_ELE_T *) trdp_arenaAlloc(appHandle, TRDP_ARENA_PUB_ELE, sizeof(PD_ELE_T));
 
         if (pReqElement == NULL)
         {
@@ -1102,11 +1318,12 @@ EXT_DECL TRDP_ERR_T tlp_request (
              */
             pReqElement->dataSize   = dataSize;
             pReqElement->grossSize  = trdp_packetSizePD(dataSize);
-            pReqElement->pFrame     = (PD_PACKET_T *) vos_memAlloc(pReqElement->grossSize);
+            pReqElement->pFrame     = (PD_PACKET_T *) trdp_arenaAlloc(appHandle, TRDP_ARENA_PUB_FRAME,
+                                                                      pReqElement->grossSize);
 
             if (pReqElement->pFrame == NULL)
             {
-                vos_memFree(pReqElement);
+                trdp_arenaFree(appHandle, TRDP_ARENA_PUB_ELE, pReqElement);
                 pReqElement = NULL;
                 ret = TRDP_MEM_ERR;
             }
@@ -1127,8 +1344,8 @@ EXT_DECL TRDP_ERR_T tlp_request (
 
                 if (ret != TRDP_NO_ERR)
                 {
-                    vos_memFree(pReqElement->pFrame);
-                    vos_memFree(pReqElement);
+                    trdp_arenaFree(appHandle, TRDP_ARENA_PUB_FRAME, pReqElement->pFrame);
+                    trdp_arenaFree(appHandle, TRDP_ARENA_PUB_ELE, pReqElement);
                     pReqElement = NULL;
                     ret = TRDP_MEM_ERR;
                 }
@@ -1354,7 +1571,7 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
             /*    buffer size is PD_ELEMENT plus max. payload size    */
 
             /*    Allocate a buffer for this kind of packets    */
-            newPD = (PD_ELE_T *) vos_memAlloc(sizeof(PD_ELE_T));
+            newPD = (PD_ELE_T *) trdp_arenaAlloc(appHandle, TRDP_ARENA_SUB_ELE, sizeof(PD_ELE_T));
 
             if (newPD == NULL)
             {
@@ -1364,10 +1581,11 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
             else
             {
                 /*  Alloc the corresponding data buffer  */
-                newPD->pFrame = (PD_PACKET_T *) vos_memAlloc(TRDP_MAX_PD_PACKET_SIZE);
+                newPD->pFrame = (PD_PACKET_T *) trdp_arenaAlloc(appHandle, TRDP_ARENA_SUB_FRAME,
+                                                                TRDP_MAX_PD_PACKET_SIZE);
                 if (newPD->pFrame == NULL)
                 {
-                    vos_memFree(newPD);
+                    trdp_arenaFree(appHandle, TRDP_ARENA_SUB_ELE, newPD);
                     newPD   = NULL;
                     ret     = TRDP_MEM_ERR;
                 }
@@ -1418,10 +1636,22 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
                         vos_addTime(&newPD->timeToGo, &newPD->interval);
                     }
 
-                    /*  append this subscription to our receive queue */
-                    trdp_queueAppLast(&appHandle->pRcvQueue, newPD);
+                    /*  index this subscription and append it to our receive queue */
+                    ret = trdp_subIndexAdd(appHandle, newPD);
+                    if (ret != TRDP_NO_ERR)
+                    {
+                        trdp_releaseSocket(appHandle->ifacePD, lIndex, 0u, FALSE,
+                                           trdp_findMCjoins(appHandle, newPD->addr.mcGroup));
+                        trdp_arenaFree(appHandle, TRDP_ARENA_SUB_FRAME, newPD->pFrame);
+                        trdp_arenaFree(appHandle, TRDP_ARENA_SUB_ELE, newPD);
+                        newPD = NULL;
+                    }
+                    else
+                    {
+                        trdp_queueAppLast(&appHandle->pRcvQueue, newPD);
 
-                    *pSubHandle = (TRDP_SUB_T) newPD;
+                        *pSubHandle = (TRDP_SUB_T) newPD;
+                    }
                 }
             }
         } /*lint !e438 unused newPD */
@@ -1474,7 +1704,8 @@ EXT_DECL TRDP_ERR_T tlp_unsubscribe (
     if (ret == TRDP_NO_ERR)
     {
         TRDP_IP_ADDR_T mcGroup = pElement->addr.mcGroup;
-        /*    Remove from queue?    */
+        /*    Remove from index and queue    */
+        trdp_subIndexRemove(appHandle, pElement);
         trdp_queueDelElement(&appHandle->pRcvQueue, pElement);
         /*    if we subscribed to an MC-group, check if anyone else did too: */
         if (mcGroup != VOS_INADDR_ANY)
@@ -1483,15 +1714,16 @@ EXT_DECL TRDP_ERR_T tlp_unsubscribe (
         }
         trdp_releaseSocket(appHandle->ifacePD, pElement->socketIdx, 0u, FALSE, mcGroup);
         pElement->magic = 0u;
+        trdp_pdFreeRefFrames(appHandle, pElement, TRDP_ARENA_SUB_FRAME);
         if (pElement->pFrame != NULL)
         {
-            vos_memFree(pElement->pFrame);
+            trdp_arenaFree(appHandle, TRDP_ARENA_SUB_FRAME, pElement->pFrame);
         }
         if (pElement->pSeqCntList != NULL)
         {
-            vos_memFree(pElement->pSeqCntList);
+            trdp_seqCntFree(appHandle, pElement->pSeqCntList);
         }
-        vos_memFree(pElement);
+        trdp_arenaFree(appHandle, TRDP_ARENA_SUB_ELE, pElement);
 
 #ifdef HIGH_PERF_INDEXED
         /* We must check if this publisher is listed in our indexed arrays */
@@ -1523,7 +1755,7 @@ EXT_DECL TRDP_ERR_T tlp_unsubscribe (
  *
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
- *  @retval         TRDP_MEM_ERR        could not reserve memory (out of memory)
+ *  @retval         TRDP_MEM_ERR        could not reserve memory (out of memory), subscription unchanged
  *  @retval         TRDP_NOINIT_ERR     handle invalid
  *  @retval         TRDP_SOCK_ERR       Resource (socket) not available, subscription canceled
  */
@@ -1556,6 +1788,19 @@ EXT_DECL TRDP_ERR_T tlp_resubscribe (
         return TRDP_NOINIT_ERR;
     }
 
+    /*  The index key changes with the addresses. Make room for the new key first, re-indexing can not fail then
+        and the subscription is left unchanged if memory is short */
+    ret = trdp_subIndexReserve(appHandle, appHandle->subIndex.exact.count + appHandle->subIndex.wild.count + 1u);
+    if (ret != TRDP_NO_ERR)
+    {
+        if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+        return ret;
+    }
+    trdp_subIndexRemove(appHandle, subHandle);
+
     /*  Change the addressing item   */
     subHandle->addr.srcIpAddr   = srcIpAddr1;
     subHandle->addr.srcIpAddr2  = srcIpAddr2;
@@ -1604,6 +1849,12 @@ EXT_DECL TRDP_ERR_T tlp_resubscribe (
         subHandle->addr.mcGroup = 0u;
     }
 
+    /*  Re-index the subscription, if it is still valid (room was reserved above) */
+    if (ret == TRDP_NO_ERR)
+    {
+        ret = trdp_subIndexAdd(appHandle, subHandle);
+    }
+
     if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
     {
         vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
@@ -1661,34 +1912,7 @@ EXT_DECL TRDP_ERR_T tlp_get (
     if (ret == TRDP_NO_ERR)
     {
         /*    Call the receive function if we are in non blocking mode    */
-        if (!(appHandle->option & TRDP_OPTION_BLOCK))
-        {
-            TRDP_ERR_T  err;
-            /* read all you can get, return value checked for recoverable errors (Ticket #304) */
-            do
-            {
-                err = trdp_pdReceive(appHandle, appHandle->ifacePD[pElement->socketIdx].sock);
-
-                switch (err)
-                {
-                    case TRDP_NO_ERR:
-                    case TRDP_NOSUB_ERR:         /* missing subscription should not lead to extensive error output */
-                    case TRDP_NODATA_ERR:
-                    case TRDP_BLOCK_ERR:
-                        break;
-                    case TRDP_PARAM_ERR:
-                        vos_printLog(VOS_LOG_ERROR, "trdp_pdReceive() failed (Err: %d)\n", err);
-                        break;
-                    case TRDP_WIRE_ERR:
-                    case TRDP_CRC_ERR:
-                    case TRDP_MEM_ERR:
-                    default:
-                        vos_printLog(VOS_LOG_WARNING, "trdp_pdReceive() failed (Err: %d)\n", err);
-                        break;
-                 }
-             }
-            while ((err != TRDP_NODATA_ERR) && (err != TRDP_BLOCK_ERR)); /* as long as there are messages or a timeout is received */
-        }
+        tlp_receivePending(appHandle, pElement);
 
         /*    Get the current time    */
         vos_getTime(&now);
@@ -1720,18 +1944,91 @@ EXT_DECL TRDP_ERR_T tlp_get (
 
         if (pPdInfo != NULL)
         {
-            pPdInfo->comId          = pElement->addr.comId;
-            pPdInfo->srcIpAddr      = pElement->lastSrcIP;
-            pPdInfo->destIpAddr     = pElement->addr.destIpAddr;
-            pPdInfo->etbTopoCnt     = vos_ntohl(pElement->pFrame->frameHead.etbTopoCnt);
-            pPdInfo->opTrnTopoCnt   = vos_ntohl(pElement->pFrame->frameHead.opTrnTopoCnt);
-            pPdInfo->msgType        = (TRDP_MSG_T) vos_ntohs(pElement->pFrame->frameHead.msgType);
-            pPdInfo->seqCount       = pElement->curSeqCnt;
-            pPdInfo->protVersion    = vos_ntohs(pElement->pFrame->frameHead.protocolVersion);
-            pPdInfo->replyComId     = vos_ntohl(pElement->pFrame->frameHead.replyComId);
-            pPdInfo->replyIpAddr    = vos_ntohl(pElement->pFrame->frameHead.replyIpAddress);
-            pPdInfo->pUserRef       = pElement->pUserRef;
-            pPdInfo->resultCode     = ret;
+            tlp_setPdInfo(pElement, pPdInfo, ret);
+        }
+
+        if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Get a reference to the last valid PD message (zero-copy).
+ *  The returned data pointer stays valid until tlp_releaseRef() is called, newly received frames do not overwrite
+ *  it. Only one reference per subscription can be held at a time. The data is returned as received (network
+ *  representation), it is not unmarshalled. The reference must be released before unsubscribing.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by subscription
+ *  @param[in,out]  pPdInfo             pointer to application's info buffer
+ *  @param[out]     ppData              pointer to the read-only data of the received frame
+ *  @param[out]     pDataSize           size of data
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_SUB_ERR        not subscribed
+ *  @retval         TRDP_NODATA_ERR     nothing received yet
+ *  @retval         TRDP_TIMEOUT_ERR    packet timed out
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_INUSE_ERR      the previous reference was not released
+ */
+EXT_DECL TRDP_ERR_T tlp_getRef (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    TRDP_PD_INFO_T      *pPdInfo,
+    const UINT8         * *ppData,
+    UINT32              *pDataSize)
+{
+    PD_ELE_T    *pElement   = (PD_ELE_T *) subHandle;
+    TRDP_ERR_T  ret         = TRDP_NOSUB_ERR;
+    TRDP_TIME_T now;
+
+    if ((pElement == NULL) || (ppData == NULL) || (pDataSize == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (pElement->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+    {
+        return TRDP_NOSUB_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    *ppData     = NULL;
+    *pDataSize  = 0u;
+
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutexRxPD);
+    if (ret == TRDP_NO_ERR)
+    {
+        /*    Call the receive function if we are in non blocking mode    */
+        tlp_receivePending(appHandle, pElement);
+
+        /*    Get the current time    */
+        vos_getTime(&now);
+
+        /*    Check time out    */
+        if (timerisset(&pElement->interval) &&
+            timercmp(&pElement->timeToGo, &now, <))
+        {
+            ret = TRDP_TIMEOUT_ERR;
+        }
+        else
+        {
+            ret = trdp_pdGetRef(appHandle, pElement, ppData, pDataSize);
+        }
+
+        if (pPdInfo != NULL)
+        {
+            tlp_setPdInfo(pElement, pPdInfo, ret);
         }
 
         if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
@@ -1743,6 +2040,69 @@ EXT_DECL TRDP_ERR_T tlp_get (
     return ret;
 }
 
+/**********************************************************************************************************************/
+/** Release a reference obtained by tlp_getRef().
+ *  The data pointer must not be used afterwards.
+ *  The frame is only marked as given back, the session was checked by tlp_getRef() and the receiver recycles the
+ *  frame under its mutex. Call it from the thread which called tlp_getRef().
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by subscription
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_SUB_ERR        not subscribed
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_STATE_ERR      no reference held
+ */
+EXT_DECL TRDP_ERR_T tlp_releaseRef (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle)
+{
+    PD_ELE_T    *pElement = (PD_ELE_T *) subHandle;
+    TRDP_ERR_T  ret;
+
+    if (pElement == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (pElement->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+    {
+        return TRDP_NOSUB_ERR;
+    }
+
+    /*    Only tlp_getRef() of this thread sets pRefFrame, only a recycled frame resets refReleased    */
+    if ((pElement->pRefFrame == NULL) || (pElement->refReleased != 0u))
+    {
+        return TRDP_STATE_ERR;
+    }
+
+    if (appHandle == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+#ifdef TRDP_REF_LOCK_FREE
+    TRDP_REF_SET_RELEASED(pElement);
+    ret = TRDP_NO_ERR;
+#else
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutexRxPD);
+    if (ret == TRDP_NO_ERR)
+    {
+        TRDP_REF_SET_RELEASED(pElement);
+
+        if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+#endif
+
+    return ret;
+}
+
 #ifdef __cplusplus
 }
 #endif
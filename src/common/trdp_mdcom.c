@@ -20,6 +20,15 @@
  /*
  * $Id: trdp_mdcom.c 2224 2020-11-03 16:51:17Z bloehr $
  *
+ *      AG 2026-10-17: A new TCP connection is shared by later sender sessions only with shareTcp
+ *      AG 2026-10-17: TCP MD sent through a send queue per connection, frames of one trdp_mdSend() coalesced
+ *      AG 2026-10-17: trdp_mdAcceptConnections()/trdp_mdReceiveSocket() split off for tlc_processEvents()
+ *      AG 2026-10-17: TCP MD read through a receive buffer per connection, all buffered frames are processed
+ *      AG 2026-10-17: Timeouts by the MD timer wheel, trdp_mdSend() only visits armed sessions (ready list)
+ *      AG 2026-10-17: trdp_mdFindListener() global, for the dispatch benchmark
+ *      AG 2026-10-17: Requests and notifications are dispatched through the listener index (trdp_mdFindListener)
+ *      AG 2026-10-17: Sessions are looked up by the sessionID index of the MD queues
+ *      AG 2026-10-17: MD elements are taken from the session arena (tlc_presetArenaSession)
  *      BL 2020-11-03: Ticket #346 UDP MD: In case of wrong data length (too big) in the header the package won't be released
  *      BL 2020-08-10: Ticket #335 MD UDP notifications sometimes dropped
  *      BL 2020-07-30: Ticket #336 MD structures handling in multithread application
@@ -108,6 +117,7 @@ static void         trdp_mdManageSessionId (TRDP_UUID_T pSessionId,
                                             MD_ELE_T    *pMdElement);
 
 static TRDP_ERR_T   trdp_mdLookupElement (MD_ELE_T                  *pinitialMdElement,
+                                          const TRDP_MD_SID_INDEX_T *pIndex,
                                           const TRDP_MD_ELE_ST_T    elementState,
                                           const TRDP_UUID_T         pSessionId,
                                           MD_ELE_T                  * *pretrievedMdElement);
@@ -121,6 +131,10 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T          *pElement,
 static MD_ELE_T     *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T  appHandle,
                                                 MD_HEADER_T         *pMdItemHeader);
 
+static BOOL8        trdp_mdListenerMatches (TRDP_SESSION_PT       appHandle,
+                                            const MD_LIS_ELE_T    *pListener,
+                                            BOOL8                 isTCP,
+                                            const MD_HEADER_T     *pH);
 static TRDP_ERR_T   trdp_mdHandleRequest (TRDP_SESSION_PT   appHandle,
                                           BOOL8             isTCP,
                                           UINT32            sockIndex,
@@ -140,14 +154,23 @@ static TRDP_ERR_T   trdp_mdCheck (TRDP_SESSION_PT   appHandle,
 static TRDP_ERR_T   trdp_mdSendPacket (SOCKET   mdSock,
                                        UINT16   port,
                                        MD_ELE_T *pElement);
+static TRDP_ERR_T   trdp_mdTcpQueueCheck (TRDP_SESSION_PT   appHandle,
+                                          INT32             socketIdx,
+                                          UINT32            grossSize);
+static TRDP_ERR_T   trdp_mdTcpFlush (TRDP_SESSION_PT    appHandle,
+                                     INT32              socketIdx);
+static TRDP_ERR_T   trdp_mdTcpGather (TRDP_SESSION_PT   appHandle,
+                                      MD_ELE_T          *pElement);
+static void         trdp_mdTcpFlushAll (TRDP_SESSION_PT appHandle);
+static UINT32       trdp_mdTcpFrameBuffered (const TRDP_TCP_RCV_T *pRcv);
 static TRDP_ERR_T   trdp_mdRecvTCPPacket (TRDP_SESSION_PT   appHandle,
-                                          SOCKET            mdSock,
+                                          UINT32            socketIndex,
                                           MD_ELE_T          *pElement);
 static TRDP_ERR_T   trdp_mdRecvUDPPacket (TRDP_SESSION_PT   appHandle,
                                           SOCKET            mdSock,
                                           MD_ELE_T          *pElement);
 static TRDP_ERR_T   trdp_mdRecvPacket (TRDP_SESSION_PT  appHandle,
-                                       SOCKET           mdSock,
+                                       UINT32           sockIndex,
                                        MD_ELE_T         *pElement);
 static TRDP_ERR_T   trdp_mdRecv (TRDP_SESSION_PT    appHandle,
                                  UINT32             sockIndex);
@@ -263,6 +286,7 @@ static void trdp_mdManageSessionId (TRDP_UUID_T pSessionId, MD_ELE_T *pMdElement
  *  within a list starting with pinitialMdElement.*
  *
  *  @param[in]      pinitialMdElement   start element within a list of element
+ *  @param[in]      pIndex              sessionID index of that list
  *  @param[in]      elementState        element state to look for
  *  @param[in]      pSessionId          element session to look for
  *  @param[out]     pretrievedMdElement pointer to looked up element
@@ -270,8 +294,9 @@ static void trdp_mdManageSessionId (TRDP_UUID_T pSessionId, MD_ELE_T *pMdElement
  *  @retval         TRDP_NO_ERR           no error
  *  @retval         TRDP_NOLIST_ERR       no match found error
  */
-static TRDP_ERR_T trdp_mdLookupElement (MD_ELE_T                *pinitialMdElement,
-                                        const TRDP_MD_ELE_ST_T  elementState,
+static TRDP_ERR_T trdp_mdLookupElement (MD_ELE_T                    *pinitialMdElement,
+                                        const TRDP_MD_SID_INDEX_T   *pIndex,
+                                        const TRDP_MD_ELE_ST_T      elementState,
                                         const TRDP_UUID_T       pSessionId,
                                         MD_ELE_T                * *pretrievedMdElement)
 {
@@ -281,12 +306,12 @@ static TRDP_ERR_T trdp_mdLookupElement (MD_ELE_T                *pinitialMdEleme
         (pSessionId != NULL))
     {
         MD_ELE_T *iterMD;
-        /* start iteration through receive or send list */
-        for (iterMD = pinitialMdElement; iterMD != NULL; iterMD = iterMD->pNext)
+        /* iterate through the elements of the receive or send list with that session */
+        for (iterMD = trdp_MDqueueFindSession(pinitialMdElement, pIndex, pSessionId, NULL);
+             iterMD != NULL;
+             iterMD = trdp_MDqueueFindSession(pinitialMdElement, pIndex, pSessionId, iterMD))
         {
-            if ((elementState == iterMD->stateEle)
-                &&
-                (0 == memcmp(iterMD->sessionID, pSessionId, TRDP_SESS_ID_SIZE)))
+            if (elementState == iterMD->stateEle)
             {
                 *pretrievedMdElement = iterMD;
                 errv = TRDP_NO_ERR;
@@ -418,7 +443,7 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
        case TRDP_ST_RX_REQ_W4AP_REPLY:     /* Replier waiting for reply from application */
        case TRDP_ST_TX_REQ_W4AP_CONFIRM:   /* Caller waiting for a confirmation/reply from application */
            /* Application confirm/reply timeout, stop session, notify application */
-           pElement->morituri   = TRUE;
+           trdp_mdSetMorituri(appHandle, pElement);
            hasTimedOut          = TRUE;
 
            if ( pElement->stateEle == TRDP_ST_TX_REQ_W4AP_CONFIRM )
@@ -438,7 +463,7 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
            if ((pElement->pktFlags & TRDP_FLAGS_TCP) != 0 )
            {
                vos_printLogStr(VOS_LOG_INFO, "TCP MD reply/confirm timeout\n");
-               pElement->morituri   = TRUE;
+               trdp_mdSetMorituri(appHandle, pElement);
                hasTimedOut          = TRUE;
                *pResult = TRDP_REPLYTO_ERR;
 
@@ -485,7 +510,7 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
                    else
                    {
                        /* Reply timeout, stop Reply/ReplyQuery reception, notify application */
-                       pElement->morituri   = TRUE;
+                       trdp_mdSetMorituri(appHandle, pElement);
                        hasTimedOut          = TRUE;
                        *pResult = TRDP_REPLYTO_ERR;
                    }
@@ -501,7 +526,7 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
                        (pElement->numRepliesQuery <= pElement->numConfirmSent))
                    {
                        /* All Confirm required by received ReplyQuery are sent */
-                       pElement->morituri = TRUE;
+                       trdp_mdSetMorituri(appHandle, pElement);
                    }
                    else
                    {
@@ -509,7 +534,7 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
                        if ( pElement->numRepliesQuery <= (pElement->numConfirmSent + pElement->numConfirmTimeout))
                        {
                            /* Callback execution require to indicate send done with some Confirm Timeout */
-                           pElement->morituri   = TRUE;
+                           trdp_mdSetMorituri(appHandle, pElement);
                            hasTimedOut          = TRUE;
                            *pResult = TRDP_REQCONFIRMTO_ERR;
                        }
@@ -519,7 +544,7 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
            break;
        case TRDP_ST_RX_REPLYQUERY_W4C:  /* Reply query timeout raised, stop waiting for confirmation, notify application
                                           */
-           pElement->morituri   = TRUE;
+           trdp_mdSetMorituri(appHandle, pElement);
            hasTimedOut          = TRUE;
            *pResult = TRDP_CONFIRMTO_ERR;
            /* Statistics */
@@ -536,7 +561,7 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
            /* kill session silently since only one TCP reply possible */
            if ((pElement->pktFlags & TRDP_FLAGS_TCP) != 0 )
            {
-               pElement->morituri = TRUE;
+               trdp_mdSetMorituri(appHandle, pElement);
            }
            else
            {
@@ -545,14 +570,14 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
                    ||
                    (pElement->numReplies < pElement->numExpReplies))
                {
-                   pElement->morituri   = TRUE;
+                   trdp_mdSetMorituri(appHandle, pElement);
                    hasTimedOut          = TRUE;
                    *pResult = TRDP_REPLYTO_ERR;
                }
                else
                {
                    /* kill session silently if number of expected replies have been received  */
-                   pElement->morituri = TRUE;
+                   trdp_mdSetMorituri(appHandle, pElement);
                }
            }
            break;
@@ -577,11 +602,13 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
 {
     MD_ELE_T    *iterMD         = NULL;
     MD_ELE_T    *startElement   = NULL;
+    TRDP_MD_SID_INDEX_T *pIndex = NULL;
     /* determine the queue to look for the recevd pMdItemHeader */
     if ((vos_ntohs(pMdItemHeader->msgType) == TRDP_MSG_MC)
         )
     {
-        startElement = appHandle->pMDRcvQueue;
+        startElement    = appHandle->pMDRcvQueue;
+        pIndex          = &appHandle->mdRcvIndex;
     }
     else
     {
@@ -591,15 +618,18 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
             ||
             (vos_ntohs(pMdItemHeader->msgType) == TRDP_MSG_ME))
         {
-            startElement = appHandle->pMDSndQueue;
+            startElement    = appHandle->pMDSndQueue;
+            pIndex          = &appHandle->mdSndIndex;
         }
         /* having no else here will render the startElement to be NULL  */
         /* this will sufficiently skip the for loop below, getting NULL */
         /* as function return value - which also will get correctly     */
         /* handled by trdp_mdRecv                                       */
     }
-    /* iterate through the receive queue */
-    for (iterMD = startElement; iterMD != NULL; iterMD = iterMD->pNext)
+    /* iterate through the elements of the queue with that session */
+    for (iterMD = trdp_MDqueueFindSession(startElement, pIndex, pMdItemHeader->sessionID, NULL);
+         iterMD != NULL;
+         iterMD = trdp_MDqueueFindSession(startElement, pIndex, pMdItemHeader->sessionID, iterMD))
     {
         /* accept only local communication or matching topo counters */
         if (((pMdItemHeader->etbTopoCnt != 0u) || (pMdItemHeader->opTrnTopoCnt != 0u))
@@ -643,7 +673,7 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
                 /* dedicated MC handling */
                 /* set element state and indicate that the item has to be removed */
                 iterMD->stateEle    = TRDP_ST_RX_CONF_RECEIVED;
-                iterMD->morituri    = TRUE;
+                trdp_mdSetMorituri(appHandle, iterMD);
                 vos_printLogStr(VOS_LOG_INFO, "Received Confirmation, session will be closed!\n");
                 break; /* exit for loop */
             }
@@ -689,7 +719,7 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
                             && (iterMD->numConfirmSent + iterMD->numConfirmTimeout >= iterMD->numRepliesQuery)))
                     {
                         /* Prepare for session fin, Reply/ReplyQuery reception only one expected */
-                        iterMD->morituri = TRUE;
+                        trdp_mdSetMorituri(appHandle, iterMD);
                     }
                     break; /* exit for loop */
                 }
@@ -722,6 +752,7 @@ static void trdp_mdCloseSessions (
 {
 
     MD_ELE_T *iterMD;
+    MD_ELE_T *pNextMD;
 
     /* Check all the sockets */
     if (checkAllSockets == TRUE)
@@ -729,33 +760,33 @@ static void trdp_mdCloseSessions (
         trdp_releaseSocket(appHandle->ifaceMD, TRDP_INVALID_SOCKET_INDEX, 0, checkAllSockets, VOS_INADDR_ANY);
     }
 
-    iterMD = appHandle->pMDSndQueue;
+    /* Only search the queues if a session was marked by trdp_mdSetMorituri() */
+    iterMD = (appHandle->mdMorituri == TRUE) ? appHandle->pMDSndQueue : NULL;
 
     while (NULL != iterMD)
     {
+        pNextMD = iterMD->pNext;
         if (TRUE == iterMD->morituri)
         {
             trdp_releaseSocket(appHandle->ifaceMD, iterMD->socketIdx, appHandle->mdDefault.connectTimeout,
                                FALSE, VOS_INADDR_ANY);
-            trdp_MDqueueDelElement(&appHandle->pMDSndQueue, iterMD);
+            trdp_MDqueueDelElement(&appHandle->pMDSndQueue, &appHandle->mdSndIndex, iterMD);
             vos_printLog(VOS_LOG_INFO, "Freeing %s MD caller session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
                          iterMD->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
                          iterMD->sessionID[0], iterMD->sessionID[1], iterMD->sessionID[2], iterMD->sessionID[3],
                          iterMD->sessionID[4], iterMD->sessionID[5], iterMD->sessionID[6], iterMD->sessionID[7])
 
-            trdp_mdFreeSession(iterMD);
-            iterMD = appHandle->pMDSndQueue;
-        }
-        else
-        {
-            iterMD = iterMD->pNext;
+            trdp_mdFreeSession(appHandle, iterMD);
         }
+        iterMD = pNextMD;
     }
 
-    iterMD = appHandle->pMDRcvQueue;
+    iterMD = (appHandle->mdMorituri == TRUE) ? appHandle->pMDRcvQueue : NULL;
+    appHandle->mdMorituri = FALSE;
 
     while (NULL != iterMD)
     {
+        pNextMD = iterMD->pNext;
         if (TRUE == iterMD->morituri)
         {
             if (0 != (iterMD->pktFlags & TRDP_FLAGS_TCP))
@@ -763,18 +794,14 @@ static void trdp_mdCloseSessions (
                 trdp_releaseSocket(appHandle->ifaceMD, iterMD->socketIdx, appHandle->mdDefault.connectTimeout,
                                    FALSE, VOS_INADDR_ANY);
             }
-            trdp_MDqueueDelElement(&appHandle->pMDRcvQueue, iterMD);
+            trdp_MDqueueDelElement(&appHandle->pMDRcvQueue, &appHandle->mdRcvIndex, iterMD);
             vos_printLog(VOS_LOG_INFO, "Freeing MD %s replier session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
                          iterMD->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
                          iterMD->sessionID[0], iterMD->sessionID[1], iterMD->sessionID[2], iterMD->sessionID[3],
                          iterMD->sessionID[4], iterMD->sessionID[5], iterMD->sessionID[6], iterMD->sessionID[7])
-            trdp_mdFreeSession(iterMD);
-            iterMD = appHandle->pMDRcvQueue;
-        }
-        else
-        {
-            iterMD = iterMD->pNext;
+            trdp_mdFreeSession(appHandle, iterMD);
         }
+        iterMD = pNextMD;
     }
 
     /* Save the new socket in the old socket position */
@@ -787,7 +814,6 @@ static void trdp_mdCloseSessions (
 
         appHandle->ifaceMD[socketIndex].sock = newSocket;
         appHandle->ifaceMD[socketIndex].rcvMostly = TRUE;
-        appHandle->ifaceMD[socketIndex].tcpParams.notSend     = FALSE;
         appHandle->ifaceMD[socketIndex].type                  = TRDP_SOCK_MD_TCP;
         appHandle->ifaceMD[socketIndex].usage                 = 0;
         appHandle->ifaceMD[socketIndex].tcpParams.sendNotOk   = FALSE;
@@ -978,7 +1004,7 @@ static void    trdp_mdUpdatePacket (MD_ELE_T *pElement)
 }
 
 /**********************************************************************************************************************/
-/** Send MD packet
+/** Send MD packet via UDP (TCP frames go through the send queue of their connection, trdp_mdTcpGather())
  *
  *  @param[in]      mdSock          socket descriptor
  *  @param[in]      port            port on which to send
@@ -989,33 +1015,20 @@ static TRDP_ERR_T  trdp_mdSendPacket (SOCKET    mdSock,
                                       UINT16    port,
                                       MD_ELE_T  *pElement)
 {
-    VOS_ERR_T   err         = VOS_NO_ERR;
-    UINT32      tmpSndSize  = 0u;
-
-    if ((pElement->pktFlags & TRDP_FLAGS_TCP) != 0)
-    {
-        tmpSndSize = pElement->sendSize;
+    VOS_ERR_T err = VOS_NO_ERR;
 
-        pElement->sendSize = pElement->grossSize - tmpSndSize;
-
-        err = vos_sockSendTCP(mdSock, ((UINT8 *)&pElement->pPacket->frameHead) + tmpSndSize, &pElement->sendSize);
-        pElement->sendSize = tmpSndSize + pElement->sendSize;
-    }
-    else
-    {
-        pElement->sendSize = pElement->grossSize;
+    pElement->sendSize = pElement->grossSize;
 
-        err = vos_sockSendUDP(mdSock,
-                              (UINT8 *)&pElement->pPacket->frameHead,
-                              &pElement->sendSize,
-                              pElement->addr.destIpAddr,
-                              port);
-    }
+    err = vos_sockSendUDP(mdSock,
+                          (UINT8 *)&pElement->pPacket->frameHead,
+                          &pElement->sendSize,
+                          pElement->addr.destIpAddr,
+                          port);
 
     if (err != VOS_NO_ERR)
     {
-        vos_printLog(VOS_LOG_ERROR, "vos_sockSend%s error (Err: %d, Socket: %d, Port: %u)\n",
-                     (pElement->pktFlags & TRDP_FLAGS_TCP) ? "TCP" : "UDP", err, (int) mdSock, (unsigned int) port);
+        vos_printLog(VOS_LOG_ERROR, "vos_sockSendUDP error (Err: %d, Socket: %d, Port: %u)\n",
+                     err, (int) mdSock, (unsigned int) port);
 
         if (err == VOS_NOCONN_ERR)
         {
@@ -1033,323 +1046,444 @@ static TRDP_ERR_T  trdp_mdSendPacket (SOCKET    mdSock,
 
     if ((pElement->sendSize) != pElement->grossSize)
     {
-        vos_printLog(VOS_LOG_INFO, "vos_sockSend%s incomplete (Socket: %d, Port: %d)\n",
-                     (pElement->pktFlags & TRDP_FLAGS_TCP) ? "TCP" : "UDP", (int) mdSock, (unsigned int) port);
+        vos_printLog(VOS_LOG_INFO, "vos_sockSendUDP incomplete (Socket: %d, Port: %d)\n",
+                     (int) mdSock, (unsigned int) port);
         return TRDP_IO_ERR;
     }
 
     return TRDP_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Check whether the send queue of a TCP connection takes another frame
+ *  Between two calls of trdp_mdSend() the queue only holds what the socket did not take. A connection which is
+ *  that far behind refuses new messages until it has drained.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      socketIdx           index of the connection in ifaceMD[]
+ *  @param[in]      grossSize           size of the frame to send
+ *  @retval         TRDP_NO_ERR         frame can be sent
+ *  @retval         TRDP_QUEUE_FULL_ERR send queue full
+ */
+static TRDP_ERR_T trdp_mdTcpQueueCheck (TRDP_SESSION_PT appHandle, INT32 socketIdx, UINT32 grossSize)
+{
+    const TRDP_TCP_SND_T *pSnd;
+
+    if (socketIdx == TRDP_INVALID_SOCKET_INDEX)
+    {
+        return TRDP_NO_ERR;
+    }
+    pSnd = appHandle->ifaceMD[socketIdx].tcpParams.pSnd;
+    if ((pSnd != NULL) && ((pSnd->fill + grossSize) > TRDP_MD_TCP_SND_SIZE))
+    {
+        vos_printLog(VOS_LOG_INFO, "TCP send queue full (Socket: %d, queued: %u)\n",
+                     (int) appHandle->ifaceMD[socketIdx].sock, (unsigned int) pSnd->fill);
+        return TRDP_QUEUE_FULL_ERR;
+    }
+    return TRDP_NO_ERR;
+}
 
 /**********************************************************************************************************************/
-/** Receive MD packet transmitted via TCP
+/** Send the queued bytes and the gathered frames of a TCP connection with one vectored call
+ *  What the socket does not take is copied to the queue. The sending timeout runs while bytes are left and is
+ *  restarted whenever the socket takes some of them.
  *
- *  @param[in]      appHandle       session pointer
- *  @param[in]      mdSock          socket descriptor
- *  @param[out]     pElement        pointer to received packet
- *  @retval         != TRDP_NO_ERR  error
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      socketIdx           index of the connection in ifaceMD[]
+ *  @retval         TRDP_NO_ERR         all sent
+ *  @retval         TRDP_BLOCK_ERR      bytes left in the queue
+ *  @retval         TRDP_MEM_ERR        no queue buffer, the stream is broken
+ *  @retval         TRDP_NOCONN_ERR     no connection
+ *  @retval         TRDP_IO_ERR         send failed
  */
-static TRDP_ERR_T trdp_mdRecvTCPPacket (TRDP_SESSION_PT appHandle, SOCKET mdSock, MD_ELE_T *pElement)
+static TRDP_ERR_T trdp_mdTcpFlush (TRDP_SESSION_PT appHandle, INT32 socketIdx)
 {
-    /* TCP receiver */
-    TRDP_ERR_T  err = TRDP_NO_ERR;
-    UINT32      size = 0u;                       /* Size of the all data read until now */
-    UINT32      dataSize        = 0u;            /* The pending data to read */
-    UINT32      socketIndex     = 0u;
-    UINT32      readSize        = 0u;            /* All the data read in this cycle (Header + Data) */
-    UINT32      readDataSize    = 0u;            /* All the data part read in this cycle (Data) */
-    BOOL8       noDataToRead    = FALSE;
-    UINT32      storedDataSize  = 0u;
+    TRDP_SOCKETS_T  *pSocket    = &appHandle->ifaceMD[socketIdx];
+    TRDP_TCP_SND_T  *pSnd       = pSocket->tcpParams.pSnd;
+    UINT32          sent        = 0u;
+    UINT32          size;
+    UINT32          idx;
+    BOOL8           progress;
+    VOS_ERR_T       err;
+
+    /* seg[0] are the bytes still queued, they go first */
+    pSnd->seg[0].pBuffer    = (pSnd->pBuf != NULL) ? (pSnd->pBuf + pSnd->head) : NULL;
+    pSnd->seg[0].size       = pSnd->fill;
+
+    err = vos_sockSendTCPVec(pSocket->sock, pSnd->seg, pSnd->noOfFrames + 1u, &sent);
+    if ((err != VOS_NO_ERR) && (err != VOS_BLOCK_ERR))
+    {
+        vos_printLog(VOS_LOG_ERROR, "vos_sockSendTCPVec error (Err: %d, Socket: %d)\n", err, (int) pSocket->sock);
+        pSnd->head          = 0u;
+        pSnd->fill          = 0u;
+        pSnd->noOfFrames    = 0u;
+        pSnd->frameBytes    = 0u;
+        return (err == VOS_NOCONN_ERR) ? TRDP_NOCONN_ERR : TRDP_IO_ERR;
+    }
+    progress    = (sent > 0u) ? TRUE : FALSE;
+
+    size        = (sent < pSnd->fill) ? sent : pSnd->fill;
+    pSnd->head  += size;
+    pSnd->fill  -= size;
+    sent        -= size;
+
+    /* Keep the unsent rest of the gathered frames, their sessions may be gone after this pass */
+    for (idx = 1u; idx <= pSnd->noOfFrames; idx++)
+    {
+        size = pSnd->seg[idx].size;
+        if (sent >= size)
+        {
+            sent -= size;
+            continue;
+        }
+        if (pSnd->pBuf == NULL)
+        {
+            pSnd->pBuf = (UINT8 *) vos_memAlloc(TRDP_MD_TCP_SND_SIZE);
+            if (pSnd->pBuf == NULL)
+            {
+                vos_printLogStr(VOS_LOG_ERROR, "vos_memAlloc() failed\n");
+                pSnd->noOfFrames    = 0u;
+                pSnd->frameBytes    = 0u;
+                return TRDP_MEM_ERR;
+            }
+        }
+        if ((pSnd->head + pSnd->fill + size - sent) > TRDP_MD_TCP_SND_SIZE)
+        {
+            memmove(pSnd->pBuf, pSnd->pBuf + pSnd->head, pSnd->fill);
+            pSnd->head = 0u;
+        }
+        memcpy(pSnd->pBuf + pSnd->head + pSnd->fill, pSnd->seg[idx].pBuffer + sent, size - sent);
+        pSnd->fill  += size - sent;
+        sent        = 0u;
+    }
+    pSnd->noOfFrames    = 0u;
+    pSnd->frameBytes    = 0u;
+
+    if (pSnd->fill == 0u)
+    {
+        pSnd->head = 0u;
+        pSocket->tcpParams.sendNotOk = FALSE;
+        return TRDP_NO_ERR;
+    }
+
+    if ((pSocket->tcpParams.sendNotOk == FALSE) || (progress == TRUE))
+    {
+        /*  (Re-)start the Sending Timeout, it only expires if the connection takes nothing */
+        TRDP_TIME_T tmpt_interval;
 
-    /* Initialize to 0 the stored header size*/
-    UINT32      storedHeader = 0;
+        tmpt_interval.tv_sec    = appHandle->mdDefault.sendingTimeout / 1000000u;
+        tmpt_interval.tv_usec   = appHandle->mdDefault.sendingTimeout % 1000000;
 
-    /* Initialize to 0 the pElement->dataSize
-     * Once it is known, the message complete data size will be saved*/
-    pElement->dataSize = 0u;
+        vos_getTime(&pSocket->tcpParams.sendingTimeout);
+        vos_addTime(&pSocket->tcpParams.sendingTimeout, &tmpt_interval);
 
-    /* Fill destination address */
-    pElement->addr.destIpAddr = appHandle->realIP;
+        pSocket->tcpParams.sendNotOk = TRUE;
+    }
+    return TRDP_BLOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Gather the frame of an MD session for the next send on its TCP connection
+ *  The frame is referenced in place until trdp_mdTcpFlush(), which is called at the latest at the end of
+ *  trdp_mdSend(). If the queue limit would be exceeded, the frames gathered so far are sent first.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            MD session to send
+ *  @retval         TRDP_NO_ERR         frame gathered
+ *  @retval         TRDP_QUEUE_FULL_ERR connection busy, the session stays armed
+ *  @retval         != TRDP_NO_ERR      out of memory or send error, the connection is broken
+ */
+static TRDP_ERR_T trdp_mdTcpGather (TRDP_SESSION_PT appHandle, MD_ELE_T *pElement)
+{
+    TRDP_SOCKETS_T  *pSocket    = &appHandle->ifaceMD[pElement->socketIdx];
+    TRDP_TCP_SND_T  *pSnd       = pSocket->tcpParams.pSnd;
+    TRDP_ERR_T      err;
 
-    /* Find the socket index */
-    for ( socketIndex = 0u; socketIndex < (UINT32)trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP); socketIndex++ )
+    if (pSnd == NULL)
     {
-        if ( appHandle->ifaceMD[socketIndex].sock == mdSock )
+        pSnd = (TRDP_TCP_SND_T *) vos_memAlloc(sizeof(TRDP_TCP_SND_T));
+        if (pSnd == NULL)
         {
-            break;
+            vos_printLogStr(VOS_LOG_ERROR, "vos_memAlloc() failed\n");
+            return TRDP_MEM_ERR;
         }
+        pSocket->tcpParams.pSnd = pSnd;
     }
 
-    if ( socketIndex >= (UINT32)trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_TCP) )
+    /* Once a frame was refused, the following ones of this pass are refused too to keep their order */
+    if ((pSnd->full == FALSE)
+        && ((pSnd->noOfFrames == TRDP_MD_TCP_SND_FRAMES)
+            || ((pSnd->fill + pSnd->frameBytes + pElement->grossSize) > TRDP_MD_TCP_SND_SIZE)))
+    {
+        err = trdp_mdTcpFlush(appHandle, pElement->socketIdx);
+        if ((err != TRDP_NO_ERR) && (err != TRDP_BLOCK_ERR))
+        {
+            return err;
+        }
+        pSnd->full = ((pSnd->fill + pElement->grossSize) > TRDP_MD_TCP_SND_SIZE) ? TRUE : FALSE;
+    }
+    if (pSnd->full == TRUE)
     {
-        vos_printLogStr(VOS_LOG_ERROR, "trdp_mdRecvPacket - Socket index out of range\n");
-        return TRDP_UNKNOWN_ERR;
+        return TRDP_QUEUE_FULL_ERR;
     }
 
-    /* Read Header */
-    if ((appHandle->uncompletedTCP[socketIndex] == NULL)
-        || ((appHandle->uncompletedTCP[socketIndex] != NULL)
-            && (appHandle->uncompletedTCP[socketIndex]->grossSize < sizeof(MD_HEADER_T))))
+    pSnd->noOfFrames++;
+    pSnd->seg[pSnd->noOfFrames].pBuffer = (const UINT8 *) &pElement->pPacket->frameHead;
+    pSnd->seg[pSnd->noOfFrames].size    = pElement->grossSize;
+    pSnd->frameBytes                    += pElement->grossSize;
+    pElement->sendSize                  = pElement->grossSize;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Send what was gathered or is still queued on the TCP connections at the end of trdp_mdSend()
+ *  A connection failing to send is closed with all its caller sessions.
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+static void trdp_mdTcpFlushAll (TRDP_SESSION_PT appHandle)
+{
+    INT32           lIndex;
+    TRDP_ERR_T      err;
+    TRDP_TCP_SND_T  *pSnd;
+    MD_ELE_T        *iterMD;
+
+    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_UDP); lIndex++)
     {
-        if ( appHandle->uncompletedTCP[socketIndex] == NULL )
+        pSnd = appHandle->ifaceMD[lIndex].tcpParams.pSnd;
+        if ((pSnd == NULL) || (appHandle->ifaceMD[lIndex].type != TRDP_SOCK_MD_TCP))
         {
-            readSize = sizeof(MD_HEADER_T);
+            continue;
         }
-        else
+        pSnd->full = FALSE;
+        if (appHandle->ifaceMD[lIndex].tcpParams.morituri == TRUE)
+        {
+            /* about to be closed, drop the frames gathered */
+            pSnd->noOfFrames    = 0u;
+            pSnd->frameBytes    = 0u;
+            continue;
+        }
+        if ((pSnd->fill == 0u) && (pSnd->noOfFrames == 0u))
         {
-            /* If we have read some data before, read the rest */
-            readSize        = sizeof(MD_HEADER_T) - appHandle->uncompletedTCP[socketIndex]->grossSize;
-            storedHeader    = appHandle->uncompletedTCP[socketIndex]->grossSize;
+            continue;
         }
-
-        if ( readSize > 0u )
+        err = trdp_mdTcpFlush(appHandle, lIndex);
+        if ((err == TRDP_NO_ERR) || (err == TRDP_BLOCK_ERR))
         {
-            err = (TRDP_ERR_T) vos_sockReceiveTCP(mdSock,
-                                                  ((UINT8 *)&pElement->pPacket->frameHead) + storedHeader,
-                                                  &readSize);
-
-            /* Add the read data size to the size read before */
-            size = storedHeader + readSize;
-
-            if ( err == TRDP_NO_ERR
-                 && (appHandle->uncompletedTCP[socketIndex] != NULL)
-                 && (size >= sizeof(MD_HEADER_T))
-                 && appHandle->uncompletedTCP[socketIndex]->pPacket != NULL )     /* BL: Prevent NULL pointer access */
+            continue;
+        }
+        for (iterMD = appHandle->pMDSndQueue; iterMD != NULL; iterMD = iterMD->pNext)
+        {
+            if (iterMD->socketIdx == lIndex)
             {
-                if ( trdp_mdCheck(appHandle, &pElement->pPacket->frameHead, size, CHECK_HEADER_ONLY) == TRDP_NO_ERR )
-                {
-                    /* Uncompleted Header, completed. Save some parameters in the uncompletedTCP structure */
-                    appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.datasetLength =
-                        pElement->pPacket->frameHead.datasetLength;
-                    appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.frameCheckSum =
-                        pElement->pPacket->frameHead.frameCheckSum;
-                }
-                else
+                trdp_mdSetMorituri(appHandle, iterMD);
+
+                /* Execute callback for each session */
+                if (iterMD->pfCbFunction != NULL)
                 {
-                    vos_printLogStr(VOS_LOG_INFO, "TCP MD header check failed\n");
-                    return TRDP_NODATA_ERR;
+                    trdp_mdInvokeCallback(iterMD, appHandle, TRDP_TIMEOUT_ERR);
                 }
             }
         }
+        /* Close the socket */
+        appHandle->ifaceMD[lIndex].tcpParams.morituri = TRUE;
     }
+}
 
-    /* Read Data */
-    if ((size >= sizeof(MD_HEADER_T))
-        || ((appHandle->uncompletedTCP[socketIndex] != NULL)
-            && (appHandle->uncompletedTCP[socketIndex]->grossSize >= sizeof(MD_HEADER_T))))
-    {
-        if ( appHandle->uncompletedTCP[socketIndex] == NULL || appHandle->uncompletedTCP[socketIndex]->pPacket == NULL )
-        {
-            /* Get the rest of the message length */
-            dataSize = vos_ntohl(pElement->pPacket->frameHead.datasetLength);
 
-            readDataSize        = trdp_packetSizeMD(dataSize - sizeof(MD_HEADER_T));
-            pElement->grossSize = trdp_packetSizeMD(dataSize);
-            pElement->dataSize  = dataSize;
-            dataSize = pElement->grossSize - sizeof(MD_HEADER_T);
-        }
-        else
-        {
-            /* Calculate the data size that is pending to read */
-            dataSize = vos_ntohl(appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.datasetLength);
+/**********************************************************************************************************************/
+/** Size of the frame at the front of a TCP receive buffer, if it is completely buffered
+ *
+ *  @param[in]      pRcv            receive state of the connection (may be NULL)
+ *  @retval         gross size of the buffered frame, 0 if none is complete
+ */
+static UINT32 trdp_mdTcpFrameBuffered (const TRDP_TCP_RCV_T *pRcv)
+{
+    UINT32 grossSize;
 
-            pElement->dataSize  = dataSize;
-            pElement->grossSize = trdp_packetSizeMD(dataSize);
+    if ((pRcv == NULL) || (pRcv->pPacket != NULL) || (pRcv->fill < sizeof(MD_HEADER_T)))
+    {
+        return 0u;
+    }
+    grossSize = trdp_packetSizeMD(vos_ntohl(((const MD_HEADER_T *)(pRcv->pBuf + pRcv->head))->datasetLength));
+    return (grossSize <= pRcv->fill) ? grossSize : 0u;
+}
 
-            size = appHandle->uncompletedTCP[socketIndex]->grossSize + readSize;
-            dataSize        = dataSize - (size - sizeof(MD_HEADER_T));
-            readDataSize    = dataSize; /* trdp_packetSizeMD(dataSize); */
-        }
+/**********************************************************************************************************************/
+/** Receive MD packet transmitted via TCP
+ *  All bytes available are read into the receive buffer of the connection by one call, complete frames are taken
+ *  from its front one by one. The packet of the element is only (re-)allocated when the frame size is known.
+ *  Frames not fitting into the buffer are read into their packet directly.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      socketIndex     index of the connection in ifaceMD[]
+ *  @param[in,out]  pElement        receive element, gets the complete frame
+ *  @retval         TRDP_NO_ERR     complete frame in pElement
+ *  @retval         TRDP_PACKET_ERR frame not yet complete
+ *  @retval         TRDP_BLOCK_ERR  nothing to read
+ *  @retval         TRDP_NODATA_ERR connection closed by the other corner
+ *  @retval         TRDP_MEM_ERR    out of memory
+ *  @retval         != TRDP_NO_ERR  header check failed, the stream is out of sync
+ */
+static TRDP_ERR_T trdp_mdRecvTCPPacket (TRDP_SESSION_PT appHandle, UINT32 socketIndex, MD_ELE_T *pElement)
+{
+    TRDP_SOCKETS_T  *pSocket    = &appHandle->ifaceMD[socketIndex];
+    TRDP_TCP_RCV_T  *pRcv       = pSocket->tcpParams.pRcv;
+    TRDP_ERR_T      err         = TRDP_NO_ERR;
+    MD_HEADER_T     *pHeader;
+    UINT32          grossSize;
+    UINT32          readSize;
 
-        /* If all the Header is read, check if more memory is needed */
-        if ( size >= sizeof(MD_HEADER_T))
-        {
-            if ( trdp_packetSizeMD(pElement->dataSize) > cMinimumMDSize )
-            {
-                /* we have to allocate a bigger buffer */
-                MD_PACKET_T *pBigData = (MD_PACKET_T *) vos_memAlloc(trdp_packetSizeMD(pElement->dataSize));
-                if ( pBigData == NULL )
-                {
-                    return TRDP_MEM_ERR;
-                }
-                /*  Swap the pointers ...  */
-                memcpy(((UINT8 *)&pBigData->frameHead) + storedHeader,
-                       ((UINT8 *)&pElement->pPacket->frameHead) + storedHeader,
-                       readSize);
+    pElement->dataSize          = 0u;
+    pElement->grossSize         = 0u;
+    pElement->addr.destIpAddr   = appHandle->realIP;
 
-                vos_memFree(pElement->pPacket);
-                pElement->pPacket = pBigData;
-            }
+    if (pRcv == NULL)
+    {
+        pRcv = (TRDP_TCP_RCV_T *) vos_memAlloc(sizeof(TRDP_TCP_RCV_T));
+        if (pRcv == NULL)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "vos_memAlloc() failed\n");
+            return TRDP_MEM_ERR;
         }
-
-        if ( readDataSize > 0u )
+        pRcv->pBuf = (UINT8 *) vos_memAlloc(TRDP_MD_TCP_RCV_SIZE);
+        if (pRcv->pBuf == NULL)
         {
-            err = (TRDP_ERR_T) vos_sockReceiveTCP(mdSock,
-                                                  ((UINT8 *)&pElement->pPacket->frameHead) + size,
-                                                  &readDataSize);
-
-            /* Add the read data size */
-            size = size + readDataSize;
-
-            /* Add the read Data size to the size read during this cycle */
-            readSize = readSize + readDataSize;
+            vos_memFree(pRcv);
+            vos_printLogStr(VOS_LOG_ERROR, "vos_memAlloc() failed\n");
+            return TRDP_MEM_ERR;
         }
+        pSocket->tcpParams.pRcv = pRcv;
     }
-    pElement->grossSize = size;
 
-    /* If the Header is incomplete, the data size will be "0". Otherwise it will be calculated. */
-    switch ( err )
-    {
-       case TRDP_NODATA_ERR:
-           vos_printLog(VOS_LOG_INFO, "vos_sockReceiveTCP - No data at socket %d\n", (int) mdSock);
-           return TRDP_NODATA_ERR;
-       case TRDP_BLOCK_ERR:
-           if (((pElement->pktFlags & TRDP_FLAGS_TCP) != 0) && (readSize == 0u))
-           {
-               return TRDP_BLOCK_ERR;
-           }
-           break;
-       case TRDP_NO_ERR:
-           break;
-       default:
-           vos_printLog(VOS_LOG_ERROR, "vos_sockReceiveTCP failed (Err: %d, Socket: %d)\n", err, (int) mdSock);
-           return err;
-    }
-    /* All the data (Header + Data) stored in the uncompletedTCP[] array */
-    /* Check if it's necessary to read some data */
-    if ( pElement->grossSize == sizeof(MD_HEADER_T))
+    /* Read all there is, unless a complete frame is still buffered */
+    if ((pRcv->pPacket == NULL) && (trdp_mdTcpFrameBuffered(pRcv) == 0u))
     {
-        if ( dataSize == 0u )
+        /* move a partial frame to the front to get the whole free space in one piece */
+        if ((pRcv->head != 0u) && (pRcv->fill != 0u))
+        {
+            memmove(pRcv->pBuf, pRcv->pBuf + pRcv->head, pRcv->fill);
+        }
+        pRcv->head  = 0u;
+        readSize    = TRDP_MD_TCP_RCV_SIZE - pRcv->fill;
+        err         = (TRDP_ERR_T) vos_sockReceiveTCP(pSocket->sock, pRcv->pBuf + pRcv->fill, &readSize);
+        pRcv->fill += readSize;
+
+        switch (err)
         {
-            noDataToRead = TRUE;
+           case TRDP_NO_ERR:
+               break;
+           case TRDP_NODATA_ERR:
+               vos_printLog(VOS_LOG_INFO, "vos_sockReceiveTCP - No data at socket %d\n", (int) pSocket->sock);
+               return TRDP_NODATA_ERR;
+           case TRDP_BLOCK_ERR:
+               return TRDP_BLOCK_ERR;
+           default:
+               vos_printLog(VOS_LOG_ERROR, "vos_sockReceiveTCP failed (Err: %d, Socket: %d)\n",
+                            err, (int) pSocket->sock);
+               return err;
         }
     }
 
-    /* Compare if all the data has been read */
-    if (((pElement->grossSize < sizeof(MD_HEADER_T)) && (readDataSize == 0u))
-        ||
-        ((noDataToRead == FALSE) && (readDataSize != dataSize)))
+    if (pRcv->pPacket == NULL)
     {
-        /* Uncompleted message received */
-
-        if ( appHandle->uncompletedTCP[socketIndex] == NULL )
+        if (pRcv->fill < sizeof(MD_HEADER_T))
         {
-            /* It is the first loop, no data stored yet. Allocate memory for the message */
-            appHandle->uncompletedTCP[socketIndex] = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
-
-            if ( appHandle->uncompletedTCP[socketIndex] == NULL )
-            {
-                /* vos_memDelete(NULL); */
-                vos_printLogStr(VOS_LOG_ERROR, "vos_memAlloc() failed\n");
-                return TRDP_MEM_ERR;
-            }
-
-            /* Check the memory that is needed */
-            if ( trdp_packetSizeMD(pElement->dataSize) < cMinimumMDSize )
-            {
-                /* Allocate the cMinimumMDSize memory at least for now*/
-                appHandle->uncompletedTCP[socketIndex]->pPacket = (MD_PACKET_T *) vos_memAlloc(cMinimumMDSize);
-            }
-            else
-            {
-                /* Allocate the dataSize memory */
-                /* we have to allocate a bigger buffer */
-                appHandle->uncompletedTCP[socketIndex]->pPacket =
-                    (MD_PACKET_T *) vos_memAlloc(trdp_packetSizeMD(pElement->dataSize));
-            }
-
-            if ( appHandle->uncompletedTCP[socketIndex]->pPacket == NULL )
-            {
-                return TRDP_MEM_ERR;
-            }
-
-            storedDataSize = 0;
+            return TRDP_PACKET_ERR;
         }
-        else
+
+        pHeader = (MD_HEADER_T *)(pRcv->pBuf + pRcv->head);
+        err     = trdp_mdCheck(appHandle, pHeader, sizeof(MD_HEADER_T), CHECK_HEADER_ONLY);
+        if (err != TRDP_NO_ERR)
         {
-            /* Get the size that have been already stored in the uncompletedTCP[] */
-            storedDataSize = appHandle->uncompletedTCP[socketIndex]->grossSize;
+            vos_printLogStr(VOS_LOG_INFO, "TCP MD header check failed\n");
+            return err;
+        }
+        grossSize = trdp_packetSizeMD(vos_ntohl(pHeader->datasetLength));
 
-            if ((storedDataSize < sizeof(MD_HEADER_T))
-                && (pElement->grossSize > sizeof(MD_HEADER_T)))
+        if (grossSize <= pRcv->fill)
+        {
+            /* Complete frame buffered, the packet needs to be allocated only now */
+            if ((pElement->pPacket == NULL) || (grossSize > cMinimumMDSize))
             {
-                if ( trdp_packetSizeMD(pElement->dataSize) > cMinimumMDSize )
+                MD_PACKET_T *pPacket = (MD_PACKET_T *) vos_memAlloc((grossSize > cMinimumMDSize) ?
+                                                                    grossSize : cMinimumMDSize);
+                if (pPacket == NULL)
                 {
-                    /* we have to allocate a bigger buffer */
-                    MD_PACKET_T *pBigData = (MD_PACKET_T *) vos_memAlloc(trdp_packetSizeMD(pElement->dataSize));
-                    if ( pBigData == NULL )
-                    {
-                        return TRDP_MEM_ERR;
-                    }
-
-                    /* Copy the data to the pBigData->frameHead */
-                    memcpy(((UINT8 *)&pBigData->frameHead),
-                           ((UINT8 *)&pElement->pPacket->frameHead),
-                           storedDataSize);
-
-                    /*  Swap the pointers ...  */
-                    vos_memFree(appHandle->uncompletedTCP[socketIndex]->pPacket);
-                    appHandle->uncompletedTCP[socketIndex]->pPacket = pBigData;
+                    return TRDP_MEM_ERR;
+                }
+                if (pElement->pPacket != NULL)
+                {
+                    vos_memFree(pElement->pPacket);
                 }
+                pElement->pPacket = pPacket;
             }
+            memcpy(pElement->pPacket, pHeader, grossSize);
+            pRcv->head  += grossSize;
+            pRcv->fill  -= grossSize;
+            if (pRcv->fill == 0u)
+            {
+                pRcv->head = 0u;
+            }
+            pElement->grossSize = grossSize;
+            pElement->dataSize  = vos_ntohl(pElement->pPacket->frameHead.datasetLength);
+            return TRDP_NO_ERR;
         }
 
-        if ( (readSize > 0u)  && (appHandle->uncompletedTCP[socketIndex]->pPacket !=NULL))
+        if (grossSize <= TRDP_MD_TCP_RCV_SIZE)
         {
-            /* Copy the read data in the uncompletedTCP[] */
-            memcpy(((UINT8 *)&appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead) + storedDataSize,
-                   ((UINT8 *)&pElement->pPacket->frameHead) + storedDataSize, readSize);
-            appHandle->uncompletedTCP[socketIndex]->grossSize   = pElement->grossSize;
-            appHandle->uncompletedTCP[socketIndex]->dataSize    = readDataSize;
+            /* the rest will fit into the buffer (after moving the frame to the front) */
+            return TRDP_PACKET_ERR;
         }
-        else
+
+        /* Too large for the buffer: continue reading into a packet of the final size */
+        pRcv->pPacket = (MD_PACKET_T *) vos_memAlloc(grossSize);
+        if (pRcv->pPacket == NULL)
         {
-            vos_printLog(VOS_LOG_DBG, "Received TCP - readSize = 0 (Socket: %d)\n", (int) mdSock);
-            return TRDP_PARAM_ERR;
+            return TRDP_MEM_ERR;
         }
+        memcpy(pRcv->pPacket, pHeader, pRcv->fill);
+        pRcv->packetSize    = grossSize;
+        pRcv->packetFill    = pRcv->fill;
+        pRcv->head          = 0u;
+        pRcv->fill          = 0u;
+    }
 
-        return TRDP_PACKET_ERR;
+    readSize    = pRcv->packetSize - pRcv->packetFill;
+    err         = (TRDP_ERR_T) vos_sockReceiveTCP(pSocket->sock, (UINT8 *) pRcv->pPacket + pRcv->packetFill, &readSize);
+    pRcv->packetFill += readSize;
+
+    switch (err)
+    {
+       case TRDP_NO_ERR:
+       case TRDP_BLOCK_ERR:
+           break;
+       case TRDP_NODATA_ERR:
+           vos_printLog(VOS_LOG_INFO, "vos_sockReceiveTCP - No data at socket %d\n", (int) pSocket->sock);
+           return TRDP_NODATA_ERR;
+       default:
+           vos_printLog(VOS_LOG_ERROR, "vos_sockReceiveTCP failed (Err: %d, Socket: %d)\n", err, (int) pSocket->sock);
+           return err;
     }
-    else
+
+    if (pRcv->packetFill < pRcv->packetSize)
     {
-        /* Complete message */
-        /* All data is read. Save all the data and copy to the pElement to continue */
-        if ( appHandle->uncompletedTCP[socketIndex] != NULL )
-        {
-            /* Add the received information and copy all the data to the pElement */
-            storedDataSize = appHandle->uncompletedTCP[socketIndex]->grossSize;
+        return TRDP_PACKET_ERR;
+    }
 
-            if ((readSize > 0u) &&
-                appHandle->uncompletedTCP[socketIndex]->pPacket != NULL )
-            {
-                /* Copy the read data in the uncompletedTCP[] */
-                memcpy(((UINT8 *)&appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead) + storedDataSize,
-                       ((UINT8 *)&pElement->pPacket->frameHead) + storedDataSize, readSize);
-
-                /* Copy all the uncompletedTCP data to the pElement */
-                memcpy(((UINT8 *)&pElement->pPacket->frameHead),
-                       ((UINT8 *)&appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead), pElement->grossSize);
-
-                /* Disallocate the memory */
-                /* 1st free data buffer - independant pointer */
-                vos_memFree(appHandle->uncompletedTCP[socketIndex]->pPacket);
-                /* 2nd free socket element */
-                vos_memFree(appHandle->uncompletedTCP[socketIndex]);
-                appHandle->uncompletedTCP[socketIndex] = NULL;
-            }
-            else
-            {
-                vos_printLog(VOS_LOG_DBG, "vos_sockReceiveTCP - readSize = 0 (Socket: %d)\n", (int) mdSock);
-                return TRDP_PARAM_ERR;
-            }
-        }
+    /* Hand the packet over */
+    if (pElement->pPacket != NULL)
+    {
+        vos_memFree(pElement->pPacket);
     }
+    pElement->pPacket   = pRcv->pPacket;
+    pElement->grossSize = pRcv->packetSize;
+    pElement->dataSize  = vos_ntohl(pElement->pPacket->frameHead.datasetLength);
+    pRcv->pPacket       = NULL;
     return TRDP_NO_ERR;
 }
 
 
-
 /**********************************************************************************************************************/
 /** Receive MD packet transmitted via UDP
  *
@@ -1463,14 +1597,14 @@ static TRDP_ERR_T trdp_mdRecvUDPPacket (TRDP_SESSION_PT appHandle, SOCKET mdSock
 /** Receive MD packet
  *
  *  @param[in]      appHandle       session pointer
- *  @param[in]      mdSock          socket descriptor
+ *  @param[in]      sockIndex       index of the socket in ifaceMD[]
  *  @param[in]      pElement        pointer to received packet
  *
  *  @retval         != TRDP_NO_ERR  error
  */
 static TRDP_ERR_T  trdp_mdRecvPacket (
     TRDP_SESSION_PT appHandle,
-    SOCKET          mdSock,
+    UINT32          sockIndex,
     MD_ELE_T        *pElement)
 {
     TRDP_MD_STATISTICS_T *pElementStatistics;
@@ -1480,7 +1614,7 @@ static TRDP_ERR_T  trdp_mdRecvPacket (
     if ((pElement->pktFlags & TRDP_FLAGS_TCP) != 0)
     {
         /* Call TCP receiver function */
-        err = trdp_mdRecvTCPPacket(appHandle, mdSock, pElement);
+        err = trdp_mdRecvTCPPacket(appHandle, sockIndex, pElement);
         if (err != TRDP_NO_ERR)
         {
             /* fatal communication issue, exit function, but collect error stats (Ticket #267)  */
@@ -1493,7 +1627,7 @@ static TRDP_ERR_T  trdp_mdRecvPacket (
     else
     {
         /* Call UDP receiver function */
-        err = trdp_mdRecvUDPPacket(appHandle, mdSock, pElement);
+        err = trdp_mdRecvUDPPacket(appHandle, appHandle->ifaceMD[sockIndex].sock, pElement);
         if (err != TRDP_NO_ERR)
         {
             /* fatal communication issue, exit function, but collect error stats (Ticket #267) */
@@ -1539,51 +1673,209 @@ static TRDP_ERR_T  trdp_mdRecvPacket (
 }
 
 /**********************************************************************************************************************/
-/** Handle incoming request message - private SW level
+/** Check a received request/notification against the filter of a listener
  *
- *  @param[in]      appHandle       the handle returned by tlc_init
- *  @param[in]      isTCP           TCP ?
- *  @param[in]      sockIndex       socket index
- *  @param[in]      pH              Header of the incoming message
- *  @param[in]      state           listener state to be set
- *  @param[out]     pIterMD         Pointer to MD element handle to be returned
+ *  @param[in]      appHandle           session pointer, pMDRcvEle holds the addresses of the message
+ *  @param[in]      pListener           listener to check
+ *  @param[in]      isTCP               TRUE if received via TCP
+ *  @param[in]      pH                  pointer to the received header
  *
- *  @retval         TRDP_NO_ERR         no error
- *  @retval         TRDP_NOLIST_ERR     no listener
+ *  @retval         TRUE                listener takes the message
+ *  @retval         FALSE               no match
  */
-static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
-                                        BOOL8               isTCP,
-                                        UINT32              sockIndex,
-                                        MD_HEADER_T         *pH,
-                                        TRDP_MD_ELE_ST_T    state,
-                                        MD_ELE_T            * *pIterMD)
+static BOOL8 trdp_mdListenerMatches (TRDP_SESSION_PT    appHandle,
+                                     const MD_LIS_ELE_T *pListener,
+                                     BOOL8              isTCP,
+                                     const MD_HEADER_T  *pH)
 {
-    UINT32 numOfReceivers = 0u;
-    MD_LIS_ELE_T    *iterListener   = NULL;
-    TRDP_ERR_T      result          = TRDP_NO_ERR;
-    MD_ELE_T        *iterMD         = NULL;
+    if ((pListener->socketIdx != TRDP_INVALID_SOCKET_INDEX) &&
+        (isTCP == TRUE))
+    {
+        return FALSE;
+    }
 
-    /* set pointer to be returned to NULL */
-    *pIterMD = NULL;
+    /* Ticket #206: TCP requests should use TCP listeners only */
+    if ((pListener->pktFlags & TRDP_FLAGS_TCP) && (isTCP == FALSE))
+    {
+        return FALSE;
+    }
 
-    /* Only if no Notification */
-    if (state != TRDP_ST_RX_NOTIFY_RECEIVED)
+    /* Ticket #180: Do the filtering as the standard demands */
+
+    /* If comID does not match but should, continue */
+    if (((pListener->privFlags & TRDP_CHECK_COMID) != 0) &&
+        (vos_ntohl(pH->comId) != pListener->addr.comId))
     {
-        /* Search for existing session (in case it is a repeated request)  */
-        /* This is kind of error detection/comm issue remedy functionality */
-        /* running ahead of further logic */
-        for ( iterMD = appHandle->pMDRcvQueue; iterMD != NULL; iterMD = iterMD->pNext )
-        {
-            numOfReceivers++; /* count the list items here */
-            if ( 0 == memcmp(iterMD->pPacket->frameHead.sessionID, pH->sessionID, TRDP_SESS_ID_SIZE))
-            {
-                /* According IEC61375-2-3 A.7.7.1 (BL: non existant chapter?)*/
-                /* encountered a matching session */
-                if ((pH->sequenceCounter == iterMD->pPacket->frameHead.sequenceCounter)
-                    ||
-                    (isTCP == TRUE) /* include TCP as topmost discard criterium */
-                    ||
-                    (iterMD->addr.mcGroup != 0))  /* discard multicasts anyway */
+        return FALSE;
+    }
+
+    /* check the source URI if set  */
+    if ((pListener->srcURI[0] != 0) &&
+        (!trdp_isAddressed(pListener->srcURI, (CHAR8 *) pH->sourceURI)))
+    {
+        return FALSE;
+    }
+
+    /* check the destination URI if set  */
+    if ((pListener->destURI[0] != 0) &&
+        (!trdp_isAddressed(pListener->destURI, (CHAR8 *) pH->destinationURI)))
+    {
+        return FALSE;
+    }
+
+    /* check topocounts before comparing source or destination IP addresses! */
+    /* Step 1: here we need to check the topccounts */
+    /* in case of train communication (topo counters != zero) check topo validity of recvd message and */
+    /* recv queue item by matching the etbTopoCnt and opTrnTopoCnt                                     */
+    if (((pH->etbTopoCnt != 0u) || (pH->opTrnTopoCnt != 0u))
+        && (!trdp_validTopoCounters( vos_ntohl(pH->etbTopoCnt),
+                                     vos_ntohl(pH->opTrnTopoCnt),
+                                     pListener->addr.etbTopoCnt,
+                                     pListener->addr.opTrnTopoCnt)))
+    {
+        return FALSE;
+    }
+
+    /* If multicast address is set, but does not match, we go to the next listener (if any) */
+    if ((pListener->addr.mcGroup != 0u || vos_isMulticast(appHandle->pMDRcvEle->addr.destIpAddr)) &&
+        (pListener->addr.mcGroup != appHandle->pMDRcvEle->addr.destIpAddr))
+    {
+        /* no IP match for unicast addressing */
+        return FALSE;
+    }
+
+    /* if source IP given (and no range) */
+    if ((pListener->addr.srcIpAddr2 == 0) &&
+        (pListener->addr.srcIpAddr != 0) &&
+        (pListener->addr.srcIpAddr != appHandle->pMDRcvEle->addr.srcIpAddr))
+    {
+        return FALSE;
+    }
+
+    /* if source IP given and is within given IP range */
+    if ((pListener->addr.srcIpAddr != 0) &&
+        (pListener->addr.srcIpAddr2 != 0) &&
+        (!trdp_isInIPrange(appHandle->pMDRcvEle->addr.srcIpAddr,
+                           pListener->addr.srcIpAddr,
+                           pListener->addr.srcIpAddr2)))
+    {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Find the listener of a received request/notification
+ *  The first matching listener of pMDListenQueue (the newest) takes the message. The listener index is probed
+ *  for comId and URI listeners, comId listeners without URI, URI listeners ignoring the comId and listeners
+ *  ignoring both, the first match of each probe is a candidate and the newest candidate wins.
+ *
+ *  @param[in]      appHandle           session pointer, pMDRcvEle holds the addresses of the message
+ *  @param[in]      isTCP               TRUE if received via TCP
+ *  @param[in]      pH                  pointer to the received header
+ *
+ *  @retval         != NULL             listener
+ *  @retval         NULL                no listener
+ */
+MD_LIS_ELE_T *trdp_mdFindListener (TRDP_SESSION_PT   appHandle,
+                                   BOOL8             isTCP,
+                                   const MD_HEADER_T *pH)
+{
+    MD_LIS_ELE_T    *pBest  = NULL;
+    MD_LIS_ELE_T    *iterListener;
+    CHAR8           destURI[TRDP_USR_URI_SIZE + 1u];
+    UINT32          probe;
+
+    if (appHandle->mdLisIndex.ppBuckets == NULL)
+    {
+        for (iterListener = appHandle->pMDListenQueue; iterListener != NULL; iterListener = iterListener->pNext)
+        {
+            if (trdp_mdListenerMatches(appHandle, iterListener, isTCP, pH) == TRUE)
+            {
+                return iterListener;
+            }
+        }
+        return NULL;
+    }
+
+    /* the received URI need not be terminated */
+    memcpy(destURI, pH->destinationURI, TRDP_USR_URI_SIZE);
+    destURI[TRDP_USR_URI_SIZE] = 0;
+
+    for (probe = 0u; probe < 4u; probe++)
+    {
+        BOOL8       checkComId  = (probe < 2u) ? TRUE : FALSE;
+        const CHAR8 *pDestURI   = ((probe & 1u) == 0u) ? destURI : NULL;
+
+        /* listeners with a URI never take messages without one */
+        if ((pDestURI != NULL) && (pDestURI[0] == 0))
+        {
+            continue;
+        }
+        for (iterListener = trdp_lisIndexFind(appHandle, checkComId, vos_ntohl(pH->comId), pDestURI, NULL);
+             iterListener != NULL;
+             iterListener = trdp_lisIndexFind(appHandle, checkComId, vos_ntohl(pH->comId), pDestURI, iterListener))
+        {
+            if ((pBest != NULL) && (iterListener->lisOrder < pBest->lisOrder))
+            {
+                break;      /* the chain is ordered, nothing newer to come */
+            }
+            if (trdp_mdListenerMatches(appHandle, iterListener, isTCP, pH) == TRUE)
+            {
+                pBest = iterListener;
+                break;
+            }
+        }
+    }
+    return pBest;
+}
+
+/**********************************************************************************************************************/
+/** Handle incoming request message - private SW level
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_init
+ *  @param[in]      isTCP           TCP ?
+ *  @param[in]      sockIndex       socket index
+ *  @param[in]      pH              Header of the incoming message
+ *  @param[in]      state           listener state to be set
+ *  @param[out]     pIterMD         Pointer to MD element handle to be returned
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOLIST_ERR     no listener
+ */
+static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
+                                        BOOL8               isTCP,
+                                        UINT32              sockIndex,
+                                        MD_HEADER_T         *pH,
+                                        TRDP_MD_ELE_ST_T    state,
+                                        MD_ELE_T            * *pIterMD)
+{
+    MD_LIS_ELE_T    *iterListener   = NULL;
+    TRDP_ERR_T      result          = TRDP_NO_ERR;
+    MD_ELE_T        *iterMD         = NULL;
+
+    /* set pointer to be returned to NULL */
+    *pIterMD = NULL;
+
+    /* Only if no Notification */
+    if (state != TRDP_ST_RX_NOTIFY_RECEIVED)
+    {
+        /* Search for existing session (in case it is a repeated request)  */
+        /* This is kind of error detection/comm issue remedy functionality */
+        /* running ahead of further logic */
+        for ( iterMD = trdp_MDqueueFindSession(appHandle->pMDRcvQueue, &appHandle->mdRcvIndex, pH->sessionID, NULL);
+              iterMD != NULL;
+              iterMD = trdp_MDqueueFindSession(appHandle->pMDRcvQueue, &appHandle->mdRcvIndex, pH->sessionID, iterMD))
+        {
+            if ( 0 == memcmp(iterMD->pPacket->frameHead.sessionID, pH->sessionID, TRDP_SESS_ID_SIZE))
+            {
+                /* According IEC61375-2-3 A.7.7.1 (BL: non existant chapter?)*/
+                /* encountered a matching session */
+                if ((pH->sequenceCounter == iterMD->pPacket->frameHead.sequenceCounter)
+                    ||
+                    (isTCP == TRUE) /* include TCP as topmost discard criterium */
+                    ||
+                    (iterMD->addr.mcGroup != 0))  /* discard multicasts anyway */
                 {
                     /* discard call immediately */
                     vos_printLogStr(VOS_LOG_INFO,
@@ -1627,6 +1919,7 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
                     vos_addTime(&iterMD->timeToGo, &iterMD->interval);
                     /* update the frame header CRC also */
                     trdp_mdUpdatePacket(iterMD);
+                    trdp_mdTimerSchedule(appHandle, iterMD);
                     /* ready to proceed - will be handled by trdp_mdSend run- */
                     /* ning within its own loop triggered cyclically.         */
                     return result;
@@ -1634,10 +1927,11 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
             }
         }
         /* Inhibit MQ/MN Flooding */
-        if ( appHandle->mdDefault.maxNumSessions <= numOfReceivers )
+        if ( appHandle->mdDefault.maxNumSessions <= appHandle->mdRcvIndex.count )
         {
             /* Discard MD request, we shall not be flooded by incoming requests */
-            vos_printLog(VOS_LOG_INFO, "trdp_mdRecv: Max. number of requests reached (%d)!\n", numOfReceivers);
+            vos_printLog(VOS_LOG_INFO, "trdp_mdRecv: Max. number of requests reached (%u)!\n",
+                         appHandle->mdRcvIndex.count);
             /* Indicate that this call can not get replied due to receiver count limitation  */
             (void)trdp_mdSendME(appHandle, pH, TRDP_REPLY_NO_MEM_REPL);
             /* return to calling routine without performing any receiver action */
@@ -1647,122 +1941,46 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
 
     iterMD = NULL; /* reset item for the actual lookup task */
 
-    /* search for existing listener */
-    for ( iterListener = appHandle->pMDListenQueue; iterListener != NULL;
-          iterListener = iterListener->pNext )
+    /* search for the listener: the newest one of the index or the queue */
+    iterListener = trdp_mdFindListener(appHandle, isTCP, pH);
+    if (iterListener != NULL)
     {
-        if ((iterListener->socketIdx != TRDP_INVALID_SOCKET_INDEX) &&
-            (isTCP == TRUE))
-        {
-            continue;
-        }
-
-        /* Ticket #206: TCP requests should use TCP listeners only */
-        if ((iterListener->pktFlags & TRDP_FLAGS_TCP) && (isTCP == FALSE))
-        {
-            continue;
-        }
-
-        /* Ticket #180: Do the filtering as the standard demands */
-
-        /* If comID does not match but should, continue */
-        if (((iterListener->privFlags & TRDP_CHECK_COMID) != 0) &&
-            (vos_ntohl(pH->comId) != iterListener->addr.comId))
-        {
-            continue;
-        }
+        /* We found a listener, set some values for this new session  */
+        iterMD = appHandle->pMDRcvEle;
+        iterMD->pUserRef = iterListener->pUserRef;
+        iterMD->pfCbFunction        = iterListener->pfCbFunction;
+        iterMD->stateEle            = state;
+        iterMD->addr.etbTopoCnt     = iterListener->addr.etbTopoCnt;
+        iterMD->addr.opTrnTopoCnt   = iterListener->addr.opTrnTopoCnt;
+        iterMD->pktFlags            = iterListener->pktFlags;           /* BL: This was missing! */
+        iterMD->pListener           = iterListener;
 
-        /* check the source URI if set  */
-        if ((iterListener->srcURI[0] != 0) &&
-            (!trdp_isAddressed(iterListener->srcURI, (CHAR8 *) pH->sourceURI)))
-        {
-            continue;
-        }
-
-        /* check the destination URI if set  */
-        if ((iterListener->destURI[0] != 0) &&
-            (!trdp_isAddressed(iterListener->destURI, (CHAR8 *) pH->destinationURI)))
-        {
-            continue;
-        }
-
-        /* check topocounts before comparing source or destination IP addresses! */
-        /* Step 1: here we need to check the topccounts */
-        /* in case of train communication (topo counters != zero) check topo validity of recvd message and */
-        /* recv queue item by matching the etbTopoCnt and opTrnTopoCnt                                     */
-        if (((pH->etbTopoCnt != 0u) || (pH->opTrnTopoCnt != 0u))
-            && (!trdp_validTopoCounters( vos_ntohl(pH->etbTopoCnt),
-                                         vos_ntohl(pH->opTrnTopoCnt),
-                                         iterListener->addr.etbTopoCnt,
-                                         iterListener->addr.opTrnTopoCnt)))
-        {
-            continue;
-        }
 
-        /* If multicast address is set, but does not match, we go to the next listener (if any) */
-        if ((iterListener->addr.mcGroup != 0u || vos_isMulticast(appHandle->pMDRcvEle->addr.destIpAddr)) &&
-            (iterListener->addr.mcGroup != appHandle->pMDRcvEle->addr.destIpAddr))
-        {
-            /* no IP match for unicast addressing */
-            continue;
-        }
+        /* Count this Request/Notification as new session */
+        iterListener->numSessions++;
 
-        /* if source IP given (and no range) */
-        if ((iterListener->addr.srcIpAddr2 == 0) &&
-            (iterListener->addr.srcIpAddr != 0) &&
-            (iterListener->addr.srcIpAddr != appHandle->pMDRcvEle->addr.srcIpAddr))
+        if ( iterListener->socketIdx == TRDP_INVALID_SOCKET_INDEX ) /* On TCP, listeners have no socket
+           assigned  */
         {
-            continue;
+            iterMD->socketIdx = (INT32) sockIndex;
         }
-
-        /* if source IP given and is within given IP range */
-        if ((iterListener->addr.srcIpAddr != 0) &&
-            (iterListener->addr.srcIpAddr2 != 0) &&
-            (!trdp_isInIPrange(appHandle->pMDRcvEle->addr.srcIpAddr,
-                               iterListener->addr.srcIpAddr,
-                               iterListener->addr.srcIpAddr2)))
+        else
         {
-            continue;
+            iterMD->socketIdx = iterListener->socketIdx;
         }
 
-        /* If we come here, it is the right listener! */
-        {
-            /* We found a listener, set some values for this new session  */
-            iterMD = appHandle->pMDRcvEle;
-            iterMD->pUserRef = iterListener->pUserRef;
-            iterMD->pfCbFunction        = iterListener->pfCbFunction;
-            iterMD->stateEle            = state;
-            iterMD->addr.etbTopoCnt     = iterListener->addr.etbTopoCnt;
-            iterMD->addr.opTrnTopoCnt   = iterListener->addr.opTrnTopoCnt;
-            iterMD->pktFlags            = iterListener->pktFlags;           /* BL: This was missing! */
-            iterMD->pListener           = iterListener;
-
-
-            /* Count this Request/Notification as new session */
-            iterListener->numSessions++;
-
-            if ( iterListener->socketIdx == TRDP_INVALID_SOCKET_INDEX ) /* On TCP, listeners have no socket
-               assigned  */
-            {
-                iterMD->socketIdx = (INT32) sockIndex;
-            }
-            else
-            {
-                iterMD->socketIdx = iterListener->socketIdx;
-            }
-
-            trdp_MDqueueInsFirst(&appHandle->pMDRcvQueue, iterMD);
+        /* the sessionID is the key of the queue index */
+        memcpy(iterMD->sessionID, pH->sessionID, TRDP_SESS_ID_SIZE);
+        trdp_MDqueueInsFirst(&appHandle->pMDRcvQueue, &appHandle->mdRcvIndex, iterMD);
 
-            appHandle->pMDRcvEle = NULL;
+        appHandle->pMDRcvEle = NULL;
 
-            vos_printLog(VOS_LOG_INFO,
-                         "Creating %s MD replier session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
-                         iterMD->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
-                         pH->sessionID[0], pH->sessionID[1], pH->sessionID[2],
-                         pH->sessionID[3], pH->sessionID[4], pH->sessionID[5],
-                         pH->sessionID[6], pH->sessionID[7]);
-            break;
-        }
+        vos_printLog(VOS_LOG_INFO,
+                     "Creating %s MD replier session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
+                     iterMD->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
+                     pH->sessionID[0], pH->sessionID[1], pH->sessionID[2],
+                     pH->sessionID[3], pH->sessionID[4], pH->sessionID[5],
+                     pH->sessionID[6], pH->sessionID[7]);
     }
     if ( NULL != iterMD )
     {
@@ -1855,7 +2073,7 @@ static TRDP_ERR_T trdp_mdSendME (TRDP_SESSION_PT appHandle, MD_HEADER_T *pH, INT
     {
         /* we have found the MD_ELE_T */
         /* Room for MD element */
-        pSenderElement = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
+        pSenderElement = (MD_ELE_T *) trdp_arenaAlloc(appHandle, TRDP_ARENA_MD_ELE, sizeof(MD_ELE_T));
         /* Reset descriptor value */
         if ( NULL != pSenderElement )
         {
@@ -1902,7 +2120,7 @@ static TRDP_ERR_T trdp_mdSendME (TRDP_SESSION_PT appHandle, MD_HEADER_T *pH, INT
                 pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
                 if ( NULL == pSenderElement->pPacket )
                 {
-                    vos_memFree(pSenderElement);
+                    trdp_arenaFree(appHandle, TRDP_ARENA_MD_ELE, pSenderElement);
                     pSenderElement = NULL;
                     errv = TRDP_MEM_ERR;
 
@@ -1932,7 +2150,7 @@ static TRDP_ERR_T trdp_mdSendME (TRDP_SESSION_PT appHandle, MD_HEADER_T *pH, INT
         if ( TRDP_NO_ERR != errv &&
              NULL != pSenderElement )
         {
-            trdp_mdFreeSession(pSenderElement);
+            trdp_mdFreeSession(appHandle, pSenderElement);
             pSenderElement = NULL;
         }
     }
@@ -1980,7 +2198,7 @@ static TRDP_ERR_T  trdp_mdRecv (
     /* get buffer if none available */
     if (appHandle->pMDRcvEle == NULL)
     {
-        appHandle->pMDRcvEle = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
+        appHandle->pMDRcvEle = (MD_ELE_T *) trdp_arenaAlloc(appHandle, TRDP_ARENA_MD_ELE, sizeof(MD_ELE_T));
         if (NULL != appHandle->pMDRcvEle)
         {
             appHandle->pMDRcvEle->pPacket   = NULL; /* (MD_PACKET_T *) vos_memAlloc(cMinimumMDSize); */
@@ -2004,14 +2222,15 @@ static TRDP_ERR_T  trdp_mdRecv (
         isTCP = FALSE;
     }
 
-    if (appHandle->pMDRcvEle->pPacket == NULL)
+    /* TCP allocates the packet when the frame size is known */
+    if ((isTCP == FALSE) && (appHandle->pMDRcvEle->pPacket == NULL))
     {
         /* Malloc the minimum size for now */
         appHandle->pMDRcvEle->pPacket = (MD_PACKET_T *) vos_memAlloc(cMinimumMDSize);
 
         if (appHandle->pMDRcvEle->pPacket == NULL)
         {
-            vos_memFree(appHandle->pMDRcvEle);
+            trdp_arenaFree(appHandle, TRDP_ARENA_MD_ELE, appHandle->pMDRcvEle);
             appHandle->pMDRcvEle = NULL;
             vos_printLogStr(VOS_LOG_ERROR, "trdp_mdRecv - Out of receive buffers!\n");
             return TRDP_MEM_ERR;
@@ -2019,7 +2238,7 @@ static TRDP_ERR_T  trdp_mdRecv (
     }
 
     /* get packet: */
-    result = trdp_mdRecvPacket(appHandle, appHandle->ifaceMD[sockIndex].sock, appHandle->pMDRcvEle);
+    result = trdp_mdRecvPacket(appHandle, sockIndex, appHandle->pMDRcvEle);
 
     if (result != TRDP_NO_ERR)
     {
@@ -2096,6 +2315,12 @@ static TRDP_ERR_T  trdp_mdRecv (
            break;
     }
 
+    /* new state and timeout of the session */
+    if (NULL != iterMD)
+    {
+        trdp_mdTimerSchedule(appHandle, iterMD);
+    }
+
     /* Inform user  */
     if (NULL != iterMD && iterMD->pfCbFunction != NULL)
     {
@@ -2110,7 +2335,7 @@ static TRDP_ERR_T  trdp_mdRecv (
     /*  notification sessions can be discarded after application was informed */
     if (NULL != iterMD && iterMD->stateEle == TRDP_ST_RX_NOTIFY_RECEIVED)
     {
-        iterMD->morituri = TRUE;
+        trdp_mdSetMorituri(appHandle, iterMD);
     }
 
     return TRDP_NO_ERR;
@@ -2182,24 +2407,41 @@ TRDP_ERR_T trdp_mdGetTCPSocket (
 /**********************************************************************************************************************/
 /** Free memory of session
  *
+ *  @param[in]      appHandle         TRDP session pointer
  *  @param[in]      pMDSession        session pointer
  */
 void trdp_mdFreeSession (
-    MD_ELE_T *pMDSession)
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pMDSession)
 {
     if (NULL != pMDSession)
     {
+        trdp_mdTimerCancel(appHandle, pMDSession);
         if (NULL != pMDSession->pPacket)
         {
             vos_memFree(pMDSession->pPacket);
         }
-        vos_memFree(pMDSession);
+        trdp_arenaFree(appHandle, TRDP_ARENA_MD_ELE, pMDSession);
     }
 }
 
+/**********************************************************************************************************************/
+/** Mark an MD session to be closed by the next trdp_mdCloseSessions()
+ *
+ *  @param[in]      appHandle         TRDP session pointer
+ *  @param[in]      pMDSession        session pointer
+ */
+void trdp_mdSetMorituri (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pMDSession)
+{
+    pMDSession->morituri    = TRUE;
+    appHandle->mdMorituri   = TRUE;
+}
+
 /**********************************************************************************************************************/
 /** Sending MD messages
- *  Send the messages stored in the sendQueue
+ *  Send the messages of the sessions armed in the send or receive queue (ready list of the timer wheel)
  *  Call user's callback if needed
  *
  *  @param[in]      appHandle           session pointer
@@ -2208,28 +2450,15 @@ TRDP_ERR_T  trdp_mdSend (
     TRDP_SESSION_PT appHandle)
 {
     TRDP_ERR_T  result      = TRDP_NO_ERR;
-    MD_ELE_T    *iterMD     = appHandle->pMDSndQueue;
-    BOOL8       firstLoop   = TRUE;
+    MD_ELE_T    *iterMD;
+    UINT32      noOfArmed   = appHandle->mdTimer.stats.numReady;
 
-    /*  Find the packet which has to be sent next:
-     Note: We must also check the receive queue for pending replies! */
-    do
+    /*  Only the sessions armed so far: sessions which stay armed are appended again and wait for the next call */
+    for (; (noOfArmed > 0u) && ((iterMD = trdp_mdTimerNextReady(appHandle)) != NULL); noOfArmed--)
     {
         int dotx = 0;
         TRDP_MD_ELE_ST_T nextstate = TRDP_ST_NONE;
 
-        /*  Switch to receive queue */
-        if (NULL == iterMD && TRUE == firstLoop)
-        {
-            iterMD      = appHandle->pMDRcvQueue;
-            firstLoop   = FALSE;
-        }
-
-        if (NULL == iterMD)
-        {
-            break;
-        }
-
         switch (iterMD->stateEle)
         {
            case TRDP_ST_TX_NOTIFY_ARM:
@@ -2290,7 +2519,7 @@ TRDP_ERR_T  trdp_mdSend (
                                          (int)appHandle->ifaceMD[iterMD->socketIdx].sock,
                                          (unsigned int)appHandle->mdDefault.tcpPort);
                             iterMD->tcpParameters.doConnect = FALSE;
-                            iterMD = iterMD->pNext;
+                            trdp_mdTimerSchedule(appHandle, iterMD);
                             continue;
                         }
                         else
@@ -2319,161 +2548,139 @@ TRDP_ERR_T  trdp_mdSend (
                                 appHandle->ifaceMD[iterMD->socketIdx].tcpParams.sendNotOk = TRUE;
                             }
 
-                            iterMD->morituri = TRUE;
-                            iterMD = iterMD->pNext;
+                            trdp_mdSetMorituri(appHandle, iterMD);
+                            trdp_mdTimerSchedule(appHandle, iterMD);
                             continue;
                         }
                     }
                 }
 
-                if (((iterMD->pktFlags & TRDP_FLAGS_TCP) == 0)
-                    || (((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
-                        && ((appHandle->ifaceMD[iterMD->socketIdx].tcpParams.notSend == FALSE)
-                            || (iterMD->tcpParameters.msgUncomplete == TRUE))))
+                if ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
+                {
+                    /* sent with the other frames of this connection at the end of this pass */
+                    result = trdp_mdTcpGather(appHandle, iterMD);
+                }
+                else if (0u != iterMD->replyPort &&
+                         (iterMD->pPacket->frameHead.msgType == vos_ntohs(TRDP_MSG_MP) ||
+                          iterMD->pPacket->frameHead.msgType == vos_ntohs(TRDP_MSG_MQ)))
+                {
+                    result = trdp_mdSendPacket(appHandle->ifaceMD[iterMD->socketIdx].sock,
+                                               iterMD->replyPort,
+                                               iterMD);
+                }
+                else
                 {
+                    result = trdp_mdSendPacket(appHandle->ifaceMD[iterMD->socketIdx].sock,
+                                               appHandle->mdDefault.udpPort,
+                                               iterMD);
+                }
 
-                    if (0u != iterMD->replyPort &&
-                        (iterMD->pPacket->frameHead.msgType == vos_ntohs(TRDP_MSG_MP) ||
-                         iterMD->pPacket->frameHead.msgType == vos_ntohs(TRDP_MSG_MQ)))
+                if (result == TRDP_NO_ERR)
+                {
+                    if ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
                     {
-                        result = trdp_mdSendPacket(appHandle->ifaceMD[iterMD->socketIdx].sock,
-                                                   iterMD->replyPort,
-                                                   iterMD);
+                        /* Add the socket in the file descriptor*/
+                        appHandle->ifaceMD[iterMD->socketIdx].tcpParams.addFileDesc = TRUE;
+                        /* increment transmission counter for TCP */
+                        appHandle->stats.tcpMd.numSend++;
                     }
                     else
                     {
-                        result = trdp_mdSendPacket(appHandle->ifaceMD[iterMD->socketIdx].sock,
-                                                   appHandle->mdDefault.udpPort,
-                                                   iterMD);
+                        /* increment transmission counter for UDP */
+                        appHandle->stats.udpMd.numSend++;
                     }
 
-                    if (result == TRDP_NO_ERR)
+                    if (nextstate == TRDP_ST_RX_REPLYQUERY_W4C)
                     {
-                        if ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
+                        /* Update timeout */
+                        if (((iterMD->interval.tv_sec != TRDP_MD_INFINITE_TIME) ||
+                             (iterMD->interval.tv_usec != TRDP_MD_INFINITE_USEC_TIME)))
                         {
-                            appHandle->ifaceMD[iterMD->socketIdx].tcpParams.notSend = FALSE;
-                            iterMD->tcpParameters.msgUncomplete = FALSE;
-                            appHandle->ifaceMD[iterMD->socketIdx].tcpParams.sendNotOk = FALSE;
-
-                            /* Add the socket in the file descriptor*/
-                            appHandle->ifaceMD[iterMD->socketIdx].tcpParams.addFileDesc = TRUE;
-                            /* increment transmission counter for TCP */
-                            appHandle->stats.tcpMd.numSend++;
-                        }
-                        else
-                        {
-                            /* increment transmission counter for UDP */
-                            appHandle->stats.udpMd.numSend++;
-                        }
-
-                        if (nextstate == TRDP_ST_RX_REPLYQUERY_W4C)
-                        {
-                            /* Update timeout */
-                            if (((iterMD->interval.tv_sec != TRDP_MD_INFINITE_TIME) ||
-                                 (iterMD->interval.tv_usec != TRDP_MD_INFINITE_USEC_TIME)))
-                            {
-                                vos_getTime(&iterMD->timeToGo);
-                                vos_addTime(&iterMD->timeToGo, &iterMD->interval);
-                                vos_printLogStr(VOS_LOG_INFO, "Setting timeout for confirmation!\n");
-                            }
+                            vos_getTime(&iterMD->timeToGo);
+                            vos_addTime(&iterMD->timeToGo, &iterMD->interval);
+                            vos_printLogStr(VOS_LOG_INFO, "Setting timeout for confirmation!\n");
                         }
+                    }
 
-                        switch (iterMD->stateEle)
-                        {
-                           case TRDP_ST_TX_CONFIRM_ARM:
+                    switch (iterMD->stateEle)
+                    {
+                       case TRDP_ST_TX_CONFIRM_ARM:
+                       {
+                           iterMD->numConfirmSent++;
+                           if (
+                               (iterMD->numExpReplies != 0u)
+                               && ((iterMD->numRepliesQuery + iterMD->numReplies) >= iterMD->numExpReplies)
+                               && (iterMD->numConfirmSent >= iterMD->numRepliesQuery))
+                           {
+                               trdp_mdSetMorituri(appHandle, iterMD);
+                           }
+                           else
                            {
-                               iterMD->numConfirmSent++;
-                               if (
-                                   (iterMD->numExpReplies != 0u)
-                                   && ((iterMD->numRepliesQuery + iterMD->numReplies) >= iterMD->numExpReplies)
-                                   && (iterMD->numConfirmSent >= iterMD->numRepliesQuery))
+                               /* not yet all replies received OR not yet all confirmations sent */
+                               if (iterMD->numConfirmSent < iterMD->numRepliesQuery)
                                {
-                                   iterMD->morituri = TRUE;
+                                   nextstate = TRDP_ST_TX_REQ_W4AP_CONFIRM;
                                }
                                else
                                {
-                                   /* not yet all replies received OR not yet all confirmations sent */
-                                   if (iterMD->numConfirmSent < iterMD->numRepliesQuery)
-                                   {
-                                       nextstate = TRDP_ST_TX_REQ_W4AP_CONFIRM;
-                                   }
-                                   else
-                                   {
-                                       nextstate = TRDP_ST_TX_REQUEST_W4REPLY;
-                                   }
+                                   nextstate = TRDP_ST_TX_REQUEST_W4REPLY;
                                }
                            }
-                           break;
-                           case TRDP_ST_TX_NOTIFY_ARM:
-                           case TRDP_ST_TX_REPLY_ARM:
-                           {
-                               iterMD->morituri = TRUE;
-                           }
-                           break;
-                           default:
-                               ;
-                        }
-                        iterMD->stateEle = nextstate;
+                       }
+                       break;
+                       case TRDP_ST_TX_NOTIFY_ARM:
+                       case TRDP_ST_TX_REPLY_ARM:
+                       {
+                           trdp_mdSetMorituri(appHandle, iterMD);
+                       }
+                       break;
+                       default:
+                           ;
+                    }
+                    iterMD->stateEle = nextstate;
+                }
+                else
+                {
+                    if (result == TRDP_QUEUE_FULL_ERR)
+                    {
+                        /* TCP connection busy: the session stays armed until the send queue has drained */
+                        result = TRDP_NO_ERR;
+                    }
+                    else if ((result == TRDP_IO_ERR) && ((iterMD->pktFlags & TRDP_FLAGS_TCP) == 0))
+                    {
+                        /* Send uncompleted */
                     }
                     else
                     {
-                        if (result == TRDP_IO_ERR)
-                        {
-                            /* Send uncompleted */
-                            if ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
-                            {
-                                appHandle->ifaceMD[iterMD->socketIdx].tcpParams.notSend = TRUE;
-                                iterMD->tcpParameters.msgUncomplete = TRUE;
-
-                                if (appHandle->ifaceMD[iterMD->socketIdx].tcpParams.sendNotOk == FALSE)
-                                {
-                                    /*  Start the Sending Timeout */
-                                    TRDP_TIME_T tmpt_interval, tmpt_now;
-
-                                    tmpt_interval.tv_sec    = appHandle->mdDefault.sendingTimeout / 1000000u;
-                                    tmpt_interval.tv_usec   = appHandle->mdDefault.sendingTimeout % 1000000;
-
-                                    vos_getTime(&tmpt_now);
-                                    vos_addTime(&tmpt_now, &tmpt_interval);
+                        MD_ELE_T *iterMD_find = NULL;
 
-                                    memcpy(&appHandle->ifaceMD[iterMD->socketIdx].tcpParams.sendingTimeout,
-                                           &tmpt_now,
-                                           sizeof(TRDP_TIME_T));
-
-                                    appHandle->ifaceMD[iterMD->socketIdx].tcpParams.sendNotOk = TRUE;
-                                }
-                            }
-                        }
-                        else
+                        /* search for existing session */
+                        for (iterMD_find = appHandle->pMDSndQueue;
+                             iterMD_find != NULL;
+                             iterMD_find = iterMD_find->pNext)
                         {
-                            MD_ELE_T *iterMD_find = NULL;
-
-                            /* search for existing session */
-                            for (iterMD_find = appHandle->pMDSndQueue;
-                                 iterMD_find != NULL;
-                                 iterMD_find = iterMD_find->pNext)
+                            if (iterMD_find->socketIdx == iterMD->socketIdx)
                             {
-                                if (iterMD_find->socketIdx == iterMD->socketIdx)
+                                trdp_mdSetMorituri(appHandle, iterMD_find);
+
+                                /* Execute callback for each session */
+                                if (iterMD_find->pfCbFunction != NULL)
                                 {
-                                    iterMD_find->morituri = TRUE;
-
-                                    /* Execute callback for each session */
-                                    if (iterMD_find->pfCbFunction != NULL)
-                                    {
-                                        trdp_mdInvokeCallback(iterMD_find, appHandle, TRDP_TIMEOUT_ERR);
-                                    }
-                                    /* Close the socket */
-                                    appHandle->ifaceMD[iterMD->socketIdx].tcpParams.morituri = TRUE;
+                                    trdp_mdInvokeCallback(iterMD_find, appHandle, TRDP_TIMEOUT_ERR);
                                 }
+                                /* Close the socket */
+                                appHandle->ifaceMD[iterMD->socketIdx].tcpParams.morituri = TRUE;
                             }
                         }
                     }
                 }
             }
         }
-        iterMD = iterMD->pNext;
+        /* next state and timeout */
+        trdp_mdTimerSchedule(appHandle, iterMD);
     }
-    while (TRUE); /*lint !e506 */
+
+    trdp_mdTcpFlushAll(appHandle);
 
     trdp_mdCloseSessions(appHandle, TRDP_INVALID_SOCKET_INDEX, VOS_INVALID_SOCKET, TRUE);
 
@@ -2495,7 +2702,6 @@ void trdp_mdCheckPending (
     INT32               *pNoDesc)
 {
     int lIndex;
-    MD_ELE_T *iterMD;
     MD_LIS_ELE_T *iterListener;
 
     /*    Add the socket to the pFileDesc    */
@@ -2553,56 +2759,267 @@ void trdp_mdCheckPending (
         }
     }
 
-    /*  Include MD UDP receive sockets */
-    for (iterMD = appHandle->pMDRcvQueue; iterMD != NULL; iterMD = iterMD->pNext)
+    /*  Include the MD UDP sockets of the sessions: they are in use as long as a session holds them,
+        trdp_releaseSocket() closes unused ones - no need to visit the sessions themselves */
+    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_UDP); lIndex++)
     {
-        /*    There can be several sockets depending on TRDP_PD_CONFIG_T    */
-        if ((iterMD->socketIdx != TRDP_INVALID_SOCKET_INDEX)
-            && (appHandle->ifaceMD[iterMD->socketIdx].sock != VOS_INVALID_SOCKET)
-            && ((appHandle->ifaceMD[iterMD->socketIdx].type != TRDP_SOCK_MD_TCP)
-                || ((appHandle->ifaceMD[iterMD->socketIdx].type == TRDP_SOCK_MD_TCP)
-                    && (appHandle->ifaceMD[iterMD->socketIdx].tcpParams.addFileDesc == TRUE))))
-        {
-            if (!FD_ISSET(appHandle->ifaceMD[iterMD->socketIdx].sock, (fd_set *)pFileDesc)) /*lint !e573 !e505
-                                                                                          signed/unsigned division in macro /
-                                                                                          Redundant left argument to comma */
+        if ((appHandle->ifaceMD[lIndex].sock != VOS_INVALID_SOCKET)
+            && (appHandle->ifaceMD[lIndex].type == TRDP_SOCK_MD_UDP)
+            && (appHandle->ifaceMD[lIndex].usage > 0))
+        {
+            FD_SET(appHandle->ifaceMD[lIndex].sock, (fd_set *)pFileDesc); /*lint !e573 !e505
+                                                                        signed/unsigned division in macro /
+                                                                        Redundant left argument to comma */
+            if (appHandle->ifaceMD[lIndex].sock > *pNoDesc)
             {
-                FD_SET(appHandle->ifaceMD[iterMD->socketIdx].sock, (fd_set *)pFileDesc); /*lint !e573 !e505
-                                                                                       signed/unsigned division in macro /
-                                                                                       Redundant left argument to comma */
-                if (appHandle->ifaceMD[iterMD->socketIdx].sock > *pNoDesc)
-                {
-                    *pNoDesc = (INT32) appHandle->ifaceMD[iterMD->socketIdx].sock;
-                }
+                *pNoDesc = (INT32) appHandle->ifaceMD[lIndex].sock;
             }
         }
     }
+}
+
 
-    for (iterMD = appHandle->pMDSndQueue; iterMD != NULL; iterMD = iterMD->pNext)
+/**********************************************************************************************************************/
+/** Accept the TCP connections queued up on the listening socket
+ *  A connection from a device we already have a connection to replaces that one, if it is not in use.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in,out]  pRfds               pointer to set of ready descriptors, the replaced socket is removed from it,
+ *                                      NULL if no set is used
+ *  @param[in,out]  pCount              pointer to number of ready descriptors or NULL
+ */
+void trdp_mdAcceptConnections (
+    const TRDP_SESSION_PT   appHandle,
+    TRDP_FDS_T              *pRfds,
+    INT32                   *pCount)
+{
+    TRDP_ERR_T  err;
+    SOCKET      new_sd = VOS_INVALID_SOCKET;
+
+    /*************************************************/
+    /* Accept all incoming connections that are      */
+    /* queued up on the listening socket.            */
+    /*************************************************/
+    do
     {
-        /*    There can be several sockets depending on TRDP_PD_CONFIG_T    */
-        if ((iterMD->socketIdx != TRDP_INVALID_SOCKET_INDEX)
-            && (appHandle->ifaceMD[iterMD->socketIdx].sock != VOS_INVALID_SOCKET)
-            && ((appHandle->ifaceMD[iterMD->socketIdx].type != TRDP_SOCK_MD_TCP)
-                || ((appHandle->ifaceMD[iterMD->socketIdx].type == TRDP_SOCK_MD_TCP)
-                    && (appHandle->ifaceMD[iterMD->socketIdx].tcpParams.addFileDesc == TRUE))))
-        {
-            if (!FD_ISSET(appHandle->ifaceMD[iterMD->socketIdx].sock, (fd_set *)pFileDesc)) /*lint !e573 !e505
-                                                                                          signed/unsigned division in macro /
-                                                                                          Redundant left argument to comma */
+        /**********************************************/
+        /* Accept each incoming connection.           */
+        /* Check any failure on accept                */
+        /**********************************************/
+        TRDP_IP_ADDR_T  newIp;
+        UINT16          read_tcpPort;
+
+        newIp = appHandle->realIP;
+        read_tcpPort = appHandle->mdDefault.tcpPort;
+
+        err = (TRDP_ERR_T) vos_sockAccept(appHandle->tcpFd.listen_sd,
+                                          &new_sd, &newIp,
+                                          &(read_tcpPort));
+
+        if (new_sd == VOS_INVALID_SOCKET)
+        {
+            if (err == TRDP_NO_ERR)
+            {
+                break;
+            }
+            else
+            {
+                vos_printLog(VOS_LOG_ERROR, "vos_sockAccept() failed (Err: %d, Socket: %d, Port: %u)\n",
+                             err, (int) appHandle->tcpFd.listen_sd, (unsigned int) read_tcpPort);
+
+                /* Callback the error to the application  */
+                if (appHandle->mdDefault.pfCbFunction != NULL)
+                {
+                    TRDP_MD_INFO_T theMessage = cTrdp_md_info_default;
+
+                    theMessage.etbTopoCnt   = appHandle->etbTopoCnt;
+                    theMessage.opTrnTopoCnt = appHandle->opTrnTopoCnt;
+                    theMessage.resultCode   = TRDP_SOCK_ERR;
+                    theMessage.srcIpAddr    = newIp;
+                    appHandle->mdDefault.pfCbFunction(appHandle->mdDefault.pRefCon, appHandle,
+                                                      &theMessage, NULL, 0);
+                }
+                continue;
+            }
+        }
+        else
+        {
+            vos_printLog(VOS_LOG_INFO, "Accepting new TCP connection on Socket: %d (Port: %u)\n",
+                         (int) new_sd, (unsigned int) read_tcpPort);
+        }
+
+        {
+            VOS_SOCK_OPT_T trdp_sock_opt;
+
+            memset(&trdp_sock_opt, 0, sizeof(trdp_sock_opt));
+
+            trdp_sock_opt.qos   = appHandle->mdDefault.sendParam.qos;
+            trdp_sock_opt.ttl   = appHandle->mdDefault.sendParam.ttl;
+            trdp_sock_opt.ttl_multicast = 0;
+            trdp_sock_opt.reuseAddrPort = TRUE;
+            trdp_sock_opt.nonBlocking   = TRUE;
+            trdp_sock_opt.no_mc_loop    = FALSE;
+            trdp_sock_opt.noDelay       = TRUE;
+
+            err = (TRDP_ERR_T) vos_sockSetOptions(new_sd, &trdp_sock_opt);
+            if (err != TRDP_NO_ERR)
             {
-                FD_SET(appHandle->ifaceMD[iterMD->socketIdx].sock, (fd_set *)pFileDesc); /*lint !e573 !e505
-                                                                                       signed/unsigned division in macro /
-                                                                                       Redundant left argument to comma */
-                if (appHandle->ifaceMD[iterMD->socketIdx].sock >= *pNoDesc)
+                continue;
+            }
+        }
+
+        /* There is one more socket to manage */
+
+        /* Compare with the sockets stored in the socket list */
+        {
+            INT32   socketIndex;
+            BOOL8   socketFound = FALSE;
+
+            for (socketIndex = 0; socketIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_UDP); socketIndex++)
+            {
+                if ((appHandle->ifaceMD[socketIndex].sock != VOS_INVALID_SOCKET)
+                    && (appHandle->ifaceMD[socketIndex].type == TRDP_SOCK_MD_TCP)
+                    && (appHandle->ifaceMD[socketIndex].tcpParams.cornerIp == newIp)
+                    && (appHandle->ifaceMD[socketIndex].rcvMostly == TRUE))
                 {
-                    *pNoDesc = (INT32) appHandle->ifaceMD[iterMD->socketIdx].sock;
+                    vos_printLog(VOS_LOG_INFO, "New socket accepted from the same device (Ip = %u)\n", newIp);
+
+                    if (appHandle->ifaceMD[socketIndex].usage > 0)
+                    {
+                        vos_printLog(
+                            VOS_LOG_INFO,
+                            "The new socket accepted from the same device (Ip = %u), won't be removed, because it is still in use\n",
+                            newIp);
+                        socketFound = TRUE;
+                        break;
+                    }
+
+                    if ((pRfds != NULL) &&
+                        FD_ISSET(appHandle->ifaceMD[socketIndex].sock, (fd_set *) pRfds)) /*lint !e573 !e505
+                                                                                        signed/unsigned division in macro /
+                                                                                        Redundant left argument to comma */
+                    {
+                        /* Decrement the Ready descriptors counter */
+                        if (pCount != NULL)
+                        {
+                            (*pCount)--;
+                        }
+                        FD_CLR(appHandle->ifaceMD[socketIndex].sock, (fd_set *) pRfds); /*lint !e502 !e573 !e505
+                                                                                        signed/unsigned division
+                                                                                        in macro */
+                    }
+
+
+                    /* Close the old socket */
+                    appHandle->ifaceMD[socketIndex].tcpParams.morituri = TRUE;
+
+                    /* Manage the socket pool (update the socket) */
+                    trdp_mdCloseSessions(appHandle, socketIndex, new_sd, TRUE);
+
+                    socketFound = TRUE;
+                    break;
+                }
+            }
+
+            if (socketFound == FALSE)
+            {
+                /* Save the new socket in the ifaceMD.
+                   On receiving MD data on this connection, a listener will be searched and a receive
+                   session instantiated. The socket/connection will be closed when the session has finished.
+                 */
+                err = trdp_requestSocket(
+                        appHandle->ifaceMD,
+                        appHandle->mdDefault.tcpPort,
+                        &appHandle->mdDefault.sendParam,
+                        appHandle->realIP,
+                        0,
+                        TRDP_SOCK_MD_TCP,
+                        TRDP_OPTION_NONE,
+                        TRUE,
+                        new_sd,
+                        &socketIndex,
+                        newIp);
+
+                if (err != TRDP_NO_ERR)
+                {
+                    vos_printLog(VOS_LOG_ERROR, "trdp_requestSocket() failed (Err: %d, Port: %d)\n",
+                                 err, (UINT32)appHandle->mdDefault.tcpPort);
                 }
             }
         }
+
+        /**********************************************/
+        /* Loop back up and accept another incoming   */
+        /* connection                                 */
+        /**********************************************/
     }
+    while (new_sd != VOS_INVALID_SOCKET);
 }
 
+/**********************************************************************************************************************/
+/** Receive from a readable MD socket
+ *  All frames already in the receive buffer of a TCP connection are handled, a TCP connection closed by the other
+ *  side or out of sync is closed.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      lIndex              index of the socket in ifaceMD[]
+ */
+void trdp_mdReceiveSocket (
+    const TRDP_SESSION_PT   appHandle,
+    INT32                   lIndex)
+{
+    TRDP_ERR_T err;
+
+    err = trdp_mdRecv(appHandle, (UINT32) lIndex);
+
+    if (appHandle->ifaceMD[lIndex].type == TRDP_SOCK_MD_TCP)
+    {
+        /* Further frames already in the receive buffer will not be signalled by the socket again */
+        while ((err != TRDP_NODATA_ERR) &&
+               (err != TRDP_CRC_ERR) &&
+               (err != TRDP_WIRE_ERR) &&
+               (err != TRDP_TOPO_ERR) &&
+               (trdp_mdTcpFrameBuffered(appHandle->ifaceMD[lIndex].tcpParams.pRcv) != 0u))
+        {
+            err = trdp_mdRecv(appHandle, (UINT32) lIndex);
+        }
+
+        /* The receive message is incomplete */
+        if (err == TRDP_PACKET_ERR)
+        {
+            vos_printLog(VOS_LOG_INFO, "Incomplete TCP MD received (Socket: %d)\n",
+                         (int) appHandle->ifaceMD[lIndex].sock);
+        }
+        /* A packet error on TCP should not lead to closing of the connection!
+             The following if-clauses were converted to else-if to prevent a false error handling (Ticket #160) */
+        /* Check if the socket has been closed in the other corner */
+        else if (err == TRDP_NODATA_ERR)
+        {
+            vos_printLog(VOS_LOG_INFO,
+                         "The socket has been closed in the other corner (Corner Ip: %s, Socket: %d)\n",
+                         vos_ipDotted(appHandle->ifaceMD[lIndex].tcpParams.cornerIp),
+                         (int) appHandle->ifaceMD[lIndex].sock);
+
+            appHandle->ifaceMD[lIndex].tcpParams.morituri = TRUE;
+
+            trdp_mdCloseSessions(appHandle, TRDP_INVALID_SOCKET_INDEX, VOS_INVALID_SOCKET, TRUE);
+        }
+        /* Check if the socket has been closed in the other corner */
+        else if ((err == TRDP_CRC_ERR) ||
+                 (err == TRDP_WIRE_ERR) ||
+                 (err == TRDP_TOPO_ERR))
+        {
+            vos_printLog(VOS_LOG_WARNING,
+                         "Closing TCP connection, out of sync (Corner Ip: %s, Socket: %d)\n",
+                         vos_ipDotted(appHandle->ifaceMD[lIndex].tcpParams.cornerIp),
+                         (int) appHandle->ifaceMD[lIndex].sock);
+
+            appHandle->ifaceMD[lIndex].tcpParams.morituri = TRUE;
+
+            trdp_mdCloseSessions(appHandle, TRDP_INVALID_SOCKET_INDEX, VOS_INVALID_SOCKET, TRUE);
+        }
+    }
+}
 
 /**********************************************************************************************************************/
 /** Checking receive connection requests and data
@@ -2621,8 +3038,6 @@ void  trdp_mdCheckListenSocks (
     INT32       noOfDesc;
     SOCKET      highDesc = VOS_INVALID_SOCKET;
     INT32       lIndex;
-    TRDP_ERR_T  err;
-    SOCKET      new_sd = VOS_INVALID_SOCKET;
 
     if (appHandle == NULL)
     {
@@ -2703,159 +3118,7 @@ void  trdp_mdCheckListenSocks (
             /****************************************************/
             (*pCount)--;
 
-            /*************************************************/
-            /* Accept all incoming connections that are      */
-            /* queued up on the listening socket.            */
-            /*************************************************/
-            do
-            {
-                /**********************************************/
-                /* Accept each incoming connection.           */
-                /* Check any failure on accept                */
-                /**********************************************/
-                TRDP_IP_ADDR_T  newIp;
-                UINT16          read_tcpPort;
-
-                newIp = appHandle->realIP;
-                read_tcpPort = appHandle->mdDefault.tcpPort;
-
-                err = (TRDP_ERR_T) vos_sockAccept(appHandle->tcpFd.listen_sd,
-                                                  &new_sd, &newIp,
-                                                  &(read_tcpPort));
-
-                if (new_sd == VOS_INVALID_SOCKET)
-                {
-                    if (err == TRDP_NO_ERR)
-                    {
-                        break;
-                    }
-                    else
-                    {
-                        vos_printLog(VOS_LOG_ERROR, "vos_sockAccept() failed (Err: %d, Socket: %d, Port: %u)\n",
-                                     err, (int) appHandle->tcpFd.listen_sd, (unsigned int) read_tcpPort);
-
-                        /* Callback the error to the application  */
-                        if (appHandle->mdDefault.pfCbFunction != NULL)
-                        {
-                            TRDP_MD_INFO_T theMessage = cTrdp_md_info_default;
-
-                            theMessage.etbTopoCnt   = appHandle->etbTopoCnt;
-                            theMessage.opTrnTopoCnt = appHandle->opTrnTopoCnt;
-                            theMessage.resultCode   = TRDP_SOCK_ERR;
-                            theMessage.srcIpAddr    = newIp;
-                            appHandle->mdDefault.pfCbFunction(appHandle->mdDefault.pRefCon, appHandle,
-                                                              &theMessage, NULL, 0);
-                        }
-                        continue;
-                    }
-                }
-                else
-                {
-                    vos_printLog(VOS_LOG_INFO, "Accepting new TCP connection on Socket: %d (Port: %u)\n",
-                                 (int) new_sd, (unsigned int) read_tcpPort);
-                }
-
-                {
-                    VOS_SOCK_OPT_T trdp_sock_opt;
-
-                    memset(&trdp_sock_opt, 0, sizeof(trdp_sock_opt));
-
-                    trdp_sock_opt.qos   = appHandle->mdDefault.sendParam.qos;
-                    trdp_sock_opt.ttl   = appHandle->mdDefault.sendParam.ttl;
-                    trdp_sock_opt.ttl_multicast = 0;
-                    trdp_sock_opt.reuseAddrPort = TRUE;
-                    trdp_sock_opt.nonBlocking   = TRUE;
-                    trdp_sock_opt.no_mc_loop    = FALSE;
-
-                    err = (TRDP_ERR_T) vos_sockSetOptions(new_sd, &trdp_sock_opt);
-                    if (err != TRDP_NO_ERR)
-                    {
-                        continue;
-                    }
-                }
-
-                /* There is one more socket to manage */
-
-                /* Compare with the sockets stored in the socket list */
-                {
-                    INT32   socketIndex;
-                    BOOL8   socketFound = FALSE;
-
-                    for (socketIndex = 0; socketIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_UDP); socketIndex++)
-                    {
-                        if ((appHandle->ifaceMD[socketIndex].sock != VOS_INVALID_SOCKET)
-                            && (appHandle->ifaceMD[socketIndex].type == TRDP_SOCK_MD_TCP)
-                            && (appHandle->ifaceMD[socketIndex].tcpParams.cornerIp == newIp)
-                            && (appHandle->ifaceMD[socketIndex].rcvMostly == TRUE))
-                        {
-                            vos_printLog(VOS_LOG_INFO, "New socket accepted from the same device (Ip = %u)\n", newIp);
-
-                            if (appHandle->ifaceMD[socketIndex].usage > 0)
-                            {
-                                vos_printLog(
-                                    VOS_LOG_INFO,
-                                    "The new socket accepted from the same device (Ip = %u), won't be removed, because it is still in use\n",
-                                    newIp);
-                                socketFound = TRUE;
-                                break;
-                            }
-
-                            if (FD_ISSET(appHandle->ifaceMD[socketIndex].sock, (fd_set *) pRfds)) /*lint !e573 !e505
-                                                                                                signed/unsigned division in macro /
-                                                                                                Redundant left argument to comma */
-                            {
-                                /* Decrement the Ready descriptors counter */
-                                (*pCount)--;
-                                FD_CLR(appHandle->ifaceMD[socketIndex].sock, (fd_set *) pRfds); /*lint !e502 !e573 !e505
-                                                                                                signed/unsigned division
-                                                                                                in macro */
-                            }
-
-
-                            /* Close the old socket */
-                            appHandle->ifaceMD[socketIndex].tcpParams.morituri = TRUE;
-
-                            /* Manage the socket pool (update the socket) */
-                            trdp_mdCloseSessions(appHandle, socketIndex, new_sd, TRUE);
-
-                            socketFound = TRUE;
-                            break;
-                        }
-                    }
-
-                    if (socketFound == FALSE)
-                    {
-                        /* Save the new socket in the ifaceMD.
-                           On receiving MD data on this connection, a listener will be searched and a receive
-                           session instantiated. The socket/connection will be closed when the session has finished.
-                         */
-                        err = trdp_requestSocket(
-                                appHandle->ifaceMD,
-                                appHandle->mdDefault.tcpPort,
-                                &appHandle->mdDefault.sendParam,
-                                appHandle->realIP,
-                                0,
-                                TRDP_SOCK_MD_TCP,
-                                TRDP_OPTION_NONE,
-                                TRUE,
-                                new_sd,
-                                &socketIndex,
-                                newIp);
-
-                        if (err != TRDP_NO_ERR)
-                        {
-                            vos_printLog(VOS_LOG_ERROR, "trdp_requestSocket() failed (Err: %d, Port: %d)\n",
-                                         err, (UINT32)appHandle->mdDefault.tcpPort);
-                        }
-                    }
-                }
-
-                /**********************************************/
-                /* Loop back up and accept another incoming   */
-                /* connection                                 */
-                /**********************************************/
-            }
-            while (new_sd != VOS_INVALID_SOCKET);
+            trdp_mdAcceptConnections(appHandle, pRfds, pCount);
         }
     }
 
@@ -2879,45 +3142,7 @@ void  trdp_mdCheckListenSocks (
             }
             FD_CLR(appHandle->ifaceMD[lIndex].sock, (fd_set *)pRfds); /*lint !e502 !e573 !e505 signed/unsigned division in macro
                                                                       */
-            err = trdp_mdRecv(appHandle, (UINT32) lIndex);
-
-            if (appHandle->ifaceMD[lIndex].type == TRDP_SOCK_MD_TCP)
-            {
-                /* The receive message is incomplete */
-                if (err == TRDP_PACKET_ERR)
-                {
-                    vos_printLog(VOS_LOG_INFO, "Incomplete TCP MD received (Socket: %d)\n",
-                                 (int) appHandle->ifaceMD[lIndex].sock);
-                }
-                /* A packet error on TCP should not lead to closing of the connection!
-                     The following if-clauses were converted to else-if to prevent a false error handling (Ticket #160) */
-                /* Check if the socket has been closed in the other corner */
-                else if (err == TRDP_NODATA_ERR)
-                {
-                    vos_printLog(VOS_LOG_INFO,
-                                 "The socket has been closed in the other corner (Corner Ip: %s, Socket: %d)\n",
-                                 vos_ipDotted(appHandle->ifaceMD[lIndex].tcpParams.cornerIp),
-                                 (int) appHandle->ifaceMD[lIndex].sock);
-
-                    appHandle->ifaceMD[lIndex].tcpParams.morituri = TRUE;
-
-                    trdp_mdCloseSessions(appHandle, TRDP_INVALID_SOCKET_INDEX, VOS_INVALID_SOCKET, TRUE);
-                }
-                /* Check if the socket has been closed in the other corner */
-                else if ((err == TRDP_CRC_ERR) ||
-                         (err == TRDP_WIRE_ERR) ||
-                         (err == TRDP_TOPO_ERR))
-                {
-                    vos_printLog(VOS_LOG_WARNING,
-                                 "Closing TCP connection, out of sync (Corner Ip: %s, Socket: %d)\n",
-                                 vos_ipDotted(appHandle->ifaceMD[lIndex].tcpParams.cornerIp),
-                                 (int) appHandle->ifaceMD[lIndex].sock);
-
-                    appHandle->ifaceMD[lIndex].tcpParams.morituri = TRUE;
-
-                    trdp_mdCloseSessions(appHandle, TRDP_INVALID_SOCKET_INDEX, VOS_INVALID_SOCKET, TRUE);
-                }
-            }
+            trdp_mdReceiveSocket(appHandle, lIndex);
         }
     }
 }
@@ -2934,9 +3159,7 @@ void  trdp_mdCheckListenSocks (
 void  trdp_mdCheckTimeouts (
     TRDP_SESSION_PT appHandle)
 {
-    MD_ELE_T    *iterMD     = appHandle->pMDSndQueue;
-    BOOL8       firstLoop   = TRUE;
-    BOOL8       timeOut     = FALSE;
+    MD_ELE_T    *iterMD;
     TRDP_TIME_T now;
 
     if (appHandle == NULL)
@@ -2944,48 +3167,30 @@ void  trdp_mdCheckTimeouts (
         return;
     }
 
-    /*  Find the sessions which needs action
-     Note: We must also check the receive queue for pending replies! */
-    do
+    /*  Find the sessions which needs action: only those from the expired slots of the timer wheel
+        (sessions with infinite timeouts are not kept by the wheel) */
+    vos_getTime(&now);
+    trdp_mdTimerExpire(appHandle, &now);
+
+    while ((iterMD = trdp_mdTimerNextDue(appHandle)) != NULL)
     {
         TRDP_ERR_T resultCode = TRDP_UNKNOWN_ERR;
 
         /* Update the current time always inside loop in case of application delays  */
         vos_getTime(&now);
 
-        /*  Switch to receive queue */
-        if (NULL == iterMD && TRUE == firstLoop)
-        {
-            iterMD      = appHandle->pMDRcvQueue;
-            firstLoop   = FALSE;
-        }
-
-        /*  Are we finished?   */
-        if (NULL == iterMD)
-        {
-            break;
-        }
-
         /* timeToGo is timeout value! */
-        if (((iterMD->interval.tv_sec != TRDP_MD_INFINITE_TIME) ||
-             (iterMD->interval.tv_usec != TRDP_MD_INFINITE_USEC_TIME)) &&
-            (0 > vos_cmpTime(&iterMD->timeToGo, &now)))     /* timeout overflow */
+        if ((0 > vos_cmpTime(&iterMD->timeToGo, &now)) &&    /* timeout overflow */
+            (TRUE == trdp_mdTimeOutStateHandler(iterMD, appHandle, &resultCode)) &&
+            (iterMD->pfCbFunction != NULL))
         {
-            timeOut = trdp_mdTimeOutStateHandler( iterMD, appHandle, &resultCode);
+            /* Notify user  */
+            trdp_mdInvokeCallback(iterMD, appHandle, resultCode);
         }
 
-        if (TRUE == timeOut)    /* Notify user  */
-        {
-            /* Execute callback */
-            if (iterMD->pfCbFunction != NULL)
-            {
-                trdp_mdInvokeCallback(iterMD, appHandle, resultCode);
-            }
-        }
-
-        iterMD = iterMD->pNext;
+        /* a retry, the next timeout or, if nothing changed, again with the next tick */
+        trdp_mdTimerSchedule(appHandle, iterMD);
     }
-    while (TRUE); /*lint !e506 */
 
     /* Check for sockets Connection Timeouts */
     /* if ((appHandle->mdDefault.flags & TRDP_FLAGS_TCP) != 0) */
@@ -3034,7 +3239,7 @@ void  trdp_mdCheckTimeouts (
                     {
                         if (iterMD_find->socketIdx == lIndex)
                         {
-                            iterMD_find->morituri = TRUE;
+                            trdp_mdSetMorituri(appHandle, iterMD_find);
 
                             /* Execute callback for each session */
                             if (iterMD_find->pfCbFunction != NULL)
@@ -3099,6 +3304,7 @@ static TRDP_ERR_T trdp_mdConnectSocket (TRDP_APP_SESSION_T      appHandle,
         else
         {
             pSenderElement->tcpParameters.doConnect = TRUE;
+            appHandle->ifaceMD[pSenderElement->socketIdx].tcpParams.shared = appHandle->mdDefault.shareTcp;
             /*  Ticket #Usage should be handled inside trdp_requestSocket() only, if it returns without error, usage is incremented
                 appHandle->ifaceMD[pSenderElement->socketIdx].usage++; */
         }
@@ -3216,8 +3422,9 @@ static void trdp_mdDetailSenderPacket (const TRDP_MSG_T         msgType,
     /* Insert element in send queue */
     if ( TRUE == newSession )
     {
-            trdp_MDqueueAppLast(&appHandle->pMDSndQueue, pSenderElement);
+            trdp_MDqueueAppLast(&appHandle->pMDSndQueue, &appHandle->mdSndIndex, pSenderElement);
     }
+    trdp_mdTimerSchedule(appHandle, pSenderElement);
 
     vos_printLog(VOS_LOG_INFO,
                  "MD sender element state = %d, msgType=%c%c\n",
@@ -3289,10 +3496,17 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
     if ( pSessionId )
     {
         errv = trdp_mdLookupElement((MD_ELE_T *)appHandle->pMDRcvQueue,
+                                    &appHandle->mdRcvIndex,
                                     TRDP_ST_RX_REQ_W4AP_REPLY,
                                     pSessionId,
                                     &pSenderElement);
 
+        if ((TRDP_NO_ERR == errv) && (NULL != pSenderElement) && ((pSenderElement->pktFlags & TRDP_FLAGS_TCP) != 0))
+        {
+            /* refused while the connection is busy, the session waits for the reply to be repeated */
+            errv = trdp_mdTcpQueueCheck(appHandle, pSenderElement->socketIdx, trdp_packetSizeMD(dataSize));
+        }
+
         if ((TRDP_NO_ERR == errv) && (NULL != pSenderElement))
         {
 
@@ -3346,7 +3560,7 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
                     pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
                     if ( NULL == pSenderElement->pPacket )
                     {
-                        vos_memFree(pSenderElement);
+                        trdp_arenaFree(appHandle, TRDP_ARENA_MD_ELE, pSenderElement);
                         pSenderElement = NULL;
                         errv = TRDP_MEM_ERR;
                     }
@@ -3465,7 +3679,7 @@ TRDP_ERR_T trdp_mdCall (
     }
 
     /* Room for MD element */
-    pSenderElement = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
+    pSenderElement = (MD_ELE_T *) trdp_arenaAlloc(appHandle, TRDP_ARENA_MD_ELE, sizeof(MD_ELE_T));
 
     /* Reset descriptor value */
     if ( NULL != pSenderElement )
@@ -3548,6 +3762,16 @@ TRDP_ERR_T trdp_mdCall (
                                     destIpAddr,
                                     TRUE,
                                     pSenderElement);
+        if ((errv == TRDP_NO_ERR) && ((pSenderElement->pktFlags & TRDP_FLAGS_TCP) != 0))
+        {
+            errv = trdp_mdTcpQueueCheck(appHandle, pSenderElement->socketIdx, pSenderElement->grossSize);
+            if (errv != TRDP_NO_ERR)
+            {
+                /* give the connection back */
+                trdp_releaseSocket(appHandle->ifaceMD, pSenderElement->socketIdx,
+                                   appHandle->mdDefault.connectTimeout, FALSE, VOS_INADDR_ANY);
+            }
+        }
         if ( errv == TRDP_NO_ERR )
         {
             trdp_mdFillStateElement(msgType, pSenderElement);
@@ -3567,7 +3791,7 @@ TRDP_ERR_T trdp_mdCall (
             pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
             if ( NULL == pSenderElement->pPacket )
             {
-                vos_memFree(pSenderElement);
+                trdp_arenaFree(appHandle, TRDP_ARENA_MD_ELE, pSenderElement);
                 pSenderElement = NULL;
                 errv = TRDP_MEM_ERR;
 
@@ -3597,7 +3821,7 @@ TRDP_ERR_T trdp_mdCall (
     if ( TRDP_NO_ERR != errv &&
          NULL != pSenderElement )
     {
-        trdp_mdFreeSession(pSenderElement);
+        trdp_mdFreeSession(appHandle, pSenderElement);
         pSenderElement = NULL;
     }
 
@@ -3657,6 +3881,7 @@ TRDP_ERR_T trdp_mdConfirm (
     if ( pSessionId )
     {
         errv = trdp_mdLookupElement((MD_ELE_T *)appHandle->pMDSndQueue,
+                                    &appHandle->mdSndIndex,
                                     TRDP_ST_TX_REQ_W4AP_CONFIRM,
                                     (const UINT8 *)pSessionId,
                                     &pSenderElement);
@@ -3710,7 +3935,7 @@ TRDP_ERR_T trdp_mdConfirm (
                 pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
                 if ( NULL == pSenderElement->pPacket )
                 {
-                    vos_memFree(pSenderElement);
+                    trdp_arenaFree(appHandle, TRDP_ARENA_MD_ELE, pSenderElement);
                     pSenderElement = NULL;
                     errv = TRDP_MEM_ERR;
                 }
@@ -17,6 +17,10 @@
  /*
  * $Id: trdp_mdcom.h 2183 2020-07-29 15:51:09Z bloehr $
  *
+ *      AG 2026-10-17: trdp_mdFindListener()
+ *      AG 2026-10-17: trdp_mdAcceptConnections(), trdp_mdReceiveSocket()
+ *      AG 2026-10-17: trdp_mdSetMorituri()
+ *      AG 2026-10-17: Session parameter for trdp_mdFreeSession (arena)
  *      BL 2020-07-29: Ticket #286 tlm_reply() is missing a sourceURI parameter as defined in the standard
  *     AHW 2017-11-08: Ticket #179 Max. number of retries (part of sendParam) of a MD request needs to be checked
  *      BL 2014-07-14: Ticket #46: Protocol change: operational topocount needed
@@ -50,7 +54,17 @@ TRDP_ERR_T  trdp_mdGetTCPSocket (
     TRDP_SESSION_PT pSession);
 
 void        trdp_mdFreeSession (
-    MD_ELE_T *pMDSession);
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pMDSession);
+
+MD_LIS_ELE_T *trdp_mdFindListener (
+    TRDP_SESSION_PT     appHandle,
+    BOOL8               isTCP,
+    const MD_HEADER_T   *pH);
+
+void        trdp_mdSetMorituri (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pMDSession);
 
 TRDP_ERR_T  trdp_mdSend (
     TRDP_SESSION_PT appHandle);
@@ -60,6 +74,15 @@ void        trdp_mdCheckPending (
     TRDP_FDS_T          *pFileDesc,
     INT32               *pNoDesc);
 
+void        trdp_mdAcceptConnections (
+    const TRDP_SESSION_PT   appHandle,
+    TRDP_FDS_T              *pRfds,
+    INT32                   *pCount);
+
+void        trdp_mdReceiveSocket (
+    const TRDP_SESSION_PT   appHandle,
+    INT32                   lIndex);
+
 void trdp_mdCheckListenSocks (
     const TRDP_SESSION_PT appHandle,
     TRDP_FDS_T      *pRfds,
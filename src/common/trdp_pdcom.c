@@ -17,6 +17,16 @@
 /*
 * $Id: trdp_pdcom.c 2223 2020-11-03 15:06:50Z bloehr $
 *
+*      AG 2026-10-17: trdp_pdFlushBatch(): measured gain of batched sending documented
+*      AG 2026-10-17: Frames given back by tlp_releaseRef() are recycled by trdp_pdRecycleRef() under mutexRxPD
+*      AG 2026-10-17: Frames are returned to the publisher or subscriber slab of the arena
+*      AG 2026-10-17: trdp_pdReceiveSocket() split off trdp_pdCheckListenSocks(), trdp_pdCheckPending() without fd set
+*      AG 2026-10-17: Frames and elements are taken from/returned to the session arena
+*      AG 2026-10-17: Zero-copy writing: trdp_pdPutBegin()/trdp_pdPutCommit() swap a lent frame in at commit
+*      AG 2026-10-17: Zero-copy reading: frames lent by trdp_pdGetRef() are not recycled by the receiver
+*      AG 2026-10-17: trdp_pdHandleFrame() uses the subscriber hash index in both build modes
+*      AG 2026-10-17: Batched PD transmission (trdp_pdSendElement with batch, trdp_pdFlushBatch)
+*      AG 2026-10-17: Batched PD reception (trdp_pdReceiveBatch), frame handling moved to trdp_pdHandleFrame()
 *      BL 2020-11-03: Ticket #347 Allow dynamic sized arrays for PD (Ticket #207 undone)
 *      BL 2020-07-29: Ticket #332 Error reading from TSN PD header
 *      BL 2020-07-27: Ticket #304 ... stats count for no subscription added
@@ -166,6 +176,7 @@ void    trdp_pdInit (
 /** Copy data
  *  Update the data to be sent
  *
+ *  @param[in]      appHandle       session pointer
  *  @param[in]      pPacket         pointer to the packet element to send
  *  @param[in]      marshall        pointer to marshalling function
  *  @param[in]      refCon          reference for marshalling function
@@ -176,6 +187,7 @@ void    trdp_pdInit (
  *                                  other errors
  */
 TRDP_ERR_T trdp_pdPut (
+    TRDP_SESSION_PT appHandle,
     PD_ELE_T        *pPacket,
     TRDP_MARSHALL_T marshall,
     void            *refCon,
@@ -208,15 +220,18 @@ TRDP_ERR_T trdp_pdPut (
 
             pPacket->dataSize   = dataSize;
             pPacket->grossSize  = trdp_packetSizePD(dataSize);
-            pTemp = (PD_PACKET_T *) vos_memAlloc(pPacket->grossSize);
-            if (pTemp == NULL)
+            if (!(pPacket->privFlags & TRDP_MAX_FRAME))
             {
-                return TRDP_MEM_ERR;
+                pTemp = (PD_PACKET_T *) trdp_arenaAlloc(appHandle, TRDP_ARENA_PUB_FRAME, pPacket->grossSize);
+                if (pTemp == NULL)
+                {
+                    return TRDP_MEM_ERR;
+                }
+                /* copy existing header info */
+                memcpy(pTemp, pPacket->pFrame, trdp_packetSizePD(0u));
+                trdp_arenaFree(appHandle, TRDP_ARENA_PUB_FRAME, pPacket->pFrame);
+                pPacket->pFrame = pTemp;
             }
-            /* copy existing header info */
-            memcpy(pTemp, pPacket->pFrame, trdp_packetSizePD(0u));
-            vos_memFree(pPacket->pFrame);
-            pPacket->pFrame = pTemp;
             /* complete header info, set dataset length */
             pPacket->pFrame->frameHead.datasetLength = vos_htonl(pPacket->dataSize);
         }
@@ -230,22 +245,24 @@ TRDP_ERR_T trdp_pdPut (
                 return TRDP_PARAM_ERR;
             }
             /* If new data size is larger than former size, we must reallocate the transmit buffer */
-            if (pPacket->grossSize  < trdp_packetSizePD(dataSize))
+            if (!(pPacket->privFlags & TRDP_MAX_FRAME) &&
+                (pPacket->grossSize < trdp_packetSizePD(dataSize)))
             {
                 PD_PACKET_T *pTemp;
-                pTemp = (PD_PACKET_T *) vos_memAlloc(trdp_packetSizePD(dataSize));
+                pTemp = (PD_PACKET_T *) trdp_arenaAlloc(appHandle, TRDP_ARENA_PUB_FRAME, trdp_packetSizePD(dataSize));
                 if (pTemp == NULL)
                 {
                     return TRDP_MEM_ERR;
                 }
                 /* copy existing header info */
                 memcpy(pTemp, pPacket->pFrame, trdp_packetSizePD(0u));
-                vos_memFree(pPacket->pFrame);
+                trdp_arenaFree(appHandle, TRDP_ARENA_PUB_FRAME, pPacket->pFrame);
                 pPacket->pFrame = pTemp;
             }
             memcpy(pPacket->pFrame->data, pData, dataSize);
             pPacket->dataSize   = dataSize;
             pPacket->grossSize  = trdp_packetSizePD(dataSize);
+            pPacket->pFrame->frameHead.datasetLength = vos_htonl(pPacket->dataSize);
         }
         else
         {
@@ -429,18 +446,227 @@ TRDP_ERR_T trdp_pdGet (
     return TRDP_NO_ERR;
 }
 
+/******************************************************************************/
+/** Lend a frame of a publisher to the application for writing the next data in place
+ *  The frame is not referenced by the send queue until trdp_pdPutCommit() swaps it in, so the sender never
+ *  sees partially written data. The frame does not contain the current data.
+ *  The caller holds mutexTxPD unless the publisher has a spare frame, which is not shared with the sender.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pPacket             publisher
+ *  @param[out]     ppData              pointer to the data area of the lent frame
+ *  @param[out]     pMaxSize            size of the data area
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_INUSE_ERR      a frame is already lent and not yet committed
+ */
+TRDP_ERR_T trdp_pdPutBegin (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T    *pPacket,
+    UINT8       * *ppData,
+    UINT32      *pMaxSize)
+{
+    if (pPacket->pRefFrame != NULL)
+    {
+        return TRDP_INUSE_ERR;
+    }
+    if (pPacket->pSpareFrame == NULL)
+    {
+        pPacket->pSpareFrame = (PD_PACKET_T *) trdp_arenaAlloc(appHandle, TRDP_ARENA_PUB_FRAME,
+                                                               TRDP_MAX_PD_PACKET_SIZE);
+        if (pPacket->pSpareFrame == NULL)
+        {
+            return TRDP_MEM_ERR;
+        }
+    }
+    pPacket->pRefFrame      = pPacket->pSpareFrame;
+    pPacket->pSpareFrame    = NULL;
+    *ppData     = pPacket->pRefFrame->data;
+    *pMaxSize   = TRDP_MAX_PD_DATA_SIZE;
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Make the frame lent by trdp_pdPutBegin() the current frame of a publisher
+ *  The header is taken over from the current frame, which is kept for the next trdp_pdPutBegin() if possible.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pPacket             publisher
+ *  @param[in]      dataSize            size of the data written
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      dataSize too large, the frame stays lent
+ *  @retval         TRDP_STATE_ERR      no frame lent
+ */
+TRDP_ERR_T trdp_pdPutCommit (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T    *pPacket,
+    UINT32      dataSize)
+{
+    PD_PACKET_T *pOld = pPacket->pFrame;
+
+    if (pPacket->pRefFrame == NULL)
+    {
+        return TRDP_STATE_ERR;
+    }
+    if (dataSize > TRDP_MAX_PD_DATA_SIZE)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /* take over the header, sequence counter and CRC are set when sending */
+    memcpy(&pPacket->pRefFrame->frameHead, &pOld->frameHead, sizeof(PD_HEADER_T));
+    pPacket->pRefFrame->frameHead.datasetLength = vos_htonl(dataSize);
+    pPacket->pFrame     = pPacket->pRefFrame;
+    pPacket->pRefFrame  = NULL;
+
+    /* A former lent frame will be lent again, an initial frame may be too small */
+    if (pPacket->privFlags & TRDP_MAX_FRAME)
+    {
+        pPacket->pSpareFrame = pOld;
+    }
+    else
+    {
+        trdp_arenaFree(appHandle, TRDP_ARENA_PUB_FRAME, pOld);
+    }
+
+    pPacket->dataSize   = dataSize;
+    pPacket->grossSize  = trdp_packetSizePD(dataSize);
+    pPacket->privFlags  = (TRDP_PRIV_FLAGS_T) ((pPacket->privFlags | TRDP_MAX_FRAME) &
+                                               ~(TRDP_PRIV_FLAGS_T)TRDP_INVALID_DATA);
+
+    /*  Update some statistics  */
+    pPacket->updPkts++;
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Lend the current frame of a subscription to the application
+ *  The frame is pinned until tlp_releaseRef() gives it back, received frames are stored in another buffer.
+ *  A frame given back before is recycled first.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pPacket             subscription
+ *  @param[out]     ppData              pointer to the received data (network representation)
+ *  @param[out]     pDataSize           size of the received data
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NODATA_ERR     nothing received yet
+ *  @retval         TRDP_TIMEOUT_ERR    packet timed out
+ *  @retval         TRDP_INUSE_ERR      a frame is already lent and not yet released
+ */
+TRDP_ERR_T trdp_pdGetRef (
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            *pPacket,
+    const UINT8         * *ppData,
+    UINT32              *pDataSize)
+{
+    if ((pPacket == NULL) || (ppData == NULL) || (pDataSize == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    trdp_pdRecycleRef(appHandle, pPacket);
+
+    /*  Update some statistics  */
+    pPacket->getPkts++;
+
+    if ((pPacket->privFlags & TRDP_INVALID_DATA) != 0)
+    {
+        return TRDP_NODATA_ERR;
+    }
+
+    if ((pPacket->privFlags & TRDP_TIMED_OUT) != 0)
+    {
+        return TRDP_TIMEOUT_ERR;
+    }
+
+    if (pPacket->pRefFrame != NULL)
+    {
+        return TRDP_INUSE_ERR;
+    }
+
+    pPacket->pRefFrame  = pPacket->pFrame;
+    *ppData             = pPacket->pFrame->data;
+    *pDataSize          = pPacket->dataSize;
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Take back a frame lent by trdp_pdGetRef() once tlp_releaseRef() has given it back
+ *  tlp_releaseRef() only marks the frame, it is recycled here under mutexRxPD. A frame which was superseded in the
+ *  meantime is kept as spare buffer for the next lending.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pPacket             subscription
+ */
+void trdp_pdRecycleRef (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket)
+{
+    if ((pPacket->pRefFrame == NULL) || (TRDP_REF_IS_RELEASED(pPacket) == 0u))
+    {
+        return;
+    }
+    if (pPacket->pRefFrame != pPacket->pFrame)
+    {
+        if (pPacket->pSpareFrame == NULL)
+        {
+            pPacket->pSpareFrame = pPacket->pRefFrame;
+        }
+        else
+        {
+            trdp_arenaFree(appHandle, TRDP_ARENA_SUB_FRAME, pPacket->pRefFrame);
+        }
+    }
+    pPacket->pRefFrame      = NULL;
+    pPacket->refReleased    = 0u;
+}
+
+/******************************************************************************/
+/** Free the buffers of a publisher or subscription used for lending frames
+ *  Must be called before the element and its pFrame are freed.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pPacket             publisher or subscription
+ *  @param[in]      slab                TRDP_ARENA_PUB_FRAME or TRDP_ARENA_SUB_FRAME
+ */
+void trdp_pdFreeRefFrames (
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            *pPacket,
+    TRDP_ARENA_SLAB_T   slab)
+{
+    if ((pPacket->pRefFrame != NULL) && (pPacket->pRefFrame != pPacket->pFrame))
+    {
+        trdp_arenaFree(appHandle, slab, pPacket->pRefFrame);
+    }
+    if (pPacket->pSpareFrame != NULL)
+    {
+        trdp_arenaFree(appHandle, slab, pPacket->pSpareFrame);
+    }
+    pPacket->pRefFrame      = NULL;
+    pPacket->pSpareFrame    = NULL;
+    pPacket->refReleased    = 0u;
+}
+
 /******************************************************************************/
 /** Send a due PD message
+ *  If a batch is supplied, plain cyclic frames are only collected and will be sent (and counted) by
+ *  trdp_pdFlushBatch(). Requests, pulled and one shot frames are always sent immediately.
  *
  *  @param[in]      appHandle           session pointer
  *  @param[in]      ppElement           pointer to pointer of the element to send
+ *  @param[in,out]  pBatch              batch to collect cyclic frames, NULL to send immediately
  *
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_IO_ERR         socket I/O error
  */
 TRDP_ERR_T  trdp_pdSendElement (
-    TRDP_SESSION_PT appHandle,
-    PD_ELE_T        * *ppElement)
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            * *ppElement,
+    TRDP_PD_SND_BATCH_T *pBatch)
 {
     TRDP_ERR_T  err     = TRDP_NO_ERR;
     PD_ELE_T    *iterPD = *ppElement;
@@ -498,16 +724,31 @@ TRDP_ERR_T  trdp_pdSendElement (
                                      iterPD->pFrame->data,
                                      vos_ntohl(iterPD->pFrame->frameHead.datasetLength));
             }
-            /* We pass the error to the application, but we keep on going    */
-            result = trdp_pdSend(appHandle->ifacePD[iterPD->socketIdx].sock, iterPD, appHandle->pdDefault.port);
-            if (result == TRDP_NO_ERR)
+            if ((pBatch != NULL) &&
+                (iterPD->pullIpAddress == 0u) &&
+                !(iterPD->privFlags & TRDP_REQ_2B_SENT) &&
+                (iterPD->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PD)))
             {
-                appHandle->stats.pd.numSend++;
-                iterPD->numRxTx++;
+                /* Cyclic frame: will be sent and counted by trdp_pdFlushBatch() */
+                if (pBatch->noOfFrames >= TRDP_PD_SND_BATCH_SIZE)
+                {
+                    err = trdp_pdFlushBatch(appHandle, pBatch);
+                }
+                pBatch->pElement[pBatch->noOfFrames++] = iterPD;
             }
             else
             {
-                err = result;   /* pass last error to application  */
+                /* We pass the error to the application, but we keep on going    */
+                result = trdp_pdSend(appHandle->ifacePD[iterPD->socketIdx].sock, iterPD, appHandle->pdDefault.port);
+                if (result == TRDP_NO_ERR)
+                {
+                    appHandle->stats.pd.numSend++;
+                    iterPD->numRxTx++;
+                }
+                else
+                {
+                    err = result;   /* pass last error to application  */
+                }
             }
         }
     }
@@ -558,10 +799,10 @@ TRDP_ERR_T  trdp_pdSendElement (
         iterPD->magic = 0u;
         if (iterPD->pSeqCntList != NULL)
         {
-            vos_memFree(iterPD->pSeqCntList);
+            trdp_seqCntFree(appHandle, iterPD->pSeqCntList);
         }
-        vos_memFree(iterPD->pFrame);
-        vos_memFree(iterPD);
+        trdp_arenaFree(appHandle, TRDP_ARENA_PUB_FRAME, iterPD->pFrame);
+        trdp_arenaFree(appHandle, TRDP_ARENA_PUB_ELE, iterPD);
 
         /* pre-set next element */
         *ppElement = pTemp;
@@ -570,6 +811,94 @@ TRDP_ERR_T  trdp_pdSendElement (
     return err;
 }
 
+/******************************************************************************/
+/** Send the PD frames collected by trdp_pdSendElement()
+ *  All frames for the same socket are handed over with one vos_sockSendUDPBatch() call.
+ *  The statistics are only updated for frames which were sent completely.
+ *  Only the system call per frame is saved, each datagram still passes the UDP stack: trdp-pd-bench shows a few
+ *  percent on VOS level and no clear difference through tlp_processSend() (pdSendSingle).
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in,out]  pBatch              collected frames, empty on return
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_IO_ERR         socket I/O error
+ */
+TRDP_ERR_T  trdp_pdFlushBatch (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_PD_SND_BATCH_T *pBatch)
+{
+    TRDP_ERR_T      err = TRDP_NO_ERR;
+    VOS_SOCK_MSG_T  msgs[TRDP_PD_SND_BATCH_SIZE];
+    PD_ELE_T        *pSent[TRDP_PD_SND_BATCH_SIZE];
+    BOOL8           done[TRDP_PD_SND_BATCH_SIZE];
+    UINT32          i, j;
+
+    if ((pBatch == NULL) || (pBatch->noOfFrames == 0u))
+    {
+        return TRDP_NO_ERR;
+    }
+
+    memset(done, 0, sizeof(done));
+
+    for (i = 0u; i < pBatch->noOfFrames; i++)
+    {
+        INT32   socketIdx;
+        UINT32  noOfMsgs = 0u;
+        UINT32  noOfSent;
+
+        if (done[i] == TRUE)
+        {
+            continue;
+        }
+
+        /* Collect all frames going out on the same socket */
+        socketIdx = pBatch->pElement[i]->socketIdx;
+        for (j = i; j < pBatch->noOfFrames; j++)
+        {
+            PD_ELE_T *pElement = pBatch->pElement[j];
+
+            if ((done[j] == FALSE) && (pElement->socketIdx == socketIdx))
+            {
+                done[j] = TRUE;
+                pElement->sendSize          = 0u;
+                msgs[noOfMsgs].pBuffer      = (UINT8 *)&pElement->pFrame->frameHead;
+                msgs[noOfMsgs].size         = pElement->grossSize;
+                msgs[noOfMsgs].dstIPAddr    = pElement->addr.destIpAddr;
+                msgs[noOfMsgs].dstIPPort    = appHandle->pdDefault.port;
+                pSent[noOfMsgs]             = pElement;
+                noOfMsgs++;
+            }
+        }
+
+        noOfSent = noOfMsgs;
+        if (vos_sockSendUDPBatch(appHandle->ifacePD[socketIdx].sock, msgs, &noOfSent) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_DBG, "trdp_pdFlushBatch failed\n");
+        }
+
+        for (j = 0u; j < noOfMsgs; j++)
+        {
+            pSent[j]->sendSize = msgs[j].size;
+            if (pSent[j]->sendSize == pSent[j]->grossSize)
+            {
+                appHandle->stats.pd.numSend++;
+                pSent[j]->numRxTx++;
+            }
+            else
+            {
+                if (pSent[j]->sendSize != 0u)
+                {
+                    vos_printLogStr(VOS_LOG_ERROR, "trdp_pdFlushBatch incomplete\n");
+                }
+                err = TRDP_IO_ERR;  /* pass last error to application  */
+            }
+        }
+    }
+    pBatch->noOfFrames = 0u;
+    return err;
+}
+
 /******************************************************************************/
 /** Send all due PD messages
  *
@@ -713,10 +1042,10 @@ TRDP_ERR_T  trdp_pdSendQueued (
                 iterPD->magic = 0u;
                 if (iterPD->pSeqCntList != NULL)
                 {
-                    vos_memFree(iterPD->pSeqCntList);
+                    trdp_seqCntFree(appHandle, iterPD->pSeqCntList);
                 }
-                vos_memFree(iterPD->pFrame);
-                vos_memFree(iterPD);
+                trdp_arenaFree(appHandle, TRDP_ARENA_PUB_FRAME, iterPD->pFrame);
+                trdp_arenaFree(appHandle, TRDP_ARENA_PUB_ELE, iterPD);
 
                 /* pre-set next element */
                 iterPD = pTemp;
@@ -729,15 +1058,17 @@ TRDP_ERR_T  trdp_pdSendQueued (
 }
 
 /******************************************************************************/
-/** Receiving PD messages
- *  Read the receive socket for arriving PDs, copy the packet to a new PD_ELE_T
+/** Handle a received PD frame
  *  Check for protocol errors and compare the received data to the data in our receive queue.
  *  If it is a new packet, check if it is a PD Request (PULL).
- *  If it is an update, exchange the existing entry with the new one
+ *  If it is an update, exchange the existing entry's frame with the received one
  *  Call user's callback if needed
  *
  *  @param[in]      appHandle           session pointer
- *  @param[in]      sock                the socket to read from
+ *  @param[in,out]  ppFrame             pointer to the receive buffer, exchanged with the subscriber's frame on update
+ *  @param[in]      recSize             size of the received frame
+ *  @param[in]      srcIpAddr           source IP of the received frame
+ *  @param[in]      destIpAddr          destination IP of the received frame
  *
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
@@ -746,15 +1077,17 @@ TRDP_ERR_T  trdp_pdSendQueued (
  *  @retval         TRDP_CRC_ERR        header checksum
  *  @retval         TRDP_TOPOCOUNT_ERR  invalid topocount
  */
-TRDP_ERR_T  trdp_pdReceive (
+static TRDP_ERR_T  trdp_pdHandleFrame (
     TRDP_SESSION_PT appHandle,
-    SOCKET          sock)
+    PD_PACKET_T     * *ppFrame,
+    UINT32          recSize,
+    TRDP_IP_ADDR_T  srcIpAddr,
+    TRDP_IP_ADDR_T  destIpAddr)
 {
-    PD_HEADER_T         *pNewFrameHead      = &appHandle->pNewFrame->frameHead;
+    PD_HEADER_T         *pNewFrameHead      = &(*ppFrame)->frameHead;
     PD_ELE_T            *pExistingElement   = NULL;
     PD_ELE_T            *pPulledElement;
     TRDP_ERR_T          err             = TRDP_NO_ERR;
-    UINT32              recSize         = TRDP_MAX_PD_PACKET_SIZE;
     int                 informUser      = FALSE;
     int                 isTSN           = FALSE;
     TRDP_ADDRESSES_T    subAddresses    = { 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u};
@@ -763,18 +1096,8 @@ TRDP_ERR_T  trdp_pdReceive (
     PD2_HEADER_T        *pTSNFrameHead = (PD2_HEADER_T *) pNewFrameHead;
 #endif
 
-    /*  Get the packet from the wire:  */
-    err = (TRDP_ERR_T) vos_sockReceiveUDP(sock,
-                                          (UINT8 *) pNewFrameHead,
-                                          &recSize,
-                                          &subAddresses.srcIpAddr,
-                                          NULL,
-                                          &subAddresses.destIpAddr,
-                                          FALSE);
-    if ( err != TRDP_NO_ERR)
-    {
-        return err;
-    }
+    subAddresses.srcIpAddr  = srcIpAddr;
+    subAddresses.destIpAddr = destIpAddr;
 
     /*  Is packet sane?    */
     err = trdp_pdCheck(pNewFrameHead, recSize, &isTSN);
@@ -830,23 +1153,8 @@ TRDP_ERR_T  trdp_pdReceive (
 
     }
 
-    /*  Examine subscription queue, are we interested in this PD?   */
-#ifdef HIGH_PERF_INDEXED
-    if ((appHandle->pSlot == NULL) ||
-        (appHandle->pSlot->noOfRxEntries == 0))
-    {
-        /*  If not set up until now, we issue a warning, but handle the data...   */
-        vos_printLogStr(VOS_LOG_WARNING, "Receiving PD while tlc_updateSession() not yet called or rcvIdx empty.\n");
-        pExistingElement = trdp_queueFindSubAddr(appHandle->pRcvQueue, &subAddresses);
-    }
-    else
-    {
-        /*  This is the fast, indexed access to our subscriptions!   */
-        pExistingElement = trdp_indexedFindSubAddr(appHandle, &subAddresses);
-    }
-#else
-    pExistingElement = trdp_queueFindSubAddr(appHandle->pRcvQueue, &subAddresses);
-#endif
+    /*  Examine subscription index, are we interested in this PD?   */
+    pExistingElement = trdp_subIndexFind(appHandle, &subAddresses);
 
     if (pExistingElement == NULL)
     {
@@ -869,6 +1177,21 @@ TRDP_ERR_T  trdp_pdReceive (
                                    pExistingElement->addr.opTrnTopoCnt))
         {
             UINT32 newSeqCnt = vos_ntohl(pNewFrameHead->sequenceCounter);   /* same location for PD and PD2 */
+
+            /* The current frame is lent to the application (tlp_getRef), we need another buffer to swap in,
+               unless it was given back meanwhile */
+            trdp_pdRecycleRef(appHandle, pExistingElement);
+            if ((pExistingElement->pRefFrame == pExistingElement->pFrame) &&
+                (pExistingElement->pSpareFrame == NULL))
+            {
+                pExistingElement->pSpareFrame = (PD_PACKET_T *) trdp_arenaAlloc(appHandle, TRDP_ARENA_SUB_FRAME,
+                                                                                TRDP_MAX_PD_PACKET_SIZE);
+                if (pExistingElement->pSpareFrame == NULL)
+                {
+                    return TRDP_MEM_ERR;
+                }
+            }
+
             /* Save the source IP address of the received packet */
             pExistingElement->lastSrcIP = subAddresses.srcIpAddr;
             /* Save the real destination of the received packet (own IP or MC group) */
@@ -882,7 +1205,7 @@ TRDP_ERR_T  trdp_pdReceive (
             }
 
             /* find sender in our list */
-            switch (trdp_checkSequenceCounter(pExistingElement,
+            switch (trdp_checkSequenceCounter(appHandle, pExistingElement,
                                               newSeqCnt,
                                               subAddresses.srcIpAddr, msgType))
             {
@@ -930,7 +1253,7 @@ TRDP_ERR_T  trdp_pdReceive (
                     {
                         informUser = TRUE;                 /* Inform user anyway */
                     }
-                    else if (0 != memcmp(appHandle->pNewFrame->data,
+                    else if (0 != memcmp((*ppFrame)->data,
                                          pExistingElement->pFrame->data,
                                          pExistingElement->dataSize))
                     {
@@ -957,8 +1280,15 @@ TRDP_ERR_T  trdp_pdReceive (
             /*  -> always swap the frame pointers              */
             {
                 PD_PACKET_T *pTemp = pExistingElement->pFrame;
-                pExistingElement->pFrame    = appHandle->pNewFrame;
-                appHandle->pNewFrame        = pTemp;
+
+                /*  a lent frame stays with the application, the receiver gets the spare buffer */
+                if (pTemp == pExistingElement->pRefFrame)
+                {
+                    pTemp = pExistingElement->pSpareFrame;
+                    pExistingElement->pSpareFrame = NULL;
+                }
+                pExistingElement->pFrame    = *ppFrame;
+                *ppFrame                    = pTemp;
             }
 
             /*  It might be a PULL request      */
@@ -1020,7 +1350,7 @@ TRDP_ERR_T  trdp_pdReceive (
                     /* trigger immediate sending of PD  */
                     pPulledElement->privFlags |= TRDP_REQ_2B_SENT;
 
-                    if (trdp_pdSendElement(appHandle, &pPulledElement) != TRDP_NO_ERR)
+                    if (trdp_pdSendElement(appHandle, &pPulledElement, NULL) != TRDP_NO_ERR)
                     {
                         /*  We do not break here, only report error */
                         vos_printLogStr(VOS_LOG_WARNING, "Error sending one or more PD packets\n");
@@ -1095,11 +1425,102 @@ TRDP_ERR_T  trdp_pdReceive (
     return err;
 }
 
+/******************************************************************************/
+/** Receiving PD messages
+ *  Read the receive socket for one arriving PD into the session's receive buffer and handle it.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      sock                the socket to read from
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_WIRE_ERR       protocol error (late packet, version mismatch)
+ *  @retval         TRDP_QUEUE_ERR      not in queue
+ *  @retval         TRDP_CRC_ERR        header checksum
+ *  @retval         TRDP_TOPOCOUNT_ERR  invalid topocount
+ */
+TRDP_ERR_T  trdp_pdReceive (
+    TRDP_SESSION_PT appHandle,
+    SOCKET          sock)
+{
+    TRDP_ERR_T      err;
+    UINT32          recSize     = TRDP_MAX_PD_PACKET_SIZE;
+    TRDP_IP_ADDR_T  srcIpAddr   = 0u;
+    TRDP_IP_ADDR_T  destIpAddr  = 0u;
+
+    /*  Get the packet from the wire:  */
+    err = (TRDP_ERR_T) vos_sockReceiveUDP(sock,
+                                          (UINT8 *) appHandle->pNewFrame,
+                                          &recSize,
+                                          &srcIpAddr,
+                                          NULL,
+                                          &destIpAddr,
+                                          FALSE);
+    if ( err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+
+    return trdp_pdHandleFrame(appHandle, &appHandle->pNewFrame, recSize, srcIpAddr, destIpAddr);
+}
+
+/******************************************************************************/
+/** Receiving several PD messages with one socket call
+ *  Read up to TRDP_PD_RCV_BATCH_SIZE arriving PDs into the session's receive ring, then handle them in order.
+ *  All frames read are handled, the first error encountered is reported.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      sock                the socket to read from
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_WIRE_ERR       protocol error (late packet, version mismatch)
+ *  @retval         TRDP_QUEUE_ERR      not in queue
+ *  @retval         TRDP_CRC_ERR        header checksum
+ *  @retval         TRDP_TOPOCOUNT_ERR  invalid topocount
+ *  @retval         TRDP_BLOCK_ERR      no data available
+ */
+TRDP_ERR_T  trdp_pdReceiveBatch (
+    TRDP_SESSION_PT appHandle,
+    SOCKET          sock)
+{
+    VOS_SOCK_MSG_T  msgs[TRDP_PD_RCV_BATCH_SIZE];
+    UINT32          noOfMsgs = TRDP_PD_RCV_BATCH_SIZE;
+    UINT32          idx;
+    TRDP_ERR_T      err;
+    TRDP_ERR_T      result = TRDP_NO_ERR;
+
+    for (idx = 0u; idx < TRDP_PD_RCV_BATCH_SIZE; idx++)
+    {
+        msgs[idx].pBuffer   = (UINT8 *) appHandle->pRcvRing[idx];
+        msgs[idx].size      = TRDP_MAX_PD_PACKET_SIZE;
+    }
+
+    /*  Get the packets from the wire:  */
+    err = (TRDP_ERR_T) vos_sockReceiveUDPBatch(sock, msgs, &noOfMsgs);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+
+    /*  Dispatch them, the ring entries are exchanged with the subscriber's frames on update  */
+    for (idx = 0u; idx < noOfMsgs; idx++)
+    {
+        err = trdp_pdHandleFrame(appHandle, &appHandle->pRcvRing[idx], msgs[idx].size,
+                                 msgs[idx].srcIPAddr, msgs[idx].dstIPAddr);
+        if ((err != TRDP_NO_ERR) && (result == TRDP_NO_ERR))
+        {
+            result = err;
+        }
+    }
+    return result;
+}
+
 /******************************************************************************/
 /** Check for pending packets, set FD if non blocking
  *
  *  @param[in]      appHandle           session pointer
- *  @param[in,out]  pFileDesc           pointer to set of ready descriptors
+ *  @param[in,out]  pFileDesc           pointer to set of ready descriptors, NULL to compute nextJob only
  *  @param[in,out]  pNoDesc             pointer to number of ready descriptors
  *  @param[in]      checkSend           check send queue, too
  */
@@ -1127,7 +1548,8 @@ void trdp_pdCheckPending (
         }
 
         /*    Check and set the socket file descriptor, if not already done    */
-        if (iterPD->socketIdx != -1 &&
+        if ((pFileDesc != NULL) &&
+            iterPD->socketIdx != -1 &&
             appHandle->ifacePD[iterPD->socketIdx].sock != -1 &&
             !FD_ISSET(appHandle->ifacePD[iterPD->socketIdx].sock, (fd_set *)pFileDesc))     /*lint !e573 !e505
                                                                                           signed/unsigned division in macro /
@@ -1253,6 +1675,50 @@ void trdp_handleTimeout (
     }
 }
 
+/**********************************************************************************************************************/
+/** Receive from a readable PD socket
+ *  Reads as long as data is available (non-blocking), several frames per call, and calls the user's callbacks
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      idx                 index of the socket in ifacePD[]
+ *
+ *  @retval         TRDP_NO_ERR         no error (or nothing to read, no subscriber)
+ *  @retval         != TRDP_NO_ERR      error of trdp_pdReceiveBatch()
+ */
+TRDP_ERR_T trdp_pdReceiveSocket (
+    TRDP_SESSION_PT appHandle,
+    UINT32          idx)
+{
+    TRDP_ERR_T  err;
+    BOOL8       nonBlocking = !(appHandle->option & TRDP_OPTION_BLOCK);
+
+    /*  PD frame received? */
+    /*  Compare the received data to the data in our receive queue
+     Call user's callback if data changed    */
+
+    do
+    {
+        /* Read as long as data is available, several frames per call */
+        err = trdp_pdReceiveBatch(appHandle, appHandle->ifacePD[idx].sock);
+
+    }
+    while ((err == TRDP_NO_ERR) && (nonBlocking == TRUE));
+
+    switch (err)
+    {
+        case TRDP_NO_ERR:
+        case TRDP_NOSUB_ERR:        /* missing subscription should not lead to extensive error output */
+        case TRDP_BLOCK_ERR:
+        case TRDP_NODATA_ERR:       /* ignore would-block or sporadic unsolicited messages */
+            return TRDP_NO_ERR;
+        case TRDP_TOPO_ERR:
+        case TRDP_TIMEOUT_ERR:
+        default:
+            vos_printLog(VOS_LOG_WARNING, "trdp_pdReceive() failed (Err: %d)\n", err);
+            return err;
+    }
+}
+
 /**********************************************************************************************************************/
 /** Checking receive connection requests and data
  *  Call user's callback if needed
@@ -1284,7 +1750,6 @@ TRDP_ERR_T   trdp_pdCheckListenSocks (
          */
         UINT32      idx;
         TRDP_ERR_T  err;
-        BOOL8       nonBlocking = !(appHandle->option & TRDP_OPTION_BLOCK);
 
         /*    Check and set the socket file descriptor by going thru the socket list    */
         for (idx = 0; idx < (UINT32) trdp_getCurrentMaxSocketCnt(TRDP_SOCK_PD); idx++)
@@ -1293,34 +1758,10 @@ TRDP_ERR_T   trdp_pdCheckListenSocks (
                 (FD_ISSET(appHandle->ifacePD[idx].sock, (fd_set *) pRfds)))  /*lint !e573 signed/unsigned division in
                                                                                macro */
             {
-                VOS_LOG_T logType = VOS_LOG_ERROR;
-
-                /*  PD frame received? */
-                /*  Compare the received data to the data in our receive queue
-                 Call user's callback if data changed    */
-
-                do
-                {
-                    /* Read as long as data is available */
-                    err = trdp_pdReceive(appHandle, appHandle->ifacePD[idx].sock);
-
-                }
-                while ((err == TRDP_NO_ERR) && (nonBlocking == TRUE));
-
-                switch (err)
+                err = trdp_pdReceiveSocket(appHandle, idx);
+                if (err != TRDP_NO_ERR)
                 {
-                    case TRDP_NO_ERR:
-                    case TRDP_NOSUB_ERR:        /* missing subscription should not lead to extensive error output */
-                    case TRDP_BLOCK_ERR:
-                    case TRDP_NODATA_ERR:       /* ignore would-block or sporadic unsolicited messages */
-                        break;
-                    case TRDP_TOPO_ERR:
-                    case TRDP_TIMEOUT_ERR:
-                    default:
-                        result  = err;
-                        logType = VOS_LOG_WARNING;
-                        vos_printLog(logType, "trdp_pdReceive() failed (Err: %d)\n", err);
-                        break;
+                    result = err;
                 }
                 (*pCount)--;
                 FD_CLR(appHandle->ifacePD[idx].sock, (fd_set *)pRfds); /*lint !e502 !e573 !e505
@@ -17,6 +17,14 @@
 /*
 * $Id: trdp_pdcom.h 2092 2019-10-18 13:00:03Z bloehr $
 *
+*      AG 2026-10-17: trdp_pdReleaseRef() replaced by trdp_pdRecycleRef(), called under mutexRxPD
+*      AG 2026-10-17: Frame slab parameter for trdp_pdFreeRefFrames()
+*      AG 2026-10-17: trdp_pdReceiveSocket() added
+*      AG 2026-10-17: Session parameter for trdp_pdPut/PutBegin/PutCommit/ReleaseRef/FreeRefFrames (arena)
+*      AG 2026-10-17: trdp_pdPutBegin() and trdp_pdPutCommit() for zero-copy writing
+*      AG 2026-10-17: trdp_pdGetRef(), trdp_pdReleaseRef() and trdp_pdFreeRefFrames() for zero-copy reading
+*      AG 2026-10-17: Batched PD transmission (TRDP_PD_SND_BATCH_T, trdp_pdFlushBatch)
+*      AG 2026-10-17: trdp_pdReceiveBatch() added
 *      BL 2019-06-17: Ticket #264 Provide service oriented interface
 *      BL 2019-06-17: Ticket #162 Independent handling of PD and MD to reduce jitter
 *      BL 2019-06-17: Ticket #161 Increase performance
@@ -48,6 +56,13 @@
  * TYPEDEFS
  */
 
+/** Cyclic PD frames collected for a batched send */
+typedef struct
+{
+    UINT32      noOfFrames;                             /**< number of collected frames         */
+    PD_ELE_T    *pElement[TRDP_PD_SND_BATCH_SIZE];      /**< publishers with a frame to send    */
+} TRDP_PD_SND_BATCH_T;
+
 /*******************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -65,6 +80,7 @@ void        trdp_pdUpdate (
     PD_ELE_T *);
 
 TRDP_ERR_T  trdp_pdPut (
+    TRDP_SESSION_PT appHandle,
     PD_ELE_T *,
     TRDP_MARSHALL_T func,
     void            *refCon,
@@ -88,9 +104,40 @@ TRDP_ERR_T trdp_pdGet (
     const UINT8         *pData,
     UINT32              *pDataSize);
 
+TRDP_ERR_T trdp_pdPutBegin (
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            *pPacket,
+    UINT8               * *ppData,
+    UINT32              *pMaxSize);
+
+TRDP_ERR_T trdp_pdPutCommit (
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            *pPacket,
+    UINT32              dataSize);
+
+TRDP_ERR_T trdp_pdGetRef (
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            *pPacket,
+    const UINT8         * *ppData,
+    UINT32              *pDataSize);
+
+void trdp_pdRecycleRef (
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            *pPacket);
+
+void trdp_pdFreeRefFrames (
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            *pPacket,
+    TRDP_ARENA_SLAB_T   slab);
+
 TRDP_ERR_T  trdp_pdSendElement (
-    TRDP_SESSION_PT appHandle,
-    PD_ELE_T        * *ppElement);
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            * *ppElement,
+    TRDP_PD_SND_BATCH_T *pBatch);
+
+TRDP_ERR_T  trdp_pdFlushBatch (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_PD_SND_BATCH_T *pBatch);
 
 TRDP_ERR_T  trdp_pdSendQueued (
     TRDP_SESSION_PT appHandle);
@@ -110,6 +157,10 @@ TRDP_ERR_T  trdp_pdReceive (
     TRDP_SESSION_PT pSessionHandle,
     SOCKET          sock);
 
+TRDP_ERR_T  trdp_pdReceiveBatch (
+    TRDP_SESSION_PT pSessionHandle,
+    SOCKET          sock);
+
 void        trdp_pdCheckPending (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_FDS_T          *pFileDesc,
@@ -123,6 +174,10 @@ void        trdp_handleTimeout (
 void        trdp_pdHandleTimeOuts (
     TRDP_SESSION_PT appHandle);
 
+TRDP_ERR_T  trdp_pdReceiveSocket (
+    TRDP_SESSION_PT appHandle,
+    UINT32          idx);
+
 TRDP_ERR_T  trdp_pdCheckListenSocks (
     TRDP_SESSION_PT appHandle,
     TRDP_FDS_T      *pRfds,
@@ -17,6 +17,10 @@
 /*
  * $Id: trdp_pdindex.c 2206 2020-08-20 13:49:34Z bloehr $
  *
+ *      AG 2026-10-17: trdp_pdSendIndexed() sends frame by frame if pdSendSingle is set
+ *      AG 2026-10-17: Per-session timeout heap replaces the function statics of trdp_pdHandleTimeOutsIndexed()
+ *      AG 2026-10-17: Subscriptions are found via the hash index of the session, comId sorted table removed
+ *      AG 2026-10-17: trdp_pdSendIndexed() sends the frames of a slot in batches
  *      BL 2020-08-07: Ticket #317 Bug in trdp_indexedFindSubAddr() (HIGH_PERFORMANCE)
  *      BL 2020-08-06: Ticket #314 Timeout supervision does not restart after PD request
  *      BL 2020-07-15: Formatting (indenting)
@@ -121,24 +125,22 @@ static INLINE void setElement (
 
 #ifdef DEBUG
 /**********************************************************************************************************************/
-/** Print an index table
+/** Print the timeout heap
  *
  *  @param[in]      pRcvTable           pointer to the array
  *  @param[in]      noOfEntries         no of entries in the array
- *  @param[in]      label               Table's id
  *
  *  @retval         none
  */
 static void   print_rcv_tables (
-    PD_ELE_T    * *pRcvTable,
-    UINT32      noOfEntries,
-    const CHAR8 *label)
+    TRDP_HP_TO_ENTRY_T  *pRcvTable,
+    UINT32              noOfEntries)
 {
     UINT32 idx;
 
     vos_printLogStr(VOS_LOG_INFO, "-------------------------------------------------\n");
-    vos_printLog(VOS_LOG_INFO, "--- Table of %s-sorted subscriptions (%u) --\n",
-                 label, (unsigned int) noOfEntries);
+    vos_printLog(VOS_LOG_INFO, "--- Heap of supervised subscriptions (%u) --\n",
+                 (unsigned int) noOfEntries);
     vos_printLogStr(VOS_LOG_INFO, "- Idx\t(addr):\t\t\t  comId SrcIP\tTimeout(s)\n");
     vos_printLogStr(VOS_LOG_INFO, "-------------------------------------------------\n");
     for (idx = 0; idx < noOfEntries; idx++)
@@ -146,11 +148,11 @@ static void   print_rcv_tables (
 
         vos_printLog(VOS_LOG_INFO, "%3u\t(%p): %8u %-16s %u.%03u\n",
                      (unsigned int)idx,
-                     (void *)pRcvTable[idx],
-                     (unsigned int)pRcvTable[idx]->addr.comId,
-                     (char *)vos_ipDotted(pRcvTable[idx]->addr.srcIpAddr),
-                     (unsigned int)pRcvTable[idx]->interval.tv_sec,
-                     (unsigned int)pRcvTable[idx]->interval.tv_usec / 1000);
+                     (void *)pRcvTable[idx].pElement,
+                     (unsigned int)pRcvTable[idx].pElement->addr.comId,
+                     (char *)vos_ipDotted(pRcvTable[idx].pElement->addr.srcIpAddr),
+                     (unsigned int)pRcvTable[idx].pElement->interval.tv_sec,
+                     (unsigned int)pRcvTable[idx].pElement->interval.tv_usec / 1000);
     }
     vos_printLogStr(VOS_LOG_INFO, "-------------------------------------------------\n");
 }
@@ -489,40 +491,67 @@ static TRDP_ERR_T indexCreatePubTable (
 }
 
 /**********************************************************************************************************************/
-/** Sort/Find by comId
+/** Move a timeout heap entry towards the root until its parent is not later
  *
- *  @param[in]      pPDElement1         pointer to first element
- *  @param[in]      pPDElement2         pointer to second element
+ *  @param[in]      pHeap               pointer to the heap array
+ *  @param[in]      idx                 index of the entry
  */
-static int compareComIds (const void *pPDElement1, const void *pPDElement2)
+static void toHeapUp (
+    TRDP_HP_TO_ENTRY_T  *pHeap,
+    UINT32              idx)
 {
-    const PD_ELE_T  *p1 = *(const PD_ELE_T * *)pPDElement1;
-    const PD_ELE_T  *p2 = *(const PD_ELE_T * *)pPDElement2;
+    TRDP_HP_TO_ENTRY_T entry = pHeap[idx];
 
-    if (p1->addr.comId > p2->addr.comId)
-    {
-        return 1;
-    }
-    else if (p1->addr.comId < p2->addr.comId)
+    while (idx > 0u)
     {
-        return -1;
+        UINT32 parent = (idx - 1u) / 2u;
+
+        if (!timercmp(&entry.timeToCheck, &pHeap[parent].timeToCheck, <))
+        {
+            break;
+        }
+        pHeap[idx]  = pHeap[parent];
+        idx         = parent;
     }
-    return 0;
+    pHeap[idx] = entry;
 }
 
 /**********************************************************************************************************************/
-/** Sort by timeout
+/** Move a timeout heap entry towards the leaves until no child is earlier
  *
- *  @param[in]      pPDElement1         pointer to first element
- *  @param[in]      pPDElement2         pointer to second element
+ *  @param[in]      pHeap               pointer to the heap array
+ *  @param[in]      noOfEntries         no of entries in the heap
+ *  @param[in]      idx                 index of the entry
  */
-static int compareTimeouts (const void *pPDElement1, const void *pPDElement2)
+static void toHeapDown (
+    TRDP_HP_TO_ENTRY_T  *pHeap,
+    UINT32              noOfEntries,
+    UINT32              idx)
 {
-    const PD_ELE_T  *p1 = *(const PD_ELE_T * *)pPDElement1;
-    const PD_ELE_T  *p2 = *(const PD_ELE_T * *)pPDElement2;
-    return vos_cmpTime(&p1->interval, &p2->interval);
-}
+    TRDP_HP_TO_ENTRY_T entry = pHeap[idx];
 
+    for (;; )
+    {
+        UINT32 child = 2u * idx + 1u;
+
+        if (child >= noOfEntries)
+        {
+            break;
+        }
+        if (((child + 1u) < noOfEntries) &&
+            timercmp(&pHeap[child + 1u].timeToCheck, &pHeap[child].timeToCheck, <))
+        {
+            child++;
+        }
+        if (!timercmp(&pHeap[child].timeToCheck, &entry.timeToCheck, <))
+        {
+            break;
+        }
+        pHeap[idx]  = pHeap[child];
+        idx         = child;
+    }
+    pHeap[idx] = entry;
+}
 
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
@@ -583,10 +612,6 @@ void trdp_indexDeInit (TRDP_SESSION_PT appHandle)
         {
             vos_memFree(appHandle->pSlot->highCat.ppIdxCat);
         }
-        if (appHandle->pSlot->pRcvTableComId != NULL)
-        {
-            vos_memFree(appHandle->pSlot->pRcvTableComId);
-        }
         if (appHandle->pSlot->pRcvTableTimeOut != NULL)
         {
             vos_memFree(appHandle->pSlot->pRcvTableTimeOut);
@@ -669,21 +694,12 @@ TRDP_ERR_T  trdp_indexAllocTables (
 
     /* get some memory for the receive index tables */
 
-    appHandle->pSlot->allocatedRcvTableSize = maxNoOfSubscriptions * sizeof(PD_ELE_T * *);
-    appHandle->pSlot->pRcvTableComId        = (PD_ELE_T * *) vos_memAlloc(appHandle->pSlot->allocatedRcvTableSize);
-
-    if (appHandle->pSlot->pRcvTableComId == NULL)
-    {
-        appHandle->pSlot->allocatedRcvTableSize = 0u;
-        return TRDP_MEM_ERR;
-    }
-
-    appHandle->pSlot->pRcvTableTimeOut = (PD_ELE_T * *) vos_memAlloc(appHandle->pSlot->allocatedRcvTableSize);
+    appHandle->pSlot->allocatedRcvTableSize = maxNoOfSubscriptions * sizeof(TRDP_HP_TO_ENTRY_T);
+    appHandle->pSlot->pRcvTableTimeOut      =
+        (TRDP_HP_TO_ENTRY_T *) vos_memAlloc(appHandle->pSlot->allocatedRcvTableSize);
 
     if (appHandle->pSlot->pRcvTableTimeOut == NULL)
     {
-        vos_memFree(appHandle->pSlot->pRcvTableComId);
-        appHandle->pSlot->pRcvTableComId        = NULL;
         appHandle->pSlot->allocatedRcvTableSize = 0u;
         return TRDP_MEM_ERR;
     }
@@ -996,59 +1012,36 @@ TRDP_ERR_T trdp_indexCreatePubTables (TRDP_SESSION_PT appHandle)
  */
 void  trdp_pdHandleTimeOutsIndexed (TRDP_SESSION_PT appHandle)
 {
-    UINT32 idx, idxMax;
-    TRDP_TIME_T now, interval;
-    PD_ELE_T * *pElement;
-    static TRDP_TIME_T  lastCall = {0, 0};
-    static TRDP_TIME_T  cumulatedCallTime = {0, 0};
+    TRDP_HP_SLOTS_T     *pSlot  = appHandle->pSlot;
+    TRDP_HP_TO_ENTRY_T  *pHeap  = pSlot->pRcvTableTimeOut;
+    TRDP_TIME_T         now;
 
     vos_getTime(&now);
 
-    if (timerisset(&lastCall) != 0) /* On first run we do nothing but set lastCall to now */
+    /* Visit only the subscriptions which are due. A received packet moves timeToGo without touching the heap,
+       the entry is corrected when it comes due. */
+    while ((pSlot->noOfRxEntries > 0u) &&
+           !timercmp(&pHeap[0].timeToCheck, &now, >))
     {
-        /* determine the time since last call  */
-        interval = now;
-        vos_subTime(&interval, &lastCall);
-
-        /* sum up our execution time */
-        vos_addTime(&cumulatedCallTime, &interval);
-
-        /* determine which time slot we should search */
-        /* interval_ms = interval.tv_usec / 1000 + interval.tv_sec * 1000u; */
+        PD_ELE_T *pElement = pHeap[0].pElement;
 
-        pElement    = (PD_ELE_T * *) appHandle->pSlot->pRcvTableTimeOut;
-        idxMax      = appHandle->pSlot->noOfRxEntries;
-
-        /* we need to check the first, fastest intervals each time we are called */
-        for (idx = 0;
-             (idx < idxMax) &&
-             timercmp(&(pElement[idx]->interval), &interval, < );
-             idx++)
+        if (timerisset(&pElement->timeToGo) &&
+            timercmp(&pElement->timeToGo, &now, >))
         {
-            if (timercmp(&(pElement[idx]->timeToGo), &now, <))
-            {
-                trdp_handleTimeout(appHandle, pElement[idx]);
-            }
+            /* not late, received in the meantime */
+            pHeap[0].timeToCheck = pElement->timeToGo;
         }
-
-        /* every TRDP_TO_CHECK_CYCLE (default 100ms) check for other timeouts */
-        if ((cumulatedCallTime.tv_usec > TRDP_TO_CHECK_CYCLE) || (cumulatedCallTime.tv_sec != 0))
+        else
         {
-            for (;
-                 idx < idxMax;
-                 idx++)
-            {
-                /* we check only briefly, complete check is done inside trdp_handleTimeout */
-                if (timercmp(&(pElement[idx]->timeToGo), &now, <))
-                {
-                    trdp_handleTimeout(appHandle, pElement[idx]);
-                }
-            }
-            /* Reset the cumulated time */
-            timerclear(&cumulatedCallTime);
+            /* complete check is done inside trdp_handleTimeout */
+            trdp_handleTimeout(appHandle, pElement);
+
+            /* check again one interval later, a packet received until then will postpone this */
+            pHeap[0].timeToCheck = now;
+            vos_addTime(&pHeap[0].timeToCheck, &pElement->interval);
         }
+        toHeapDown(pHeap, pSlot->noOfRxEntries, 0u);
     }
-    lastCall = now;
 }
 
 /**********************************************************************************************************************/
@@ -1072,12 +1065,16 @@ TRDP_ERR_T trdp_pdSendIndexed (TRDP_SESSION_PT appHandle)
     TRDP_HP_SLOTS_T *pSlot = appHandle->pSlot;
     PD_ELE_T        *pCurElement;
     UINT32          i;
+    TRDP_PD_SND_BATCH_T batch;
+    TRDP_PD_SND_BATCH_T *pBatch = (appHandle->pdSendSingle == TRUE) ? NULL : &batch;
 
     if (appHandle->pSlot == NULL)
     {
         return TRDP_BLOCK_ERR;
     }
 
+    batch.noOfFrames = 0u;
+
 
     /* In case we are called less often than 1ms, we'll loop over the index table */
     for (i = 0u; i < pSlot->processCycle; i += TRDP_MIN_CYCLE)
@@ -1095,7 +1092,7 @@ TRDP_ERR_T trdp_pdSendIndexed (TRDP_SESSION_PT appHandle)
             {
                 break;
             }
-            err = trdp_pdSendElement(appHandle, &pCurElement);
+            err = trdp_pdSendElement(appHandle, &pCurElement, pBatch);
             if (err != TRDP_NO_ERR)
             {
                 result = err;   /* return first error, only. Keep on sending... */
@@ -1114,7 +1111,7 @@ TRDP_ERR_T trdp_pdSendIndexed (TRDP_SESSION_PT appHandle)
                 {
                     break;
                 }
-                err = trdp_pdSendElement(appHandle, &pCurElement);
+                err = trdp_pdSendElement(appHandle, &pCurElement, pBatch);
                 if (err != TRDP_NO_ERR)
                 {
                     result = err;   /* return first error, only. Keep on sending... */
@@ -1129,7 +1126,7 @@ TRDP_ERR_T trdp_pdSendIndexed (TRDP_SESSION_PT appHandle)
             {
                 /* Defensive programming: Prohibit endless loop! */
                 PD_ELE_T *pBefore = appHandle->pSndQueue;
-                err = trdp_pdSendElement(appHandle, &appHandle->pSndQueue);
+                err = trdp_pdSendElement(appHandle, &appHandle->pSndQueue, NULL);
                 if (err != TRDP_NO_ERR)
                 {
                     result = err;   /* return first error, only. Keep on sending... */
@@ -1152,7 +1149,7 @@ TRDP_ERR_T trdp_pdSendIndexed (TRDP_SESSION_PT appHandle)
                 {
                     break;
                 }
-                err = trdp_pdSendElement(appHandle, &pCurElement);
+                err = trdp_pdSendElement(appHandle, &pCurElement, pBatch);
                 if (err != TRDP_NO_ERR)
                 {
                     result = err;   /* return first error, only. Keep on sending... */
@@ -1173,11 +1170,17 @@ TRDP_ERR_T trdp_pdSendIndexed (TRDP_SESSION_PT appHandle)
                         /*  Set timer if interval was set.                     */
                         vos_addTime(&pSlot->pExtTxTable[depth]->timeToGo,
                                     &pSlot->pExtTxTable[depth]->interval);
-                        (void) trdp_pdSendElement(appHandle, &pSlot->pExtTxTable[depth]);
+                        (void) trdp_pdSendElement(appHandle, &pSlot->pExtTxTable[depth], pBatch);
                     }
                 }
             }
         }
+        /* Send out what has been collected in this cycle */
+        err = trdp_pdFlushBatch(appHandle, pBatch);
+        if ((err != TRDP_NO_ERR) && (result == TRDP_NO_ERR))
+        {
+            result = err;
+        }
         /* We count the numbers of cycles, an overflow does not matter! */
         pSlot->currentCycle += TRDP_MIN_CYCLE;
         if (pSlot->currentCycle >= (pSlot->highCat.noOfTxEntries * pSlot->highCat.slotCycle))
@@ -1219,24 +1222,22 @@ TRDP_ERR_T trdp_indexCreateSubTables (TRDP_SESSION_PT appHandle)
     {
         UINT32      noOfSubs    = 0, idx = 0;
         PD_ELE_T    *iterPD     = appHandle->pRcvQueue;
+        TRDP_TIME_T now;
         while (iterPD)
         {
             noOfSubs++;
             iterPD = iterPD->pNext;
         }
+        pSlot->noOfRxEntries = 0u;
         if (noOfSubs == 0)
         {
             return err;
         }
 
         /* Check the index tables if they still fit: */
-        if ((pSlot->allocatedRcvTableSize / sizeof(PD_ELE_T * *)) < noOfSubs)
+        if ((pSlot->allocatedRcvTableSize / sizeof(TRDP_HP_TO_ENTRY_T)) < noOfSubs)
         {
             /* There are more subscribers now!  */
-            if (pSlot->pRcvTableComId != NULL)
-            {
-                vos_memFree(pSlot->pRcvTableComId);
-            }
             if (pSlot->pRcvTableTimeOut != NULL)
             {
                 vos_memFree(pSlot->pRcvTableTimeOut);
@@ -1246,104 +1247,49 @@ TRDP_ERR_T trdp_indexCreateSubTables (TRDP_SESSION_PT appHandle)
 
             /* re-alloc the table memory */
 
-            pSlot->pRcvTableComId = (PD_ELE_T * *) vos_memAlloc(noOfSubs * sizeof(PD_ELE_T * *));
-            if (pSlot->pRcvTableComId == NULL)
-            {
-                return TRDP_MEM_ERR;
-            }
-
-            pSlot->pRcvTableTimeOut = (PD_ELE_T * *) vos_memAlloc(noOfSubs * sizeof(PD_ELE_T * *));
+            pSlot->pRcvTableTimeOut = (TRDP_HP_TO_ENTRY_T *) vos_memAlloc(noOfSubs * sizeof(TRDP_HP_TO_ENTRY_T));
             if (pSlot->pRcvTableTimeOut == NULL)
             {
-                vos_memFree(pSlot->pRcvTableComId);
-                pSlot->pRcvTableComId = NULL;
                 return TRDP_MEM_ERR;
             }
             vos_printLog(VOS_LOG_WARNING,
                          "Pre-allocated receiver table size was not sufficent, enlarge no of subs! (%u < %u)\n",
-                         (unsigned int) (pSlot->allocatedRcvTableSize / sizeof(PD_ELE_T * *)),
+                         (unsigned int) (pSlot->allocatedRcvTableSize / sizeof(TRDP_HP_TO_ENTRY_T)),
                          (unsigned int) noOfSubs);
-            pSlot->allocatedRcvTableSize = noOfSubs * sizeof(PD_ELE_T * *);
+            pSlot->allocatedRcvTableSize = noOfSubs * sizeof(TRDP_HP_TO_ENTRY_T);
         }
-        /* fill the arrays ... */
-        pSlot->noOfRxEntries = noOfSubs;
-        iterPD = appHandle->pRcvQueue;
 
-        /* ...by copying the PD element pointers first */
-        while ((iterPD != NULL) &&
-               (idx < noOfSubs))
+        /* fill the heap with the subscriptions to supervise (infinite timeouts are not) */
+        vos_getTime(&now);
+        for (iterPD = appHandle->pRcvQueue; (iterPD != NULL) && (idx < noOfSubs); iterPD = iterPD->pNext)
         {
-            pSlot->pRcvTableComId[idx]      = iterPD;
-            pSlot->pRcvTableTimeOut[idx++]  = iterPD;
-            iterPD = iterPD->pNext;
-        }
-
-        vos_printLog(VOS_LOG_DBG, "Sorting array at %p.\n", (void *) pSlot->pRcvTableComId);
-
-        /* sort the table on comIds */
-        vos_qsort(pSlot->pRcvTableComId, noOfSubs, sizeof(PD_ELE_T *), compareComIds);
-
-        vos_printLog(VOS_LOG_DBG, "Sorting array at %p.\n", (void *) pSlot->pRcvTableTimeOut);
+            if (timerisset(&iterPD->interval))
+            {
+                TRDP_HP_TO_ENTRY_T *pEntry = &pSlot->pRcvTableTimeOut[idx];
 
-        /* sort the table on interval (aka timeout) */
-        vos_qsort(pSlot->pRcvTableTimeOut, noOfSubs, sizeof(PD_ELE_T *), compareTimeouts);
+                pEntry->pElement = iterPD;
+                if (timerisset(&iterPD->timeToGo))
+                {
+                    pEntry->timeToCheck = iterPD->timeToGo;
+                }
+                else
+                {
+                    pEntry->timeToCheck = now;
+                    vos_addTime(&pEntry->timeToCheck, &iterPD->interval);
+                }
+                toHeapUp(pSlot->pRcvTableTimeOut, idx);
+                idx++;
+            }
+        }
+        pSlot->noOfRxEntries = idx;
 
 #ifdef DEBUG
-        print_rcv_tables(pSlot->pRcvTableComId, pSlot->noOfRxEntries, "ComId");
-        print_rcv_tables(pSlot->pRcvTableTimeOut, pSlot->noOfRxEntries, "Timeout");
+        print_rcv_tables(pSlot->pRcvTableTimeOut, pSlot->noOfRxEntries);
 #endif
     }
     return err;
 }
 
-/**********************************************************************************************************************/
-/** Return the element (subscription) with same comId and IP addresses
- *  This search is done for every received packet
- *
- *  @param[in]      appHandle       pointer to head of queue
- *  @param[in]      pAddr           Pub/Sub handle (Address, ComID, srcIP & dest IP, serviceId) to search for
- *
- *  @retval         != NULL         pointer to PD element
- *  @retval         NULL            No PD element found
- */
-PD_ELE_T *trdp_indexedFindSubAddr (
-    TRDP_SESSION_PT     appHandle,
-    TRDP_ADDRESSES_T    *pAddr)
-{
-    PD_ELE_T    matchKey;
-    PD_ELE_T    * *pFirstMatchedPD = (PD_ELE_T * *) &matchKey;
-    matchKey.addr   = *pAddr;
-    matchKey.magic  = TRDP_MAGIC_SUB_HNDL_VALUE;
-
-    if ((appHandle->pSlot == NULL) || (appHandle->pSlot->pRcvTableComId == NULL))
-    {
-        return NULL;
-    }
-
-    pFirstMatchedPD = (PD_ELE_T * *) vos_bsearch(&pFirstMatchedPD, appHandle->pSlot->pRcvTableComId,
-                                                 appHandle->pSlot->noOfRxEntries, sizeof(PD_ELE_T *), compareComIds);
-    /* The found hit might not be the very first (because of binary search) */
-    if (pFirstMatchedPD)
-    {
-        UINT32  startIdx;
-
-        /* We go back as long comId matches */
-        while ((pFirstMatchedPD != appHandle->pSlot->pRcvTableComId) &&
-               ((*(pFirstMatchedPD - 1))->addr.comId == pAddr->comId))
-        {
-            pFirstMatchedPD--;
-        }
-        /* the first match might not be the best! Look further, but stop on comId change */
-        /* was: return trdp_findSubAddr(*pFirstMatchedPD, pAddr, pAddr->comId);  Ticket #317*/
-        startIdx = (UINT32)(pFirstMatchedPD - appHandle->pSlot->pRcvTableComId);
-        /*startIdx /= sizeof(PD_ELE_T *); */
-        return trdp_idxfindSubAddr(appHandle->pSlot->pRcvTableComId,
-                                   startIdx, appHandle->pSlot->noOfRxEntries,
-                                   pAddr, pAddr->comId);
-    }
-    return NULL;
-}
-
 /******************************************************************************/
 /** Check for pending packets, set FD if non blocking
  *
@@ -1357,8 +1303,8 @@ void trdp_indexCheckPending (
     TRDP_FDS_T          *pFileDesc,
     INT32               *pNoDesc)
 {
-    PD_ELE_T    * *iterPD;
     UINT32      idx;
+    TRDP_TIME_T now;
     TRDP_TIME_T delay = {0u, 10000};     /* This determines the max. delay to report a timeout, 10ms should be OK */
 
     if ((appHandle->pSlot == NULL) || (appHandle->pSlot->pRcvTableTimeOut == NULL))
@@ -1366,20 +1312,23 @@ void trdp_indexCheckPending (
         return;
     }
 
-    iterPD = appHandle->pSlot->pRcvTableTimeOut;
+    vos_getTime(&now);
 
-    /*    Find the first packet with a non-zero timeout value; we search the ordered list and
-     stop at the first non-zero PD Element (usually the first) */
-    for (idx = 0; idx < appHandle->pSlot->noOfRxEntries; idx++)
+    /*    The root of the heap is the next subscription to check */
+    if (appHandle->pSlot->noOfRxEntries > 0u)
     {
-        if (timerisset(&iterPD[idx]->interval))
+        delay = appHandle->pSlot->pRcvTableTimeOut[0].timeToCheck;
+        if (timercmp(&delay, &now, >))
         {
-            delay = iterPD[idx]->interval;
-            break;
+            vos_subTime(&delay, &now);
+        }
+        else
+        {
+            vos_clearTime(&delay);
         }
     }
-    /*    Get the current time and add the found interval to nextjob  */
-    vos_getTime(&appHandle->nextJob);
+    /*    Add the found interval to nextjob  */
+    appHandle->nextJob = now;
     vos_addTime(&appHandle->nextJob, &delay);
 
     /* Return the interval for select() directly */
@@ -17,6 +17,8 @@
 /*
  * $Id: trdp_pdindex.h 2206 2020-08-20 13:49:34Z bloehr $
  *
+ *      AG 2026-10-17: Timeout supervision by a per-session min-heap (TRDP_HP_TO_ENTRY_T), TRDP_TO_CHECK_CYCLE removed
+ *      AG 2026-10-17: pRcvTableComId removed, subscriptions are found via the hash index of the session
  *      BL 2020-08-06: Ticket #314 Timeout supervision does not restart after PD request
  *      BL 2019-10-15: Ticket #282 Preset index table size and depth to prevent memory fragmentation
  *      BL 2019-07-10: Ticket #162 Independent handling of PD and MD to reduce jitter
@@ -55,10 +57,6 @@
 #define TRDP_MID_CYCLE_LIMIT    1000000                 /**< 101ms...1000ms   */
 #define TRDP_HIGH_CYCLE_LIMIT   10000000                /**< over 1000ms         */
 
-#ifndef TRDP_TO_CHECK_CYCLE
-#define TRDP_TO_CHECK_CYCLE     100000                  /* default 100ms      */
-#endif
-
 /** Default table size settings in HIGH_PERF_INDEXED Mode  */
 #define TRDP_DEFAULT_INDEX_SIZES  {100,     /**< Max. number of expected subscriptions with intervals <= 100ms  */ \
                                    200,     /**< Max. number of expected subscriptions with intervals <= 1000ms */ \
@@ -92,6 +90,13 @@ typedef struct hp_slot
 
 typedef PD_ELE_T *(PD_ELE_ARRAY_T[]);
 
+/** Entry of the timeout heap, the subscription cannot time out before timeToCheck */
+typedef struct hp_to_entry
+{
+    TRDP_TIME_T     timeToCheck;                        /**< next time the subscription must be checked             */
+    PD_ELE_T        *pElement;                          /**< the subscription                                       */
+} TRDP_HP_TO_ENTRY_T;
+
 /** entry for the application session */
 typedef struct hp_slots
 {
@@ -102,9 +107,8 @@ typedef struct hp_slots
     TRDP_HP_CAT_SLOT_T  midCat;                         /**< array dim[slot][depth]          */
     TRDP_HP_CAT_SLOT_T  highCat;                        /**< array dim[slot][depth]          */
 
-    UINT32              noOfRxEntries;                  /**< number of subscribed PDs to be handled             */
-    PD_ELE_T            * *pRcvTableComId;              /**< Pointer to sorted array of PDs to be handled       */
-    PD_ELE_T            * *pRcvTableTimeOut;            /**< Pointer to sorted array of PDs to be handled       */
+    UINT32              noOfRxEntries;                  /**< number of supervised subscriptions in the heap     */
+    TRDP_HP_TO_ENTRY_T  *pRcvTableTimeOut;              /**< min-heap of subscriptions on timeToCheck           */
     UINT32              allocatedRcvTableSize;          /**< real allocated size                                */
     UINT8               noOfExtTxEntries;               /**< number of 'special' PDs to be handled              */
     PD_ELE_T            * *pExtTxTable;                 /**< Pointer to array of PDs to be handled              */
@@ -135,9 +139,6 @@ void        trdp_queueInsThroughputAccending (PD_ELE_T  * *ppHead,
 TRDP_ERR_T  trdp_pdSendIndexed (TRDP_SESSION_PT appHandle);
 void        trdp_pdHandleTimeOutsIndexed (TRDP_SESSION_PT appHandle);
 
-PD_ELE_T    *trdp_indexedFindSubAddr (TRDP_SESSION_PT   appHandle,
-                                      TRDP_ADDRESSES_T  *pAddr);
-
 TRDP_ERR_T  trdp_indexCreatePubTables (TRDP_SESSION_PT appHandle);
 TRDP_ERR_T  trdp_indexCreateSubTables (TRDP_SESSION_PT appHandle);
 void        trdp_indexCheckPending (TRDP_APP_SESSION_T  appHandle,
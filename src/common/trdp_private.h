@@ -17,6 +17,27 @@
 /*
  * $Id: trdp_private.h 2219 2020-08-25 10:04:10Z bloehr $
  *
+ *      AG 2026-10-17: TRDP_SEQ_CNT_LIST_T: clock hand and referenced flag replace the LRU counters
+ *      AG 2026-10-17: shared in TRDP_SOCKET_TCP_T
+ *      AG 2026-10-17: Arena slabs per owning mutex and for full size sequence counter lists, no arena mutex
+ *      AG 2026-10-17: numEvicted in TRDP_SEQ_CNT_LIST_T
+ *      AG 2026-10-17: pdSendSingle in TRDP_SESSION_T to compare indexed sending with and without batches
+ *      AG 2026-10-17: pSrvCache, service cache of tau_so_if
+ *      AG 2026-10-17: Sequence counter table (TRDP_SEQ_CNT_LIST_T) open addressed on (srcIP, msgType) with LRU eviction
+ *      AG 2026-10-17: Send queue per TCP connection (TRDP_TCP_SND_T) replaces notSend/msgUncomplete
+ *      AG 2026-10-17: Poll set of tlc_processEvents() in the session, registered socket per pool entry
+ *      AG 2026-10-17: Receive buffer per TCP connection (TRDP_TCP_RCV_T) replaces uncompletedTCP[]
+ *      AG 2026-10-17: Timer wheel and ready list of the MD sessions (TRDP_MD_TIMER_T)
+ *      AG 2026-10-17: comId/URI index of the MD listeners (TRDP_MD_LIS_INDEX_T)
+ *      AG 2026-10-17: SessionID index of the MD queues (TRDP_MD_SID_INDEX_T)
+ *      AG 2026-10-17: Session arena (TRDP_ARENA_T), hot fields of PD_ELE_T moved to the front
+ *      AG 2026-10-17: srmAddr, SRM addresses resolved without blocking by tau_so_if
+ *      AG 2026-10-17: refReleased: tlp_releaseRef() without mutex, TRDP_REF_SET_RELEASED()
+ *      AG 2026-10-17: pRefFrame/pSpareFrame also used by tlp_putBegin()/tlp_putCommit(), TRDP_MAX_FRAME
+ *      AG 2026-10-17: pRefFrame/pSpareFrame in PD_ELE_T for tlp_getRef()/tlp_releaseRef()
+ *      AG 2026-10-17: Hash index of PD subscriptions (TRDP_SUB_INDEX_T)
+ *      AG 2026-10-17: TRDP_PD_SND_BATCH_SIZE for batched PD transmission
+ *      AG 2026-10-17: Ring of PD receive buffers for batched reception added to TRDP_SESSION_T
  *      BL 2020-07-10: Ticket #321 Move TRDP_TIMER_GRANULARITY to public API
  *      CK 2020-04-06: Ticket #318 Added pointer to list of seqCnt used per comId for PD Requests in TRDP_SESSION_T
  *      SB 2020-03-30: Ticket #309 Added pointer to a Session's Listener
@@ -101,7 +122,61 @@
 #define TRDP_MAGIC_PUB_HNDL_VALUE       0xCAFEBABEu
 #define TRDP_MAGIC_SUB_HNDL_VALUE       0xBABECAFEu
 
-#define TRDP_SEQ_CNT_START_ARRAY_SIZE   64u                         /**< This should be enough for the start          */
+#define TRDP_SEQ_CNT_START_ARRAY_SIZE   64u                         /**< Initial no. of slots per subscription (2^n)  */
+#ifndef TRDP_SEQ_CNT_MAX_ARRAY_SIZE
+#define TRDP_SEQ_CNT_MAX_ARRAY_SIZE     1024u                       /**< Max. no. of slots, then senders are evicted  */
+#endif
+
+/* tlp_releaseRef() hands a frame back without mutexRxPD, the receiver recycles it under the mutex */
+#if defined(__GNUC__) && !defined(VOS_NO_ATOMICS)
+#define TRDP_REF_LOCK_FREE
+#define TRDP_REF_SET_RELEASED(p)    __atomic_store_n(&(p)->refReleased, 1u, __ATOMIC_RELEASE)
+#define TRDP_REF_IS_RELEASED(p)     __atomic_load_n(&(p)->refReleased, __ATOMIC_ACQUIRE)
+#else
+#define TRDP_REF_SET_RELEASED(p)    ((p)->refReleased = 1u)
+#define TRDP_REF_IS_RELEASED(p)     ((p)->refReleased)
+#endif
+
+#ifndef TRDP_PD_RCV_BATCH_SIZE
+#define TRDP_PD_RCV_BATCH_SIZE          VOS_MAX_SOCK_BATCH          /**< No. of PD frames read by one socket call     */
+#endif
+
+#ifndef TRDP_SUB_INDEX_MIN_SIZE
+#define TRDP_SUB_INDEX_MIN_SIZE         64u                         /**< Initial no. of slots of the subscriber index */
+#endif
+
+#ifndef TRDP_MD_SID_INDEX_MIN_SIZE
+#define TRDP_MD_SID_INDEX_MIN_SIZE      64u                         /**< Initial no. of buckets of the sessionID index */
+#endif
+
+#ifndef TRDP_MD_LIS_INDEX_MIN_SIZE
+#define TRDP_MD_LIS_INDEX_MIN_SIZE      64u                         /**< Initial no. of buckets of the listener index */
+#endif
+
+#ifndef TRDP_MD_TIMER_TICK
+#define TRDP_MD_TIMER_TICK              1000u                       /**< [us] resolution of the MD timer wheel        */
+#endif
+
+#define TRDP_MD_TIMER_SLOT_BITS         6u                          /**< 64 slots per level of the MD timer wheel     */
+#define TRDP_MD_TIMER_SLOTS             (1u << TRDP_MD_TIMER_SLOT_BITS)
+
+#ifndef TRDP_MD_TCP_RCV_SIZE
+#define TRDP_MD_TCP_RCV_SIZE            16384u                      /**< Receive buffer of a TCP connection, larger
+                                                                         frames are read into their packet directly */
+#endif
+
+#ifndef TRDP_MD_TCP_SND_SIZE
+#define TRDP_MD_TCP_SND_SIZE            65536u                      /**< Send queue limit of a TCP connection, must
+                                                                         hold a frame of TRDP_MAX_MD_PACKET_SIZE      */
+#endif
+
+#ifndef TRDP_MD_TCP_SND_FRAMES
+#define TRDP_MD_TCP_SND_FRAMES          64u                         /**< Max. no. of frames gathered for one send     */
+#endif
+
+#ifndef TRDP_PD_SND_BATCH_SIZE
+#define TRDP_PD_SND_BATCH_SIZE          VOS_MAX_SOCK_BATCH          /**< No. of PD frames sent by one socket call     */
+#endif
 
 #define TRDP_IF_WAIT_FOR_READY          120u        /**< 120 seconds (120 tries each second to bind to an IP address) */
 
@@ -146,7 +221,7 @@ typedef enum
 #define TRDP_TIMED_OUT      0x2u            /**< if set, inform the user                                */
 #define TRDP_INVALID_DATA   0x4u            /**< if set, inform the user                                */
 #define TRDP_REQ_2B_SENT    0x8u            /**< if set, the request needs to be sent                   */
-                                            /* TRDP_PULL_SUB removed, was unused */
+#define TRDP_MAX_FRAME      0x10u           /**< if set, pFrame can hold TRDP_MAX_PD_DATA_SIZE (tlp_putCommit)  */
 #define TRDP_REDUNDANT      0x20u           /**< if set, packet should not be sent (redundant)          */
 #define TRDP_CHECK_COMID    0x40u           /**< if set, do filter comId (addListener)                  */
 #define TRDP_IS_TSN         0x80u           /**< if set, PD will be sent on trdp_put() only             */
@@ -181,14 +256,18 @@ typedef struct
 {
     UINT32          lastSeqCnt;                         /**< Sequence counter value for comId           */
     TRDP_IP_ADDR_T  srcIpAddr;                          /**< Source IP address                          */
-    TRDP_MSG_T      msgType;                            /**< message type                               */
+    TRDP_MSG_T      msgType;                            /**< message type, 0 for a free slot            */
+    BOOL8           referenced;                         /**< received since the clock hand passed       */
 } TRDP_SEQ_CNT_ENTRY_T;
 
+/** Open addressed table of the senders of a subscription, keyed on (srcIpAddr, msgType) */
 typedef struct
 {
-    UINT16                  maxNoOfEntries;             /**< Max. no of entries the seq[] can hold      */
-    UINT16                  curNoOfEntries;             /**< Current no of entries in array             */
-    TRDP_SEQ_CNT_ENTRY_T    seq[1];                     /**< list of used sequence no.                  */
+    UINT16                  maxNoOfEntries;             /**< No. of slots of seq[] (power of 2)         */
+    UINT16                  curNoOfEntries;             /**< No. of used slots                          */
+    UINT32                  hand;                       /**< clock hand, next slot to check for eviction */
+    UINT32                  numEvicted;                 /**< senders dropped for new ones               */
+    TRDP_SEQ_CNT_ENTRY_T    seq[1];                     /**< slots, at most half of them used           */
 } TRDP_SEQ_CNT_LIST_T;
 
 /** Tuple of last used sequence counter for PD Request (PR) per comId  */
@@ -203,12 +282,14 @@ typedef struct TRDP_PR_SEQ_CNT_ELE
 typedef struct TRDP_SOCKET_TCP
 {
     TRDP_IP_ADDR_T  cornerIp;                           /**< The other TCP corner Ip                      */
-    BOOL8           notSend;                            /**< If the message has been sent uncompleted     */
     TRDP_TIME_T     connectionTimeout;                  /**< TCP socket connection Timeout                */
     BOOL8           sendNotOk;                          /**< The sending timeout will be start            */
     TRDP_TIME_T     sendingTimeout;                     /**< The timeout sending the message              */
     BOOL8           addFileDesc;                        /**< Ready to add the socket in the fd            */
     BOOL8           morituri;                           /**< about to die                                 */
+    BOOL8           shared;                             /**< may take further sender sessions (shareTcp)  */
+    struct TRDP_TCP_RCV *pRcv;                          /**< receive buffer, allocated on first receive   */
+    struct TRDP_TCP_SND *pSnd;                          /**< send queue, allocated on first send          */
 } TRDP_SOCKET_TCP_T;
 
 
@@ -224,6 +305,8 @@ typedef struct TRDP_SOCKETS
     INT16               usage;                           /**< No. of current users of this socket         */
     TRDP_SOCKET_TCP_T   tcpParams;                       /**< Params used for TCP                         */
     TRDP_IP_ADDR_T      mcGroups[VOS_MAX_MULTICAST_CNT]; /**< List of multicast addresses for this socket */
+    SOCKET              pollSock;                        /**< sock as added to the poll set of the session,
+                                                              VOS_INVALID_SOCKET if not added             */
 } TRDP_SOCKETS_T;
 
 #if (defined (WIN32) || defined (WIN64))
@@ -300,6 +383,33 @@ typedef struct
     MD_HEADER_T frameHead;                      /**< Packet    header in network byte order                 */
     UINT8       data[TRDP_MAX_MD_DATA_SIZE];    /**< data ready to be sent or received                      */
 } GNU_PACKED MD_PACKET_T;
+
+/** Receive state of a TCP connection: the byte stream is read into pBuf with as few calls as possible,
+    complete frames are taken from its front. A frame larger than the buffer is read into its own packet. */
+typedef struct TRDP_TCP_RCV
+{
+    UINT8           *pBuf;                      /**< TRDP_MD_TCP_RCV_SIZE bytes                             */
+    UINT32          head;                       /**< offset of the first unparsed byte                      */
+    UINT32          fill;                       /**< no. of unparsed bytes from head on                     */
+    MD_PACKET_T     *pPacket;                   /**< large frame being read in place or NULL                */
+    UINT32          packetSize;                 /**< gross size of pPacket                                  */
+    UINT32          packetFill;                 /**< bytes of pPacket received so far                       */
+} TRDP_TCP_RCV_T;
+
+/** Send queue of a TCP connection: trdp_mdSend() gathers the frames of a pass in place and sends them with one
+    vectored call behind the bytes still queued from before. Only what the socket does not take is copied to pBuf.
+    fill plus the gathered bytes never exceed TRDP_MD_TCP_SND_SIZE. */
+typedef struct TRDP_TCP_SND
+{
+    UINT8           *pBuf;                      /**< TRDP_MD_TCP_SND_SIZE bytes, allocated on first backlog */
+    UINT32          head;                       /**< offset of the first unsent byte                        */
+    UINT32          fill;                       /**< no. of unsent bytes from head on                       */
+    VOS_SOCK_SEG_T  seg[TRDP_MD_TCP_SND_FRAMES + 1u]; /**< [0]: the queued bytes, [1..noOfFrames]: frames gathered
+                                                     in place by the current pass of trdp_mdSend()          */
+    UINT32          noOfFrames;                 /**< no. of gathered frames                                 */
+    UINT32          frameBytes;                 /**< sum of the sizes of the gathered frames                */
+    BOOL8           full;                       /**< a frame was refused in this pass, refuse the following */
+} TRDP_TCP_SND_T;
 #endif /* MD_SUPPORT */
 
 #ifdef HIGH_PERF_INDEXED
@@ -313,8 +423,15 @@ typedef struct hp_slots TRDP_HP_SLOTS_T;        /**< forward declaration
 /** Queue element for PD packets to send or receive    */
 typedef struct PD_ELE
 {
+    /* Fields used by the send and timeout loops first, they share the first cache line */
     struct PD_ELE       *pNext;                 /**< pointer to next element or NULL                        */
     UINT32              magic;                  /**< prevent acces through dangeling pointer                */
+    TRDP_PRIV_FLAGS_T   privFlags;              /**< private flags                                          */
+    TRDP_TIME_T         interval;               /**< time out value for received packets or
+                                                     interval for packets to send (set from ms)             */
+    TRDP_TIME_T         timeToGo;               /**< next time this packet must be sent/rcv                 */
+    TRDP_FLAGS_T        pktFlags;               /**< flags                                                  */
+    INT32               socketIdx;              /**< index into the socket list                             */
     TRDP_ADDRESSES_T    addr;                   /**< handle of publisher/subscriber                         */
     TRDP_IP_ADDR_T      lastSrcIP;              /**< last source IP a subscribed packet was received from   */
     TRDP_IP_ADDR_T      pullIpAddress;          /**< In case of pulling a PD this is the requested Ip       */
@@ -327,22 +444,45 @@ typedef struct PD_ELE
     UINT32              getPkts;                /**< Counter for read packets (statistics)                  */
     UINT32              numMissed;              /**< Counter for skipped sequence number (statistics)       */
     TRDP_ERR_T          lastErr;                /**< Last error (timeout)                                   */
-    TRDP_PRIV_FLAGS_T   privFlags;              /**< private flags                                          */
-    TRDP_FLAGS_T        pktFlags;               /**< flags                                                  */
-    TRDP_TIME_T         interval;               /**< time out value for received packets or
-                                                     interval for packets to send (set from ms)             */
-    TRDP_TIME_T         timeToGo;               /**< next time this packet must be sent/rcv                 */
     TRDP_TO_BEHAVIOR_T  toBehavior;             /**< timeout behavior for packets                           */
     UINT32              dataSize;               /**< net data size                                          */
     UINT32              grossSize;              /**< complete packet size (header, data)                    */
     UINT32              sendSize;               /**< data size sent out                                     */
     TRDP_DATASET_T      *pCachedDS;             /**< Pointer to dataset element if known                    */
-    INT32               socketIdx;              /**< index into the socket list                             */
     const void          *pUserRef;              /**< from subscribe()                                       */
     TRDP_PD_CALLBACK_T  pfCbFunction;           /**< Pointer to PD callback function                        */
     PD_PACKET_T         *pFrame;                /**< header ... data + FCS...                               */
+    PD_PACKET_T         *pRefFrame;             /**< frame lent by tlp_getRef() or tlp_putBegin() or NULL   */
+    PD_PACKET_T         *pSpareFrame;           /**< replaces a lent frame (subscriber) or next frame to lend
+                                                     (publisher), always of TRDP_MAX_PD_PACKET_SIZE         */
+    UINT32              refReleased;            /**< pRefFrame given back by tlp_releaseRef(), not recycled yet */
 } PD_ELE_T, *TRDP_PUB_PT, *TRDP_SUB_PT;
 
+/** Slot of the subscriber hash index, the key is taken from the subscription when it is inserted   */
+typedef struct
+{
+    UINT32              comId;                  /**< comId of the subscription                              */
+    UINT32              serviceId;              /**< serviceId (0 if no SOA support)                        */
+    TRDP_IP_ADDR_T      srcIpAddr;              /**< source IP (lower address of range), 0 = any            */
+    TRDP_IP_ADDR_T      destIpAddr;             /**< multicast group, 0 = any (unicast)                     */
+    PD_ELE_T            *pElement;              /**< subscription or NULL if the slot is free               */
+} TRDP_SUB_IDX_SLOT_T;
+
+/** Open addressing hash table (linear probing) of subscriptions  */
+typedef struct
+{
+    UINT32              size;                   /**< no. of slots, power of two                             */
+    UINT32              count;                  /**< no. of used slots                                      */
+    TRDP_SUB_IDX_SLOT_T *pSlots;                /**< slot array                                             */
+} TRDP_SUB_HASH_T;
+
+/** Subscriber index of a session  */
+typedef struct
+{
+    TRDP_SUB_HASH_T     exact;                  /**< keyed on comId, serviceId, srcIp and destIp            */
+    TRDP_SUB_HASH_T     wild;                   /**< keyed on comId: any source or source IP range          */
+} TRDP_SUB_INDEX_T;
+
 #if MD_SUPPORT
 /** Queue element for MD listeners (UDP and TCP)   */
 typedef struct MD_LIS_ELE
@@ -357,13 +497,23 @@ typedef struct MD_LIS_ELE
     INT32               socketIdx;              /**< index into the socket list                             */
     TRDP_MD_CALLBACK_T  pfCbFunction;           /**< Pointer to MD callback function                        */
     UINT32              numSessions;            /**< Number of received packets of all sessions             */
+    struct MD_LIS_ELE   *pNextLis;              /**< next listener in the same bucket of the listener index */
+    UINT32              lisOrder;               /**< age in the queue, newer listeners take precedence      */
 } MD_LIS_ELE_T;
 
+/** Hash index of the MD listeners keyed on comId (if checked) and destination URI (if set)  */
+typedef struct
+{
+    MD_LIS_ELE_T        * *ppBuckets;           /**< bucket chains (pNextLis), newest first, or NULL        */
+    UINT32              size;                   /**< number of buckets (power of 2)                         */
+    UINT32              count;                  /**< number of listeners in the queue                       */
+    UINT32              lastOrder;              /**< lisOrder of the newest listener                        */
+} TRDP_MD_LIS_INDEX_T;
+
 /** Tcp connection parameters    */
 typedef struct TRDP_MD_TCP
 {
     BOOL8   doConnect;                          /**< TCP connection state                                   */
-    BOOL8   msgUncomplete;                      /**< The receive message is uncomplete                      */
 } TRDP_MD_TCP_T;
 
 /** Session queue element for MD (UDP and TCP)  */
@@ -402,19 +552,79 @@ typedef struct MD_ELE
     MD_PACKET_T         *pPacket;               /**< Packet header in network byte order                    */
                                                 /**< data ready to be sent (with CRCs)                      */
     MD_LIS_ELE_T        *pListener;             /**< Pointer to the Session's associated Listener           */
+    struct MD_ELE       *pNextSid;              /**< next element in the same bucket of the sessionID index */
+    struct MD_ELE       *pNextTimer;            /**< next element in the same slot of the timer wheel       */
+    struct MD_ELE       * *ppPrevTimer;         /**< link pointing to this element, NULL if no timer is set */
+    struct MD_ELE       *pNextReady;            /**< next element armed for sending                         */
+    struct MD_ELE       * *ppPrevReady;         /**< link pointing to this element, NULL if not armed       */
+    UINT32              timerLevel;             /**< level of the timer wheel, TRDP_MD_TIMER_LEVELS if due  */
 } MD_ELE_T;
 
+/** Hash index of an MD queue keyed on the sessionID, kept by the trdp_MDqueue functions  */
+typedef struct
+{
+    MD_ELE_T            * *ppBuckets;           /**< bucket chains (pNextSid) or NULL, then search the queue */
+    UINT32              size;                   /**< number of buckets (power of 2)                         */
+    UINT32              count;                  /**< number of elements in the queue                        */
+} TRDP_MD_SID_INDEX_T;
+
+/** Hierarchical timer wheel of the MD sessions (timeToGo) and FIFO of the sessions armed for sending  */
+typedef struct
+{
+    MD_ELE_T            *pSlot[TRDP_MD_TIMER_LEVELS][TRDP_MD_TIMER_SLOTS];  /**< timers by level and slot    */
+    MD_ELE_T            *pDue;                  /**< expired timers not yet handled                         */
+    UINT32              curTick;                /**< next tick to be handled                                */
+    MD_ELE_T            *pReady;                /**< sessions armed for sending, oldest first               */
+    MD_ELE_T            * *ppReadyTail;         /**< last link of the ready list, NULL if empty             */
+    TRDP_MD_TIMER_STATISTICS_T  stats;          /**< occupancy, copied to the session statistics            */
+} TRDP_MD_TIMER_T;
+
 /**    TCP file descriptor parameters   */
 typedef struct
 {
     SOCKET  listen_sd;          /**< TCP general socket listening connection requests   */
     SOCKET  max_sd;             /**< Maximum socket number in the file descriptor   */
+    SOCKET  poll_sd;            /**< listen_sd as added to the poll set of the session  */
     /* fd_set  master_set;         / **< Local file descriptor   * / */
 } TRDP_TCP_FD_T;
 #endif
 
 struct TAU_TTDB;
 
+/** Blocks kept by the session arena. A slab is only used by holders of the mutex noted, it needs no lock of its own */
+typedef enum
+{
+    TRDP_ARENA_PUB_ELE      = 0,                /**< PD_ELE_T of publishers and PD requests (mutexTxPD)     */
+    TRDP_ARENA_PUB_FRAME    = 1,                /**< their frames of TRDP_MAX_PD_PACKET_SIZE (mutexTxPD)    */
+    TRDP_ARENA_SUB_ELE      = 2,                /**< PD_ELE_T of subscribers (mutexRxPD)                    */
+    TRDP_ARENA_SUB_FRAME    = 3,                /**< their frames of TRDP_MAX_PD_PACKET_SIZE (mutexRxPD)    */
+    TRDP_ARENA_SEQ_CNT      = 4,                /**< sequence counter lists of the start size (mutexRxPD)   */
+    TRDP_ARENA_SEQ_CNT_FULL = 5,                /**< sequence counter lists of the max. size (mutexRxPD)    */
+    TRDP_ARENA_MD_ELE       = 6,                /**< MD_ELE_T (mutexMD)                                     */
+    TRDP_ARENA_SLABS        = 7
+} TRDP_ARENA_SLAB_T;
+
+/** Equally sized blocks of the session arena, free blocks are linked through their first word   */
+typedef struct
+{
+    UINT8               *pStart;                /**< first block                                            */
+    UINT8               *pEnd;                  /**< behind the last block                                  */
+    UINT32              blockSize;              /**< size of a block                                        */
+    UINT32              noOfBlocks;             /**< number of blocks                                       */
+    UINT32              used;                   /**< blocks in use                                          */
+    UINT32              overflow;               /**< requests served by vos_memAlloc, slab was exhausted    */
+    void                *pFree;                 /**< first free block or NULL                               */
+} TRDP_SLAB_T;
+
+/** Fixed footprint arena of a session (tlc_presetArenaSession)  */
+typedef struct
+{
+    UINT8               *pArea;                 /**< contiguous memory of all slabs or NULL (not used)      */
+    UINT32              size;                   /**< size of the area                                       */
+    BOOL8               wasAllocated;           /**< area was allocated by tlc_presetArenaSession           */
+    TRDP_SLAB_T         slab[TRDP_ARENA_SLABS]; /**< one slab per kind of block                             */
+} TRDP_ARENA_T;
+
 /** Session/application variables store */
 typedef struct TRDP_SESSION
 {
@@ -435,26 +645,37 @@ typedef struct TRDP_SESSION
     TRDP_SOCKETS_T          ifacePD[TRDP_MAX_PD_SOCKET_CNT];  /**< Collection of sockets to use               */
     PD_ELE_T                *pSndQueue;         /**< pointer to first element of send queue                 */
     PD_ELE_T                *pRcvQueue;         /**< pointer to first element of rcv queue                  */
+    TRDP_SUB_INDEX_T        subIndex;           /**< hash index of the subscriptions in pRcvQueue           */
+    TRDP_ARENA_T            arena;              /**< preallocated elements and frames (fixed footprint)     */
     PD_PACKET_T             *pNewFrame;         /**< pointer to received PD frame                           */
+    PD_PACKET_T             *pRcvRing[TRDP_PD_RCV_BATCH_SIZE];  /**< ring of PD frames for batched reception  */
     TRDP_PR_SEQ_CNT_LIST_T  *pSeqCntList4PDReq; /**< pointer to list of sequence counters for PR per comId  */
     TRDP_TIME_T             initTime;           /**< initialization time of session                         */
     TRDP_STATISTICS_T       stats;              /**< statistics of this session                             */
+    VOS_POLL_T              pollSet;            /**< sockets waited on by tlc_processEvents(), NULL if unused */
 #ifdef HIGH_PERF_INDEXED
     TRDP_HP_SLOTS_T         *pSlot;             /**< pointer to a struct holding a list of slots for
                                                                         high speed access to PD telegrams   */
+    BOOL8                   pdSendSingle;       /**< send indexed PDs one by one, not in batches (benchmark)  */
 #endif
 #if MD_SUPPORT
     VOS_MUTEX_T             mutexMD;            /**< protect the message data handling                      */
     TRDP_SOCKETS_T          ifaceMD[TRDP_MAX_MD_SOCKET_CNT];  /**< Collection of sockets to use             */
     struct TAU_TTDB         *pTTDB;             /**< session related TTDB data                              */
     void                    *pUser;             /**< space for higher layer data                            */
+    struct TAU_SRV_CACHE    *pSrvCache;         /**< session related service cache (tau_so_if)               */
+    TRDP_IP_ADDR_T          srmAddr[2];         /**< ECSP and SRM group resolved by tau_so_if, 0 = unknown   */
     TRDP_TCP_FD_T           tcpFd;              /**< TCP file descriptor parameters                         */
     TRDP_MD_CONFIG_T        mdDefault;          /**< Default configuration for message data                 */
     MD_LIS_ELE_T            *pMDListenQueue;    /**< pointer to first element of listeners queue            */
     MD_ELE_T                *pMDSndQueue;       /**< pointer to first element of send MD queue (caller)     */
     MD_ELE_T                *pMDRcvQueue;       /**< pointer to first element of recv MD queue (replier)    */
+    TRDP_MD_SID_INDEX_T     mdSndIndex;         /**< sessionID index of pMDSndQueue                         */
+    TRDP_MD_SID_INDEX_T     mdRcvIndex;         /**< sessionID index of pMDRcvQueue                         */
+    TRDP_MD_LIS_INDEX_T     mdLisIndex;         /**< comId/URI index of pMDListenQueue                      */
+    TRDP_MD_TIMER_T         mdTimer;            /**< timeouts and armed sessions of both MD queues          */
+    BOOL8                   mdMorituri;         /**< MD sessions are marked to be closed                    */
     MD_ELE_T                *pMDRcvEle;         /**< pointer to received MD element                         */
-    MD_ELE_T                *uncompletedTCP[VOS_MAX_SOCKET_CNT];     /**< uncompleted TCP messages buffer   */
 #endif
 } TRDP_SESSION_T, *TRDP_SESSION_PT;
 
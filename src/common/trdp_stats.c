@@ -17,6 +17,9 @@
  /*
  * $Id: trdp_stats.c 2137 2019-12-06 17:40:07Z bloehr $
  *
+ *      AG 2026-10-17: Senders evicted from sequence counter tables
+ *      AG 2026-10-17: MD timer wheel occupancy
+ *      AG 2026-10-17: Memory statistics per block size
  *      BL 2019-02-01: Ticket #234 Correcting Statistics ComIds & defines
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2017-11-17: superfluous session->redID replaced by sndQueue->redId
@@ -466,6 +469,7 @@ void    trdp_UpdateStats (
     VOS_ERR_T       ret;
     VOS_TIMEVAL_T   temp, temp2;
     TIMEDATE32      diff;
+    VOS_MEM_CLASS_STATS_T   memClass[VOS_MEM_NBLOCKSIZES];
 
     /*  Get a new time stamp    */
     vos_getTime(&temp2);
@@ -494,6 +498,20 @@ void    trdp_UpdateStats (
     {
         vos_printLog(VOS_LOG_ERROR, "vos_memCount() failed (Err: %d)\n", ret);
     }
+    if (vos_memClassCount(memClass) == VOS_NO_ERR)
+    {
+        for (lIndex = 0u; lIndex < VOS_MEM_NBLOCKSIZES; lIndex++)
+        {
+            appHandle->stats.memClass.used[lIndex]      = memClass[lIndex].used;
+            appHandle->stats.memClass.peak[lIndex]      = memClass[lIndex].peak;
+            appHandle->stats.memClass.fallback[lIndex]  = memClass[lIndex].fallback;
+            appHandle->stats.memClass.failed[lIndex]    = memClass[lIndex].failed;
+        }
+    }
+
+#if MD_SUPPORT
+    appHandle->stats.mdTimer = appHandle->mdTimer.stats;
+#endif
 
     appHandle->stats.pd.numMissed = 0u;
 
@@ -587,6 +605,10 @@ void    trdp_pdPrepareStats (
     {
         pData->mem.blockSize[i]     = vos_htonl(appHandle->stats.mem.blockSize[i]);
         pData->mem.usedBlockSize[i] = vos_htonl(appHandle->stats.mem.usedBlockSize[i]);
+        pData->memClass.used[i]     = vos_htonl(appHandle->stats.memClass.used[i]);
+        pData->memClass.peak[i]     = vos_htonl(appHandle->stats.memClass.peak[i]);
+        pData->memClass.fallback[i] = vos_htonl(appHandle->stats.memClass.fallback[i]);
+        pData->memClass.failed[i]   = vos_htonl(appHandle->stats.memClass.failed[i]);
     }
 
     /* Process data */
@@ -633,6 +655,18 @@ void    trdp_pdPrepareStats (
     pData->tcpMd.numReplyTimeout    = vos_htonl(appHandle->stats.tcpMd.numReplyTimeout);
     pData->tcpMd.numConfirmTimeout  = vos_htonl(appHandle->stats.tcpMd.numConfirmTimeout);
     pData->tcpMd.numSend            = vos_htonl(appHandle->stats.tcpMd.numSend);
+
+    /* MD timer wheel */
+    pData->mdTimer.numTimers        = vos_htonl(appHandle->stats.mdTimer.numTimers);
+    pData->mdTimer.maxTimers        = vos_htonl(appHandle->stats.mdTimer.maxTimers);
+    for (i = 0; i < TRDP_MD_TIMER_LEVELS; i++)
+    {
+        pData->mdTimer.numPerLevel[i] = vos_htonl(appHandle->stats.mdTimer.numPerLevel[i]);
+    }
+    pData->mdTimer.numReady         = vos_htonl(appHandle->stats.mdTimer.numReady);
+    pData->mdTimer.numExpired       = vos_htonl(appHandle->stats.mdTimer.numExpired);
+    pData->mdTimer.numCascaded      = vos_htonl(appHandle->stats.mdTimer.numCascaded);
+    pData->numSeqCntEvict           = vos_htonl(appHandle->stats.numSeqCntEvict);
     pPacket->dataSize = sizeof(TRDP_STATISTICS_T);
 
     /* mark the data as valid */
@@ -17,6 +17,21 @@
 /*
 * $Id: trdp_utils.c 2194 2020-08-07 14:58:59Z bloehr $
 *
+*      AG 2026-10-17: trdp_checkSequenceCounter(): clock (second chance) eviction, O(1) amortised instead of a scan of the table
+*      AG 2026-10-17: Arena without mutex, O(1) trdp_arenaFree(), full size sequence counter lists from the arena
+*      AG 2026-10-17: trdp_checkSequenceCounter(): evicted senders counted, the first one per subscription logged
+*      AG 2026-10-17: trdp_checkSequenceCounter(): open addressed sender table, least recently used sender evicted
+*      AG 2026-10-17: trdp_releaseTcpSnd(): send queue of a TCP connection freed when the socket is closed, TCP_NODELAY,
+*                  TCP connection shared by concurrent sender sessions (shareTcp)
+*      AG 2026-10-17: A closed socket is no longer registered in the poll set of the session (pollSock)
+*      AG 2026-10-17: trdp_releaseTcpRcv() replaces trdp_initUncompletedTCP(), buffer freed when the socket is closed
+*      AG 2026-10-17: trdp_mdTimerInterval(): time until the timer wheel needs service
+*      AG 2026-10-17: Timer wheel and ready list of the MD sessions (trdp_mdTimerSchedule/Cancel/Expire/NextDue/NextReady)
+*      AG 2026-10-17: comId/URI index of the MD listeners (trdp_lisIndexAdd/Remove/Find/Free)
+*      AG 2026-10-17: Hash index of subscriptions (trdp_subIndexAdd/Remove/Find), replaces trdp_idxfindSubAddr()
+*      AG 2026-10-17: SessionID index kept by trdp_MDqueueAppLast/InsFirst/DelElement(), trdp_MDqueueFindSession()
+*      AG 2026-10-17: Session arena (trdp_arenaCreate/Alloc/Free), trdp_subIndexReserve()
+*      AG 2026-10-17: trdp_allocRcvRing()/trdp_freeRcvRing() for batched PD reception
 *      BL 2020-08-07: Ticket #317 Bug in trdp_indexedFindSubAddr() (HIGH_PERFORMANCE)
 *      A 2020-05-04: Ticket #331: Add VLAN support for Sim
 *      SB 2020-03-30: Ticket #311: removed trdp_getSeqCnt() because redundant publisher should not run on the same interface
@@ -83,6 +98,13 @@
 
 #define SAME_SERVICE_COM_ID(a,b)    (((a).comId == (b).comId) && SOA_SAME_SERVICEID_OR0((a).serviceId,(b).serviceId))
 
+/* the serviceId is only part of the subscriber index key, if we are interested in the service field */
+#ifdef SOA_SUPPORT
+#define SUB_IDX_SERVICEID(a)            (a)
+#else
+#define SUB_IDX_SERVICEID(a)            0u
+#endif
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -491,43 +513,36 @@ PD_ELE_T *trdp_queueFindSubAddr (
 /**********************************************************************************************************************/
 /** Return the element with same comId and IP addresses
  *
- *  @param[in]      array           ComId-indexed array of PD Elements
- *  @param[in]      startIdx        Index to begin search
- *  @param[in]      maxIdx          Size / max index + 1  of array
+ *  @param[in]      pHead           pointer to head of queue
  *  @param[in]      addr            Pub/Sub handle (Address, ComID, srcIP & dest IP, serviceId) to search for
  *  @param[in]      comId           ComId to stay on on a sorted search, 0 when searching on unsorted queues
  *
  *  @retval         != NULL         pointer to PD element
  *  @retval         NULL            No PD element found
  */
-PD_ELE_T *trdp_idxfindSubAddr (
-    PD_ELE_T            *array[],
-    UINT32              startIdx,
-    UINT32              maxIdx,
+PD_ELE_T *trdp_findSubAddr (
+    PD_ELE_T            *pHead,
     TRDP_ADDRESSES_T    *addr,
     UINT32              comId)
 {
     PD_ELE_T    *iterPD;
     PD_ELE_T    *pFirstMatchedPD = NULL;
-    UINT32      idx;
 
-    if ((array == NULL) || (addr == NULL) ||
-        (startIdx >= maxIdx))
+    if (pHead == NULL || addr == NULL)
     {
         return NULL;
     }
 
-    for (idx = startIdx; idx < maxIdx; idx++)
+    for (iterPD = pHead; iterPD != NULL; iterPD = iterPD->pNext)
     {
-        iterPD = array[idx];
         /* watch a comId change (needed for indexed search) */
         if ((comId != 0u) && (iterPD->addr.comId != comId))
         {
             break;
         }
         /*  We match if src/dst/mc address is zero or matches */
-        /* if ((iterPD->addr.comId == addr->comId)
-         && SOA_SAME_SERVICEID_OR0(addr->serviceId, iterPD->addr.serviceId)) */
+       /* if ((iterPD->addr.comId == addr->comId)
+              && SOA_SAME_SERVICEID_OR0(addr->serviceId, iterPD->addr.serviceId)) */
         if (SAME_SERVICE_COM_ID(iterPD->addr, *addr)) /*lint !e506 meant to be true, if service support is off */
         {
             /* if srcIP filter matches AND destIP matches THEN this is a direct hit */
@@ -565,19 +580,16 @@ PD_ELE_T *trdp_idxfindSubAddr (
 /** Return the element with same comId and IP addresses
  *
  *  @param[in]      pHead           pointer to head of queue
- *  @param[in]      addr            Pub/Sub handle (Address, ComID, srcIP & dest IP, serviceId) to search for
- *  @param[in]      comId           ComId to stay on on a sorted search, 0 when searching on unsorted queues
+ *  @param[in]      addr            Pub/Sub handle (Address, ComID, srcIP & dest IP) to search for
  *
  *  @retval         != NULL         pointer to PD element
  *  @retval         NULL            No PD element found
  */
-PD_ELE_T *trdp_findSubAddr (
+PD_ELE_T *trdp_queueFindExistingSub (
     PD_ELE_T            *pHead,
-    TRDP_ADDRESSES_T    *addr,
-    UINT32              comId)
+    TRDP_ADDRESSES_T    *addr)
 {
-    PD_ELE_T    *iterPD;
-    PD_ELE_T    *pFirstMatchedPD = NULL;
+    PD_ELE_T *iterPD;
 
     if (pHead == NULL || addr == NULL)
     {
@@ -586,300 +598,1736 @@ PD_ELE_T *trdp_findSubAddr (
 
     for (iterPD = pHead; iterPD != NULL; iterPD = iterPD->pNext)
     {
-        /* watch a comId change (needed for indexed search) */
-        if ((comId != 0u) && (iterPD->addr.comId != comId))
-        {
-            break;
-        }
         /*  We match if src/dst/mc address is zero or matches */
-       /* if ((iterPD->addr.comId == addr->comId)
-              && SOA_SAME_SERVICEID_OR0(addr->serviceId, iterPD->addr.serviceId)) */
-        if (SAME_SERVICE_COM_ID(iterPD->addr, *addr)) /*lint !e506 meant to be true, if service support is off */
+        if ((iterPD->addr.comId == addr->comId)
+            && SOA_SAME_SERVICEID(iterPD->addr.serviceId, addr->serviceId)) /*lint !e506 meant to be true, if service support is off */
         {
-            /* if srcIP filter matches AND destIP matches THEN this is a direct hit */
-            if ((iterPD->addr.srcIpAddr == addr->srcIpAddr) &&
-                ((iterPD->addr.destIpAddr == addr->destIpAddr)))
-            {
-                return iterPD;  /* we cannot find a better match */
-            }
-
-            if (((iterPD->addr.srcIpAddr == VOS_INADDR_ANY) || (iterPD->addr.srcIpAddr == addr->srcIpAddr))
-                && ((iterPD->addr.destIpAddr == VOS_INADDR_ANY) || (addr->destIpAddr == VOS_INADDR_ANY) ||
-                    (iterPD->addr.destIpAddr == addr->destIpAddr)))
+            if ((iterPD->addr.srcIpAddr == addr->srcIpAddr)
+                && (iterPD->addr.destIpAddr == addr->destIpAddr))
             {
-                pFirstMatchedPD = iterPD;
+                return iterPD;
             }
-
             /* Check for IP range */
             if (iterPD->addr.srcIpAddr2 != VOS_INADDR_ANY)
             {
                 if ((addr->srcIpAddr >= iterPD->addr.srcIpAddr) &&
                     (addr->srcIpAddr <= iterPD->addr.srcIpAddr2) &&
-                    ((iterPD->addr.destIpAddr == VOS_INADDR_ANY) || (addr->destIpAddr == VOS_INADDR_ANY) ||
-                     (iterPD->addr.destIpAddr == addr->destIpAddr)))
+                    (iterPD->addr.destIpAddr == addr->destIpAddr))
                 {
                     return iterPD;
                 }
             }
+
         }
     }
-    return pFirstMatchedPD;
+    return NULL;
 }
 
+/**********************************************************************************************************************/
+/** Hash value of a subscriber index key
+ *
+ *  @param[in]      comId           comId
+ *  @param[in]      serviceId       serviceId
+ *  @param[in]      srcIpAddr       source IP
+ *  @param[in]      destIpAddr      destination IP (MC group)
+ *
+ *  @retval         hash value
+ */
+static UINT32 trdp_subHashKey (
+    UINT32          comId,
+    UINT32          serviceId,
+    TRDP_IP_ADDR_T  srcIpAddr,
+    TRDP_IP_ADDR_T  destIpAddr)
+{
+    UINT32 hash = comId * 0x9E3779B1u;
+
+    hash    = (hash ^ serviceId) * 0x85EBCA6Bu;
+    hash    = (hash ^ srcIpAddr) * 0xC2B2AE35u;
+    hash    = (hash ^ destIpAddr) * 0x9E3779B1u;
+    return hash ^ (hash >> 16u);
+}
 
 /**********************************************************************************************************************/
-/** Return the element with same comId and IP addresses
+/** Hash value of a used slot
  *
- *  @param[in]      pHead           pointer to head of queue
- *  @param[in]      addr            Pub/Sub handle (Address, ComID, srcIP & dest IP) to search for
+ *  @param[in]      pSlot           slot
+ *  @param[in]      comIdOnly       TRUE for the table of wildcard subscriptions (keyed on comId only)
+ *
+ *  @retval         hash value
+ */
+static UINT32 trdp_subSlotHash (
+    const TRDP_SUB_IDX_SLOT_T   *pSlot,
+    BOOL8                       comIdOnly)
+{
+    if (comIdOnly == TRUE)
+    {
+        return trdp_subHashKey(pSlot->comId, 0u, VOS_INADDR_ANY, VOS_INADDR_ANY);
+    }
+    return trdp_subHashKey(pSlot->comId, pSlot->serviceId, pSlot->srcIpAddr, pSlot->destIpAddr);
+}
+
+/**********************************************************************************************************************/
+/** Put an entry into a hash table with at least one free slot
+ *
+ *  @param[in]      pHash           hash table
+ *  @param[in]      pEntry          entry to copy into the table
+ *  @param[in]      comIdOnly       TRUE for the table of wildcard subscriptions
+ */
+static void trdp_subHashPut (
+    TRDP_SUB_HASH_T             *pHash,
+    const TRDP_SUB_IDX_SLOT_T   *pEntry,
+    BOOL8                       comIdOnly)
+{
+    UINT32  mask    = pHash->size - 1u;
+    UINT32  idx     = trdp_subSlotHash(pEntry, comIdOnly) & mask;
+
+    while (pHash->pSlots[idx].pElement != NULL)
+    {
+        idx = (idx + 1u) & mask;
+    }
+    pHash->pSlots[idx] = *pEntry;
+    pHash->count++;
+}
+
+/**********************************************************************************************************************/
+/** Insert an entry, the table is doubled if it would become more than half full
+ *
+ *  @param[in]      pHash           hash table
+ *  @param[in]      pEntry          entry to copy into the table
+ *  @param[in]      comIdOnly       TRUE for the table of wildcard subscriptions
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T trdp_subHashInsert (
+    TRDP_SUB_HASH_T             *pHash,
+    const TRDP_SUB_IDX_SLOT_T   *pEntry,
+    BOOL8                       comIdOnly)
+{
+    if (((pHash->count + 1u) * 2u) > pHash->size)
+    {
+        TRDP_SUB_HASH_T newHash;
+        UINT32          idx;
+
+        newHash.size    = (pHash->size == 0u) ? TRDP_SUB_INDEX_MIN_SIZE : (pHash->size * 2u);
+        newHash.count   = 0u;
+        newHash.pSlots  = (TRDP_SUB_IDX_SLOT_T *) vos_memAlloc(newHash.size * sizeof(TRDP_SUB_IDX_SLOT_T));
+        if (newHash.pSlots == NULL)
+        {
+            return TRDP_MEM_ERR;
+        }
+        for (idx = 0u; idx < pHash->size; idx++)
+        {
+            if (pHash->pSlots[idx].pElement != NULL)
+            {
+                trdp_subHashPut(&newHash, &pHash->pSlots[idx], comIdOnly);
+            }
+        }
+        if (pHash->pSlots != NULL)
+        {
+            vos_memFree(pHash->pSlots);
+        }
+        *pHash = newHash;
+    }
+    trdp_subHashPut(pHash, pEntry, comIdOnly);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Remove the slot of an element, following entries of the cluster are moved back (no tombstones)
+ *
+ *  @param[in]      pHash           hash table
+ *  @param[in]      pEntry          key and element to remove
+ *  @param[in]      comIdOnly       TRUE for the table of wildcard subscriptions
+ */
+static void trdp_subHashRemove (
+    TRDP_SUB_HASH_T             *pHash,
+    const TRDP_SUB_IDX_SLOT_T   *pEntry,
+    BOOL8                       comIdOnly)
+{
+    UINT32  mask, idx, next;
+
+    if (pHash->count == 0u)
+    {
+        return;
+    }
+    mask    = pHash->size - 1u;
+    idx     = trdp_subSlotHash(pEntry, comIdOnly) & mask;
+
+    while (pHash->pSlots[idx].pElement != pEntry->pElement)
+    {
+        if (pHash->pSlots[idx].pElement == NULL)
+        {
+            return;     /* not in this table */
+        }
+        idx = (idx + 1u) & mask;
+    }
+
+    for (next = (idx + 1u) & mask; pHash->pSlots[next].pElement != NULL; next = (next + 1u) & mask)
+    {
+        UINT32 home = trdp_subSlotHash(&pHash->pSlots[next], comIdOnly) & mask;
+
+        /* Move the entry into the gap if its home slot is not between the gap and its current position */
+        if (((next - home) & mask) >= ((next - idx) & mask))
+        {
+            pHash->pSlots[idx]  = pHash->pSlots[next];
+            idx                 = next;
+        }
+    }
+    pHash->pSlots[idx].pElement = NULL;
+    pHash->count--;
+}
+
+/**********************************************************************************************************************/
+/** Find a subscription with exactly this key
+ *
+ *  @param[in]      pHash           table of the subscriptions with a source IP
+ *  @param[in]      comId           comId
+ *  @param[in]      serviceId       serviceId
+ *  @param[in]      srcIpAddr       source IP
+ *  @param[in]      destIpAddr      destination IP (MC group), 0 for any
  *
  *  @retval         != NULL         pointer to PD element
  *  @retval         NULL            No PD element found
  */
-PD_ELE_T *trdp_queueFindExistingSub (
-    PD_ELE_T            *pHead,
-    TRDP_ADDRESSES_T    *addr)
+static PD_ELE_T *trdp_subHashFind (
+    const TRDP_SUB_HASH_T   *pHash,
+    UINT32                  comId,
+    UINT32                  serviceId,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    TRDP_IP_ADDR_T          destIpAddr)
 {
-    PD_ELE_T *iterPD;
+    UINT32 mask, idx;
 
-    if (pHead == NULL || addr == NULL)
+    if (pHash->count == 0u)
     {
         return NULL;
     }
+    mask = pHash->size - 1u;
+    for (idx = trdp_subHashKey(comId, serviceId, srcIpAddr, destIpAddr) & mask;
+         pHash->pSlots[idx].pElement != NULL;
+         idx = (idx + 1u) & mask)
+    {
+        const TRDP_SUB_IDX_SLOT_T *pSlot = &pHash->pSlots[idx];
 
-    for (iterPD = pHead; iterPD != NULL; iterPD = iterPD->pNext)
+        if ((pSlot->comId == comId) &&
+            (pSlot->serviceId == serviceId) &&
+            (pSlot->srcIpAddr == srcIpAddr) &&
+            (pSlot->destIpAddr == destIpAddr))
+        {
+            return pSlot->pElement;
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Find a subscription with this source, accept subscriptions for any service, too
+ *
+ *  @param[in]      pHash           table of the subscriptions with a source IP
+ *  @param[in]      pAddr           received addresses
+ *  @param[in]      destIpAddr      destination IP (MC group), 0 for any
+ *
+ *  @retval         != NULL         pointer to PD element
+ *  @retval         NULL            No PD element found
+ */
+static PD_ELE_T *trdp_subHashFindSrc (
+    const TRDP_SUB_HASH_T   *pHash,
+    const TRDP_ADDRESSES_T  *pAddr,
+    TRDP_IP_ADDR_T          destIpAddr)
+{
+    UINT32      serviceId   = SUB_IDX_SERVICEID(pAddr->serviceId);
+    PD_ELE_T    *pElement   = trdp_subHashFind(pHash, pAddr->comId, serviceId, pAddr->srcIpAddr, destIpAddr);
+
+    if ((pElement == NULL) && (serviceId != 0u))
     {
-        /*  We match if src/dst/mc address is zero or matches */
-        if ((iterPD->addr.comId == addr->comId)
-            && SOA_SAME_SERVICEID(iterPD->addr.serviceId, addr->serviceId)) /*lint !e506 meant to be true, if service support is off */
+        pElement = trdp_subHashFind(pHash, pAddr->comId, 0u, pAddr->srcIpAddr, destIpAddr);
+    }
+    return pElement;
+}
+
+/**********************************************************************************************************************/
+/** Compute the index key of a subscription
+ *  The destination of the key is the multicast group: unicast subscriptions accept any destination.
+ *
+ *  @param[in]      pElement        subscription
+ *  @param[out]     pEntry          key and element
+ *
+ *  @retval         TRUE            wildcard subscription (any source or source IP range)
+ *  @retval         FALSE           subscription for one source IP
+ */
+static BOOL8 trdp_subIndexEntry (
+    PD_ELE_T            *pElement,
+    TRDP_SUB_IDX_SLOT_T *pEntry)
+{
+    pEntry->comId       = pElement->addr.comId;
+    pEntry->serviceId   = SUB_IDX_SERVICEID(pElement->addr.serviceId);
+    pEntry->srcIpAddr   = pElement->addr.srcIpAddr;
+    pEntry->destIpAddr  = pElement->addr.mcGroup;
+    pEntry->pElement    = pElement;
+
+    return ((pElement->addr.srcIpAddr == VOS_INADDR_ANY) ||
+            (pElement->addr.srcIpAddr2 != VOS_INADDR_ANY)) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Add a subscription to the subscriber index of the session
+ *  Must be called after the addressing of the element is set up and before it is modified (tlp_resubscribe).
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pElement        subscription
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+TRDP_ERR_T trdp_subIndexAdd (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement)
+{
+    TRDP_SUB_IDX_SLOT_T entry;
+
+    if (trdp_subIndexEntry(pElement, &entry) == TRUE)
+    {
+        return trdp_subHashInsert(&appHandle->subIndex.wild, &entry, TRUE);
+    }
+    return trdp_subHashInsert(&appHandle->subIndex.exact, &entry, FALSE);
+}
+
+/**********************************************************************************************************************/
+/** Remove a subscription from the subscriber index of the session
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pElement        subscription
+ */
+void trdp_subIndexRemove (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement)
+{
+    TRDP_SUB_IDX_SLOT_T entry;
+
+    if (trdp_subIndexEntry(pElement, &entry) == TRUE)
+    {
+        trdp_subHashRemove(&appHandle->subIndex.wild, &entry, TRUE);
+    }
+    else
+    {
+        trdp_subHashRemove(&appHandle->subIndex.exact, &entry, FALSE);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Free the subscriber index of the session
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+void trdp_subIndexFree (
+    TRDP_SESSION_PT appHandle)
+{
+    if (appHandle->subIndex.exact.pSlots != NULL)
+    {
+        vos_memFree(appHandle->subIndex.exact.pSlots);
+    }
+    if (appHandle->subIndex.wild.pSlots != NULL)
+    {
+        vos_memFree(appHandle->subIndex.wild.pSlots);
+    }
+    memset(&appHandle->subIndex, 0, sizeof(appHandle->subIndex));
+}
+
+/**********************************************************************************************************************/
+/** Size the subscriber index for a number of subscriptions, avoids growing it later
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      noOfSubs        expected number of subscriptions
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+TRDP_ERR_T trdp_subIndexReserve (
+    TRDP_SESSION_PT appHandle,
+    UINT32          noOfSubs)
+{
+    TRDP_SUB_HASH_T *pTables[2];
+    UINT32          table, size, idx;
+
+    pTables[0]  = &appHandle->subIndex.exact;
+    pTables[1]  = &appHandle->subIndex.wild;
+    for (size = TRDP_SUB_INDEX_MIN_SIZE; (size / 2u) < noOfSubs; size *= 2u)
+    {
+        ;
+    }
+    for (table = 0u; table < 2u; table++)
+    {
+        TRDP_SUB_HASH_T newHash;
+
+        if (pTables[table]->size >= size)
         {
-            if ((iterPD->addr.srcIpAddr == addr->srcIpAddr)
-                && (iterPD->addr.destIpAddr == addr->destIpAddr))
+            continue;
+        }
+        newHash.size    = size;
+        newHash.count   = 0u;
+        newHash.pSlots  = (TRDP_SUB_IDX_SLOT_T *) vos_memAlloc(size * sizeof(TRDP_SUB_IDX_SLOT_T));
+        if (newHash.pSlots == NULL)
+        {
+            return TRDP_MEM_ERR;
+        }
+        for (idx = 0u; idx < pTables[table]->size; idx++)
+        {
+            if (pTables[table]->pSlots[idx].pElement != NULL)
             {
-                return iterPD;
+                trdp_subHashPut(&newHash, &pTables[table]->pSlots[idx], (table == 1u) ? TRUE : FALSE);
+            }
+        }
+        if (pTables[table]->pSlots != NULL)
+        {
+            vos_memFree(pTables[table]->pSlots);
+        }
+        *pTables[table] = newHash;
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Return the subscription for a received packet
+ *  This search is done for every received packet. In order of preference we return the subscription for
+ *      - the same source and multicast group
+ *      - a source IP range containing the source
+ *      - the same source and any destination
+ *      - any source (and the same multicast group, if there is one)
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pAddr           received addresses (ComID, srcIP & dest IP, serviceId)
+ *
+ *  @retval         != NULL         pointer to PD element
+ *  @retval         NULL            No PD element found
+ */
+PD_ELE_T *trdp_subIndexFind (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_ADDRESSES_T    *pAddr)
+{
+    const TRDP_SUB_HASH_T   *pWild      = &appHandle->subIndex.wild;
+    PD_ELE_T                *pAnySrc    = NULL;
+    PD_ELE_T                *pElement;
+
+    /* Without the destination of the packet the index cannot be used (Ticket #230) */
+    if (pAddr->destIpAddr == VOS_INADDR_ANY)
+    {
+        return trdp_queueFindSubAddr(appHandle->pRcvQueue, pAddr);
+    }
+
+    pElement = trdp_subHashFindSrc(&appHandle->subIndex.exact, pAddr, pAddr->destIpAddr);
+    if (pElement != NULL)
+    {
+        return pElement;    /* we cannot find a better match */
+    }
+
+    if (pWild->count != 0u)
+    {
+        UINT32  serviceId   = SUB_IDX_SERVICEID(pAddr->serviceId);
+        UINT32  mask        = pWild->size - 1u;
+        UINT32  idx;
+
+        for (idx = trdp_subHashKey(pAddr->comId, 0u, VOS_INADDR_ANY, VOS_INADDR_ANY) & mask;
+             pWild->pSlots[idx].pElement != NULL;
+             idx = (idx + 1u) & mask)
+        {
+            const TRDP_SUB_IDX_SLOT_T *pSlot = &pWild->pSlots[idx];
+
+            if ((pSlot->comId != pAddr->comId) ||
+                ((pSlot->serviceId != 0u) && (pSlot->serviceId != serviceId)) ||
+                ((pSlot->destIpAddr != VOS_INADDR_ANY) && (pSlot->destIpAddr != pAddr->destIpAddr)))
+            {
+                continue;
             }
             /* Check for IP range */
-            if (iterPD->addr.srcIpAddr2 != VOS_INADDR_ANY)
+            if (pSlot->pElement->addr.srcIpAddr2 != VOS_INADDR_ANY)
             {
-                if ((addr->srcIpAddr >= iterPD->addr.srcIpAddr) &&
-                    (addr->srcIpAddr <= iterPD->addr.srcIpAddr2) &&
-                    (iterPD->addr.destIpAddr == addr->destIpAddr))
+                if ((pAddr->srcIpAddr >= pSlot->srcIpAddr) &&
+                    (pAddr->srcIpAddr <= pSlot->pElement->addr.srcIpAddr2))
                 {
-                    return iterPD;
+                    return pSlot->pElement;
                 }
             }
+            else if ((pAnySrc == NULL) || (pSlot->destIpAddr != VOS_INADDR_ANY))
+            {
+                pAnySrc = pSlot->pElement;
+            }
+        }
+    }
+
+    pElement = trdp_subHashFindSrc(&appHandle->subIndex.exact, pAddr, VOS_INADDR_ANY);
+    return (pElement != NULL) ? pElement : pAnySrc;
+}
+
+/**********************************************************************************************************************/
+/** Delete an element
+ *
+ *  @param[in]      ppHead          pointer to pointer to head of queue
+ *  @param[in]      pDelete         pointer to element to delete
+ */
+void    trdp_queueDelElement (
+    PD_ELE_T    * *ppHead,
+    PD_ELE_T    *pDelete)
+{
+    PD_ELE_T *iterPD;
+
+    if (ppHead == NULL || *ppHead == NULL || pDelete == NULL)
+    {
+        return;
+    }
+
+    /* handle removal of first element */
+    if (pDelete == *ppHead)
+    {
+        *ppHead = pDelete->pNext;
+        return;
+    }
+
+    for (iterPD = *ppHead; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        if (iterPD->pNext && iterPD->pNext == pDelete)
+        {
+            iterPD->pNext = pDelete->pNext;
+            return;
+        }
+    }
+}
+
+
+/**********************************************************************************************************************/
+/** Check topography counters
+ *  The applied conformance pattern follows Table A.5/A.21 (positive match):
+ *  Telegram to be sent   Locally stored value (appSession)
+ *  Case etbTopoCnt opTrnTopoCnt etbTopoCntFilter opTrnTopoCntFilter
+ *  1    any        any          0                0
+ *  2    any        equal        0                equal
+ *  3    equal      any          equal            0
+ *  4    equal      equal        equal            equal
+ *
+ *  @param[in]      etbTopoCnt              ETB topography counter to be checked
+ *  @param[in]      opTrnTopoCnt            Operational topography counter to be checked
+ *  @param[in]      etbTopoCntFilter        ETB topography counter filter value
+ *  @param[in]      opTrnTopoCntFilter      Operational topography counter filter value
+ *
+ *  @retval         TRUE           Filter criteria matched
+ *                  FALSE          Filter criteria not matched
+ */
+BOOL8 trdp_validTopoCounters (
+    UINT32  etbTopoCnt,
+    UINT32  opTrnTopoCnt,
+    UINT32  etbTopoCntFilter,
+    UINT32  opTrnTopoCntFilter)
+{
+    if (((etbTopoCntFilter == 0) || (etbTopoCnt == etbTopoCntFilter))
+        &&
+        ((opTrnTopoCntFilter == 0) || (opTrnTopoCnt == opTrnTopoCntFilter)))
+    {
+        return TRUE;
+    }
+    else
+    {
+        return FALSE;
+    }
+}
+
+#if MD_SUPPORT
+/**********************************************************************************************************************/
+/** Return the element with same comId from MD queue
+ *
+ *  @param[in]      pHead           pointer to head of queue
+ *  @param[in]      addr            Pub/Sub handle (Address, ComID, srcIP & dest IP) to search for
+ *
+ *  @retval         != NULL         pointer to PD element
+ *  @retval         NULL            No PD element found
+ */
+MD_ELE_T *trdp_MDqueueFindAddr (
+    MD_ELE_T            *pHead,
+    TRDP_ADDRESSES_T    *addr)
+{
+    MD_ELE_T *iterMD;
+
+    if (pHead == NULL || addr == NULL)
+    {
+        return NULL;
+    }
+
+    for (iterMD = pHead; iterMD != NULL; iterMD = iterMD->pNext)
+    {
+        /*  We match if src/dst address is zero or found */
+        if ((iterMD->addr.comId == addr->comId)
+            && ((addr->srcIpAddr == 0) || (iterMD->addr.srcIpAddr == addr->srcIpAddr))
+            && ((addr->destIpAddr == 0) || (iterMD->addr.destIpAddr == addr->destIpAddr)))
+        {
+            return iterMD;
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Hash of a sessionID
+ *
+ *  @param[in]      pSessionId      16 bytes UUID
+ *
+ *  @retval         hash value, the upper bits are used
+ */
+static UINT32 trdp_sidHash (
+    const UINT8 *pSessionId)
+{
+    UINT32  word[TRDP_SESS_ID_SIZE / 4u];
+    UINT32  hash;
+
+    memcpy(word, pSessionId, TRDP_SESS_ID_SIZE);
+    hash = word[0] ^ (word[1] * 0x85EBCA6Bu) ^ (word[2] * 0xC2B2AE35u) ^ (word[3] * 0x27D4EB2Fu);
+    return (hash ^ (hash >> 15)) * 0x9E3779B1u;
+}
+
+/**********************************************************************************************************************/
+/** Put an element into its bucket
+ *
+ *  @param[in]      pIndex          sessionID index
+ *  @param[in]      pElement        element to add
+ */
+static void trdp_sidIndexPut (
+    TRDP_MD_SID_INDEX_T *pIndex,
+    MD_ELE_T            *pElement)
+{
+    MD_ELE_T * *ppBucket = &pIndex->ppBuckets[trdp_sidHash(pElement->sessionID) & (pIndex->size - 1u)];
+
+    pElement->pNextSid  = *ppBucket;
+    *ppBucket           = pElement;
+}
+
+/**********************************************************************************************************************/
+/** Count a new element of the queue and index it, grow the index if it gets too full
+ *  The index is rebuilt from the queue, so it is complete even if a former allocation failed.
+ *  Without buckets, the queue is searched instead.
+ *
+ *  @param[in]      pHead           head of queue, including the new element
+ *  @param[in]      pIndex          sessionID index
+ *  @param[in]      pNew            new element
+ */
+static void trdp_sidIndexAdd (
+    MD_ELE_T            *pHead,
+    TRDP_MD_SID_INDEX_T *pIndex,
+    MD_ELE_T            *pNew)
+{
+    pIndex->count++;
+    if (pIndex->count > pIndex->size)
+    {
+        UINT32      newSize = (pIndex->size == 0u) ? TRDP_MD_SID_INDEX_MIN_SIZE : (pIndex->size * 2u);
+        MD_ELE_T    * *ppBuckets = (MD_ELE_T * *) vos_memAlloc(newSize * sizeof(MD_ELE_T *));
+
+        if (ppBuckets != NULL)
+        {
+            MD_ELE_T *iterMD;
+
+            if (pIndex->ppBuckets != NULL)
+            {
+                vos_memFree(pIndex->ppBuckets);
+            }
+            pIndex->ppBuckets   = ppBuckets;
+            pIndex->size        = newSize;
+            for (iterMD = pHead; iterMD != NULL; iterMD = iterMD->pNext)
+            {
+                trdp_sidIndexPut(pIndex, iterMD);
+            }
+            return;
+        }
+        /* keep the current buckets, the chains just get longer */
+    }
+    if (pIndex->ppBuckets != NULL)
+    {
+        trdp_sidIndexPut(pIndex, pNew);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Remove an element of the queue from the index
+ *
+ *  @param[in]      pIndex          sessionID index
+ *  @param[in]      pDelete         element to remove
+ */
+static void trdp_sidIndexRemove (
+    TRDP_MD_SID_INDEX_T *pIndex,
+    MD_ELE_T            *pDelete)
+{
+    pIndex->count--;
+    if (pIndex->ppBuckets != NULL)
+    {
+        MD_ELE_T * *ppIter = &pIndex->ppBuckets[trdp_sidHash(pDelete->sessionID) & (pIndex->size - 1u)];
+
+        while (*ppIter != NULL)
+        {
+            if (*ppIter == pDelete)
+            {
+                *ppIter = pDelete->pNextSid;
+                break;
+            }
+            ppIter = &(*ppIter)->pNextSid;
+        }
+    }
+    pDelete->pNextSid = NULL;
+}
+
+/**********************************************************************************************************************/
+/** Return the next element with the given sessionID of an MD queue
+ *  The sessionID of an element must not change while it is queued.
+ *
+ *  @param[in]      pHead           head of queue
+ *  @param[in]      pIndex          sessionID index of the queue
+ *  @param[in]      pSessionId      sessionID (16 bytes) to search for
+ *  @param[in]      pAfter          element found before or NULL for the first one
+ *
+ *  @retval         != NULL         pointer to MD element
+ *  @retval         NULL            No (further) MD element found
+ */
+MD_ELE_T *trdp_MDqueueFindSession (
+    MD_ELE_T                    *pHead,
+    const TRDP_MD_SID_INDEX_T   *pIndex,
+    const UINT8                 *pSessionId,
+    const MD_ELE_T              *pAfter)
+{
+    MD_ELE_T *iterMD;
+
+    if (pSessionId == NULL)
+    {
+        return NULL;
+    }
+    if ((pIndex != NULL) && (pIndex->ppBuckets != NULL))
+    {
+        iterMD = (pAfter == NULL) ?
+            pIndex->ppBuckets[trdp_sidHash(pSessionId) & (pIndex->size - 1u)] : pAfter->pNextSid;
+        for (; iterMD != NULL; iterMD = iterMD->pNextSid)
+        {
+            if (memcmp(iterMD->sessionID, pSessionId, TRDP_SESS_ID_SIZE) == 0)
+            {
+                return iterMD;
+            }
+        }
+        return NULL;
+    }
+    iterMD = (pAfter == NULL) ? pHead : pAfter->pNext;
+    for (; iterMD != NULL; iterMD = iterMD->pNext)
+    {
+        if (memcmp(iterMD->sessionID, pSessionId, TRDP_SESS_ID_SIZE) == 0)
+        {
+            return iterMD;
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Free the buckets of a sessionID index
+ *
+ *  @param[in]      pIndex          sessionID index
+ */
+void trdp_MDqueueFreeIndex (
+    TRDP_MD_SID_INDEX_T *pIndex)
+{
+    if (pIndex->ppBuckets != NULL)
+    {
+        vos_memFree(pIndex->ppBuckets);
+    }
+    memset(pIndex, 0, sizeof(TRDP_MD_SID_INDEX_T));
+}
+
+/**********************************************************************************************************************/
+/** Hash of the key of a listener
+ *  The URI is compared case insensitive (trdp_isAddressed), it is hashed in lower case.
+ *
+ *  @param[in]      checkComId      TRUE if the comId is part of the key
+ *  @param[in]      comId           comId
+ *  @param[in]      pDestURI        destination URI or NULL for any
+ *
+ *  @retval         hash value, the upper bits are used
+ */
+static UINT32 trdp_lisHash (
+    BOOL8           checkComId,
+    UINT32          comId,
+    const CHAR8     *pDestURI)
+{
+    UINT32 hash = (checkComId == TRUE) ? ((comId * 0x85EBCA6Bu) ^ 0x5A5A5A5Au) : 0u;
+    UINT32 idx;
+
+    if (pDestURI != NULL)
+    {
+        for (idx = 0u; (idx < TRDP_USR_URI_SIZE) && (pDestURI[idx] != 0); idx++)
+        {
+            UINT32 c = (UINT8) pDestURI[idx];
+
+            if ((c >= (UINT32) 'A') && (c <= (UINT32) 'Z'))
+            {
+                c += (UINT32) ('a' - 'A');
+            }
+            hash = (hash ^ c) * 0x01000193u;
+        }
+        hash ^= 0xC2B2AE35u;
+    }
+    return (hash ^ (hash >> 15)) * 0x9E3779B1u;
+}
+
+/**********************************************************************************************************************/
+/** Bucket of a listener
+ *
+ *  @param[in]      pIndex          listener index
+ *  @param[in]      pListener       listener
+ *
+ *  @retval         pointer to the head of the bucket chain
+ */
+static MD_LIS_ELE_T * *trdp_lisBucket (
+    const TRDP_MD_LIS_INDEX_T   *pIndex,
+    const MD_LIS_ELE_T          *pListener)
+{
+    UINT32 hash = trdp_lisHash(((pListener->privFlags & TRDP_CHECK_COMID) != 0) ? TRUE : FALSE,
+                               pListener->addr.comId,
+                               (pListener->destURI[0] != 0) ? pListener->destURI : NULL);
+
+    return &pIndex->ppBuckets[hash & (pIndex->size - 1u)];
+}
+
+/**********************************************************************************************************************/
+/** Add a listener to the index, it was just inserted at the front of pMDListenQueue
+ *  The chains are kept in queue order (newest first), on growing the index is rebuilt from the queue.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pNew            new listener
+ */
+void trdp_lisIndexAdd (
+    TRDP_SESSION_PT appHandle,
+    MD_LIS_ELE_T    *pNew)
+{
+    TRDP_MD_LIS_INDEX_T *pIndex = &appHandle->mdLisIndex;
+    MD_LIS_ELE_T        * *ppBucket;
+
+    pNew->lisOrder  = ++pIndex->lastOrder;
+    pIndex->count++;
+    if (pIndex->count > pIndex->size)
+    {
+        UINT32          newSize     = (pIndex->size == 0u) ? TRDP_MD_LIS_INDEX_MIN_SIZE : (pIndex->size * 2u);
+        MD_LIS_ELE_T    * *ppBuckets = (MD_LIS_ELE_T * *) vos_memAlloc(newSize * sizeof(MD_LIS_ELE_T *));
+
+        if (ppBuckets != NULL)
+        {
+            MD_LIS_ELE_T *iterLis;
+
+            if (pIndex->ppBuckets != NULL)
+            {
+                vos_memFree(pIndex->ppBuckets);
+            }
+            pIndex->ppBuckets   = ppBuckets;
+            pIndex->size        = newSize;
+            for (iterLis = appHandle->pMDListenQueue; iterLis != NULL; iterLis = iterLis->pNext)
+            {
+                /* append, to keep the queue order */
+                for (ppBucket = trdp_lisBucket(pIndex, iterLis); *ppBucket != NULL; ppBucket = &(*ppBucket)->pNextLis)
+                {
+                    ;
+                }
+                iterLis->pNextLis   = NULL;
+                *ppBucket           = iterLis;
+            }
+            return;
+        }
+        /* keep the current buckets, the chains just get longer */
+    }
+    if (pIndex->ppBuckets != NULL)
+    {
+        ppBucket        = trdp_lisBucket(pIndex, pNew);
+        pNew->pNextLis  = *ppBucket;
+        *ppBucket       = pNew;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Remove a listener from the index
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pDelete         listener to remove
+ */
+void trdp_lisIndexRemove (
+    TRDP_SESSION_PT appHandle,
+    MD_LIS_ELE_T    *pDelete)
+{
+    TRDP_MD_LIS_INDEX_T *pIndex = &appHandle->mdLisIndex;
+
+    pIndex->count--;
+    if (pIndex->ppBuckets != NULL)
+    {
+        MD_LIS_ELE_T * *ppIter = trdp_lisBucket(pIndex, pDelete);
+
+        while (*ppIter != NULL)
+        {
+            if (*ppIter == pDelete)
+            {
+                *ppIter = pDelete->pNextLis;
+                break;
+            }
+            ppIter = &(*ppIter)->pNextLis;
+        }
+    }
+    pDelete->pNextLis = NULL;
+}
+
+/**********************************************************************************************************************/
+/** Return the next listener with exactly the given key
+ *  A received message has to probe the four keys (with/without comId, with/without URI), the listeners of a key
+ *  are returned newest first. Listeners with a URI are only found by a probe with that URI.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      checkComId      TRUE for comId listeners, FALSE for listeners ignoring the comId
+ *  @param[in]      comId           received comId
+ *  @param[in]      pDestURI        received destination URI or NULL for listeners without URI
+ *  @param[in]      pAfter          listener found before or NULL for the first one
+ *
+ *  @retval         != NULL         pointer to listener
+ *  @retval         NULL            no (further) listener or no index, then search pMDListenQueue
+ */
+MD_LIS_ELE_T *trdp_lisIndexFind (
+    TRDP_SESSION_PT     appHandle,
+    BOOL8               checkComId,
+    UINT32              comId,
+    const CHAR8         *pDestURI,
+    const MD_LIS_ELE_T  *pAfter)
+{
+    const TRDP_MD_LIS_INDEX_T   *pIndex = &appHandle->mdLisIndex;
+    MD_LIS_ELE_T                *iterLis;
+
+    if (pIndex->ppBuckets == NULL)
+    {
+        return NULL;
+    }
+    iterLis = (pAfter == NULL) ?
+        pIndex->ppBuckets[trdp_lisHash(checkComId, comId, pDestURI) & (pIndex->size - 1u)] : pAfter->pNextLis;
+    for (; iterLis != NULL; iterLis = iterLis->pNextLis)
+    {
+        if ((((iterLis->privFlags & TRDP_CHECK_COMID) != 0) != (checkComId == TRUE)) ||
+            ((checkComId == TRUE) && (iterLis->addr.comId != comId)))
+        {
+            continue;
+        }
+        if ((pDestURI == NULL) ? (iterLis->destURI[0] == 0) :
+            ((iterLis->destURI[0] != 0) && trdp_isAddressed(iterLis->destURI, pDestURI)))
+        {
+            return iterLis;
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Free the buckets of the listener index
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+void trdp_lisIndexFree (
+    TRDP_SESSION_PT appHandle)
+{
+    if (appHandle->mdLisIndex.ppBuckets != NULL)
+    {
+        vos_memFree(appHandle->mdLisIndex.ppBuckets);
+    }
+    memset(&appHandle->mdLisIndex, 0, sizeof(TRDP_MD_LIS_INDEX_T));
+}
+
+/**********************************************************************************************************************/
+/** Delete an element from MD queue
+ *
+ *  @param[in]      ppHead          pointer to pointer to head of queue
+ *  @param[in]      pIndex          sessionID index of the queue or NULL
+ *  @param[in]      pDelete         pointer to element to delete
+ */
+void    trdp_MDqueueDelElement (
+    MD_ELE_T            * *ppHead,
+    TRDP_MD_SID_INDEX_T *pIndex,
+    MD_ELE_T            *pDelete)
+{
+    MD_ELE_T *iterMD;
+
+    if (ppHead == NULL || *ppHead == NULL || pDelete == NULL)
+    {
+        return;
+    }
+
+    /*    handle removal of first element    */
+    if (pDelete == *ppHead)
+    {
+        *ppHead = pDelete->pNext;
+        if (pIndex != NULL)
+        {
+            trdp_sidIndexRemove(pIndex, pDelete);
+        }
+        return;
+    }
+
+    for (iterMD = *ppHead; iterMD != NULL; iterMD = iterMD->pNext)
+    {
+        if (iterMD->pNext && iterMD->pNext == pDelete)
+        {
+            iterMD->pNext = pDelete->pNext;
+            if (pIndex != NULL)
+            {
+                trdp_sidIndexRemove(pIndex, pDelete);
+            }
+            return;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Append an element at end of queue
+ *  The sessionID of the element must be set.
+ *
+ *  @param[in]      ppHead          pointer to pointer to head of queue
+ *  @param[in]      pIndex          sessionID index of the queue or NULL
+ *  @param[in]      pNew            pointer to element to append
+ */
+void    trdp_MDqueueAppLast (
+    MD_ELE_T            * *ppHead,
+    TRDP_MD_SID_INDEX_T *pIndex,
+    MD_ELE_T            *pNew)
+{
+    MD_ELE_T *iterMD;
+
+    if (ppHead == NULL || pNew == NULL)
+    {
+        return;
+    }
+
+    /* Ensure this element is last! */
+    pNew->pNext = NULL;
+
+    if (*ppHead == NULL)
+    {
+        *ppHead = pNew;
+    }
+    else
+    {
+        for (iterMD = *ppHead; iterMD->pNext != NULL; iterMD = iterMD->pNext)
+        {
+            ;
+        }
+        iterMD->pNext = pNew;
+    }
+    if (pIndex != NULL)
+    {
+        trdp_sidIndexAdd(*ppHead, pIndex, pNew);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Insert an element at front of MD queue
+ *  The sessionID of the element must be set.
+ *
+ *  @param[in]      ppHead          pointer to pointer to head of queue
+ *  @param[in]      pIndex          sessionID index of the queue or NULL
+ *  @param[in]      pNew            pointer to element to insert
+ */
+void    trdp_MDqueueInsFirst (
+    MD_ELE_T            * *ppHead,
+    TRDP_MD_SID_INDEX_T *pIndex,
+    MD_ELE_T            *pNew)
+{
+    if (ppHead == NULL || pNew == NULL)
+    {
+        return;
+    }
+
+    pNew->pNext = *ppHead;
+    *ppHead     = pNew;
+    if (pIndex != NULL)
+    {
+        trdp_sidIndexAdd(*ppHead, pIndex, pNew);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Convert a time to ticks of the MD timer wheel
+ *
+ *  @param[in]      pTime           absolute time
+ *  @param[in]      roundUp         TRUE to round up to the next tick
+ *
+ *  @retval         tick, wrapping around
+ */
+static UINT32 trdp_mdTimerTick (
+    const TRDP_TIME_T   *pTime,
+    BOOL8               roundUp)
+{
+    UINT32 usec = (UINT32) pTime->tv_usec;
+
+    if (roundUp == TRUE)
+    {
+        usec += TRDP_MD_TIMER_TICK - 1u;
+    }
+    return pTime->tv_sec * (1000000u / TRDP_MD_TIMER_TICK) + usec / TRDP_MD_TIMER_TICK;
+}
+
+/**********************************************************************************************************************/
+/** Put an element into a slot of the timer wheel
+ *  Timers beyond the range of the wheel are clamped, trdp_mdCheckTimeouts() reschedules them when they come up.
+ *
+ *  @param[in]      pWheel          timer wheel of the session
+ *  @param[in]      pElement        element, not linked into the wheel
+ *  @param[in]      expires         tick the timer expires
+ */
+static void trdp_mdTimerAdd (
+    TRDP_MD_TIMER_T *pWheel,
+    MD_ELE_T        *pElement,
+    UINT32          expires)
+{
+    UINT32      delta = expires - pWheel->curTick;
+    UINT32      level = 0u;
+    MD_ELE_T    * *ppSlot;
+
+    if ((INT32) delta < 0)
+    {
+        /* already late: handle it with the next tick */
+        delta   = 0u;
+        expires = pWheel->curTick;
+    }
+    else if (delta >= (1u << (TRDP_MD_TIMER_SLOT_BITS * TRDP_MD_TIMER_LEVELS)))
+    {
+        delta   = (1u << (TRDP_MD_TIMER_SLOT_BITS * TRDP_MD_TIMER_LEVELS)) - 1u;
+        expires = pWheel->curTick + delta;
+    }
+    while ((level < TRDP_MD_TIMER_LEVELS - 1u) && (delta >= (1u << (TRDP_MD_TIMER_SLOT_BITS * (level + 1u)))))
+    {
+        level++;
+    }
+
+    ppSlot = &pWheel->pSlot[level][(expires >> (TRDP_MD_TIMER_SLOT_BITS * level)) & (TRDP_MD_TIMER_SLOTS - 1u)];
+    pElement->pNextTimer    = *ppSlot;
+    pElement->ppPrevTimer   = ppSlot;
+    if (*ppSlot != NULL)
+    {
+        (*ppSlot)->ppPrevTimer = &pElement->pNextTimer;
+    }
+    *ppSlot = pElement;
+    pElement->timerLevel = level;
+
+    pWheel->stats.numPerLevel[level]++;
+    pWheel->stats.numTimers++;
+    if (pWheel->stats.numTimers > pWheel->stats.maxTimers)
+    {
+        pWheel->stats.maxTimers = pWheel->stats.numTimers;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Take an element out of the timer wheel or the list of due timers
+ *
+ *  @param[in]      pWheel          timer wheel of the session
+ *  @param[in]      pElement        element with a timer set
+ */
+static void trdp_mdTimerRemove (
+    TRDP_MD_TIMER_T *pWheel,
+    MD_ELE_T        *pElement)
+{
+    *pElement->ppPrevTimer = pElement->pNextTimer;
+    if (pElement->pNextTimer != NULL)
+    {
+        pElement->pNextTimer->ppPrevTimer = pElement->ppPrevTimer;
+    }
+    if (pElement->timerLevel < TRDP_MD_TIMER_LEVELS)
+    {
+        pWheel->stats.numPerLevel[pElement->timerLevel]--;
+        pWheel->stats.numTimers--;
+    }
+    pElement->pNextTimer    = NULL;
+    pElement->ppPrevTimer   = NULL;
+}
+
+/**********************************************************************************************************************/
+/** Take an element out of the ready list
+ *
+ *  @param[in]      pWheel          timer wheel of the session
+ *  @param[in]      pElement        element in the ready list
+ */
+static void trdp_mdReadyRemove (
+    TRDP_MD_TIMER_T *pWheel,
+    MD_ELE_T        *pElement)
+{
+    *pElement->ppPrevReady = pElement->pNextReady;
+    if (pElement->pNextReady != NULL)
+    {
+        pElement->pNextReady->ppPrevReady = pElement->ppPrevReady;
+    }
+    else
+    {
+        pWheel->ppReadyTail = pElement->ppPrevReady;
+    }
+    pElement->pNextReady    = NULL;
+    pElement->ppPrevReady   = NULL;
+    pWheel->stats.numReady--;
+}
+
+/**********************************************************************************************************************/
+/** Schedule an MD session after its state or timeToGo has changed
+ *  Armed sessions are appended to the ready list for trdp_mdSend(), the timer is (re-)started with timeToGo unless
+ *  the interval is infinite.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pElement        MD session in one of the MD queues
+ */
+void trdp_mdTimerSchedule (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement)
+{
+    TRDP_MD_TIMER_T *pWheel = &appHandle->mdTimer;
+
+    switch (pElement->stateEle)
+    {
+       case TRDP_ST_TX_NOTIFY_ARM:
+       case TRDP_ST_TX_REQUEST_ARM:
+       case TRDP_ST_TX_REPLY_ARM:
+       case TRDP_ST_TX_REPLYQUERY_ARM:
+       case TRDP_ST_TX_CONFIRM_ARM:
+           if (pElement->ppPrevReady == NULL)
+           {
+               if (pWheel->ppReadyTail == NULL)
+               {
+                   pWheel->ppReadyTail = &pWheel->pReady;
+               }
+               pElement->pNextReady    = NULL;
+               pElement->ppPrevReady   = pWheel->ppReadyTail;
+               *pWheel->ppReadyTail    = pElement;
+               pWheel->ppReadyTail     = &pElement->pNextReady;
+               pWheel->stats.numReady++;
+           }
+           break;
+       default:
+           break;
+    }
+
+    if (pElement->ppPrevTimer != NULL)
+    {
+        trdp_mdTimerRemove(pWheel, pElement);
+    }
+    if ((pElement->interval.tv_sec != TRDP_MD_INFINITE_TIME) ||
+        (pElement->interval.tv_usec != TRDP_MD_INFINITE_USEC_TIME))
+    {
+        if (pWheel->stats.numTimers == 0u)
+        {
+            /* the wheel is empty, start it from now */
+            TRDP_TIME_T now;
+
+            vos_getTime(&now);
+            pWheel->curTick = trdp_mdTimerTick(&now, FALSE);
+        }
+        trdp_mdTimerAdd(pWheel, pElement, trdp_mdTimerTick(&pElement->timeToGo, TRUE));
+    }
+}
+
+/**********************************************************************************************************************/
+/** Remove an MD session from the timer wheel and the ready list before it is freed
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pElement        MD session
+ */
+void trdp_mdTimerCancel (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement)
+{
+    if (pElement->ppPrevTimer != NULL)
+    {
+        trdp_mdTimerRemove(&appHandle->mdTimer, pElement);
+    }
+    if (pElement->ppPrevReady != NULL)
+    {
+        trdp_mdReadyRemove(&appHandle->mdTimer, pElement);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Advance the timer wheel up to now
+ *  The timers of the passed ticks are moved to the list of due timers, the timers of the coarser levels are cascaded
+ *  down when their slot comes up. Ticks without any timer of the finest level are skipped slot by slot.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pNow            current time
+ */
+void trdp_mdTimerExpire (
+    TRDP_SESSION_PT     appHandle,
+    const TRDP_TIME_T   *pNow)
+{
+    TRDP_MD_TIMER_T *pWheel = &appHandle->mdTimer;
+    UINT32          nowTick = trdp_mdTimerTick(pNow, FALSE);
+    MD_ELE_T        *pElement;
+
+    while ((pWheel->stats.numTimers != 0u) && ((INT32) (nowTick - pWheel->curTick) >= 0))
+    {
+        UINT32 slot = pWheel->curTick & (TRDP_MD_TIMER_SLOTS - 1u);
+
+        if (slot == 0u)
+        {
+            UINT32 level;
+
+            /* entering a new slot of the next level: spread its timers over the finer levels */
+            for (level = 1u; level < TRDP_MD_TIMER_LEVELS; level++)
+            {
+                UINT32 upper = (pWheel->curTick >> (TRDP_MD_TIMER_SLOT_BITS * level)) & (TRDP_MD_TIMER_SLOTS - 1u);
+
+                while ((pElement = pWheel->pSlot[level][upper]) != NULL)
+                {
+                    trdp_mdTimerRemove(pWheel, pElement);
+                    trdp_mdTimerAdd(pWheel, pElement, trdp_mdTimerTick(&pElement->timeToGo, TRUE));
+                    pWheel->stats.numCascaded++;
+                }
+                if (upper != 0u)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (pWheel->stats.numPerLevel[0] == 0u)
+        {
+            /* nothing on the finest level, go to the next cascade but not beyond now */
+            UINT32 next = (pWheel->curTick | (TRDP_MD_TIMER_SLOTS - 1u)) + 1u;
+
+            pWheel->curTick = ((INT32) (next - nowTick) > 0) ? nowTick + 1u : next;
+            continue;
+        }
+
+        while ((pElement = pWheel->pSlot[0][slot]) != NULL)
+        {
+            trdp_mdTimerRemove(pWheel, pElement);
+            pElement->timerLevel    = TRDP_MD_TIMER_LEVELS;
+            pElement->pNextTimer    = pWheel->pDue;
+            pElement->ppPrevTimer   = &pWheel->pDue;
+            if (pWheel->pDue != NULL)
+            {
+                pWheel->pDue->ppPrevTimer = &pElement->pNextTimer;
+            }
+            pWheel->pDue = pElement;
+            pWheel->stats.numExpired++;
+        }
+        pWheel->curTick++;
+    }
+    if ((INT32) (nowTick - pWheel->curTick) >= 0)
+    {
+        pWheel->curTick = nowTick + 1u;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Take the next due timer
+ *
+ *  @param[in]      appHandle       session pointer
+ *
+ *  @retval         MD session with an expired timer or NULL
+ */
+MD_ELE_T *trdp_mdTimerNextDue (
+    TRDP_SESSION_PT appHandle)
+{
+    MD_ELE_T *pElement = appHandle->mdTimer.pDue;
+
+    if (pElement != NULL)
+    {
+        trdp_mdTimerRemove(&appHandle->mdTimer, pElement);
+    }
+    return pElement;
+}
+
+/**********************************************************************************************************************/
+/** Time until the MD timer wheel needs to be serviced by trdp_mdSend()/trdp_mdCheckTimeouts()
+ *  This is the next expiring timer of the finest level or the next cascade of the coarser levels, whichever comes
+ *  first. Sessions in the ready list or with due timers need service with the next tick.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pNow            current time
+ *  @param[out]     pInterval       time from now
+ *
+ *  @retval         TRUE            interval set
+ *  @retval         FALSE           no timer running, no session armed
+ */
+BOOL8 trdp_mdTimerInterval (
+    TRDP_SESSION_PT     appHandle,
+    const TRDP_TIME_T   *pNow,
+    TRDP_TIME_T         *pInterval)
+{
+    TRDP_MD_TIMER_T *pWheel     = &appHandle->mdTimer;
+    UINT32          nowTick     = trdp_mdTimerTick(pNow, FALSE);
+    UINT32          tick        = pWheel->curTick;
+    UINT32          delta;
+    UINT32          i;
+
+    if ((pWheel->pReady != NULL) || (pWheel->pDue != NULL))
+    {
+        tick = nowTick + 1u;
+    }
+    else if (pWheel->stats.numTimers == 0u)
+    {
+        return FALSE;
+    }
+    else
+    {
+        for (i = 0u; i < TRDP_MD_TIMER_SLOTS; i++, tick++)
+        {
+            if (((tick & (TRDP_MD_TIMER_SLOTS - 1u)) == 0u) &&
+                (pWheel->stats.numTimers != pWheel->stats.numPerLevel[0]))
+            {
+                break;      /* timers of the coarser levels are cascaded here */
+            }
+            if ((pWheel->stats.numPerLevel[0] != 0u) &&
+                (pWheel->pSlot[0][tick & (TRDP_MD_TIMER_SLOTS - 1u)] != NULL))
+            {
+                break;
+            }
+        }
+    }
 
-        }
+    if ((INT32) (tick - nowTick) <= 0)
+    {
+        pInterval->tv_sec   = 0;
+        pInterval->tv_usec  = 0;
     }
-    return NULL;
+    else
+    {
+        delta = (tick - nowTick) * TRDP_MD_TIMER_TICK - ((UINT32) pNow->tv_usec % TRDP_MD_TIMER_TICK);
+        pInterval->tv_sec   = delta / 1000000u;
+        pInterval->tv_usec  = (INT32) (delta % 1000000u);
+    }
+    return TRUE;
 }
 
 /**********************************************************************************************************************/
-/** Delete an element
+/** Take the oldest MD session of the ready list
  *
- *  @param[in]      ppHead          pointer to pointer to head of queue
- *  @param[in]      pDelete         pointer to element to delete
+ *  @param[in]      appHandle       session pointer
+ *
+ *  @retval         armed MD session or NULL
  */
-void    trdp_queueDelElement (
-    PD_ELE_T    * *ppHead,
-    PD_ELE_T    *pDelete)
+MD_ELE_T *trdp_mdTimerNextReady (
+    TRDP_SESSION_PT appHandle)
 {
-    PD_ELE_T *iterPD;
+    MD_ELE_T *pElement = appHandle->mdTimer.pReady;
 
-    if (ppHead == NULL || *ppHead == NULL || pDelete == NULL)
+    if (pElement != NULL)
     {
-        return;
+        trdp_mdReadyRemove(&appHandle->mdTimer, pElement);
     }
+    return pElement;
+}
 
-    /* handle removal of first element */
-    if (pDelete == *ppHead)
-    {
-        *ppHead = pDelete->pNext;
-        return;
-    }
+/**********************************************************************************************************************/
+/** Free the receive buffer of a TCP connection and a partially received frame
+ *
+ *  @param[in,out]  pSocket             socket pool entry
+ */
+void trdp_releaseTcpRcv (TRDP_SOCKETS_T *pSocket)
+{
+    TRDP_TCP_RCV_T *pRcv = pSocket->tcpParams.pRcv;
 
-    for (iterPD = *ppHead; iterPD != NULL; iterPD = iterPD->pNext)
+    if (pRcv != NULL)
     {
-        if (iterPD->pNext && iterPD->pNext == pDelete)
+        if (pRcv->pPacket != NULL)
         {
-            iterPD->pNext = pDelete->pNext;
-            return;
+            vos_memFree(pRcv->pPacket);
         }
+        vos_memFree(pRcv->pBuf);
+        vos_memFree(pRcv);
+        pSocket->tcpParams.pRcv = NULL;
     }
 }
 
-
 /**********************************************************************************************************************/
-/** Check topography counters
- *  The applied conformance pattern follows Table A.5/A.21 (positive match):
- *  Telegram to be sent   Locally stored value (appSession)
- *  Case etbTopoCnt opTrnTopoCnt etbTopoCntFilter opTrnTopoCntFilter
- *  1    any        any          0                0
- *  2    any        equal        0                equal
- *  3    equal      any          equal            0
- *  4    equal      equal        equal            equal
+/** Free the send queue of a TCP connection, unsent data is dropped
  *
- *  @param[in]      etbTopoCnt              ETB topography counter to be checked
- *  @param[in]      opTrnTopoCnt            Operational topography counter to be checked
- *  @param[in]      etbTopoCntFilter        ETB topography counter filter value
- *  @param[in]      opTrnTopoCntFilter      Operational topography counter filter value
- *
- *  @retval         TRUE           Filter criteria matched
- *                  FALSE          Filter criteria not matched
+ *  @param[in,out]  pSocket             socket pool entry
  */
-BOOL8 trdp_validTopoCounters (
-    UINT32  etbTopoCnt,
-    UINT32  opTrnTopoCnt,
-    UINT32  etbTopoCntFilter,
-    UINT32  opTrnTopoCntFilter)
+void trdp_releaseTcpSnd (TRDP_SOCKETS_T *pSocket)
 {
-    if (((etbTopoCntFilter == 0) || (etbTopoCnt == etbTopoCntFilter))
-        &&
-        ((opTrnTopoCntFilter == 0) || (opTrnTopoCnt == opTrnTopoCntFilter)))
-    {
-        return TRUE;
-    }
-    else
+    TRDP_TCP_SND_T *pSnd = pSocket->tcpParams.pSnd;
+
+    if (pSnd != NULL)
     {
-        return FALSE;
+        if (pSnd->pBuf != NULL)
+        {
+            vos_memFree(pSnd->pBuf);
+        }
+        vos_memFree(pSnd);
+        pSocket->tcpParams.pSnd = NULL;
     }
 }
+#endif
 
-#if MD_SUPPORT
 /**********************************************************************************************************************/
-/** Return the element with same comId from MD queue
+/** Allocate the ring of PD receive buffers of a session
  *
- *  @param[in]      pHead           pointer to head of queue
- *  @param[in]      addr            Pub/Sub handle (Address, ComID, srcIP & dest IP) to search for
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
  *
- *  @retval         != NULL         pointer to PD element
- *  @retval         NULL            No PD element found
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory, nothing allocated
  */
-MD_ELE_T *trdp_MDqueueFindAddr (
-    MD_ELE_T            *pHead,
-    TRDP_ADDRESSES_T    *addr)
+TRDP_ERR_T trdp_allocRcvRing (TRDP_APP_SESSION_T appHandle)
 {
-    MD_ELE_T *iterMD;
+    UINT32 idx;
 
-    if (pHead == NULL || addr == NULL)
+    for (idx = 0u; idx < TRDP_PD_RCV_BATCH_SIZE; idx++)
     {
-        return NULL;
+        appHandle->pRcvRing[idx] = (PD_PACKET_T *) vos_memAlloc(TRDP_MAX_PD_PACKET_SIZE);
+        if (appHandle->pRcvRing[idx] == NULL)
+        {
+            trdp_freeRcvRing(appHandle);
+            return TRDP_MEM_ERR;
+        }
     }
+    return TRDP_NO_ERR;
+}
 
-    for (iterMD = pHead; iterMD != NULL; iterMD = iterMD->pNext)
+/**********************************************************************************************************************/
+/** Free the ring of PD receive buffers of a session
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ */
+void trdp_freeRcvRing (TRDP_APP_SESSION_T appHandle)
+{
+    UINT32 idx;
+
+    for (idx = 0u; idx < TRDP_PD_RCV_BATCH_SIZE; idx++)
     {
-        /*  We match if src/dst address is zero or found */
-        if ((iterMD->addr.comId == addr->comId)
-            && ((addr->srcIpAddr == 0) || (iterMD->addr.srcIpAddr == addr->srcIpAddr))
-            && ((addr->destIpAddr == 0) || (iterMD->addr.destIpAddr == addr->destIpAddr)))
+        if (appHandle->pRcvRing[idx] != NULL)
         {
-            return iterMD;
+            /* Frames are swapped with the subscriptions' frames, it may come from the arena */
+            trdp_arenaFree(appHandle, TRDP_ARENA_SUB_FRAME, appHandle->pRcvRing[idx]);
+            appHandle->pRcvRing[idx] = NULL;
         }
     }
-    return NULL;
 }
 
 /**********************************************************************************************************************/
-/** Delete an element from MD queue
+/** Compute the block sizes and counts of an arena
  *
- *  @param[in]      ppHead          pointer to pointer to head of queue
- *  @param[in]      pDelete         pointer to element to delete
+ *  @param[in]      pArenaConfig        sizes
+ *  @param[out]     blockSize           size of the blocks per slab
+ *  @param[out]     noOfBlocks          number of blocks per slab
+ *
+ *  @retval         total size of the arena
  */
-void    trdp_MDqueueDelElement (
-    MD_ELE_T    * *ppHead,
-    MD_ELE_T    *pDelete)
+static UINT32 trdp_arenaLayout (
+    const TRDP_ARENA_CONFIG_T   *pArenaConfig,
+    UINT32                      blockSize[TRDP_ARENA_SLABS],
+    UINT32                      noOfBlocks[TRDP_ARENA_SLABS])
 {
-    MD_ELE_T *iterMD;
-
-    if (ppHead == NULL || *ppHead == NULL || pDelete == NULL)
+    UINT32 slab, size = 0u;
+
+    blockSize[TRDP_ARENA_PUB_ELE]       = sizeof(PD_ELE_T);
+    blockSize[TRDP_ARENA_PUB_FRAME]     = TRDP_MAX_PD_PACKET_SIZE;
+    blockSize[TRDP_ARENA_SUB_ELE]       = sizeof(PD_ELE_T);
+    blockSize[TRDP_ARENA_SUB_FRAME]     = TRDP_MAX_PD_PACKET_SIZE;
+    blockSize[TRDP_ARENA_SEQ_CNT]       = TRDP_SEQ_CNT_START_ARRAY_SIZE * sizeof(TRDP_SEQ_CNT_ENTRY_T) +
+                                          sizeof(TRDP_SEQ_CNT_LIST_T);
+    blockSize[TRDP_ARENA_SEQ_CNT_FULL]  = TRDP_SEQ_CNT_MAX_ARRAY_SIZE * sizeof(TRDP_SEQ_CNT_ENTRY_T) +
+                                          sizeof(TRDP_SEQ_CNT_LIST_T);
+    noOfBlocks[TRDP_ARENA_PUB_ELE]      = pArenaConfig->maxNoOfPublishers;
+    noOfBlocks[TRDP_ARENA_PUB_FRAME]    = pArenaConfig->maxNoOfPubFrames;
+    noOfBlocks[TRDP_ARENA_SUB_ELE]      = pArenaConfig->maxNoOfSubscribers;
+    noOfBlocks[TRDP_ARENA_SUB_FRAME]    = pArenaConfig->maxNoOfSubFrames;
+    noOfBlocks[TRDP_ARENA_SEQ_CNT]      = pArenaConfig->maxNoOfSeqCntLists;
+    noOfBlocks[TRDP_ARENA_SEQ_CNT_FULL] = pArenaConfig->maxNoOfFullSeqCntLists;
+#if MD_SUPPORT
+    blockSize[TRDP_ARENA_MD_ELE]        = sizeof(MD_ELE_T);
+    noOfBlocks[TRDP_ARENA_MD_ELE]       = pArenaConfig->maxNoOfMdElements;
+#else
+    blockSize[TRDP_ARENA_MD_ELE]        = 0u;
+    noOfBlocks[TRDP_ARENA_MD_ELE]       = 0u;
+#endif
+    for (slab = 0u; slab < TRDP_ARENA_SLABS; slab++)
     {
-        return;
+        /* Blocks are aligned to pointers, the first word links the free blocks */
+        blockSize[slab] = (blockSize[slab] + (UINT32) sizeof(void *) - 1u) & ~((UINT32) sizeof(void *) - 1u);
+        size += blockSize[slab] * noOfBlocks[slab];
     }
+    return size;
+}
 
-    /*    handle removal of first element    */
-    if (pDelete == *ppHead)
+/**********************************************************************************************************************/
+/** Return the memory needed for an arena
+ *
+ *  @param[in]      pArenaConfig        sizes
+ *
+ *  @retval         size in bytes
+ */
+UINT32 trdp_arenaSize (
+    const TRDP_ARENA_CONFIG_T *pArenaConfig)
+{
+    UINT32  blockSize[TRDP_ARENA_SLABS];
+    UINT32  noOfBlocks[TRDP_ARENA_SLABS];
+
+    return trdp_arenaLayout(pArenaConfig, blockSize, noOfBlocks);
+}
+
+/**********************************************************************************************************************/
+/** Set up the arena of a session: one contiguous area, cut into slabs of free blocks
+ *  Each slab is only used by the holder of one session mutex (see TRDP_ARENA_SLAB_T), the arena has no lock.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pArenaConfig        sizes and optional memory
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      no sizes or supplied memory too small/unaligned
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+TRDP_ERR_T trdp_arenaCreate (
+    TRDP_SESSION_PT             appHandle,
+    const TRDP_ARENA_CONFIG_T   *pArenaConfig)
+{
+    TRDP_ARENA_T    *pArena = &appHandle->arena;
+    UINT32          blockSize[TRDP_ARENA_SLABS];
+    UINT32          noOfBlocks[TRDP_ARENA_SLABS];
+    UINT32          size, slab, idx;
+    UINT8           *pBlock;
+
+    size = trdp_arenaLayout(pArenaConfig, blockSize, noOfBlocks);
+    if (size == 0u)
     {
-        *ppHead = pDelete->pNext;
-        return;
+        return TRDP_PARAM_ERR;
+    }
+    if (pArenaConfig->p != NULL)
+    {
+        if ((pArenaConfig->size < size) || (((uintptr_t) pArenaConfig->p & (sizeof(void *) - 1u)) != 0u))
+        {
+            return TRDP_PARAM_ERR;
+        }
+        pArena->pArea = pArenaConfig->p;
+    }
+    else
+    {
+        pArena->pArea = (UINT8 *) vos_memAlloc(size);
+        if (pArena->pArea == NULL)
+        {
+            return TRDP_MEM_ERR;
+        }
+        pArena->wasAllocated = TRUE;
     }
+    pArena->size = size;
 
-    for (iterMD = *ppHead; iterMD != NULL; iterMD = iterMD->pNext)
+    pBlock = pArena->pArea;
+    for (slab = 0u; slab < TRDP_ARENA_SLABS; slab++)
     {
-        if (iterMD->pNext && iterMD->pNext == pDelete)
+        TRDP_SLAB_T *pSlab = &pArena->slab[slab];
+
+        pSlab->pStart       = pBlock;
+        pSlab->blockSize    = blockSize[slab];
+        pSlab->noOfBlocks   = noOfBlocks[slab];
+        pSlab->pFree        = NULL;
+        /* Link from the end, the blocks are handed out in address order */
+        for (idx = noOfBlocks[slab]; idx > 0u; idx--)
         {
-            iterMD->pNext = pDelete->pNext;
-            return;
+            void **ppLink = (void **) (pBlock + (idx - 1u) * blockSize[slab]);
+
+            *ppLink         = pSlab->pFree;
+            pSlab->pFree    = ppLink;
         }
+        pBlock      += blockSize[slab] * noOfBlocks[slab];
+        pSlab->pEnd = pBlock;
     }
+    return TRDP_NO_ERR;
 }
 
 /**********************************************************************************************************************/
-/** Append an element at end of queue
+/** Release the arena of a session, all blocks must have been returned
  *
- *  @param[in]      ppHead          pointer to pointer to head of queue
- *  @param[in]      pNew            pointer to element to append
+ *  @param[in]      appHandle           session pointer
  */
-void    trdp_MDqueueAppLast (
-    MD_ELE_T    * *ppHead,
-    MD_ELE_T    *pNew)
+void trdp_arenaDestroy (
+    TRDP_SESSION_PT appHandle)
 {
-    MD_ELE_T *iterMD;
+    TRDP_ARENA_T *pArena = &appHandle->arena;
 
-    if (ppHead == NULL || pNew == NULL)
+    if (pArena->pArea != NULL)
     {
-        return;
+        if (pArena->wasAllocated == TRUE)
+        {
+            vos_memFree(pArena->pArea);
+        }
+        memset(pArena, 0, sizeof(TRDP_ARENA_T));
     }
+}
 
-    /* Ensure this element is last! */
-    pNew->pNext = NULL;
+/**********************************************************************************************************************/
+/** Get a cleared block from the arena, from vos_memAlloc if there is no arena or the slab is exhausted
+ *  The caller must hold the session mutex owning the slab (see TRDP_ARENA_SLAB_T).
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      slab                kind of block
+ *  @param[in]      size                size needed
+ *
+ *  @retval         pointer to the block or NULL
+ */
+void *trdp_arenaAlloc (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_ARENA_SLAB_T   slab,
+    UINT32              size)
+{
+    TRDP_SLAB_T *pSlab      = &appHandle->arena.slab[slab];
+    void        **ppBlock   = NULL;
 
-    if (*ppHead == NULL)
+    if ((appHandle->arena.pArea != NULL) && (size <= pSlab->blockSize))
     {
-        *ppHead = pNew;
-        return;
+        ppBlock = (void **) pSlab->pFree;
+        if (ppBlock != NULL)
+        {
+            pSlab->pFree = *ppBlock;
+            pSlab->used++;
+        }
+        else
+        {
+            pSlab->overflow++;
+        }
     }
-
-    for (iterMD = *ppHead; iterMD->pNext != NULL; iterMD = iterMD->pNext)
+    if (ppBlock == NULL)
     {
-        ;
+        return vos_memAlloc(size);
     }
-    iterMD->pNext = pNew;
+    /* Cleared like a block from vos_memAlloc */
+    memset(ppBlock, 0, size);
+    return ppBlock;
 }
 
 /**********************************************************************************************************************/
-/** Insert an element at front of MD queue
+/** Return a block from trdp_arenaAlloc (or vos_memAlloc) of the same kind
+ *  The caller must hold the session mutex owning the slab (see TRDP_ARENA_SLAB_T).
  *
- *  @param[in]      ppHead          pointer to pointer to head of queue
- *  @param[in]      pNew            pointer to element to insert
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      slab                kind of block, as passed to trdp_arenaAlloc
+ *  @param[in]      pBlock              block to free
  */
-void    trdp_MDqueueInsFirst (
-    MD_ELE_T    * *ppHead,
-    MD_ELE_T    *pNew)
+void trdp_arenaFree (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_ARENA_SLAB_T   slab,
+    void                *pBlock)
 {
-    if (ppHead == NULL || pNew == NULL)
+    TRDP_SLAB_T *pSlab = &appHandle->arena.slab[slab];
+
+    /* Not from the slab: the slab was exhausted or the block was swapped in from vos_memAlloc */
+    if (((UINT8 *) pBlock < pSlab->pStart) || ((UINT8 *) pBlock >= pSlab->pEnd))
     {
+        vos_memFree(pBlock);
         return;
     }
-
-    pNew->pNext = *ppHead;
-    *ppHead     = pNew;
+    *(void **) pBlock   = pSlab->pFree;
+    pSlab->pFree        = pBlock;
+    pSlab->used--;
 }
 
 /**********************************************************************************************************************/
-/** Initialize the UncompletedTCP pointers to null
+/** Return the sequence counter list of a subscription to the slab it was taken from
  *
- *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pSeqCntList         list to free
  */
-void trdp_initUncompletedTCP (TRDP_APP_SESSION_T appHandle)
+void trdp_seqCntFree (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_SEQ_CNT_LIST_T *pSeqCntList)
 {
-    int lIndex;
-    /* Initialize the pointers to Null */
-    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
-    {
-        appHandle->uncompletedTCP[lIndex] = NULL;
-    }
+    trdp_arenaFree(appHandle,
+                   (pSeqCntList->maxNoOfEntries > TRDP_SEQ_CNT_START_ARRAY_SIZE) ? TRDP_ARENA_SEQ_CNT_FULL :
+                   TRDP_ARENA_SEQ_CNT, pSeqCntList);
 }
-#endif
+
 
 /**********************************************************************************************************************/
 /** Append an element at end of queue
@@ -949,6 +2397,9 @@ void trdp_initSockets (
     {
         iface[lIndex].sock = VOS_INVALID_SOCKET;
         iface[lIndex].type = TRDP_SOCK_INVAL;
+        iface[lIndex].tcpParams.pRcv = NULL;
+        iface[lIndex].tcpParams.pSnd = NULL;
+        iface[lIndex].pollSock = VOS_INVALID_SOCKET;
     }
 }
 
@@ -1031,7 +2482,9 @@ TRDP_ERR_T  trdp_requestSocket (
                  && (iface[lIndex].rcvMostly == rcvMostly)
                  && ((type != TRDP_SOCK_MD_TCP)
                      || ((type == TRDP_SOCK_MD_TCP) && (iface[lIndex].tcpParams.cornerIp == cornerIp) &&
-                         (iface[lIndex].usage == 0))))
+                         /* whole frames are queued per connection, with shareTcp a connection in use is shared */
+                         ((iface[lIndex].usage == 0) ||
+                          ((iface[lIndex].tcpParams.shared == TRUE) && (iface[lIndex].tcpParams.morituri == FALSE))))))
         {
             /*  Did this socket join the required multicast group?  */
             if (mcGroup != 0 && trdp_SockIsJoined(iface[lIndex].mcGroups, mcGroup) == FALSE)
@@ -1130,6 +2583,7 @@ TRDP_ERR_T  trdp_requestSocket (
         }
 
         iface[lIndex].sock      = VOS_INVALID_SOCKET;
+        iface[lIndex].pollSock  = VOS_INVALID_SOCKET;
         iface[lIndex].bindAddr  = bindAddr /* was srcIP (ID #125) */;
         iface[lIndex].srcAddr   = srcIP;
         iface[lIndex].type      = type;
@@ -1140,8 +2594,8 @@ TRDP_ERR_T  trdp_requestSocket (
         iface[lIndex].tcpParams.cornerIp    = cornerIp;
         iface[lIndex].tcpParams.sendNotOk   = FALSE;
         iface[lIndex].usage = 0;
-        iface[lIndex].tcpParams.notSend     = FALSE;
         iface[lIndex].tcpParams.morituri    = FALSE;
+        iface[lIndex].tcpParams.shared      = FALSE;
         iface[lIndex].tcpParams.sendingTimeout.tv_sec   = 0;
         iface[lIndex].tcpParams.sendingTimeout.tv_usec  = 0;
 
@@ -1174,6 +2628,7 @@ TRDP_ERR_T  trdp_requestSocket (
         sock_options.ttl_multicast  = (type != TRDP_SOCK_MD_TCP) ? params->ttl : 0;
         sock_options.no_mc_loop     = ((type != TRDP_SOCK_MD_TCP) && (options & TRDP_OPTION_NO_MC_LOOP_BACK)) ? 1 : 0;
         sock_options.no_udp_crc     = ((type != TRDP_SOCK_MD_TCP) && (options & TRDP_OPTION_NO_UDP_CHK)) ? 1 : 0;
+        sock_options.noDelay        = (type == TRDP_SOCK_MD_TCP) ? TRUE : FALSE;  /* frames are coalesced by the send queue */
         sock_options.vlanId         = params->vlan;
         sock_options.ifName[0]      = 0;
         switch (type)
@@ -1443,12 +2898,15 @@ void  trdp_releaseSocket (
                 {
                     vos_printLog(VOS_LOG_ERROR, "vos_sockClose() failed (Err:%d)\n", err);
                 }
+                trdp_releaseTcpRcv(&iface[lIndex]);
+                trdp_releaseTcpSnd(&iface[lIndex]);
 
                 /* Delete the socket from the iface */
                 vos_printLog(VOS_LOG_INFO,
                              "Deleting socket from the iface (Sock: %d, lIndex: %d)\n",
                              (int) iface[lIndex].sock, lIndex);
                 iface[lIndex].sock = TRDP_INVALID_SOCKET_INDEX;
+                iface[lIndex].pollSock = VOS_INVALID_SOCKET;    /* the close took it out of the poll set */
                 iface[lIndex].sendParam.qos = 0;
                 iface[lIndex].sendParam.ttl = 0;
                 iface[lIndex].usage         = 0;
@@ -1494,6 +2952,7 @@ void  trdp_releaseSocket (
                     vos_printLog(VOS_LOG_DBG, "Closed socket %d\n", (int) iface[lIndex].sock);
                 }
                 iface[lIndex].sock = VOS_INVALID_SOCKET;
+                iface[lIndex].pollSock = VOS_INVALID_SOCKET;
             }
             else if (mcGroupUsed != VOS_INADDR_ANY) /* Check for MC usage (close socket will unjoin MC anyway) */
             {
@@ -1554,6 +3013,133 @@ void  trdp_releaseSocket (
     }
 }
 
+/**********************************************************************************************************************/
+/** Home slot of a sender in the sequence counter table
+ *
+ *  @param[in]      srcIP               Source IP address
+ *  @param[in]      msgType             message type
+ *  @param[in]      mask                no. of slots - 1
+ *
+ *  @retval         slot index
+ */
+static UINT32 trdp_seqCntSlot (
+    TRDP_IP_ADDR_T  srcIP,
+    TRDP_MSG_T      msgType,
+    UINT32          mask)
+{
+    UINT32 hash = (srcIP ^ ((UINT32) msgType << 16u)) * 0x9E3779B1u;
+
+    return (hash ^ (hash >> 16u)) & mask;
+}
+
+/**********************************************************************************************************************/
+/** Find the slot of a sender, or the free slot ending its probe sequence
+ *
+ *  @param[in]      pList               sequence counter table
+ *  @param[in]      srcIP               Source IP address
+ *  @param[in]      msgType             message type
+ *
+ *  @retval         slot index
+ */
+static UINT32 trdp_seqCntFind (
+    const TRDP_SEQ_CNT_LIST_T   *pList,
+    TRDP_IP_ADDR_T              srcIP,
+    TRDP_MSG_T                  msgType)
+{
+    UINT32  mask    = (UINT32) pList->maxNoOfEntries - 1u;
+    UINT32  idx     = trdp_seqCntSlot(srcIP, msgType, mask);
+
+    while ((pList->seq[idx].msgType != 0u) &&
+           ((pList->seq[idx].srcIpAddr != srcIP) || (pList->seq[idx].msgType != msgType)))
+    {
+        idx = (idx + 1u) & mask;
+    }
+    return idx;
+}
+
+/**********************************************************************************************************************/
+/** Remove a sender not received since the clock hand passed it (second chance), following entries of the cluster
+ *  are moved back (no tombstones). Each slot passed costs one reception or one eviction, O(1) amortised.
+ *
+ *  @param[in]      pList               sequence counter table
+ */
+static void trdp_seqCntEvict (
+    TRDP_SEQ_CNT_LIST_T *pList)
+{
+    UINT32  mask    = (UINT32) pList->maxNoOfEntries - 1u;
+    UINT32  idx     = pList->hand & mask;
+    UINT32  next;
+
+    /* The table is half full: after one revolution at most, the hand stops at a sender */
+    while ((pList->seq[idx].msgType == 0u) || (pList->seq[idx].referenced == TRUE))
+    {
+        pList->seq[idx].referenced  = FALSE;
+        idx                         = (idx + 1u) & mask;
+    }
+    pList->hand = idx;      /* the gap may be filled by the next entry of the cluster, check it next time */
+    vos_printLog(VOS_LOG_DBG, "*** sequence entry evicted (SrcIp: %s)\n", vos_ipDotted(pList->seq[idx].srcIpAddr));
+
+    for (next = (idx + 1u) & mask; pList->seq[next].msgType != 0u; next = (next + 1u) & mask)
+    {
+        UINT32 home = trdp_seqCntSlot(pList->seq[next].srcIpAddr, pList->seq[next].msgType, mask);
+
+        /* Move the entry into the gap if its home slot is not between the gap and its current position */
+        if (((next - home) & mask) >= ((next - idx) & mask))
+        {
+            pList->seq[idx] = pList->seq[next];
+            idx             = next;
+        }
+    }
+    pList->seq[idx].msgType = 0u;
+    pList->curNoOfEntries--;
+}
+
+/**********************************************************************************************************************/
+/** Double the sequence counter table of a subscription
+ *  With a full size block reserved in the arena the table grows to TRDP_SEQ_CNT_MAX_ARRAY_SIZE at once.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            subscription element
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+static TRDP_ERR_T trdp_seqCntGrow (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement)
+{
+    TRDP_SEQ_CNT_LIST_T *pOld   = pElement->pSeqCntList;
+    UINT32              newSize = 2u * (UINT32) pOld->maxNoOfEntries;
+    TRDP_SEQ_CNT_LIST_T *pNew;
+    UINT32              idx;
+
+    if (appHandle->arena.slab[TRDP_ARENA_SEQ_CNT_FULL].pFree != NULL)
+    {
+        newSize = TRDP_SEQ_CNT_MAX_ARRAY_SIZE;
+    }
+    pNew = (TRDP_SEQ_CNT_LIST_T *) trdp_arenaAlloc(appHandle, TRDP_ARENA_SEQ_CNT_FULL,
+                                                   newSize * sizeof(TRDP_SEQ_CNT_ENTRY_T) +
+                                                   sizeof(TRDP_SEQ_CNT_LIST_T));
+    if (pNew == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pNew->maxNoOfEntries    = (UINT16) newSize;
+    pNew->curNoOfEntries    = pOld->curNoOfEntries;
+    pNew->hand              = 0u;
+    pNew->numEvicted        = pOld->numEvicted;
+    for (idx = 0u; idx < pOld->maxNoOfEntries; idx++)
+    {
+        if (pOld->seq[idx].msgType != 0u)
+        {
+            pNew->seq[trdp_seqCntFind(pNew, pOld->seq[idx].srcIpAddr, pOld->seq[idx].msgType)] = pOld->seq[idx];
+        }
+    }
+    trdp_seqCntFree(appHandle, pOld);   /* Free old area */
+    pElement->pSeqCntList = pNew;
+    return TRDP_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** remove the sequence counter for the comID/source IP.
  *  The sequence counter should be reset if there was a packet time out.
@@ -1571,20 +3157,16 @@ void trdp_resetSequenceCounter (
     TRDP_IP_ADDR_T  srcIP,
     TRDP_MSG_T      msgType)
 {
-    int l_index;
+    UINT32 l_index;
 
     if (pElement == NULL || pElement->pSeqCntList == NULL)
     {
         return;
     }
-    /* Loop over entries */
-    for (l_index = 0; l_index < pElement->pSeqCntList->curNoOfEntries; ++l_index)
+    l_index = trdp_seqCntFind(pElement->pSeqCntList, srcIP, msgType);
+    if (pElement->pSeqCntList->seq[l_index].msgType != 0u)
     {
-        if ((srcIP == pElement->pSeqCntList->seq[l_index].srcIpAddr) &&
-            (msgType == pElement->pSeqCntList->seq[l_index].msgType))
-        {
-            pElement->pSeqCntList->seq[l_index].lastSeqCnt = 0;
-        }
+        pElement->pSeqCntList->seq[l_index].lastSeqCnt = 0;
     }
 }
 
@@ -1593,7 +3175,12 @@ void trdp_resetSequenceCounter (
  *  If the comID/srcIP is not found, update it and return 0 -
  *  else if already received, return 1
  *  On memory error, return -1
+ *  The senders are kept in an open addressed table, which grows up to TRDP_SEQ_CNT_MAX_ARRAY_SIZE slots. Beyond,
+ *  a sender not heard of since the clock hand passed it is dropped for a new one (second chance, close to least
+ *  recently used). Drops are counted in the session statistics (numSeqCntEvict) and the first one of a
+ *  subscription is logged.
  *
+ *  @param[in]      appHandle           session pointer
  *  @param[in]      pElement            subscription element
  *  @param[in]      sequenceCounter     sequence counter to check
  *  @param[in]      srcIP               Source IP address
@@ -1605,12 +3192,14 @@ void trdp_resetSequenceCounter (
  */
 
 int trdp_checkSequenceCounter (
+    TRDP_SESSION_PT appHandle,
     PD_ELE_T        *pElement,
     UINT32          sequenceCounter,
     TRDP_IP_ADDR_T  srcIP,
     TRDP_MSG_T      msgType)
 {
-    int l_index;
+    TRDP_SEQ_CNT_ENTRY_T    *pEntry;
+    UINT32                  l_index;
 
     if (pElement == NULL)
     {
@@ -1621,73 +3210,74 @@ int trdp_checkSequenceCounter (
     if (pElement->pSeqCntList == NULL)
     {
         /* Allocate some space */
-        pElement->pSeqCntList = (TRDP_SEQ_CNT_LIST_T *) vos_memAlloc(TRDP_SEQ_CNT_START_ARRAY_SIZE *
-                                                                     sizeof(TRDP_SEQ_CNT_ENTRY_T) +
-                                                                     sizeof(TRDP_SEQ_CNT_LIST_T));
+        pElement->pSeqCntList = (TRDP_SEQ_CNT_LIST_T *) trdp_arenaAlloc(appHandle, TRDP_ARENA_SEQ_CNT,
+                                                                        TRDP_SEQ_CNT_START_ARRAY_SIZE *
+                                                                        sizeof(TRDP_SEQ_CNT_ENTRY_T) +
+                                                                        sizeof(TRDP_SEQ_CNT_LIST_T));
         if (pElement->pSeqCntList == NULL)
         {
             return -1;
         }
         pElement->pSeqCntList->maxNoOfEntries   = TRDP_SEQ_CNT_START_ARRAY_SIZE;
         pElement->pSeqCntList->curNoOfEntries   = 0;
+        pElement->pSeqCntList->hand             = 0u;
+        pElement->pSeqCntList->numEvicted       = 0u;
     }
-    /* Loop over entries */
-    for (l_index = 0; l_index < pElement->pSeqCntList->curNoOfEntries; ++l_index)
+
+    l_index = trdp_seqCntFind(pElement->pSeqCntList, srcIP, msgType);
+    pEntry  = &pElement->pSeqCntList->seq[l_index];
+    if (pEntry->msgType != 0u)
     {
-        if ((srcIP == pElement->pSeqCntList->seq[l_index].srcIpAddr) &&
-            (msgType == pElement->pSeqCntList->seq[l_index].msgType))
+        pEntry->referenced = TRUE;
+
+        /*        Is this packet a duplicate?    */
+        if ((pEntry->lastSeqCnt == 0) ||    /* first time after timeout */
+            (sequenceCounter > pEntry->lastSeqCnt))
         {
-            /*        Is this packet a duplicate?    */
-            if ((pElement->pSeqCntList->seq[l_index].lastSeqCnt == 0) ||    /* first time after timeout */
-                (sequenceCounter > pElement->pSeqCntList->seq[l_index].lastSeqCnt))
-            {
-                /*
-                 vos_printLog(VOS_LOG_DBG,
-                 "Rcv sequence: %u    last seq: %u\n",
-                 sequenceCounter,
-                 pElement->pSeqCntList->seq[l_index].lastSeqCnt);
-                 vos_printLog(VOS_LOG_DBG, "-> new PD data found (SrcIp: %s comId %u)\n", vos_ipDotted(
-                 srcIP), pElement->addr.comId);
-                 */
-                pElement->pSeqCntList->seq[l_index].lastSeqCnt = sequenceCounter;
-                return 0;
-            }
-            else
-            {
-                vos_printLog(VOS_LOG_DBG,
-                             "Rcv sequence: %u    last seq: %u\n",
-                             sequenceCounter,
-                             pElement->pSeqCntList->seq[l_index].lastSeqCnt);
-                vos_printLog(VOS_LOG_DBG, "-> duplicated PD data ignored (SrcIp: %s comId %u)\n", vos_ipDotted(
-                                 srcIP), pElement->addr.comId);
-                return 1;
-            }
+            pEntry->lastSeqCnt = sequenceCounter;
+            return 0;
+        }
+        else
+        {
+            vos_printLog(VOS_LOG_DBG,
+                         "Rcv sequence: %u    last seq: %u\n",
+                         sequenceCounter,
+                         pEntry->lastSeqCnt);
+            vos_printLog(VOS_LOG_DBG, "-> duplicated PD data ignored (SrcIp: %s comId %u)\n", vos_ipDotted(
+                             srcIP), pElement->addr.comId);
+            return 1;
         }
     }
 
-    /* Not found in list, add new entry */
-    if (pElement->pSeqCntList->curNoOfEntries >= pElement->pSeqCntList->maxNoOfEntries)
+    /* Not found in table, add new entry, the table is kept at most half full */
+    if ((((UINT32) pElement->pSeqCntList->curNoOfEntries + 1u) * 2u) > pElement->pSeqCntList->maxNoOfEntries)
     {
-        /* Allocate some more space */
-        UINT16 newSize = 2 * pElement->pSeqCntList->curNoOfEntries;
-        TRDP_SEQ_CNT_LIST_T *newList = (TRDP_SEQ_CNT_LIST_T *) vos_memAlloc(newSize * sizeof(TRDP_SEQ_CNT_ENTRY_T) +
-                                                                            sizeof(TRDP_SEQ_CNT_LIST_T));
-        if (newList == NULL)
+        if (pElement->pSeqCntList->maxNoOfEntries < TRDP_SEQ_CNT_MAX_ARRAY_SIZE)
         {
-            return -1;
+            if (trdp_seqCntGrow(appHandle, pElement) != TRDP_NO_ERR)
+            {
+                return -1;
+            }
         }
-
-        /* Copy old data into new, larger area */
-        memcpy(newList, pElement->pSeqCntList, pElement->pSeqCntList->maxNoOfEntries *
-               sizeof(TRDP_SEQ_CNT_ENTRY_T) +
-               sizeof(TRDP_SEQ_CNT_LIST_T));
-        vos_memFree(pElement->pSeqCntList);     /* Free old area */
-        pElement->pSeqCntList = newList;
-        pElement->pSeqCntList->maxNoOfEntries = newSize;
+        else
+        {
+            if (pElement->pSeqCntList->numEvicted == 0u)
+            {
+                vos_printLog(VOS_LOG_WARNING,
+                             "More than %u senders of comId %u, least recently heard senders are dropped\n",
+                             TRDP_SEQ_CNT_MAX_ARRAY_SIZE / 2u, pElement->addr.comId);
+            }
+            trdp_seqCntEvict(pElement->pSeqCntList);
+            pElement->pSeqCntList->numEvicted++;
+            appHandle->stats.numSeqCntEvict++;
+        }
+        l_index = trdp_seqCntFind(pElement->pSeqCntList, srcIP, msgType);
     }
-    pElement->pSeqCntList->seq[pElement->pSeqCntList->curNoOfEntries].lastSeqCnt    = sequenceCounter;
-    pElement->pSeqCntList->seq[pElement->pSeqCntList->curNoOfEntries].srcIpAddr     = srcIP;
-    pElement->pSeqCntList->seq[pElement->pSeqCntList->curNoOfEntries].msgType       = msgType;
+    pEntry              = &pElement->pSeqCntList->seq[l_index];
+    pEntry->lastSeqCnt  = sequenceCounter;
+    pEntry->srcIpAddr   = srcIP;
+    pEntry->msgType     = msgType;
+    pEntry->referenced  = TRUE;
     pElement->pSeqCntList->curNoOfEntries++;
     vos_printLog(VOS_LOG_DBG, "Rcv sequence: %u\n", sequenceCounter);
     vos_printLog(VOS_LOG_DBG, "*** new sequence entry (SrcIp: %s comId %u)\n", vos_ipDotted(
@@ -17,6 +17,15 @@
 /*
 * $Id: trdp_utils.h 2194 2020-08-07 14:58:59Z bloehr $
 *
+*      AG 2026-10-17: trdp_arenaFree() takes the slab, trdp_seqCntFree()
+*      AG 2026-10-17: trdp_releaseTcpSnd()
+*      AG 2026-10-17: trdp_releaseTcpRcv() replaces trdp_initUncompletedTCP()
+*      AG 2026-10-17: trdp_mdTimerInterval()
+*      AG 2026-10-17: trdp_mdTimerSchedule/Cancel/Expire/NextDue/NextReady()
+*      AG 2026-10-17: trdp_lisIndexAdd/Remove/Find/Free()
+*      AG 2026-10-17: Session arena trdp_arenaCreate/Destroy/Alloc/Free(), trdp_subIndexReserve()
+*      AG 2026-10-17: trdp_subIndexAdd/Remove/Find/Free() replace trdp_idxfindSubAddr()
+*      AG 2026-10-17: trdp_allocRcvRing()/trdp_freeRcvRing() for batched PD reception
 *      BL 2020-08-07: Ticket #317 Bug in trdp_indeedFindSubAddr() (HIGH_PERFORMANCE)
 *      SB 2020-03-30: Ticket #311: removed trdp_getSeqCnt() because redundant publisher should not run on the same interface
 *      BL 2019-06-17: Ticket #264 Provide service oriented interface
@@ -89,13 +98,6 @@ PD_ELE_T        *trdp_findSubAddr (
     TRDP_ADDRESSES_T    *pAddr,
     UINT32              comId);
 
-PD_ELE_T        *trdp_idxfindSubAddr (
-    PD_ELE_T            *array[],
-    UINT32              startIdx,
-    UINT32              maxIdx,
-    TRDP_ADDRESSES_T    *addr,
-    UINT32              comId);
-
 PD_ELE_T        *trdp_queueFindSubAddr (
     PD_ELE_T            *pHead,
     TRDP_ADDRESSES_T    *pAddr);
@@ -104,6 +106,25 @@ PD_ELE_T        *trdp_queueFindExistingSub (
     PD_ELE_T            *pHead,
     TRDP_ADDRESSES_T    *pAddr);
 
+TRDP_ERR_T      trdp_subIndexAdd (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement);
+
+void            trdp_subIndexRemove (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement);
+
+void            trdp_subIndexFree (
+    TRDP_SESSION_PT appHandle);
+
+TRDP_ERR_T      trdp_subIndexReserve (
+    TRDP_SESSION_PT appHandle,
+    UINT32          noOfSubs);
+
+PD_ELE_T        *trdp_subIndexFind (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_ADDRESSES_T    *pAddr);
+
 PD_ELE_T        *trdp_queueFindPubAddr (
     PD_ELE_T            *pHead,
     TRDP_ADDRESSES_T    *addr);
@@ -126,16 +147,69 @@ MD_ELE_T    *trdp_MDqueueFindAddr (
     TRDP_ADDRESSES_T    *addr);
 
 void        trdp_MDqueueDelElement (
-    MD_ELE_T    * *ppHead,
-    MD_ELE_T    *pDelete);
+    MD_ELE_T            * *ppHead,
+    TRDP_MD_SID_INDEX_T *pIndex,
+    MD_ELE_T            *pDelete);
 
 void        trdp_MDqueueAppLast (
-    MD_ELE_T    * *pHead,
-    MD_ELE_T    *pNew);
+    MD_ELE_T            * *pHead,
+    TRDP_MD_SID_INDEX_T *pIndex,
+    MD_ELE_T            *pNew);
 
 void        trdp_MDqueueInsFirst (
-    MD_ELE_T    * *ppHead,
-    MD_ELE_T    *pNew);
+    MD_ELE_T            * *ppHead,
+    TRDP_MD_SID_INDEX_T *pIndex,
+    MD_ELE_T            *pNew);
+
+MD_ELE_T    *trdp_MDqueueFindSession (
+    MD_ELE_T                    *pHead,
+    const TRDP_MD_SID_INDEX_T   *pIndex,
+    const UINT8                 *pSessionId,
+    const MD_ELE_T              *pAfter);
+
+void        trdp_MDqueueFreeIndex (
+    TRDP_MD_SID_INDEX_T *pIndex);
+
+void        trdp_lisIndexAdd (
+    TRDP_SESSION_PT appHandle,
+    MD_LIS_ELE_T    *pNew);
+
+void        trdp_lisIndexRemove (
+    TRDP_SESSION_PT appHandle,
+    MD_LIS_ELE_T    *pDelete);
+
+MD_LIS_ELE_T *trdp_lisIndexFind (
+    TRDP_SESSION_PT     appHandle,
+    BOOL8               checkComId,
+    UINT32              comId,
+    const CHAR8         *pDestURI,
+    const MD_LIS_ELE_T  *pAfter);
+
+void        trdp_lisIndexFree (
+    TRDP_SESSION_PT appHandle);
+
+void        trdp_mdTimerSchedule (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement);
+
+void        trdp_mdTimerCancel (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement);
+
+void        trdp_mdTimerExpire (
+    TRDP_SESSION_PT     appHandle,
+    const TRDP_TIME_T   *pNow);
+
+MD_ELE_T    *trdp_mdTimerNextDue (
+    TRDP_SESSION_PT appHandle);
+
+BOOL8       trdp_mdTimerInterval (
+    TRDP_SESSION_PT     appHandle,
+    const TRDP_TIME_T   *pNow,
+    TRDP_TIME_T         *pInterval);
+
+MD_ELE_T    *trdp_mdTimerNextReady (
+    TRDP_SESSION_PT appHandle);
 #endif
 
 INT32   trdp_getCurrentMaxSocketCnt (
@@ -149,9 +223,42 @@ void trdp_initSockets (
     TRDP_SOCKETS_T  iface[],
     UINT8           noOfEntries);
 
-void    trdp_initUncompletedTCP (
+void    trdp_releaseTcpRcv (
+    TRDP_SOCKETS_T *pSocket);
+
+void    trdp_releaseTcpSnd (
+    TRDP_SOCKETS_T *pSocket);
+
+TRDP_ERR_T  trdp_allocRcvRing (
+    TRDP_APP_SESSION_T appHandle);
+
+void        trdp_freeRcvRing (
     TRDP_APP_SESSION_T appHandle);
 
+UINT32      trdp_arenaSize (
+    const TRDP_ARENA_CONFIG_T *pArenaConfig);
+
+TRDP_ERR_T  trdp_arenaCreate (
+    TRDP_SESSION_PT             appHandle,
+    const TRDP_ARENA_CONFIG_T   *pArenaConfig);
+
+void        trdp_arenaDestroy (
+    TRDP_SESSION_PT appHandle);
+
+void        *trdp_arenaAlloc (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_ARENA_SLAB_T   slab,
+    UINT32              size);
+
+void        trdp_arenaFree (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_ARENA_SLAB_T   slab,
+    void                *pBlock);
+
+void        trdp_seqCntFree (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_SEQ_CNT_LIST_T *pSeqCntList);
+
 void    trdp_resetSequenceCounter (
     PD_ELE_T        *pElement,
     TRDP_IP_ADDR_T  srcIP,
@@ -192,6 +299,7 @@ UINT32  trdp_packetSizeMD (
     UINT32 dataSize);
 
 int trdp_checkSequenceCounter (
+    TRDP_SESSION_PT appHandle,
     PD_ELE_T        *pElement,
     UINT32          sequenceCounter,
     TRDP_IP_ADDR_T  srcIP,
@@ -18,6 +18,9 @@
  /*
  * $Id: vos_mem.h 2077 2019-09-06 08:41:15Z bloehr $
  *
+ *      AG 2026-10-17: Per thread magazines capped by memory area size
+ *      AG 2026-10-17: Per block size statistics vos_memClassCount(), allocation site tags in DEBUG builds
+ *      AG 2026-10-17: VOS_QUEUE_POLICY_LOCKFREE, vos_queueSendCopy(), vos_queueReceiveCopy()
  *      BL 2019-09-06: Default pre-allocated blocks for HIGH_PERF raised again
  *      BL 2019-08-15: Default pre-allocated blocks for HIGH_PERF raised
  *      BL 2017-05-08: Compiler warnings, doxygen comment errors
@@ -47,13 +50,15 @@ extern "C" {
 #endif
 
 #define VOS_MEM_NBLOCKSIZES         15u  /**< No of pre-defined block sizes */
+#define VOS_QUEUE_INLINE_SIZE       56u  /**< Max. size of a message copied into a lock free queue */
 
 /** Queue policy matching pthread/Posix defines    */
 typedef enum
 {
     VOS_QUEUE_POLICY_OTHER,         /*  Default for the target system    */
     VOS_QUEUE_POLICY_FIFO,          /*  First in, first out              */
-    VOS_QUEUE_POLICY_LIFO           /*  Last in, first out               */
+    VOS_QUEUE_POLICY_LIFO,          /*  Last in, first out               */
+    VOS_QUEUE_POLICY_LOCKFREE       /*  First in, first out, lock free for several senders and receivers */
 } VOS_QUEUE_POLICY_T;
 
 
@@ -101,6 +106,11 @@ typedef enum
 
 #endif
 
+/** Tag each pool block with the file and line of its vos_memAlloc() call in debug builds */
+#if defined(DEBUG) && !defined(VOS_MEM_NO_SITE_TAGS)
+#define VOS_MEM_SITE_TAGS
+#endif
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -109,6 +119,16 @@ typedef enum
 typedef struct VOS_QUEUE *VOS_QUEUE_T;
 typedef struct VOS_QUEUE_ELEM *VOS_QUEUE_ELEM_T;
 
+/** Statistics of one block size of the memory area */
+typedef struct
+{
+    UINT32  blockSize;          /**< size of the blocks */
+    UINT32  used;               /**< blocks currently allocated */
+    UINT32  peak;               /**< max. blocks allocated at the same time */
+    UINT32  fallback;           /**< requests served by a bigger block size, this one was exhausted */
+    UINT32  failed;             /**< requests which could not be served at all */
+} VOS_MEM_CLASS_STATS_T;
+
 /***********************************************************************************************************************
  * PROTOTYPES
  */
@@ -121,6 +141,11 @@ typedef struct VOS_QUEUE_ELEM *VOS_QUEUE_ELEM_T;
 /** Initialize the memory unit.
  *  Init a supplied block of memory and prepare it for use with vos_alloc and vos_dealloc. The used block sizes can
  *  be supplied and will be preallocated.
+ *  On POSIX, each thread caches free blocks of up to 2048 bytes in a magazine. The magazines of one thread hold at
+ *  most 1/16 of the memory area (no magazines below about 1.5 MB: 16 blocks per size need 16 * 5.9 kB), an
+ *  allocation which finds no free block returns the magazine of the calling thread before it takes a bigger block
+ *  or fails. Blocks in magazines of other threads are not reclaimed until those threads exit, so up to
+ *  (number of threads - 1) / 16 of the area can be stranded.
  *
  *  @param[in]      pMemoryArea     Pointer to memory area to use
  *  @param[in]      size            Size of provided memory area
@@ -192,6 +217,47 @@ EXT_DECL VOS_ERR_T vos_memCount(
     UINT32 blockSize[VOS_MEM_NBLOCKSIZES],
     UINT32 usedBlockSize[VOS_MEM_NBLOCKSIZES]);
 
+/**********************************************************************************************************************/
+/** Return the statistics per block size (of memory area above).
+ *  Peak, fallback and failure counts start after the pre-allocation of vos_memInit(). Summing up peak, fallback and
+ *  failed of a representative run gives a good estimate for the pre-allocation vector (see test/diverse/memPrealloc.c).
+ *
+ *  @param[out]     classStats          Array of statistics, one entry per block size
+ *  @retval         VOS_NO_ERR          no error
+ *  @retval         VOS_PARAM_ERR       parameter invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_memClassCount (
+    VOS_MEM_CLASS_STATS_T classStats[VOS_MEM_NBLOCKSIZES]);
+
+#ifdef VOS_MEM_SITE_TAGS
+/**********************************************************************************************************************/
+/** Allocate a block of memory and remember the allocation site.
+ *  Called by the vos_memAlloc() macro in debug builds.
+ *
+ *  @param[in]      size            Size of requested block
+ *  @param[in]      pSite           "file:line" of the caller, must be a string literal
+ *
+ *  @retval         Pointer to memory area
+ *  @retval         NULL if no memory available
+ */
+
+EXT_DECL UINT8 *vos_memAllocSite (
+    UINT32      size,
+    const CHAR8 *pSite);
+
+/**********************************************************************************************************************/
+/** Log the allocation sites holding pool blocks, with current and peak number of blocks.
+ *
+ */
+
+EXT_DECL void vos_memPrintSites (void);
+
+#define VOS_MEM_STR2(x)     #x
+#define VOS_MEM_STR(x)      VOS_MEM_STR2(x)
+#define vos_memAlloc(size)  vos_memAllocSite((size), __FILE__ ":" VOS_MEM_STR(__LINE__))
+#endif
+
 /**********************************************************************************************************************/
 /*  Sorting/Searching                                                                                                 */
 /**********************************************************************************************************************/
@@ -301,9 +367,11 @@ EXT_DECL void vos_strncat (
 
 /**********************************************************************************************************************/
 /** Initialize a message queue.
- *  Returns a handle for further calls
+ *  Returns a handle for further calls.
+ *  A VOS_QUEUE_POLICY_LOCKFREE queue is a bounded ring buffer without mutex, its size is rounded up to a power of
+ *  two. Messages are stored in the ring itself, receivers are only woken through the semaphore if they are waiting.
  *
- *  @param[in]      queueType       Define queue type (1 = FIFO, 2 = LIFO, 3 = PRIO)
+ *  @param[in]      queueType       Define queue type (1 = FIFO, 2 = LIFO, 3 = LOCKFREE)
  *  @param[in]      maxNoOfMsg      Maximum number of messages
  *  @param[out]     pQueueHandle    Handle of created queue
  *
@@ -380,6 +448,46 @@ EXT_DECL VOS_ERR_T vos_queueDestroy (
     VOS_QUEUE_T queueHandle);
 
 
+/**********************************************************************************************************************/
+/** Send a copy of a small message.
+ *  The data is copied into the queue, the caller keeps ownership of the buffer. Lock free queues only.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[in]      pData           Pointer to data to be sent
+ *  @param[in]      size            Size of data to be sent (max. VOS_QUEUE_INLINE_SIZE)
+ *
+ *  @retval         VOS_NO_ERR          no error
+ *  @retval         VOS_PARAM_ERR       parameter out of range/invalid
+ *  @retval         VOS_QUEUE_FULL_ERR  queue is full
+ */
+
+EXT_DECL VOS_ERR_T vos_queueSendCopy (
+    VOS_QUEUE_T queueHandle,
+    const UINT8 *pData,
+    UINT32      size);
+
+
+/**********************************************************************************************************************/
+/** Get a copy of a message sent with vos_queueSendCopy().
+ *  Messages sent with vos_queueSend() must be received with vos_queueReceive() and vice versa.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[out]     pData           Pointer to buffer for the received data
+ *  @param[in,out]  pSize           In: size of the buffer (min. VOS_QUEUE_INLINE_SIZE), out: size of the data
+ *  @param[in]      usTimeout       Maximum time to wait for a message (in usec)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid, message was not sent as copy (and is dropped)
+ *  @retval         VOS_QUEUE_ERR   queue is empty
+ */
+
+EXT_DECL VOS_ERR_T vos_queueReceiveCopy (
+    VOS_QUEUE_T queueHandle,
+    UINT8       *pData,
+    UINT32      *pSize,
+    UINT32      usTimeout);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -17,6 +17,10 @@
 /*
  * $Id: vos_sock.h 2112 2019-11-12 14:29:12Z andersoberg $
  *
+ *      AG 2026-10-17: Vectored TCP send (vos_sockSendTCPVec), socket option noDelay
+ *      AG 2026-10-17: Event driven socket sets (vos_pollCreate/Destroy/Add/Del/Wait/GetDesc)
+ *      AG 2026-10-17: Batched UDP send (vos_sockSendUDPBatch)
+ *      AG 2026-10-17: Batched UDP receive (vos_sockReceiveUDPBatch)
 *       A 2019-11-11: Ticket #290: Add support for Virtualization on Windows
  *      BL 2019-09-10: Ticket #278 Don't check if a socket is < 0
  *      BL 2019-06-17: Ticket #191 Add provisions for TSN / Hard Real Time (open source)
@@ -114,6 +118,10 @@ extern "C" {
 #endif
 #endif
 
+#ifndef VOS_MAX_SOCK_BATCH          /**< Max. number of datagrams handled by one batched socket call */
+#define VOS_MAX_SOCK_BATCH  16u
+#endif
+
 #define VOS_INADDR_ANY      INADDR_ANY
 
 #define VOS_DEFAULT_IFACE   cDefaultIface
@@ -146,12 +154,42 @@ typedef struct
     BOOL8   no_udp_crc;     /**< supress udp crc computation                       */
     BOOL8   txTime;         /**< use transmit time on send, if available            */
     BOOL8   raw;            /**< use raw socket, not for receiver!                  */
+    BOOL8   noDelay;        /**< TCP only: send small segments without delay        */
     UINT16  vlanId;
     CHAR8   ifName[VOS_MAX_IF_NAME_SIZE]; /**< interface name if available          */
 } VOS_SOCK_OPT_T;
 
 typedef fd_set VOS_FDS_T;
 
+/** Descriptor of one datagram for batched UDP socket calls */
+typedef struct
+{
+    UINT8   *pBuffer;       /**< pointer to data buffer                                     */
+    UINT32  size;           /**< In: size of the buffer, Out: no of bytes received          */
+    UINT32  srcIPAddr;      /**< source IP of the received datagram                         */
+    UINT16  srcIPPort;      /**< source port of the received datagram                       */
+    UINT32  dstIPAddr;      /**< Receive: destination IP of the datagram (own IP or MC),
+                                 Send: destination IP                                        */
+    UINT16  dstIPPort;      /**< destination port (send only)                               */
+} VOS_SOCK_MSG_T;
+
+/** One segment of the data sent by vos_sockSendTCPVec() */
+typedef struct
+{
+    const UINT8 *pBuffer;   /**< pointer to the data                                        */
+    UINT32      size;       /**< no of bytes to send                                        */
+} VOS_SOCK_SEG_T;
+
+/** Set of sockets to wait on with vos_pollWait() (opaque, target dependant)   */
+typedef struct VOS_POLL *VOS_POLL_T;
+
+/** Readable socket reported by vos_pollWait() */
+typedef struct
+{
+    SOCKET  sock;           /**< readable socket                                            */
+    UINT32  ref;            /**< reference supplied with vos_pollAdd()                      */
+} VOS_POLL_EVENT_T;
+
 typedef struct
 {
     CHAR8           name[VOS_MAX_IF_NAME_SIZE]; /**< interface adapter name         */
@@ -266,6 +304,106 @@ EXT_DECL const CHAR8 *vos_ipDotted (
 EXT_DECL BOOL8 vos_isMulticast (
     UINT32 ipAddress);
 
+/**********************************************************************************************************************/
+/** Create a set of sockets to wait on for readability.
+ *  Unlike vos_select(), the set is kept between the calls and the wait reports the readable sockets only - the
+ *  effort does not depend on the number of idle sockets (epoll on Linux).
+ *
+ *  @param[out]     pPoll           pointer to the handle of the new set
+ *  @param[in]      maxSockets      max. number of sockets in the set
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_SOCK_ERR    set could not be created
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_pollCreate (
+    VOS_POLL_T  *pPoll,
+    UINT32      maxSockets);
+
+/**********************************************************************************************************************/
+/** Destroy a set of sockets.
+ *  The sockets themselves are not closed.
+ *
+ *  @param[in]      pollSet         handle of the set
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_pollDestroy (
+    VOS_POLL_T pollSet);
+
+/**********************************************************************************************************************/
+/** Add a socket to a set.
+ *  A socket which is closed leaves the set implicitly.
+ *
+ *  @param[in]      pollSet         handle of the set
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      ref             reference reported with the events of this socket
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_QUEUE_FULL_ERR  set is full
+ *  @retval         VOS_SOCK_ERR    socket could not be added
+ */
+
+EXT_DECL VOS_ERR_T vos_pollAdd (
+    VOS_POLL_T  pollSet,
+    SOCKET      sock,
+    UINT32      ref);
+
+/**********************************************************************************************************************/
+/** Remove a socket from a set.
+ *
+ *  @param[in]      pollSet         handle of the set
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error or socket not in the set
+ */
+
+EXT_DECL VOS_ERR_T vos_pollDel (
+    VOS_POLL_T  pollSet,
+    SOCKET      sock);
+
+/**********************************************************************************************************************/
+/** Wait until sockets of a set become readable.
+ *
+ *  @param[in]      pollSet         handle of the set
+ *  @param[out]     pEvents         array to receive the readable sockets
+ *  @param[in,out]  pNoOfEvents     In: size of the array, Out: number of readable sockets
+ *  @param[in]      pTimeOut        max. time to wait, NULL to wait forever
+ *
+ *  @retval         VOS_NO_ERR      no error (*pNoOfEvents is 0 on time out)
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_IO_ERR      wait failed
+ */
+
+EXT_DECL VOS_ERR_T vos_pollWait (
+    VOS_POLL_T          pollSet,
+    VOS_POLL_EVENT_T    *pEvents,
+    UINT32              *pNoOfEvents,
+    const VOS_TIMEVAL_T *pTimeOut);
+
+/**********************************************************************************************************************/
+/** Get a descriptor which becomes readable whenever a socket of the set is readable.
+ *  It can be used to nest the set into the application's own select() or epoll loop.
+ *
+ *  @param[in]      pollSet         handle of the set
+ *  @param[out]     pDesc           pointer to the descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_UNKNOWN_ERR the target has no such descriptor
+ */
+
+EXT_DECL VOS_ERR_T vos_pollGetDesc (
+    VOS_POLL_T  pollSet,
+    SOCKET      *pDesc);
+
 /**********************************************************************************************************************/
 /** Get a list of interface addresses
  *  The caller has to provide an array of interface records to be filled.
@@ -474,6 +612,28 @@ EXT_DECL VOS_ERR_T vos_sockSendUDP (
     UINT32      ipAddress,
     UINT16      port);
 
+/**********************************************************************************************************************/
+/** Send several UDP datagrams with one call.
+ *  Every datagram is sent to its own destination address and port. A failing datagram does not stop the
+ *  transmission of the following ones. Targets without a batched send system call will send one datagram after
+ *  the other.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in,out]  pMsgs           array of datagram descriptors (pBuffer, size, dstIPAddr and dstIPPort must be set)
+ *                                  Out: size is the number of bytes sent, 0 if the datagram could not be sent
+ *  @param[in,out]  pNoOfMsgs       In: number of descriptors, Out: number of datagrams sent
+ *
+ *  @retval         VOS_NO_ERR      all datagrams sent
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_IO_ERR      at least one datagram could not be sent
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          *pNoOfMsgs);
+
 /**********************************************************************************************************************/
 /** Receive UDP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -507,6 +667,28 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
     UINT32  *pDstIPAddr,
     BOOL8   peek);
 
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams with one call.
+ *  Fills up to *pNoOfMsgs buffers with the datagrams pending on the socket. The call will block (if the socket is in
+ *  blocking mode) until the first datagram is available, further datagrams are only fetched if already queued.
+ *  Targets without a batched receive system call will deliver one datagram per call.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in,out]  pMsgs           array of datagram descriptors (pBuffer and size must be set)
+ *  @param[in,out]  pNoOfMsgs       In: number of descriptors, Out: number of datagrams received
+ *
+ *  @retval         VOS_NO_ERR      at least one datagram received
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          *pNoOfMsgs);
+
 /**********************************************************************************************************************/
 /** Bind a socket to an address and port.
  *
@@ -602,6 +784,29 @@ EXT_DECL VOS_ERR_T vos_sockSendTCP (
     const UINT8 *pBuffer,
     UINT32      *pSize);
 
+/**********************************************************************************************************************/
+/** Send several segments of TCP data with one call.
+ *  The segments are sent back to back as one byte stream. Targets without a vectored send system call will send
+ *  one segment after the other.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pSegs           array of segments to send
+ *  @param[in]      noOfSegs        number of segments
+ *  @param[out]     pSize           no of bytes sent
+ *
+ *  @retval         VOS_NO_ERR      all segments sent
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   call would have blocked in non-blocking mode, data partially sent
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCPVec (
+    SOCKET                  sock,
+    const VOS_SOCK_SEG_T    *pSegs,
+    UINT32                  noOfSegs,
+    UINT32                  *pSize);
+
 /**********************************************************************************************************************/
 /** Receive TCP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -19,6 +19,10 @@
  * $Id: vos_mem.c 2012 2019-08-16 09:43:29Z s-bender $
  *
  * Changes:
+ *      AG 2026-10-17: Magazines capped by memory area size, own magazine reclaimed before a bigger block is used
+ *      AG 2026-10-17: Per block size used/peak/fallback/failed counters, allocation site tags
+ *      AG 2026-10-17: Per thread magazines of free blocks, constant time block size lookup
+ *      AG 2026-10-17: Lock free MPMC ring buffer queue (VOS_QUEUE_POLICY_LOCKFREE) with inline messages
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2016-07-06: Ticket #122 64Bit compatibility (+ compiler warnings)
  *      BL 2016-02-10: Debug print: tabs before size output
@@ -62,10 +66,31 @@
 #include "vos_thread.h"
 #include "vos_private.h"
 
+/* The functions are defined here, not the site tagging macro */
+#ifdef VOS_MEM_SITE_TAGS
+#undef vos_memAlloc
+#endif
+
 /***********************************************************************************************************************
  * DEFINITIONS
  */
 
+/* Per thread magazines of free blocks, they need thread local storage and a destructor at thread exit */
+#if defined(POSIX) && defined(__GNUC__) && !defined(VOS_MEM_NO_MAGAZINES)
+#define VOS_MEM_MAGAZINES
+#endif
+
+#define VOS_MEM_MAG_SIZE        16u     /* Max. no of blocks per size a thread keeps */
+#define VOS_MEM_MAG_MAX_BLOCK   2048u   /* Larger blocks are not kept in magazines */
+#define VOS_MEM_MAG_SHARE       16u     /* Full magazines of one thread hold at most 1/16 of the memory area */
+
+/* Block size lookup: 8 byte slots up to 2048 bytes, 2048 byte slots above */
+#define VOS_MEM_SMALL_LIMIT     2048u
+#define VOS_MEM_SMALL_SHIFT     3u
+#define VOS_MEM_SMALL_SLOTS     (VOS_MEM_SMALL_LIMIT >> VOS_MEM_SMALL_SHIFT)
+#define VOS_MEM_LARGE_SHIFT     11u
+#define VOS_MEM_LARGE_SLOTS     256u
+
 typedef struct memBlock
 {
     UINT32          size;           /* Size of the data part of the block */
@@ -77,12 +102,14 @@ typedef struct
 {
     UINT32  freeSize;             /* Size of free memory */
     UINT32  minFreeSize;          /* Size of free memory */
-    UINT32  allocCnt;             /* No of allocated memory blocks */
     UINT32  allocErrCnt;          /* No of allocated memory errors */
     UINT32  freeErrCnt;           /* No of free memory errors */
     UINT32  blockCnt[VOS_MEM_NBLOCKSIZES];  /* D:o per block size */
     UINT32  preAlloc[VOS_MEM_NBLOCKSIZES];  /* Pre allocated per block size */
-
+    UINT32  usedCnt[VOS_MEM_NBLOCKSIZES];   /* Blocks in use per block size */
+    UINT32  peakCnt[VOS_MEM_NBLOCKSIZES];   /* Max. blocks in use per block size */
+    UINT32  fallbackCnt[VOS_MEM_NBLOCKSIZES]; /* Requests served by a bigger block size */
+    UINT32  failCnt[VOS_MEM_NBLOCKSIZES];   /* Requests not served per block size */
 } MEM_STATISTIC_T;
 
 typedef struct
@@ -102,8 +129,41 @@ typedef struct
         MEM_BLOCK_T *pFirst;            /* Pointer to first free block */
     } freeBlock[VOS_MEM_NBLOCKSIZES];
     MEM_STATISTIC_T memCnt;             /* Statistic counters */
+    UINT8           smallClass[VOS_MEM_SMALL_SLOTS];   /* Block size index by size, small sizes */
+    UINT8           largeClass[VOS_MEM_LARGE_SLOTS];   /* Block size index by size, large sizes */
+    UINT32          magSize;            /* Max. no of blocks per size in a magazine, 0: no magazines */
+    UINT32          magBatch;           /* No of blocks moved between magazine and free list at once */
 } MEM_CONTROL_T;
 
+#ifdef VOS_MEM_MAGAZINES
+/* Free blocks cached by one thread, per block size */
+typedef struct
+{
+    UINT32      generation;                         /* sMemGeneration the blocks belong to */
+    UINT32      count[VOS_MEM_NBLOCKSIZES];
+    MEM_BLOCK_T *pFirst[VOS_MEM_NBLOCKSIZES];
+} MEM_MAGAZINE_T;
+
+#define VOS_MEM_STAT_ADD(var, val)  (void) __atomic_add_fetch(&(var), (val), __ATOMIC_RELAXED)
+#define VOS_MEM_STAT_SUB(var, val)  __atomic_sub_fetch(&(var), (val), __ATOMIC_RELAXED)
+#define VOS_MEM_STAT_INC(var)       __atomic_add_fetch(&(var), 1u, __ATOMIC_RELAXED)
+#define VOS_MEM_STAT_MIN(var, val)  VOS_MEM_STAT_REPLACE(var, val, <)
+#define VOS_MEM_STAT_MAX(var, val)  VOS_MEM_STAT_REPLACE(var, val, >)
+#define VOS_MEM_STAT_REPLACE(var, val, cmp)                                                     \
+    do {                                                                                        \
+        UINT32 cur_ = __atomic_load_n(&(var), __ATOMIC_RELAXED);                                \
+        while (((val) cmp cur_) &&                                                              \
+               !__atomic_compare_exchange_n(&(var), &cur_, (val), 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) \
+        {}                                                                                      \
+    } while (0)
+#else
+#define VOS_MEM_STAT_ADD(var, val)  (void) ((var) += (val))
+#define VOS_MEM_STAT_SUB(var, val)  ((var) -= (val))
+#define VOS_MEM_STAT_INC(var)       (++(var))
+#define VOS_MEM_STAT_MIN(var, val)  do {if ((val) < (var)) {(var) = (val);}} while (0)
+#define VOS_MEM_STAT_MAX(var, val)  do {if ((val) > (var)) {(var) = (val);}} while (0)
+#endif
+
 typedef struct
 {
     UINT32  queueAllocated;      /* No of allocated queues */
@@ -114,6 +174,45 @@ typedef struct
     UINT32  queuReadErrCnt;      /* No of queue read errors */
 } VOS_STATISTIC;
 
+/* Atomic operations for the lock free queue, without them the ring buffer is protected by the queue mutex */
+#if defined(__GNUC__) && !defined(VOS_NO_ATOMICS)
+#define VOS_HAS_ATOMICS
+#define VOS_ATOMIC_LOAD(p)              __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define VOS_ATOMIC_STORE(p, v)          __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define VOS_ATOMIC_CAS(p, pExpected, v) __atomic_compare_exchange_n((p), (pExpected), (v), TRUE, \
+                                                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#define VOS_ATOMIC_ADD(p, v)            (void) __atomic_add_fetch((p), (v), __ATOMIC_SEQ_CST)
+#define VOS_ATOMIC_FENCE()              __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#define VOS_ATOMIC_LOAD(p)              (*(p))
+#define VOS_ATOMIC_STORE(p, v)          (*(p) = (v))
+#define VOS_ATOMIC_CAS(p, pExpected, v) ((*(p) = (v)), TRUE)
+#define VOS_ATOMIC_ADD(p, v)            (*(p) += (v))
+#define VOS_ATOMIC_FENCE()
+#endif
+
+#define VOS_QUEUE_COPY_FLAG     0x80000000u     /* Slot holds a copied message, not a pointer */
+#define VOS_QUEUE_CACHE_LINE    64u
+
+/* Queue element struct */
+struct VOS_QUEUE_ELEM
+{
+    UINT8   *pData;
+    UINT32  size;
+};
+
+/* Lock free queue slot, the sequence tells producers and consumers whose turn it is */
+struct VOS_QUEUE_SLOT
+{
+    UINT32  sequence;
+    UINT32  size;                               /* VOS_QUEUE_COPY_FLAG set for copied messages */
+    union
+    {
+        UINT8   *pData;
+        UINT8   data[VOS_QUEUE_INLINE_SIZE];
+    } msg;
+};
+
 /* Queue header struct */
 struct VOS_QUEUE
 {
@@ -125,13 +224,15 @@ struct VOS_QUEUE
     VOS_SEMA_T              semaphore;
     VOS_MUTEX_T             mutex;
     struct VOS_QUEUE_ELEM   *pQueue;
-};
-
-/* Queue element struct */
-struct VOS_QUEUE_ELEM
-{
-    UINT8   *pData;
-    UINT32  size;
+    /* VOS_QUEUE_POLICY_LOCKFREE only, positions on separate cache lines */
+    struct VOS_QUEUE_SLOT   *pSlots;
+    UINT32                  slotMask;
+    UINT32                  waiters;            /* No of receivers blocked on the semaphore */
+    UINT8                   pad1[VOS_QUEUE_CACHE_LINE];
+    UINT32                  enqueuePos;
+    UINT8                   pad2[VOS_QUEUE_CACHE_LINE - sizeof(UINT32)];
+    UINT32                  dequeuePos;
+    UINT8                   pad3[VOS_QUEUE_CACHE_LINE - sizeof(UINT32)];
 };
 
 /* Forward declaration, Mutex size is target dependent! */
@@ -150,9 +251,360 @@ static MEM_CONTROL_T gMem =
         {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL},
         {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}
     },
-    {0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, VOS_MEM_PREALLOCATE}
+    {0, 0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, VOS_MEM_PREALLOCATE, {0}, {0}, {0}, {0}},
+    {0}, {0}, 0u, 0u
 };
 
+#ifdef VOS_MEM_SITE_TAGS
+#define VOS_MEM_MAX_SITES   256u        /* Max. no of different vos_memAlloc() calls tracked */
+
+/* Allocation site, allocated blocks point to it by their pNext */
+typedef struct
+{
+    const CHAR8 *pSite;                 /* "file:line" of the call */
+    UINT32      used;                   /* Blocks currently allocated from here */
+    UINT32      peak;                   /* Max. blocks allocated from here at the same time */
+    UINT32      bytes;                  /* Block bytes currently allocated from here */
+} MEM_SITE_T;
+
+static MEM_SITE_T       sMemSite[VOS_MEM_MAX_SITES];
+#endif
+
+/* Incremented by vos_memInit(), blocks in magazines of an older memory area are dropped */
+static UINT32           sMemGeneration = 0u;
+
+#ifdef VOS_MEM_MAGAZINES
+static __thread MEM_MAGAZINE_T  sMagazine;
+static pthread_key_t            sMagazineKey;
+static pthread_once_t           sMagazineOnce = PTHREAD_ONCE_INIT;
+#endif
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Get the index of the smallest block size for a requested size.
+ *
+ *  @param[in]      size            Requested size, 1 up to the largest block size
+ *
+ *  @retval         index into gMem.freeBlock[]
+ */
+
+static UINT32 memSizeClass (
+    UINT32 size)
+{
+    UINT32 i;
+
+    if (size <= VOS_MEM_SMALL_LIMIT)
+    {
+        i = gMem.smallClass[(size - 1u) >> VOS_MEM_SMALL_SHIFT];
+    }
+    else
+    {
+        i = gMem.largeClass[(size - 1u) >> VOS_MEM_LARGE_SHIFT];
+    }
+    /* The table holds the block size for the smallest size in the slot, a larger one may be needed */
+    while (size > gMem.freeBlock[i].size)
+    {
+        i++;
+    }
+    return i;
+}
+
+/**********************************************************************************************************************/
+/** Build the block size lookup tables from gMem.freeBlock[].
+ *
+ *  @retval         none
+ */
+
+static void memBuildSizeClasses (void)
+{
+    UINT32 slot, i = 0u;
+
+    for (slot = 0u; slot < VOS_MEM_SMALL_SLOTS; slot++)
+    {
+        while ((i < gMem.noOfBlocks - 1u) && (gMem.freeBlock[i].size < (slot << VOS_MEM_SMALL_SHIFT) + 1u))
+        {
+            i++;
+        }
+        gMem.smallClass[slot] = (UINT8) i;
+    }
+    i = 0u;
+    for (slot = 0u; slot < VOS_MEM_LARGE_SLOTS; slot++)
+    {
+        while ((i < gMem.noOfBlocks - 1u) && (gMem.freeBlock[i].size < (slot << VOS_MEM_LARGE_SHIFT) + 1u))
+        {
+            i++;
+        }
+        gMem.largeClass[slot] = (UINT8) i;
+    }
+}
+
+#ifdef VOS_MEM_SITE_TAGS
+/**********************************************************************************************************************/
+/** Remove a returned block from the statistics of its allocation site.
+ *
+ *  @param[in]      pBlock          Pointer to the block
+ *  @param[in]      blockSize       Size of the block
+ *
+ *  @retval         none
+ */
+
+static void memSiteRelease (
+    MEM_BLOCK_T *pBlock,
+    UINT32      blockSize)
+{
+    MEM_SITE_T *pEntry = (MEM_SITE_T *) pBlock->pNext;
+
+    /* Blocks from vos_memAlloc() without tag carry NULL */
+    if ((pEntry >= &sMemSite[0]) && (pEntry < &sMemSite[VOS_MEM_MAX_SITES]) &&
+        (vos_mutexLock(&gMem.mutex) == VOS_NO_ERR))
+    {
+        pEntry->used--;
+        pEntry->bytes -= blockSize;
+        (void) vos_mutexUnlock(&gMem.mutex);
+    }
+}
+#endif
+
+#ifdef VOS_MEM_MAGAZINES
+/**********************************************************************************************************************/
+/** Move all blocks of a magazine to the free lists, gMem.mutex must be held.
+ *
+ *  @param[in]      pMag            Pointer to the magazine
+ *
+ *  @retval         none
+ */
+
+static void memMagazineFlush (
+    MEM_MAGAZINE_T *pMag)
+{
+    MEM_BLOCK_T *pBlock;
+    UINT32      i;
+
+    for (i = 0u; i < gMem.noOfBlocks; i++)
+    {
+        while (pMag->pFirst[i] != NULL)
+        {
+            pBlock          = pMag->pFirst[i];
+            pMag->pFirst[i] = pBlock->pNext;
+            pBlock->pNext   = gMem.freeBlock[i].pFirst;
+            gMem.freeBlock[i].pFirst = pBlock;
+        }
+        pMag->count[i] = 0u;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Return all blocks of a magazine to the free lists.
+ *  Called at thread exit (as key destructor) and at the end of vos_memInit().
+ *
+ *  @param[in]      pArg            Pointer to the magazine of the thread
+ *
+ *  @retval         none
+ */
+
+static void memMagazineRelease (
+    void *pArg)
+{
+    MEM_MAGAZINE_T *pMag = (MEM_MAGAZINE_T *) pArg;
+
+    if ((pMag->generation != sMemGeneration) || (vos_mutexLock(&gMem.mutex) != VOS_NO_ERR))
+    {
+        return;
+    }
+    memMagazineFlush(pMag);
+    (void) vos_mutexUnlock(&gMem.mutex);
+}
+
+static void memMagazineKeyCreate (void)
+{
+    (void) pthread_key_create(&sMagazineKey, memMagazineRelease);
+}
+
+/**********************************************************************************************************************/
+/** Get the magazine of the calling thread.
+ *
+ *  @retval         Pointer to the magazine
+ */
+
+static MEM_MAGAZINE_T *memMagazine (void)
+{
+    if (sMagazine.generation != sMemGeneration)
+    {
+        /* First use by this thread or blocks of a deleted memory area */
+        memset(&sMagazine, 0, sizeof(sMagazine));
+        sMagazine.generation = sMemGeneration;
+        (void) pthread_once(&sMagazineOnce, memMagazineKeyCreate);
+        (void) pthread_setspecific(sMagazineKey, &sMagazine);
+    }
+    return &sMagazine;
+}
+
+/**********************************************************************************************************************/
+/** Get a block from the magazine of the calling thread, refill it from the free list if empty.
+ *
+ *  @param[in]      i               Index of the block size
+ *
+ *  @retval         Pointer to the block
+ *  @retval         NULL if the free list is empty, too
+ */
+
+static MEM_BLOCK_T *memMagazineGet (
+    UINT32 i)
+{
+    MEM_MAGAZINE_T  *pMag = memMagazine();
+    MEM_BLOCK_T     *pBlock;
+
+    if (pMag->count[i] == 0u)
+    {
+        if (vos_mutexLock(&gMem.mutex) != VOS_NO_ERR)
+        {
+            return NULL;
+        }
+        while ((pMag->count[i] < gMem.magBatch) && (gMem.freeBlock[i].pFirst != NULL))
+        {
+            pBlock          = gMem.freeBlock[i].pFirst;
+            gMem.freeBlock[i].pFirst = pBlock->pNext;
+            pBlock->pNext   = pMag->pFirst[i];
+            pMag->pFirst[i] = pBlock;
+            pMag->count[i]++;
+        }
+        (void) vos_mutexUnlock(&gMem.mutex);
+        if (pMag->count[i] == 0u)
+        {
+            return NULL;
+        }
+    }
+    pBlock          = pMag->pFirst[i];
+    pMag->pFirst[i] = pBlock->pNext;
+    pMag->count[i]--;
+    return pBlock;
+}
+
+/**********************************************************************************************************************/
+/** Put a block into the magazine of the calling thread, spill a batch to the free list if it is full.
+ *
+ *  @param[in]      i               Index of the block size
+ *  @param[in]      pBlock          Pointer to the block
+ *
+ *  @retval         none
+ */
+
+static void memMagazinePut (
+    UINT32      i,
+    MEM_BLOCK_T *pBlock)
+{
+    MEM_MAGAZINE_T  *pMag = memMagazine();
+    UINT32          n;
+
+    pBlock->pNext   = pMag->pFirst[i];
+    pMag->pFirst[i] = pBlock;
+    pMag->count[i]++;
+
+    if ((pMag->count[i] > gMem.magSize) && (vos_mutexLock(&gMem.mutex) == VOS_NO_ERR))
+    {
+        for (n = 0u; n < gMem.magBatch; n++)
+        {
+            pBlock          = pMag->pFirst[i];
+            pMag->pFirst[i] = pBlock->pNext;
+            pBlock->pNext   = gMem.freeBlock[i].pFirst;
+            gMem.freeBlock[i].pFirst = pBlock;
+        }
+        pMag->count[i] -= gMem.magBatch;
+        (void) vos_mutexUnlock(&gMem.mutex);
+    }
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Get a block from the free lists or the free area, a bigger block if nothing else is left.
+ *
+ *  @param[in,out]  pIndex          In: index of the wanted block size, out: index of the returned block
+ *  @param[in]      size            Requested size (for logging)
+ *
+ *  @retval         Pointer to the block
+ *  @retval         NULL if no memory available
+ */
+
+static MEM_BLOCK_T *memGlobalGet (
+    UINT32  *pIndex,
+    UINT32  size)
+{
+    UINT32      i = *pIndex;
+    UINT32      blockSize;
+    MEM_BLOCK_T *pBlock;
+
+    /* Get memory sempahore */
+    if (vos_mutexLock(&gMem.mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_memAlloc can't get semaphore\n");
+        return NULL;
+    }
+
+    blockSize   = gMem.freeBlock[i].size;
+    pBlock      = gMem.freeBlock[i].pFirst;
+
+    /* Check if there is a free block ready */
+    if (pBlock != NULL)
+    {
+        /* There is, get it. */
+        /* Set start pointer to next free block in the linked list */
+        gMem.freeBlock[i].pFirst = pBlock->pNext;
+    }
+    else
+    {
+        /* There was no suitable free block, create one from the free area */
+
+        /* Enough free memory left ? */
+        if ((gMem.allocSize + blockSize + sizeof(MEM_BLOCK_T)) < gMem.memSize)
+        {
+            pBlock = (MEM_BLOCK_T *) gMem.pFreeArea; /*lint !e826 Allocation of MEM_BLOCK from free area*/
+
+            gMem.pFreeArea  = (UINT8 *) gMem.pFreeArea + (sizeof(MEM_BLOCK_T) + blockSize);
+            gMem.allocSize  += blockSize + sizeof(MEM_BLOCK_T);
+            gMem.memCnt.blockCnt[i]++;
+        }
+        else
+        {
+#ifdef VOS_MEM_MAGAZINES
+            /* Blocks parked in the magazine of this thread may still serve the request */
+            memMagazineFlush(memMagazine());
+            pBlock = gMem.freeBlock[i].pFirst;
+            if (pBlock != NULL)
+            {
+                gMem.freeBlock[i].pFirst = pBlock->pNext;
+            }
+#endif
+            while ((pBlock == NULL) && (++i < gMem.noOfBlocks))
+            {
+                pBlock = gMem.freeBlock[i].pFirst;
+                if (pBlock != NULL)
+                {
+                    vos_printLog(
+                        VOS_LOG_ERROR,
+                        "vos_memAlloc() Used a bigger buffer size=%d asked size=%d\n",
+                        gMem.freeBlock[i].size,
+                        size);
+                    /* There is, get it. */
+                    /* Set start pointer to next free block in the linked list */
+                    gMem.freeBlock[i].pFirst = pBlock->pNext;
+                    *pIndex = i;
+                }
+            }
+        }
+    }
+
+    /* Release semaphore */
+    if (vos_mutexUnlock(&gMem.mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return pBlock;
+}
+
+
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -189,12 +641,12 @@ EXT_DECL VOS_ERR_T vos_memInit (
     UINT8   *p[VOS_MEM_MAX_PREALLOCATE];
 
     /* Initialize memory */
+    sMemGeneration++;
     gMem.memSize = size;
     gMem.allocSize = 0;
     gMem.noOfBlocks         = 0;
     gMem.memCnt.freeSize    = size;
     gMem.memCnt.minFreeSize = size;
-    gMem.memCnt.allocCnt    = 0;
     gMem.memCnt.allocErrCnt = 0;
     gMem.memCnt.freeErrCnt  = 0;
 
@@ -282,6 +734,26 @@ EXT_DECL VOS_ERR_T vos_memInit (
     {
         gMem.freeBlock[i].pFirst    = (MEM_BLOCK_T *)NULL;
         gMem.freeBlock[i].size      = blockSize[i];
+    }
+    memBuildSizeClasses();
+
+#ifdef VOS_MEM_MAGAZINES
+    /* Cap the magazines: full magazines of one thread must not hold more than 1/VOS_MEM_MAG_SHARE of the area */
+    max = 0u;
+    for (i = 0u; (i < (UINT32) VOS_MEM_NBLOCKSIZES) && (blockSize[i] <= VOS_MEM_MAG_MAX_BLOCK); i++)
+    {
+        max += blockSize[i] + (UINT32) sizeof(MEM_BLOCK_T);
+    }
+    gMem.magSize = size / VOS_MEM_MAG_SHARE / max;
+    if (gMem.magSize > VOS_MEM_MAG_SIZE)
+    {
+        gMem.magSize = VOS_MEM_MAG_SIZE;
+    }
+    gMem.magBatch = gMem.magSize / 2u;      /* 0 for small areas: no magazines at all */
+#endif
+
+    for (i = 0; i < (UINT32) VOS_MEM_NBLOCKSIZES; i++)
+    {
         max     = gMem.memCnt.preAlloc[i];
         minSize += blockSize[i];
 
@@ -312,6 +784,16 @@ EXT_DECL VOS_ERR_T vos_memInit (
         }
     }
 
+#ifdef VOS_MEM_MAGAZINES
+    /* The pre-allocated blocks belong to the free lists, not to this thread */
+    memMagazineRelease(memMagazine());
+#endif
+
+    /* Count the application's use only */
+    memset(gMem.memCnt.peakCnt, 0, sizeof(gMem.memCnt.peakCnt));
+    memset(gMem.memCnt.fallbackCnt, 0, sizeof(gMem.memCnt.fallbackCnt));
+    memset(gMem.memCnt.failCnt, 0, sizeof(gMem.memCnt.failCnt));
+
     return VOS_NO_ERR;
 }
 
@@ -341,6 +823,7 @@ EXT_DECL void vos_memDelete (
         free(gMem.pArea);    /*lint !e421 !e586 optional use of heap memory for debugging/development */
     }
     memset(&gMem, 0, sizeof(gMem));
+    sMemGeneration++;
 }
 
 /**********************************************************************************************************************/
@@ -355,7 +838,7 @@ EXT_DECL void vos_memDelete (
 EXT_DECL UINT8 *vos_memAlloc (
     UINT32 size)
 {
-    UINT32      i, blockSize;
+    UINT32      i, blockSize, freeSize, used, wanted;
     MEM_BLOCK_T *pBlock;
 
     if (size == 0)
@@ -381,16 +864,7 @@ EXT_DECL UINT8 *vos_memAlloc (
     /* Adjust size to get one which is a multiple of UINT32's */
     size = ((size + sizeof(UINT32) - 1) / sizeof(UINT32)) * sizeof(UINT32);
 
-    /* Find appropriate blocksize */
-    for (i = 0; i < gMem.noOfBlocks; i++)
-    {
-        if (size <= gMem.freeBlock[i].size)
-        {
-            break;
-        }
-    }
-
-    if (i >= gMem.noOfBlocks)
+    if (size > gMem.freeBlock[gMem.noOfBlocks - 1u].size)
     {
         gMem.memCnt.allocErrCnt++;
 
@@ -399,96 +873,55 @@ EXT_DECL UINT8 *vos_memAlloc (
         return NULL; /* No block size big enough */
     }
 
-    /* Get memory sempahore */
-    if (vos_mutexLock(&gMem.mutex) != VOS_NO_ERR)
-    {
-        gMem.memCnt.allocErrCnt++;
-
-        vos_printLogStr(VOS_LOG_ERROR, "vos_memAlloc can't get semaphore\n");
+    /* Find appropriate blocksize */
+    i       = memSizeClass(size);
+    wanted  = i;
+    pBlock  = NULL;
 
-        return NULL;
+#ifdef VOS_MEM_MAGAZINES
+    if ((gMem.magBatch != 0u) && (gMem.freeBlock[i].size <= VOS_MEM_MAG_MAX_BLOCK))
+    {
+        pBlock = memMagazineGet(i);
     }
-    else
+    if (pBlock == NULL)
+#endif
     {
-        blockSize   = gMem.freeBlock[i].size;
-        pBlock      = gMem.freeBlock[i].pFirst;
-
-        /* Check if there is a free block ready */
-        if (pBlock != NULL)
-        {
-            /* There is, get it. */
-            /* Set start pointer to next free block in the linked list */
-            gMem.freeBlock[i].pFirst = pBlock->pNext;
-        }
-        else
-        {
-            /* There was no suitable free block, create one from the free area */
-
-            /* Enough free memory left ? */
-            if ((gMem.allocSize + blockSize + sizeof(MEM_BLOCK_T)) < gMem.memSize)
-            {
-                pBlock = (MEM_BLOCK_T *) gMem.pFreeArea; /*lint !e826 Allocation of MEM_BLOCK from free area*/
-
-                gMem.pFreeArea  = (UINT8 *) gMem.pFreeArea + (sizeof(MEM_BLOCK_T) + blockSize);
-                gMem.allocSize  += blockSize + sizeof(MEM_BLOCK_T);
-                gMem.memCnt.blockCnt[i]++;
-            }
-            else
-            {
-                while ((++i < gMem.noOfBlocks) && (pBlock == NULL))
-                {
-                    pBlock = gMem.freeBlock[i].pFirst;
-                    if (pBlock != NULL)
-                    {
-                        vos_printLog(
-                            VOS_LOG_ERROR,
-                            "vos_memAlloc() Used a bigger buffer size=%d asked size=%d\n",
-                            gMem.freeBlock[i].size,
-                            size);
-                        /* There is, get it. */
-                        /* Set start pointer to next free block in the linked list */
-                        gMem.freeBlock[i].pFirst = pBlock->pNext;
-
-                        blockSize = gMem.freeBlock[i].size;
-                    }
-                }
-            }
-        }
-
-        /* Release semaphore */
-        if (vos_mutexUnlock(&gMem.mutex) != VOS_NO_ERR)
-        {
-            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
-        }
-
-        if (pBlock != NULL)
-        {
-            /* Fill in size in memory header of the block. To be used when it is returned.*/
-            pBlock->size = blockSize;
-            gMem.memCnt.freeSize -= blockSize + sizeof(MEM_BLOCK_T);
-            if (gMem.memCnt.freeSize < gMem.memCnt.minFreeSize)
-            {
-                gMem.memCnt.minFreeSize = gMem.memCnt.freeSize;
-            }
-            gMem.memCnt.allocCnt++;
+        pBlock = memGlobalGet(&i, size);
+    }
 
-            /* Clear returned memory area to be compliant with malloc'ed version */
-            memset((UINT8 *) pBlock + sizeof(MEM_BLOCK_T), 0, blockSize);
+    if (pBlock != NULL)
+    {
+        blockSize = gMem.freeBlock[i].size;
 
-            /* Return pointer to data area, not the memory block itself */
-            vos_printLog(VOS_LOG_DBG,
-                         "vos_memAlloc() %p, size\t%u\n",
-                         (void *) ((UINT8 *) pBlock + sizeof(MEM_BLOCK_T)),
-                         size);
-            return (UINT8 *) pBlock + sizeof(MEM_BLOCK_T);
-        }
-        else
+        /* Fill in size in memory header of the block. To be used when it is returned.*/
+        pBlock->size    = blockSize;
+        pBlock->pNext   = NULL;
+        if (i != wanted)
         {
-            /* Not enough memory */
-            vos_printLog(VOS_LOG_ERROR, "vos_memAlloc() Not enough memory, size %u\n", size);
-            gMem.memCnt.allocErrCnt++;
-            return NULL;
+            VOS_MEM_STAT_ADD(gMem.memCnt.fallbackCnt[wanted], 1u);
         }
+        used = VOS_MEM_STAT_INC(gMem.memCnt.usedCnt[i]);
+        VOS_MEM_STAT_MAX(gMem.memCnt.peakCnt[i], used);
+        freeSize = VOS_MEM_STAT_SUB(gMem.memCnt.freeSize, blockSize + sizeof(MEM_BLOCK_T));
+        VOS_MEM_STAT_MIN(gMem.memCnt.minFreeSize, freeSize);
+
+        /* Clear returned memory area to be compliant with malloc'ed version */
+        memset((UINT8 *) pBlock + sizeof(MEM_BLOCK_T), 0, blockSize);
+
+        /* Return pointer to data area, not the memory block itself */
+        vos_printLog(VOS_LOG_DBG,
+                     "vos_memAlloc() %p, size\t%u\n",
+                     (void *) ((UINT8 *) pBlock + sizeof(MEM_BLOCK_T)),
+                     size);
+        return (UINT8 *) pBlock + sizeof(MEM_BLOCK_T);
+    }
+    else
+    {
+        /* Not enough memory */
+        vos_printLog(VOS_LOG_ERROR, "vos_memAlloc() Not enough memory, size %u\n", size);
+        gMem.memCnt.allocErrCnt++;
+        VOS_MEM_STAT_ADD(gMem.memCnt.failCnt[wanted], 1u);
+        return NULL;
     }
 }
 
@@ -530,6 +963,42 @@ EXT_DECL void vos_memFree (void *pMemBlock)
         return;
     }
 
+    /* Set block pointer to start of block, before the returned pointer */
+    pBlock      = (MEM_BLOCK_T *) ((UINT8 *) pMemBlock - sizeof(MEM_BLOCK_T));
+    blockSize   = pBlock->size;
+
+    /* Find appropriate free block item */
+    i = gMem.noOfBlocks;
+    if ((blockSize != 0u) && (blockSize <= gMem.freeBlock[gMem.noOfBlocks - 1u].size))
+    {
+        i = memSizeClass(blockSize);
+    }
+
+    if ((i >= gMem.noOfBlocks) || (blockSize != gMem.freeBlock[i].size))
+    {
+        gMem.memCnt.freeErrCnt++;
+
+        vos_printLogStr(VOS_LOG_ERROR, "vos_memFree illegal sized memory\n");
+        return;
+    }
+
+    vos_printLog(VOS_LOG_DBG, "vos_memFree() %p, size %u\n", pMemBlock, pBlock->size);
+    /* Destroy the size first in the block. If user tries to return same memory this will then fail. */
+    pBlock->size = 0;
+    VOS_MEM_STAT_ADD(gMem.memCnt.freeSize, blockSize + sizeof(MEM_BLOCK_T));
+    VOS_MEM_STAT_SUB(gMem.memCnt.usedCnt[i], 1u);
+#ifdef VOS_MEM_SITE_TAGS
+    memSiteRelease(pBlock, blockSize);
+#endif
+
+#ifdef VOS_MEM_MAGAZINES
+    if ((gMem.magBatch != 0u) && (blockSize <= VOS_MEM_MAG_MAX_BLOCK))
+    {
+        memMagazinePut(i, pBlock);
+        return;
+    }
+#endif
+
     /* Get memory sempahore */
     if (vos_mutexLock(&gMem.mutex) != VOS_NO_ERR)
     {
@@ -539,105 +1008,182 @@ EXT_DECL void vos_memFree (void *pMemBlock)
     }
     else
     {
-        /* Set block pointer to start of block, before the returned pointer */
-        pBlock      = (MEM_BLOCK_T *) ((UINT8 *) pMemBlock - sizeof(MEM_BLOCK_T));
-        blockSize   = pBlock->size;
+        /* Put the returned block first in the linked list */
+        pBlock->pNext = gMem.freeBlock[i].pFirst;
+        gMem.freeBlock[i].pFirst = pBlock;
 
-        /* Find appropriate free block item */
-        for (i = 0; i < gMem.noOfBlocks; i++)
+        /* Release semaphore */
+        if (vos_mutexUnlock(&gMem.mutex) != VOS_NO_ERR)
         {
-            if (blockSize == gMem.freeBlock[i].size)
-            {
-                break;
-            }
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
         }
+    }
+}
 
-        if (i >= gMem.noOfBlocks)
-        {
-            gMem.memCnt.freeErrCnt++;
 
-            vos_printLogStr(VOS_LOG_ERROR, "vos_memFree illegal sized memory\n");
-        }
-        else
-        {
-            gMem.memCnt.freeSize += blockSize + sizeof(MEM_BLOCK_T);
-            gMem.memCnt.allocCnt--;
 
-            /* Put the returned block first in the linked list */
-            pBlock->pNext = gMem.freeBlock[i].pFirst;
-            gMem.freeBlock[i].pFirst = pBlock;
+/**********************************************************************************************************************/
+/** Return used and available memory (of memory area above).
+ *
+ *  @param[out]     pAllocatedMemory    Pointer to allocated memory size
+ *  @param[out]     pFreeMemory         Pointer to free memory size
+ *  @param[out]     pMinFree            Pointer to minimal free memory size in statistics interval
+ *  @param[out]     pNumAllocBlocks     Pointer to number of allocated memory blocks
+ *  @param[out]     pNumAllocErr        Pointer to number of allocation errors
+ *  @param[out]     pNumFreeErr         Pointer to number of free errors
+ *  @param[out]     blockSize           Pointer to list of memory block sizes
+ *  @param[out]     usedBlockSize       Pointer to list of used memoryblocks
+ *  @retval         VOS_NO_ERR          no error
+ *  @retval         VOS_INIT_ERR        module not initialised
+ */
+
+EXT_DECL VOS_ERR_T vos_memCount (
+    UINT32  *pAllocatedMemory,
+    UINT32  *pFreeMemory,
+    UINT32  *pMinFree,
+    UINT32  *pNumAllocBlocks,
+    UINT32  *pNumAllocErr,
+    UINT32  *pNumFreeErr,
+    UINT32  blockSize[VOS_MEM_NBLOCKSIZES],
+    UINT32  usedBlockSize[VOS_MEM_NBLOCKSIZES])
+{
+    UINT32 i;
+
+    if (gMem.memSize == 0 && gMem.pArea == NULL)
+    {
+        /* normal heap memory is used */
+        *pAllocatedMemory   = 0;
+        *pFreeMemory        = 0;
+        *pMinFree           = 0;
+        *pNumAllocBlocks    = 0;
+        *pNumAllocErr       = 0;
+        *pNumFreeErr        = 0;
+
+        memset(blockSize, 0, sizeof(blockSize[VOS_MEM_NBLOCKSIZES]));
+        memset(usedBlockSize, 0, sizeof(usedBlockSize[VOS_MEM_NBLOCKSIZES]));
+    }
+
+    *pAllocatedMemory   = gMem.memSize;
+    *pFreeMemory        = gMem.memCnt.freeSize;
+    *pMinFree           = gMem.memCnt.minFreeSize;
+    *pNumAllocBlocks    = 0;
+    *pNumAllocErr       = gMem.memCnt.allocErrCnt;
+    *pNumFreeErr        = gMem.memCnt.freeErrCnt;
+
+    for (i = 0; i < (UINT32) VOS_MEM_NBLOCKSIZES; i++)
+    {
+        *pNumAllocBlocks    += gMem.memCnt.usedCnt[i];
+        usedBlockSize[i]    = gMem.memCnt.blockCnt[i];
+        blockSize[i]        = gMem.freeBlock[i].size;
+    }
+
+    return VOS_NO_ERR;
+}
+
+
+/**********************************************************************************************************************/
+/** Return the statistics per block size (of memory area above).
+ *
+ *  @param[out]     classStats          Array of statistics, one entry per block size
+ *  @retval         VOS_NO_ERR          no error
+ *  @retval         VOS_PARAM_ERR       parameter invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_memClassCount (
+    VOS_MEM_CLASS_STATS_T classStats[VOS_MEM_NBLOCKSIZES])
+{
+    UINT32 i;
+
+    if (classStats == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    /* normal heap memory is used, if not initialised: all zero */
+    for (i = 0; i < (UINT32) VOS_MEM_NBLOCKSIZES; i++)
+    {
+        classStats[i].blockSize = gMem.freeBlock[i].size;
+        classStats[i].used      = gMem.memCnt.usedCnt[i];
+        classStats[i].peak      = gMem.memCnt.peakCnt[i];
+        classStats[i].fallback  = gMem.memCnt.fallbackCnt[i];
+        classStats[i].failed    = gMem.memCnt.failCnt[i];
+    }
+
+    return VOS_NO_ERR;
+}
+
+#ifdef VOS_MEM_SITE_TAGS
+/**********************************************************************************************************************/
+/** Allocate a block of memory and remember the allocation site.
+ *
+ *  @param[in]      size            Size of requested block
+ *  @param[in]      pSite           "file:line" of the caller, must be a string literal
+ *
+ *  @retval         Pointer to memory area
+ *  @retval         NULL if no memory available
+ */
+
+EXT_DECL UINT8 *vos_memAllocSite (
+    UINT32      size,
+    const CHAR8 *pSite)
+{
+    UINT8       *pMem = vos_memAlloc(size);
+    MEM_BLOCK_T *pBlock;
+    MEM_SITE_T  *pEntry;
+    UINT32      i, n;
 
-            vos_printLog(VOS_LOG_DBG, "vos_memFree() %p, size %u\n", pMemBlock, pBlock->size);
-            /* Destroy the size first in the block. If user tries to return same memory this will then fail. */
-            pBlock->size = 0;
-        }
+    if ((pMem == NULL) || (gMem.pArea == NULL) || (vos_mutexLock(&gMem.mutex) != VOS_NO_ERR))
+    {
+        return pMem;
+    }
 
-        /* Release semaphore */
-        if (vos_mutexUnlock(&gMem.mutex) != VOS_NO_ERR)
+    /* The literal's address is the key, linear probing */
+    i = (UINT32) (((uintptr_t) pSite >> 3) % VOS_MEM_MAX_SITES);
+    for (n = 0u; n < VOS_MEM_MAX_SITES; n++, i = (i + 1u) % VOS_MEM_MAX_SITES)
+    {
+        pEntry = &sMemSite[i];
+        if ((pEntry->pSite == NULL) || (pEntry->pSite == pSite))
         {
-            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+            pBlock          = (MEM_BLOCK_T *) (pMem - sizeof(MEM_BLOCK_T));
+            pEntry->pSite   = pSite;
+            pEntry->bytes  += pBlock->size;
+            if (++pEntry->used > pEntry->peak)
+            {
+                pEntry->peak = pEntry->used;
+            }
+            /* pNext is unused while the block is allocated */
+            pBlock->pNext = (MEM_BLOCK_T *) pEntry;
+            break;
         }
     }
+    (void) vos_mutexUnlock(&gMem.mutex);
+    return pMem;
 }
 
-
-
 /**********************************************************************************************************************/
-/** Return used and available memory (of memory area above).
+/** Log the allocation sites holding pool blocks, with current and peak number of blocks.
  *
- *  @param[out]     pAllocatedMemory    Pointer to allocated memory size
- *  @param[out]     pFreeMemory         Pointer to free memory size
- *  @param[out]     pMinFree            Pointer to minimal free memory size in statistics interval
- *  @param[out]     pNumAllocBlocks     Pointer to number of allocated memory blocks
- *  @param[out]     pNumAllocErr        Pointer to number of allocation errors
- *  @param[out]     pNumFreeErr         Pointer to number of free errors
- *  @param[out]     blockSize           Pointer to list of memory block sizes
- *  @param[out]     usedBlockSize       Pointer to list of used memoryblocks
- *  @retval         VOS_NO_ERR          no error
- *  @retval         VOS_INIT_ERR        module not initialised
  */
 
-EXT_DECL VOS_ERR_T vos_memCount (
-    UINT32  *pAllocatedMemory,
-    UINT32  *pFreeMemory,
-    UINT32  *pMinFree,
-    UINT32  *pNumAllocBlocks,
-    UINT32  *pNumAllocErr,
-    UINT32  *pNumFreeErr,
-    UINT32  blockSize[VOS_MEM_NBLOCKSIZES],
-    UINT32  usedBlockSize[VOS_MEM_NBLOCKSIZES])
+EXT_DECL void vos_memPrintSites (void)
 {
     UINT32 i;
 
-    if (gMem.memSize == 0 && gMem.pArea == NULL)
+    if (vos_mutexLock(&gMem.mutex) != VOS_NO_ERR)
     {
-        /* normal heap memory is used */
-        *pAllocatedMemory   = 0;
-        *pFreeMemory        = 0;
-        *pMinFree           = 0;
-        *pNumAllocBlocks    = 0;
-        *pNumAllocErr       = 0;
-        *pNumFreeErr        = 0;
-
-        memset(blockSize, 0, sizeof(blockSize[VOS_MEM_NBLOCKSIZES]));
-        memset(usedBlockSize, 0, sizeof(usedBlockSize[VOS_MEM_NBLOCKSIZES]));
+        return;
     }
-
-    *pAllocatedMemory   = gMem.memSize;
-    *pFreeMemory        = gMem.memCnt.freeSize;
-    *pMinFree           = gMem.memCnt.minFreeSize;
-    *pNumAllocBlocks    = gMem.memCnt.allocCnt;
-    *pNumAllocErr       = gMem.memCnt.allocErrCnt;
-    *pNumFreeErr        = gMem.memCnt.freeErrCnt;
-
-    for (i = 0; i < (UINT32) VOS_MEM_NBLOCKSIZES; i++)
+    for (i = 0u; i < VOS_MEM_MAX_SITES; i++)
     {
-        usedBlockSize[i]    = gMem.memCnt.blockCnt[i];
-        blockSize[i]        = gMem.freeBlock[i].size;
+        if (sMemSite[i].used != 0u)
+        {
+            vos_printLog(VOS_LOG_INFO, "%s: %u blocks (%u bytes), peak %u blocks\n",
+                         sMemSite[i].pSite, sMemSite[i].used, sMemSite[i].bytes, sMemSite[i].peak);
+        }
     }
-
-    return VOS_NO_ERR;
+    (void) vos_mutexUnlock(&gMem.mutex);
 }
+#endif
 
 
 /**********************************************************************************************************************/
@@ -772,11 +1318,232 @@ EXT_DECL void vos_strncat (
                                                                                                                */
 /**********************************************************************************************************************/
 
+/**********************************************************************************************************************/
+/** Put a message into a lock free queue.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[in]      pData           Pointer to data or to the data to copy
+ *  @param[in]      size            Size of data, VOS_QUEUE_COPY_FLAG set to copy the data
+ *
+ *  @retval         VOS_NO_ERR          no error
+ *  @retval         VOS_QUEUE_FULL_ERR  queue is full
+ */
+
+static VOS_ERR_T queueRingPut (
+    VOS_QUEUE_T queueHandle,
+    const UINT8 *pData,
+    UINT32      size)
+{
+    struct VOS_QUEUE_SLOT   *pSlot;
+    UINT32                  pos = VOS_ATOMIC_LOAD(&queueHandle->enqueuePos);
+    INT32                   diff;
+
+    for (;; )
+    {
+        pSlot   = &queueHandle->pSlots[pos & queueHandle->slotMask];
+        diff    = (INT32) (VOS_ATOMIC_LOAD(&pSlot->sequence) - pos);
+        if (diff == 0)
+        {
+            /* The slot is free, try to claim it (pos is updated on failure) */
+            if (VOS_ATOMIC_CAS(&queueHandle->enqueuePos, &pos, pos + 1u))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return VOS_QUEUE_FULL_ERR;
+        }
+        else
+        {
+            pos = VOS_ATOMIC_LOAD(&queueHandle->enqueuePos);
+        }
+    }
+
+    if ((size & VOS_QUEUE_COPY_FLAG) != 0u)
+    {
+        memcpy(pSlot->msg.data, pData, size & ~VOS_QUEUE_COPY_FLAG);
+    }
+    else
+    {
+        pSlot->msg.pData = (UINT8 *) pData;
+    }
+    pSlot->size = size;
+    VOS_ATOMIC_STORE(&pSlot->sequence, pos + 1u);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get a message from a lock free queue.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[out]     ppData          Pointer to the sent data pointer, if sent by pointer
+ *  @param[out]     pCopy           Pointer to a buffer of VOS_QUEUE_INLINE_SIZE, if sent as copy
+ *  @param[out]     pSize           Size of data, VOS_QUEUE_COPY_FLAG set if sent as copy
+ *
+ *  @retval         TRUE            message received
+ *  @retval         FALSE           queue is empty
+ */
+
+static BOOL8 queueRingGet (
+    VOS_QUEUE_T queueHandle,
+    UINT8       * *ppData,
+    UINT8       *pCopy,
+    UINT32      *pSize)
+{
+    struct VOS_QUEUE_SLOT   *pSlot;
+    UINT32                  pos = VOS_ATOMIC_LOAD(&queueHandle->dequeuePos);
+    INT32                   diff;
+
+    for (;; )
+    {
+        pSlot   = &queueHandle->pSlots[pos & queueHandle->slotMask];
+        diff    = (INT32) (VOS_ATOMIC_LOAD(&pSlot->sequence) - (pos + 1u));
+        if (diff == 0)
+        {
+            if (VOS_ATOMIC_CAS(&queueHandle->dequeuePos, &pos, pos + 1u))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return FALSE;
+        }
+        else
+        {
+            pos = VOS_ATOMIC_LOAD(&queueHandle->dequeuePos);
+        }
+    }
+
+    *pSize = pSlot->size;
+    if ((pSlot->size & VOS_QUEUE_COPY_FLAG) == 0u)
+    {
+        *ppData = pSlot->msg.pData;
+    }
+    else if (pCopy != NULL)
+    {
+        memcpy(pCopy, pSlot->msg.data, pSlot->size & ~VOS_QUEUE_COPY_FLAG);
+    }
+    /* Free the slot for the next round */
+    VOS_ATOMIC_STORE(&pSlot->sequence, pos + queueHandle->slotMask + 1u);
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Send to a lock free queue and wake a waiting receiver.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[in]      pData           Pointer to data or to the data to copy
+ *  @param[in]      size            Size of data, VOS_QUEUE_COPY_FLAG set to copy the data
+ *
+ *  @retval         VOS_NO_ERR          no error
+ *  @retval         VOS_QUEUE_FULL_ERR  queue is full
+ */
+
+static VOS_ERR_T queueLockFreeSend (
+    VOS_QUEUE_T queueHandle,
+    const UINT8 *pData,
+    UINT32      size)
+{
+    VOS_ERR_T retVal;
+
+#ifdef VOS_HAS_ATOMICS
+    retVal = queueRingPut(queueHandle, pData, size);
+#else
+    if (vos_mutexLock(queueHandle->mutex) != VOS_NO_ERR)
+    {
+        return VOS_MUTEX_ERR;
+    }
+    retVal = queueRingPut(queueHandle, pData, size);
+    (void) vos_mutexUnlock(queueHandle->mutex);
+#endif
+    if (retVal == VOS_NO_ERR)
+    {
+#ifdef VOS_HAS_ATOMICS
+        /* Pairs with the increment of waiters in queueLockFreeReceive() */
+        VOS_ATOMIC_FENCE();
+        if (VOS_ATOMIC_LOAD(&queueHandle->waiters) != 0u)
+#endif
+        {
+            vos_semaGive(queueHandle->semaphore);
+        }
+    }
+    else
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_queueSend() ERROR Queue is full\n");
+    }
+    return retVal;
+}
+
+/**********************************************************************************************************************/
+/** Receive from a lock free queue, wait on the semaphore only if the queue is empty.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[out]     ppData          Pointer to the sent data pointer, if sent by pointer
+ *  @param[out]     pCopy           Pointer to a buffer of VOS_QUEUE_INLINE_SIZE, if sent as copy
+ *  @param[out]     pSize           Size of data, VOS_QUEUE_COPY_FLAG set if sent as copy
+ *  @param[in]      usTimeout       Maximum time to wait for a message (in usec)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_QUEUE_ERR   queue is empty
+ */
+
+static VOS_ERR_T queueLockFreeReceive (
+    VOS_QUEUE_T queueHandle,
+    UINT8       * *ppData,
+    UINT8       *pCopy,
+    UINT32      *pSize,
+    UINT32      usTimeout)
+{
+    BOOL8       received;
+    VOS_ERR_T   err = VOS_NO_ERR;
+
+    for (;; )
+    {
+#ifdef VOS_HAS_ATOMICS
+        received = queueRingGet(queueHandle, ppData, pCopy, pSize);
+#else
+        if (vos_mutexLock(queueHandle->mutex) != VOS_NO_ERR)
+        {
+            return VOS_MUTEX_ERR;
+        }
+        received = queueRingGet(queueHandle, ppData, pCopy, pSize);
+        (void) vos_mutexUnlock(queueHandle->mutex);
+#endif
+        if ((received == TRUE) || (usTimeout == 0u) || (err != VOS_NO_ERR))
+        {
+            break;
+        }
+
+        /* Announce the waiter first, then look again: a sender either sees us or we see its message */
+        VOS_ATOMIC_ADD(&queueHandle->waiters, 1u);
+#ifdef VOS_HAS_ATOMICS
+        received = queueRingGet(queueHandle, ppData, pCopy, pSize);
+#else
+        received = FALSE;
+#endif
+        if (received == FALSE)
+        {
+            err = vos_semaTake(queueHandle->semaphore, usTimeout);
+        }
+        VOS_ATOMIC_ADD(&queueHandle->waiters, (UINT32) -1);
+        if (received == TRUE)
+        {
+            break;
+        }
+        /* after a timeout one more look, then give up */
+    }
+    return (received == TRUE) ? VOS_NO_ERR : VOS_QUEUE_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Initialize a message queue.
- *  Returns a handle for further calls
+ *  Returns a handle for further calls.
+ *  A VOS_QUEUE_POLICY_LOCKFREE queue is a bounded ring buffer without mutex, its size is rounded up to a power of
+ *  two. Messages are stored in the ring itself, receivers are only woken through the semaphore if they are waiting.
  *
- *  @param[in]      queueType       Define queue type (1 = FIFO, 2 = LIFO, 3 = PRIO)
+ *  @param[in]      queueType       Define queue type (1 = FIFO, 2 = LIFO, 3 = LOCKFREE)
  *  @param[in]      maxNoOfMsg      Maximum number of messages
  *  @param[out]     pQueueHandle    Handle of created queue
  *
@@ -797,9 +1564,10 @@ EXT_DECL VOS_ERR_T vos_queueCreate (
 
     /* Check parameters */
     if ((queueType < VOS_QUEUE_POLICY_OTHER)
-        || (queueType > VOS_QUEUE_POLICY_LIFO)
+        || (queueType > VOS_QUEUE_POLICY_LOCKFREE)
         || (pQueueHandle == NULL)
-        || (maxNoOfMsg == 0))
+        || (maxNoOfMsg == 0)
+        || (maxNoOfMsg > 0x10000000u))
     {
         vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreate() ERROR invalid parameter\n");
         retVal = VOS_PARAM_ERR;
@@ -844,18 +1612,49 @@ EXT_DECL VOS_ERR_T vos_queueCreate (
                         (*pQueueHandle)->queueType      = queueType;
                         (*pQueueHandle)->maxNoOfMsg     = maxNoOfMsg;
                         (*pQueueHandle)->magicNumber    = cQueueMagic;
+                        (*pQueueHandle)->pQueue         = NULL;
+                        (*pQueueHandle)->pSlots         = NULL;
+                        (*pQueueHandle)->slotMask       = 0;
+                        (*pQueueHandle)->waiters        = 0;
+                        (*pQueueHandle)->enqueuePos     = 0;
+                        (*pQueueHandle)->dequeuePos     = 0;
                         /* alloc queue memory */
-                        (*pQueueHandle)->pQueue =
-                            (struct VOS_QUEUE_ELEM *)vos_memAlloc(maxNoOfMsg * sizeof(struct VOS_QUEUE_ELEM));
-                        if ((*pQueueHandle)->pQueue == NULL)
+                        if (queueType == VOS_QUEUE_POLICY_LOCKFREE)
+                        {
+                            UINT32 i, noOfSlots = 2u;
+
+                            while (noOfSlots < maxNoOfMsg)
+                            {
+                                noOfSlots <<= 1u;
+                            }
+                            (*pQueueHandle)->pSlots =
+                                (struct VOS_QUEUE_SLOT *)vos_memAlloc(noOfSlots * sizeof(struct VOS_QUEUE_SLOT));
+                            if ((*pQueueHandle)->pSlots != NULL)
+                            {
+                                (*pQueueHandle)->slotMask = noOfSlots - 1u;
+                                for (i = 0u; i < noOfSlots; i++)
+                                {
+                                    (*pQueueHandle)->pSlots[i].sequence = i;
+                                }
+                            }
+                        }
+                        else
+                        {
+                            (*pQueueHandle)->pQueue =
+                                (struct VOS_QUEUE_ELEM *)vos_memAlloc(maxNoOfMsg * sizeof(struct VOS_QUEUE_ELEM));
+                            if ((*pQueueHandle)->pQueue != NULL)
+                            {
+                                (*pQueueHandle)->pQueue->pData  = NULL;
+                                (*pQueueHandle)->pQueue->size   = 0;
+                            }
+                        }
+                        if (((*pQueueHandle)->pQueue == NULL) && ((*pQueueHandle)->pSlots == NULL))
                         {
                             vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreate() ERROR could not allocate memory\n");
                             retVal = VOS_MEM_ERR;
                         }
                         else
                         {
-                            (*pQueueHandle)->pQueue->pData  = NULL;
-                            (*pQueueHandle)->pQueue->size   = 0;
                             retVal = vos_mutexUnlock((*pQueueHandle)->mutex);
                             if (retVal != VOS_NO_ERR)
                             {
@@ -907,6 +1706,18 @@ EXT_DECL VOS_ERR_T vos_queueSend (
         vos_printLogStr(VOS_LOG_ERROR, "vos_queueSend() ERROR invalid parameter\n");
         retVal = VOS_PARAM_ERR;
     }
+    else if (queueHandle->queueType == VOS_QUEUE_POLICY_LOCKFREE)
+    {
+        if ((size & VOS_QUEUE_COPY_FLAG) != 0u)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "vos_queueSend() ERROR invalid parameter\n");
+            retVal = VOS_PARAM_ERR;
+        }
+        else
+        {
+            retVal = queueLockFreeSend(queueHandle, pData, size);
+        }
+    }
     else
     {
         err = vos_mutexLock(queueHandle->mutex);
@@ -1018,6 +1829,21 @@ EXT_DECL VOS_ERR_T vos_queueReceive (
         vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceive() ERROR invalid parameter\n");
         retVal = VOS_PARAM_ERR;
     }
+    else if (queueHandle->queueType == VOS_QUEUE_POLICY_LOCKFREE)
+    {
+        *ppData = NULL;
+        retVal  = queueLockFreeReceive(queueHandle, ppData, NULL, pSize, usTimeout);
+        if (retVal != VOS_NO_ERR)
+        {
+            *pSize = 0;
+        }
+        else if ((*pSize & VOS_QUEUE_COPY_FLAG) != 0u)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceive() ERROR message was sent by vos_queueSendCopy()\n");
+            *pSize = 0;
+            retVal = VOS_PARAM_ERR;
+        }
+    }
     else
     {
         /* wait for semaphore indicating new message in queue */
@@ -1113,8 +1939,16 @@ EXT_DECL VOS_ERR_T vos_queueDestroy (
         else
         {
             queueHandle->magicNumber = 0;
-            vos_memFree(queueHandle->pQueue);
-            queueHandle->pQueue = NULL;
+            if (queueHandle->pSlots != NULL)
+            {
+                vos_memFree(queueHandle->pSlots);
+                queueHandle->pSlots = NULL;
+            }
+            else
+            {
+                vos_memFree(queueHandle->pQueue);
+                queueHandle->pQueue = NULL;
+            }
         }
         vos_semaDelete(queueHandle->semaphore);
         err = vos_mutexUnlock(queueHandle->mutex);
@@ -1132,3 +1966,85 @@ EXT_DECL VOS_ERR_T vos_queueDestroy (
     }
     return retVal;
 }
+
+/**********************************************************************************************************************/
+/** Send a copy of a small message.
+ *  The data is copied into the queue, the caller keeps ownership of the buffer. Lock free queues only.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[in]      pData           Pointer to data to be sent
+ *  @param[in]      size            Size of data to be sent (max. VOS_QUEUE_INLINE_SIZE)
+ *
+ *  @retval         VOS_NO_ERR          no error
+ *  @retval         VOS_PARAM_ERR       parameter out of range/invalid
+ *  @retval         VOS_QUEUE_FULL_ERR  queue is full
+ */
+
+EXT_DECL VOS_ERR_T vos_queueSendCopy (
+    VOS_QUEUE_T queueHandle,
+    const UINT8 *pData,
+    UINT32      size)
+{
+    if ((queueHandle == (VOS_QUEUE_T) NULL)
+        || (pData == NULL)
+        || (size == 0)
+        || (size > VOS_QUEUE_INLINE_SIZE)
+        || (queueHandle->magicNumber != cQueueMagic)
+        || (queueHandle->queueType != VOS_QUEUE_POLICY_LOCKFREE))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_queueSendCopy() ERROR invalid parameter\n");
+        return VOS_PARAM_ERR;
+    }
+    return queueLockFreeSend(queueHandle, pData, size | VOS_QUEUE_COPY_FLAG);
+}
+
+/**********************************************************************************************************************/
+/** Get a copy of a message sent with vos_queueSendCopy().
+ *  Messages sent with vos_queueSend() must be received with vos_queueReceive() and vice versa.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[out]     pData           Pointer to buffer for the received data
+ *  @param[in,out]  pSize           In: size of the buffer (min. VOS_QUEUE_INLINE_SIZE), out: size of the data
+ *  @param[in]      usTimeout       Maximum time to wait for a message (in usec)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid, message was not sent as copy (and is dropped)
+ *  @retval         VOS_QUEUE_ERR   queue is empty
+ */
+
+EXT_DECL VOS_ERR_T vos_queueReceiveCopy (
+    VOS_QUEUE_T queueHandle,
+    UINT8       *pData,
+    UINT32      *pSize,
+    UINT32      usTimeout)
+{
+    VOS_ERR_T   retVal;
+    UINT8       *pSent = NULL;
+
+    if ((queueHandle == (VOS_QUEUE_T) NULL)
+        || (pData == NULL)
+        || (pSize == NULL)
+        || (*pSize < VOS_QUEUE_INLINE_SIZE)
+        || (queueHandle->magicNumber != cQueueMagic)
+        || (queueHandle->queueType != VOS_QUEUE_POLICY_LOCKFREE))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceiveCopy() ERROR invalid parameter\n");
+        return VOS_PARAM_ERR;
+    }
+    retVal = queueLockFreeReceive(queueHandle, &pSent, pData, pSize, usTimeout);
+    if (retVal != VOS_NO_ERR)
+    {
+        *pSize = 0;
+    }
+    else if ((*pSize & VOS_QUEUE_COPY_FLAG) == 0u)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceiveCopy() ERROR message was sent by vos_queueSend()\n");
+        *pSize = 0;
+        retVal = VOS_PARAM_ERR;
+    }
+    else
+    {
+        *pSize &= ~VOS_QUEUE_COPY_FLAG;
+    }
+    return retVal;
+}
@@ -18,6 +18,7 @@
 /*
 * $Id: vos_utils.c 2188 2020-07-31 09:17:58Z bloehr $
 *
+*      AG 2026-10-17: Slicing-by-8 and PCLMULQDQ (x86-64, runtime detected) versions of vos_crc32 and vos_sc32
 *      BL 2017-05-08: Compiler warnings
 *      BL 2017-02-27: #142 Compiler warnings / MISRA-C 2012 issues
 *      BL 2016-08-17: parentheses added (compiler warning)
@@ -45,12 +46,23 @@
 #define pgm_read_dword(a)  (*(a))
 #endif
 
+/*  VOS_CRC_BYTEWISE:   classic byte-at-a-time CRC only (smallest footprint)
+    VOS_CRC_NO_CLMUL:   do not use the carry-less multiply path on x86-64    */
+#if !defined(VOS_CRC_BYTEWISE) && !defined(VOS_CRC_NO_CLMUL) && defined(__GNUC__) && defined(__x86_64__)
+#define VOS_CRC_CLMUL       1
+#include <immintrin.h>
+#endif
+
 /***********************************************************************************************************************
  * DEFINITIONS
  */
 
 #define NO_OF_ERROR_STRINGS  52u
 
+#ifdef VOS_CRC_CLMUL
+#define VOS_CRC_CLMUL_MIN   128u    /**< below this size slicing-by-8 is faster than folding */
+#endif
+
 /***********************************************************************************************************************
  * GLOBALS
  */
@@ -209,6 +221,945 @@ static const UINT32 sc32_table[256u] PROGMEM =              /**< Table of CRC-32
     0x70629EDFU, 0x84CE65CCU, 0x6D9793EAU, 0x993B68F9U
 };
 
+#ifndef VOS_CRC_BYTEWISE
+/** Slicing-by-8 tables derived from fcs_table: fcs_table8[k - 1][i] is the CRC of byte i followed by k zero bytes
+ *  (tables for 1...7 trailing bytes, fcs_table itself is used for 0)
+ */
+static const UINT32 fcs_table8[7u][256u] PROGMEM =
+{
+    {
+        0x00000000u, 0x191b3141u, 0x32366282u, 0x2b2d53c3u,
+        0x646cc504u, 0x7d77f445u, 0x565aa786u, 0x4f4196c7u,
+        0xc8d98a08u, 0xd1c2bb49u, 0xfaefe88au, 0xe3f4d9cbu,
+        0xacb54f0cu, 0xb5ae7e4du, 0x9e832d8eu, 0x87981ccfu,
+        0x4ac21251u, 0x53d92310u, 0x78f470d3u, 0x61ef4192u,
+        0x2eaed755u, 0x37b5e614u, 0x1c98b5d7u, 0x05838496u,
+        0x821b9859u, 0x9b00a918u, 0xb02dfadbu, 0xa936cb9au,
+        0xe6775d5du, 0xff6c6c1cu, 0xd4413fdfu, 0xcd5a0e9eu,
+        0x958424a2u, 0x8c9f15e3u, 0xa7b24620u, 0xbea97761u,
+        0xf1e8e1a6u, 0xe8f3d0e7u, 0xc3de8324u, 0xdac5b265u,
+        0x5d5daeaau, 0x44469febu, 0x6f6bcc28u, 0x7670fd69u,
+        0x39316baeu, 0x202a5aefu, 0x0b07092cu, 0x121c386du,
+        0xdf4636f3u, 0xc65d07b2u, 0xed705471u, 0xf46b6530u,
+        0xbb2af3f7u, 0xa231c2b6u, 0x891c9175u, 0x9007a034u,
+        0x179fbcfbu, 0x0e848dbau, 0x25a9de79u, 0x3cb2ef38u,
+        0x73f379ffu, 0x6ae848beu, 0x41c51b7du, 0x58de2a3cu,
+        0xf0794f05u, 0xe9627e44u, 0xc24f2d87u, 0xdb541cc6u,
+        0x94158a01u, 0x8d0ebb40u, 0xa623e883u, 0xbf38d9c2u,
+        0x38a0c50du, 0x21bbf44cu, 0x0a96a78fu, 0x138d96ceu,
+        0x5ccc0009u, 0x45d73148u, 0x6efa628bu, 0x77e153cau,
+        0xbabb5d54u, 0xa3a06c15u, 0x888d3fd6u, 0x91960e97u,
+        0xded79850u, 0xc7cca911u, 0xece1fad2u, 0xf5facb93u,
+        0x7262d75cu, 0x6b79e61du, 0x4054b5deu, 0x594f849fu,
+        0x160e1258u, 0x0f152319u, 0x243870dau, 0x3d23419bu,
+        0x65fd6ba7u, 0x7ce65ae6u, 0x57cb0925u, 0x4ed03864u,
+        0x0191aea3u, 0x188a9fe2u, 0x33a7cc21u, 0x2abcfd60u,
+        0xad24e1afu, 0xb43fd0eeu, 0x9f12832du, 0x8609b26cu,
+        0xc94824abu, 0xd05315eau, 0xfb7e4629u, 0xe2657768u,
+        0x2f3f79f6u, 0x362448b7u, 0x1d091b74u, 0x04122a35u,
+        0x4b53bcf2u, 0x52488db3u, 0x7965de70u, 0x607eef31u,
+        0xe7e6f3feu, 0xfefdc2bfu, 0xd5d0917cu, 0xcccba03du,
+        0x838a36fau, 0x9a9107bbu, 0xb1bc5478u, 0xa8a76539u,
+        0x3b83984bu, 0x2298a90au, 0x09b5fac9u, 0x10aecb88u,
+        0x5fef5d4fu, 0x46f46c0eu, 0x6dd93fcdu, 0x74c20e8cu,
+        0xf35a1243u, 0xea412302u, 0xc16c70c1u, 0xd8774180u,
+        0x9736d747u, 0x8e2de606u, 0xa500b5c5u, 0xbc1b8484u,
+        0x71418a1au, 0x685abb5bu, 0x4377e898u, 0x5a6cd9d9u,
+        0x152d4f1eu, 0x0c367e5fu, 0x271b2d9cu, 0x3e001cddu,
+        0xb9980012u, 0xa0833153u, 0x8bae6290u, 0x92b553d1u,
+        0xddf4c516u, 0xc4eff457u, 0xefc2a794u, 0xf6d996d5u,
+        0xae07bce9u, 0xb71c8da8u, 0x9c31de6bu, 0x852aef2au,
+        0xca6b79edu, 0xd37048acu, 0xf85d1b6fu, 0xe1462a2eu,
+        0x66de36e1u, 0x7fc507a0u, 0x54e85463u, 0x4df36522u,
+        0x02b2f3e5u, 0x1ba9c2a4u, 0x30849167u, 0x299fa026u,
+        0xe4c5aeb8u, 0xfdde9ff9u, 0xd6f3cc3au, 0xcfe8fd7bu,
+        0x80a96bbcu, 0x99b25afdu, 0xb29f093eu, 0xab84387fu,
+        0x2c1c24b0u, 0x350715f1u, 0x1e2a4632u, 0x07317773u,
+        0x4870e1b4u, 0x516bd0f5u, 0x7a468336u, 0x635db277u,
+        0xcbfad74eu, 0xd2e1e60fu, 0xf9ccb5ccu, 0xe0d7848du,
+        0xaf96124au, 0xb68d230bu, 0x9da070c8u, 0x84bb4189u,
+        0x03235d46u, 0x1a386c07u, 0x31153fc4u, 0x280e0e85u,
+        0x674f9842u, 0x7e54a903u, 0x5579fac0u, 0x4c62cb81u,
+        0x8138c51fu, 0x9823f45eu, 0xb30ea79du, 0xaa1596dcu,
+        0xe554001bu, 0xfc4f315au, 0xd7626299u, 0xce7953d8u,
+        0x49e14f17u, 0x50fa7e56u, 0x7bd72d95u, 0x62cc1cd4u,
+        0x2d8d8a13u, 0x3496bb52u, 0x1fbbe891u, 0x06a0d9d0u,
+        0x5e7ef3ecu, 0x4765c2adu, 0x6c48916eu, 0x7553a02fu,
+        0x3a1236e8u, 0x230907a9u, 0x0824546au, 0x113f652bu,
+        0x96a779e4u, 0x8fbc48a5u, 0xa4911b66u, 0xbd8a2a27u,
+        0xf2cbbce0u, 0xebd08da1u, 0xc0fdde62u, 0xd9e6ef23u,
+        0x14bce1bdu, 0x0da7d0fcu, 0x268a833fu, 0x3f91b27eu,
+        0x70d024b9u, 0x69cb15f8u, 0x42e6463bu, 0x5bfd777au,
+        0xdc656bb5u, 0xc57e5af4u, 0xee530937u, 0xf7483876u,
+        0xb809aeb1u, 0xa1129ff0u, 0x8a3fcc33u, 0x9324fd72u
+    },
+    {
+        0x00000000u, 0x01c26a37u, 0x0384d46eu, 0x0246be59u,
+        0x0709a8dcu, 0x06cbc2ebu, 0x048d7cb2u, 0x054f1685u,
+        0x0e1351b8u, 0x0fd13b8fu, 0x0d9785d6u, 0x0c55efe1u,
+        0x091af964u, 0x08d89353u, 0x0a9e2d0au, 0x0b5c473du,
+        0x1c26a370u, 0x1de4c947u, 0x1fa2771eu, 0x1e601d29u,
+        0x1b2f0bacu, 0x1aed619bu, 0x18abdfc2u, 0x1969b5f5u,
+        0x1235f2c8u, 0x13f798ffu, 0x11b126a6u, 0x10734c91u,
+        0x153c5a14u, 0x14fe3023u, 0x16b88e7au, 0x177ae44du,
+        0x384d46e0u, 0x398f2cd7u, 0x3bc9928eu, 0x3a0bf8b9u,
+        0x3f44ee3cu, 0x3e86840bu, 0x3cc03a52u, 0x3d025065u,
+        0x365e1758u, 0x379c7d6fu, 0x35dac336u, 0x3418a901u,
+        0x3157bf84u, 0x3095d5b3u, 0x32d36beau, 0x331101ddu,
+        0x246be590u, 0x25a98fa7u, 0x27ef31feu, 0x262d5bc9u,
+        0x23624d4cu, 0x22a0277bu, 0x20e69922u, 0x2124f315u,
+        0x2a78b428u, 0x2bbade1fu, 0x29fc6046u, 0x283e0a71u,
+        0x2d711cf4u, 0x2cb376c3u, 0x2ef5c89au, 0x2f37a2adu,
+        0x709a8dc0u, 0x7158e7f7u, 0x731e59aeu, 0x72dc3399u,
+        0x7793251cu, 0x76514f2bu, 0x7417f172u, 0x75d59b45u,
+        0x7e89dc78u, 0x7f4bb64fu, 0x7d0d0816u, 0x7ccf6221u,
+        0x798074a4u, 0x78421e93u, 0x7a04a0cau, 0x7bc6cafdu,
+        0x6cbc2eb0u, 0x6d7e4487u, 0x6f38fadeu, 0x6efa90e9u,
+        0x6bb5866cu, 0x6a77ec5bu, 0x68315202u, 0x69f33835u,
+        0x62af7f08u, 0x636d153fu, 0x612bab66u, 0x60e9c151u,
+        0x65a6d7d4u, 0x6464bde3u, 0x662203bau, 0x67e0698du,
+        0x48d7cb20u, 0x4915a117u, 0x4b531f4eu, 0x4a917579u,
+        0x4fde63fcu, 0x4e1c09cbu, 0x4c5ab792u, 0x4d98dda5u,
+        0x46c49a98u, 0x4706f0afu, 0x45404ef6u, 0x448224c1u,
+        0x41cd3244u, 0x400f5873u, 0x4249e62au, 0x438b8c1du,
+        0x54f16850u, 0x55330267u, 0x5775bc3eu, 0x56b7d609u,
+        0x53f8c08cu, 0x523aaabbu, 0x507c14e2u, 0x51be7ed5u,
+        0x5ae239e8u, 0x5b2053dfu, 0x5966ed86u, 0x58a487b1u,
+        0x5deb9134u, 0x5c29fb03u, 0x5e6f455au, 0x5fad2f6du,
+        0xe1351b80u, 0xe0f771b7u, 0xe2b1cfeeu, 0xe373a5d9u,
+        0xe63cb35cu, 0xe7fed96bu, 0xe5b86732u, 0xe47a0d05u,
+        0xef264a38u, 0xeee4200fu, 0xeca29e56u, 0xed60f461u,
+        0xe82fe2e4u, 0xe9ed88d3u, 0xebab368au, 0xea695cbdu,
+        0xfd13b8f0u, 0xfcd1d2c7u, 0xfe976c9eu, 0xff5506a9u,
+        0xfa1a102cu, 0xfbd87a1bu, 0xf99ec442u, 0xf85cae75u,
+        0xf300e948u, 0xf2c2837fu, 0xf0843d26u, 0xf1465711u,
+        0xf4094194u, 0xf5cb2ba3u, 0xf78d95fau, 0xf64fffcdu,
+        0xd9785d60u, 0xd8ba3757u, 0xdafc890eu, 0xdb3ee339u,
+        0xde71f5bcu, 0xdfb39f8bu, 0xddf521d2u, 0xdc374be5u,
+        0xd76b0cd8u, 0xd6a966efu, 0xd4efd8b6u, 0xd52db281u,
+        0xd062a404u, 0xd1a0ce33u, 0xd3e6706au, 0xd2241a5du,
+        0xc55efe10u, 0xc49c9427u, 0xc6da2a7eu, 0xc7184049u,
+        0xc25756ccu, 0xc3953cfbu, 0xc1d382a2u, 0xc011e895u,
+        0xcb4dafa8u, 0xca8fc59fu, 0xc8c97bc6u, 0xc90b11f1u,
+        0xcc440774u, 0xcd866d43u, 0xcfc0d31au, 0xce02b92du,
+        0x91af9640u, 0x906dfc77u, 0x922b422eu, 0x93e92819u,
+        0x96a63e9cu, 0x976454abu, 0x9522eaf2u, 0x94e080c5u,
+        0x9fbcc7f8u, 0x9e7eadcfu, 0x9c381396u, 0x9dfa79a1u,
+        0x98b56f24u, 0x99770513u, 0x9b31bb4au, 0x9af3d17du,
+        0x8d893530u, 0x8c4b5f07u, 0x8e0de15eu, 0x8fcf8b69u,
+        0x8a809decu, 0x8b42f7dbu, 0x89044982u, 0x88c623b5u,
+        0x839a6488u, 0x82580ebfu, 0x801eb0e6u, 0x81dcdad1u,
+        0x8493cc54u, 0x8551a663u, 0x8717183au, 0x86d5720du,
+        0xa9e2d0a0u, 0xa820ba97u, 0xaa6604ceu, 0xaba46ef9u,
+        0xaeeb787cu, 0xaf29124bu, 0xad6fac12u, 0xacadc625u,
+        0xa7f18118u, 0xa633eb2fu, 0xa4755576u, 0xa5b73f41u,
+        0xa0f829c4u, 0xa13a43f3u, 0xa37cfdaau, 0xa2be979du,
+        0xb5c473d0u, 0xb40619e7u, 0xb640a7beu, 0xb782cd89u,
+        0xb2cddb0cu, 0xb30fb13bu, 0xb1490f62u, 0xb08b6555u,
+        0xbbd72268u, 0xba15485fu, 0xb853f606u, 0xb9919c31u,
+        0xbcde8ab4u, 0xbd1ce083u, 0xbf5a5edau, 0xbe9834edu
+    },
+    {
+        0x00000000u, 0xb8bc6765u, 0xaa09c88bu, 0x12b5afeeu,
+        0x8f629757u, 0x37def032u, 0x256b5fdcu, 0x9dd738b9u,
+        0xc5b428efu, 0x7d084f8au, 0x6fbde064u, 0xd7018701u,
+        0x4ad6bfb8u, 0xf26ad8ddu, 0xe0df7733u, 0x58631056u,
+        0x5019579fu, 0xe8a530fau, 0xfa109f14u, 0x42acf871u,
+        0xdf7bc0c8u, 0x67c7a7adu, 0x75720843u, 0xcdce6f26u,
+        0x95ad7f70u, 0x2d111815u, 0x3fa4b7fbu, 0x8718d09eu,
+        0x1acfe827u, 0xa2738f42u, 0xb0c620acu, 0x087a47c9u,
+        0xa032af3eu, 0x188ec85bu, 0x0a3b67b5u, 0xb28700d0u,
+        0x2f503869u, 0x97ec5f0cu, 0x8559f0e2u, 0x3de59787u,
+        0x658687d1u, 0xdd3ae0b4u, 0xcf8f4f5au, 0x7733283fu,
+        0xeae41086u, 0x525877e3u, 0x40edd80du, 0xf851bf68u,
+        0xf02bf8a1u, 0x48979fc4u, 0x5a22302au, 0xe29e574fu,
+        0x7f496ff6u, 0xc7f50893u, 0xd540a77du, 0x6dfcc018u,
+        0x359fd04eu, 0x8d23b72bu, 0x9f9618c5u, 0x272a7fa0u,
+        0xbafd4719u, 0x0241207cu, 0x10f48f92u, 0xa848e8f7u,
+        0x9b14583du, 0x23a83f58u, 0x311d90b6u, 0x89a1f7d3u,
+        0x1476cf6au, 0xaccaa80fu, 0xbe7f07e1u, 0x06c36084u,
+        0x5ea070d2u, 0xe61c17b7u, 0xf4a9b859u, 0x4c15df3cu,
+        0xd1c2e785u, 0x697e80e0u, 0x7bcb2f0eu, 0xc377486bu,
+        0xcb0d0fa2u, 0x73b168c7u, 0x6104c729u, 0xd9b8a04cu,
+        0x446f98f5u, 0xfcd3ff90u, 0xee66507eu, 0x56da371bu,
+        0x0eb9274du, 0xb6054028u, 0xa4b0efc6u, 0x1c0c88a3u,
+        0x81dbb01au, 0x3967d77fu, 0x2bd27891u, 0x936e1ff4u,
+        0x3b26f703u, 0x839a9066u, 0x912f3f88u, 0x299358edu,
+        0xb4446054u, 0x0cf80731u, 0x1e4da8dfu, 0xa6f1cfbau,
+        0xfe92dfecu, 0x462eb889u, 0x549b1767u, 0xec277002u,
+        0x71f048bbu, 0xc94c2fdeu, 0xdbf98030u, 0x6345e755u,
+        0x6b3fa09cu, 0xd383c7f9u, 0xc1366817u, 0x798a0f72u,
+        0xe45d37cbu, 0x5ce150aeu, 0x4e54ff40u, 0xf6e89825u,
+        0xae8b8873u, 0x1637ef16u, 0x048240f8u, 0xbc3e279du,
+        0x21e91f24u, 0x99557841u, 0x8be0d7afu, 0x335cb0cau,
+        0xed59b63bu, 0x55e5d15eu, 0x47507eb0u, 0xffec19d5u,
+        0x623b216cu, 0xda874609u, 0xc832e9e7u, 0x708e8e82u,
+        0x28ed9ed4u, 0x9051f9b1u, 0x82e4565fu, 0x3a58313au,
+        0xa78f0983u, 0x1f336ee6u, 0x0d86c108u, 0xb53aa66du,
+        0xbd40e1a4u, 0x05fc86c1u, 0x1749292fu, 0xaff54e4au,
+        0x322276f3u, 0x8a9e1196u, 0x982bbe78u, 0x2097d91du,
+        0x78f4c94bu, 0xc048ae2eu, 0xd2fd01c0u, 0x6a4166a5u,
+        0xf7965e1cu, 0x4f2a3979u, 0x5d9f9697u, 0xe523f1f2u,
+        0x4d6b1905u, 0xf5d77e60u, 0xe762d18eu, 0x5fdeb6ebu,
+        0xc2098e52u, 0x7ab5e937u, 0x680046d9u, 0xd0bc21bcu,
+        0x88df31eau, 0x3063568fu, 0x22d6f961u, 0x9a6a9e04u,
+        0x07bda6bdu, 0xbf01c1d8u, 0xadb46e36u, 0x15080953u,
+        0x1d724e9au, 0xa5ce29ffu, 0xb77b8611u, 0x0fc7e174u,
+        0x9210d9cdu, 0x2aacbea8u, 0x38191146u, 0x80a57623u,
+        0xd8c66675u, 0x607a0110u, 0x72cfaefeu, 0xca73c99bu,
+        0x57a4f122u, 0xef189647u, 0xfdad39a9u, 0x45115eccu,
+        0x764dee06u, 0xcef18963u, 0xdc44268du, 0x64f841e8u,
+        0xf92f7951u, 0x41931e34u, 0x5326b1dau, 0xeb9ad6bfu,
+        0xb3f9c6e9u, 0x0b45a18cu, 0x19f00e62u, 0xa14c6907u,
+        0x3c9b51beu, 0x842736dbu, 0x96929935u, 0x2e2efe50u,
+        0x2654b999u, 0x9ee8defcu, 0x8c5d7112u, 0x34e11677u,
+        0xa9362eceu, 0x118a49abu, 0x033fe645u, 0xbb838120u,
+        0xe3e09176u, 0x5b5cf613u, 0x49e959fdu, 0xf1553e98u,
+        0x6c820621u, 0xd43e6144u, 0xc68bceaau, 0x7e37a9cfu,
+        0xd67f4138u, 0x6ec3265du, 0x7c7689b3u, 0xc4caeed6u,
+        0x591dd66fu, 0xe1a1b10au, 0xf3141ee4u, 0x4ba87981u,
+        0x13cb69d7u, 0xab770eb2u, 0xb9c2a15cu, 0x017ec639u,
+        0x9ca9fe80u, 0x241599e5u, 0x36a0360bu, 0x8e1c516eu,
+        0x866616a7u, 0x3eda71c2u, 0x2c6fde2cu, 0x94d3b949u,
+        0x090481f0u, 0xb1b8e695u, 0xa30d497bu, 0x1bb12e1eu,
+        0x43d23e48u, 0xfb6e592du, 0xe9dbf6c3u, 0x516791a6u,
+        0xccb0a91fu, 0x740cce7au, 0x66b96194u, 0xde0506f1u
+    },
+    {
+        0x00000000u, 0x3d6029b0u, 0x7ac05360u, 0x47a07ad0u,
+        0xf580a6c0u, 0xc8e08f70u, 0x8f40f5a0u, 0xb220dc10u,
+        0x30704bc1u, 0x0d106271u, 0x4ab018a1u, 0x77d03111u,
+        0xc5f0ed01u, 0xf890c4b1u, 0xbf30be61u, 0x825097d1u,
+        0x60e09782u, 0x5d80be32u, 0x1a20c4e2u, 0x2740ed52u,
+        0x95603142u, 0xa80018f2u, 0xefa06222u, 0xd2c04b92u,
+        0x5090dc43u, 0x6df0f5f3u, 0x2a508f23u, 0x1730a693u,
+        0xa5107a83u, 0x98705333u, 0xdfd029e3u, 0xe2b00053u,
+        0xc1c12f04u, 0xfca106b4u, 0xbb017c64u, 0x866155d4u,
+        0x344189c4u, 0x0921a074u, 0x4e81daa4u, 0x73e1f314u,
+        0xf1b164c5u, 0xccd14d75u, 0x8b7137a5u, 0xb6111e15u,
+        0x0431c205u, 0x3951ebb5u, 0x7ef19165u, 0x4391b8d5u,
+        0xa121b886u, 0x9c419136u, 0xdbe1ebe6u, 0xe681c256u,
+        0x54a11e46u, 0x69c137f6u, 0x2e614d26u, 0x13016496u,
+        0x9151f347u, 0xac31daf7u, 0xeb91a027u, 0xd6f18997u,
+        0x64d15587u, 0x59b17c37u, 0x1e1106e7u, 0x23712f57u,
+        0x58f35849u, 0x659371f9u, 0x22330b29u, 0x1f532299u,
+        0xad73fe89u, 0x9013d739u, 0xd7b3ade9u, 0xead38459u,
+        0x68831388u, 0x55e33a38u, 0x124340e8u, 0x2f236958u,
+        0x9d03b548u, 0xa0639cf8u, 0xe7c3e628u, 0xdaa3cf98u,
+        0x3813cfcbu, 0x0573e67bu, 0x42d39cabu, 0x7fb3b51bu,
+        0xcd93690bu, 0xf0f340bbu, 0xb7533a6bu, 0x8a3313dbu,
+        0x0863840au, 0x3503adbau, 0x72a3d76au, 0x4fc3fedau,
+        0xfde322cau, 0xc0830b7au, 0x872371aau, 0xba43581au,
+        0x9932774du, 0xa4525efdu, 0xe3f2242du, 0xde920d9du,
+        0x6cb2d18du, 0x51d2f83du, 0x167282edu, 0x2b12ab5du,
+        0xa9423c8cu, 0x9422153cu, 0xd3826fecu, 0xeee2465cu,
+        0x5cc29a4cu, 0x61a2b3fcu, 0x2602c92cu, 0x1b62e09cu,
+        0xf9d2e0cfu, 0xc4b2c97fu, 0x8312b3afu, 0xbe729a1fu,
+        0x0c52460fu, 0x31326fbfu, 0x7692156fu, 0x4bf23cdfu,
+        0xc9a2ab0eu, 0xf4c282beu, 0xb362f86eu, 0x8e02d1deu,
+        0x3c220dceu, 0x0142247eu, 0x46e25eaeu, 0x7b82771eu,
+        0xb1e6b092u, 0x8c869922u, 0xcb26e3f2u, 0xf646ca42u,
+        0x44661652u, 0x79063fe2u, 0x3ea64532u, 0x03c66c82u,
+        0x8196fb53u, 0xbcf6d2e3u, 0xfb56a833u, 0xc6368183u,
+        0x74165d93u, 0x49767423u, 0x0ed60ef3u, 0x33b62743u,
+        0xd1062710u, 0xec660ea0u, 0xabc67470u, 0x96a65dc0u,
+        0x248681d0u, 0x19e6a860u, 0x5e46d2b0u, 0x6326fb00u,
+        0xe1766cd1u, 0xdc164561u, 0x9bb63fb1u, 0xa6d61601u,
+        0x14f6ca11u, 0x2996e3a1u, 0x6e369971u, 0x5356b0c1u,
+        0x70279f96u, 0x4d47b626u, 0x0ae7ccf6u, 0x3787e546u,
+        0x85a73956u, 0xb8c710e6u, 0xff676a36u, 0xc2074386u,
+        0x4057d457u, 0x7d37fde7u, 0x3a978737u, 0x07f7ae87u,
+        0xb5d77297u, 0x88b75b27u, 0xcf1721f7u, 0xf2770847u,
+        0x10c70814u, 0x2da721a4u, 0x6a075b74u, 0x576772c4u,
+        0xe547aed4u, 0xd8278764u, 0x9f87fdb4u, 0xa2e7d404u,
+        0x20b743d5u, 0x1dd76a65u, 0x5a7710b5u, 0x67173905u,
+        0xd537e515u, 0xe857cca5u, 0xaff7b675u, 0x92979fc5u,
+        0xe915e8dbu, 0xd475c16bu, 0x93d5bbbbu, 0xaeb5920bu,
+        0x1c954e1bu, 0x21f567abu, 0x66551d7bu, 0x5b3534cbu,
+        0xd965a31au, 0xe4058aaau, 0xa3a5f07au, 0x9ec5d9cau,
+        0x2ce505dau, 0x11852c6au, 0x562556bau, 0x6b457f0au,
+        0x89f57f59u, 0xb49556e9u, 0xf3352c39u, 0xce550589u,
+        0x7c75d999u, 0x4115f029u, 0x06b58af9u, 0x3bd5a349u,
+        0xb9853498u, 0x84e51d28u, 0xc34567f8u, 0xfe254e48u,
+        0x4c059258u, 0x7165bbe8u, 0x36c5c138u, 0x0ba5e888u,
+        0x28d4c7dfu, 0x15b4ee6fu, 0x521494bfu, 0x6f74bd0fu,
+        0xdd54611fu, 0xe03448afu, 0xa794327fu, 0x9af41bcfu,
+        0x18a48c1eu, 0x25c4a5aeu, 0x6264df7eu, 0x5f04f6ceu,
+        0xed242adeu, 0xd044036eu, 0x97e479beu, 0xaa84500eu,
+        0x4834505du, 0x755479edu, 0x32f4033du, 0x0f942a8du,
+        0xbdb4f69du, 0x80d4df2du, 0xc774a5fdu, 0xfa148c4du,
+        0x78441b9cu, 0x4524322cu, 0x028448fcu, 0x3fe4614cu,
+        0x8dc4bd5cu, 0xb0a494ecu, 0xf704ee3cu, 0xca64c78cu
+    },
+    {
+        0x00000000u, 0xcb5cd3a5u, 0x4dc8a10bu, 0x869472aeu,
+        0x9b914216u, 0x50cd91b3u, 0xd659e31du, 0x1d0530b8u,
+        0xec53826du, 0x270f51c8u, 0xa19b2366u, 0x6ac7f0c3u,
+        0x77c2c07bu, 0xbc9e13deu, 0x3a0a6170u, 0xf156b2d5u,
+        0x03d6029bu, 0xc88ad13eu, 0x4e1ea390u, 0x85427035u,
+        0x9847408du, 0x531b9328u, 0xd58fe186u, 0x1ed33223u,
+        0xef8580f6u, 0x24d95353u, 0xa24d21fdu, 0x6911f258u,
+        0x7414c2e0u, 0xbf481145u, 0x39dc63ebu, 0xf280b04eu,
+        0x07ac0536u, 0xccf0d693u, 0x4a64a43du, 0x81387798u,
+        0x9c3d4720u, 0x57619485u, 0xd1f5e62bu, 0x1aa9358eu,
+        0xebff875bu, 0x20a354feu, 0xa6372650u, 0x6d6bf5f5u,
+        0x706ec54du, 0xbb3216e8u, 0x3da66446u, 0xf6fab7e3u,
+        0x047a07adu, 0xcf26d408u, 0x49b2a6a6u, 0x82ee7503u,
+        0x9feb45bbu, 0x54b7961eu, 0xd223e4b0u, 0x197f3715u,
+        0xe82985c0u, 0x23755665u, 0xa5e124cbu, 0x6ebdf76eu,
+        0x73b8c7d6u, 0xb8e41473u, 0x3e7066ddu, 0xf52cb578u,
+        0x0f580a6cu, 0xc404d9c9u, 0x4290ab67u, 0x89cc78c2u,
+        0x94c9487au, 0x5f959bdfu, 0xd901e971u, 0x125d3ad4u,
+        0xe30b8801u, 0x28575ba4u, 0xaec3290au, 0x659ffaafu,
+        0x789aca17u, 0xb3c619b2u, 0x35526b1cu, 0xfe0eb8b9u,
+        0x0c8e08f7u, 0xc7d2db52u, 0x4146a9fcu, 0x8a1a7a59u,
+        0x971f4ae1u, 0x5c439944u, 0xdad7ebeau, 0x118b384fu,
+        0xe0dd8a9au, 0x2b81593fu, 0xad152b91u, 0x6649f834u,
+        0x7b4cc88cu, 0xb0101b29u, 0x36846987u, 0xfdd8ba22u,
+        0x08f40f5au, 0xc3a8dcffu, 0x453cae51u, 0x8e607df4u,
+        0x93654d4cu, 0x58399ee9u, 0xdeadec47u, 0x15f13fe2u,
+        0xe4a78d37u, 0x2ffb5e92u, 0xa96f2c3cu, 0x6233ff99u,
+        0x7f36cf21u, 0xb46a1c84u, 0x32fe6e2au, 0xf9a2bd8fu,
+        0x0b220dc1u, 0xc07ede64u, 0x46eaaccau, 0x8db67f6fu,
+        0x90b34fd7u, 0x5bef9c72u, 0xdd7beedcu, 0x16273d79u,
+        0xe7718facu, 0x2c2d5c09u, 0xaab92ea7u, 0x61e5fd02u,
+        0x7ce0cdbau, 0xb7bc1e1fu, 0x31286cb1u, 0xfa74bf14u,
+        0x1eb014d8u, 0xd5ecc77du, 0x5378b5d3u, 0x98246676u,
+        0x852156ceu, 0x4e7d856bu, 0xc8e9f7c5u, 0x03b52460u,
+        0xf2e396b5u, 0x39bf4510u, 0xbf2b37beu, 0x7477e41bu,
+        0x6972d4a3u, 0xa22e0706u, 0x24ba75a8u, 0xefe6a60du,
+        0x1d661643u, 0xd63ac5e6u, 0x50aeb748u, 0x9bf264edu,
+        0x86f75455u, 0x4dab87f0u, 0xcb3ff55eu, 0x006326fbu,
+        0xf135942eu, 0x3a69478bu, 0xbcfd3525u, 0x77a1e680u,
+        0x6aa4d638u, 0xa1f8059du, 0x276c7733u, 0xec30a496u,
+        0x191c11eeu, 0xd240c24bu, 0x54d4b0e5u, 0x9f886340u,
+        0x828d53f8u, 0x49d1805du, 0xcf45f2f3u, 0x04192156u,
+        0xf54f9383u, 0x3e134026u, 0xb8873288u, 0x73dbe12du,
+        0x6eded195u, 0xa5820230u, 0x2316709eu, 0xe84aa33bu,
+        0x1aca1375u, 0xd196c0d0u, 0x5702b27eu, 0x9c5e61dbu,
+        0x815b5163u, 0x4a0782c6u, 0xcc93f068u, 0x07cf23cdu,
+        0xf6999118u, 0x3dc542bdu, 0xbb513013u, 0x700de3b6u,
+        0x6d08d30eu, 0xa65400abu, 0x20c07205u, 0xeb9ca1a0u,
+        0x11e81eb4u, 0xdab4cd11u, 0x5c20bfbfu, 0x977c6c1au,
+        0x8a795ca2u, 0x41258f07u, 0xc7b1fda9u, 0x0ced2e0cu,
+        0xfdbb9cd9u, 0x36e74f7cu, 0xb0733dd2u, 0x7b2fee77u,
+        0x662adecfu, 0xad760d6au, 0x2be27fc4u, 0xe0beac61u,
+        0x123e1c2fu, 0xd962cf8au, 0x5ff6bd24u, 0x94aa6e81u,
+        0x89af5e39u, 0x42f38d9cu, 0xc467ff32u, 0x0f3b2c97u,
+        0xfe6d9e42u, 0x35314de7u, 0xb3a53f49u, 0x78f9ececu,
+        0x65fcdc54u, 0xaea00ff1u, 0x28347d5fu, 0xe368aefau,
+        0x16441b82u, 0xdd18c827u, 0x5b8cba89u, 0x90d0692cu,
+        0x8dd55994u, 0x46898a31u, 0xc01df89fu, 0x0b412b3au,
+        0xfa1799efu, 0x314b4a4au, 0xb7df38e4u, 0x7c83eb41u,
+        0x6186dbf9u, 0xaada085cu, 0x2c4e7af2u, 0xe712a957u,
+        0x15921919u, 0xdececabcu, 0x585ab812u, 0x93066bb7u,
+        0x8e035b0fu, 0x455f88aau, 0xc3cbfa04u, 0x089729a1u,
+        0xf9c19b74u, 0x329d48d1u, 0xb4093a7fu, 0x7f55e9dau,
+        0x6250d962u, 0xa90c0ac7u, 0x2f987869u, 0xe4c4abccu
+    },
+    {
+        0x00000000u, 0xa6770bb4u, 0x979f1129u, 0x31e81a9du,
+        0xf44f2413u, 0x52382fa7u, 0x63d0353au, 0xc5a73e8eu,
+        0x33ef4e67u, 0x959845d3u, 0xa4705f4eu, 0x020754fau,
+        0xc7a06a74u, 0x61d761c0u, 0x503f7b5du, 0xf64870e9u,
+        0x67de9cceu, 0xc1a9977au, 0xf0418de7u, 0x56368653u,
+        0x9391b8ddu, 0x35e6b369u, 0x040ea9f4u, 0xa279a240u,
+        0x5431d2a9u, 0xf246d91du, 0xc3aec380u, 0x65d9c834u,
+        0xa07ef6bau, 0x0609fd0eu, 0x37e1e793u, 0x9196ec27u,
+        0xcfbd399cu, 0x69ca3228u, 0x582228b5u, 0xfe552301u,
+        0x3bf21d8fu, 0x9d85163bu, 0xac6d0ca6u, 0x0a1a0712u,
+        0xfc5277fbu, 0x5a257c4fu, 0x6bcd66d2u, 0xcdba6d66u,
+        0x081d53e8u, 0xae6a585cu, 0x9f8242c1u, 0x39f54975u,
+        0xa863a552u, 0x0e14aee6u, 0x3ffcb47bu, 0x998bbfcfu,
+        0x5c2c8141u, 0xfa5b8af5u, 0xcbb39068u, 0x6dc49bdcu,
+        0x9b8ceb35u, 0x3dfbe081u, 0x0c13fa1cu, 0xaa64f1a8u,
+        0x6fc3cf26u, 0xc9b4c492u, 0xf85cde0fu, 0x5e2bd5bbu,
+        0x440b7579u, 0xe27c7ecdu, 0xd3946450u, 0x75e36fe4u,
+        0xb044516au, 0x16335adeu, 0x27db4043u, 0x81ac4bf7u,
+        0x77e43b1eu, 0xd19330aau, 0xe07b2a37u, 0x460c2183u,
+        0x83ab1f0du, 0x25dc14b9u, 0x14340e24u, 0xb2430590u,
+        0x23d5e9b7u, 0x85a2e203u, 0xb44af89eu, 0x123df32au,
+        0xd79acda4u, 0x71edc610u, 0x4005dc8du, 0xe672d739u,
+        0x103aa7d0u, 0xb64dac64u, 0x87a5b6f9u, 0x21d2bd4du,
+        0xe47583c3u, 0x42028877u, 0x73ea92eau, 0xd59d995eu,
+        0x8bb64ce5u, 0x2dc14751u, 0x1c295dccu, 0xba5e5678u,
+        0x7ff968f6u, 0xd98e6342u, 0xe86679dfu, 0x4e11726bu,
+        0xb8590282u, 0x1e2e0936u, 0x2fc613abu, 0x89b1181fu,
+        0x4c162691u, 0xea612d25u, 0xdb8937b8u, 0x7dfe3c0cu,
+        0xec68d02bu, 0x4a1fdb9fu, 0x7bf7c102u, 0xdd80cab6u,
+        0x1827f438u, 0xbe50ff8cu, 0x8fb8e511u, 0x29cfeea5u,
+        0xdf879e4cu, 0x79f095f8u, 0x48188f65u, 0xee6f84d1u,
+        0x2bc8ba5fu, 0x8dbfb1ebu, 0xbc57ab76u, 0x1a20a0c2u,
+        0x8816eaf2u, 0x2e61e146u, 0x1f89fbdbu, 0xb9fef06fu,
+        0x7c59cee1u, 0xda2ec555u, 0xebc6dfc8u, 0x4db1d47cu,
+        0xbbf9a495u, 0x1d8eaf21u, 0x2c66b5bcu, 0x8a11be08u,
+        0x4fb68086u, 0xe9c18b32u, 0xd82991afu, 0x7e5e9a1bu,
+        0xefc8763cu, 0x49bf7d88u, 0x78576715u, 0xde206ca1u,
+        0x1b87522fu, 0xbdf0599bu, 0x8c184306u, 0x2a6f48b2u,
+        0xdc27385bu, 0x7a5033efu, 0x4bb82972u, 0xedcf22c6u,
+        0x28681c48u, 0x8e1f17fcu, 0xbff70d61u, 0x198006d5u,
+        0x47abd36eu, 0xe1dcd8dau, 0xd034c247u, 0x7643c9f3u,
+        0xb3e4f77du, 0x1593fcc9u, 0x247be654u, 0x820cede0u,
+        0x74449d09u, 0xd23396bdu, 0xe3db8c20u, 0x45ac8794u,
+        0x800bb91au, 0x267cb2aeu, 0x1794a833u, 0xb1e3a387u,
+        0x20754fa0u, 0x86024414u, 0xb7ea5e89u, 0x119d553du,
+        0xd43a6bb3u, 0x724d6007u, 0x43a57a9au, 0xe5d2712eu,
+        0x139a01c7u, 0xb5ed0a73u, 0x840510eeu, 0x22721b5au,
+        0xe7d525d4u, 0x41a22e60u, 0x704a34fdu, 0xd63d3f49u,
+        0xcc1d9f8bu, 0x6a6a943fu, 0x5b828ea2u, 0xfdf58516u,
+        0x3852bb98u, 0x9e25b02cu, 0xafcdaab1u, 0x09baa105u,
+        0xfff2d1ecu, 0x5985da58u, 0x686dc0c5u, 0xce1acb71u,
+        0x0bbdf5ffu, 0xadcafe4bu, 0x9c22e4d6u, 0x3a55ef62u,
+        0xabc30345u, 0x0db408f1u, 0x3c5c126cu, 0x9a2b19d8u,
+        0x5f8c2756u, 0xf9fb2ce2u, 0xc813367fu, 0x6e643dcbu,
+        0x982c4d22u, 0x3e5b4696u, 0x0fb35c0bu, 0xa9c457bfu,
+        0x6c636931u, 0xca146285u, 0xfbfc7818u, 0x5d8b73acu,
+        0x03a0a617u, 0xa5d7ada3u, 0x943fb73eu, 0x3248bc8au,
+        0xf7ef8204u, 0x519889b0u, 0x6070932du, 0xc6079899u,
+        0x304fe870u, 0x9638e3c4u, 0xa7d0f959u, 0x01a7f2edu,
+        0xc400cc63u, 0x6277c7d7u, 0x539fdd4au, 0xf5e8d6feu,
+        0x647e3ad9u, 0xc209316du, 0xf3e12bf0u, 0x55962044u,
+        0x90311ecau, 0x3646157eu, 0x07ae0fe3u, 0xa1d90457u,
+        0x579174beu, 0xf1e67f0au, 0xc00e6597u, 0x66796e23u,
+        0xa3de50adu, 0x05a95b19u, 0x34414184u, 0x92364a30u
+    },
+    {
+        0x00000000u, 0xccaa009eu, 0x4225077du, 0x8e8f07e3u,
+        0x844a0efau, 0x48e00e64u, 0xc66f0987u, 0x0ac50919u,
+        0xd3e51bb5u, 0x1f4f1b2bu, 0x91c01cc8u, 0x5d6a1c56u,
+        0x57af154fu, 0x9b0515d1u, 0x158a1232u, 0xd92012acu,
+        0x7cbb312bu, 0xb01131b5u, 0x3e9e3656u, 0xf23436c8u,
+        0xf8f13fd1u, 0x345b3f4fu, 0xbad438acu, 0x767e3832u,
+        0xaf5e2a9eu, 0x63f42a00u, 0xed7b2de3u, 0x21d12d7du,
+        0x2b142464u, 0xe7be24fau, 0x69312319u, 0xa59b2387u,
+        0xf9766256u, 0x35dc62c8u, 0xbb53652bu, 0x77f965b5u,
+        0x7d3c6cacu, 0xb1966c32u, 0x3f196bd1u, 0xf3b36b4fu,
+        0x2a9379e3u, 0xe639797du, 0x68b67e9eu, 0xa41c7e00u,
+        0xaed97719u, 0x62737787u, 0xecfc7064u, 0x205670fau,
+        0x85cd537du, 0x496753e3u, 0xc7e85400u, 0x0b42549eu,
+        0x01875d87u, 0xcd2d5d19u, 0x43a25afau, 0x8f085a64u,
+        0x562848c8u, 0x9a824856u, 0x140d4fb5u, 0xd8a74f2bu,
+        0xd2624632u, 0x1ec846acu, 0x9047414fu, 0x5ced41d1u,
+        0x299dc2edu, 0xe537c273u, 0x6bb8c590u, 0xa712c50eu,
+        0xadd7cc17u, 0x617dcc89u, 0xeff2cb6au, 0x2358cbf4u,
+        0xfa78d958u, 0x36d2d9c6u, 0xb85dde25u, 0x74f7debbu,
+        0x7e32d7a2u, 0xb298d73cu, 0x3c17d0dfu, 0xf0bdd041u,
+        0x5526f3c6u, 0x998cf358u, 0x1703f4bbu, 0xdba9f425u,
+        0xd16cfd3cu, 0x1dc6fda2u, 0x9349fa41u, 0x5fe3fadfu,
+        0x86c3e873u, 0x4a69e8edu, 0xc4e6ef0eu, 0x084cef90u,
+        0x0289e689u, 0xce23e617u, 0x40ace1f4u, 0x8c06e16au,
+        0xd0eba0bbu, 0x1c41a025u, 0x92cea7c6u, 0x5e64a758u,
+        0x54a1ae41u, 0x980baedfu, 0x1684a93cu, 0xda2ea9a2u,
+        0x030ebb0eu, 0xcfa4bb90u, 0x412bbc73u, 0x8d81bcedu,
+        0x8744b5f4u, 0x4beeb56au, 0xc561b289u, 0x09cbb217u,
+        0xac509190u, 0x60fa910eu, 0xee7596edu, 0x22df9673u,
+        0x281a9f6au, 0xe4b09ff4u, 0x6a3f9817u, 0xa6959889u,
+        0x7fb58a25u, 0xb31f8abbu, 0x3d908d58u, 0xf13a8dc6u,
+        0xfbff84dfu, 0x37558441u, 0xb9da83a2u, 0x7570833cu,
+        0x533b85dau, 0x9f918544u, 0x111e82a7u, 0xddb48239u,
+        0xd7718b20u, 0x1bdb8bbeu, 0x95548c5du, 0x59fe8cc3u,
+        0x80de9e6fu, 0x4c749ef1u, 0xc2fb9912u, 0x0e51998cu,
+        0x04949095u, 0xc83e900bu, 0x46b197e8u, 0x8a1b9776u,
+        0x2f80b4f1u, 0xe32ab46fu, 0x6da5b38cu, 0xa10fb312u,
+        0xabcaba0bu, 0x6760ba95u, 0xe9efbd76u, 0x2545bde8u,
+        0xfc65af44u, 0x30cfafdau, 0xbe40a839u, 0x72eaa8a7u,
+        0x782fa1beu, 0xb485a120u, 0x3a0aa6c3u, 0xf6a0a65du,
+        0xaa4de78cu, 0x66e7e712u, 0xe868e0f1u, 0x24c2e06fu,
+        0x2e07e976u, 0xe2ade9e8u, 0x6c22ee0bu, 0xa088ee95u,
+        0x79a8fc39u, 0xb502fca7u, 0x3b8dfb44u, 0xf727fbdau,
+        0xfde2f2c3u, 0x3148f25du, 0xbfc7f5beu, 0x736df520u,
+        0xd6f6d6a7u, 0x1a5cd639u, 0x94d3d1dau, 0x5879d144u,
+        0x52bcd85du, 0x9e16d8c3u, 0x1099df20u, 0xdc33dfbeu,
+        0x0513cd12u, 0xc9b9cd8cu, 0x4736ca6fu, 0x8b9ccaf1u,
+        0x8159c3e8u, 0x4df3c376u, 0xc37cc495u, 0x0fd6c40bu,
+        0x7aa64737u, 0xb60c47a9u, 0x3883404au, 0xf42940d4u,
+        0xfeec49cdu, 0x32464953u, 0xbcc94eb0u, 0x70634e2eu,
+        0xa9435c82u, 0x65e95c1cu, 0xeb665bffu, 0x27cc5b61u,
+        0x2d095278u, 0xe1a352e6u, 0x6f2c5505u, 0xa386559bu,
+        0x061d761cu, 0xcab77682u, 0x44387161u, 0x889271ffu,
+        0x825778e6u, 0x4efd7878u, 0xc0727f9bu, 0x0cd87f05u,
+        0xd5f86da9u, 0x19526d37u, 0x97dd6ad4u, 0x5b776a4au,
+        0x51b26353u, 0x9d1863cdu, 0x1397642eu, 0xdf3d64b0u,
+        0x83d02561u, 0x4f7a25ffu, 0xc1f5221cu, 0x0d5f2282u,
+        0x079a2b9bu, 0xcb302b05u, 0x45bf2ce6u, 0x89152c78u,
+        0x50353ed4u, 0x9c9f3e4au, 0x121039a9u, 0xdeba3937u,
+        0xd47f302eu, 0x18d530b0u, 0x965a3753u, 0x5af037cdu,
+        0xff6b144au, 0x33c114d4u, 0xbd4e1337u, 0x71e413a9u,
+        0x7b211ab0u, 0xb78b1a2eu, 0x39041dcdu, 0xf5ae1d53u,
+        0x2c8e0fffu, 0xe0240f61u, 0x6eab0882u, 0xa201081cu,
+        0xa8c40105u, 0x646e019bu, 0xeae10678u, 0x264b06e6u
+    }
+};
+
+/** Slicing-by-8 tables derived from sc32_table: sc32_table8[k - 1][i] is the SC-32 of byte i followed by k zero bytes
+ */
+static const UINT32 sc32_table8[7u][256u] PROGMEM =
+{
+    {
+        0x00000000U, 0xAB4DB90BU, 0xA2378905U, 0x097A300EU,
+        0xB0C3E919U, 0x1B8E5012U, 0x12F4601CU, 0xB9B9D917U,
+        0x952B2921U, 0x3E66902AU, 0x371CA024U, 0x9C51192FU,
+        0x25E8C038U, 0x8EA57933U, 0x87DF493DU, 0x2C92F036U,
+        0xDEFAA951U, 0x75B7105AU, 0x7CCD2054U, 0xD780995FU,
+        0x6E394048U, 0xC574F943U, 0xCC0EC94DU, 0x67437046U,
+        0x4BD18070U, 0xE09C397BU, 0xE9E60975U, 0x42ABB07EU,
+        0xFB126969U, 0x505FD062U, 0x5925E06CU, 0xF2685967U,
+        0x4959A9B1U, 0xE21410BAU, 0xEB6E20B4U, 0x402399BFU,
+        0xF99A40A8U, 0x52D7F9A3U, 0x5BADC9ADU, 0xF0E070A6U,
+        0xDC728090U, 0x773F399BU, 0x7E450995U, 0xD508B09EU,
+        0x6CB16989U, 0xC7FCD082U, 0xCE86E08CU, 0x65CB5987U,
+        0x97A300E0U, 0x3CEEB9EBU, 0x359489E5U, 0x9ED930EEU,
+        0x2760E9F9U, 0x8C2D50F2U, 0x855760FCU, 0x2E1AD9F7U,
+        0x028829C1U, 0xA9C590CAU, 0xA0BFA0C4U, 0x0BF219CFU,
+        0xB24BC0D8U, 0x190679D3U, 0x107C49DDU, 0xBB31F0D6U,
+        0x92B35362U, 0x39FEEA69U, 0x3084DA67U, 0x9BC9636CU,
+        0x2270BA7BU, 0x893D0370U, 0x8047337EU, 0x2B0A8A75U,
+        0x07987A43U, 0xACD5C348U, 0xA5AFF346U, 0x0EE24A4DU,
+        0xB75B935AU, 0x1C162A51U, 0x156C1A5FU, 0xBE21A354U,
+        0x4C49FA33U, 0xE7044338U, 0xEE7E7336U, 0x4533CA3DU,
+        0xFC8A132AU, 0x57C7AA21U, 0x5EBD9A2FU, 0xF5F02324U,
+        0xD962D312U, 0x722F6A19U, 0x7B555A17U, 0xD018E31CU,
+        0x69A13A0BU, 0xC2EC8300U, 0xCB96B30EU, 0x60DB0A05U,
+        0xDBEAFAD3U, 0x70A743D8U, 0x79DD73D6U, 0xD290CADDU,
+        0x6B2913CAU, 0xC064AAC1U, 0xC91E9ACFU, 0x625323C4U,
+        0x4EC1D3F2U, 0xE58C6AF9U, 0xECF65AF7U, 0x47BBE3FCU,
+        0xFE023AEBU, 0x554F83E0U, 0x5C35B3EEU, 0xF7780AE5U,
+        0x05105382U, 0xAE5DEA89U, 0xA727DA87U, 0x0C6A638CU,
+        0xB5D3BA9BU, 0x1E9E0390U, 0x17E4339EU, 0xBCA98A95U,
+        0x903B7AA3U, 0x3B76C3A8U, 0x320CF3A6U, 0x99414AADU,
+        0x20F893BAU, 0x8BB52AB1U, 0x82CF1ABFU, 0x2982A3B4U,
+        0xD1CA5DD7U, 0x7A87E4DCU, 0x73FDD4D2U, 0xD8B06DD9U,
+        0x6109B4CEU, 0xCA440DC5U, 0xC33E3DCBU, 0x687384C0U,
+        0x44E174F6U, 0xEFACCDFDU, 0xE6D6FDF3U, 0x4D9B44F8U,
+        0xF4229DEFU, 0x5F6F24E4U, 0x561514EAU, 0xFD58ADE1U,
+        0x0F30F486U, 0xA47D4D8DU, 0xAD077D83U, 0x064AC488U,
+        0xBFF31D9FU, 0x14BEA494U, 0x1DC4949AU, 0xB6892D91U,
+        0x9A1BDDA7U, 0x315664ACU, 0x382C54A2U, 0x9361EDA9U,
+        0x2AD834BEU, 0x81958DB5U, 0x88EFBDBBU, 0x23A204B0U,
+        0x9893F466U, 0x33DE4D6DU, 0x3AA47D63U, 0x91E9C468U,
+        0x28501D7FU, 0x831DA474U, 0x8A67947AU, 0x212A2D71U,
+        0x0DB8DD47U, 0xA6F5644CU, 0xAF8F5442U, 0x04C2ED49U,
+        0xBD7B345EU, 0x16368D55U, 0x1F4CBD5BU, 0xB4010450U,
+        0x46695D37U, 0xED24E43CU, 0xE45ED432U, 0x4F136D39U,
+        0xF6AAB42EU, 0x5DE70D25U, 0x549D3D2BU, 0xFFD08420U,
+        0xD3427416U, 0x780FCD1DU, 0x7175FD13U, 0xDA384418U,
+        0x63819D0FU, 0xC8CC2404U, 0xC1B6140AU, 0x6AFBAD01U,
+        0x43790EB5U, 0xE834B7BEU, 0xE14E87B0U, 0x4A033EBBU,
+        0xF3BAE7ACU, 0x58F75EA7U, 0x518D6EA9U, 0xFAC0D7A2U,
+        0xD6522794U, 0x7D1F9E9FU, 0x7465AE91U, 0xDF28179AU,
+        0x6691CE8DU, 0xCDDC7786U, 0xC4A64788U, 0x6FEBFE83U,
+        0x9D83A7E4U, 0x36CE1EEFU, 0x3FB42EE1U, 0x94F997EAU,
+        0x2D404EFDU, 0x860DF7F6U, 0x8F77C7F8U, 0x243A7EF3U,
+        0x08A88EC5U, 0xA3E537CEU, 0xAA9F07C0U, 0x01D2BECBU,
+        0xB86B67DCU, 0x1326DED7U, 0x1A5CEED9U, 0xB11157D2U,
+        0x0A20A704U, 0xA16D1E0FU, 0xA8172E01U, 0x035A970AU,
+        0xBAE34E1DU, 0x11AEF716U, 0x18D4C718U, 0xB3997E13U,
+        0x9F0B8E25U, 0x3446372EU, 0x3D3C0720U, 0x9671BE2BU,
+        0x2FC8673CU, 0x8485DE37U, 0x8DFFEE39U, 0x26B25732U,
+        0xD4DA0E55U, 0x7F97B75EU, 0x76ED8750U, 0xDDA03E5BU,
+        0x6419E74CU, 0xCF545E47U, 0xC62E6E49U, 0x6D63D742U,
+        0x41F12774U, 0xEABC9E7FU, 0xE3C6AE71U, 0x488B177AU,
+        0xF132CE6DU, 0x5A7F7766U, 0x53054768U, 0xF848FE63U
+    },
+    {
+        0x00000000U, 0x573840BDU, 0xAE70817AU, 0xF948C1C7U,
+        0xA84DF9E7U, 0xFF75B95AU, 0x063D789DU, 0x51053820U,
+        0xA43708DDU, 0xF30F4860U, 0x0A4789A7U, 0x5D7FC91AU,
+        0x0C7AF13AU, 0x5B42B187U, 0xA20A7040U, 0xF53230FDU,
+        0xBCC2EAA9U, 0xEBFAAA14U, 0x12B26BD3U, 0x458A2B6EU,
+        0x148F134EU, 0x43B753F3U, 0xBAFF9234U, 0xEDC7D289U,
+        0x18F5E274U, 0x4FCDA2C9U, 0xB685630EU, 0xE1BD23B3U,
+        0xB0B81B93U, 0xE7805B2EU, 0x1EC89AE9U, 0x49F0DA54U,
+        0x8D292E41U, 0xDA116EFCU, 0x2359AF3BU, 0x7461EF86U,
+        0x2564D7A6U, 0x725C971BU, 0x8B1456DCU, 0xDC2C1661U,
+        0x291E269CU, 0x7E266621U, 0x876EA7E6U, 0xD056E75BU,
+        0x8153DF7BU, 0xD66B9FC6U, 0x2F235E01U, 0x781B1EBCU,
+        0x31EBC4E8U, 0x66D38455U, 0x9F9B4592U, 0xC8A3052FU,
+        0x99A63D0FU, 0xCE9E7DB2U, 0x37D6BC75U, 0x60EEFCC8U,
+        0x95DCCC35U, 0xC2E48C88U, 0x3BAC4D4FU, 0x6C940DF2U,
+        0x3D9135D2U, 0x6AA9756FU, 0x93E1B4A8U, 0xC4D9F415U,
+        0xEEFEA791U, 0xB9C6E72CU, 0x408E26EBU, 0x17B66656U,
+        0x46B35E76U, 0x118B1ECBU, 0xE8C3DF0CU, 0xBFFB9FB1U,
+        0x4AC9AF4CU, 0x1DF1EFF1U, 0xE4B92E36U, 0xB3816E8BU,
+        0xE28456ABU, 0xB5BC1616U, 0x4CF4D7D1U, 0x1BCC976CU,
+        0x523C4D38U, 0x05040D85U, 0xFC4CCC42U, 0xAB748CFFU,
+        0xFA71B4DFU, 0xAD49F462U, 0x540135A5U, 0x03397518U,
+        0xF60B45E5U, 0xA1330558U, 0x587BC49FU, 0x0F438422U,
+        0x5E46BC02U, 0x097EFCBFU, 0xF0363D78U, 0xA70E7DC5U,
+        0x63D789D0U, 0x34EFC96DU, 0xCDA708AAU, 0x9A9F4817U,
+        0xCB9A7037U, 0x9CA2308AU, 0x65EAF14DU, 0x32D2B1F0U,
+        0xC7E0810DU, 0x90D8C1B0U, 0x69900077U, 0x3EA840CAU,
+        0x6FAD78EAU, 0x38953857U, 0xC1DDF990U, 0x96E5B92DU,
+        0xDF156379U, 0x882D23C4U, 0x7165E203U, 0x265DA2BEU,
+        0x77589A9EU, 0x2060DA23U, 0xD9281BE4U, 0x8E105B59U,
+        0x7B226BA4U, 0x2C1A2B19U, 0xD552EADEU, 0x826AAA63U,
+        0xD36F9243U, 0x8457D2FEU, 0x7D1F1339U, 0x2A275384U,
+        0x2951B431U, 0x7E69F48CU, 0x8721354BU, 0xD01975F6U,
+        0x811C4DD6U, 0xD6240D6BU, 0x2F6CCCACU, 0x78548C11U,
+        0x8D66BCECU, 0xDA5EFC51U, 0x23163D96U, 0x742E7D2BU,
+        0x252B450BU, 0x721305B6U, 0x8B5BC471U, 0xDC6384CCU,
+        0x95935E98U, 0xC2AB1E25U, 0x3BE3DFE2U, 0x6CDB9F5FU,
+        0x3DDEA77FU, 0x6AE6E7C2U, 0x93AE2605U, 0xC49666B8U,
+        0x31A45645U, 0x669C16F8U, 0x9FD4D73FU, 0xC8EC9782U,
+        0x99E9AFA2U, 0xCED1EF1FU, 0x37992ED8U, 0x60A16E65U,
+        0xA4789A70U, 0xF340DACDU, 0x0A081B0AU, 0x5D305BB7U,
+        0x0C356397U, 0x5B0D232AU, 0xA245E2EDU, 0xF57DA250U,
+        0x004F92ADU, 0x5777D210U, 0xAE3F13D7U, 0xF907536AU,
+        0xA8026B4AU, 0xFF3A2BF7U, 0x0672EA30U, 0x514AAA8DU,
+        0x18BA70D9U, 0x4F823064U, 0xB6CAF1A3U, 0xE1F2B11EU,
+        0xB0F7893EU, 0xE7CFC983U, 0x1E870844U, 0x49BF48F9U,
+        0xBC8D7804U, 0xEBB538B9U, 0x12FDF97EU, 0x45C5B9C3U,
+        0x14C081E3U, 0x43F8C15EU, 0xBAB00099U, 0xED884024U,
+        0xC7AF13A0U, 0x9097531DU, 0x69DF92DAU, 0x3EE7D267U,
+        0x6FE2EA47U, 0x38DAAAFAU, 0xC1926B3DU, 0x96AA2B80U,
+        0x63981B7DU, 0x34A05BC0U, 0xCDE89A07U, 0x9AD0DABAU,
+        0xCBD5E29AU, 0x9CEDA227U, 0x65A563E0U, 0x329D235DU,
+        0x7B6DF909U, 0x2C55B9B4U, 0xD51D7873U, 0x822538CEU,
+        0xD32000EEU, 0x84184053U, 0x7D508194U, 0x2A68C129U,
+        0xDF5AF1D4U, 0x8862B169U, 0x712A70AEU, 0x26123013U,
+        0x77170833U, 0x202F488EU, 0xD9678949U, 0x8E5FC9F4U,
+        0x4A863DE1U, 0x1DBE7D5CU, 0xE4F6BC9BU, 0xB3CEFC26U,
+        0xE2CBC406U, 0xB5F384BBU, 0x4CBB457CU, 0x1B8305C1U,
+        0xEEB1353CU, 0xB9897581U, 0x40C1B446U, 0x17F9F4FBU,
+        0x46FCCCDBU, 0x11C48C66U, 0xE88C4DA1U, 0xBFB40D1CU,
+        0xF644D748U, 0xA17C97F5U, 0x58345632U, 0x0F0C168FU,
+        0x5E092EAFU, 0x09316E12U, 0xF079AFD5U, 0xA741EF68U,
+        0x5273DF95U, 0x054B9F28U, 0xFC035EEFU, 0xAB3B1E52U,
+        0xFA3E2672U, 0xAD0666CFU, 0x544EA708U, 0x0376E7B5U
+    },
+    {
+        0x00000000U, 0x52A36862U, 0xA546D0C4U, 0xF7E5B8A6U,
+        0xBE215A9BU, 0xEC8232F9U, 0x1B678A5FU, 0x49C4E23DU,
+        0x88EE4E25U, 0xDA4D2647U, 0x2DA89EE1U, 0x7F0BF683U,
+        0x36CF14BEU, 0x646C7CDCU, 0x9389C47AU, 0xC12AAC18U,
+        0xE5706759U, 0xB7D30F3BU, 0x4036B79DU, 0x1295DFFFU,
+        0x5B513DC2U, 0x09F255A0U, 0xFE17ED06U, 0xACB48564U,
+        0x6D9E297CU, 0x3F3D411EU, 0xC8D8F9B8U, 0x9A7B91DAU,
+        0xD3BF73E7U, 0x811C1B85U, 0x76F9A323U, 0x245ACB41U,
+        0x3E4C35A1U, 0x6CEF5DC3U, 0x9B0AE565U, 0xC9A98D07U,
+        0x806D6F3AU, 0xD2CE0758U, 0x252BBFFEU, 0x7788D79CU,
+        0xB6A27B84U, 0xE40113E6U, 0x13E4AB40U, 0x4147C322U,
+        0x0883211FU, 0x5A20497DU, 0xADC5F1DBU, 0xFF6699B9U,
+        0xDB3C52F8U, 0x899F3A9AU, 0x7E7A823CU, 0x2CD9EA5EU,
+        0x651D0863U, 0x37BE6001U, 0xC05BD8A7U, 0x92F8B0C5U,
+        0x53D21CDDU, 0x017174BFU, 0xF694CC19U, 0xA437A47BU,
+        0xEDF34646U, 0xBF502E24U, 0x48B59682U, 0x1A16FEE0U,
+        0x7C986B42U, 0x2E3B0320U, 0xD9DEBB86U, 0x8B7DD3E4U,
+        0xC2B931D9U, 0x901A59BBU, 0x67FFE11DU, 0x355C897FU,
+        0xF4762567U, 0xA6D54D05U, 0x5130F5A3U, 0x03939DC1U,
+        0x4A577FFCU, 0x18F4179EU, 0xEF11AF38U, 0xBDB2C75AU,
+        0x99E80C1BU, 0xCB4B6479U, 0x3CAEDCDFU, 0x6E0DB4BDU,
+        0x27C95680U, 0x756A3EE2U, 0x828F8644U, 0xD02CEE26U,
+        0x1106423EU, 0x43A52A5CU, 0xB44092FAU, 0xE6E3FA98U,
+        0xAF2718A5U, 0xFD8470C7U, 0x0A61C861U, 0x58C2A003U,
+        0x42D45EE3U, 0x10773681U, 0xE7928E27U, 0xB531E645U,
+        0xFCF50478U, 0xAE566C1AU, 0x59B3D4BCU, 0x0B10BCDEU,
+        0xCA3A10C6U, 0x989978A4U, 0x6F7CC002U, 0x3DDFA860U,
+        0x741B4A5DU, 0x26B8223FU, 0xD15D9A99U, 0x83FEF2FBU,
+        0xA7A439BAU, 0xF50751D8U, 0x02E2E97EU, 0x5041811CU,
+        0x19856321U, 0x4B260B43U, 0xBCC3B3E5U, 0xEE60DB87U,
+        0x2F4A779FU, 0x7DE91FFDU, 0x8A0CA75BU, 0xD8AFCF39U,
+        0x916B2D04U, 0xC3C84566U, 0x342DFDC0U, 0x668E95A2U,
+        0xF930D684U, 0xAB93BEE6U, 0x5C760640U, 0x0ED56E22U,
+        0x47118C1FU, 0x15B2E47DU, 0xE2575CDBU, 0xB0F434B9U,
+        0x71DE98A1U, 0x237DF0C3U, 0xD4984865U, 0x863B2007U,
+        0xCFFFC23AU, 0x9D5CAA58U, 0x6AB912FEU, 0x381A7A9CU,
+        0x1C40B1DDU, 0x4EE3D9BFU, 0xB9066119U, 0xEBA5097BU,
+        0xA261EB46U, 0xF0C28324U, 0x07273B82U, 0x558453E0U,
+        0x94AEFFF8U, 0xC60D979AU, 0x31E82F3CU, 0x634B475EU,
+        0x2A8FA563U, 0x782CCD01U, 0x8FC975A7U, 0xDD6A1DC5U,
+        0xC77CE325U, 0x95DF8B47U, 0x623A33E1U, 0x30995B83U,
+        0x795DB9BEU, 0x2BFED1DCU, 0xDC1B697AU, 0x8EB80118U,
+        0x4F92AD00U, 0x1D31C562U, 0xEAD47DC4U, 0xB87715A6U,
+        0xF1B3F79BU, 0xA3109FF9U, 0x54F5275FU, 0x06564F3DU,
+        0x220C847CU, 0x70AFEC1EU, 0x874A54B8U, 0xD5E93CDAU,
+        0x9C2DDEE7U, 0xCE8EB685U, 0x396B0E23U, 0x6BC86641U,
+        0xAAE2CA59U, 0xF841A23BU, 0x0FA41A9DU, 0x5D0772FFU,
+        0x14C390C2U, 0x4660F8A0U, 0xB1854006U, 0xE3262864U,
+        0x85A8BDC6U, 0xD70BD5A4U, 0x20EE6D02U, 0x724D0560U,
+        0x3B89E75DU, 0x692A8F3FU, 0x9ECF3799U, 0xCC6C5FFBU,
+        0x0D46F3E3U, 0x5FE59B81U, 0xA8002327U, 0xFAA34B45U,
+        0xB367A978U, 0xE1C4C11AU, 0x162179BCU, 0x448211DEU,
+        0x60D8DA9FU, 0x327BB2FDU, 0xC59E0A5BU, 0x973D6239U,
+        0xDEF98004U, 0x8C5AE866U, 0x7BBF50C0U, 0x291C38A2U,
+        0xE83694BAU, 0xBA95FCD8U, 0x4D70447EU, 0x1FD32C1CU,
+        0x5617CE21U, 0x04B4A643U, 0xF3511EE5U, 0xA1F27687U,
+        0xBBE48867U, 0xE947E005U, 0x1EA258A3U, 0x4C0130C1U,
+        0x05C5D2FCU, 0x5766BA9EU, 0xA0830238U, 0xF2206A5AU,
+        0x330AC642U, 0x61A9AE20U, 0x964C1686U, 0xC4EF7EE4U,
+        0x8D2B9CD9U, 0xDF88F4BBU, 0x286D4C1DU, 0x7ACE247FU,
+        0x5E94EF3EU, 0x0C37875CU, 0xFBD23FFAU, 0xA9715798U,
+        0xE0B5B5A5U, 0xB216DDC7U, 0x45F36561U, 0x17500D03U,
+        0xD67AA11BU, 0x84D9C979U, 0x733C71DFU, 0x219F19BDU,
+        0x685BFB80U, 0x3AF893E2U, 0xCD1D2B44U, 0x9FBE4326U
+    },
+    {
+        0x00000000U, 0x06CD561BU, 0x0D9AAC36U, 0x0B57FA2DU,
+        0x1B35586CU, 0x1DF80E77U, 0x16AFF45AU, 0x1062A241U,
+        0x366AB0D8U, 0x30A7E6C3U, 0x3BF01CEEU, 0x3D3D4AF5U,
+        0x2D5FE8B4U, 0x2B92BEAFU, 0x20C54482U, 0x26081299U,
+        0x6CD561B0U, 0x6A1837ABU, 0x614FCD86U, 0x67829B9DU,
+        0x77E039DCU, 0x712D6FC7U, 0x7A7A95EAU, 0x7CB7C3F1U,
+        0x5ABFD168U, 0x5C728773U, 0x57257D5EU, 0x51E82B45U,
+        0x418A8904U, 0x4747DF1FU, 0x4C102532U, 0x4ADD7329U,
+        0xD9AAC360U, 0xDF67957BU, 0xD4306F56U, 0xD2FD394DU,
+        0xC29F9B0CU, 0xC452CD17U, 0xCF05373AU, 0xC9C86121U,
+        0xEFC073B8U, 0xE90D25A3U, 0xE25ADF8EU, 0xE4978995U,
+        0xF4F52BD4U, 0xF2387DCFU, 0xF96F87E2U, 0xFFA2D1F9U,
+        0xB57FA2D0U, 0xB3B2F4CBU, 0xB8E50EE6U, 0xBE2858FDU,
+        0xAE4AFABCU, 0xA887ACA7U, 0xA3D0568AU, 0xA51D0091U,
+        0x83151208U, 0x85D84413U, 0x8E8FBE3EU, 0x8842E825U,
+        0x98204A64U, 0x9EED1C7FU, 0x95BAE652U, 0x9377B049U,
+        0x47F97DD3U, 0x41342BC8U, 0x4A63D1E5U, 0x4CAE87FEU,
+        0x5CCC25BFU, 0x5A0173A4U, 0x51568989U, 0x579BDF92U,
+        0x7193CD0BU, 0x775E9B10U, 0x7C09613DU, 0x7AC43726U,
+        0x6AA69567U, 0x6C6BC37CU, 0x673C3951U, 0x61F16F4AU,
+        0x2B2C1C63U, 0x2DE14A78U, 0x26B6B055U, 0x207BE64EU,
+        0x3019440FU, 0x36D41214U, 0x3D83E839U, 0x3B4EBE22U,
+        0x1D46ACBBU, 0x1B8BFAA0U, 0x10DC008DU, 0x16115696U,
+        0x0673F4D7U, 0x00BEA2CCU, 0x0BE958E1U, 0x0D240EFAU,
+        0x9E53BEB3U, 0x989EE8A8U, 0x93C91285U, 0x9504449EU,
+        0x8566E6DFU, 0x83ABB0C4U, 0x88FC4AE9U, 0x8E311CF2U,
+        0xA8390E6BU, 0xAEF45870U, 0xA5A3A25DU, 0xA36EF446U,
+        0xB30C5607U, 0xB5C1001CU, 0xBE96FA31U, 0xB85BAC2AU,
+        0xF286DF03U, 0xF44B8918U, 0xFF1C7335U, 0xF9D1252EU,
+        0xE9B3876FU, 0xEF7ED174U, 0xE4292B59U, 0xE2E47D42U,
+        0xC4EC6FDBU, 0xC22139C0U, 0xC976C3EDU, 0xCFBB95F6U,
+        0xDFD937B7U, 0xD91461ACU, 0xD2439B81U, 0xD48ECD9AU,
+        0x8FF2FBA6U, 0x893FADBDU, 0x82685790U, 0x84A5018BU,
+        0x94C7A3CAU, 0x920AF5D1U, 0x995D0FFCU, 0x9F9059E7U,
+        0xB9984B7EU, 0xBF551D65U, 0xB402E748U, 0xB2CFB153U,
+        0xA2AD1312U, 0xA4604509U, 0xAF37BF24U, 0xA9FAE93FU,
+        0xE3279A16U, 0xE5EACC0DU, 0xEEBD3620U, 0xE870603BU,
+        0xF812C27AU, 0xFEDF9461U, 0xF5886E4CU, 0xF3453857U,
+        0xD54D2ACEU, 0xD3807CD5U, 0xD8D786F8U, 0xDE1AD0E3U,
+        0xCE7872A2U, 0xC8B524B9U, 0xC3E2DE94U, 0xC52F888FU,
+        0x565838C6U, 0x50956EDDU, 0x5BC294F0U, 0x5D0FC2EBU,
+        0x4D6D60AAU, 0x4BA036B1U, 0x40F7CC9CU, 0x463A9A87U,
+        0x6032881EU, 0x66FFDE05U, 0x6DA82428U, 0x6B657233U,
+        0x7B07D072U, 0x7DCA8669U, 0x769D7C44U, 0x70502A5FU,
+        0x3A8D5976U, 0x3C400F6DU, 0x3717F540U, 0x31DAA35BU,
+        0x21B8011AU, 0x27755701U, 0x2C22AD2CU, 0x2AEFFB37U,
+        0x0CE7E9AEU, 0x0A2ABFB5U, 0x017D4598U, 0x07B01383U,
+        0x17D2B1C2U, 0x111FE7D9U, 0x1A481DF4U, 0x1C854BEFU,
+        0xC80B8675U, 0xCEC6D06EU, 0xC5912A43U, 0xC35C7C58U,
+        0xD33EDE19U, 0xD5F38802U, 0xDEA4722FU, 0xD8692434U,
+        0xFE6136ADU, 0xF8AC60B6U, 0xF3FB9A9BU, 0xF536CC80U,
+        0xE5546EC1U, 0xE39938DAU, 0xE8CEC2F7U, 0xEE0394ECU,
+        0xA4DEE7C5U, 0xA213B1DEU, 0xA9444BF3U, 0xAF891DE8U,
+        0xBFEBBFA9U, 0xB926E9B2U, 0xB271139FU, 0xB4BC4584U,
+        0x92B4571DU, 0x94790106U, 0x9F2EFB2BU, 0x99E3AD30U,
+        0x89810F71U, 0x8F4C596AU, 0x841BA347U, 0x82D6F55CU,
+        0x11A14515U, 0x176C130EU, 0x1C3BE923U, 0x1AF6BF38U,
+        0x0A941D79U, 0x0C594B62U, 0x070EB14FU, 0x01C3E754U,
+        0x27CBF5CDU, 0x2106A3D6U, 0x2A5159FBU, 0x2C9C0FE0U,
+        0x3CFEADA1U, 0x3A33FBBAU, 0x31640197U, 0x37A9578CU,
+        0x7D7424A5U, 0x7BB972BEU, 0x70EE8893U, 0x7623DE88U,
+        0x66417CC9U, 0x608C2AD2U, 0x6BDBD0FFU, 0x6D1686E4U,
+        0x4B1E947DU, 0x4DD3C266U, 0x4684384BU, 0x40496E50U,
+        0x502BCC11U, 0x56E69A0AU, 0x5DB16027U, 0x5B7C363CU
+    },
+    {
+        0x00000000U, 0xEB490C5FU, 0x223EE3ADU, 0xC977EFF2U,
+        0x447DC75AU, 0xAF34CB05U, 0x664324F7U, 0x8D0A28A8U,
+        0x88FB8EB4U, 0x63B282EBU, 0xAAC56D19U, 0x418C6146U,
+        0xCC8649EEU, 0x27CF45B1U, 0xEEB8AA43U, 0x05F1A61CU,
+        0xE55BE67BU, 0x0E12EA24U, 0xC76505D6U, 0x2C2C0989U,
+        0xA1262121U, 0x4A6F2D7EU, 0x8318C28CU, 0x6851CED3U,
+        0x6DA068CFU, 0x86E96490U, 0x4F9E8B62U, 0xA4D7873DU,
+        0x29DDAF95U, 0xC294A3CAU, 0x0BE34C38U, 0xE0AA4067U,
+        0x3E1B37E5U, 0xD5523BBAU, 0x1C25D448U, 0xF76CD817U,
+        0x7A66F0BFU, 0x912FFCE0U, 0x58581312U, 0xB3111F4DU,
+        0xB6E0B951U, 0x5DA9B50EU, 0x94DE5AFCU, 0x7F9756A3U,
+        0xF29D7E0BU, 0x19D47254U, 0xD0A39DA6U, 0x3BEA91F9U,
+        0xDB40D19EU, 0x3009DDC1U, 0xF97E3233U, 0x12373E6CU,
+        0x9F3D16C4U, 0x74741A9BU, 0xBD03F569U, 0x564AF936U,
+        0x53BB5F2AU, 0xB8F25375U, 0x7185BC87U, 0x9ACCB0D8U,
+        0x17C69870U, 0xFC8F942FU, 0x35F87BDDU, 0xDEB17782U,
+        0x7C366FCAU, 0x977F6395U, 0x5E088C67U, 0xB5418038U,
+        0x384BA890U, 0xD302A4CFU, 0x1A754B3DU, 0xF13C4762U,
+        0xF4CDE17EU, 0x1F84ED21U, 0xD6F302D3U, 0x3DBA0E8CU,
+        0xB0B02624U, 0x5BF92A7BU, 0x928EC589U, 0x79C7C9D6U,
+        0x996D89B1U, 0x722485EEU, 0xBB536A1CU, 0x501A6643U,
+        0xDD104EEBU, 0x365942B4U, 0xFF2EAD46U, 0x1467A119U,
+        0x11960705U, 0xFADF0B5AU, 0x33A8E4A8U, 0xD8E1E8F7U,
+        0x55EBC05FU, 0xBEA2CC00U, 0x77D523F2U, 0x9C9C2FADU,
+        0x422D582FU, 0xA9645470U, 0x6013BB82U, 0x8B5AB7DDU,
+        0x06509F75U, 0xED19932AU, 0x246E7CD8U, 0xCF277087U,
+        0xCAD6D69BU, 0x219FDAC4U, 0xE8E83536U, 0x03A13969U,
+        0x8EAB11C1U, 0x65E21D9EU, 0xAC95F26CU, 0x47DCFE33U,
+        0xA776BE54U, 0x4C3FB20BU, 0x85485DF9U, 0x6E0151A6U,
+        0xE30B790EU, 0x08427551U, 0xC1359AA3U, 0x2A7C96FCU,
+        0x2F8D30E0U, 0xC4C43CBFU, 0x0DB3D34DU, 0xE6FADF12U,
+        0x6BF0F7BAU, 0x80B9FBE5U, 0x49CE1417U, 0xA2871848U,
+        0xF86CDF94U, 0x1325D3CBU, 0xDA523C39U, 0x311B3066U,
+        0xBC1118CEU, 0x57581491U, 0x9E2FFB63U, 0x7566F73CU,
+        0x70975120U, 0x9BDE5D7FU, 0x52A9B28DU, 0xB9E0BED2U,
+        0x34EA967AU, 0xDFA39A25U, 0x16D475D7U, 0xFD9D7988U,
+        0x1D3739EFU, 0xF67E35B0U, 0x3F09DA42U, 0xD440D61DU,
+        0x594AFEB5U, 0xB203F2EAU, 0x7B741D18U, 0x903D1147U,
+        0x95CCB75BU, 0x7E85BB04U, 0xB7F254F6U, 0x5CBB58A9U,
+        0xD1B17001U, 0x3AF87C5EU, 0xF38F93ACU, 0x18C69FF3U,
+        0xC677E871U, 0x2D3EE42EU, 0xE4490BDCU, 0x0F000783U,
+        0x820A2F2BU, 0x69432374U, 0xA034CC86U, 0x4B7DC0D9U,
+        0x4E8C66C5U, 0xA5C56A9AU, 0x6CB28568U, 0x87FB8937U,
+        0x0AF1A19FU, 0xE1B8ADC0U, 0x28CF4232U, 0xC3864E6DU,
+        0x232C0E0AU, 0xC8650255U, 0x0112EDA7U, 0xEA5BE1F8U,
+        0x6751C950U, 0x8C18C50FU, 0x456F2AFDU, 0xAE2626A2U,
+        0xABD780BEU, 0x409E8CE1U, 0x89E96313U, 0x62A06F4CU,
+        0xEFAA47E4U, 0x04E34BBBU, 0xCD94A449U, 0x26DDA816U,
+        0x845AB05EU, 0x6F13BC01U, 0xA66453F3U, 0x4D2D5FACU,
+        0xC0277704U, 0x2B6E7B5BU, 0xE21994A9U, 0x095098F6U,
+        0x0CA13EEAU, 0xE7E832B5U, 0x2E9FDD47U, 0xC5D6D118U,
+        0x48DCF9B0U, 0xA395F5EFU, 0x6AE21A1DU, 0x81AB1642U,
+        0x61015625U, 0x8A485A7AU, 0x433FB588U, 0xA876B9D7U,
+        0x257C917FU, 0xCE359D20U, 0x074272D2U, 0xEC0B7E8DU,
+        0xE9FAD891U, 0x02B3D4CEU, 0xCBC43B3CU, 0x208D3763U,
+        0xAD871FCBU, 0x46CE1394U, 0x8FB9FC66U, 0x64F0F039U,
+        0xBA4187BBU, 0x51088BE4U, 0x987F6416U, 0x73366849U,
+        0xFE3C40E1U, 0x15754CBEU, 0xDC02A34CU, 0x374BAF13U,
+        0x32BA090FU, 0xD9F30550U, 0x1084EAA2U, 0xFBCDE6FDU,
+        0x76C7CE55U, 0x9D8EC20AU, 0x54F92DF8U, 0xBFB021A7U,
+        0x5F1A61C0U, 0xB4536D9FU, 0x7D24826DU, 0x966D8E32U,
+        0x1B67A69AU, 0xF02EAAC5U, 0x39594537U, 0xD2104968U,
+        0xD7E1EF74U, 0x3CA8E32BU, 0xF5DF0CD9U, 0x1E960086U,
+        0x939C282EU, 0x78D52471U, 0xB1A2CB83U, 0x5AEBC7DCU
+    },
+    {
+        0x00000000U, 0x0475443BU, 0x08EA8876U, 0x0C9FCC4DU,
+        0x11D510ECU, 0x15A054D7U, 0x193F989AU, 0x1D4ADCA1U,
+        0x23AA21D8U, 0x27DF65E3U, 0x2B40A9AEU, 0x2F35ED95U,
+        0x327F3134U, 0x360A750FU, 0x3A95B942U, 0x3EE0FD79U,
+        0x475443B0U, 0x4321078BU, 0x4FBECBC6U, 0x4BCB8FFDU,
+        0x5681535CU, 0x52F41767U, 0x5E6BDB2AU, 0x5A1E9F11U,
+        0x64FE6268U, 0x608B2653U, 0x6C14EA1EU, 0x6861AE25U,
+        0x752B7284U, 0x715E36BFU, 0x7DC1FAF2U, 0x79B4BEC9U,
+        0x8EA88760U, 0x8ADDC35BU, 0x86420F16U, 0x82374B2DU,
+        0x9F7D978CU, 0x9B08D3B7U, 0x97971FFAU, 0x93E25BC1U,
+        0xAD02A6B8U, 0xA977E283U, 0xA5E82ECEU, 0xA19D6AF5U,
+        0xBCD7B654U, 0xB8A2F26FU, 0xB43D3E22U, 0xB0487A19U,
+        0xC9FCC4D0U, 0xCD8980EBU, 0xC1164CA6U, 0xC563089DU,
+        0xD829D43CU, 0xDC5C9007U, 0xD0C35C4AU, 0xD4B61871U,
+        0xEA56E508U, 0xEE23A133U, 0xE2BC6D7EU, 0xE6C92945U,
+        0xFB83F5E4U, 0xFFF6B1DFU, 0xF3697D92U, 0xF71C39A9U,
+        0xE9FDF5D3U, 0xED88B1E8U, 0xE1177DA5U, 0xE562399EU,
+        0xF828E53FU, 0xFC5DA104U, 0xF0C26D49U, 0xF4B72972U,
+        0xCA57D40BU, 0xCE229030U, 0xC2BD5C7DU, 0xC6C81846U,
+        0xDB82C4E7U, 0xDFF780DCU, 0xD3684C91U, 0xD71D08AAU,
+        0xAEA9B663U, 0xAADCF258U, 0xA6433E15U, 0xA2367A2EU,
+        0xBF7CA68FU, 0xBB09E2B4U, 0xB7962EF9U, 0xB3E36AC2U,
+        0x8D0397BBU, 0x8976D380U, 0x85E91FCDU, 0x819C5BF6U,
+        0x9CD68757U, 0x98A3C36CU, 0x943C0F21U, 0x90494B1AU,
+        0x675572B3U, 0x63203688U, 0x6FBFFAC5U, 0x6BCABEFEU,
+        0x7680625FU, 0x72F52664U, 0x7E6AEA29U, 0x7A1FAE12U,
+        0x44FF536BU, 0x408A1750U, 0x4C15DB1DU, 0x48609F26U,
+        0x552A4387U, 0x515F07BCU, 0x5DC0CBF1U, 0x59B58FCAU,
+        0x20013103U, 0x24747538U, 0x28EBB975U, 0x2C9EFD4EU,
+        0x31D421EFU, 0x35A165D4U, 0x393EA999U, 0x3D4BEDA2U,
+        0x03AB10DBU, 0x07DE54E0U, 0x0B4198ADU, 0x0F34DC96U,
+        0x127E0037U, 0x160B440CU, 0x1A948841U, 0x1EE1CC7AU,
+        0x275710B5U, 0x2322548EU, 0x2FBD98C3U, 0x2BC8DCF8U,
+        0x36820059U, 0x32F74462U, 0x3E68882FU, 0x3A1DCC14U,
+        0x04FD316DU, 0x00887556U, 0x0C17B91BU, 0x0862FD20U,
+        0x15282181U, 0x115D65BAU, 0x1DC2A9F7U, 0x19B7EDCCU,
+        0x60035305U, 0x6476173EU, 0x68E9DB73U, 0x6C9C9F48U,
+        0x71D643E9U, 0x75A307D2U, 0x793CCB9FU, 0x7D498FA4U,
+        0x43A972DDU, 0x47DC36E6U, 0x4B43FAABU, 0x4F36BE90U,
+        0x527C6231U, 0x5609260AU, 0x5A96EA47U, 0x5EE3AE7CU,
+        0xA9FF97D5U, 0xAD8AD3EEU, 0xA1151FA3U, 0xA5605B98U,
+        0xB82A8739U, 0xBC5FC302U, 0xB0C00F4FU, 0xB4B54B74U,
+        0x8A55B60DU, 0x8E20F236U, 0x82BF3E7BU, 0x86CA7A40U,
+        0x9B80A6E1U, 0x9FF5E2DAU, 0x936A2E97U, 0x971F6AACU,
+        0xEEABD465U, 0xEADE905EU, 0xE6415C13U, 0xE2341828U,
+        0xFF7EC489U, 0xFB0B80B2U, 0xF7944CFFU, 0xF3E108C4U,
+        0xCD01F5BDU, 0xC974B186U, 0xC5EB7DCBU, 0xC19E39F0U,
+        0xDCD4E551U, 0xD8A1A16AU, 0xD43E6D27U, 0xD04B291CU,
+        0xCEAAE566U, 0xCADFA15DU, 0xC6406D10U, 0xC235292BU,
+        0xDF7FF58AU, 0xDB0AB1B1U, 0xD7957DFCU, 0xD3E039C7U,
+        0xED00C4BEU, 0xE9758085U, 0xE5EA4CC8U, 0xE19F08F3U,
+        0xFCD5D452U, 0xF8A09069U, 0xF43F5C24U, 0xF04A181FU,
+        0x89FEA6D6U, 0x8D8BE2EDU, 0x81142EA0U, 0x85616A9BU,
+        0x982BB63AU, 0x9C5EF201U, 0x90C13E4CU, 0x94B47A77U,
+        0xAA54870EU, 0xAE21C335U, 0xA2BE0F78U, 0xA6CB4B43U,
+        0xBB8197E2U, 0xBFF4D3D9U, 0xB36B1F94U, 0xB71E5BAFU,
+        0x40026206U, 0x4477263DU, 0x48E8EA70U, 0x4C9DAE4BU,
+        0x51D772EAU, 0x55A236D1U, 0x593DFA9CU, 0x5D48BEA7U,
+        0x63A843DEU, 0x67DD07E5U, 0x6B42CBA8U, 0x6F378F93U,
+        0x727D5332U, 0x76081709U, 0x7A97DB44U, 0x7EE29F7FU,
+        0x075621B6U, 0x0323658DU, 0x0FBCA9C0U, 0x0BC9EDFBU,
+        0x1683315AU, 0x12F67561U, 0x1E69B92CU, 0x1A1CFD17U,
+        0x24FC006EU, 0x20894455U, 0x2C168818U, 0x2863CC23U,
+        0x35291082U, 0x315C54B9U, 0x3DC398F4U, 0x39B6DCCFU
+    },
+    {
+        0x00000000U, 0x4EAE216AU, 0x9D5C42D4U, 0xD3F263BEU,
+        0xCE147EBBU, 0x80BA5FD1U, 0x53483C6FU, 0x1DE61D05U,
+        0x68840665U, 0x262A270FU, 0xF5D844B1U, 0xBB7665DBU,
+        0xA69078DEU, 0xE83E59B4U, 0x3BCC3A0AU, 0x75621B60U,
+        0xD1080CCAU, 0x9FA62DA0U, 0x4C544E1EU, 0x02FA6F74U,
+        0x1F1C7271U, 0x51B2531BU, 0x824030A5U, 0xCCEE11CFU,
+        0xB98C0AAFU, 0xF7222BC5U, 0x24D0487BU, 0x6A7E6911U,
+        0x77987414U, 0x3936557EU, 0xEAC436C0U, 0xA46A17AAU,
+        0x56BCE287U, 0x1812C3EDU, 0xCBE0A053U, 0x854E8139U,
+        0x98A89C3CU, 0xD606BD56U, 0x05F4DEE8U, 0x4B5AFF82U,
+        0x3E38E4E2U, 0x7096C588U, 0xA364A636U, 0xEDCA875CU,
+        0xF02C9A59U, 0xBE82BB33U, 0x6D70D88DU, 0x23DEF9E7U,
+        0x87B4EE4DU, 0xC91ACF27U, 0x1AE8AC99U, 0x54468DF3U,
+        0x49A090F6U, 0x070EB19CU, 0xD4FCD222U, 0x9A52F348U,
+        0xEF30E828U, 0xA19EC942U, 0x726CAAFCU, 0x3CC28B96U,
+        0x21249693U, 0x6F8AB7F9U, 0xBC78D447U, 0xF2D6F52DU,
+        0xAD79C50EU, 0xE3D7E464U, 0x302587DAU, 0x7E8BA6B0U,
+        0x636DBBB5U, 0x2DC39ADFU, 0xFE31F961U, 0xB09FD80BU,
+        0xC5FDC36BU, 0x8B53E201U, 0x58A181BFU, 0x160FA0D5U,
+        0x0BE9BDD0U, 0x45479CBAU, 0x96B5FF04U, 0xD81BDE6EU,
+        0x7C71C9C4U, 0x32DFE8AEU, 0xE12D8B10U, 0xAF83AA7AU,
+        0xB265B77FU, 0xFCCB9615U, 0x2F39F5ABU, 0x6197D4C1U,
+        0x14F5CFA1U, 0x5A5BEECBU, 0x89A98D75U, 0xC707AC1FU,
+        0xDAE1B11AU, 0x944F9070U, 0x47BDF3CEU, 0x0913D2A4U,
+        0xFBC52789U, 0xB56B06E3U, 0x6699655DU, 0x28374437U,
+        0x35D15932U, 0x7B7F7858U, 0xA88D1BE6U, 0xE6233A8CU,
+        0x934121ECU, 0xDDEF0086U, 0x0E1D6338U, 0x40B34252U,
+        0x5D555F57U, 0x13FB7E3DU, 0xC0091D83U, 0x8EA73CE9U,
+        0x2ACD2B43U, 0x64630A29U, 0xB7916997U, 0xF93F48FDU,
+        0xE4D955F8U, 0xAA777492U, 0x7985172CU, 0x372B3646U,
+        0x42492D26U, 0x0CE70C4CU, 0xDF156FF2U, 0x91BB4E98U,
+        0x8C5D539DU, 0xC2F372F7U, 0x11011149U, 0x5FAF3023U,
+        0xAE5F710FU, 0xE0F15065U, 0x330333DBU, 0x7DAD12B1U,
+        0x604B0FB4U, 0x2EE52EDEU, 0xFD174D60U, 0xB3B96C0AU,
+        0xC6DB776AU, 0x88755600U, 0x5B8735BEU, 0x152914D4U,
+        0x08CF09D1U, 0x466128BBU, 0x95934B05U, 0xDB3D6A6FU,
+        0x7F577DC5U, 0x31F95CAFU, 0xE20B3F11U, 0xACA51E7BU,
+        0xB143037EU, 0xFFED2214U, 0x2C1F41AAU, 0x62B160C0U,
+        0x17D37BA0U, 0x597D5ACAU, 0x8A8F3974U, 0xC421181EU,
+        0xD9C7051BU, 0x97692471U, 0x449B47CFU, 0x0A3566A5U,
+        0xF8E39388U, 0xB64DB2E2U, 0x65BFD15CU, 0x2B11F036U,
+        0x36F7ED33U, 0x7859CC59U, 0xABABAFE7U, 0xE5058E8DU,
+        0x906795EDU, 0xDEC9B487U, 0x0D3BD739U, 0x4395F653U,
+        0x5E73EB56U, 0x10DDCA3CU, 0xC32FA982U, 0x8D8188E8U,
+        0x29EB9F42U, 0x6745BE28U, 0xB4B7DD96U, 0xFA19FCFCU,
+        0xE7FFE1F9U, 0xA951C093U, 0x7AA3A32DU, 0x340D8247U,
+        0x416F9927U, 0x0FC1B84DU, 0xDC33DBF3U, 0x929DFA99U,
+        0x8F7BE79CU, 0xC1D5C6F6U, 0x1227A548U, 0x5C898422U,
+        0x0326B401U, 0x4D88956BU, 0x9E7AF6D5U, 0xD0D4D7BFU,
+        0xCD32CABAU, 0x839CEBD0U, 0x506E886EU, 0x1EC0A904U,
+        0x6BA2B264U, 0x250C930EU, 0xF6FEF0B0U, 0xB850D1DAU,
+        0xA5B6CCDFU, 0xEB18EDB5U, 0x38EA8E0BU, 0x7644AF61U,
+        0xD22EB8CBU, 0x9C8099A1U, 0x4F72FA1FU, 0x01DCDB75U,
+        0x1C3AC670U, 0x5294E71AU, 0x816684A4U, 0xCFC8A5CEU,
+        0xBAAABEAEU, 0xF4049FC4U, 0x27F6FC7AU, 0x6958DD10U,
+        0x74BEC015U, 0x3A10E17FU, 0xE9E282C1U, 0xA74CA3ABU,
+        0x559A5686U, 0x1B3477ECU, 0xC8C61452U, 0x86683538U,
+        0x9B8E283DU, 0xD5200957U, 0x06D26AE9U, 0x487C4B83U,
+        0x3D1E50E3U, 0x73B07189U, 0xA0421237U, 0xEEEC335DU,
+        0xF30A2E58U, 0xBDA40F32U, 0x6E566C8CU, 0x20F84DE6U,
+        0x84925A4CU, 0xCA3C7B26U, 0x19CE1898U, 0x576039F2U,
+        0x4A8624F7U, 0x0428059DU, 0xD7DA6623U, 0x99744749U,
+        0xEC165C29U, 0xA2B87D43U, 0x714A1EFDU, 0x3FE43F97U,
+        0x22022292U, 0x6CAC03F8U, 0xBF5E6046U, 0xF1F0412CU
+    }
+};
+#endif
+
 #if MD_SUPPORT
 const CHAR8         *cErrStrings[NO_OF_ERROR_STRINGS] PROGMEM =
 {
@@ -500,6 +1451,224 @@ EXT_DECL void vos_terminate (void)
     vos_memDelete(NULL);
 }
 
+/**********************************************************************************************************************/
+/** CRC register update according to IEEE802.3 (reflected), slicing-by-8
+ *
+ *  @param[in]          crc         Initial value.
+ *  @param[in]          pData       Pointer to data.
+ *  @param[in]          dataLen     length in bytes of data.
+ *  @retval             CRC register (not inverted)
+ */
+
+static UINT32 vos_crc32Slice (
+    UINT32      crc,
+    const UINT8 *pData,
+    UINT32      dataLen)
+{
+#ifndef VOS_CRC_BYTEWISE
+    while (dataLen >= 8u)
+    {
+        UINT32 one = crc ^ ((UINT32) pData[0] | ((UINT32) pData[1] << 8u) |
+                            ((UINT32) pData[2] << 16u) | ((UINT32) pData[3] << 24u));
+        crc = pgm_read_dword(&fcs_table8[6][one & 0xffu]) ^
+            pgm_read_dword(&fcs_table8[5][(one >> 8u) & 0xffu]) ^
+            pgm_read_dword(&fcs_table8[4][(one >> 16u) & 0xffu]) ^
+            pgm_read_dword(&fcs_table8[3][one >> 24u]) ^
+            pgm_read_dword(&fcs_table8[2][pData[4]]) ^
+            pgm_read_dword(&fcs_table8[1][pData[5]]) ^
+            pgm_read_dword(&fcs_table8[0][pData[6]]) ^
+            pgm_read_dword(&fcs_table[pData[7]]);
+        pData   += 8u;
+        dataLen -= 8u;
+    }
+#endif
+    while (dataLen > 0u)
+    {
+        crc = (crc >> 8u) ^ pgm_read_dword(&fcs_table[(crc ^ *pData++) & 0xffu]);
+        dataLen--;
+    }
+    return crc;
+}
+
+/**********************************************************************************************************************/
+/** CRC register update according to IEC 61375-2-3 B.7, slicing-by-8
+ *
+ *  @param[in]          crc         Initial value.
+ *  @param[in]          pData       Pointer to data.
+ *  @param[in]          dataLen     length in bytes of data.
+ *  @retval             CRC register
+ */
+
+static UINT32 vos_sc32Slice (
+    UINT32      crc,
+    const UINT8 *pData,
+    UINT32      dataLen)
+{
+#ifndef VOS_CRC_BYTEWISE
+    while (dataLen >= 8u)
+    {
+        UINT32 one = crc ^ (((UINT32) pData[0] << 24u) | ((UINT32) pData[1] << 16u) |
+                            ((UINT32) pData[2] << 8u) | (UINT32) pData[3]);
+        crc = pgm_read_dword(&sc32_table8[6][one >> 24u]) ^
+            pgm_read_dword(&sc32_table8[5][(one >> 16u) & 0xffu]) ^
+            pgm_read_dword(&sc32_table8[4][(one >> 8u) & 0xffu]) ^
+            pgm_read_dword(&sc32_table8[3][one & 0xffu]) ^
+            pgm_read_dword(&sc32_table8[2][pData[4]]) ^
+            pgm_read_dword(&sc32_table8[1][pData[5]]) ^
+            pgm_read_dword(&sc32_table8[0][pData[6]]) ^
+            pgm_read_dword(&sc32_table[pData[7]]);
+        pData   += 8u;
+        dataLen -= 8u;
+    }
+#endif
+    while (dataLen > 0u)
+    {
+        crc = pgm_read_dword(&sc32_table[((UINT32)(crc >> 24u) ^ *pData++) & 0xffu]) ^ (crc << 8);
+        dataLen--;
+    }
+    return crc;
+}
+
+#ifdef VOS_CRC_CLMUL
+/**********************************************************************************************************************/
+/** Check once if the CPU supports carry-less multiplication (and SSSE3 for the byte shuffles)
+ *
+ *  @retval             TRUE if PCLMULQDQ can be used
+ */
+
+static BOOL8 vos_crcClmulAvailable (void)
+{
+    static INT32 sHasClmul = -1;
+
+    if (sHasClmul < 0)
+    {
+        __builtin_cpu_init();
+        sHasClmul = (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3")) ? 1 : 0;
+    }
+    return (sHasClmul == 1) ? TRUE : FALSE;
+}
+
+/*  Fold the 128 bit remainder x over the distance given by the constants k and add the next block:
+    x.low * k.low ^ x.high * k.high ^ next.
+    The same operation serves both polynomials, only the encoding of the constants differs:
+    IEEE802.3 (reflected):  k.low = bitrev64(x^(D+63) mod P), k.high = bitrev64(x^(D-1) mod P)
+    IEC 61375-2-3 B.7:      k.low = x^D mod P,                k.high = x^(D+64) mod P
+    with D = 512 (four blocks in parallel) or D = 128 (one block)   */
+#define VOS_CRC_FOLD(x, k, next)  _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128((x), (k), 0x00),  \
+                                                              _mm_clmulepi64_si128((x), (k), 0x11)), (next))
+
+/**********************************************************************************************************************/
+/** CRC register update according to IEEE802.3 using PCLMULQDQ folding
+ *  The folded 128 bit remainder is finally reduced with the table.
+ *
+ *  @param[in]          crc         Initial value.
+ *  @param[in]          pData       Pointer to data.
+ *  @param[in]          dataLen     length in bytes of data, multiple of 16, at least 64
+ *  @retval             CRC register (not inverted)
+ */
+
+__attribute__((target("pclmul,ssse3")))
+static UINT32 vos_crc32Clmul (
+    UINT32      crc,
+    const UINT8 *pData,
+    UINT32      dataLen)
+{
+    const __m128i   k512    = _mm_set_epi64x((long long) 0xCAD38E8F00000000ull, (long long) 0x653D982200000000ull);
+    const __m128i   k128    = _mm_set_epi64x((long long) 0x9BA54C6F00000000ull, (long long) 0x65673B4600000000ull);
+    __m128i         x0, x1, x2, x3;
+    UINT8           rest[16];
+
+    x0  = _mm_xor_si128(_mm_loadu_si128((const __m128i *) pData), _mm_cvtsi32_si128((int) crc));
+    x1  = _mm_loadu_si128((const __m128i *) (pData + 16u));
+    x2  = _mm_loadu_si128((const __m128i *) (pData + 32u));
+    x3  = _mm_loadu_si128((const __m128i *) (pData + 48u));
+    pData   += 64u;
+    dataLen -= 64u;
+
+    while (dataLen >= 64u)
+    {
+        x0  = VOS_CRC_FOLD(x0, k512, _mm_loadu_si128((const __m128i *) pData));
+        x1  = VOS_CRC_FOLD(x1, k512, _mm_loadu_si128((const __m128i *) (pData + 16u)));
+        x2  = VOS_CRC_FOLD(x2, k512, _mm_loadu_si128((const __m128i *) (pData + 32u)));
+        x3  = VOS_CRC_FOLD(x3, k512, _mm_loadu_si128((const __m128i *) (pData + 48u)));
+        pData   += 64u;
+        dataLen -= 64u;
+    }
+
+    x0 = VOS_CRC_FOLD(x0, k128, x1);
+    x0 = VOS_CRC_FOLD(x0, k128, x2);
+    x0 = VOS_CRC_FOLD(x0, k128, x3);
+
+    while (dataLen >= 16u)
+    {
+        x0  = VOS_CRC_FOLD(x0, k128, _mm_loadu_si128((const __m128i *) pData));
+        pData   += 16u;
+        dataLen -= 16u;
+    }
+
+    /* The remainder has the same CRC as the data folded so far */
+    _mm_storeu_si128((__m128i *) rest, x0);
+    return vos_crc32Slice(0u, rest, 16u);
+}
+
+/**********************************************************************************************************************/
+/** CRC register update according to IEC 61375-2-3 B.7 using PCLMULQDQ folding
+ *  The folded 128 bit remainder is finally reduced with the table.
+ *
+ *  @param[in]          crc         Initial value.
+ *  @param[in]          pData       Pointer to data.
+ *  @param[in]          dataLen     length in bytes of data, multiple of 16, at least 64
+ *  @retval             CRC register
+ */
+
+__attribute__((target("pclmul,ssse3")))
+static UINT32 vos_sc32Clmul (
+    UINT32      crc,
+    const UINT8 *pData,
+    UINT32      dataLen)
+{
+    const __m128i   k512    = _mm_set_epi64x(0x5ECF6CD1ll, 0xE1D04AE3ll);
+    const __m128i   k128    = _mm_set_epi64x(0xBDA13578ll, 0x052E2A05ll);
+    const __m128i   swap    = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i         x0, x1, x2, x3;
+    UINT8           rest[16];
+
+    /* Big endian bit order: byte swap every block, the initial value goes into the most significant word */
+    x0  = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) pData), swap);
+    x0  = _mm_xor_si128(x0, _mm_set_epi32((int) crc, 0, 0, 0));
+    x1  = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (pData + 16u)), swap);
+    x2  = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (pData + 32u)), swap);
+    x3  = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (pData + 48u)), swap);
+    pData   += 64u;
+    dataLen -= 64u;
+
+    while (dataLen >= 64u)
+    {
+        x0  = VOS_CRC_FOLD(x0, k512, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) pData), swap));
+        x1  = VOS_CRC_FOLD(x1, k512, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (pData + 16u)), swap));
+        x2  = VOS_CRC_FOLD(x2, k512, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (pData + 32u)), swap));
+        x3  = VOS_CRC_FOLD(x3, k512, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (pData + 48u)), swap));
+        pData   += 64u;
+        dataLen -= 64u;
+    }
+
+    x0 = VOS_CRC_FOLD(x0, k128, x1);
+    x0 = VOS_CRC_FOLD(x0, k128, x2);
+    x0 = VOS_CRC_FOLD(x0, k128, x3);
+
+    while (dataLen >= 16u)
+    {
+        x0  = VOS_CRC_FOLD(x0, k128, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) pData), swap));
+        pData   += 16u;
+        dataLen -= 16u;
+    }
+
+    /* The remainder has the same CRC as the data folded so far */
+    _mm_storeu_si128((__m128i *) rest, _mm_shuffle_epi8(x0, swap));
+    return vos_sc32Slice(0u, rest, 16u);
+}
+#endif
+
 /**********************************************************************************************************************/
 /** Compute crc32 according to IEEE802.3. / to IEC 61375-2-3 A.3
  *  Note: Returned CRC is inverted
@@ -515,13 +1684,16 @@ UINT32 vos_crc32 (
     const UINT8 *pData,
     UINT32      dataLen)
 {
-
-    UINT32 i;
-    for (i = 0u; i < dataLen; i++)
+#ifdef VOS_CRC_CLMUL
+    if ((dataLen >= VOS_CRC_CLMUL_MIN) && (vos_crcClmulAvailable() == TRUE))
     {
-        crc = (crc >> 8u) ^ pgm_read_dword(&fcs_table[(crc ^ pData[i]) & 0xffu]);
+        UINT32 blockLen = dataLen & ~15u;
+        crc     = vos_crc32Clmul(crc, pData, blockLen);
+        pData   += blockLen;
+        dataLen -= blockLen;
     }
-    return ~crc;
+#endif
+    return ~vos_crc32Slice(crc, pData, dataLen);
 }
 
 /**********************************************************************************************************************/
@@ -538,13 +1710,16 @@ UINT32 vos_sc32 (
     const UINT8 *pData,
     UINT32      dataLen)
 {
-
-    UINT32 i;
-    for (i = 0u; i < dataLen; i++)
+#ifdef VOS_CRC_CLMUL
+    if ((dataLen >= VOS_CRC_CLMUL_MIN) && (vos_crcClmulAvailable() == TRUE))
     {
-        crc = pgm_read_dword(&sc32_table[((UINT32)(crc >> 24u) ^ pData[i]) & 0xffu]) ^ (crc << 8);
+        UINT32 blockLen = dataLen & ~15u;
+        crc     = vos_sc32Clmul(crc, pData, blockLen);
+        pData   += blockLen;
+        dataLen -= blockLen;
     }
-    return crc;
+#endif
+    return vos_sc32Slice(crc, pData, dataLen);
 }
 
 /**********************************************************************************************************************/
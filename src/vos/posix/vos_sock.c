@@ -17,6 +17,10 @@
 /*
 * $Id: vos_sock.c 2137 2019-12-06 17:40:07Z bloehr $
 *
+*      AG 2026-10-17: Vectored TCP send using writev(), TCP_NODELAY socket option
+*      AG 2026-10-17: Socket sets for event driven receiving: epoll (Linux), poll() otherwise
+*      AG 2026-10-17: Batched UDP send using sendmmsg() (Linux)
+*      AG 2026-10-17: Batched UDP receive using recvmmsg() (Linux)
 *      BL 2019-08-27: Changed send failure from ERROR to WARNING
 *      SB 2019-07-11: Added includes linux/if_vlan.h and linux/sockios.h
 *      BL 2019-06-17: Ticket #191 Add provisions for TSN / Hard Real Time (open source)
@@ -57,28 +61,30 @@
 #include <sys/socket.h>
 #include <sys/ioctl.h>
 
-#ifdef INTEGRITY
-#   include <sys/uio.h>
-#endif
+#include <sys/uio.h>
 
 #ifdef __linux
 #   include <linux/if.h>
 #   include <byteswap.h>
 #   include <linux/if_vlan.h>
 #   include <linux/sockios.h>
+#   include <sys/epoll.h>
 #else
 #   include <net/if.h>
 #   include <net/if_types.h>
+#   include <poll.h>
 #endif
 
 #include <netinet/ip.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 
 #include <sys/types.h>
 #include <ifaddrs.h>
 
 #include "vos_utils.h"
+#include "vos_mem.h"
 #include "vos_sock.h"
 #include "vos_thread.h"
 #include "vos_private.h"
@@ -108,6 +114,55 @@ struct ifreq    gIfr;
 BOOL8       vos_getMacAddress (UINT8        *pMacAddr,
                                const char   *pIfName);
 
+/** Max. number of events fetched by one epoll_wait() call */
+#define VOS_POLL_MAX_EVENTS     64u
+
+/** Socket set of vos_pollWait() */
+struct VOS_POLL
+{
+#ifdef __linux
+    int             epfd;           /**< epoll instance                                 */
+#else
+    struct pollfd   *pFds;          /**< sockets of the set                             */
+    UINT32          *pRefs;         /**< references of the sockets                      */
+    UINT32          noOfFds;        /**< sockets in use                                 */
+#endif
+    UINT32          maxSockets;     /**< size of the set                                */
+};
+
+/** Size of the control message buffer used to get the destination address of a received datagram */
+#define VOS_SOCK_CTRL_BUF_SIZE  32u
+
+/**********************************************************************************************************************/
+/** Get the destination address of a received datagram from its control messages (IP_PKTINFO/IP_RECVDSTADDR).
+ *
+ *  @param[in]          pMsg        pointer to the received message header
+ *  @param[out]         pDstIPAddr  pointer to destination IP, untouched if not available
+ */
+static void vos_sockGetDstAddr (
+    struct msghdr   *pMsg,
+    UINT32          *pDstIPAddr)
+{
+    struct cmsghdr *cmsg;
+
+    for (cmsg = CMSG_FIRSTHDR(pMsg); cmsg != NULL; cmsg = CMSG_NXTHDR(pMsg, cmsg))
+    {
+#if defined(IP_RECVDSTADDR)
+        if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_RECVDSTADDR)
+        {
+            struct in_addr *pia = (struct in_addr *)CMSG_DATA(cmsg);
+            *pDstIPAddr = (UINT32)vos_ntohl(pia->s_addr);
+        }
+#elif defined(IP_PKTINFO)
+        if (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_PKTINFO)
+        {
+            struct in_pktinfo *pia = (struct in_pktinfo *)CMSG_DATA(cmsg);
+            *pDstIPAddr = (UINT32)vos_ntohl(pia->ipi_addr.s_addr);
+        }
+#endif
+    }
+}
+
 /**********************************************************************************************************************/
 /** Get the MAC address for a named interface.
  *
@@ -410,6 +465,340 @@ EXT_DECL INT32 vos_select (
                   (fd_set *) pErrorFD, (struct timeval *) pTimeOut);
 }
 
+/**********************************************************************************************************************/
+/** Create a set of sockets to wait on for readability.
+ *  Linux uses an epoll instance, other POSIX targets a poll() array.
+ *
+ *  @param[out]     pPoll           pointer to the handle of the new set
+ *  @param[in]      maxSockets      max. number of sockets in the set
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_SOCK_ERR    set could not be created
+ */
+
+EXT_DECL VOS_ERR_T vos_pollCreate (
+    VOS_POLL_T  *pPoll,
+    UINT32      maxSockets)
+{
+    struct VOS_POLL *pSet;
+
+    if ((pPoll == NULL) || (maxSockets == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    pSet = (struct VOS_POLL *) vos_memAlloc(sizeof(struct VOS_POLL));
+    if (pSet == NULL)
+    {
+        return VOS_MEM_ERR;
+    }
+    pSet->maxSockets = maxSockets;
+
+#ifdef __linux
+    pSet->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (pSet->epfd == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "epoll_create1() failed (Err: %s)\n", buff);
+        vos_memFree(pSet);
+        return VOS_SOCK_ERR;
+    }
+#else
+    pSet->pFds  = (struct pollfd *) vos_memAlloc(maxSockets * sizeof(struct pollfd));
+    pSet->pRefs = (UINT32 *) vos_memAlloc(maxSockets * sizeof(UINT32));
+    if ((pSet->pFds == NULL) || (pSet->pRefs == NULL))
+    {
+        if (pSet->pFds != NULL)
+        {
+            vos_memFree(pSet->pFds);
+        }
+        if (pSet->pRefs != NULL)
+        {
+            vos_memFree(pSet->pRefs);
+        }
+        vos_memFree(pSet);
+        return VOS_MEM_ERR;
+    }
+    pSet->noOfFds = 0u;
+#endif
+    *pPoll = pSet;
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Destroy a set of sockets.
+ *  The sockets themselves are not closed.
+ *
+ *  @param[in]      pollSet         handle of the set
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_pollDestroy (
+    VOS_POLL_T pollSet)
+{
+    if (pollSet == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+#ifdef __linux
+    (void) close(pollSet->epfd);
+#else
+    vos_memFree(pollSet->pFds);
+    vos_memFree(pollSet->pRefs);
+#endif
+    vos_memFree(pollSet);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Add a socket to a set.
+ *  A socket which is closed leaves the set implicitly: epoll drops it with the last close(), the poll() array
+ *  drops it when poll() reports it invalid or when the descriptor is added again.
+ *
+ *  @param[in]      pollSet         handle of the set
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      ref             reference reported with the events of this socket
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_QUEUE_FULL_ERR  set is full
+ *  @retval         VOS_SOCK_ERR    socket could not be added
+ */
+
+EXT_DECL VOS_ERR_T vos_pollAdd (
+    VOS_POLL_T  pollSet,
+    SOCKET      sock,
+    UINT32      ref)
+{
+#ifdef __linux
+    struct epoll_event ev;
+
+    if ((pollSet == NULL) || (sock == VOS_INVALID_SOCKET))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events   = EPOLLIN;
+    ev.data.u64 = ((uint64_t) ref << 32) | (uint32_t) sock;
+
+    if (epoll_ctl(pollSet->epfd, EPOLL_CTL_ADD, sock, &ev) == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+
+        if ((errno == EEXIST) && (epoll_ctl(pollSet->epfd, EPOLL_CTL_MOD, sock, &ev) == 0))
+        {
+            return VOS_NO_ERR;
+        }
+        if (errno == ENOSPC)
+        {
+            return VOS_QUEUE_FULL_ERR;
+        }
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "epoll_ctl(ADD, %d) failed (Err: %s)\n", (int) sock, buff);
+        return VOS_SOCK_ERR;
+    }
+#else
+    UINT32 i;
+
+    if ((pollSet == NULL) || (sock == VOS_INVALID_SOCKET))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    for (i = 0u; i < pollSet->noOfFds; i++)
+    {
+        if (pollSet->pFds[i].fd == sock)
+        {
+            break;
+        }
+    }
+    if (i == pollSet->noOfFds)
+    {
+        if (pollSet->noOfFds >= pollSet->maxSockets)
+        {
+            return VOS_QUEUE_FULL_ERR;
+        }
+        pollSet->noOfFds++;
+    }
+    pollSet->pFds[i].fd        = sock;
+    pollSet->pFds[i].events    = POLLIN;
+    pollSet->pFds[i].revents   = 0;
+    pollSet->pRefs[i]          = ref;
+#endif
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Remove a socket from a set.
+ *
+ *  @param[in]      pollSet         handle of the set
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error or socket not in the set
+ */
+
+EXT_DECL VOS_ERR_T vos_pollDel (
+    VOS_POLL_T  pollSet,
+    SOCKET      sock)
+{
+#ifdef __linux
+    struct epoll_event ev;  /* kernels before 2.6.9 want a non-NULL event */
+
+    if ((pollSet == NULL) || (sock == VOS_INVALID_SOCKET) ||
+        (epoll_ctl(pollSet->epfd, EPOLL_CTL_DEL, sock, &ev) == -1))
+    {
+        return VOS_PARAM_ERR;
+    }
+#else
+    UINT32 i;
+
+    if ((pollSet == NULL) || (sock == VOS_INVALID_SOCKET))
+    {
+        return VOS_PARAM_ERR;
+    }
+    for (i = 0u; (i < pollSet->noOfFds) && (pollSet->pFds[i].fd != sock); i++)
+    {
+        ;
+    }
+    if (i == pollSet->noOfFds)
+    {
+        return VOS_PARAM_ERR;
+    }
+    pollSet->noOfFds--;
+    pollSet->pFds[i]   = pollSet->pFds[pollSet->noOfFds];
+    pollSet->pRefs[i]  = pollSet->pRefs[pollSet->noOfFds];
+#endif
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Wait until sockets of a set become readable.
+ *  Sockets stay readable (level triggered) until their data has been read.
+ *
+ *  @param[in]      pollSet         handle of the set
+ *  @param[out]     pEvents         array to receive the readable sockets
+ *  @param[in,out]  pNoOfEvents     In: size of the array, Out: number of readable sockets
+ *  @param[in]      pTimeOut        max. time to wait, NULL to wait forever
+ *
+ *  @retval         VOS_NO_ERR      no error (*pNoOfEvents is 0 on time out)
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_IO_ERR      wait failed
+ */
+
+EXT_DECL VOS_ERR_T vos_pollWait (
+    VOS_POLL_T          pollSet,
+    VOS_POLL_EVENT_T    *pEvents,
+    UINT32              *pNoOfEvents,
+    const VOS_TIMEVAL_T *pTimeOut)
+{
+    int         timeOut = -1;
+    int         ready;
+    UINT32      i;
+#ifdef __linux
+    struct epoll_event  events[VOS_POLL_MAX_EVENTS];
+#else
+    UINT32      found = 0u;
+#endif
+
+    if ((pollSet == NULL) || (pEvents == NULL) || (pNoOfEvents == NULL) || (*pNoOfEvents == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    if (pTimeOut != NULL)
+    {
+        /* round up to full ms, never sleep shorter than requested */
+        timeOut = (int) (pTimeOut->tv_sec * 1000u + ((UINT32) pTimeOut->tv_usec + 999u) / 1000u);
+    }
+
+#ifdef __linux
+    if (*pNoOfEvents > VOS_POLL_MAX_EVENTS)
+    {
+        *pNoOfEvents = VOS_POLL_MAX_EVENTS;
+    }
+    ready = epoll_wait(pollSet->epfd, events, (int) *pNoOfEvents, timeOut);
+    if (ready == -1)
+    {
+        *pNoOfEvents = 0u;
+        return (errno == EINTR) ? VOS_NO_ERR : VOS_IO_ERR;
+    }
+    for (i = 0u; i < (UINT32) ready; i++)
+    {
+        pEvents[i].sock = (SOCKET) (uint32_t) events[i].data.u64;
+        pEvents[i].ref  = (UINT32) (events[i].data.u64 >> 32);
+    }
+    *pNoOfEvents = (UINT32) ready;
+#else
+    ready = poll(pollSet->pFds, (nfds_t) pollSet->noOfFds, timeOut);
+    if (ready == -1)
+    {
+        *pNoOfEvents = 0u;
+        return (errno == EINTR) ? VOS_NO_ERR : VOS_IO_ERR;
+    }
+    i = 0u;
+    while ((ready > 0) && (i < pollSet->noOfFds))
+    {
+        if (pollSet->pFds[i].revents == 0)
+        {
+            i++;
+            continue;
+        }
+        ready--;
+        if (pollSet->pFds[i].revents & POLLNVAL)
+        {
+            /* closed meanwhile: it leaves the set */
+            pollSet->noOfFds--;
+            pollSet->pFds[i]   = pollSet->pFds[pollSet->noOfFds];
+            pollSet->pRefs[i]  = pollSet->pRefs[pollSet->noOfFds];
+            continue;
+        }
+        if (found < *pNoOfEvents)
+        {
+            pEvents[found].sock = pollSet->pFds[i].fd;
+            pEvents[found].ref  = pollSet->pRefs[i];
+            found++;
+        }
+        i++;
+    }
+    *pNoOfEvents = found;
+#endif
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get a descriptor which becomes readable whenever a socket of the set is readable.
+ *
+ *  @param[in]      pollSet         handle of the set
+ *  @param[out]     pDesc           pointer to the descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_UNKNOWN_ERR the target has no such descriptor (no epoll)
+ */
+
+EXT_DECL VOS_ERR_T vos_pollGetDesc (
+    VOS_POLL_T  pollSet,
+    SOCKET      *pDesc)
+{
+    if ((pollSet == NULL) || (pDesc == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+#ifdef __linux
+    *pDesc = pollSet->epfd;
+    return VOS_NO_ERR;
+#else
+    return VOS_UNKNOWN_ERR;
+#endif
+}
+
 /**********************************************************************************************************************/
 /** Get a list of interface addresses
  *  The caller has to provide an array of interface records to be filled.
@@ -923,6 +1312,17 @@ EXT_DECL VOS_ERR_T vos_sockSetOptions (
             }
         }
 #endif
+        if (pOptions->noDelay > 0)
+        {
+            sockOptValue = 1;
+            if (setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &sockOptValue,
+                           sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "setsockopt() TCP_NODELAY failed (Err: %s)\n", buff);
+            }
+        }
     }
     /*  Include struct in_pktinfo in the message "ancilliary" control data.
         This way we can get the destination IP address for received UDP packets */
@@ -1172,6 +1572,125 @@ EXT_DECL VOS_ERR_T vos_sockSendUDP (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Send several UDP datagrams with one call.
+ *  Every datagram is sent to its own destination address and port. A failing datagram does not stop the
+ *  transmission of the following ones. On Linux sendmmsg() is used, other targets send one datagram after the other.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in,out]  pMsgs           array of datagram descriptors (pBuffer, size, dstIPAddr and dstIPPort must be set)
+ *                                  Out: size is the number of bytes sent, 0 if the datagram could not be sent
+ *  @param[in,out]  pNoOfMsgs       In: number of descriptors, Out: number of datagrams sent
+ *
+ *  @retval         VOS_NO_ERR      all datagrams sent
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_IO_ERR      at least one datagram could not be sent
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          *pNoOfMsgs)
+{
+    VOS_ERR_T           err = VOS_NO_ERR;
+    UINT32              sent = 0u;
+#if defined(__linux)
+    struct sockaddr_in  destAddr[VOS_MAX_SOCK_BATCH];
+    struct mmsghdr      msgs[VOS_MAX_SOCK_BATCH];
+    struct iovec        iov[VOS_MAX_SOCK_BATCH];
+    UINT32              noOfMsgs;
+    UINT32              start;
+    UINT32              i;
+    int                 sendCnt;
+
+    if ((sock == -1) || (pMsgs == NULL) || (pNoOfMsgs == NULL) || (*pNoOfMsgs > VOS_MAX_SOCK_BATCH))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    noOfMsgs = *pNoOfMsgs;
+    memset(msgs, 0, noOfMsgs * sizeof(struct mmsghdr));
+    memset(destAddr, 0, noOfMsgs * sizeof(struct sockaddr_in));
+
+    for (i = 0u; i < noOfMsgs; i++)
+    {
+        destAddr[i].sin_family          = AF_INET;
+        destAddr[i].sin_addr.s_addr     = vos_htonl(pMsgs[i].dstIPAddr);
+        destAddr[i].sin_port            = vos_htons(pMsgs[i].dstIPPort);
+        iov[i].iov_base                 = pMsgs[i].pBuffer;
+        iov[i].iov_len                  = pMsgs[i].size;
+        msgs[i].msg_hdr.msg_iov         = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen      = 1;
+        msgs[i].msg_hdr.msg_name        = &destAddr[i];
+        msgs[i].msg_hdr.msg_namelen     = sizeof(destAddr[i]);
+    }
+
+    start = 0u;
+    while (start < noOfMsgs)
+    {
+        sendCnt = sendmmsg(sock, &msgs[start], (unsigned int) (noOfMsgs - start), 0);
+
+        if (sendCnt == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            /*  The datagram at 'start' failed, skip it and go on with the next one */
+            if (errno == EWOULDBLOCK)
+            {
+                err = VOS_BLOCK_ERR;
+            }
+            else
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "sendmmsg() to %s:%u failed (Err: %s)\n",
+                             inet_ntoa(destAddr[start].sin_addr), (unsigned int)pMsgs[start].dstIPPort, buff);
+                err = VOS_IO_ERR;
+            }
+            pMsgs[start].size = 0u;
+            start++;
+        }
+        else
+        {
+            for (i = start; i < (start + (UINT32) sendCnt); i++)
+            {
+                pMsgs[i].size = (UINT32) msgs[i].msg_len;
+            }
+            sent    += (UINT32) sendCnt;
+            start   += (UINT32) sendCnt;
+        }
+    }
+#else
+    UINT32              i;
+
+    if ((pMsgs == NULL) || (pNoOfMsgs == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    /*  No sendmmsg() available: one datagram after the other  */
+    for (i = 0u; i < *pNoOfMsgs; i++)
+    {
+        VOS_ERR_T result = vos_sockSendUDP(sock, pMsgs[i].pBuffer, &pMsgs[i].size,
+                                           pMsgs[i].dstIPAddr, pMsgs[i].dstIPPort);
+        if (result == VOS_NO_ERR)
+        {
+            sent++;
+        }
+        else
+        {
+            pMsgs[i].size = 0u;
+            err = result;
+        }
+    }
+#endif
+    *pNoOfMsgs = sent;
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Receive UDP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -1208,14 +1727,13 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
     union
     {
         struct cmsghdr  cm;
-        char            raw[32];
+        char            raw[VOS_SOCK_CTRL_BUF_SIZE];
     } control_un;
     struct sockaddr_in  srcAddr;
     socklen_t           sockLen = sizeof(srcAddr);
     ssize_t rcvSize = 0;
     struct msghdr       msg;
     struct iovec        iov;
-    struct cmsghdr      *cmsg;
 
     if (sock == -1 || pBuffer == NULL || pSize == NULL)
     {
@@ -1248,24 +1766,8 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
         {
             if (pDstIPAddr != NULL)
             {
-                for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg))
-                {
-#if defined(IP_RECVDSTADDR)
-                    if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_RECVDSTADDR)
-                    {
-                        struct in_addr *pia = (struct in_addr *)CMSG_DATA(cmsg);
-                        *pDstIPAddr = (UINT32)vos_ntohl(pia->s_addr);
-                        /* vos_printLog(VOS_LOG_DBG, "udp message dest IP: %s\n", vos_ipDotted(*pDstIPAddr)); */
-                    }
-#elif defined(IP_PKTINFO)
-                    if (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_PKTINFO)
-                    {
-                        struct in_pktinfo *pia = (struct in_pktinfo *)CMSG_DATA(cmsg);
-                        *pDstIPAddr = (UINT32)vos_ntohl(pia->ipi_addr.s_addr);
-                        /* vos_printLog(VOS_LOG_DBG, "udp message dest IP: %s\n", vos_ipDotted(*pDstIPAddr)); */
-                    }
-#endif
-                }
+                vos_sockGetDstAddr(&msg, pDstIPAddr);
+                /* vos_printLog(VOS_LOG_DBG, "udp message dest IP: %s\n", vos_ipDotted(*pDstIPAddr)); */
             }
 
 
@@ -1314,6 +1816,122 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
     }
 }
 
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams with one call.
+ *  Fills up to *pNoOfMsgs buffers with the datagrams pending on the socket. The call will block (if the socket is in
+ *  blocking mode) until the first datagram is available, further datagrams are only fetched if already queued.
+ *  Targets without a batched receive system call will deliver one datagram per call.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in,out]  pMsgs           array of datagram descriptors (pBuffer and size must be set)
+ *  @param[in,out]  pNoOfMsgs       In: number of descriptors, Out: number of datagrams received
+ *
+ *  @retval         VOS_NO_ERR      at least one datagram received
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          *pNoOfMsgs)
+{
+#if defined(__linux) && defined(MSG_WAITFORONE)
+    union
+    {
+        struct cmsghdr  cm;
+        char            raw[VOS_SOCK_CTRL_BUF_SIZE];
+    } control_un[VOS_MAX_SOCK_BATCH];
+    struct sockaddr_in  srcAddr[VOS_MAX_SOCK_BATCH];
+    struct mmsghdr      msgs[VOS_MAX_SOCK_BATCH];
+    struct iovec        iov[VOS_MAX_SOCK_BATCH];
+    unsigned int        noOfMsgs;
+    unsigned int        i;
+    int                 rcvCnt;
+
+    if ((sock == -1) || (pMsgs == NULL) || (pNoOfMsgs == NULL) || (*pNoOfMsgs == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    noOfMsgs = (*pNoOfMsgs > VOS_MAX_SOCK_BATCH) ? VOS_MAX_SOCK_BATCH : (unsigned int) *pNoOfMsgs;
+    *pNoOfMsgs = 0u;
+
+    memset(msgs, 0, noOfMsgs * sizeof(struct mmsghdr));
+    memset(control_un, 0, noOfMsgs * sizeof(control_un[0]));
+
+    for (i = 0u; i < noOfMsgs; i++)
+    {
+        iov[i].iov_base                 = pMsgs[i].pBuffer;
+        iov[i].iov_len                  = pMsgs[i].size;
+        msgs[i].msg_hdr.msg_iov         = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen      = 1;
+        msgs[i].msg_hdr.msg_name        = &srcAddr[i];
+        msgs[i].msg_hdr.msg_namelen     = sizeof(srcAddr[i]);
+        msgs[i].msg_hdr.msg_control     = &control_un[i].cm;
+        msgs[i].msg_hdr.msg_controllen  = sizeof(control_un[i]);
+    }
+
+    /*  Wait for the first datagram only, take the rest if already queued   */
+    do
+    {
+        rcvCnt = recvmmsg(sock, msgs, noOfMsgs, MSG_WAITFORONE, NULL);
+    }
+    while (rcvCnt == -1 && errno == EINTR);
+
+    if (rcvCnt == -1)
+    {
+        if (errno == EWOULDBLOCK)
+        {
+            return VOS_BLOCK_ERR;
+        }
+        else if (errno == ECONNRESET)
+        {
+            /* ICMP port unreachable received (result of previous send), treat this as no error */
+            return VOS_NO_ERR;
+        }
+        else
+        {
+            char buff[VOS_MAX_ERR_STR_SIZE];
+            STRING_ERR(buff);
+            vos_printLog(VOS_LOG_ERROR, "recvmmsg() failed (Err: %s)\n", buff);
+            return VOS_IO_ERR;
+        }
+    }
+    else if (rcvCnt == 0)
+    {
+        return VOS_NODATA_ERR;
+    }
+
+    for (i = 0u; i < (unsigned int) rcvCnt; i++)
+    {
+        pMsgs[i].size       = (UINT32) msgs[i].msg_len;
+        pMsgs[i].srcIPAddr  = (UINT32) vos_ntohl(srcAddr[i].sin_addr.s_addr);
+        pMsgs[i].srcIPPort  = (UINT16) vos_ntohs(srcAddr[i].sin_port);
+        pMsgs[i].dstIPAddr  = 0u;
+        vos_sockGetDstAddr(&msgs[i].msg_hdr, &pMsgs[i].dstIPAddr);
+    }
+    *pNoOfMsgs = (UINT32) rcvCnt;
+    return VOS_NO_ERR;
+#else
+    VOS_ERR_T err;
+
+    if ((pMsgs == NULL) || (pNoOfMsgs == NULL) || (*pNoOfMsgs == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    /*  No recvmmsg() available: one datagram per call  */
+    pMsgs[0].dstIPAddr = 0u;
+    err = vos_sockReceiveUDP(sock, pMsgs[0].pBuffer, &pMsgs[0].size,
+                             &pMsgs[0].srcIPAddr, &pMsgs[0].srcIPPort, &pMsgs[0].dstIPAddr, FALSE);
+    *pNoOfMsgs = (err == VOS_NO_ERR) ? 1u : 0u;
+    return err;
+#endif
+}
+
 /**********************************************************************************************************************/
 /** Bind a socket to an address and port.
  *
@@ -1612,6 +2230,96 @@ EXT_DECL VOS_ERR_T vos_sockSendTCP (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Send several segments of TCP data with one call.
+ *  The segments are sent back to back as one byte stream, up to VOS_MAX_SOCK_BATCH segments by one writev().
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pSegs           array of segments to send
+ *  @param[in]      noOfSegs        number of segments
+ *  @param[out]     pSize           no of bytes sent
+ *
+ *  @retval         VOS_NO_ERR      all segments sent
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   call would have blocked in non-blocking mode, data partially sent
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCPVec (
+    SOCKET                  sock,
+    const VOS_SOCK_SEG_T    *pSegs,
+    UINT32                  noOfSegs,
+    UINT32                  *pSize)
+{
+    struct iovec    iov[VOS_MAX_SOCK_BATCH];
+    UINT32          seg     = 0u;   /* first segment not completely sent  */
+    UINT32          offset  = 0u;   /* bytes of pSegs[seg] already sent     */
+    UINT32          cnt;
+    ssize_t         sendSize;
+
+    if ((sock == -1) || ((pSegs == NULL) && (noOfSegs != 0u)) || (pSize == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pSize = 0u;
+
+    /* Keep on sending until we got rid of all data or we received an unrecoverable error */
+    while (seg < noOfSegs)
+    {
+        if (pSegs[seg].size == offset)
+        {
+            seg++;
+            offset = 0u;
+            continue;
+        }
+        for (cnt = 0u; (cnt < VOS_MAX_SOCK_BATCH) && ((seg + cnt) < noOfSegs); cnt++)
+        {
+            iov[cnt].iov_base   = (void *) (pSegs[seg + cnt].pBuffer + ((cnt == 0u) ? offset : 0u));
+            iov[cnt].iov_len    = pSegs[seg + cnt].size - ((cnt == 0u) ? offset : 0u);
+        }
+
+        sendSize = writev(sock, iov, (int) cnt);
+
+        if (sendSize == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EWOULDBLOCK)
+            {
+                return VOS_BLOCK_ERR;
+            }
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "writev() failed (Err: %s)\n", buff);
+            }
+            if ((errno == ENOTCONN)
+                || (errno == ECONNREFUSED)
+                || (errno == EHOSTUNREACH))
+            {
+                return VOS_NOCONN_ERR;
+            }
+            return VOS_IO_ERR;
+        }
+
+        *pSize += (UINT32) sendSize;
+
+        /* Skip the segments sent completely, stop in the one sent partially */
+        while ((seg < noOfSegs) && ((size_t) sendSize >= (pSegs[seg].size - offset)))
+        {
+            sendSize   -= (ssize_t) (pSegs[seg].size - offset);
+            seg++;
+            offset      = 0u;
+        }
+        offset += (UINT32) sendSize;
+    }
+    return VOS_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Receive TCP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -18,6 +18,10 @@
 /*
 * $Id: vos_sock.c 2088 2019-10-10 14:36:13Z bloehr $*
 *
+*      AG 2026-10-17: vos_sockSendTCPVec() added (one segment per call), socket option noDelay
+*      AG 2026-10-17: vos_pollCreate/Destroy/Add/Del/Wait/GetDesc() added (not implemented)
+*      AG 2026-10-17: vos_sockSendUDPBatch() added (one datagram per call)
+*      AG 2026-10-17: vos_sockReceiveUDPBatch() added (one datagram per call)
 *      BL 2019-09-10: Ticket #278 Don't check if a socket is < 0
 *      BL 2019-08-27: Changed send failure from ERROR to WARNING
 *      BL 2019-01-29: Ticket #233: DSCP Values not standard conform
@@ -508,6 +512,125 @@ EXT_DECL INT32 vos_select (
                   (fd_set *) pErrorFD, (struct timeval *) pTimeOut);
 }
 
+/**********************************************************************************************************************/
+/** Create a set of sockets to wait on for readability.
+ *  Not implemented for this target, use vos_select().
+ *
+ *  @param[out]     pPoll           pointer to the handle of the new set
+ *  @param[in]      maxSockets      max. number of sockets in the set
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_pollCreate (
+    VOS_POLL_T  *pPoll,
+    UINT32      maxSockets)
+{
+    (void) pPoll;
+    (void) maxSockets;
+    vos_printLogStr(VOS_LOG_WARNING, "vos_pollCreate() not implemented\n");
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Destroy a set of sockets. Not implemented for this target.
+ *
+ *  @param[in]      pollSet         handle of the set
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_pollDestroy (
+    VOS_POLL_T pollSet)
+{
+    (void) pollSet;
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Add a socket to a set. Not implemented for this target.
+ *
+ *  @param[in]      pollSet         handle of the set
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      ref             reference reported with the events of this socket
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_pollAdd (
+    VOS_POLL_T  pollSet,
+    SOCKET      sock,
+    UINT32      ref)
+{
+    (void) pollSet;
+    (void) sock;
+    (void) ref;
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Remove a socket from a set. Not implemented for this target.
+ *
+ *  @param[in]      pollSet         handle of the set
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_pollDel (
+    VOS_POLL_T  pollSet,
+    SOCKET      sock)
+{
+    (void) pollSet;
+    (void) sock;
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Wait until sockets of a set become readable. Not implemented for this target.
+ *
+ *  @param[in]      pollSet         handle of the set
+ *  @param[out]     pEvents         array to receive the readable sockets
+ *  @param[in,out]  pNoOfEvents     In: size of the array, Out: number of readable sockets
+ *  @param[in]      pTimeOut        max. time to wait, NULL to wait forever
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_pollWait (
+    VOS_POLL_T          pollSet,
+    VOS_POLL_EVENT_T    *pEvents,
+    UINT32              *pNoOfEvents,
+    const VOS_TIMEVAL_T *pTimeOut)
+{
+    (void) pollSet;
+    (void) pEvents;
+    (void) pTimeOut;
+    if (pNoOfEvents != NULL)
+    {
+        *pNoOfEvents = 0u;
+    }
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get a descriptor which becomes readable whenever a socket of the set is readable. Not implemented for this target.
+ *
+ *  @param[in]      pollSet         handle of the set
+ *  @param[out]     pDesc           pointer to the descriptor
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_pollGetDesc (
+    VOS_POLL_T  pollSet,
+    SOCKET      *pDesc)
+{
+    (void) pollSet;
+    (void) pDesc;
+    return VOS_UNKNOWN_ERR;
+}
+
 /*    Sockets    */
 
 /**********************************************************************************************************************/
@@ -924,6 +1047,18 @@ EXT_DECL VOS_ERR_T vos_sockSetOptions (
                 vos_printLog(VOS_LOG_ERROR, "setsockopt() UDP_CHECKSUM_COVERAGE failed (Err: %d)\n", err);
             }
         }
+        if (pOptions->noDelay > 0)
+        {
+            DWORD optValue = TRUE;
+            if (setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (const char *)&optValue,
+                           sizeof(optValue)) == SOCKET_ERROR)
+            {
+                int err = WSAGetLastError();
+
+                err = err;     /* for lint */
+                vos_printLog(VOS_LOG_ERROR, "setsockopt() TCP_NODELAY failed (Err: %d)\n", err);
+            }
+        }
 
     }
 
@@ -1153,6 +1288,55 @@ EXT_DECL VOS_ERR_T vos_sockSendUDP (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Send several UDP datagrams with one call.
+ *  No batched send system call available on this target: the datagrams are sent one after the other.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in,out]  pMsgs           array of datagram descriptors (pBuffer, size, dstIPAddr and dstIPPort must be set)
+ *                                  Out: size is the number of bytes sent, 0 if the datagram could not be sent
+ *  @param[in,out]  pNoOfMsgs       In: number of descriptors, Out: number of datagrams sent
+ *
+ *  @retval         VOS_NO_ERR      all datagrams sent
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_IO_ERR      at least one datagram could not be sent
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          *pNoOfMsgs)
+{
+    VOS_ERR_T   err = VOS_NO_ERR;
+    UINT32      noOfMsgs;
+    UINT32      sent = 0u;
+    UINT32      i;
+
+    if ((pMsgs == NULL) || (pNoOfMsgs == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    noOfMsgs = *pNoOfMsgs;
+    for (i = 0u; i < noOfMsgs; i++)
+    {
+        VOS_ERR_T result = vos_sockSendUDP(sock, pMsgs[i].pBuffer, &pMsgs[i].size,
+                                           pMsgs[i].dstIPAddr, pMsgs[i].dstIPPort);
+        if (result == VOS_NO_ERR)
+        {
+            sent++;
+        }
+        else
+        {
+            pMsgs[i].size = 0u;
+            err = result;       /* report the last error, but try the remaining datagrams */
+        }
+    }
+    *pNoOfMsgs = sent;
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Receive UDP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -1285,6 +1469,40 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
 
 }
 
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams with one call.
+ *  There is no batched receive on this target, exactly one datagram will be delivered per call.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in,out]  pMsgs           array of datagram descriptors (pBuffer and size must be set)
+ *  @param[in,out]  pNoOfMsgs       In: number of descriptors, Out: number of datagrams received
+ *
+ *  @retval         VOS_NO_ERR      at least one datagram received
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          *pNoOfMsgs)
+{
+    VOS_ERR_T err;
+
+    if ((pMsgs == NULL) || (pNoOfMsgs == NULL) || (*pNoOfMsgs == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    pMsgs[0].dstIPAddr = 0u;
+    err = vos_sockReceiveUDP(sock, pMsgs[0].pBuffer, &pMsgs[0].size,
+                             &pMsgs[0].srcIPAddr, &pMsgs[0].srcIPPort, &pMsgs[0].dstIPAddr, FALSE);
+    *pNoOfMsgs = (err == VOS_NO_ERR) ? 1u : 0u;
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Bind a socket to an address and port.
  *
@@ -1572,6 +1790,47 @@ EXT_DECL VOS_ERR_T vos_sockSendTCP (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Send several segments of TCP data with one call.
+ *  No vectored send on this target, the segments are sent one after the other by vos_sockSendTCP().
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pSegs           array of segments to send
+ *  @param[in]      noOfSegs        number of segments
+ *  @param[out]     pSize           no of bytes sent
+ *
+ *  @retval         VOS_NO_ERR      all segments sent
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   call would have blocked in non-blocking mode, data partially sent
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCPVec (
+    SOCKET                  sock,
+    const VOS_SOCK_SEG_T    *pSegs,
+    UINT32                  noOfSegs,
+    UINT32                  *pSize)
+{
+    VOS_ERR_T   err = VOS_NO_ERR;
+    UINT32      i;
+    UINT32      size;
+
+    if (((pSegs == NULL) && (noOfSegs != 0u)) || (pSize == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pSize = 0u;
+    for (i = 0u; (i < noOfSegs) && (err == VOS_NO_ERR); i++)
+    {
+        size    = pSegs[i].size;
+        err     = (size != 0u) ? vos_sockSendTCP(sock, pSegs[i].pBuffer, &size) : VOS_NO_ERR;
+        *pSize  += size;
+    }
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Receive TCP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -14,6 +14,10 @@
  *
  * $Id: LibraryTests.c 1804 2018-11-13 08:18:02Z ahweiss $
  *
+ *      AG 2026-10-17: testMemReclaim: blocks in the own magazine serve as bigger blocks before allocation fails
+ *      AG 2026-10-17: testMemStats: per block size used/peak/fallback/failed counters
+ *      AG 2026-10-17: testMem: several threads on the memory pool, cross thread free, timing
+ *      AG 2026-10-17: testQueue: lock free queue, several producers, timing against the mutex queue
  *      BL 2017-05-22: Ticket #122: Addendum for 64Bit compatibility (VOS_TIME_T -> VOS_TIMEVAL_T)
  */
 
@@ -300,6 +304,414 @@ int testInterfaces()
     return 0; /* all time tests succeeded */
 }
 
+#define QUEUE_PRODUCERS     3
+#define QUEUE_MESSAGES      20000
+#define QUEUE_BENCH_LOOPS   200000
+
+typedef struct
+{
+    VOS_QUEUE_T     queue;
+    UINT32          id;
+    volatile int    done;
+} QUEUE_PRODUCER_T;
+
+static void queueProducer(void *pArg)
+{
+    QUEUE_PRODUCER_T *pProducer = (QUEUE_PRODUCER_T *) pArg;
+    UINT32 i;
+
+    for (i = 1; i <= QUEUE_MESSAGES; i++)
+    {
+        /* sequence number as pointer, producer id as size */
+        while (vos_queueSend(pProducer->queue, (UINT8 *)(uintptr_t) i, pProducer->id) == VOS_QUEUE_FULL_ERR)
+        {
+            (void) vos_threadDelay(100);
+        }
+    }
+    pProducer->done = 1;
+}
+
+static double queueBench(VOS_QUEUE_POLICY_T policy)
+{
+    VOS_QUEUE_T     queue;
+    VOS_TIMEVAL_T   start, now;
+    UINT8           *pData;
+    UINT32          size;
+    int             i;
+
+    if (vos_queueCreate(policy, 16, &queue) != VOS_NO_ERR)
+    {
+        return -1.0;
+    }
+    vos_getTime(&start);
+    for (i = 0; i < QUEUE_BENCH_LOOPS; i++)
+    {
+        (void) vos_queueSend(queue, (UINT8 *) &queue, 1);
+        (void) vos_queueReceive(queue, &pData, &size, 0);
+    }
+    vos_getTime(&now);
+    vos_subTime(&now, &start);
+    (void) vos_queueDestroy(queue);
+    return ((double) now.tv_sec * 1000000000.0 + (double) now.tv_usec * 1000.0) / QUEUE_BENCH_LOOPS;
+}
+
+int testQueue()
+{
+    VOS_QUEUE_T         queue;
+    VOS_THREAD_T        thread;
+    QUEUE_PRODUCER_T    producer[QUEUE_PRODUCERS];
+    UINT32              last[QUEUE_PRODUCERS] = {0};
+    UINT8               *pData;
+    UINT8               copy[VOS_QUEUE_INLINE_SIZE];
+    UINT32              size;
+    UINT32              received = 0;
+    int                 i;
+
+    if (vos_queueCreate(VOS_QUEUE_POLICY_LOCKFREE, 3, &queue) != VOS_NO_ERR)
+    {
+        printf("vos_queueCreate(VOS_QUEUE_POLICY_LOCKFREE) failed\n");
+        return 1;
+    }
+
+    /* rounded up to 4 messages */
+    for (i = 0; i < 4; i++)
+    {
+        if (vos_queueSend(queue, (UINT8 *) &last[i], (UINT32) i + 1) != VOS_NO_ERR)
+            return 1;
+    }
+    if (vos_queueSend(queue, (UINT8 *) &last[0], 1) != VOS_QUEUE_FULL_ERR)
+        return 1;
+    for (i = 0; i < 4; i++)
+    {
+        if ((vos_queueReceive(queue, &pData, &size, 0) != VOS_NO_ERR) ||
+            (pData != (UINT8 *) &last[i]) || (size != (UINT32) i + 1))
+            return 1;
+    }
+    if (vos_queueReceive(queue, &pData, &size, 1000) != VOS_QUEUE_ERR)
+        return 1;
+
+    /* copied messages */
+    if ((vos_queueSendCopy(queue, (const UINT8 *) "hello", 6) != VOS_NO_ERR) ||
+        (vos_queueSendCopy(queue, copy, VOS_QUEUE_INLINE_SIZE + 1) != VOS_PARAM_ERR))
+        return 1;
+    size = sizeof(copy);
+    if ((vos_queueReceiveCopy(queue, copy, &size, 0) != VOS_NO_ERR) || (size != 6) ||
+        (strcmp((const char *) copy, "hello") != 0))
+        return 1;
+    vos_queueDestroy(queue);
+
+    /* several producers, one blocking receiver */
+    if (vos_queueCreate(VOS_QUEUE_POLICY_LOCKFREE, 64, &queue) != VOS_NO_ERR)
+        return 1;
+    (void) vos_threadInit();
+    for (i = 0; i < QUEUE_PRODUCERS; i++)
+    {
+        producer[i].queue = queue;
+        producer[i].id = (UINT32) i + 1;
+        producer[i].done = 0;
+        if (vos_threadCreate(&thread, "queueProducer", VOS_THREAD_POLICY_OTHER, 0, 0, 0,
+                             queueProducer, &producer[i]) != VOS_NO_ERR)
+        {
+            printf("vos_threadCreate failed\n");
+            return 1;
+        }
+    }
+    while (received < QUEUE_PRODUCERS * QUEUE_MESSAGES)
+    {
+        if (vos_queueReceive(queue, &pData, &size, 1000000) != VOS_NO_ERR)
+        {
+            printf("Lock free queue: only %u messages received\n", received);
+            return 1;
+        }
+        /* FIFO per producer */
+        if ((size < 1) || (size > QUEUE_PRODUCERS) || ((uintptr_t) pData != last[size - 1] + 1))
+        {
+            printf("Lock free queue: message %p from %u out of order\n", (void *) pData, size);
+            return 1;
+        }
+        last[size - 1]++;
+        received++;
+    }
+    for (i = 0; i < QUEUE_PRODUCERS; i++)
+    {
+        while (!producer[i].done)
+        {
+            (void) vos_threadDelay(1000);
+        }
+    }
+    vos_queueDestroy(queue);
+
+    printf("Queue send/receive: mutex %.1f ns, lock free %.1f ns\n",
+           queueBench(VOS_QUEUE_POLICY_FIFO), queueBench(VOS_QUEUE_POLICY_LOCKFREE));
+    return 0;
+}
+
+#define MEM_WORKERS         4
+#define MEM_LOOPS           20000
+#define MEM_POOL_SIZE       (2u * 1024u * 1024u)
+#define MEM_QUEUE_DEPTH     64      /* blocks in flight to the main thread must fit into the pool */
+
+typedef struct
+{
+    VOS_QUEUE_T     queue;      /* blocks handed to the main thread */
+    UINT32          seed;
+    UINT32          errors;
+    volatile int    done;
+} MEM_WORKER_T;
+
+static void memWorker(void *pArg)
+{
+    MEM_WORKER_T    *pWorker = (MEM_WORKER_T *) pArg;
+    UINT8           *p[8];
+    UINT32          i, j, size;
+
+    for (i = 0; i < MEM_LOOPS; i++)
+    {
+        for (j = 0; j < 8; j++)
+        {
+            pWorker->seed = pWorker->seed * 1103515245u + 12345u;
+            size = 1u + (pWorker->seed >> 16) % 2100u;
+            p[j] = vos_memAlloc(size);
+            if (p[j] == NULL)
+            {
+                pWorker->errors++;
+                continue;
+            }
+            p[j][0] = (UINT8) j;
+            p[j][size - 1] = (UINT8) j;
+        }
+        for (j = 0; j < 8; j++)
+        {
+            if (p[j] == NULL)
+            {
+                continue;
+            }
+            /* every 16th block is freed by the main thread */
+            if (((i & 15u) == 0u) && (j == 0u) &&
+                (vos_queueSend(pWorker->queue, p[j], 1) == VOS_NO_ERR))
+            {
+                continue;
+            }
+            vos_memFree(p[j]);
+        }
+    }
+    pWorker->done = 1;
+}
+
+static double memBench(void)
+{
+    VOS_TIMEVAL_T   start, now;
+    UINT8           *p[4];
+    int             i;
+
+    vos_getTime(&start);
+    for (i = 0; i < QUEUE_BENCH_LOOPS; i++)
+    {
+        p[0] = vos_memAlloc(40);
+        p[1] = vos_memAlloc(120);
+        p[2] = vos_memAlloc(1400);
+        p[3] = vos_memAlloc(64);
+        vos_memFree(p[2]);
+        vos_memFree(p[0]);
+        vos_memFree(p[3]);
+        vos_memFree(p[1]);
+    }
+    vos_getTime(&now);
+    vos_subTime(&now, &start);
+    return ((double) now.tv_sec * 1000000000.0 + (double) now.tv_usec * 1000.0) / (QUEUE_BENCH_LOOPS * 4);
+}
+
+int testMem()
+{
+    VOS_THREAD_T    thread;
+    MEM_WORKER_T    worker[MEM_WORKERS];
+    VOS_QUEUE_T     queue;
+    UINT8           *pData;
+    UINT32          size, allocated, freeMem, minFree, numBlocks, numAllocErr, numFreeErr;
+    UINT32          blockSize[VOS_MEM_NBLOCKSIZES], usedBlocks[VOS_MEM_NBLOCKSIZES];
+    UINT32          preAlloc[VOS_MEM_NBLOCKSIZES] = {0};
+    int             i, running;
+    double          heapNs, poolNs;
+
+    heapNs = memBench();
+    if (vos_memInit(NULL, MEM_POOL_SIZE, preAlloc) != VOS_NO_ERR)
+    {
+        printf("vos_memInit failed\n");
+        return 1;
+    }
+    if (vos_queueCreate(VOS_QUEUE_POLICY_LOCKFREE, MEM_QUEUE_DEPTH, &queue) != VOS_NO_ERR)
+    {
+        return 1;
+    }
+    (void) vos_threadInit();
+    for (i = 0; i < MEM_WORKERS; i++)
+    {
+        worker[i].queue = queue;
+        worker[i].seed = (UINT32) i + 1;
+        worker[i].errors = 0;
+        worker[i].done = 0;
+        if (vos_threadCreate(&thread, "memWorker", VOS_THREAD_POLICY_OTHER, 0, 0, 0,
+                             memWorker, &worker[i]) != VOS_NO_ERR)
+        {
+            printf("vos_threadCreate failed\n");
+            return 1;
+        }
+    }
+    do
+    {
+        running = 0;
+        for (i = 0; i < MEM_WORKERS; i++)
+        {
+            running += !worker[i].done;
+        }
+        while (vos_queueReceive(queue, &pData, &size, 0) == VOS_NO_ERR)
+        {
+            vos_memFree(pData);
+        }
+        (void) vos_threadDelay(1000);
+    }
+    while (running);
+    while (vos_queueReceive(queue, &pData, &size, 0) == VOS_NO_ERR)
+    {
+        vos_memFree(pData);
+    }
+    vos_queueDestroy(queue);
+    /* let the workers return their cached blocks at exit */
+    (void) vos_threadDelay(100000);
+
+    poolNs = memBench();
+    if (vos_memCount(&allocated, &freeMem, &minFree, &numBlocks, &numAllocErr, &numFreeErr,
+                     blockSize, usedBlocks) != VOS_NO_ERR)
+    {
+        return 1;
+    }
+    vos_memDelete(NULL);
+    for (i = 0; i < MEM_WORKERS; i++)
+    {
+        if (worker[i].errors != 0)
+        {
+            printf("Memory worker %d: %u allocations failed\n", i, worker[i].errors);
+            return 1;
+        }
+    }
+    if ((numBlocks != 0) || (freeMem != allocated) || (numAllocErr != 0) || (numFreeErr != 0))
+    {
+        printf("Memory pool: %u blocks still allocated, %u of %u bytes free, %u/%u errors\n",
+               numBlocks, freeMem, allocated, numAllocErr, numFreeErr);
+        return 1;
+    }
+    printf("Memory alloc/free: heap %.1f ns, pool %.1f ns\n", heapNs, poolNs);
+    return 0;
+}
+
+int testMemStats()
+{
+    VOS_MEM_CLASS_STATS_T   stats[VOS_MEM_NBLOCKSIZES];
+    UINT32                  preAlloc[VOS_MEM_NBLOCKSIZES] = {0};
+    UINT8                   *p[256];
+    UINT32                  i, n, small, big;
+
+    if (vos_memInit(NULL, 8192, preAlloc) != VOS_NO_ERR)
+    {
+        return 1;
+    }
+    /* one free big block, then exhaust the smallest size: the last but one request uses the big block */
+    vos_memFree(vos_memAlloc(4000));
+    for (n = 0; n < 256; n++)
+    {
+        p[n] = vos_memAlloc(40);
+        if (p[n] == NULL)
+        {
+            break;
+        }
+    }
+    if ((n < 2) || (vos_memClassCount(stats) != VOS_NO_ERR))
+    {
+        return 1;
+    }
+    for (small = 0; (small < VOS_MEM_NBLOCKSIZES) && (stats[small].blockSize < 40); small++)
+    {}
+    for (big = 0; (big < VOS_MEM_NBLOCKSIZES) && (stats[big].blockSize < 4000); big++)
+    {}
+    if ((small >= VOS_MEM_NBLOCKSIZES) || (big >= VOS_MEM_NBLOCKSIZES) ||
+        (stats[small].used != n - 1) || (stats[small].peak != n - 1) ||
+        (stats[small].fallback != 1) || (stats[small].failed != 1) ||
+        (stats[big].used != 1) || (stats[big].peak != 1))
+    {
+        printf("Memory statistics: %u blocks, used %u peak %u fallback %u failed %u, big used %u\n", n,
+               stats[small].used, stats[small].peak, stats[small].fallback, stats[small].failed, stats[big].used);
+        return 1;
+    }
+    for (i = 0; i < n; i++)
+    {
+        vos_memFree(p[i]);
+    }
+    (void) vos_memClassCount(stats);
+    vos_memDelete(NULL);
+    for (i = 0; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        if (stats[i].used != 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int testMemReclaim()
+{
+    VOS_MEM_CLASS_STATS_T   stats[VOS_MEM_NBLOCKSIZES];
+    UINT32                  preAlloc[VOS_MEM_NBLOCKSIZES] = {0};
+    UINT8                   *p[4];
+    UINT8                   **pSmall;
+    UINT32                  i, n, small, mid;
+    const UINT32            maxSmall = MEM_POOL_SIZE / 32u;
+
+    pSmall = (UINT8 **) malloc(maxSmall * sizeof(UINT8 *));
+    if ((pSmall == NULL) || (vos_memInit(NULL, MEM_POOL_SIZE, preAlloc) != VOS_NO_ERR))
+    {
+        free(pSmall);
+        return 1;
+    }
+    /* park some medium blocks in the magazine of this thread, then exhaust the free area with small ones:
+       the blocks in the magazine must serve as bigger blocks before an allocation fails */
+    for (i = 0; i < 4; i++)
+    {
+        p[i] = vos_memAlloc(1000);
+    }
+    for (i = 0; i < 4; i++)
+    {
+        vos_memFree(p[i]);
+    }
+    for (n = 0; n < maxSmall; n++)
+    {
+        pSmall[n] = vos_memAlloc(40);
+        if (pSmall[n] == NULL)
+        {
+            break;
+        }
+    }
+    (void) vos_memClassCount(stats);
+    for (small = 0; (small < VOS_MEM_NBLOCKSIZES) && (stats[small].blockSize < 40); small++)
+    {}
+    for (mid = 0; (mid < VOS_MEM_NBLOCKSIZES) && (stats[mid].blockSize < 1000); mid++)
+    {}
+    for (i = 0; i < n; i++)
+    {
+        vos_memFree(pSmall[i]);
+    }
+    free(pSmall);
+    vos_memDelete(NULL);
+    if ((n >= maxSmall) || (small >= VOS_MEM_NBLOCKSIZES) || (mid >= VOS_MEM_NBLOCKSIZES) ||
+        (stats[small].fallback < 4) || (stats[mid].used != 4))
+    {
+        printf("Memory reclaim: %u blocks, fallback %u, medium blocks used %u\n", n,
+               stats[small].fallback, stats[mid].used);
+        return 1;
+    }
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
     printf("Starting tests\n");
@@ -339,6 +751,30 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    if(testQueue())
+    {
+        printf("Queue test failed\n");
+        return 1;
+    }
+
+    if(testMem())
+    {
+        printf("Memory test failed\n");
+        return 1;
+    }
+
+    if(testMemStats())
+    {
+        printf("Memory statistics test failed\n");
+        return 1;
+    }
+
+    if(testMemReclaim())
+    {
+        printf("Memory reclaim test failed\n");
+        return 1;
+    }
+
     printf("All tests successfully finished.\n");
     return 0;
 }
@@ -0,0 +1,180 @@
+/**********************************************************************************************************************/
+/**
+ * @file            crc-bench.c
+ *
+ * @brief           Micro-benchmark for vos_crc32 and vos_sc32
+ *
+ * @details         Compares the results of vos_crc32 and vos_sc32 against byte-at-a-time reference implementations
+ *                  for all lengths up to 2048 bytes and reports the throughput for PD header (40 bytes) and
+ *                  maximum PD payload (1432 bytes) sized buffers.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *      AG 2026-10-17: Created
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "vos_utils.h"
+#include "vos_thread.h"
+
+/* --- defines ----------------------------------------------------------------*/
+
+#define BENCH_MAX_LEN       2048u
+#define BENCH_HEADER_SIZE   40u         /* PD header                        */
+#define BENCH_PAYLOAD_SIZE  1432u       /* maximum PD payload               */
+#define BENCH_BYTES         200000000u  /* bytes to compute per run         */
+
+/* --- globals ----------------------------------------------------------------*/
+
+static UINT32   sFcsRef[256];
+static UINT32   sSc32Ref[256];
+static UINT8    sData[BENCH_MAX_LEN];
+
+/* --- local functions --------------------------------------------------------*/
+
+/* Build the byte-at-a-time reference tables from the polynomials */
+static void initReference (void)
+{
+    UINT32 i, j;
+
+    for (i = 0u; i < 256u; i++)
+    {
+        UINT32 fcs  = i;
+        UINT32 sc   = i << 24u;
+
+        for (j = 0u; j < 8u; j++)
+        {
+            fcs = (fcs & 1u) ? ((fcs >> 1u) ^ 0xEDB88320u) : (fcs >> 1u);
+            sc  = (sc & 0x80000000u) ? ((sc << 1u) ^ 0xF4ACFB13u) : (sc << 1u);
+        }
+        sFcsRef[i]  = fcs;
+        sSc32Ref[i] = sc;
+    }
+}
+
+static UINT32 refCrc32 (UINT32 crc, const UINT8 *pData, UINT32 dataLen)
+{
+    UINT32 i;
+    for (i = 0u; i < dataLen; i++)
+    {
+        crc = (crc >> 8u) ^ sFcsRef[(crc ^ pData[i]) & 0xffu];
+    }
+    return ~crc;
+}
+
+static UINT32 refSc32 (UINT32 crc, const UINT8 *pData, UINT32 dataLen)
+{
+    UINT32 i;
+    for (i = 0u; i < dataLen; i++)
+    {
+        crc = sSc32Ref[((crc >> 24u) ^ pData[i]) & 0xffu] ^ (crc << 8u);
+    }
+    return crc;
+}
+
+/* Check all lengths and offsets (alignment) against the reference */
+static int verify (void)
+{
+    UINT32  len, offset;
+    int     errors = 0;
+
+    for (offset = 0u; offset < 8u; offset++)
+    {
+        for (len = 0u; len <= (BENCH_MAX_LEN - offset); len++)
+        {
+            UINT32 init = (len & 1u) ? 0xFFFFFFFFu : (UINT32) rand();
+
+            if (vos_crc32(init, sData + offset, len) != refCrc32(init, sData + offset, len))
+            {
+                printf("vos_crc32 mismatch: offset %u, length %u\n", offset, len);
+                errors++;
+            }
+            if (vos_sc32(init, sData + offset, len) != refSc32(init, sData + offset, len))
+            {
+                printf("vos_sc32 mismatch: offset %u, length %u\n", offset, len);
+                errors++;
+            }
+        }
+    }
+
+    /* Check values for "123456789": IEEE802.3 and the result of the former byte-at-a-time SC-32 */
+    if ((vos_crc32(0xFFFFFFFFu, (const UINT8 *) "123456789", 9u) != 0xCBF43926u) ||
+        (vos_sc32(0xFFFFFFFFu, (const UINT8 *) "123456789", 9u) != 0xC683B9E5u))
+    {
+        printf("check values wrong\n");
+        errors++;
+    }
+    return errors;
+}
+
+static double elapsedUs (const VOS_TIMEVAL_T *pStart)
+{
+    VOS_TIMEVAL_T now;
+    vos_getTime(&now);
+    vos_subTime(&now, pStart);
+    return (double) now.tv_sec * 1000000.0 + (double) now.tv_usec;
+}
+
+/* Throughput in bytes/s for one function and buffer size */
+static double measure (UINT32 (*pFunc)(UINT32, const UINT8 *, UINT32), UINT32 size, UINT32 *pSink)
+{
+    VOS_TIMEVAL_T   start;
+    UINT32          loops = BENCH_BYTES / size;
+    UINT32          i;
+    UINT32          crc = 0xFFFFFFFFu;
+    double          usec;
+
+    vos_getTime(&start);
+    for (i = 0u; i < loops; i++)
+    {
+        crc = pFunc(crc, sData, size);
+    }
+    usec = elapsedUs(&start);
+    *pSink ^= crc;
+    return (usec > 0.0) ? (double) loops * size * 1000000.0 / usec : 0.0;
+}
+
+/**********************************************************************************************************************/
+int main (void)
+{
+    static const UINT32 sizes[] = {BENCH_HEADER_SIZE, BENCH_PAYLOAD_SIZE};
+    UINT32  i;
+    UINT32  sink = 0u;
+    int     errors;
+
+    for (i = 0u; i < BENCH_MAX_LEN; i++)
+    {
+        sData[i] = (UINT8) rand();
+    }
+    initReference();
+
+    errors = verify();
+    printf("Verification against byte-at-a-time reference: %s\n", (errors == 0) ? "OK" : "FAILED");
+
+    for (i = 0u; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        printf("%4u bytes: vos_crc32 %8.1f MB/s (reference %8.1f MB/s), vos_sc32 %8.1f MB/s (reference %8.1f MB/s)\n",
+               sizes[i],
+               measure(vos_crc32, sizes[i], &sink) / 1000000.0,
+               measure(refCrc32, sizes[i], &sink) / 1000000.0,
+               measure(vos_sc32, sizes[i], &sink) / 1000000.0,
+               measure(refSc32, sizes[i], &sink) / 1000000.0);
+    }
+    /* keep the results alive */
+    if (sink == 0x12345678u)
+    {
+        printf("\n");
+    }
+    return (errors == 0) ? 0 : 1;
+}
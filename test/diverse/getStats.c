@@ -16,6 +16,9 @@
  *
  * $Id: getStats.c 1916 2019-06-19 14:37:27Z bloehr $
  *
+ *      AG 2026-10-17: Senders evicted from sequence counter tables
+ *      AG 2026-10-17: MD timer wheel occupancy
+ *      AG 2026-10-17: Memory statistics per block size (input for memPrealloc)
  *      BL 2019-02-01: Ticket #234 Correcting Statistics ComIds
  *      BL 2017-06-30: Compiler warnings, local prototypes added
  *      BL 2016-06-08: Ticket #120: ComIds for statistics changed to proposed 61375 errata
@@ -128,6 +131,30 @@ void print_stats (
         printf("%u, ", vos_ntohl(pData->mem.usedBlockSize[i]));
     }
 
+    printf("\nmem.used:           ");
+    for (i = 0; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        printf("%u, ", vos_ntohl(pData->memClass.used[i]));
+    }
+
+    printf("\nmem.peak:           ");
+    for (i = 0; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        printf("%u, ", vos_ntohl(pData->memClass.peak[i]));
+    }
+
+    printf("\nmem.fallback:       ");
+    for (i = 0; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        printf("%u, ", vos_ntohl(pData->memClass.fallback[i]));
+    }
+
+    printf("\nmem.failed:         ");
+    for (i = 0; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        printf("%u, ", vos_ntohl(pData->memClass.failed[i]));
+    }
+
     /* Process data */
     printf("\npd.defQos:          %u\n", vos_ntohl(pData->pd.defQos));
     printf("pd.defTtl:          %u\n", vos_ntohl(pData->pd.defTtl));
@@ -143,6 +170,19 @@ void print_stats (
     printf("pd.numTimeout:      %u\n", vos_ntohl(pData->pd.numTimeout));
     printf("pd.numSend:         %u\n", vos_ntohl(pData->pd.numSend));
     printf("pd.numMissed:       %u\n", vos_ntohl(pData->pd.numMissed));
+
+    /* MD timer wheel */
+    printf("mdTimer.numTimers:  %u\n", vos_ntohl(pData->mdTimer.numTimers));
+    printf("mdTimer.maxTimers:  %u\n", vos_ntohl(pData->mdTimer.maxTimers));
+    printf("mdTimer.perLevel:   ");
+    for (i = 0; i < TRDP_MD_TIMER_LEVELS; i++)
+    {
+        printf("%u, ", vos_ntohl(pData->mdTimer.numPerLevel[i]));
+    }
+    printf("\nmdTimer.numReady:   %u\n", vos_ntohl(pData->mdTimer.numReady));
+    printf("mdTimer.numExpired: %u\n", vos_ntohl(pData->mdTimer.numExpired));
+    printf("mdTimer.numCascaded:%u\n", vos_ntohl(pData->mdTimer.numCascaded));
+    printf("numSeqCntEvict:     %u\n", vos_ntohl(pData->numSeqCntEvict));
     printf("----------------------------------------------------------------------------------------------------\n\n");
 }
 
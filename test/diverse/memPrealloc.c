@@ -0,0 +1,171 @@
+/**********************************************************************************************************************/
+/**
+ * @file            memPrealloc.c
+ *
+ * @brief           Suggest a VOS_MEM_PREALLOCATE vector from recorded memory statistics
+ *
+ * @details         Reads the output of getStats (one or several samples of a representative run, from files or
+ *                  stdin) and takes the block sizes and the maximum of the per block size peak, fallback and failure
+ *                  counts. The suggested number of blocks for a size is its peak plus the requests which had to be
+ *                  served by a bigger size or failed (limited to the peak, they are counts, not concurrent blocks),
+ *                  plus a safety margin.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *      AG 2026-10-17: Created
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "vos_types.h"
+#include "vos_mem.h"
+
+/* --- defines ----------------------------------------------------------------*/
+
+#define DEFAULT_MARGIN      20u     /* percent added to the measured demand */
+#define LINE_SIZE           1024u
+
+/* --- globals ----------------------------------------------------------------*/
+
+static UINT32   sBlockSize[VOS_MEM_NBLOCKSIZES];
+static UINT32   sPeak[VOS_MEM_NBLOCKSIZES];
+static UINT32   sFallback[VOS_MEM_NBLOCKSIZES];
+static UINT32   sFailed[VOS_MEM_NBLOCKSIZES];
+
+/* --- local functions --------------------------------------------------------*/
+
+/* Parse "label:  v, v, v, ..." and keep the maximum per block size */
+static void parseValues (const char *pValues, UINT32 values[VOS_MEM_NBLOCKSIZES])
+{
+    char            *pEnd;
+    unsigned long   value;
+    UINT32          i;
+
+    for (i = 0u; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        value = strtoul(pValues, &pEnd, 10);
+        if (pEnd == pValues)
+        {
+            break;
+        }
+        if (value > values[i])
+        {
+            values[i] = (UINT32) value;
+        }
+        pValues = pEnd;
+        while ((*pValues == ',') || (*pValues == ' '))
+        {
+            pValues++;
+        }
+    }
+}
+
+static void parseFile (FILE *pFile)
+{
+    char line[LINE_SIZE];
+
+    while (fgets(line, sizeof(line), pFile) != NULL)
+    {
+        if (strncmp(line, "mem.blockSize:", 14) == 0)
+        {
+            parseValues(line + 14, sBlockSize);
+        }
+        else if (strncmp(line, "mem.peak:", 9) == 0)
+        {
+            parseValues(line + 9, sPeak);
+        }
+        else if (strncmp(line, "mem.fallback:", 13) == 0)
+        {
+            parseValues(line + 13, sFallback);
+        }
+        else if (strncmp(line, "mem.failed:", 11) == 0)
+        {
+            parseValues(line + 11, sFailed);
+        }
+    }
+}
+
+static void usage (const char *appName)
+{
+    printf("Usage of %s\n", appName);
+    printf("This tool suggests a pre-allocation vector from recorded getStats output.\n"
+           "Arguments are:\n"
+           "-m safety margin in percent (default %u)\n"
+           "[file ...] recorded getStats output, stdin if none\n", DEFAULT_MARGIN);
+}
+
+/* --- main -------------------------------------------------------------------*/
+
+int main (int argc, char *argv[])
+{
+    UINT32  margin = DEFAULT_MARGIN;
+    UINT32  suggested[VOS_MEM_NBLOCKSIZES];
+    UINT32  i, extra, total = 0u;
+    int     arg, files = 0;
+    FILE    *pFile;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        if ((strcmp(argv[arg], "-m") == 0) && (arg + 1 < argc))
+        {
+            margin = (UINT32) strtoul(argv[++arg], NULL, 10);
+        }
+        else if (argv[arg][0] == '-')
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        else
+        {
+            pFile = fopen(argv[arg], "r");
+            if (pFile == NULL)
+            {
+                printf("Cannot open %s\n", argv[arg]);
+                return 1;
+            }
+            parseFile(pFile);
+            (void) fclose(pFile);
+            files++;
+        }
+    }
+    if (files == 0)
+    {
+        parseFile(stdin);
+    }
+    if (sBlockSize[0] == 0u)
+    {
+        printf("No memory statistics found (pool memory not used?)\n");
+        return 1;
+    }
+
+    printf("%8s %8s %8s %8s %10s\n", "size", "peak", "fallback", "failed", "suggested");
+    for (i = 0u; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        extra = sFallback[i] + sFailed[i];
+        if ((sPeak[i] != 0u) && (extra > sPeak[i]))
+        {
+            extra = sPeak[i];
+        }
+        suggested[i] = ((sPeak[i] + extra) * (100u + margin) + 99u) / 100u;
+        total += suggested[i] * (sBlockSize[i] + 2u * (UINT32) sizeof(void *));   /* plus block header */
+        printf("%8u %8u %8u %8u %10u\n", sBlockSize[i], sPeak[i], sFallback[i], sFailed[i], suggested[i]);
+    }
+
+    printf("\n#define VOS_MEM_PREALLOCATE  {");
+    for (i = 0u; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        printf("%uu%s", suggested[i], (i < VOS_MEM_NBLOCKSIZES - 1u) ? ", " : "}\n");
+    }
+    printf("Memory needed for the pre-allocated blocks: %u bytes\n", total);
+    return 0;
+}
@@ -14,6 +14,10 @@
  *
  * $Id: test_tau_dnr.c 1927 2019-06-25 15:23:26Z bloehr $
  *
+ *      AG 2026-10-17: URIs passed in TRDP_URI_HOST_T buffers
+ *      AG 2026-10-17: Asynchronous lookups rejected with standard DNS
+ *      AG 2026-10-17: Asynchronous lookups against a TCN-DNS stand-in on loopback
+ *      AG 2026-10-17: Cache test with a large hosts file, network test can be skipped (-l)
  *      BL 2018-11-09: Testing TCN-DNS for LINT findings in tau_dnr.c
  *      BL 2017-07-25: Testing TCN-DNS for Ticket #125: tau_dnr: TCN DNS support missing
  */
@@ -40,8 +44,11 @@
 #include <string.h>
 
 #include "trdp_if_light.h"
+#include "tau_tti.h"                        /* needed for TRDP_SHORT_VERSION */
 #include "tau_dnr.h"
+#include "tau_dnr_types.h"
 #include "vos_sock.h"
+#include "vos_utils.h"
 
 /*******************************************************************************
  * DEFINES
@@ -55,9 +62,31 @@
 #endif
 
 #define PATH_TO_HOSTSFILE   "hosts_example"
+#define TEST_HOSTSFILE      "test_tau_dnr_hosts"
+#define TEST_NO_OF_HOSTS    400u                    /* several consists worth of function URIs */
+#define TEST_NO_OF_ROUNDS   100u
 #define OWN_IP              vos_dottedIP("10.0.1.101")
 #define DNS_SERVER          vos_dottedIP("10.0.1.1")
 
+#define TEST_LOOPBACK       0x7F000001u             /* 127.0.0.1, TCN-DNS stand-in in the same session */
+#define TEST_NO_OF_ASYNC    64u
+#define TEST_ASYNC_ADDR     0x0A020000u             /* devNNN.async.ltrn -> 10.2.0.NNN */
+#define TEST_UNKNOWN_URI    "nobody.async.ltrn"
+
+/*******************************************************************************
+ * LOCALS
+ */
+
+static UINT8            sDnsRequest[sizeof(TRDP_DNS_REQUEST_T)];
+static UINT8            sDnsReply[sizeof(TRDP_DNS_REPLY_T)];
+static TRDP_UUID_T      sDnsSessionId;
+static BOOL8            sDnsPending     = FALSE;
+static UINT32           sNoOfDnsRequests;
+static UINT32           sLastUriCnt;
+static UINT32           sNoOfAsyncDone;
+static TRDP_IP_ADDR_T   sAsyncAddr[TEST_NO_OF_ASYNC + 1u];
+static TRDP_ERR_T       sAsyncResult[TEST_NO_OF_ASYNC + 1u];
+
 /**********************************************************************************************************************/
 /** callback routine for TRDP logging/error output
  *
@@ -181,7 +210,11 @@ static int test_tau_init(
     
     /* Resolve some Uris */
     TRDP_IP_ADDR_T      ipAddr;
-    err = tau_uri2Addr(appHandle, &ipAddr, "berndsmac");
+    TRDP_URI_HOST_T     uri;
+
+    memset(uri, 0, sizeof(uri));
+    (void) snprintf(uri, sizeof(uri), "berndsmac");
+    err = tau_uri2Addr(appHandle, &ipAddr, uri);
     if (err != TRDP_NO_ERR)
     {
         printf("tau_uri2Addr: berndsmac not known\n");
@@ -193,7 +226,8 @@ static int test_tau_init(
         ret = 0;
     }
     
-    err = tau_uri2Addr(appHandle, &ipAddr, "devECSC.aveh.lCst.lclst.ltrn");
+    (void) snprintf(uri, sizeof(uri), "devECSC.aveh.lCst.lclst.ltrn");
+    err = tau_uri2Addr(appHandle, &ipAddr, uri);
     if (err != TRDP_NO_ERR)
     {
         printf("tau_uri2Addr: devECSC not known\n");
@@ -204,7 +238,8 @@ static int test_tau_init(
         printf("tau_uri2Addr returns: %s\n", vos_ipDotted(ipAddr));
         ret = 0;
     }
-    err = tau_uri2Addr(appHandle, &ipAddr, "raspi24");
+    (void) snprintf(uri, sizeof(uri), "raspi24");
+    err = tau_uri2Addr(appHandle, &ipAddr, uri);
     if (err != TRDP_NO_ERR)
     {
         printf("tau_uri2Addr: raspi24 not known\n");
@@ -216,7 +251,8 @@ static int test_tau_init(
         ret = 0;
     }
     
-    err = tau_uri2Addr(appHandle, &ipAddr, "zeus.newtec.zz");
+    (void) snprintf(uri, sizeof(uri), "zeus.newtec.zz");
+    err = tau_uri2Addr(appHandle, &ipAddr, uri);
     if (err != TRDP_NO_ERR)
     {
         printf("tau_uri2Addr: zeus.newtec.zz not known\n");
@@ -234,10 +270,351 @@ exit_label:
     return ret; /* all tests finished */
 }
 
+/**********************************************************************************************************************/
+/*  Resolve more URIs than the former fixed size cache could hold, check case insensitivity and reverse lookup      */
+
+static int test_tau_cache (void)
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_MEM_CONFIG_T       dynamicConfig   = {NULL, 0, {0}};
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"Me", "", 0, 0, TRDP_OPTION_BLOCK};
+    TRDP_IP_ADDR_T          ipAddr;
+    TRDP_URI_HOST_T         uri;
+    TRDP_URI_HOST_T         found;
+    TRDP_TIME_T             start, end;
+    FILE                    *fp;
+    UINT32                  i, j;
+    int                     ret = 1;
+
+    fp = fopen(TEST_HOSTSFILE, "w");
+    if (fp == NULL)
+    {
+        printf("*** cannot write %s\n", TEST_HOSTSFILE);
+        return 1;
+    }
+    fprintf(fp, "# generated by test_tau_dnr\n");
+    for (i = 0u; i < TEST_NO_OF_HOSTS; i++)
+    {
+        fprintf(fp, "10.%u.%u.1\tdev%03u.cst%02u.lclst.ltrn\n", i / 32u + 1u, i % 32u, i, i / 32u);
+    }
+    fclose(fp);
+
+    if (tlc_init(dbgOut, NULL, &dynamicConfig) != TRDP_NO_ERR)
+    {
+        printf("*** Initialization error\n");
+        return 1;
+    }
+    if (tlc_openSession(&appHandle, VOS_INADDR_ANY, 0, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR)
+    {
+        printf("*** openSession error\n");
+        tlc_terminate();
+        return 1;
+    }
+    if (tau_initDnr(appHandle, 0u, 0u, TEST_HOSTSFILE, TRDP_DNR_OWN_THREAD, FALSE) != TRDP_NO_ERR)
+    {
+        printf("*** tau_initDnr error\n");
+        goto exit_label;
+    }
+    if (tau_DNRstatus(appHandle) != TRDP_DNR_HOSTSFILE)
+    {
+        printf("*** tau_DNRstatus: hosts file not used\n");
+        goto exit_label;
+    }
+
+    vos_getTime(&start);
+    for (j = 0u; j < TEST_NO_OF_ROUNDS; j++)
+    {
+        for (i = 0u; i < TEST_NO_OF_HOSTS; i++)
+        {
+            /* every other URI in upper case */
+            (void) snprintf(uri, sizeof(uri), ((i & 1u) == 0u) ? "dev%03u.cst%02u.lclst.ltrn" : "DEV%03u.CST%02u.LCLST.LTRN",
+                            i, i / 32u);
+            if ((tau_uri2Addr(appHandle, &ipAddr, uri) != TRDP_NO_ERR) ||
+                (ipAddr != (((10u << 24u) | ((i / 32u + 1u) << 16u) | ((i % 32u) << 8u)) | 1u)))
+            {
+                printf("*** tau_uri2Addr: %s not resolved (%s)\n", uri, vos_ipDotted(ipAddr));
+                goto exit_label;
+            }
+        }
+    }
+    vos_getTime(&end);
+    vos_subTime(&end, &start);
+    printf("%u URIs resolved from cache, %.1f ns per lookup\n", TEST_NO_OF_HOSTS,
+           (end.tv_sec * 1e9 + end.tv_usec * 1e3) / (TEST_NO_OF_HOSTS * TEST_NO_OF_ROUNDS));
+
+    for (i = 0u; i < TEST_NO_OF_HOSTS; i += 37u)
+    {
+        (void) snprintf(uri, sizeof(uri), "dev%03u.cst%02u.lclst.ltrn", i, i / 32u);
+        ipAddr = (((10u << 24u) | ((i / 32u + 1u) << 16u) | ((i % 32u) << 8u)) | 1u);
+        memset(found, 0, sizeof(found));
+        if ((tau_addr2Uri(appHandle, found, ipAddr) != TRDP_NO_ERR) ||
+            (vos_strnicmp(found, uri, TRDP_MAX_URI_HOST_LEN) != 0))
+        {
+            printf("*** tau_addr2Uri: %s not found (%s)\n", vos_ipDotted(ipAddr), found);
+            goto exit_label;
+        }
+    }
+    ret = 0;
+
+exit_label:
+    tau_deInitDnr(appHandle);
+    tlc_closeSession(appHandle);
+    tlc_terminate();
+    (void) remove(TEST_HOSTSFILE);
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/*  TCN-DNS stand-in: the listener keeps the request, the test loop replies to it                                  */
+
+static void dnsResponder (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) pRefCon;
+    (void) appHandle;
+    if ((pMsg->msgType == TRDP_MSG_MR) && (pData != NULL) && (dataSize <= sizeof(sDnsRequest)))
+    {
+        memcpy(sDnsRequest, pData, dataSize);
+        memcpy(sDnsSessionId, pMsg->sessionId, sizeof(TRDP_UUID_T));
+        sLastUriCnt = ((TRDP_DNS_REQUEST_T *) sDnsRequest)->tcnUriCnt;
+        sNoOfDnsRequests++;
+        sDnsPending = TRUE;
+    }
+}
+
+static void dnsReply (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_DNS_REQUEST_T  *pReq = (TRDP_DNS_REQUEST_T *) sDnsRequest;
+    TRDP_DNS_REPLY_T    *pRep = (TRDP_DNS_REPLY_T *) sDnsReply;
+    UINT32              i, dev;
+
+    memset(sDnsReply, 0, sizeof(sDnsReply));
+    pRep->version       = pReq->version;
+    pRep->etbTopoCnt    = pReq->etbTopoCnt;
+    pRep->opTrnTopoCnt  = pReq->opTrnTopoCnt;
+    pRep->etbId         = pReq->etbId;
+    pRep->tcnUriCnt     = pReq->tcnUriCnt;
+    for (i = 0u; i < pReq->tcnUriCnt; i++)
+    {
+        memcpy(pRep->tcnUriList[i].tcnUriStr, pReq->tcnUriList[i].tcnUriStr, sizeof(pRep->tcnUriList[i].tcnUriStr));
+        if (sscanf(pReq->tcnUriList[i].tcnUriStr, "dev%u.async.ltrn", &dev) == 1)
+        {
+            pRep->tcnUriList[i].tcnUriIpAddr = vos_htonl(TEST_ASYNC_ADDR + dev);
+        }
+        else
+        {
+            pRep->tcnUriList[i].resolvState = -1;
+        }
+    }
+    sDnsPending = FALSE;
+    (void) tlm_reply(appHandle, (const TRDP_UUID_T *) &sDnsSessionId, TCN_DNS_REP_COMID, 0u, NULL, sDnsReply,
+                     sizeof(TRDP_DNS_REPLY_T) - (255u - pRep->tcnUriCnt) * sizeof(TCN_URI_T), NULL);
+}
+
+static void asyncDone (
+    void                *pRefCon,
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pUri,
+    TRDP_IP_ADDR_T      ipAddr,
+    TRDP_ERR_T          result)
+{
+    UINT32 i = (UINT32) (uintptr_t) pRefCon;
+
+    (void) appHandle;
+    (void) pUri;
+    sAsyncAddr[i]   = ipAddr;
+    sAsyncResult[i] = result;
+    sNoOfAsyncDone++;
+}
+
+/* Process MD and answer TCN-DNS requests until the counter reached the target, FALSE on timeout */
+static BOOL8 processUntil (TRDP_APP_SESSION_T appHandle, const UINT32 *pCounter, UINT32 target)
+{
+    UINT32 idle = 0u;
+
+    while ((*pCounter < target) && (idle < 1000u))
+    {
+        TRDP_FDS_T  rfds;
+        TRDP_TIME_T tv = {0, 0};
+        INT32       noDesc = 0;
+        INT32       rv;
+        UINT32      before = *pCounter;
+
+        FD_ZERO(&rfds);
+        (void) tlm_getInterval(appHandle, &tv, &rfds, &noDesc);
+        tv.tv_sec   = 0;
+        tv.tv_usec  = 1000;
+        rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+        (void) tlm_process(appHandle, &rfds, &rv);
+        if (sDnsPending == TRUE)
+        {
+            dnsReply(appHandle);
+        }
+        idle = (*pCounter == before) ? idle + 1u : 0u;
+    }
+    return (*pCounter >= target) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/*  Resolve without blocking: lookups queued while a request runs are batched into the next one, a topocount change
+    refreshes all cached URIs with one request                                                                      */
+
+static int test_tau_async (void)
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_LIS_T              listenHandle;
+    TRDP_MEM_CONFIG_T       dynamicConfig   = {NULL, 0, {0}};
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"Me", "", 0, 0, TRDP_OPTION_BLOCK};
+    TRDP_IP_ADDR_T          ipAddr;
+    TRDP_URI_HOST_T         uri;
+    TRDP_TIME_T             start, end;
+    UINT32                  i, done;
+    int                     ret = 1;
+
+    if (tlc_init(dbgOut, NULL, &dynamicConfig) != TRDP_NO_ERR)
+    {
+        printf("*** Initialization error\n");
+        return 1;
+    }
+    if (tlc_openSession(&appHandle, TEST_LOOPBACK, 0, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR)
+    {
+        printf("*** openSession error\n");
+        tlc_terminate();
+        return 1;
+    }
+    if ((tau_initDnr(appHandle, TEST_LOOPBACK, 0u, NULL, TRDP_DNR_COMMON_THREAD, FALSE) != TRDP_NO_ERR) ||
+        (tlm_addListener(appHandle, &listenHandle, NULL, dnsResponder, TRUE, TCN_DNS_REQ_COMID, 0u, 0u,
+                         VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL, NULL) != TRDP_NO_ERR))
+    {
+        printf("*** tau_initDnr / tlm_addListener error\n");
+        goto exit_label;
+    }
+    (void) tlc_setETBTopoCount(appHandle, 0x1000u);
+
+    /* Nothing may block: the first URI is sent at once, the others wait for its reply */
+    memset(uri, 0, sizeof(uri));
+    vos_getTime(&start);
+    for (i = 0u; i <= TEST_NO_OF_ASYNC; i++)
+    {
+        if (i < TEST_NO_OF_ASYNC)
+        {
+            (void) snprintf(uri, sizeof(uri), "dev%03u.async.ltrn", i);
+        }
+        else
+        {
+            (void) snprintf(uri, sizeof(uri), "%s", TEST_UNKNOWN_URI);
+        }
+        if (tau_uri2AddrAsync(appHandle, uri, asyncDone, (void *) (uintptr_t) i) != TRDP_NO_ERR)
+        {
+            printf("*** tau_uri2AddrAsync failed\n");
+            goto exit_label;
+        }
+    }
+    vos_getTime(&end);
+    vos_subTime(&end, &start);
+    printf("%u lookups queued in %u us\n", TEST_NO_OF_ASYNC + 1u, (UINT32) (end.tv_sec * 1000000u + end.tv_usec));
+    if (sNoOfAsyncDone != 0u)
+    {
+        printf("*** lookups completed before any reply\n");
+        goto exit_label;
+    }
+    if ((processUntil(appHandle, &sNoOfAsyncDone, TEST_NO_OF_ASYNC + 1u) == FALSE) || (sNoOfDnsRequests != 2u))
+    {
+        printf("*** %u of %u lookups completed with %u requests (expected 2)\n",
+               sNoOfAsyncDone, TEST_NO_OF_ASYNC + 1u, sNoOfDnsRequests);
+        goto exit_label;
+    }
+    for (i = 0u; i < TEST_NO_OF_ASYNC; i++)
+    {
+        if ((sAsyncResult[i] != TRDP_NO_ERR) || (sAsyncAddr[i] != TEST_ASYNC_ADDR + i))
+        {
+            printf("*** lookup %u: %s (Err: %d)\n", i, vos_ipDotted(sAsyncAddr[i]), sAsyncResult[i]);
+            goto exit_label;
+        }
+    }
+    if (sAsyncResult[TEST_NO_OF_ASYNC] != TRDP_UNRESOLVED_ERR)
+    {
+        printf("*** %s resolved (Err: %d)\n", TEST_UNKNOWN_URI, sAsyncResult[TEST_NO_OF_ASYNC]);
+        goto exit_label;
+    }
+
+    /* A cache hit calls back at once */
+    done = sNoOfAsyncDone;
+    (void) snprintf(uri, sizeof(uri), "DEV007.async.ltrn");
+    (void) tau_uri2AddrAsync(appHandle, uri, asyncDone, (void *) (uintptr_t) 7u);
+    if ((sNoOfAsyncDone != done + 1u) || (sAsyncAddr[7] != TEST_ASYNC_ADDR + 7u))
+    {
+        printf("*** cache hit did not call back at once\n");
+        goto exit_label;
+    }
+
+    /* After a topocount change the next lookup refreshes all of them */
+    (void) tlc_setETBTopoCount(appHandle, 0x2000u);
+    done = sNoOfAsyncDone;
+    (void) snprintf(uri, sizeof(uri), "dev000.async.ltrn");
+    (void) tau_uri2AddrAsync(appHandle, uri, asyncDone, (void *) (uintptr_t) 0u);
+    if ((processUntil(appHandle, &sNoOfAsyncDone, done + 1u) == FALSE) ||
+        (sNoOfDnsRequests != 3u) || (sLastUriCnt != TEST_NO_OF_ASYNC))
+    {
+        printf("*** refresh: %u requests, %u URIs asked (expected 3, %u)\n",
+               sNoOfDnsRequests, sLastUriCnt, TEST_NO_OF_ASYNC);
+        goto exit_label;
+    }
+    (void) snprintf(uri, sizeof(uri), "dev063.async.ltrn");
+    if ((tau_uri2Addr(appHandle, &ipAddr, uri) != TRDP_NO_ERR) ||
+        (ipAddr != TEST_ASYNC_ADDR + 63u) || (sNoOfDnsRequests != 3u))
+    {
+        printf("*** dev063 not prefetched\n");
+        goto exit_label;
+    }
+    printf("%u lookups resolved with %u TCN-DNS requests\n", sNoOfAsyncDone, sNoOfDnsRequests);
+
+    /* A standard DNS query would block, asynchronous lookups are refused without calling back */
+    tau_deInitDnr(appHandle);
+    done = sNoOfAsyncDone;
+    if ((tau_initDnr(appHandle, TEST_LOOPBACK, 0u, NULL, TRDP_DNR_STANDARD_DNS, FALSE) != TRDP_NO_ERR) ||
+        (tau_uri2AddrAsync(appHandle, uri, asyncDone, (void *) (uintptr_t) 0u) != TRDP_PARAM_ERR) ||
+        (sNoOfAsyncDone != done))
+    {
+        printf("*** tau_uri2AddrAsync accepted with standard DNS\n");
+        goto exit_label;
+    }
+    ret = 0;
+
+exit_label:
+    tau_deInitDnr(appHandle);
+    tlc_closeSession(appHandle);
+    tlc_terminate();
+    return ret;
+}
+
 /**********************************************************************************************************************/
 
 int main(int argc, char *argv[])
 {
+    printf("Starting test_tau_cache\n");
+    if (test_tau_cache())
+    {
+        printf("*** tau_cache test failed\n");
+        return 1;
+    }
+    printf("Starting test_tau_async\n");
+    if (test_tau_async())
+    {
+        printf("*** tau_async test failed\n");
+        return 1;
+    }
+    if ((argc > 1) && (strcmp(argv[1], "-l") == 0))
+    {
+        printf("All local tests successfully finished.\n");
+        return 0;
+    }
+
     printf("Starting test_tau_init\n");
     if (test_tau_init(OWN_IP, DNS_SERVER))
     {
@@ -0,0 +1,428 @@
+/******************************************************************************/
+/**
+ * @file            test_tau_so_if.c
+ *
+ * @brief           Test of the service cache and the batched service requests of tau_so_if
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          B. Loehr
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *      AG 2026-10-17: Service cache and batched add/delete against an SRM stand-in on the loopback interface
+ *
+ */
+
+/*******************************************************************************
+ * INCLUDES
+ */
+
+#if (defined (WIN32) || defined (WIN64))
+#include <winsock2.h>
+#elif POSIX
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/select.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trdp_if_light.h"
+#include "tau_dnr.h"
+#include "tau_so_if.h"
+#include "vos_sock.h"
+#include "vos_utils.h"
+
+/*******************************************************************************
+ * DEFINES
+ */
+
+#define TEST_HOSTSFILE      "test_tau_so_if_hosts"
+#define TEST_NO_OF_SRV      150u                    /* services of the consist controller */
+#define TEST_NO_OF_BULK     1500u                   /* more than one request telegram holds */
+#define TEST_TYPE_ID        10000u                  /* service n has the type 10000 + n */
+
+/*******************************************************************************
+ * LOCALS
+ */
+
+typedef struct
+{
+    UINT32  noOfRequests;                           /* requests received by the SRM stand-in */
+    UINT32  noOfEntries;                            /* entries of all requests */
+    UINT32  firstServiceId;                         /* first entry of the last request */
+    UINT8   cstCnt;                                 /* of the last SRV_INFO_REQ */
+} SRM_COUNT_T;
+
+static SRM_COUNT_T          sAdd, sDel, sRead, sSrvInfoReq;
+static UINT8                sSrvInfo[sizeof(SRM_CST_SRV_INFO_T) + 512u * sizeof(SRM_SERVICE_INFO_T)];
+static SRM_SERVICE_INFO_T   sServices[TEST_NO_OF_BULK];
+
+/**********************************************************************************************************************/
+/** callback routine for TRDP logging/error output
+ *
+ *  @param[in]      pRefCon         user supplied context pointer
+ *  @param[in]      category        Log category (Error, Warning, Info etc.)
+ *  @param[in]      pTime           pointer to NULL-terminated string of time stamp
+ *  @param[in]      pFile           pointer to NULL-terminated string of source module
+ *  @param[in]      LineNumber      line
+ *  @param[in]      pMsgStr         pointer to NULL-terminated string
+ *  @retval         none
+ */
+void dbgOut (
+             void        *pRefCon,
+             TRDP_LOG_T  category,
+             const CHAR8 *pTime,
+             const CHAR8 *pFile,
+             UINT16      LineNumber,
+             const CHAR8 *pMsgStr)
+{
+    const char *catStr[] = {"**Error:", "Warning:", "   Info:", "  Debug:", "   User:"};
+
+    (void) pRefCon;
+    if (category != VOS_LOG_DBG)
+    {
+        CHAR8 *pStr = (strrchr(pFile, '/') == NULL)? strrchr(pFile, '\\') + 1 : strrchr(pFile, '/') + 1;
+        printf("%s %s %s:%d %s",
+               pTime,
+               catStr[category],
+               (pStr == NULL ? pFile : pStr),
+               LineNumber,
+               pMsgStr);
+    }
+}
+
+/**********************************************************************************************************************/
+/*  SRM stand-in: count the requests and their entries, nothing is answered                                          */
+
+static void srmListener (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    SRM_COUNT_T *pCount = (SRM_COUNT_T *) pMsg->pUserRef;
+
+    (void) pRefCon;
+    (void) appHandle;
+    if ((pCount == NULL) || (pMsg->resultCode != TRDP_NO_ERR) ||
+        ((pMsg->msgType != TRDP_MSG_MR) && (pMsg->msgType != TRDP_MSG_MN)))
+    {
+        return;
+    }
+    pCount->noOfRequests++;
+    if (pMsg->comId == SRM_SRV_REQ_NOTIFY_COMID)
+    {
+        pCount->cstCnt = ((pData != NULL) && (dataSize >= sizeof(SRM_SRV_INFO_REQ_T))) ?
+            ((SRM_SRV_INFO_REQ_T *) pData)->cstCnt : 0u;
+    }
+    else if ((pData != NULL) && (dataSize >= sizeof(SRM_SERVICE_ENTRIES_T)))
+    {
+        SRM_SERVICE_ENTRIES_T *pEntries = (SRM_SERVICE_ENTRIES_T *) pData;
+
+        pCount->noOfEntries     += vos_ntohs(pEntries->noOfEntries);
+        pCount->firstServiceId  = vos_ntohl(pEntries->serviceEntry[0].serviceId);
+    }
+}
+
+/* Service n of consist cstNo in host representation */
+static void makeService (SRM_SERVICE_INFO_T *pSrv, UINT8 cstNo, UINT32 n)
+{
+    memset(pSrv, 0, sizeof(SRM_SERVICE_INFO_T));
+    (void) snprintf(pSrv->srvName, sizeof(pSrv->srvName), "srv%u", n);
+    (void) snprintf(pSrv->fctDev, sizeof(pSrv->fctDev), "dev%u.cst%u", n % 8u, cstNo);
+    pSrv->serviceId     = SOA_SERVICEID((UINT32) cstNo, TEST_TYPE_ID + n);
+    pSrv->srvVers.ver   = 1u;
+    pSrv->cstNo         = cstNo;
+    pSrv->cstVehNo      = (UINT8) (n % 4u + 1u);
+    pSrv->addInfo[0]    = n;
+}
+
+/* Service list of consist cstNo in network representation: services first..first+cnt-1 */
+static UINT32 makeSrvInfo (UINT8 cstNo, UINT32 srvTopoCnt, UINT32 first, UINT32 cnt, UINT8 srvFlags)
+{
+    SRM_CST_SRV_INFO_T  *pInfo = (SRM_CST_SRV_INFO_T *) sSrvInfo;
+    UINT32              i;
+
+    memset(sSrvInfo, 0, sizeof(sSrvInfo));
+    pInfo->version.ver  = 1u;
+    pInfo->cstClass     = 1u;
+    memset(pInfo->cstUUID, cstNo, sizeof(pInfo->cstUUID));
+    pInfo->trnTopoCnt   = vos_htonl(1u);
+    pInfo->srvTopoCnt   = vos_htonl(srvTopoCnt);
+    pInfo->srvCnt       = vos_htons((UINT16) cnt);
+    for (i = 0u; i < cnt; i++)
+    {
+        SRM_SERVICE_INFO_T srv;
+
+        makeService(&srv, cstNo, first + i);
+        srv.srvFlags = srvFlags;
+        srv.serviceId   = vos_htonl(srv.serviceId);
+        srv.addInfo[0]  = vos_htonl(srv.addInfo[0]);
+        memcpy(&pInfo->srvInfoList[i], &srv, sizeof(srv));
+    }
+    return sizeof(SRM_CST_SRV_INFO_T) + cnt * sizeof(SRM_SERVICE_INFO_T);
+}
+
+/* Process MD for a millisecond */
+static void processOnce (TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_FDS_T  rfds;
+    TRDP_TIME_T tv = {0, 0};
+    INT32       noDesc = 0;
+    INT32       rv;
+
+    FD_ZERO(&rfds);
+    (void) tlm_getInterval(appHandle, &tv, &rfds, &noDesc);
+    tv.tv_sec   = 0;
+    tv.tv_usec  = 1000;
+    rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+    (void) tlm_process(appHandle, &rfds, &rv);
+}
+
+/* Process MD until the count reached the target */
+static BOOL8 processUntil (TRDP_APP_SESSION_T appHandle, const UINT32 *pCount, UINT32 target)
+{
+    UINT32 i;
+
+    for (i = 0u; (*pCount < target) && (i < 1000u); i++)
+    {
+        processOnce(appHandle);
+    }
+    return (*pCount >= target) ? TRUE : FALSE;
+}
+
+/* Send a service list as its SRM would and process MD until the cache version reached the target */
+static BOOL8 sendSrvInfo (TRDP_APP_SESSION_T appHandle, UINT32 dataSize, UINT32 version)
+{
+    UINT32 i;
+
+    if (tlm_notify(appHandle, NULL, NULL, SRM_SRVINFO_NOTIFY_COMID, 0u, 0u, VOS_INADDR_ANY,
+                   vos_dottedIP("127.0.0.1"), TRDP_FLAGS_NONE, NULL, sSrvInfo, dataSize, NULL, NULL) != TRDP_NO_ERR)
+    {
+        return FALSE;
+    }
+    for (i = 0u; (tau_getSrvCacheVersion(appHandle) < version) && (i < 1000u); i++)
+    {
+        processOnce(appHandle);
+    }
+    return (tau_getSrvCacheVersion(appHandle) == version) ? TRUE : FALSE;
+}
+
+/* Services first..first+cnt-1 of consist cstNo are cached, the list holds noOfServices */
+static BOOL8 checkCache (TRDP_APP_SESSION_T appHandle, UINT8 cstNo, UINT32 first, UINT32 cnt, UINT32 noOfServices)
+{
+    SRM_SERVICE_ENTRIES_T   *pList = NULL;
+    SRM_SERVICE_INFO_T      srv;
+    UINT32                  noOfListed = 0u;
+    UINT32                  i;
+    BOOL8                   ok = TRUE;
+
+    for (i = first; (i < first + cnt) && (ok == TRUE); i++)
+    {
+        ok = ((tau_getCachedService(appHandle, SOA_SERVICEID((UINT32) cstNo, TEST_TYPE_ID + i), &srv) == TRDP_NO_ERR) &&
+              (srv.addInfo[0] == i) && (srv.cstNo == cstNo) && (strncmp(srv.fctDev, "dev", 3u) == 0)) ? TRUE : FALSE;
+    }
+    if ((ok == TRUE) &&
+        ((tau_getServicesList(appHandle, &pList, &noOfListed, NULL) != TRDP_NO_ERR) ||
+         (pList == NULL) || (noOfListed != noOfServices) || (pList->noOfEntries != noOfServices)))
+    {
+        ok = FALSE;
+    }
+    if (pList != NULL)
+    {
+        tau_freeServicesList(pList);
+    }
+    if (ok == FALSE)
+    {
+        printf("*** cst%u services %u..%u: %u of %u listed\n", cstNo, first, first + cnt - 1u, noOfListed,
+               noOfServices);
+    }
+    return ok;
+}
+
+/**********************************************************************************************************************/
+/*  The service cache follows the consist service lists by their srvTopoCnt, lists are served without a request and
+    many services are added or deleted with one request                                                             */
+
+static int test_tau_srvCache (void)
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_LIS_T              listenHandle[4];
+    TRDP_MEM_CONFIG_T       dynamicConfig   = {NULL, 0, {0}};
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"Me", "", 0, 0, TRDP_OPTION_BLOCK};
+    SRM_SERVICE_INFO_T      srv;
+    UINT32                  i, version;
+    FILE                    *fp;
+    int                     ret = 1;
+
+    fp = fopen(TEST_HOSTSFILE, "w");
+    if (fp == NULL)
+    {
+        printf("*** cannot write %s\n", TEST_HOSTSFILE);
+        return 1;
+    }
+    fprintf(fp, "127.0.0.1\t%s\n", SRM_SERVICE_ADD_REQ_URI);
+    fprintf(fp, "127.0.0.1\t%s\n", SRM_SRVINFO_NOTIFY_URI);
+    fclose(fp);
+
+    if (tlc_init(dbgOut, NULL, &dynamicConfig) != TRDP_NO_ERR)
+    {
+        printf("*** Initialization error\n");
+        return 1;
+    }
+    if (tlc_openSession(&appHandle, VOS_INADDR_ANY, 0, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR)
+    {
+        printf("*** openSession error\n");
+        tlc_terminate();
+        return 1;
+    }
+    if ((tau_initDnr(appHandle, 0u, 0u, TEST_HOSTSFILE, TRDP_DNR_COMMON_THREAD, FALSE) != TRDP_NO_ERR) ||
+        (tlm_addListener(appHandle, &listenHandle[0], &sAdd, srmListener, TRUE, SRM_SERVICE_ADD_REQ_COMID, 0u, 0u,
+                         VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL, NULL) != TRDP_NO_ERR) ||
+        (tlm_addListener(appHandle, &listenHandle[1], &sDel, srmListener, TRUE, SRM_SERVICE_DEL_REQ_COMID, 0u, 0u,
+                         VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL, NULL) != TRDP_NO_ERR) ||
+        (tlm_addListener(appHandle, &listenHandle[2], &sRead, srmListener, TRUE, SRM_SERVICE_READ_REQ_COMID, 0u, 0u,
+                         VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL, NULL) != TRDP_NO_ERR) ||
+        (tlm_addListener(appHandle, &listenHandle[3], &sSrvInfoReq, srmListener, TRUE, SRM_SRV_REQ_NOTIFY_COMID,
+                         0u, 0u, VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL,
+                         NULL) != TRDP_NO_ERR))
+    {
+        printf("*** tau_initDnr / tlm_addListener error\n");
+        goto exit_label;
+    }
+
+    /* Without a train directory all consists are asked for their lists */
+    if ((tau_initSrvCache(appHandle) != TRDP_NO_ERR) ||
+        (processUntil(appHandle, &sSrvInfoReq.noOfRequests, 1u) == FALSE) ||
+        (sSrvInfoReq.cstCnt != 255u) || (tau_getSrvCacheVersion(appHandle) != 0u))
+    {
+        printf("*** tau_initSrvCache: %u service info requests, cstCnt %u\n", sSrvInfoReq.noOfRequests,
+               sSrvInfoReq.cstCnt);
+        goto exit_label;
+    }
+    if (tau_getCachedService(appHandle, SOA_SERVICEID(1u, TEST_TYPE_ID), &srv) != TRDP_NODATA_ERR)
+    {
+        printf("*** service cached before any list was received\n");
+        goto exit_label;
+    }
+
+    /* Complete lists of two consists */
+    if ((sendSrvInfo(appHandle, makeSrvInfo(1u, 100u, 0u, TEST_NO_OF_SRV, 0u), 1u) == FALSE) ||
+        (sendSrvInfo(appHandle, makeSrvInfo(2u, 200u, 0u, 20u, 0u), 2u) == FALSE) ||
+        (checkCache(appHandle, 1u, 0u, TEST_NO_OF_SRV, TEST_NO_OF_SRV + 20u) == FALSE) ||
+        (checkCache(appHandle, 2u, 0u, 20u, TEST_NO_OF_SRV + 20u) == FALSE))
+    {
+        printf("*** complete service lists not cached (version %u)\n", tau_getSrvCacheVersion(appHandle));
+        goto exit_label;
+    }
+
+    /* An unchanged srvTopoCnt is skipped: only the list of cst2 sent afterwards counts */
+    version = tau_getSrvCacheVersion(appHandle);
+    (void) makeSrvInfo(1u, 100u, 0u, 10u, 0u);
+    if ((tlm_notify(appHandle, NULL, NULL, SRM_SRVINFO_NOTIFY_COMID, 0u, 0u, VOS_INADDR_ANY,
+                    vos_dottedIP("127.0.0.1"), TRDP_FLAGS_NONE, NULL, sSrvInfo,
+                    sizeof(SRM_CST_SRV_INFO_T) + 10u * sizeof(SRM_SERVICE_INFO_T), NULL, NULL) != TRDP_NO_ERR) ||
+        (sendSrvInfo(appHandle, makeSrvInfo(2u, 201u, 0u, 20u, 0u), version + 1u) == FALSE) ||
+        (checkCache(appHandle, 1u, 0u, TEST_NO_OF_SRV, TEST_NO_OF_SRV + 20u) == FALSE))
+    {
+        printf("*** unchanged service list processed\n");
+        goto exit_label;
+    }
+
+    /* Update list: the last 10 services of cst1 are deleted, one more is added */
+    version = tau_getSrvCacheVersion(appHandle);
+    if ((sendSrvInfo(appHandle, makeSrvInfo(1u, 101u, TEST_NO_OF_SRV - 10u, 10u, 0x18u), version + 1u) == FALSE) ||
+        (sendSrvInfo(appHandle, makeSrvInfo(1u, 102u, TEST_NO_OF_SRV, 1u, 0x08u), version + 2u) == FALSE) ||
+        (checkCache(appHandle, 1u, 0u, TEST_NO_OF_SRV - 10u, TEST_NO_OF_SRV - 9u + 20u) == FALSE) ||
+        (checkCache(appHandle, 1u, TEST_NO_OF_SRV, 1u, TEST_NO_OF_SRV - 9u + 20u) == FALSE) ||
+        (tau_getCachedService(appHandle, SOA_SERVICEID(1u, TEST_TYPE_ID + TEST_NO_OF_SRV - 1u), &srv) !=
+         TRDP_NODATA_ERR))
+    {
+        printf("*** update list not applied\n");
+        goto exit_label;
+    }
+
+    /* A complete list replaces the services of its consist only */
+    version = tau_getSrvCacheVersion(appHandle);
+    if ((sendSrvInfo(appHandle, makeSrvInfo(1u, 103u, 100u, 50u, 0u), version + 1u) == FALSE) ||
+        (checkCache(appHandle, 1u, 100u, 50u, 50u + 20u) == FALSE) ||
+        (checkCache(appHandle, 2u, 0u, 20u, 50u + 20u) == FALSE) ||
+        (tau_getCachedService(appHandle, SOA_SERVICEID(1u, TEST_TYPE_ID), &srv) != TRDP_NODATA_ERR))
+    {
+        printf("*** complete list did not replace the cached one\n");
+        goto exit_label;
+    }
+    if (sRead.noOfRequests != 0u)
+    {
+        printf("*** %u read requests sent, lists should come from the cache\n", sRead.noOfRequests);
+        goto exit_label;
+    }
+
+    /* All services of the consist controller with one request each */
+    for (i = 0u; i < TEST_NO_OF_BULK; i++)
+    {
+        makeService(&sServices[i], 0u, i);
+    }
+    if ((tau_addServices(appHandle, sServices, TEST_NO_OF_SRV, FALSE) != TRDP_NO_ERR) ||
+        (tau_delServices(appHandle, sServices, TEST_NO_OF_SRV, FALSE) != TRDP_NO_ERR) ||
+        (processUntil(appHandle, &sAdd.noOfRequests, 1u) == FALSE) ||
+        (processUntil(appHandle, &sDel.noOfRequests, 1u) == FALSE) ||
+        (sAdd.noOfEntries != TEST_NO_OF_SRV) || (sDel.noOfEntries != TEST_NO_OF_SRV) ||
+        (sAdd.firstServiceId != SOA_SERVICEID(0u, TEST_TYPE_ID)))
+    {
+        printf("*** %u services added with %u requests, %u deleted with %u requests\n", sAdd.noOfEntries,
+               sAdd.noOfRequests, sDel.noOfEntries, sDel.noOfRequests);
+        goto exit_label;
+    }
+
+    /* Too many for one telegram: split into two requests */
+    if ((tau_addServices(appHandle, sServices, TEST_NO_OF_BULK, FALSE) != TRDP_NO_ERR) ||
+        (processUntil(appHandle, &sAdd.noOfRequests, 3u) == FALSE) ||
+        (sAdd.noOfEntries != TEST_NO_OF_SRV + TEST_NO_OF_BULK) ||
+        (sAdd.firstServiceId == SOA_SERVICEID(0u, TEST_TYPE_ID)))
+    {
+        printf("*** %u services added with %u requests\n", sAdd.noOfEntries - TEST_NO_OF_SRV,
+               sAdd.noOfRequests - 1u);
+        goto exit_label;
+    }
+    if ((tau_addServices(appHandle, sServices, 0u, FALSE) != TRDP_PARAM_ERR) ||
+        (tau_addServices(appHandle, NULL, 1u, FALSE) != TRDP_PARAM_ERR))
+    {
+        printf("*** parameter check failed\n");
+        goto exit_label;
+    }
+    printf("%u services registered with one request, %u with %u requests\n", TEST_NO_OF_SRV, TEST_NO_OF_BULK,
+           sAdd.noOfRequests - 1u);
+    ret = 0;
+
+exit_label:
+    tau_deInitSrvCache(appHandle);
+    tau_deInitDnr(appHandle);
+    tlc_closeSession(appHandle);
+    tlc_terminate();
+    return ret;
+}
+
+/**********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    if (test_tau_srvCache() != 0)
+    {
+        printf("*** service cache test failed\n");
+        return 1;
+    }
+    printf("All tests successfully finished.\n");
+    return 0;
+}
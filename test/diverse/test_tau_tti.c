@@ -14,6 +14,11 @@
  *
  * $Id: test_tau_tti.c 1933 2019-07-05 15:40:19Z bloehr $
  *
+ *      AG 2026-10-17: Vehicle and function lookups with labels in TRDP_LABEL_T buffers
+ *      AG 2026-10-17: Consist label passed in a TRDP_LABEL_T buffer
+ *      AG 2026-10-17: New train directory fetches the changed consists only, in parallel
+ *      AG 2026-10-17: Consist info lookup test against an ECSP stand-in on the loopback interface
+ *
  */
 
 /*******************************************************************************
@@ -21,7 +26,7 @@
  */
 
 
-#ifdef defined (WIN32) || defined (WIN64)
+#if (defined (WIN32) || defined (WIN64))
 // include also stuff, needed for window
 //#include "stdafx.h"
 #include <winsock2.h>
@@ -40,6 +45,8 @@
 #include "trdp_if_light.h"
 #include "tau_tti.h"
 #include "tau_dnr.h"
+#include "vos_sock.h"
+#include "vos_utils.h"
 
 /*******************************************************************************
  * DEFINES
@@ -49,6 +56,31 @@
 #define RESERVED_MEMORY  100000
 
 #define PATH_TO_HOSTSFILE   "hosts_example"
+#define TEST_HOSTSFILE      "test_tau_tti_hosts"
+#define TEST_NO_OF_VEH      4u
+#define TEST_NO_OF_FCT      40u
+#define TEST_FCT_ID         100u                    /* fctNNN has the ID 100 + NNN */
+#define TEST_NO_OF_ROUNDS   100000u
+#define TEST_MAX_PENDING    8u
+
+/*******************************************************************************
+ * LOCALS
+ */
+
+typedef struct
+{
+    TRDP_UUID_T sessionId;
+    UINT32      comId;
+    UINT8       cstNo;                              /* from the requested UUID, 0 = none given */
+} ECSP_REQUEST_T;
+
+static UINT8            sCstInfo[2048];
+static UINT8            sTrnDir[sizeof(TRDP_TRAIN_DIR_T)];
+static ECSP_REQUEST_T   sEcspRequest[TEST_MAX_PENDING];
+static UINT32           sNoOfPending;
+static UINT32           sMaxPending;                /* most consist info requests seen in flight at once */
+static UINT32           sNoOfCstRequests;
+static UINT32           sNoOfAnonymous;             /* n-th request without UUID gets consist n */
 
 /**********************************************************************************************************************/
 /** callback routine for TRDP logging/error output
@@ -97,6 +129,394 @@ void printSizes()
     printf("TRDP_TRAIN_NET_DIR_T: %lu\n", sizeof(TRDP_TRAIN_NET_DIR_T));
 }
 
+/**********************************************************************************************************************/
+/*  ECSP stand-in: the listener keeps the consist info request, the test loop replies to it                          */
+
+static void ecspResponder (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) pRefCon;
+    (void) appHandle;
+    if ((pMsg->msgType == TRDP_MSG_MR) && (sNoOfPending < TEST_MAX_PENDING))
+    {
+        ECSP_REQUEST_T *pReq = &sEcspRequest[sNoOfPending++];
+
+        memcpy(pReq->sessionId, pMsg->sessionId, sizeof(TRDP_UUID_T));
+        pReq->comId = pMsg->comId;
+        pReq->cstNo = ((pData != NULL) && (dataSize >= sizeof(TRDP_UUID_T))) ? pData[0] : 0u;
+        if (pMsg->comId == TTDB_STAT_CST_REQ_COMID)
+        {
+            sNoOfCstRequests++;
+            sMaxPending = (sNoOfPending > sMaxPending) ? sNoOfPending : sMaxPending;
+        }
+    }
+}
+
+static UINT8 *put16 (UINT8 *p, UINT16 val)
+{
+    *p++ = (UINT8) (val >> 8u);
+    *p++ = (UINT8) val;
+    return p;
+}
+
+static UINT8 *putLabel (UINT8 *p, const CHAR8 *pLabel)
+{
+    memset(p, 0, TRDP_MAX_LABEL_LEN);
+    strncpy((char *) p, pLabel, TRDP_MAX_LABEL_LEN);
+    return p + TRDP_MAX_LABEL_LEN;
+}
+
+/* Consist info telegram in network representation, consist n has the UUID n and the label cstN */
+static UINT32 makeCstInfo (UINT8 n)
+{
+    UINT8   *p = sCstInfo;
+    CHAR8   label[TRDP_MAX_LABEL_LEN + 1];
+    UINT32  i;
+
+    memset(sCstInfo, 0, sizeof(sCstInfo));
+    *p++    = 1u;                                   /* version */
+    *p++    = 0u;
+    *p++    = 1u;                                   /* cstClass */
+    *p++    = 0u;
+    (void) snprintf(label, sizeof(label), "cst%u", n);
+    p       = putLabel(p, label);
+    p       = putLabel(p, "testType");
+    p       = putLabel(p, "tcnopen.org");
+    memset(p, n, sizeof(TRDP_UUID_T));
+    p       += sizeof(TRDP_UUID_T) + 4u;            /* cstUUID, reserved02 */
+    p       += 2u;                                  /* cstProp.ver */
+    p       = put16(p, 0u);                         /* cstProp.len */
+    p       += 2u;                                  /* reserved03 */
+    p       = put16(p, 1u);                         /* etbCnt */
+    *p++    = 0u;                                   /* etbId */
+    *p++    = 1u;                                   /* cnCnt */
+    p       += 2u;
+    p       += 2u;                                  /* reserved04 */
+    p       = put16(p, TEST_NO_OF_VEH);
+    for (i = 0u; i < TEST_NO_OF_VEH; i++)
+    {
+        (void) snprintf(label, sizeof(label), "veh%u.%u", n, i + 1u);
+        p       = putLabel(p, label);
+        p       = putLabel(p, "testVeh");
+        *p++    = 1u;                               /* vehOrient */
+        *p++    = (UINT8) (i + 1u);                 /* cstVehNo */
+        *p++    = 1u;                               /* tractVeh */
+        *p++    = 0u;
+        p       += 2u;                              /* vehProp.ver */
+        p       = put16(p, (i == 1u) ? 8u : 0u);    /* vehicle 2 carries properties */
+        p       += (i == 1u) ? 8u : 0u;
+    }
+    p       += 2u;                                  /* reserved05 */
+    p       = put16(p, TEST_NO_OF_FCT);
+    for (i = 0u; i < TEST_NO_OF_FCT; i++)
+    {
+        (void) snprintf(label, sizeof(label), "fct%03u", i);
+        p       = putLabel(p, label);
+        p       = put16(p, (UINT16) (TEST_FCT_ID + i));
+        *p++    = 0u;                               /* grp */
+        *p++    = 0u;
+        *p++    = (UINT8) (i % TEST_NO_OF_VEH + 1u);    /* cstVehNo */
+        *p++    = 0u;                               /* etbId */
+        *p++    = 0u;                               /* cnId */
+        *p++    = 0u;
+    }
+    p       += 2u;                                  /* reserved06 */
+    p       = put16(p, 0u);                         /* cltrCstCnt */
+    i       = vos_sc32(0xFFFFFFFF, sCstInfo, (UINT32) (p - sCstInfo));
+    i       = (i == 0u) ? 0xFFFFFFFF : i;
+    p       = put16(p, (UINT16) (i >> 16u));        /* cstTopoCnt */
+    p       = put16(p, (UINT16) i);
+    return (UINT32) (p - sCstInfo);
+}
+
+/* Consist topocount of consist n */
+static UINT32 cstTopoCnt (UINT8 n)
+{
+    UINT8 *p = sCstInfo + makeCstInfo(n) - sizeof(UINT32);
+
+    return ((UINT32) p[0] << 24u) | ((UINT32) p[1] << 16u) | ((UINT32) p[2] << 8u) | p[3];
+}
+
+/* Train directory telegram: cst1 unchanged, cst2 with a new cstTopoCnt, cst3 coupled */
+static UINT32 makeTrnDir (void)
+{
+    UINT8   *p = sTrnDir;
+    UINT8   n;
+
+    memset(sTrnDir, 0, sizeof(sTrnDir));
+    *p++    = 1u;                                   /* version */
+    *p++    = 0u;
+    *p++    = 1u;                                   /* etbId */
+    *p++    = 3u;                                   /* cstCnt */
+    for (n = 1u; n <= 3u; n++)
+    {
+        UINT32 topoCnt = cstTopoCnt(n) ^ ((n == 2u) ? 1u : 0u);
+
+        memset(p, n, sizeof(TRDP_UUID_T));
+        p       += sizeof(TRDP_UUID_T);
+        p       = put16(p, (UINT16) (topoCnt >> 16u));
+        p       = put16(p, (UINT16) topoCnt);
+        *p++    = n;                                /* trnCstNo */
+        *p++    = 1u;                               /* cstOrient */
+        p       += 2u;
+    }
+    p = put16(p, 0u);                               /* trnTopoCnt */
+    p = put16(p, 1u);
+    return (UINT32) (p - sTrnDir);
+}
+
+/* Answer the pending requests. Consist info requests are held back a while to see how many run in parallel */
+static void ecspReply (TRDP_APP_SESSION_T appHandle, BOOL8 force)
+{
+    UINT32 i;
+
+    if ((sNoOfPending == 0u) || ((sNoOfPending < 2u) && (force == FALSE) &&
+                                 (sEcspRequest[0].comId == TTDB_STAT_CST_REQ_COMID)))
+    {
+        return;
+    }
+    for (i = 0u; i < sNoOfPending; i++)
+    {
+        ECSP_REQUEST_T *pReq = &sEcspRequest[i];
+
+        if (pReq->comId == TTDB_TRN_DIR_REQ_COMID)
+        {
+            (void) tlm_reply(appHandle, (const TRDP_UUID_T *) &pReq->sessionId, TTDB_TRN_DIR_REP_COMID, 0u, NULL,
+                             sTrnDir, makeTrnDir(), NULL);
+        }
+        else
+        {
+            UINT8 n = (pReq->cstNo != 0u) ? pReq->cstNo : (UINT8) ++sNoOfAnonymous;
+
+            (void) tlm_reply(appHandle, (const TRDP_UUID_T *) &pReq->sessionId, TTDB_STAT_CST_REP_COMID, 0u, NULL,
+                             sCstInfo, makeCstInfo(n), NULL);
+        }
+    }
+    sNoOfPending = 0u;
+}
+
+/* Process MD and answer the ECSP requests until the consist info version reached the target */
+static BOOL8 processUntil (TRDP_APP_SESSION_T appHandle, UINT32 version)
+{
+    UINT32 i;
+
+    for (i = 0u; (tau_getCstInfoVersion(appHandle) < version) && (i < 1000u); i++)
+    {
+        TRDP_FDS_T  rfds;
+        TRDP_TIME_T tv = {0, 0};
+        INT32       noDesc = 0;
+        INT32       rv;
+
+        FD_ZERO(&rfds);
+        (void) tlm_getInterval(appHandle, &tv, &rfds, &noDesc);
+        tv.tv_sec   = 0;
+        tv.tv_usec  = 1000;
+        rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+        (void) tlm_process(appHandle, &rfds, &rv);
+        ecspReply(appHandle, ((i % 20u) == 19u) ? TRUE : FALSE);
+    }
+    return (tau_getCstInfoVersion(appHandle) >= version) ? TRUE : FALSE;
+}
+
+/* Copy a label into a zero-filled TRDP_LABEL_T, as the TTI lookups read the whole array */
+static const CHAR8 *toLabel (TRDP_LABEL_T label, const CHAR8 *pText)
+{
+    memset(label, 0, sizeof(TRDP_LABEL_T));
+    vos_strncpy(label, pText, TRDP_MAX_LABEL_LEN);
+    return label;
+}
+
+/**********************************************************************************************************************/
+
+/* The first lookup of a consist requests its info, wait for it to arrive */
+static BOOL8 waitForCst (TRDP_APP_SESSION_T appHandle, const CHAR8 *pLabel)
+{
+    UINT16 vehCnt;
+
+    return (tau_getCstVehCnt(appHandle, &vehCnt, pLabel) == TRDP_NODATA_ERR) &&
+           (processUntil(appHandle, tau_getCstInfoVersion(appHandle) + 1u) == TRUE) &&
+           (tau_getCstVehCnt(appHandle, &vehCnt, pLabel) == TRDP_NO_ERR);
+}
+
+/**********************************************************************************************************************/
+/*  Consist infos are decoded once on arrival, lookups by consist label, vehicle ID, function ID and label hit the
+    indexes and the version tells whether anything changed                                                          */
+
+static int test_tau_cstInfo (void)
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_LIS_T              listenHandle;
+    TRDP_LIS_T              listenHandle2;
+    TRDP_MEM_CONFIG_T       dynamicConfig   = {NULL, 0, {0}};
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"Me", "", 0, 0, TRDP_OPTION_BLOCK};
+    TRDP_VEHICLE_INFO_T     vehInfo;
+    TRDP_FUNCTION_INFO_T    fctInfo;
+    TRDP_FUNCTION_INFO_T    fctList[TEST_NO_OF_FCT];
+    TRDP_LABEL_T            label;
+    TRDP_LABEL_T            cstLabel;
+    TRDP_LABEL_T            fctCstLabel;
+    TRDP_TIME_T             start, end;
+    UINT16                  vehCnt = 0u, fctCnt = 0u, cstCnt = 0u;
+    UINT32                  i, version, requests;
+    FILE                    *fp;
+    int                     ret = 1;
+
+    fp = fopen(TEST_HOSTSFILE, "w");
+    if (fp == NULL)
+    {
+        printf("*** cannot write %s\n", TEST_HOSTSFILE);
+        return 1;
+    }
+    fprintf(fp, "127.0.0.1\t%s\n", TTDB_STAT_CST_REQ_URI);
+    fclose(fp);
+
+    if (tlc_init(dbgOut, NULL, &dynamicConfig) != TRDP_NO_ERR)
+    {
+        printf("*** Initialization error\n");
+        return 1;
+    }
+    if (tlc_openSession(&appHandle, VOS_INADDR_ANY, 0, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR)
+    {
+        printf("*** openSession error\n");
+        tlc_terminate();
+        return 1;
+    }
+    if ((tau_initDnr(appHandle, 0u, 0u, TEST_HOSTSFILE, TRDP_DNR_COMMON_THREAD, FALSE) != TRDP_NO_ERR) ||
+        (tau_initTTIaccess(appHandle, NULL, 0u, NULL) != TRDP_NO_ERR) ||
+        (tlm_addListener(appHandle, &listenHandle, NULL, ecspResponder, TRUE, TTDB_STAT_CST_REQ_COMID, 0u, 0u,
+                         VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL, NULL) != TRDP_NO_ERR) ||
+        (tlm_addListener(appHandle, &listenHandle2, NULL, ecspResponder, TRUE, TTDB_TRN_DIR_REQ_COMID, 0u, 0u,
+                         VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL, NULL) != TRDP_NO_ERR))
+    {
+        printf("*** tau_initDnr / tau_initTTIaccess / tlm_addListener error\n");
+        goto exit_label;
+    }
+
+    if (tau_getCstInfoVersion(appHandle) != 0u)
+    {
+        printf("*** consist info reported before any was received\n");
+        goto exit_label;
+    }
+    if ((waitForCst(appHandle, "CST1") == FALSE) || (waitForCst(appHandle, "cst2") == FALSE))
+    {
+        printf("*** consist infos not received (%u requests)\n", sNoOfCstRequests);
+        goto exit_label;
+    }
+    version = tau_getCstInfoVersion(appHandle);
+    if (version != 2u)
+    {
+        printf("*** version %u after two consist infos (expected 2)\n", version);
+        goto exit_label;
+    }
+
+    /* counts and lists in host representation */
+    memset(cstLabel, 0, sizeof(cstLabel));
+    (void) snprintf(cstLabel, sizeof(cstLabel), "cst2");
+    if ((tau_getCstVehCnt(appHandle, &vehCnt, cstLabel) != TRDP_NO_ERR) || (vehCnt != TEST_NO_OF_VEH) ||
+        (tau_getCstFctCnt(appHandle, &fctCnt, cstLabel) != TRDP_NO_ERR) || (fctCnt != TEST_NO_OF_FCT) ||
+        (tau_getCstFctInfo(appHandle, fctList, cstLabel, TEST_NO_OF_FCT) != TRDP_NO_ERR) ||
+        (fctList[TEST_NO_OF_FCT - 1u].fctId != TEST_FCT_ID + TEST_NO_OF_FCT - 1u))
+    {
+        printf("*** cst2: %u vehicles, %u functions\n", vehCnt, fctCnt);
+        goto exit_label;
+    }
+
+    /* every vehicle and function of both consists, upper case labels included */
+    for (i = 0u; i < 2u * TEST_NO_OF_VEH; i++)
+    {
+        CHAR8 cst[TRDP_MAX_LABEL_LEN + 1];
+
+        (void) snprintf(cst, sizeof(cst), "CST%u", i / TEST_NO_OF_VEH + 1u);
+        (void) snprintf(label, sizeof(label), "VEH%u.%u", i / TEST_NO_OF_VEH + 1u, i % TEST_NO_OF_VEH + 1u);
+        if ((tau_getVehInfo(appHandle, &vehInfo, label, cst) != TRDP_NO_ERR) ||
+            (vehInfo.cstVehNo != i % TEST_NO_OF_VEH + 1u))
+        {
+            printf("*** %s in %s not found\n", label, cst);
+            goto exit_label;
+        }
+    }
+    for (i = 0u; i < TEST_NO_OF_FCT; i++)
+    {
+        (void) snprintf(label, sizeof(label), "FCT%03u", i);
+        if ((tau_getFctInfo(appHandle, &fctInfo, 0u, label, toLabel(cstLabel, "cst1")) != TRDP_NO_ERR) ||
+            (fctInfo.fctId != TEST_FCT_ID + i) ||
+            (tau_getFctInfo(appHandle, &fctInfo, (UINT16) (TEST_FCT_ID + i), NULL, toLabel(cstLabel, "cst2")) !=
+             TRDP_NO_ERR) ||
+            (fctInfo.cstVehNo != i % TEST_NO_OF_VEH + 1u))
+        {
+            printf("*** function %u not found\n", i);
+            goto exit_label;
+        }
+    }
+    (void) toLabel(cstLabel, "cst1");
+    if ((tau_getVehInfo(appHandle, &vehInfo, toLabel(label, "nobody"), cstLabel) != TRDP_PARAM_ERR) ||
+        (tau_getFctInfo(appHandle, &fctInfo, TEST_FCT_ID + TEST_NO_OF_FCT, NULL, cstLabel) != TRDP_PARAM_ERR))
+    {
+        printf("*** unknown vehicle / function found\n");
+        goto exit_label;
+    }
+
+    (void) toLabel(label, "veh2.3");
+    (void) toLabel(cstLabel, "cst2");
+    (void) toLabel(fctCstLabel, "cst1");
+    vos_getTime(&start);
+    for (i = 0u; i < TEST_NO_OF_ROUNDS; i++)
+    {
+        (void) tau_getVehInfo(appHandle, &vehInfo, label, cstLabel);
+        (void) tau_getFctInfo(appHandle, &fctInfo, (UINT16) (TEST_FCT_ID + i % TEST_NO_OF_FCT), NULL, fctCstLabel);
+    }
+    vos_getTime(&end);
+    vos_subTime(&end, &start);
+    printf("%u vehicle and function lookups in %u us\n", 2u * TEST_NO_OF_ROUNDS,
+           (UINT32) (end.tv_sec * 1000000u + end.tv_usec));
+
+    if (tau_getCstInfoVersion(appHandle) != version)
+    {
+        printf("*** version changed without new consist info\n");
+        goto exit_label;
+    }
+
+    /* New train directory: cst1 is kept, cst2 (changed) and cst3 (coupled) are fetched in parallel */
+    requests    = sNoOfCstRequests;
+    sMaxPending = 0u;
+    if ((tau_getTrnCstCnt(appHandle, &cstCnt) != TRDP_NODATA_ERR) ||
+        (processUntil(appHandle, version + 3u) == FALSE) ||         /* cst2 dropped, cst2 and cst3 stored */
+        (sNoOfCstRequests != requests + 2u) || (sMaxPending != 2u))
+    {
+        printf("*** refresh: %u consist info requests (expected 2), %u in parallel\n",
+               sNoOfCstRequests - requests, sMaxPending);
+        goto exit_label;
+    }
+    if ((tau_getTrnCstCnt(appHandle, &cstCnt) != TRDP_NO_ERR) || (cstCnt != 3u) ||
+        (tau_getVehInfo(appHandle, &vehInfo, toLabel(label, "veh1.1"), toLabel(cstLabel, "cst1")) != TRDP_NO_ERR) ||
+        (tau_getVehInfo(appHandle, &vehInfo, toLabel(label, "veh2.1"), toLabel(cstLabel, "cst2")) != TRDP_NO_ERR) ||
+        (tau_getVehInfo(appHandle, &vehInfo, toLabel(label, "veh3.1"), toLabel(cstLabel, "cst3")) != TRDP_NO_ERR) ||
+        (tau_getCstInfoVersion(appHandle) != version + 3u))
+    {
+        printf("*** consist infos after refresh not complete\n");
+        goto exit_label;
+    }
+    printf("Train directory change fetched %u of 3 consist infos\n", sNoOfCstRequests - requests);
+
+    if (tau_getVehInfo(appHandle, &vehInfo, toLabel(label, "veh9.1"), toLabel(cstLabel, "cst9")) != TRDP_NODATA_ERR)
+    {
+        printf("*** unknown consist found\n");
+        goto exit_label;
+    }
+    ret = 0;
+
+exit_label:
+    tau_deInitTTI(appHandle);
+    tau_deInitDnr(appHandle);
+    tlc_closeSession(appHandle);
+    tlc_terminate();
+    return ret;
+}
+
 /**********************************************************************************************************************/
 
 int main(int argc, char *argv[])
@@ -105,6 +525,17 @@ int main(int argc, char *argv[])
     TRDP_IP_ADDR_T      ecspIpAddr = vos_dottedIP("10.0.0.1");
     CHAR8               *pHostsFileName = NULL;
 
+    if ((argc > 1) && (strcmp(argv[1], "-l") == 0))
+    {
+        /* local tests only */
+        if (test_tau_cstInfo() != 0)
+        {
+            printf("*** consist info test failed\n");
+            return 1;
+        }
+        printf("All tests successfully finished.\n");
+        return 0;
+    }
     if (argc > 1)
     {
         pHostsFileName = argv[1];
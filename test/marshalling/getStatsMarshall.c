@@ -16,6 +16,7 @@
  *
  * $Id: getStatsMarshall.c 1916 2019-06-19 14:37:27Z bloehr $
  *
+ *      AG 2026-10-17: Marshalling context passed to tau_unmarshall()
  *      BL 2019-02-01: Ticket #234 Correcting Statistics ComIds
  *      BL 2018-09-05: Ticket #211 XML handling: Dataset Name should be stored in TRDP_DATASET_ELEMENT_T
  *      BL 2017-06-30: Compiler warnings, local prototypes added
@@ -63,6 +64,7 @@
 #define APP_VERSION         "0.0.0.3"
 
 TRDP_STATISTICS_T gBuffer;
+void *gpRefCon = NULL;          /* Marshalling context */
 int gKeepOnRunning = TRUE;
 
 /**********************************************************************************************************************/
@@ -361,7 +363,7 @@ void myPDcallBack (
            {
                if (pMsg->comId == 12)
                {
-                   tau_unmarshall(NULL, pMsg->comId, pData, dataSize, (UINT8 *) &gBuffer, &dataSize, NULL);
+                   tau_unmarshall(gpRefCon, pMsg->comId, pData, dataSize, (UINT8 *) &gBuffer, &dataSize, NULL);
                    print_stats(&gBuffer);
                    gKeepOnRunning = FALSE;
                }
@@ -406,7 +408,6 @@ int main (int argc, char * *argv)
     UINT32  destIP  = 0;
     UINT32  ownIP   = 0;
     UINT32  replyIP = 0;
-    UINT32  *refCon;
 
     if (argc <= 1)
     {
@@ -470,11 +471,12 @@ int main (int argc, char * *argv)
         return 1;
     }
 
-    if (tau_initMarshall((void *)&refCon, 1, gComIdMap, cNoOfDatasets, gDataSets) != TRDP_NO_ERR)
+    if (tau_initMarshall(&gpRefCon, 1, gComIdMap, cNoOfDatasets, gDataSets) != TRDP_NO_ERR)
     {
         printf("Marshalling initialization error\n");
         return 1;
     }
+    marshall.pRefCon = gpRefCon;
 
     /*    Open a session for callback operation    (PD only) */
     if (tlc_openSession(&appHandle,
@@ -16,6 +16,11 @@
  *
  * $Id: test_marshalling.c 2181 2020-07-28 15:38:01Z bloehr $
  *
+ *      AG 2026-10-17: test3: plans by default, interpreter context by tau_initMarshallInterpreted(), best of runs
+ *      AG 2026-10-17: test5: dataset sized and unmarshalled as by the ladder traffic store write
+ *      AG 2026-10-17: test3: plans from a separate context created by tau_initMarshallPlans()
+ *      AG 2026-10-17: test4: two marshalling contexts used by parallel threads, NULL context rejected
+ *      AG 2026-10-17: test3: compiled marshalling plans against the interpreter, benchmark
  *      SB 2019-05-24: Ticket #252 Bug in unmarshalling/marshalling of TIMEDATE48 and TIMEDATE64
  *      BL 2018-09-05: Ticket #211 XML handling: Dataset Name should be stored in TRDP_DATASET_ELEMENT_T
  *      BL 2018-04-27: Testing ticket #197
@@ -24,6 +29,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "tau_marshall.h"
+#include "vos_thread.h"
 
 /*    Test data sets    */
 TRDP_DATASET_T  gDataSet1990 =
@@ -724,6 +730,7 @@ TRDP_COMID_DSID_MAP_T   gComIdMap[] =
 
 UINT8   gDstDataBuffer[1500];
 UINT32  *gpRefCon = NULL;
+UINT32  *gpInterpRefCon = NULL;         /* Same tables, interpreted */
 
 struct myDataSet1000    gMyDataSet1000Copy;
 struct myDataSet1001    gMyDataSet1001Copy;
@@ -1052,17 +1059,378 @@ static int test2()
     return 0;
 }
 
+/***********************************************************************************************************************
+    Compare the compiled marshalling plans with the interpreter and measure both
+***********************************************************************************************************************/
+#define TEST3_BUF_SIZE      2048u
+#define TEST3_BENCH_LOOPS   20000u
+#define TEST3_BENCH_RUNS    5u
+
+typedef union
+{
+    UINT64  align;
+    UINT8   data[TEST3_BUF_SIZE];
+} TEST3_BUF_T;
+
+static TEST3_BUF_T  gPlanBuf;
+static TEST3_BUF_T  gInterpBuf;
+static TEST3_BUF_T  gWireBuf;
+
+/*  Run the plan and the interpreter on the same input, both must give the same result */
+static int compareRun (
+    BOOL8   marshall,
+    BOOL8   byDsId,
+    UINT32  id,
+    UINT8   *pSrc,
+    UINT32  srcSize,
+    UINT32  destSize)
+{
+    TRDP_ERR_T  err[2];
+    UINT32      size[2];
+    UINT8       *pBuf[2];
+    int         i;
+
+    pBuf[0] = gPlanBuf.data;
+    pBuf[1] = gInterpBuf.data;
+
+    for (i = 0; i < 2; i++)
+    {
+        void *pRefCon = (i == 0) ? gpRefCon : gpInterpRefCon;
+
+        memset(pBuf[i], 0xA5, TEST3_BUF_SIZE);
+        size[i] = destSize;
+        if (marshall == TRUE)
+        {
+            err[i] = (byDsId == TRUE) ?
+                tau_marshallDs(pRefCon, id, pSrc, srcSize, pBuf[i], &size[i], NULL) :
+                tau_marshall(pRefCon, id, pSrc, srcSize, pBuf[i], &size[i], NULL);
+        }
+        else
+        {
+            err[i] = (byDsId == TRUE) ?
+                tau_unmarshallDs(pRefCon, id, pSrc, srcSize, pBuf[i], &size[i], NULL) :
+                tau_unmarshall(pRefCon, id, pSrc, srcSize, pBuf[i], &size[i], NULL);
+        }
+    }
+
+    if ((err[0] != err[1]) || (size[0] != size[1]) || (memcmp(pBuf[0], pBuf[1], TEST3_BUF_SIZE) != 0))
+    {
+        printf("### %s %u (src %u, dest %u): plan err %d size %u, interpreter err %d size %u%s\n",
+               (marshall == TRUE) ? "marshall" : "unmarshall", id, srcSize, destSize,
+               err[0], size[0], err[1], size[1],
+               (memcmp(pBuf[0], pBuf[1], TEST3_BUF_SIZE) != 0) ? ", data differs" : "");
+        return 1;
+    }
+    return 0;
+}
+
+/*  Time marshalling and unmarshalling of one comId in ns per call */
+static double measure (
+    void    *pRefCon,
+    BOOL8   marshall,
+    UINT32  comId,
+    UINT8   *pSrc,
+    UINT32  srcSize)
+{
+    VOS_TIMEVAL_T   start;
+    VOS_TIMEVAL_T   now;
+    UINT32          i;
+    UINT32          size;
+
+    vos_getTime(&start);
+    for (i = 0u; i < TEST3_BENCH_LOOPS; i++)
+    {
+        size = TEST3_BUF_SIZE;
+        if (marshall == TRUE)
+        {
+            (void) tau_marshall(pRefCon, comId, pSrc, srcSize, gPlanBuf.data, &size, NULL);
+        }
+        else
+        {
+            (void) tau_unmarshall(pRefCon, comId, pSrc, srcSize, gPlanBuf.data, &size, NULL);
+        }
+    }
+    vos_getTime(&now);
+    vos_subTime(&now, &start);
+    return ((double) now.tv_sec * 1000000000.0 + (double) now.tv_usec * 1000.0) / TEST3_BENCH_LOOPS;
+}
+
+static int test3()
+{
+    static const UINT32 dsIds[] = {1990u, 1991u, 1992u, 1993u, 2002u, 2003u};
+    struct
+    {
+        UINT32  comId;
+        UINT8   *pData;
+        UINT32  size;
+    } tests[3];
+    UINT32      wireSize;
+    UINT32      i, n;
+    int         errors = 0;
+    double      marshallNs[2]   = {0.0, 0.0};
+    double      unmarshallNs[2] = {0.0, 0.0};
+    TRDP_ERR_T  err;
+
+    gMyDataSet2003.c = gMyDataSet2002;
+
+    tests[0].comId  = 1000u;
+    tests[0].pData  = (UINT8 *) &gMyDataSet1000;
+    tests[0].size   = sizeof(gMyDataSet1000);
+    tests[1].comId  = 1001u;
+    tests[1].pData  = (UINT8 *) &gMyDataSet1001;
+    tests[1].size   = sizeof(gMyDataSet1001);
+    tests[2].comId  = 2003u;
+    tests[2].pData  = (UINT8 *) &gMyDataSet2003;
+    tests[2].size   = sizeof(gMyDataSet2003);
+
+    for (i = 0u; i < sizeof(tests) / sizeof(tests[0]); i++)
+    {
+        /* Complete, truncated source and too small destination */
+        for (n = 0u; n <= tests[i].size; n += (n < 16u) ? 1u : 7u)
+        {
+            errors += compareRun(TRUE, FALSE, tests[i].comId, tests[i].pData, tests[i].size - n, TEST3_BUF_SIZE);
+            errors += compareRun(TRUE, FALSE, tests[i].comId, tests[i].pData, tests[i].size, tests[i].size - n + 1u);
+        }
+
+        wireSize    = TEST3_BUF_SIZE;
+        err         = tau_marshall(gpRefCon, tests[i].comId, tests[i].pData, tests[i].size,
+                                   gWireBuf.data, &wireSize, NULL);
+        if (err != TRDP_NO_ERR)
+        {
+            printf("### tau_marshall(%u) returns error %d\n", tests[i].comId, err);
+            return 1;
+        }
+        for (n = 0u; n < wireSize; n += (n < 16u) ? 1u : 7u)
+        {
+            errors += compareRun(FALSE, FALSE, tests[i].comId, gWireBuf.data, wireSize - n, TEST3_BUF_SIZE);
+            errors += compareRun(FALSE, FALSE, tests[i].comId, gWireBuf.data, wireSize, tests[i].size - n);
+        }
+    }
+
+    /* Nested datasets by dataset ID */
+    for (i = 0u; i < sizeof(dsIds) / sizeof(dsIds[0]); i++)
+    {
+        errors += compareRun(TRUE, TRUE, dsIds[i], (UINT8 *) &gMyDataSet1000.ds, sizeof(gMyDataSet1000.ds),
+                             TEST3_BUF_SIZE);
+        errors += compareRun(FALSE, TRUE, dsIds[i], gWireBuf.data, 24u, TEST3_BUF_SIZE);
+    }
+
+    if (errors != 0)
+    {
+        printf("### Compiled marshalling plans differ from the interpreter in %d cases!\n", errors);
+        return 1;
+    }
+    printf("Compiled marshalling plans match the interpreter\n");
+
+    /* Benchmark */
+    wireSize = TEST3_BUF_SIZE;
+    (void) tau_marshall(gpRefCon, 1000u, (UINT8 *) &gMyDataSet1000, sizeof(gMyDataSet1000), gWireBuf.data,
+                        &wireSize, NULL);
+    /* Alternating runs, the best one of each is reported */
+    for (n = 0u; n < TEST3_BENCH_RUNS; n++)
+    {
+        for (i = 0u; i < 2u; i++)
+        {
+            void    *pRefCon = (i == 0u) ? gpRefCon : gpInterpRefCon;
+            double  ns;
+
+            ns = measure(pRefCon, TRUE, 1000u, (UINT8 *) &gMyDataSet1000, sizeof(gMyDataSet1000));
+            if ((n == 0u) || (ns < marshallNs[i]))
+            {
+                marshallNs[i] = ns;
+            }
+            ns = measure(pRefCon, FALSE, 1000u, gWireBuf.data, wireSize);
+            if ((n == 0u) || (ns < unmarshallNs[i]))
+            {
+                unmarshallNs[i] = ns;
+            }
+        }
+    }
+    for (i = 0u; i < 2u; i++)
+    {
+        printf("ComId 1000 (%u bytes) %-11s: marshall %8.1f ns, unmarshall %8.1f ns\n",
+               wireSize, (i == 0u) ? "plan" : "interpreter", marshallNs[i], unmarshallNs[i]);
+    }
+
+    return 0;
+}
+
+/***********************************************************************************************************************
+    Two marshalling contexts used from parallel threads
+***********************************************************************************************************************/
+#define TEST4_THREADS       4u
+#define TEST4_LOOPS         20000u
+
+typedef struct
+{
+    void            *pRefCon;
+    UINT32          comId;
+    UINT8           *pData;
+    UINT32          size;
+    UINT32          wireSize;
+    volatile int    errors;
+    volatile BOOL8  done;
+    TEST3_BUF_T     wire;
+    TEST3_BUF_T     host;
+} TEST4_JOB_T;
+
+static TEST4_JOB_T  gJobs[TEST4_THREADS];
+
+static void test4Thread (
+    void *pArg)
+{
+    TEST4_JOB_T *pJob = (TEST4_JOB_T *) pArg;
+    UINT32      i, size;
+    TRDP_DATASET_T  *pCached = NULL;
+
+    for (i = 0u; i < TEST4_LOOPS; i++)
+    {
+        size = TEST3_BUF_SIZE;
+        if ((tau_marshall(pJob->pRefCon, pJob->comId, pJob->pData, pJob->size, pJob->wire.data, &size,
+                          &pCached) != TRDP_NO_ERR) ||
+            (size != pJob->wireSize) ||
+            (memcmp(pJob->wire.data, gWireBuf.data, size) != 0))
+        {
+            pJob->errors++;
+        }
+        size = TEST3_BUF_SIZE;
+        if ((tau_unmarshall(pJob->pRefCon, pJob->comId, pJob->wire.data, pJob->wireSize, pJob->host.data, &size,
+                            &pCached) != TRDP_NO_ERR) ||
+            (memcmp(pJob->host.data, pJob->pData, pJob->size) != 0))
+        {
+            pJob->errors++;
+        }
+    }
+    pJob->done = TRUE;
+}
+
+static int test4()
+{
+    void            *pRefCon2 = NULL;
+    VOS_THREAD_T    thread;
+    UINT32          i, wireSize;
+    int             errors = 0;
+
+    if (tau_initMarshall(&pRefCon2, sizeof(gComIdMap) / sizeof(TRDP_COMID_DSID_MAP_T), gComIdMap, 8,
+                         gDataSets) != TRDP_NO_ERR)
+    {
+        printf("### second tau_initMarshall failed\n");
+        return 1;
+    }
+
+    /* Reference output of the first context */
+    wireSize = TEST3_BUF_SIZE;
+    (void) tau_marshall(gpRefCon, 2003u, (UINT8 *) &gMyDataSet2003, sizeof(gMyDataSet2003), gWireBuf.data,
+                        &wireSize, NULL);
+
+    (void) vos_threadInit();
+    for (i = 0u; i < TEST4_THREADS; i++)
+    {
+        gJobs[i].pRefCon    = (i & 1u) ? pRefCon2 : (void *) gpRefCon;
+        gJobs[i].comId      = 2003u;
+        gJobs[i].pData      = (UINT8 *) &gMyDataSet2003;
+        gJobs[i].size       = sizeof(gMyDataSet2003);
+        gJobs[i].wireSize   = wireSize;
+        if (vos_threadCreate(&thread, "marshall", VOS_THREAD_POLICY_OTHER, 0, 0, 0,
+                             test4Thread, &gJobs[i]) != VOS_NO_ERR)
+        {
+            printf("### vos_threadCreate failed\n");
+            return 1;
+        }
+    }
+    for (i = 0u; i < TEST4_THREADS; i++)
+    {
+        while (gJobs[i].done == FALSE)
+        {
+            (void) vos_threadDelay(10000u);
+        }
+        errors += gJobs[i].errors;
+    }
+
+    if ((tau_deInitMarshall(pRefCon2) != TRDP_NO_ERR) ||
+        (tau_deInitMarshall(NULL) != TRDP_PARAM_ERR))
+    {
+        printf("### tau_deInitMarshall failed\n");
+        errors++;
+    }
+
+    /* There is no default context */
+    wireSize = TEST3_BUF_SIZE;
+    if (tau_marshall(NULL, 2003u, (UINT8 *) &gMyDataSet2003, sizeof(gMyDataSet2003), gWireBuf.data,
+                     &wireSize, NULL) != TRDP_PARAM_ERR)
+    {
+        printf("### tau_marshall without context does not fail\n");
+        errors++;
+    }
+    if (errors != 0)
+    {
+        printf("### Parallel marshalling failed in %d cases!\n", errors);
+        return 1;
+    }
+    printf("Parallel marshalling with two contexts OK\n");
+    return 0;
+}
+
+/***********************************************************************************************************************
+    Traffic store write of the ladder (sizeWriteDatasetInTrafficStore): a zeroed dataset is sized and unmarshalled
+    with the context itself and the dataset cached by the size calculation
+***********************************************************************************************************************/
+static int test5()
+{
+    static UINT8    src[TRDP_MAX_MD_DATA_SIZE];
+    static UINT8    dst[TRDP_MAX_MD_DATA_SIZE];
+    TRDP_DATASET_T  *pDataset   = NULL;
+    UINT32          wireSize    = 0u;
+    UINT32          hostSize;
+    TRDP_ERR_T      err;
+
+    memset(src, 0, sizeof(src));
+    err = tau_calcDatasetSize(gpRefCon, 2003u, src, sizeof(src), &wireSize, &pDataset);
+    if ((err != TRDP_NO_ERR) || (pDataset == NULL))
+    {
+        printf("### tau_calcDatasetSize returns error %d\n", err);
+        return 1;
+    }
+    hostSize = wireSize + (wireSize + 1u) / 2u;
+    err = tau_unmarshallDs(gpRefCon, pDataset->id, src, sizeof(src), dst, &hostSize, &pDataset);
+    if ((err != TRDP_NO_ERR) || (hostSize == 0u))
+    {
+        printf("### tau_unmarshallDs returns error %d\n", err);
+        return 1;
+    }
+    printf("Traffic store size of dataset %u: %u bytes marshalled, %u bytes unmarshalled\n", pDataset->id,
+           wireSize, hostSize);
+    return 0;
+}
+
 /******/
 int main ()
 {
     TRDP_ERR_T  err;
 
     err = tau_initMarshall((void *)&gpRefCon, sizeof(gComIdMap)/sizeof(TRDP_COMID_DSID_MAP_T), gComIdMap, 8, gDataSets);
+    if (err == TRDP_NO_ERR)
+    {
+        err = tau_initMarshallInterpreted((void *)&gpInterpRefCon, sizeof(gComIdMap)/sizeof(TRDP_COMID_DSID_MAP_T),
+                                          gComIdMap, 8, gDataSets);
+    }
 
     if (err == TRDP_NO_ERR)
     {
-        return test1();
+        if (test1() != 0)
+        {
+            return 1;
+        }
         //return test2();
+        if (test3() != 0)
+        {
+            return 1;
+        }
+        if (test4() != 0)
+        {
+            return 1;
+        }
+        return test5();
     }
     return 1;
 }
@@ -0,0 +1,866 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-md-bench.c
+ *
+ * @brief           Benchmark for the MD session lookup and listener dispatch on loopback
+ *
+ * @details         One session is caller and replier at the same time. A number of UDP requests is sent to the own
+ *                  listener, every request is kept open on both sides until all of them have been received. Then
+ *                  every open session is looked up by its sessionID (trdp_MDqueueFindSession), through the index and
+ *                  along the queue as the linear baseline, the indexed time should not depend on the number of open
+ *                  sessions. Finally all requests are replied.
+ *                  Notifications are then dispatched to a growing number of comId and URI listeners, with checks
+ *                  that the newest matching listener (incl. wildcards) takes each of them. The listener of each
+ *                  message is then looked up directly (trdp_mdFindListener), through the listener index and along
+ *                  the listener queue as the linear baseline.
+ *                  The timer wheel itself is checked first with timeouts up to beyond its range on a simulated clock.
+ *                  Finally a few short requests have to time out on both sides while many long ones are open, the
+ *                  time per process cycle should not depend on the number of open sessions either.
+ *                  TCP notifications are sent to the own TCP listener, bursts of small frames (several frames per
+ *                  socket read) and 64 KB blobs (one frame over many reads), each one is checked for its content.
+ *                  Bursts of TCP notifications are then queued without processing in between, the frames of one
+ *                  process cycle leave in one vectored send. If tlm_notify() reports a full send queue, the burst
+ *                  waits for the receiver.
+ *                  The session lookup and the TCP runs are repeated with the event driven loop (tlc_processEvents).
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *      AG 2026-10-17: shareTcp set, the burst shares one TCP connection
+ *      AG 2026-10-17: Listener lookup timed directly, index against the linear walk
+ *      AG 2026-10-17: Session lookup timed directly, index against the linear walk
+ *      AG 2026-10-17: TCP send burst benchmark (send queue, frames coalesced per process cycle)
+ *      AG 2026-10-17: Runs with tlc_processEvents() instead of tlm_getInterval()/vos_select()/tlm_process()
+ *      AG 2026-10-17: TCP receive benchmark (small frame bursts and 64 KB blobs)
+ *      AG 2026-10-17: Timeout benchmark (MD timer wheel)
+ *      AG 2026-10-17: Listener dispatch benchmark
+ *      AG 2026-10-17: Created
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trdp_if_light.h"
+#include "trdp_private.h"
+#include "trdp_utils.h"
+#include "trdp_mdcom.h"
+#include "vos_utils.h"
+
+/* --- defines ----------------------------------------------------------------*/
+
+#define BENCH_LOOPBACK      0x7F000001u     /* 127.0.0.1                                */
+#define BENCH_COMID         20000u
+#define BENCH_LIS_COMID     30000u          /* first comId of the listener benchmark    */
+#define BENCH_MAX_LISTENERS 1000u
+#define BENCH_REF_ANY       (BENCH_MAX_LISTENERS + 1u)  /* listener ignoring comId and URI  */
+#define BENCH_REF_URI       (BENCH_MAX_LISTENERS + 2u)  /* listener on URI "any" only       */
+#define BENCH_MAX_SESSIONS  1000u           /* open sessions in the largest run         */
+#define BENCH_LOOKUPS       100000u         /* direct lookups per variant               */
+#define BENCH_CHUNK         50u             /* requests/replies sent before processing  */
+#define BENCH_DATA_SIZE     32u
+#define BENCH_TIMEOUT       60000000u       /* reply timeout, must not expire           */
+#define BENCH_SHORT         10u             /* requests which have to time out          */
+#define BENCH_SHORT_TIMEOUT 50000u          /* their reply timeout                      */
+#define BENCH_MEM_SIZE      (16u * 1024u * 1024u)
+#define BENCH_WHEEL_TIMERS  500u            /* timers of the simulated clock check      */
+#define BENCH_WHEEL_SPAN    (6u * 3600u)    /* [s] their range, beyond the wheel        */
+#define BENCH_TCP_COMID     40000u
+#define BENCH_TCP_SMALL     1000u           /* small frames per TCP run                 */
+#define BENCH_TCP_BLOBS     40u             /* 64 KB frames per TCP run                 */
+#define BENCH_TCP_BURST     1000u           /* small frames per TCP send burst          */
+
+/* --- globals ----------------------------------------------------------------*/
+
+static TRDP_UUID_T  sReplierIds[BENCH_MAX_SESSIONS + BENCH_SHORT];
+static MD_ELE_T     *sSessions[BENCH_MAX_SESSIONS + BENCH_SHORT];
+static UINT32       sNoOfRequests   = 0u;
+static UINT32       sNoOfReplies    = 0u;
+static UINT32       sNoOfErrors     = 0u;
+static UINT32       sNoOfTimeouts   = 0u;
+static UINT32       sNoOfAppTimeouts = 0u;
+static UINT32       sNoOfListeners  = 0u;
+static UINT32       sNoOfNotifies   = 0u;
+static UINT32       sNoOfMisrouted  = 0u;
+static UINT32       sNoOfTcp        = 0u;
+static UINT32       sNoOfCorrupt    = 0u;
+static UINT32       sTcpSize        = 0u;
+static UINT32       sNoOfCycles     = 0u;
+static BOOL8        sUseEvents      = FALSE;
+static TRDP_LIS_T   sLisHandles[BENCH_MAX_LISTENERS];
+static MD_HEADER_T  sLisHeaders[BENCH_MAX_LISTENERS];
+static TRDP_SESSION_T   sWheelSession;
+static MD_ELE_T     sWheelTimers[BENCH_WHEEL_TIMERS];
+
+/* --- local functions --------------------------------------------------------*/
+
+static void dbgOut (void *pRefCon, TRDP_LOG_T category, const CHAR8 *pTime, const CHAR8 *pFile, UINT16 lineNumber,
+                    const CHAR8 *pMsgStr)
+{
+    if (category == VOS_LOG_ERROR)
+    {
+        printf("%s %s:%u %s", pTime, pFile, (unsigned int) lineNumber, pMsgStr);
+    }
+}
+
+/* Replier side keeps the session IDs of the requests, caller side counts the replies */
+static void mdCallback (void *pRefCon, TRDP_APP_SESSION_T appHandle, const TRDP_MD_INFO_T *pMsg, UINT8 *pData,
+                        UINT32 dataSize)
+{
+    if (pMsg->resultCode == TRDP_REPLYTO_ERR)
+    {
+        sNoOfTimeouts++;
+        return;
+    }
+    if (pMsg->resultCode == TRDP_APP_REPLYTO_ERR)
+    {
+        sNoOfAppTimeouts++;
+        return;
+    }
+    if (pMsg->resultCode != TRDP_NO_ERR)
+    {
+        sNoOfErrors++;
+        return;
+    }
+    if ((pMsg->msgType == TRDP_MSG_MR) && (sNoOfRequests < BENCH_MAX_SESSIONS + BENCH_SHORT))
+    {
+        memcpy(sReplierIds[sNoOfRequests], pMsg->sessionId, sizeof(TRDP_UUID_T));
+        sNoOfRequests++;
+    }
+    else if (pMsg->msgType == TRDP_MSG_MP)
+    {
+        sNoOfReplies++;
+    }
+    else if ((pMsg->msgType == TRDP_MSG_MN) && (pMsg->comId == BENCH_TCP_COMID))
+    {
+        /* every frame is filled with its (8 bit) number */
+        UINT32 i;
+
+        for (i = 0u; (i < dataSize) && (pData != NULL) && (pData[i] == (UINT8) sNoOfTcp); i++)
+        {
+            ;
+        }
+        if ((dataSize != sTcpSize) || (i != dataSize))
+        {
+            sNoOfCorrupt++;
+        }
+        sNoOfTcp++;
+    }
+    else if (pMsg->msgType == TRDP_MSG_MN)
+    {
+        UINT32 expected = BENCH_REF_ANY;
+
+        if (vos_strnicmp(pMsg->destUserURI, "any", TRDP_USR_URI_SIZE) == 0)
+        {
+            expected = BENCH_REF_URI;
+        }
+        else if ((pMsg->comId - BENCH_LIS_COMID) < sNoOfListeners)
+        {
+            expected = pMsg->comId - BENCH_LIS_COMID + 1u;
+        }
+        if ((UINT32) (uintptr_t) pMsg->pUserRef != expected)
+        {
+            sNoOfMisrouted++;
+        }
+        sNoOfNotifies++;
+    }
+}
+
+static double elapsedUs (const VOS_TIMEVAL_T *pStart)
+{
+    VOS_TIMEVAL_T now;
+    vos_getTime(&now);
+    vos_subTime(&now, pStart);
+    return (double) now.tv_sec * 1000000.0 + (double) now.tv_usec;
+}
+
+/* Process MD until the counter reached the target, FALSE on timeout */
+static BOOL8 processUntil (TRDP_APP_SESSION_T appHandle, const UINT32 *pCounter, UINT32 target)
+{
+    UINT32 idle = 0u;
+
+    while ((*pCounter < target) && (idle < 1000u))
+    {
+        TRDP_FDS_T  rfds;
+        TRDP_TIME_T tv = {0, 0};
+        INT32       noDesc = 0;
+        INT32       rv;
+        UINT32      before = *pCounter;
+
+        if (sUseEvents == TRUE)
+        {
+            tv.tv_usec = 1000;
+            (void) tlc_processEvents(appHandle, &tv);
+        }
+        else
+        {
+            FD_ZERO(&rfds);
+            (void) tlm_getInterval(appHandle, &tv, &rfds, &noDesc);
+            tv.tv_sec   = 0;
+            tv.tv_usec  = 1000;
+            rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+            (void) tlm_process(appHandle, &rfds, &rv);
+        }
+        idle = (*pCounter == before) ? idle + 1u : 0u;
+        sNoOfCycles++;
+    }
+    return (*pCounter >= target) ? TRUE : FALSE;
+}
+
+static UINT32 msec (const TRDP_TIME_T *pTime, UINT32 roundUp)
+{
+    return pTime->tv_sec * 1000u + ((UINT32) pTime->tv_usec + roundUp) / 1000u;
+}
+
+/* Every timer has to come due in the step of the simulated clock which passes its timeToGo, none earlier */
+static int checkTimerWheel (void)
+{
+    TRDP_TIME_T now, prev, step;
+    MD_ELE_T    *pElement;
+    UINT32      i, end, noOfDue = 0u, noOfEarly = 0u, noOfLate = 0u;
+
+    vos_getTime(&now);
+    end = now.tv_sec + 2u * BENCH_WHEEL_SPAN;
+    for (i = 0u; i < BENCH_WHEEL_TIMERS; i++)
+    {
+        sWheelTimers[i].stateEle        = TRDP_ST_TX_REQUEST_W4REPLY;
+        sWheelTimers[i].interval.tv_sec = 1u;
+        sWheelTimers[i].timeToGo        = now;
+        step.tv_sec     = (i * 7919u) % BENCH_WHEEL_SPAN;
+        step.tv_usec    = (INT32) ((i * 104729u) % 1000000u);
+        vos_addTime(&sWheelTimers[i].timeToGo, &step);
+        trdp_mdTimerSchedule(&sWheelSession, &sWheelTimers[i]);
+    }
+    for (i = 0u; noOfDue < BENCH_WHEEL_TIMERS; i++)
+    {
+        prev            = now;
+        step.tv_sec     = 0u;
+        step.tv_usec    = (INT32) (1000u + (i * 7919u) % 998000u);
+        vos_addTime(&now, &step);
+        if (now.tv_sec > end)
+        {
+            break;
+        }
+        trdp_mdTimerExpire(&sWheelSession, &now);
+        while ((pElement = trdp_mdTimerNextDue(&sWheelSession)) != NULL)
+        {
+            if (vos_cmpTime(&pElement->timeToGo, &now) > 0)
+            {
+                /* too early, timers beyond the range of the wheel are kept at its end */
+                noOfEarly++;
+                trdp_mdTimerSchedule(&sWheelSession, pElement);
+                continue;
+            }
+            if (msec(&pElement->timeToGo, 999u) <= msec(&prev, 0u))
+            {
+                noOfLate++;
+            }
+            noOfDue++;
+        }
+    }
+    printf("MD timer wheel: %u of %u timers due, %u early, %u late, %u cascaded\n", noOfDue, BENCH_WHEEL_TIMERS,
+           noOfEarly, noOfLate, sWheelSession.mdTimer.stats.numCascaded);
+    return ((noOfDue != BENCH_WHEEL_TIMERS) || (noOfEarly != 0u) || (noOfLate != 0u) ||
+            (sWheelSession.mdTimer.stats.numTimers != 0u) || (sWheelSession.mdTimer.stats.numCascaded == 0u)) ? 1 : 0;
+}
+
+/* Find every session of a queue by its sessionID, through the index or along the queue (pIndex == NULL).
+   Returns the time per lookup [ns], 0 if a session was not found */
+static double timeLookup (MD_ELE_T *pHead, const TRDP_MD_SID_INDEX_T *pIndex)
+{
+    MD_ELE_T        *pElement;
+    VOS_TIMEVAL_T   start;
+    UINT32          i, noOfSessions = 0u;
+    double          usec;
+
+    for (pElement = pHead; (pElement != NULL) && (noOfSessions < BENCH_MAX_SESSIONS + BENCH_SHORT);
+         pElement = pElement->pNext)
+    {
+        sSessions[noOfSessions++] = pElement;
+    }
+    if (noOfSessions == 0u)
+    {
+        return 0.0;
+    }
+
+    vos_getTime(&start);
+    for (i = 0u; i < BENCH_LOOKUPS; i++)
+    {
+        pElement = sSessions[i % noOfSessions];
+        if (trdp_MDqueueFindSession(pHead, pIndex, pElement->sessionID, NULL) != pElement)
+        {
+            return 0.0;
+        }
+    }
+    usec = elapsedUs(&start);
+    return usec * 1000.0 / (double) BENCH_LOOKUPS;
+}
+
+/* Open noOfSessions requests, look all of them up, then reply them */
+static int benchSessions (TRDP_APP_SESSION_T appHandle, UINT32 noOfSessions)
+{
+    UINT8           data[BENCH_DATA_SIZE];
+    UINT32          i;
+    double          nsec[4];
+
+    sNoOfRequests   = 0u;
+    sNoOfReplies    = 0u;
+    sNoOfErrors     = 0u;
+    memset(data, 0x55, sizeof(data));
+
+    for (i = 0u; i < noOfSessions; i++)
+    {
+        TRDP_UUID_T sessionId;
+
+        if (tlm_request(appHandle, NULL, NULL, &sessionId, BENCH_COMID, 0u, 0u, 0u, BENCH_LOOPBACK,
+                        TRDP_FLAGS_CALLBACK, 1u, BENCH_TIMEOUT, NULL, data, sizeof(data), NULL, NULL) != TRDP_NO_ERR)
+        {
+            printf("MD: tlm_request() failed\n");
+            return 1;
+        }
+        /* do not overrun the socket buffer */
+        if (((i + 1u) % BENCH_CHUNK) == 0u)
+        {
+            (void) processUntil(appHandle, &sNoOfRequests, i + 1u);
+        }
+    }
+    if (processUntil(appHandle, &sNoOfRequests, noOfSessions) == FALSE)
+    {
+        printf("MD: %u of %u requests received\n", sNoOfRequests, noOfSessions);
+        return 1;
+    }
+
+    /* the lookup of trdp_mdLookupElement(), without the state check */
+    nsec[0] = timeLookup(appHandle->pMDSndQueue, &appHandle->mdSndIndex);
+    nsec[1] = timeLookup(appHandle->pMDSndQueue, NULL);
+    nsec[2] = timeLookup(appHandle->pMDRcvQueue, &appHandle->mdRcvIndex);
+    nsec[3] = timeLookup(appHandle->pMDRcvQueue, NULL);
+    printf("MD %5u open sessions: caller %7.1f ns, linear %8.1f ns, replier %7.1f ns, linear %8.1f ns per lookup\n",
+           noOfSessions, nsec[0], nsec[1], nsec[2], nsec[3]);
+    if ((nsec[0] == 0.0) || (nsec[1] == 0.0) || (nsec[2] == 0.0) || (nsec[3] == 0.0))
+    {
+        printf("MD: open session not found\n");
+        return 1;
+    }
+
+    for (i = 0u; i < noOfSessions; i++)
+    {
+        if (tlm_reply(appHandle, (const TRDP_UUID_T *) &sReplierIds[i], BENCH_COMID, 0u, NULL, data,
+                      sizeof(data), NULL) != TRDP_NO_ERR)
+        {
+            printf("MD: tlm_reply() failed\n");
+            return 1;
+        }
+        if (((i + 1u) % BENCH_CHUNK) == 0u)
+        {
+            (void) processUntil(appHandle, &sNoOfReplies, i + 1u);
+        }
+    }
+    if (processUntil(appHandle, &sNoOfReplies, noOfSessions) == FALSE)
+    {
+        printf("MD: %u of %u replies received\n", sNoOfReplies, noOfSessions);
+        return 1;
+    }
+
+    /* all sessions must be closed and unindexed again */
+    (void) processUntil(appHandle, &sNoOfErrors, 1u);
+    if ((sNoOfErrors != 0u) || (appHandle->mdSndIndex.count != 0u) || (appHandle->mdRcvIndex.count != 0u))
+    {
+        printf("MD: %u errors, %u caller and %u replier sessions left\n",
+               sNoOfErrors, appHandle->mdSndIndex.count, appHandle->mdRcvIndex.count);
+        return 1;
+    }
+    return 0;
+}
+
+/* Open noOfSessions long requests, let BENCH_SHORT short ones time out on both sides, then reply the long ones */
+static int benchTimeouts (TRDP_APP_SESSION_T appHandle, UINT32 noOfSessions)
+{
+    UINT8               data[BENCH_DATA_SIZE];
+    TRDP_SEND_PARAM_T   sendParam = TRDP_MD_DEFAULT_SEND_PARAM;
+    TRDP_STATISTICS_T   stats;
+    VOS_TIMEVAL_T       start;
+    UINT32              i, noOfCycles = 0u;
+    double              usec = 0.0;
+    int                 rc = 0;
+
+    sNoOfRequests       = 0u;
+    sNoOfReplies        = 0u;
+    sNoOfErrors         = 0u;
+    sNoOfTimeouts       = 0u;
+    sNoOfAppTimeouts    = 0u;
+    sendParam.retries   = 0u;
+    memset(data, 0x33, sizeof(data));
+
+    for (i = 0u; i < noOfSessions + BENCH_SHORT; i++)
+    {
+        TRDP_UUID_T sessionId;
+
+        if (tlm_request(appHandle, NULL, NULL, &sessionId, BENCH_COMID, 0u, 0u, 0u, BENCH_LOOPBACK,
+                        TRDP_FLAGS_CALLBACK, 1u, (i < noOfSessions) ? BENCH_TIMEOUT : BENCH_SHORT_TIMEOUT,
+                        &sendParam, data, sizeof(data), NULL, NULL) != TRDP_NO_ERR)
+        {
+            printf("MD: tlm_request() failed\n");
+            return 1;
+        }
+        if (((i + 1u) % BENCH_CHUNK) == 0u)
+        {
+            (void) processUntil(appHandle, &sNoOfRequests, i + 1u);
+        }
+    }
+    if (processUntil(appHandle, &sNoOfRequests, noOfSessions + BENCH_SHORT) == FALSE)
+    {
+        printf("MD: %u of %u requests received\n", sNoOfRequests, noOfSessions + BENCH_SHORT);
+        return 1;
+    }
+
+    /* caller and replier side of the short requests time out, the cycles only handle those */
+    while ((sNoOfTimeouts < BENCH_SHORT) || (sNoOfAppTimeouts < BENCH_SHORT))
+    {
+        TRDP_FDS_T  rfds;
+        TRDP_TIME_T tv = {0, 0};
+        INT32       noDesc = 0;
+        INT32       rv = 0;
+
+        FD_ZERO(&rfds);
+        vos_getTime(&start);
+        (void) tlm_getInterval(appHandle, &tv, &rfds, &noDesc);
+        (void) tlm_process(appHandle, &rfds, &rv);
+        usec += elapsedUs(&start);
+        if (++noOfCycles > 10000u)
+        {
+            break;
+        }
+        (void) vos_threadDelay(1000u);
+    }
+    (void) tlc_getStatistics(appHandle, &stats);
+    printf("MD %5u open sessions: %8.2f us per cycle, %u/%u timeouts, %u timers (%u, %u, %u, %u)\n",
+           noOfSessions, usec / (double) noOfCycles, sNoOfTimeouts, sNoOfAppTimeouts, stats.mdTimer.numTimers,
+           stats.mdTimer.numPerLevel[0], stats.mdTimer.numPerLevel[1], stats.mdTimer.numPerLevel[2],
+           stats.mdTimer.numPerLevel[3]);
+    if ((sNoOfTimeouts != BENCH_SHORT) || (sNoOfAppTimeouts != BENCH_SHORT) ||
+        (stats.mdTimer.numTimers < 2u * noOfSessions))
+    {
+        rc = 1;
+    }
+
+    for (i = 0u; i < noOfSessions; i++)
+    {
+        (void) tlm_reply(appHandle, (const TRDP_UUID_T *) &sReplierIds[i], BENCH_COMID, 0u, NULL, data,
+                         sizeof(data), NULL);
+        if (((i + 1u) % BENCH_CHUNK) == 0u)
+        {
+            (void) processUntil(appHandle, &sNoOfReplies, i + 1u);
+        }
+    }
+    if (processUntil(appHandle, &sNoOfReplies, noOfSessions) == FALSE)
+    {
+        printf("MD: %u of %u replies received\n", sNoOfReplies, noOfSessions);
+        return 1;
+    }
+
+    /* no session, no timer and nothing armed left */
+    (void) processUntil(appHandle, &sNoOfErrors, 1u);
+    if ((sNoOfErrors != 0u) || (appHandle->mdSndIndex.count != 0u) || (appHandle->mdRcvIndex.count != 0u) ||
+        (appHandle->mdTimer.stats.numTimers != 0u) || (appHandle->mdTimer.stats.numReady != 0u))
+    {
+        printf("MD: %u errors, %u caller and %u replier sessions, %u timers, %u armed left\n",
+               sNoOfErrors, appHandle->mdSndIndex.count, appHandle->mdRcvIndex.count,
+               appHandle->mdTimer.stats.numTimers, appHandle->mdTimer.stats.numReady);
+        rc = 1;
+    }
+    return rc;
+}
+
+/* Send noOfFrames TCP notifications of dataSize bytes to the own TCP listener. Each one is sent before the next is
+   created, and only every chunk frames the receiver gets to read all of them at once. */
+static int benchTcp (TRDP_APP_SESSION_T appHandle, UINT32 dataSize, UINT32 noOfFrames, UINT32 chunk)
+{
+    static UINT8    data[TRDP_MAX_MD_DATA_SIZE];
+    VOS_TIMEVAL_T   start;
+    TRDP_FDS_T      noFds;
+    INT32           noOfReady;
+    UINT32          i;
+    double          usec = 0.0;
+
+    sNoOfTcp        = 0u;
+    sNoOfCorrupt    = 0u;
+    sNoOfErrors     = 0u;
+    sTcpSize        = dataSize;
+    sNoOfCycles     = 0u;
+
+    for (i = 0u; i < noOfFrames; i++)
+    {
+        memset(data, (int) (i & 0xFFu), dataSize);
+        TRDP_ERR_T err = tlm_notify(appHandle, NULL, NULL, BENCH_TCP_COMID, 0u, 0u, 0u, BENCH_LOOPBACK,
+                                    TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP, NULL, data, dataSize, NULL, NULL);
+        if (err != TRDP_NO_ERR)
+        {
+            printf("MD: tlm_notify() failed (Err: %d)\n", err);
+            return 1;
+        }
+        FD_ZERO(&noFds);
+        noOfReady = 0;
+        (void) tlm_process(appHandle, &noFds, &noOfReady);
+        /* wait for the first frame, a second connection would be opened while the first is still connecting */
+        if ((((i + 1u) % chunk) == 0u) || (i == 0u))
+        {
+            vos_getTime(&start);
+            (void) processUntil(appHandle, &sNoOfTcp, i + 1u);
+            usec += elapsedUs(&start);
+        }
+    }
+    if (processUntil(appHandle, &sNoOfTcp, noOfFrames) == FALSE)
+    {
+        printf("MD: %u of %u TCP notifications received\n", sNoOfTcp, noOfFrames);
+        return 1;
+    }
+
+    /* only the receiving side is timed */
+    printf("MD %5u TCP frames of %5u bytes: %8.2f us and %5.2f cycles per frame, %u corrupt, %u errors\n",
+           noOfFrames, dataSize, usec / (double) noOfFrames, (double) sNoOfCycles / (double) noOfFrames,
+           sNoOfCorrupt, sNoOfErrors);
+    return ((sNoOfCorrupt != 0u) || (sNoOfErrors != 0u)) ? 1 : 0;
+}
+
+/* Send noOfFrames TCP notifications of dataSize bytes, every burst of them queued without processing in between. The
+   frames of a burst go out coalesced on the next process cycle, a full send queue is reported by tlm_notify() and
+   drained by processing. Only processing is timed, sending and receiving side together. */
+static int benchTcpBurst (TRDP_APP_SESSION_T appHandle, UINT32 dataSize, UINT32 noOfFrames, UINT32 burst)
+{
+    static UINT8    data[TRDP_MAX_MD_DATA_SIZE];
+    VOS_TIMEVAL_T   start;
+    TRDP_FDS_T      noFds;
+    INT32           noOfReady;
+    UINT32          i;
+    UINT32          noOfFull = 0u;
+    double          usec = 0.0;
+
+    sNoOfTcp        = 0u;
+    sNoOfCorrupt    = 0u;
+    sNoOfErrors     = 0u;
+    sTcpSize        = dataSize;
+    sNoOfCycles     = 0u;
+
+    /* the connection has to be up before a burst shares it */
+    memset(data, 0, dataSize);
+    if ((tlm_notify(appHandle, NULL, NULL, BENCH_TCP_COMID, 0u, 0u, 0u, BENCH_LOOPBACK,
+                    TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP, NULL, data, dataSize, NULL, NULL) != TRDP_NO_ERR)
+        || (processUntil(appHandle, &sNoOfTcp, 1u) == FALSE))
+    {
+        printf("MD: first TCP notification failed\n");
+        return 1;
+    }
+    sNoOfCycles = 0u;
+
+    for (i = 1u; i <= noOfFrames; )
+    {
+        TRDP_ERR_T err;
+
+        memset(data, (int) (i & 0xFFu), dataSize);
+        err = tlm_notify(appHandle, NULL, NULL, BENCH_TCP_COMID, 0u, 0u, 0u, BENCH_LOOPBACK,
+                         TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP, NULL, data, dataSize, NULL, NULL);
+        if (err == TRDP_QUEUE_FULL_ERR)
+        {
+            /* backpressure: let the receiver catch up */
+            noOfFull++;
+            vos_getTime(&start);
+            FD_ZERO(&noFds);
+            noOfReady = 0;
+            (void) tlm_process(appHandle, &noFds, &noOfReady);
+            if (processUntil(appHandle, &sNoOfTcp, sNoOfTcp + 1u) == FALSE)
+            {
+                printf("MD: TCP send queue does not drain\n");
+                return 1;
+            }
+            usec += elapsedUs(&start);
+            continue;
+        }
+        if (err != TRDP_NO_ERR)
+        {
+            printf("MD: tlm_notify() failed (Err: %d)\n", err);
+            return 1;
+        }
+        if ((i % burst) == 0u)
+        {
+            /* send right away, then wait for the receiver */
+            vos_getTime(&start);
+            FD_ZERO(&noFds);
+            noOfReady = 0;
+            (void) tlm_process(appHandle, &noFds, &noOfReady);
+            (void) processUntil(appHandle, &sNoOfTcp, i + 1u);
+            usec += elapsedUs(&start);
+        }
+        i++;
+    }
+    if (processUntil(appHandle, &sNoOfTcp, noOfFrames + 1u) == FALSE)
+    {
+        printf("MD: %u of %u TCP notifications received\n", sNoOfTcp - 1u, noOfFrames);
+        return 1;
+    }
+
+    printf("MD %5u TCP frames of %5u bytes, bursts of %4u: %8.2f us and %5.2f cycles per frame, %u queue full, "
+           "%u corrupt, %u errors\n",
+           noOfFrames, dataSize, burst, usec / (double) noOfFrames, (double) sNoOfCycles / (double) noOfFrames,
+           noOfFull, sNoOfCorrupt, sNoOfErrors);
+    return ((sNoOfCorrupt != 0u) || (sNoOfErrors != 0u)) ? 1 : 0;
+}
+
+/* Notify noOfListeners comId listeners, every other one also filtering on a URI */
+/* Find the listener of each message of the notification run, through the index or (no buckets) along the queue.
+   Returns the time per lookup [ns], 0 if a message found the wrong listener */
+static double timeDispatch (TRDP_APP_SESSION_T appHandle, UINT32 noOfListeners)
+{
+    MD_ELE_T        rcvEle;
+    MD_ELE_T        *pSavedEle = appHandle->pMDRcvEle;
+    VOS_TIMEVAL_T   start;
+    UINT32          i;
+    double          usec = 0.0;
+
+    /* the addresses of the received message */
+    memset(&rcvEle, 0, sizeof(rcvEle));
+    rcvEle.addr.srcIpAddr   = BENCH_LOOPBACK;
+    rcvEle.addr.destIpAddr  = BENCH_LOOPBACK;
+    appHandle->pMDRcvEle    = &rcvEle;
+
+    vos_getTime(&start);
+    for (i = 0u; i < BENCH_LOOKUPS; i++)
+    {
+        UINT32 j = i % noOfListeners;
+
+        if (trdp_mdFindListener(appHandle, FALSE, &sLisHeaders[j]) != sLisHandles[j])
+        {
+            break;
+        }
+    }
+    if (i == BENCH_LOOKUPS)
+    {
+        usec = elapsedUs(&start);
+    }
+    appHandle->pMDRcvEle = pSavedEle;
+    return usec * 1000.0 / (double) BENCH_LOOKUPS;
+}
+
+static int benchListeners (TRDP_APP_SESSION_T appHandle, UINT32 noOfListeners)
+{
+    UINT8           data[BENCH_DATA_SIZE];
+    TRDP_LIS_T      anyHandle, uriHandle;
+    TRDP_URI_USER_T uri;
+    TRDP_URI_USER_T anyUri = "any";
+    MD_LIS_ELE_T    * *ppBuckets;
+    UINT32          i;
+    double          nsec[2];
+    int             rc = 0;
+
+    sNoOfListeners  = noOfListeners;
+    sNoOfNotifies   = 0u;
+    sNoOfMisrouted  = 0u;
+    memset(data, 0xAA, sizeof(data));
+
+    /* oldest: takes what nobody else wants, newest: takes URI "any" regardless of the comId */
+    (void) tlm_addListener(appHandle, &anyHandle, (const void *) (uintptr_t) BENCH_REF_ANY, NULL, FALSE, 0u, 0u, 0u,
+                           VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL, NULL);
+    for (i = 0u; i < noOfListeners; i++)
+    {
+        (void) snprintf(uri, sizeof(uri), "dev%u", i);
+        if (tlm_addListener(appHandle, &sLisHandles[i], (const void *) (uintptr_t) (i + 1u), NULL, TRUE,
+                            BENCH_LIS_COMID + i, 0u, 0u, VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY,
+                            TRDP_FLAGS_CALLBACK, NULL, ((i & 1u) != 0u) ? uri : NULL) != TRDP_NO_ERR)
+        {
+            printf("MD: tlm_addListener() failed\n");
+            return 1;
+        }
+    }
+    (void) tlm_addListener(appHandle, &uriHandle, (const void *) (uintptr_t) BENCH_REF_URI, NULL, FALSE, 0u, 0u, 0u,
+                           VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL, anyUri);
+
+    for (i = 0u; i < noOfListeners; i++)
+    {
+        /* URIs are compared case insensitive */
+        (void) snprintf(uri, sizeof(uri), "DEV%u", i);
+        memset(&sLisHeaders[i], 0, sizeof(MD_HEADER_T));
+        sLisHeaders[i].msgType  = vos_htons(TRDP_MSG_MN);
+        sLisHeaders[i].comId    = vos_htonl(BENCH_LIS_COMID + i);
+        if ((i & 1u) != 0u)
+        {
+            memcpy(sLisHeaders[i].destinationURI, uri, strlen(uri));
+        }
+        (void) tlm_notify(appHandle, NULL, NULL, BENCH_LIS_COMID + i, 0u, 0u, 0u, BENCH_LOOPBACK,
+                          TRDP_FLAGS_CALLBACK, NULL, data, sizeof(data), NULL, ((i & 1u) != 0u) ? uri : NULL);
+        if (((i + 1u) % BENCH_CHUNK) == 0u)
+        {
+            (void) processUntil(appHandle, &sNoOfNotifies, i + 1u);
+        }
+    }
+    if (processUntil(appHandle, &sNoOfNotifies, noOfListeners) == FALSE)
+    {
+        printf("MD: %u of %u notifications received\n", sNoOfNotifies, noOfListeners);
+        rc = 1;
+    }
+
+    /* wildcards: unknown comId, known comId with the URI "any" */
+    (void) tlm_notify(appHandle, NULL, NULL, BENCH_LIS_COMID + noOfListeners, 0u, 0u, 0u, BENCH_LOOPBACK,
+                      TRDP_FLAGS_CALLBACK, NULL, data, sizeof(data), NULL, NULL);
+    (void) snprintf(uri, sizeof(uri), "ANY");
+    (void) tlm_notify(appHandle, NULL, NULL, BENCH_LIS_COMID, 0u, 0u, 0u, BENCH_LOOPBACK,
+                      TRDP_FLAGS_CALLBACK, NULL, data, sizeof(data), NULL, uri);
+    if (processUntil(appHandle, &sNoOfNotifies, noOfListeners + 2u) == FALSE)
+    {
+        printf("MD: wildcard notifications not received\n");
+        rc = 1;
+    }
+
+    /* the same messages looked up directly, then with the fallback of a session without listener index */
+    nsec[0]     = timeDispatch(appHandle, noOfListeners);
+    ppBuckets   = appHandle->mdLisIndex.ppBuckets;
+    appHandle->mdLisIndex.ppBuckets = NULL;
+    nsec[1]     = timeDispatch(appHandle, noOfListeners);
+    appHandle->mdLisIndex.ppBuckets = ppBuckets;
+
+    printf("MD %5u listeners    : %7.1f ns, linear %8.1f ns per lookup, %u misrouted\n",
+           noOfListeners, nsec[0], nsec[1], sNoOfMisrouted);
+    if ((sNoOfMisrouted != 0u) || (nsec[0] == 0.0) || (nsec[1] == 0.0))
+    {
+        rc = 1;
+    }
+
+    for (i = 0u; i < noOfListeners; i++)
+    {
+        (void) tlm_delListener(appHandle, sLisHandles[i]);
+    }
+    (void) tlm_delListener(appHandle, anyHandle);
+    (void) tlm_delListener(appHandle, uriHandle);
+    return rc;
+}
+
+/**********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+    TRDP_MEM_CONFIG_T       memConfig   = {NULL, BENCH_MEM_SIZE, {0}};
+    TRDP_MD_CONFIG_T        mdConfig    = {mdCallback, NULL, TRDP_MD_DEFAULT_SEND_PARAM, TRDP_FLAGS_CALLBACK,
+                                           BENCH_TIMEOUT, BENCH_TIMEOUT, BENCH_TIMEOUT, BENCH_TIMEOUT,
+                                           TRDP_MD_UDP_PORT, TRDP_MD_TCP_PORT, 2u * BENCH_MAX_SESSIONS, TRUE};
+    TRDP_PROCESS_CONFIG_T   procConfig  = {"MdBench", "", 0u, 0u, TRDP_OPTION_NONE};
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_LIS_T              listenHandle;
+    TRDP_LIS_T              tcpHandle;
+    UINT32                  noOfSessions;
+    int                     rc = 0;
+
+    (void) argc;
+    (void) argv;
+
+    if (tlc_init(dbgOut, NULL, &memConfig) != TRDP_NO_ERR)
+    {
+        printf("tlc_init() failed\n");
+        return 1;
+    }
+    if (tlc_openSession(&appHandle, BENCH_LOOPBACK, 0u, NULL, NULL, &mdConfig, &procConfig) != TRDP_NO_ERR)
+    {
+        printf("MD: tlc_openSession() failed\n");
+        (void) tlc_terminate();
+        return 1;
+    }
+    if (tlm_addListener(appHandle, &listenHandle, NULL, NULL, TRUE, BENCH_COMID, 0u, 0u, VOS_INADDR_ANY,
+                        VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL, NULL) != TRDP_NO_ERR)
+    {
+        printf("MD: tlm_addListener() failed\n");
+        (void) tlc_closeSession(appHandle);
+        (void) tlc_terminate();
+        return 1;
+    }
+
+    rc = checkTimerWheel();
+    printf("MD benchmark, session lookup by sessionID\n");
+    for (noOfSessions = 10u; (noOfSessions <= BENCH_MAX_SESSIONS) && (rc == 0); noOfSessions *= 10u)
+    {
+        rc = benchSessions(appHandle, noOfSessions);
+    }
+    printf("MD benchmark, timeouts by the timer wheel\n");
+    for (noOfSessions = 10u; (noOfSessions <= BENCH_MAX_SESSIONS) && (rc == 0); noOfSessions *= 10u)
+    {
+        rc = benchTimeouts(appHandle, noOfSessions);
+    }
+    printf("MD benchmark, listener dispatch by comId and URI\n");
+    for (noOfSessions = 10u; (noOfSessions <= BENCH_MAX_LISTENERS) && (rc == 0); noOfSessions *= 10u)
+    {
+        rc = benchListeners(appHandle, noOfSessions);
+    }
+    printf("MD benchmark, TCP receive buffer\n");
+    if ((rc == 0) &&
+        (tlm_addListener(appHandle, &tcpHandle, NULL, NULL, TRUE, BENCH_TCP_COMID, 0u, 0u, VOS_INADDR_ANY,
+                         VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP, NULL, NULL) == TRDP_NO_ERR))
+    {
+        rc = benchTcp(appHandle, BENCH_DATA_SIZE, BENCH_TCP_SMALL, BENCH_CHUNK);
+        if (rc == 0)
+        {
+            rc = benchTcp(appHandle, TRDP_MAX_MD_DATA_SIZE, BENCH_TCP_BLOBS, 1u);
+        }
+        if (rc == 0)
+        {
+            /* sizes around the receive buffer and odd lengths */
+            rc = benchTcp(appHandle, TRDP_MD_TCP_RCV_SIZE - 4u - (UINT32) sizeof(MD_HEADER_T), 20u, 2u);
+        }
+        if (rc == 0)
+        {
+            rc = benchTcp(appHandle, 12345u, 99u, 3u);
+        }
+        if (rc == 0)
+        {
+            printf("MD benchmark, TCP send queue\n");
+            rc = benchTcpBurst(appHandle, BENCH_DATA_SIZE, BENCH_TCP_BURST, 1u);
+        }
+        if (rc == 0)
+        {
+            rc = benchTcpBurst(appHandle, BENCH_DATA_SIZE, BENCH_TCP_BURST, BENCH_TCP_BURST);
+        }
+        if (rc == 0)
+        {
+            /* more than the send queue holds per process cycle */
+            rc = benchTcpBurst(appHandle, 4000u, 1000u, 1000u);
+        }
+
+        /* the same with the event driven loop, if this build supports it */
+        {
+            TRDP_TIME_T noWait = {0, 0};
+
+            if ((rc == 0) && (tlc_processEvents(appHandle, &noWait) == TRDP_NO_ERR))
+            {
+                sUseEvents = TRUE;
+                printf("MD benchmark, tlc_processEvents\n");
+                rc = benchSessions(appHandle, 100u);
+                if (rc == 0)
+                {
+                    rc = benchTcp(appHandle, BENCH_DATA_SIZE, BENCH_TCP_SMALL, BENCH_CHUNK);
+                }
+                if (rc == 0)
+                {
+                    rc = benchTcp(appHandle, TRDP_MAX_MD_DATA_SIZE, BENCH_TCP_BLOBS, 1u);
+                }
+                if (rc == 0)
+                {
+                    rc = benchTcpBurst(appHandle, BENCH_DATA_SIZE, BENCH_TCP_BURST, BENCH_TCP_BURST);
+                }
+                sUseEvents = FALSE;
+            }
+        }
+        (void) tlm_delListener(appHandle, tcpHandle);
+    }
+    else if (rc == 0)
+    {
+        printf("MD: tlm_addListener() failed\n");
+        rc = 1;
+    }
+
+    (void) tlm_delListener(appHandle, listenHandle);
+    (void) tlc_closeSession(appHandle);
+    (void) tlc_terminate();
+    return rc;
+}
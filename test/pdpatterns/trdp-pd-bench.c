@@ -0,0 +1,1291 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-pd-bench.c
+ *
+ * @brief           Benchmark for PD reception and transmission on loopback
+ *
+ * @details         Sends bursts of valid PD frames to the loopback interface and measures the time needed to drain
+ *                  them, first on VOS level (single vs. batched receive), then through the complete stack
+ *                  (tlc_process with batched reception, tlp_processReceive for HIGH_PERF_INDEXED). The send side is
+ *                  compared on VOS level (single vs. batched send, best of alternating runs). The read path compares
+ *                  tlp_get() into a maximum size buffer with tlp_getRef()/tlp_releaseRef(), for small and for maximum
+ *                  size frames. Lent data must not be overwritten by newer frames.
+ *                  The stack run is repeated with a fixed footprint session (tlc_presetArenaSession), which must not
+ *                  allocate memory after tlc_updateSession, and with the event driven loop (tlc_processEvents), which
+ *                  must receive every frame and wake up for a subscription time out. The cost of finding one readable
+ *                  socket among many idle ones is compared on VOS level (vos_select vs. vos_pollWait).
+ *                  HIGH_PERF_INDEXED builds also send cyclic PDs through tlp_processSend(), frame by frame and in
+ *                  batches, and check the send counters against the frames received.
+ *                  Zero-copy writing (tlp_putBegin/tlp_putCommit) must send the previous data until the commit,
+ *                  take over a changed size, reject misuse and not allocate in steady state. Its cost for a maximum
+ *                  size payload is compared with tlp_put().
+ *                  The duplicate detection of one subscription is timed for up to 256 senders, the time per frame
+ *                  must not depend on their number. Beyond the table size the least recently heard sender is dropped.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *      AG 2026-10-17: VOS level send as the best of alternating runs, gain of the batched send printed
+ *      AG 2026-10-17: Sequence counter eviction timed
+ *      AG 2026-10-17: Read path also for 1432 byte frames, best of alternating runs
+ *      AG 2026-10-17: tlp_put() against tlp_putBegin()/tlp_putCommit() as the best of alternating runs
+ *      AG 2026-10-17: Sequence counter list growing into the full size arena slab
+ *      AG 2026-10-17: Senders evicted from a full sequence counter table are counted
+ *      AG 2026-10-17: tlp_putBegin()/tlp_putCommit() checked and timed against tlp_put()
+ *      AG 2026-10-17: HIGH_PERF_INDEXED: tlp_processSend() with and without batches, send counters checked
+ *      AG 2026-10-17: HIGH_PERF_INDEXED: stack run with tlp_getInterval()/tlp_processReceive()
+ *      AG 2026-10-17: Duplicate detection benchmark (sequence counter table, 256 senders on one comId)
+ *      AG 2026-10-17: Event driven stack run (tlc_processEvents), VOS level select vs. poll set with idle sockets
+ *      AG 2026-10-17: Stack run with session arena, memory blocks allocated during the run
+ *      AG 2026-10-17: Read path benchmark (tlp_get vs. tlp_getRef)
+ *      AG 2026-10-17: VOS level send benchmark (vos_sockSendUDPBatch)
+ *      AG 2026-10-17: Created
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trdp_if_light.h"
+#include "trdp_private.h"
+#include "trdp_utils.h"
+#include "vos_utils.h"
+#include "vos_sock.h"
+
+/* --- defines ----------------------------------------------------------------*/
+
+#define BENCH_LOOPBACK      0x7F000001u     /* 127.0.0.1                                */
+#define BENCH_VOS_PORT      17230u          /* port for the VOS level test              */
+#define BENCH_BURST         64u             /* frames sent before draining              */
+#define BENCH_DATA_SIZE     64u             /* payload of each frame                    */
+#define BENCH_COMID_BASE    10000u
+#define BENCH_MEM_SIZE      (4u * 1024u * 1024u)
+#define BENCH_READ_LOOPS    40000u          /* reads per variant and run                */
+#define BENCH_RUNS          5u              /* alternating runs, the best one counts    */
+#define BENCH_IDLE_SOCKETS  255u            /* idle sockets next to the active one      */
+#define BENCH_POLL_LOOPS    20000u          /* wake ups per variant                     */
+#define BENCH_TO_COMID      19999u          /* subscription which times out             */
+#define BENCH_TO_TIMEOUT    30000u          /* its time out [us]                        */
+#define BENCH_SENDERS       256u            /* senders of one comId                     */
+#define BENCH_SENDER_BASE   0x0A000001u     /* 10.0.0.1, first sender                   */
+#define BENCH_SEQ_CHECKS    1000000u        /* sequence counter checks per variant      */
+#define BENCH_TX_DEST       0x7F000002u     /* 127.0.0.2, the session binds 127.0.0.1   */
+#define BENCH_TX_PORT       17231u          /* destination of the published PDs         */
+#define BENCH_TX_PUBS       100u            /* cyclic PDs published, index table < 128k */
+#define BENCH_TX_CYCLES     2000u           /* tlp_processSend() calls per variant      */
+#define BENCH_TX_CYCLE      1000u           /* process cycle and PD interval [us]       */
+#define BENCH_PUT_COMID     20000u          /* publication written with tlp_putBegin()  */
+#define BENCH_PUT_CYCLE     10000u          /* its interval [us]                        */
+#define BENCH_PUT_LOOPS     40000u          /* updates per variant and run              */
+
+#ifdef HIGH_PERF_INDEXED
+#define STACK_PROCESS       "tlp_processReceive"
+#else
+#define STACK_PROCESS       "tlc_process"
+#endif
+
+/* --- globals ----------------------------------------------------------------*/
+
+static PD_PACKET_T  sFrames[BENCH_BURST];
+static UINT32       sDataSize = BENCH_DATA_SIZE;    /* payload of the frames sent */
+static UINT32       sSeqCnt = 0u;
+static TRDP_SUB_T   sSubHandles[BENCH_BURST];
+
+/* --- local functions --------------------------------------------------------*/
+
+static void dbgOut (void *pRefCon, TRDP_LOG_T category, const CHAR8 *pTime, const CHAR8 *pFile, UINT16 lineNumber,
+                    const CHAR8 *pMsgStr)
+{
+    if (category == VOS_LOG_ERROR)
+    {
+        printf("%s %s:%u %s", pTime, pFile, (unsigned int) lineNumber, pMsgStr);
+    }
+}
+
+/* Prepare one burst of PD frames with consecutive comIds and fresh sequence counters */
+static void prepareBurst (UINT32 noOfComIds)
+{
+    UINT32 i;
+
+    for (i = 0u; i < BENCH_BURST; i++)
+    {
+        PD_HEADER_T *pHead = &sFrames[i].frameHead;
+        UINT32      myCRC;
+
+        sSeqCnt++;
+        memset(pHead, 0, sizeof(PD_HEADER_T));
+        pHead->sequenceCounter  = vos_htonl(sSeqCnt);
+        pHead->protocolVersion  = vos_htons(TRDP_PROTO_VER);
+        pHead->msgType          = vos_htons(TRDP_MSG_PD);
+        pHead->comId            = vos_htonl(BENCH_COMID_BASE + (i % noOfComIds));
+        pHead->datasetLength    = vos_htonl(sDataSize);
+        memset(sFrames[i].data, (int) (sSeqCnt & 0xFFu), sDataSize);
+        myCRC = vos_crc32(INITFCS, (UINT8 *) pHead, sizeof(PD_HEADER_T) - SIZE_OF_FCS);
+        pHead->frameCheckSum = MAKE_LE(myCRC);
+    }
+}
+
+static void sendBurst (SOCKET sock, UINT16 port)
+{
+    UINT32 i;
+
+    for (i = 0u; i < BENCH_BURST; i++)
+    {
+        UINT32 size = sizeof(PD_HEADER_T) + sDataSize;
+        (void) vos_sockSendUDP(sock, (UINT8 *) &sFrames[i], &size, BENCH_LOOPBACK, port);
+    }
+}
+
+static void sendBurstBatched (SOCKET sock, UINT16 port)
+{
+    VOS_SOCK_MSG_T  msgs[VOS_MAX_SOCK_BATCH];
+    UINT32          i, j;
+
+    for (i = 0u; i < BENCH_BURST; i += VOS_MAX_SOCK_BATCH)
+    {
+        UINT32 noOfMsgs = 0u;
+
+        for (j = i; (j < BENCH_BURST) && (noOfMsgs < VOS_MAX_SOCK_BATCH); j++)
+        {
+            msgs[noOfMsgs].pBuffer      = (UINT8 *) &sFrames[j];
+            msgs[noOfMsgs].size         = sizeof(PD_HEADER_T) + sDataSize;
+            msgs[noOfMsgs].dstIPAddr    = BENCH_LOOPBACK;
+            msgs[noOfMsgs].dstIPPort    = port;
+            noOfMsgs++;
+        }
+        (void) vos_sockSendUDPBatch(sock, msgs, &noOfMsgs);
+    }
+}
+
+static double elapsedUs (const VOS_TIMEVAL_T *pStart)
+{
+    VOS_TIMEVAL_T now;
+    vos_getTime(&now);
+    vos_subTime(&now, pStart);
+    return (double) now.tv_sec * 1000000.0 + (double) now.tv_usec;
+}
+
+/* Drain a socket with single or batched receive calls, returns the number of frames read */
+static UINT32 drain (SOCKET sock, BOOL8 batched, UINT32 *pNoOfCalls)
+{
+    static UINT8    buffers[VOS_MAX_SOCK_BATCH][TRDP_MAX_PD_PACKET_SIZE];
+    VOS_SOCK_MSG_T  msgs[VOS_MAX_SOCK_BATCH];
+    UINT32          count = 0u;
+    UINT32          i;
+
+    for (;;)
+    {
+        UINT32 noOfMsgs = VOS_MAX_SOCK_BATCH;
+
+        for (i = 0u; i < VOS_MAX_SOCK_BATCH; i++)
+        {
+            msgs[i].pBuffer = buffers[i];
+            msgs[i].size    = TRDP_MAX_PD_PACKET_SIZE;
+        }
+        (*pNoOfCalls)++;
+        if (batched == TRUE)
+        {
+            if (vos_sockReceiveUDPBatch(sock, msgs, &noOfMsgs) != VOS_NO_ERR)
+            {
+                break;
+            }
+        }
+        else
+        {
+            noOfMsgs = 1u;
+            if (vos_sockReceiveUDP(sock, msgs[0].pBuffer, &msgs[0].size, &msgs[0].srcIPAddr, NULL,
+                                   &msgs[0].dstIPAddr, FALSE) != VOS_NO_ERR)
+            {
+                break;
+            }
+        }
+        count += noOfMsgs;
+    }
+    return count;
+}
+
+/* VOS level: compare vos_sockReceiveUDP against vos_sockReceiveUDPBatch */
+static void benchVOS (UINT32 noOfFrames)
+{
+    VOS_SOCK_OPT_T  opts;
+    SOCKET          rcvSock, sndSock;
+    int             pass;
+
+    memset(&opts, 0, sizeof(opts));
+    opts.nonBlocking    = TRUE;
+    opts.reuseAddrPort  = TRUE;
+
+    if ((vos_sockOpenUDP(&rcvSock, &opts) != VOS_NO_ERR) ||
+        (vos_sockBind(rcvSock, BENCH_LOOPBACK, BENCH_VOS_PORT) != VOS_NO_ERR) ||
+        (vos_sockOpenUDP(&sndSock, &opts) != VOS_NO_ERR))
+    {
+        printf("VOS: opening sockets failed\n");
+        return;
+    }
+
+    for (pass = 0; pass < 2; pass++)
+    {
+        BOOL8           batched = (pass == 1) ? TRUE : FALSE;
+        UINT32          received = 0u, calls = 0u, sent = 0u;
+        double          usec = 0.0;
+
+        while (sent < noOfFrames)
+        {
+            VOS_TIMEVAL_T start;
+            prepareBurst(BENCH_BURST);
+            sendBurst(sndSock, BENCH_VOS_PORT);
+            sent += BENCH_BURST;
+            vos_getTime(&start);
+            received += drain(rcvSock, batched, &calls);
+            usec += elapsedUs(&start);
+        }
+        printf("VOS   %-23s: %8u frames, %8u calls, %10.0f frames/s\n",
+               batched ? "vos_sockReceiveUDPBatch" : "vos_sockReceiveUDP",
+               received, calls, (usec > 0.0) ? (double) received * 1000000.0 / usec : 0.0);
+    }
+    (void) vos_sockClose(rcvSock);
+    (void) vos_sockClose(sndSock);
+}
+
+/* VOS level: find the one readable socket among idle ones, vos_select() over all vs. vos_pollWait() */
+static int benchVOSPoll (void)
+{
+    static SOCKET       socks[BENCH_IDLE_SOCKETS + 1u];
+    VOS_SOCK_OPT_T      opts;
+    VOS_POLL_T          pollSet = NULL;
+    VOS_POLL_EVENT_T    events[4];
+    SOCKET              sndSock, highDesc = 0;
+    UINT8               buffer[64];
+    UINT32              i, loop, found[2] = {0u, 0u};
+    double              usec[2] = {0.0, 0.0};
+    int                 pass, rc = 0;
+
+    memset(&opts, 0, sizeof(opts));
+    opts.nonBlocking    = TRUE;
+    opts.reuseAddrPort  = TRUE;
+
+    if ((vos_sockOpenUDP(&sndSock, &opts) != VOS_NO_ERR) ||
+        (vos_pollCreate(&pollSet, BENCH_IDLE_SOCKETS + 1u) != VOS_NO_ERR))
+    {
+        printf("VOS: poll set not available\n");
+        return 0;
+    }
+    for (i = 0u; i <= BENCH_IDLE_SOCKETS; i++)
+    {
+        if ((vos_sockOpenUDP(&socks[i], &opts) != VOS_NO_ERR) ||
+            (vos_sockBind(socks[i], BENCH_LOOPBACK, (UINT16) (BENCH_VOS_PORT + 1u + i)) != VOS_NO_ERR) ||
+            (vos_pollAdd(pollSet, socks[i], i) != VOS_NO_ERR))
+        {
+            printf("VOS: opening socket %u failed\n", i);
+            return 1;
+        }
+        if (socks[i] > highDesc)
+        {
+            highDesc = socks[i];
+        }
+    }
+
+    for (pass = 0; pass < 2; pass++)
+    {
+        for (loop = 0u; loop < BENCH_POLL_LOOPS; loop++)
+        {
+            VOS_TIMEVAL_T   start;
+            VOS_TIMEVAL_T   tv = {0, 0};
+            UINT32          size = sizeof(buffer);
+            SOCKET          active = socks[loop % (BENCH_IDLE_SOCKETS + 1u)];
+
+            (void) vos_sockSendUDP(sndSock, buffer, &size, BENCH_LOOPBACK,
+                                   (UINT16) (BENCH_VOS_PORT + 1u + loop % (BENCH_IDLE_SOCKETS + 1u)));
+            vos_getTime(&start);
+            if (pass == 0)
+            {
+                VOS_FDS_T   rfds;
+                INT32       ready;
+
+                FD_ZERO(&rfds);
+                for (i = 0u; i <= BENCH_IDLE_SOCKETS; i++)
+                {
+                    FD_SET(socks[i], &rfds);
+                }
+                ready = vos_select(highDesc + 1, &rfds, NULL, NULL, &tv);
+                for (i = 0u; (ready > 0) && (i <= BENCH_IDLE_SOCKETS); i++)
+                {
+                    if (FD_ISSET(socks[i], &rfds))
+                    {
+                        size = sizeof(buffer);
+                        if ((socks[i] == active) &&
+                            (vos_sockReceiveUDP(socks[i], buffer, &size, NULL, NULL, NULL, FALSE) == VOS_NO_ERR))
+                        {
+                            found[pass]++;
+                        }
+                        ready--;
+                    }
+                }
+            }
+            else
+            {
+                UINT32 noOfEvents = 4u;
+
+                (void) vos_pollWait(pollSet, events, &noOfEvents, &tv);
+                for (i = 0u; i < noOfEvents; i++)
+                {
+                    size = sizeof(buffer);
+                    if ((events[i].sock == active) &&
+                        (events[i].ref == loop % (BENCH_IDLE_SOCKETS + 1u)) &&
+                        (vos_sockReceiveUDP(events[i].sock, buffer, &size, NULL, NULL, NULL, FALSE) == VOS_NO_ERR))
+                    {
+                        found[pass]++;
+                    }
+                }
+            }
+            usec[pass] += elapsedUs(&start);
+        }
+        printf("VOS   %-23s: %8u of %8u found, %u idle sockets, %8.2f us per wake up\n",
+               (pass == 0) ? "vos_select" : "vos_pollWait", found[pass], BENCH_POLL_LOOPS, BENCH_IDLE_SOCKETS,
+               usec[pass] / (double) BENCH_POLL_LOOPS);
+        /* the datagram is on the loopback before the wait: every one must be found */
+        if (found[pass] != BENCH_POLL_LOOPS)
+        {
+            rc = 1;
+        }
+    }
+
+    (void) vos_pollDestroy(pollSet);
+    for (i = 0u; i <= BENCH_IDLE_SOCKETS; i++)
+    {
+        (void) vos_sockClose(socks[i]);
+    }
+    (void) vos_sockClose(sndSock);
+    return rc;
+}
+
+/* VOS level: compare vos_sockSendUDP against vos_sockSendUDPBatch, best of alternating runs */
+static void benchVOSSend (UINT32 noOfFrames)
+{
+    VOS_SOCK_OPT_T  opts;
+    SOCKET          rcvSock, sndSock;
+    double          best[2] = {0.0, 0.0};
+    UINT32          run;
+    int             pass;
+
+    memset(&opts, 0, sizeof(opts));
+    opts.nonBlocking    = TRUE;
+    opts.reuseAddrPort  = TRUE;
+
+    if ((vos_sockOpenUDP(&rcvSock, &opts) != VOS_NO_ERR) ||
+        (vos_sockBind(rcvSock, BENCH_LOOPBACK, BENCH_VOS_PORT) != VOS_NO_ERR) ||
+        (vos_sockOpenUDP(&sndSock, &opts) != VOS_NO_ERR))
+    {
+        printf("VOS: opening sockets failed\n");
+        return;
+    }
+
+    for (run = 0u; run < BENCH_RUNS; run++)
+    {
+        for (pass = 0; pass < 2; pass++)
+        {
+            BOOL8   batched = (pass == 1) ? TRUE : FALSE;
+            UINT32  received = 0u, calls = 0u, sent = 0u;
+            double  usec = 0.0;
+
+            while (sent < noOfFrames)
+            {
+                VOS_TIMEVAL_T start;
+                prepareBurst(BENCH_BURST);
+                vos_getTime(&start);
+                if (batched == TRUE)
+                {
+                    sendBurstBatched(sndSock, BENCH_VOS_PORT);
+                }
+                else
+                {
+                    sendBurst(sndSock, BENCH_VOS_PORT);
+                }
+                usec += elapsedUs(&start);
+                sent += BENCH_BURST;
+                received += drain(rcvSock, TRUE, &calls);
+            }
+            if ((received == sent) && (usec > 0.0) && (((double) sent * 1000000.0 / usec) > best[pass]))
+            {
+                best[pass] = (double) sent * 1000000.0 / usec;
+            }
+        }
+    }
+    for (pass = 0; pass < 2; pass++)
+    {
+        printf("VOS   %-23s: %8u frames, %5u runs, %10.0f frames/s (best)\n",
+               (pass == 1) ? "vos_sockSendUDPBatch" : "vos_sockSendUDP", noOfFrames, BENCH_RUNS, best[pass]);
+    }
+    printf("VOS   %-23s: %+7.1f %%\n", "batched send gain",
+           (best[0] > 0.0) ? (best[1] / best[0] - 1.0) * 100.0 : 0.0);
+    (void) vos_sockClose(rcvSock);
+    (void) vos_sockClose(sndSock);
+}
+
+/* Read path: copy into a maximum size buffer vs. borrowing the received frame, best of alternating runs */
+static void benchRead (TRDP_APP_SESSION_T appHandle, UINT32 noOfComIds)
+{
+    UINT8           buffer[TRDP_MAX_PD_DATA_SIZE];
+    VOS_TIMEVAL_T   start;
+    UINT32          i, run, ok = 0u, okRef = 0u;
+    UINT32          sum = 0u;
+    double          usec, usecGet = 0.0, usecRef = 0.0;
+
+    for (run = 0u; run < BENCH_RUNS; run++)
+    {
+        ok = 0u;
+        vos_getTime(&start);
+        for (i = 0u; i < BENCH_READ_LOOPS; i++)
+        {
+            UINT32 dataSize = sizeof(buffer);
+            if (tlp_get(appHandle, sSubHandles[i % noOfComIds], NULL, buffer, &dataSize) == TRDP_NO_ERR)
+            {
+                sum += buffer[dataSize - 1u];
+                ok++;
+            }
+        }
+        usec = elapsedUs(&start);
+        if ((run == 0u) || (usec < usecGet))
+        {
+            usecGet = usec;
+        }
+
+        okRef = 0u;
+        vos_getTime(&start);
+        for (i = 0u; i < BENCH_READ_LOOPS; i++)
+        {
+            const UINT8 *pData;
+            UINT32      dataSize;
+            if (tlp_getRef(appHandle, sSubHandles[i % noOfComIds], NULL, &pData, &dataSize) == TRDP_NO_ERR)
+            {
+                sum += pData[dataSize - 1u];
+                okRef++;
+                (void) tlp_releaseRef(appHandle, sSubHandles[i % noOfComIds]);
+            }
+        }
+        usec = elapsedUs(&start);
+        if ((run == 0u) || (usec < usecRef))
+        {
+            usecRef = usec;
+        }
+    }
+    printf("Stack %-23s: %8u reads of %4u bytes, %8u valid, %10.0f reads/s\n",
+           "tlp_get", BENCH_READ_LOOPS, sDataSize, ok,
+           (usecGet > 0.0) ? (double) BENCH_READ_LOOPS * 1000000.0 / usecGet : 0.0);
+    printf("Stack %-23s: %8u reads of %4u bytes, %8u valid, %10.0f reads/s\n",
+           "tlp_getRef/tlp_releaseRef", BENCH_READ_LOOPS, sDataSize, okRef,
+           (usecRef > 0.0) ? (double) BENCH_READ_LOOPS * 1000000.0 / usecRef : 0.0);
+
+    /* keep the results alive */
+    if (sum == 0x12345678u)
+    {
+        printf("\n");
+    }
+}
+
+/* tlp_getRef() data must survive newer frames, misuse of tlp_getRef()/tlp_releaseRef() must be rejected */
+static int testGetRef (TRDP_APP_SESSION_T appHandle, SOCKET sndSock, UINT32 noOfComIds)
+{
+    const UINT8 *pData = NULL, *pOther = NULL;
+    UINT32      dataSize = 0u, otherSize = 0u;
+    UINT8       first;
+    int         rc = 0;
+
+    if (tlp_getRef(appHandle, sSubHandles[0], NULL, &pData, &dataSize) != TRDP_NO_ERR)
+    {
+        printf("GetRef: tlp_getRef() failed\n");
+        return 1;
+    }
+    first = pData[0];
+
+    /* the next call receives the burst into other buffers */
+    prepareBurst(noOfComIds);
+    sendBurst(sndSock, TRDP_PD_UDP_PORT);
+    if (tlp_getRef(appHandle, sSubHandles[0], NULL, &pOther, &otherSize) != TRDP_INUSE_ERR)
+    {
+        printf("GetRef: second tlp_getRef() not rejected\n");
+        rc = 1;
+    }
+    if ((pData[0] != first) || (pData[dataSize - 1u] != first))
+    {
+        printf("GetRef: lent data overwritten by the receiver\n");
+        rc = 1;
+    }
+    if ((tlp_releaseRef(appHandle, sSubHandles[0]) != TRDP_NO_ERR) ||
+        (tlp_releaseRef(appHandle, sSubHandles[0]) != TRDP_STATE_ERR))
+    {
+        printf("GetRef: tlp_releaseRef() failed or released twice\n");
+        rc = 1;
+    }
+    if ((tlp_getRef(appHandle, sSubHandles[0], NULL, &pOther, &otherSize) != TRDP_NO_ERR) ||
+        (pOther[0] == first))
+    {
+        printf("GetRef: newer data not returned after tlp_releaseRef()\n");
+        rc = 1;
+    }
+    else
+    {
+        (void) tlp_releaseRef(appHandle, sSubHandles[0]);
+    }
+    return rc;
+}
+
+/* Number of memory blocks in use */
+static UINT32 memBlocksUsed (void)
+{
+    UINT32  allocated, free, minFree, numAllocBlocks = 0u, numAllocErr, numFreeErr;
+    UINT32  blockSize[VOS_MEM_NBLOCKSIZES], usedBlockSize[VOS_MEM_NBLOCKSIZES];
+
+    (void) vos_memCount(&allocated, &free, &minFree, &numAllocBlocks, &numAllocErr, &numFreeErr,
+                        blockSize, usedBlockSize);
+    return numAllocBlocks;
+}
+
+/* Stack level: subscribe on loopback and drain with tlc_process() (tlp_processReceive() for HIGH_PERF_INDEXED) or
+   tlc_processEvents(), optionally with a session arena, frames carry dataSize bytes */
+static int benchStack (UINT32 noOfFrames, UINT32 noOfComIds, UINT32 dataSize, BOOL8 withArena, BOOL8 withEvents)
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_PD_CONFIG_T        pdConfig = {NULL, NULL, TRDP_PD_DEFAULT_SEND_PARAM, TRDP_FLAGS_NONE, 10000000u,
+                                        TRDP_TO_SET_TO_ZERO, TRDP_PD_UDP_PORT};
+    TRDP_PROCESS_CONFIG_T   procConfig = {"PdBench", "", 0u, 0u, TRDP_OPTION_NONE};
+    VOS_SOCK_OPT_T          opts;
+    SOCKET                  sndSock;
+    TRDP_ARENA_CONFIG_T     arenaConfig = {NULL, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u};
+    UINT32                  i, sent = 0u, memBlocks;
+    double                  usec = 0.0;
+    int                     rc = 0;
+
+    sDataSize = dataSize;
+    if (tlc_openSession(&appHandle, BENCH_LOOPBACK, 0u, NULL, &pdConfig, NULL, &procConfig) != TRDP_NO_ERR)
+    {
+        printf("Stack: tlc_openSession() failed\n");
+        return 1;
+    }
+    if (withArena == TRUE)
+    {
+        /* one frame per subscription plus one spare for tlp_getRef */
+        arenaConfig.maxNoOfSubscribers  = noOfComIds;
+        arenaConfig.maxNoOfSubFrames    = 2u * noOfComIds;
+        arenaConfig.maxNoOfSeqCntLists  = noOfComIds;
+        /* too big for the largest block of the memory pool, supply it */
+        arenaConfig.size                = tlc_arenaSize(&arenaConfig);
+        arenaConfig.p                   = (UINT8 *) malloc(arenaConfig.size);
+        if ((arenaConfig.p == NULL) || (tlc_presetArenaSession(appHandle, &arenaConfig) != TRDP_NO_ERR))
+        {
+            printf("Stack: tlc_presetArenaSession() failed\n");
+            (void) tlc_closeSession(appHandle);
+            free(arenaConfig.p);
+            return 1;
+        }
+        printf("Stack arena of %u bytes\n", arenaConfig.size);
+    }
+
+    for (i = 0u; i < noOfComIds; i++)
+    {
+        if (tlp_subscribe(appHandle, &sSubHandles[i], NULL, NULL, 0u, BENCH_COMID_BASE + i, 0u, 0u,
+                          VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_NONE, NULL,
+                          10000000u, TRDP_TO_DEFAULT) != TRDP_NO_ERR)
+        {
+            printf("Stack: tlp_subscribe() failed\n");
+            (void) tlc_closeSession(appHandle);
+            free(arenaConfig.p);
+            return 1;
+        }
+    }
+    (void) tlc_updateSession(appHandle);
+
+    memset(&opts, 0, sizeof(opts));
+    if (vos_sockOpenUDP(&sndSock, &opts) != VOS_NO_ERR)
+    {
+        (void) tlc_closeSession(appHandle);
+        free(arenaConfig.p);
+        return 1;
+    }
+    memBlocks = memBlocksUsed();
+
+    while (sent < noOfFrames)
+    {
+        VOS_TIMEVAL_T   start;
+        TRDP_FDS_T      rfds;
+        TRDP_TIME_T     tv = {0, 0};
+        INT32           noDesc = 0;
+        INT32           rv;
+
+        prepareBurst(noOfComIds);
+        sendBurst(sndSock, TRDP_PD_UDP_PORT);
+        sent += BENCH_BURST;
+
+        vos_getTime(&start);
+        if (withEvents == TRUE)
+        {
+            TRDP_ERR_T err = tlc_processEvents(appHandle, &tv);
+
+            if ((err == TRDP_NOINIT_ERR) || (err == TRDP_SOCK_ERR))
+            {
+                printf("Stack %-23s: not supported by this build/target\n", "tlc_processEvents");
+                (void) vos_sockClose(sndSock);
+                (void) tlc_closeSession(appHandle);
+                return 0;
+            }
+        }
+        else
+        {
+            FD_ZERO(&rfds);
+#ifdef HIGH_PERF_INDEXED
+            /* tlc_process() is not available, receive only: nothing is published */
+            (void) tlp_getInterval(appHandle, &tv, &rfds, &noDesc);
+            tv.tv_sec   = 0;
+            tv.tv_usec  = 0;
+            rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+            (void) tlp_processReceive(appHandle, &rfds, &rv);
+#else
+            (void) tlc_getInterval(appHandle, &tv, &rfds, &noDesc);
+            tv.tv_sec   = 0;
+            tv.tv_usec  = 0;
+            rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+            (void) tlc_process(appHandle, &rfds, &rv);
+#endif
+        }
+        usec += elapsedUs(&start);
+    }
+
+    printf("Stack %-23s: %8u frames, %8u rcvd, %10.0f frames/s\n",
+           (withEvents == TRUE) ? "tlc_processEvents" : STACK_PROCESS, sent, appHandle->stats.pd.numRcv,
+           (usec > 0.0) ? (double) appHandle->stats.pd.numRcv * 1000000.0 / usec : 0.0);
+
+    /* the burst is on the loopback before the call, nothing may be left behind */
+    if ((withEvents == TRUE) && (appHandle->stats.pd.numRcv != sent))
+    {
+        rc = 1;
+    }
+
+    benchRead(appHandle, noOfComIds);
+    rc |= testGetRef(appHandle, sndSock, noOfComIds);
+
+    memBlocks = memBlocksUsed() - memBlocks;
+    printf("Stack %-23s: %8u memory blocks allocated during the run\n",
+           (withArena == TRUE) ? "with arena" : "without arena", memBlocks);
+    if (withArena == TRUE)
+    {
+        for (i = 0u; i < TRDP_ARENA_SLABS; i++)
+        {
+            printf("Stack arena slab %u %13s: %8u of %8u used, %8u overflows\n", i, "",
+                   appHandle->arena.slab[i].used, appHandle->arena.slab[i].noOfBlocks,
+                   appHandle->arena.slab[i].overflow);
+            if (appHandle->arena.slab[i].overflow != 0u)
+            {
+                rc = 1;
+            }
+        }
+        /* the steady state must not allocate */
+        if (memBlocks != 0u)
+        {
+            rc = 1;
+        }
+    }
+
+    (void) vos_sockClose(sndSock);
+    (void) tlc_closeSession(appHandle);
+    free(arenaConfig.p);
+    return rc;
+}
+
+#ifdef HIGH_PERF_INDEXED
+/* Stack level: publish cyclic PDs on the fastest slot and send them with tlp_processSend(), frame by frame or in
+   batches. Every frame sent must be counted once by its publisher and the session and arrive at the receiver. */
+static int benchStackSend (UINT32 noOfPubs, BOOL8 batched)
+{
+    static TRDP_PUB_T       pubHandles[BENCH_TX_PUBS];
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_PD_CONFIG_T        pdConfig = {NULL, NULL, TRDP_PD_DEFAULT_SEND_PARAM, TRDP_FLAGS_NONE, 10000000u,
+                                        TRDP_TO_SET_TO_ZERO, BENCH_TX_PORT};
+    TRDP_PROCESS_CONFIG_T   procConfig = {"PdBenchTx", "", BENCH_TX_CYCLE, 0u, TRDP_OPTION_NONE};
+    TRDP_IDX_TABLE_T        idxSizes = {1u, 0u, 0u, BENCH_TX_PUBS, BENCH_TX_PUBS, 0u, 0u, 0u, 0u, 0u};
+    VOS_SOCK_OPT_T          opts;
+    SOCKET                  rcvSock;
+    UINT8                   data[BENCH_DATA_SIZE];
+    UINT32                  i, received = 0u, calls = 0u, numRxTx = 0u;
+    double                  usec = 0.0;
+    int                     rc = 0;
+
+    memset(&opts, 0, sizeof(opts));
+    opts.nonBlocking    = TRUE;
+    opts.reuseAddrPort  = TRUE;
+    if ((vos_sockOpenUDP(&rcvSock, &opts) != VOS_NO_ERR) ||
+        (vos_sockBind(rcvSock, BENCH_TX_DEST, BENCH_TX_PORT) != VOS_NO_ERR))
+    {
+        printf("Stack send: opening the receiver failed\n");
+        return 1;
+    }
+    if (tlc_openSession(&appHandle, BENCH_LOOPBACK, 0u, NULL, &pdConfig, NULL, &procConfig) != TRDP_NO_ERR)
+    {
+        printf("Stack send: tlc_openSession() failed\n");
+        (void) vos_sockClose(rcvSock);
+        return 1;
+    }
+    /* every publisher is due in every slot of the fastest table */
+    if (tlc_presetIndexSession(appHandle, &idxSizes) != TRDP_NO_ERR)
+    {
+        printf("Stack send: tlc_presetIndexSession() failed\n");
+        (void) tlc_closeSession(appHandle);
+        (void) vos_sockClose(rcvSock);
+        return 1;
+    }
+    appHandle->pdSendSingle = (batched == TRUE) ? FALSE : TRUE;
+
+    memset(data, 0x55, sizeof(data));
+    for (i = 0u; i < noOfPubs; i++)
+    {
+        if (tlp_publish(appHandle, &pubHandles[i], NULL, NULL, 0u, BENCH_COMID_BASE + i, 0u, 0u, 0u, BENCH_TX_DEST,
+                        BENCH_TX_CYCLE, 0u, TRDP_FLAGS_NONE, NULL, data, sizeof(data)) != TRDP_NO_ERR)
+        {
+            printf("Stack send: tlp_publish() failed\n");
+            (void) tlc_closeSession(appHandle);
+            (void) vos_sockClose(rcvSock);
+            return 1;
+        }
+    }
+    if (tlc_updateSession(appHandle) != TRDP_NO_ERR)
+    {
+        printf("Stack send: tlc_updateSession() failed\n");
+        (void) tlc_closeSession(appHandle);
+        (void) vos_sockClose(rcvSock);
+        return 1;
+    }
+
+    for (i = 0u; i < BENCH_TX_CYCLES; i++)
+    {
+        VOS_TIMEVAL_T start;
+
+        vos_getTime(&start);
+        (void) tlp_processSend(appHandle);
+        usec += elapsedUs(&start);
+        received += drain(rcvSock, TRUE, &calls);
+    }
+    for (i = 0u; i < noOfPubs; i++)
+    {
+        numRxTx += pubHandles[i]->numRxTx;
+    }
+
+    printf("Stack %-23s: %8u frames, %8u rcvd, %10.0f frames/s\n",
+           (batched == TRUE) ? "tlp_processSend batched" : "tlp_processSend single",
+           appHandle->stats.pd.numSend, received,
+           (usec > 0.0) ? (double) appHandle->stats.pd.numSend * 1000000.0 / usec : 0.0);
+
+    /* every publisher is due in every 1ms cycle */
+    if ((appHandle->stats.pd.numSend != noOfPubs * BENCH_TX_CYCLES) ||
+        (numRxTx != appHandle->stats.pd.numSend) || (received != appHandle->stats.pd.numSend))
+    {
+        printf("Stack send: %u sent by the publishers, %u by the session, %u received, %u expected\n",
+               numRxTx, appHandle->stats.pd.numSend, received, noOfPubs * BENCH_TX_CYCLES);
+        rc = 1;
+    }
+
+    (void) tlc_closeSession(appHandle);
+    (void) vos_sockClose(rcvSock);
+    return rc;
+}
+#endif
+
+/* Marshaller of the publication which may not be written in place, copies only */
+static TRDP_ERR_T copyMarshall (void *pRefCon, UINT32 comId, UINT8 *pSrc, UINT32 srcSize, UINT8 *pDst,
+                                UINT32 *pDstSize, TRDP_DATASET_T * *ppCachedDS)
+{
+    if (srcSize > *pDstSize)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    memcpy(pDst, pSrc, srcSize);
+    *pDstSize = srcSize;
+    return TRDP_NO_ERR;
+}
+
+/* Process one interval of the cyclic publication, it is sent once */
+static void sendCycle (TRDP_APP_SESSION_T appHandle)
+{
+#ifdef HIGH_PERF_INDEXED
+    UINT32 i;
+
+    for (i = 0u; i < BENCH_PUT_CYCLE / BENCH_TX_CYCLE; i++)
+    {
+        (void) tlp_processSend(appHandle);
+    }
+#else
+    TRDP_FDS_T  rfds;
+    INT32       noDesc = 0;
+
+    vos_threadDelay(BENCH_PUT_CYCLE);
+    FD_ZERO(&rfds);
+    (void) tlc_process(appHandle, &rfds, &noDesc);
+#endif
+}
+
+/* Read all frames from the receiver, returns the number of frames of comId, the last one in pFrame */
+static UINT32 receiveFrames (SOCKET sock, UINT32 comId, PD_PACKET_T *pFrame)
+{
+    static PD_PACKET_T  frame;
+    UINT32              count = 0u;
+
+    for (;;)
+    {
+        UINT32  size = sizeof(frame);
+        UINT32  srcIP, dstIP;
+
+        if (vos_sockReceiveUDP(sock, (UINT8 *) &frame, &size, &srcIP, NULL, &dstIP, FALSE) != VOS_NO_ERR)
+        {
+            break;
+        }
+        if (vos_ntohl(frame.frameHead.comId) == comId)
+        {
+            memcpy(pFrame, &frame, size);
+            count++;
+        }
+    }
+    return count;
+}
+
+/* Stack level: tlp_putBegin()/tlp_putCommit() semantics, allocations and cost against tlp_put() */
+static int testPutCommit (void)
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_MARSHALL_CONFIG_T  marshall = {copyMarshall, NULL, NULL};
+    TRDP_PD_CONFIG_T        pdConfig = {NULL, NULL, TRDP_PD_DEFAULT_SEND_PARAM, TRDP_FLAGS_NONE, 10000000u,
+                                        TRDP_TO_SET_TO_ZERO, BENCH_TX_PORT};
+    TRDP_PROCESS_CONFIG_T   procConfig = {"PdBenchPut", "", BENCH_TX_CYCLE, 0u, TRDP_OPTION_NONE};
+    TRDP_PUB_T              pubHandle, putHandle, beginHandle, marshallHandle;
+    VOS_SOCK_OPT_T          opts;
+    SOCKET                  rcvSock;
+    static PD_PACKET_T      frame;
+    static UINT8            data[TRDP_MAX_PD_DATA_SIZE];
+    UINT8                   *pBuf = NULL;
+    UINT32                  i, run, maxSize = 0u, memBlocks;
+    double                  usecPut = 0.0, usecCommit = 0.0, usec;
+    VOS_TIMEVAL_T           start;
+    int                     rc = 0;
+
+    memset(&opts, 0, sizeof(opts));
+    opts.nonBlocking    = TRUE;
+    opts.reuseAddrPort  = TRUE;
+    if ((vos_sockOpenUDP(&rcvSock, &opts) != VOS_NO_ERR) ||
+        (vos_sockBind(rcvSock, BENCH_TX_DEST, BENCH_TX_PORT) != VOS_NO_ERR))
+    {
+        printf("Put: opening the receiver failed\n");
+        return 1;
+    }
+    if (tlc_openSession(&appHandle, BENCH_LOOPBACK, 0u, &marshall, &pdConfig, NULL, &procConfig) != TRDP_NO_ERR)
+    {
+        printf("Put: tlc_openSession() failed\n");
+        (void) vos_sockClose(rcvSock);
+        return 1;
+    }
+
+    /* one cyclic publication, the others are only written to */
+    memset(data, 0x11, sizeof(data));
+    if ((tlp_publish(appHandle, &pubHandle, NULL, NULL, 0u, BENCH_PUT_COMID, 0u, 0u, 0u, BENCH_TX_DEST,
+                     BENCH_PUT_CYCLE, 0u, TRDP_FLAGS_NONE, NULL, data, BENCH_DATA_SIZE) != TRDP_NO_ERR) ||
+        (tlp_publish(appHandle, &putHandle, NULL, NULL, 0u, BENCH_PUT_COMID + 1u, 0u, 0u, 0u, BENCH_TX_DEST,
+                     0u, 0u, TRDP_FLAGS_NONE, NULL, data, TRDP_MAX_PD_DATA_SIZE) != TRDP_NO_ERR) ||
+        (tlp_publish(appHandle, &beginHandle, NULL, NULL, 0u, BENCH_PUT_COMID + 2u, 0u, 0u, 0u, BENCH_TX_DEST,
+                     0u, 0u, TRDP_FLAGS_NONE, NULL, data, TRDP_MAX_PD_DATA_SIZE) != TRDP_NO_ERR) ||
+        (tlp_publish(appHandle, &marshallHandle, NULL, NULL, 0u, BENCH_PUT_COMID + 3u, 0u, 0u, 0u, BENCH_TX_DEST,
+                     0u, 0u, TRDP_FLAGS_MARSHALL, NULL, data, BENCH_DATA_SIZE) != TRDP_NO_ERR) ||
+        (tlc_updateSession(appHandle) != TRDP_NO_ERR))
+    {
+        printf("Put: tlp_publish() failed\n");
+        (void) tlc_closeSession(appHandle);
+        (void) vos_sockClose(rcvSock);
+        return 1;
+    }
+
+    /* the previous data is sent until the commit */
+    if ((tlp_putBegin(appHandle, pubHandle, &pBuf, &maxSize) != TRDP_NO_ERR) || (maxSize != TRDP_MAX_PD_DATA_SIZE))
+    {
+        printf("Put: tlp_putBegin() failed\n");
+        rc = 1;
+    }
+    else
+    {
+        memset(pBuf, 0x22, 2u * BENCH_DATA_SIZE);
+        sendCycle(appHandle);
+        if ((receiveFrames(rcvSock, BENCH_PUT_COMID, &frame) == 0u) ||
+            (vos_ntohl(frame.frameHead.datasetLength) != BENCH_DATA_SIZE) || (frame.data[0] != 0x11u))
+        {
+            printf("Put: data was sent before tlp_putCommit()\n");
+            rc = 1;
+        }
+        /* one buffer at a time */
+        if (tlp_putBegin(appHandle, pubHandle, &pBuf, &maxSize) != TRDP_INUSE_ERR)
+        {
+            printf("Put: second tlp_putBegin() not rejected\n");
+            rc = 1;
+        }
+        /* too large, the buffer stays lent */
+        if (tlp_putCommit(appHandle, pubHandle, TRDP_MAX_PD_DATA_SIZE + 1u) != TRDP_PARAM_ERR)
+        {
+            printf("Put: oversized tlp_putCommit() not rejected\n");
+            rc = 1;
+        }
+        /* the new size is taken over */
+        if (tlp_putCommit(appHandle, pubHandle, 2u * BENCH_DATA_SIZE) != TRDP_NO_ERR)
+        {
+            printf("Put: tlp_putCommit() failed\n");
+            rc = 1;
+        }
+        sendCycle(appHandle);
+        if ((receiveFrames(rcvSock, BENCH_PUT_COMID, &frame) == 0u) ||
+            (vos_ntohl(frame.frameHead.datasetLength) != 2u * BENCH_DATA_SIZE) ||
+            (frame.data[0] != 0x22u) || (frame.data[2u * BENCH_DATA_SIZE - 1u] != 0x22u))
+        {
+            printf("Put: committed data or size not sent\n");
+            rc = 1;
+        }
+    }
+    if (tlp_putCommit(appHandle, pubHandle, BENCH_DATA_SIZE) != TRDP_STATE_ERR)
+    {
+        printf("Put: tlp_putCommit() without tlp_putBegin() not rejected\n");
+        rc = 1;
+    }
+
+    /* data which is marshalled or sent by TSN can not be written in place */
+    if (tlp_putBegin(appHandle, marshallHandle, &pBuf, &maxSize) != TRDP_PARAM_ERR)
+    {
+        printf("Put: tlp_putBegin() on a marshalled publication not rejected\n");
+        rc = 1;
+    }
+    ((PD_ELE_T *) beginHandle)->privFlags |= TRDP_IS_TSN;
+    if (tlp_putBegin(appHandle, beginHandle, &pBuf, &maxSize) != TRDP_PARAM_ERR)
+    {
+        printf("Put: tlp_putBegin() on a TSN publication not rejected\n");
+        rc = 1;
+    }
+    ((PD_ELE_T *) beginHandle)->privFlags &= ~(TRDP_PRIV_FLAGS_T)TRDP_IS_TSN;
+
+    /* the first two updates allocate the two maximum size frames, the following ones must not allocate */
+    (void) tlp_put(appHandle, putHandle, data, TRDP_MAX_PD_DATA_SIZE);
+    for (i = 0u; i < 2u; i++)
+    {
+        if ((tlp_putBegin(appHandle, beginHandle, &pBuf, &maxSize) != TRDP_NO_ERR) ||
+            (tlp_putCommit(appHandle, beginHandle, TRDP_MAX_PD_DATA_SIZE) != TRDP_NO_ERR))
+        {
+            printf("Put: tlp_putBegin()/tlp_putCommit() failed\n");
+            rc = 1;
+        }
+    }
+    memBlocks = memBlocksUsed();
+
+    for (run = 0u; run < BENCH_RUNS; run++)
+    {
+        vos_getTime(&start);
+        for (i = 0u; i < BENCH_PUT_LOOPS; i++)
+        {
+            memset(data, (int) i, TRDP_MAX_PD_DATA_SIZE);
+            (void) tlp_put(appHandle, putHandle, data, TRDP_MAX_PD_DATA_SIZE);
+        }
+        usec = elapsedUs(&start);
+        if ((run == 0u) || (usec < usecPut))
+        {
+            usecPut = usec;
+        }
+
+        vos_getTime(&start);
+        for (i = 0u; i < BENCH_PUT_LOOPS; i++)
+        {
+            if (tlp_putBegin(appHandle, beginHandle, &pBuf, &maxSize) == TRDP_NO_ERR)
+            {
+                memset(pBuf, (int) i, TRDP_MAX_PD_DATA_SIZE);
+                (void) tlp_putCommit(appHandle, beginHandle, TRDP_MAX_PD_DATA_SIZE);
+            }
+        }
+        usec = elapsedUs(&start);
+        if ((run == 0u) || (usec < usecCommit))
+        {
+            usecCommit = usec;
+        }
+    }
+
+    memBlocks = memBlocksUsed() - memBlocks;
+    printf("Stack %-23s: %8u updates of %u bytes, %7.1f ns per update\n",
+           "tlp_put", BENCH_PUT_LOOPS, TRDP_MAX_PD_DATA_SIZE, usecPut * 1000.0 / BENCH_PUT_LOOPS);
+    printf("Stack %-23s: %8u updates of %u bytes, %7.1f ns per update, %u memory blocks allocated\n",
+           "tlp_putBegin/tlp_putCommit", BENCH_PUT_LOOPS, TRDP_MAX_PD_DATA_SIZE,
+           usecCommit * 1000.0 / BENCH_PUT_LOOPS, memBlocks);
+    if ((memBlocks != 0u) || (((PD_ELE_T *) beginHandle)->pFrame->data[0] != (UINT8) (BENCH_PUT_LOOPS - 1u)))
+    {
+        printf("Put: steady state allocated or lost data\n");
+        rc = 1;
+    }
+
+    (void) tlc_closeSession(appHandle);
+    (void) vos_sockClose(rcvSock);
+    return rc;
+}
+
+static void timeoutCallback (void *pRefCon, TRDP_APP_SESSION_T appHandle, const TRDP_PD_INFO_T *pMsg, UINT8 *pData,
+                             UINT32 dataSize)
+{
+    if ((pMsg->comId == BENCH_TO_COMID) && (pMsg->resultCode == TRDP_TIMEOUT_ERR))
+    {
+        *(UINT32 *) pMsg->pUserRef += 1u;
+    }
+}
+
+/* Stack level: tlc_processEvents() without any traffic must wake up for the time out of a subscription */
+static int testEventTimeout (void)
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_PD_CONFIG_T        pdConfig = {NULL, NULL, TRDP_PD_DEFAULT_SEND_PARAM, TRDP_FLAGS_CALLBACK, 10000000u,
+                                        TRDP_TO_SET_TO_ZERO, TRDP_PD_UDP_PORT};
+    TRDP_PROCESS_CONFIG_T   procConfig = {"PdBenchTo", "", 0u, 0u, TRDP_OPTION_NONE};
+    TRDP_SUB_T              subHandle;
+    VOS_TIMEVAL_T           start;
+    UINT32                  noOfTimeouts = 0u;
+    UINT32                  calls = 0u;
+    double                  usec;
+    TRDP_ERR_T              err = TRDP_NO_ERR;
+
+    if ((tlc_openSession(&appHandle, BENCH_LOOPBACK, 0u, NULL, &pdConfig, NULL, &procConfig) != TRDP_NO_ERR) ||
+        (tlp_subscribe(appHandle, &subHandle, &noOfTimeouts, timeoutCallback, 0u, BENCH_TO_COMID, 0u, 0u,
+                       VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL,
+                       BENCH_TO_TIMEOUT, TRDP_TO_DEFAULT) != TRDP_NO_ERR))
+    {
+        printf("Stack: opening the time out session failed\n");
+        return 1;
+    }
+    (void) tlc_updateSession(appHandle);
+
+    vos_getTime(&start);
+    while ((noOfTimeouts == 0u) && (elapsedUs(&start) < 1000000.0))
+    {
+        err = tlc_processEvents(appHandle, NULL);       /* as long as the stack needs */
+        if ((err == TRDP_NOINIT_ERR) || (err == TRDP_SOCK_ERR))
+        {
+            break;
+        }
+        calls++;
+    }
+    usec = elapsedUs(&start);
+    (void) tlc_closeSession(appHandle);
+
+    if ((err == TRDP_NOINIT_ERR) || (err == TRDP_SOCK_ERR))
+    {
+        return 0;
+    }
+    printf("Stack %-23s: %8u timeouts after %6.1f ms (%u us), %u calls\n",
+           "tlc_processEvents", noOfTimeouts, usec / 1000.0, BENCH_TO_TIMEOUT, calls);
+
+    /* no busy loop, no oversleeping up to the 1s default */
+    return ((noOfTimeouts == 1u) && (usec < (double) BENCH_TO_TIMEOUT * 3.0) && (calls < 20u)) ? 0 : 1;
+}
+
+/* Duplicate detection of one subscription: the frames of noOfSenders senders are checked, repeated frames have to
+   be found as duplicates. Only the first checks are timed, the duplicate path logs each hit. */
+static int benchSeqCnt (TRDP_APP_SESSION_T appHandle, UINT32 noOfSenders)
+{
+    PD_ELE_T        element;
+    VOS_TIMEVAL_T   start;
+    UINT32          round, sender;
+    UINT32          noOfRounds  = BENCH_SEQ_CHECKS / noOfSenders;
+    UINT32          noOfMissed  = 0u;
+    double          usec        = 0.0;
+
+    memset(&element, 0, sizeof(element));
+    element.addr.comId = BENCH_COMID_BASE;
+
+    for (round = 1u; round <= noOfRounds; round++)
+    {
+        vos_getTime(&start);
+        for (sender = 0u; sender < noOfSenders; sender++)
+        {
+            if (trdp_checkSequenceCounter(appHandle, &element, round, BENCH_SENDER_BASE + sender, TRDP_MSG_PD) != 0)
+            {
+                noOfMissed++;
+            }
+        }
+        usec += elapsedUs(&start);
+
+        /* every 16th round all frames again */
+        for (sender = 0u; ((round & 0xFu) == 1u) && (sender < noOfSenders); sender++)
+        {
+            if (trdp_checkSequenceCounter(appHandle, &element, round, BENCH_SENDER_BASE + sender, TRDP_MSG_PD) != 1)
+            {
+                noOfMissed++;
+            }
+        }
+    }
+
+    printf("SeqCnt %4u senders %16s: %8.1f ns per frame, %5u slots, %u missed\n", noOfSenders, "",
+           usec * 1000.0 / ((double) noOfRounds * (double) noOfSenders),
+           (element.pSeqCntList != NULL) ? element.pSeqCntList->maxNoOfEntries : 0u, noOfMissed);
+    if (element.pSeqCntList != NULL)
+    {
+        trdp_seqCntFree(appHandle, element.pSeqCntList);
+    }
+    return (noOfMissed == 0u) ? 0 : 1;
+}
+
+/* More senders than the table holds: the recent ones must be kept, the oldest ones are dropped and count as new */
+static int testSeqCntEvict (TRDP_APP_SESSION_T appHandle)
+{
+    PD_ELE_T    element;
+    UINT32      sender;
+    UINT32      noOfSenders = TRDP_SEQ_CNT_MAX_ARRAY_SIZE;  /* twice what fits */
+    UINT32      noOfKept    = 0u;
+    UINT32      noOfDropped = 0u;
+    UINT32      noOfEvicted = appHandle->stats.numSeqCntEvict;
+    TRDP_TIME_T start;
+    double      usec;
+    int         rc;
+
+    memset(&element, 0, sizeof(element));
+    element.addr.comId = BENCH_COMID_BASE;
+
+    vos_getTime(&start);
+    for (sender = 0u; sender < noOfSenders; sender++)
+    {
+        (void) trdp_checkSequenceCounter(appHandle, &element, 1u, BENCH_SENDER_BASE + sender, TRDP_MSG_PD);
+    }
+    /* newest first, a dropped sender would evict a kept one on its return */
+    for (sender = noOfSenders; sender > 0u; sender--)
+    {
+        if (trdp_checkSequenceCounter(appHandle, &element, 1u, BENCH_SENDER_BASE + sender - 1u, TRDP_MSG_PD) == 1)
+        {
+            noOfKept++;
+        }
+        else
+        {
+            noOfDropped++;
+        }
+    }
+    usec        = elapsedUs(&start);
+    noOfEvicted = appHandle->stats.numSeqCntEvict - noOfEvicted;
+    printf("SeqCnt %4u senders %16s: %8.1f ns per frame, %5u kept, %5u dropped, %5u slots, %5u evicted\n",
+           noOfSenders, "(table full)", usec * 1000.0 / (2.0 * (double) noOfSenders), noOfKept, noOfDropped,
+           (element.pSeqCntList != NULL) ? element.pSeqCntList->maxNoOfEntries : 0u, noOfEvicted);
+    /* every sender beyond the half full table took the slot of another one, in both rounds */
+    rc = ((noOfKept == TRDP_SEQ_CNT_MAX_ARRAY_SIZE / 2u) && (element.pSeqCntList != NULL) &&
+          (element.pSeqCntList->maxNoOfEntries == TRDP_SEQ_CNT_MAX_ARRAY_SIZE) &&
+          (noOfEvicted == noOfSenders) && (element.pSeqCntList->numEvicted == noOfEvicted)) ? 0 : 1;
+    if (element.pSeqCntList != NULL)
+    {
+        trdp_seqCntFree(appHandle, element.pSeqCntList);
+    }
+    return rc;
+}
+
+/* With an arena, the table of a subscription outgrowing the start size takes the reserved full size block */
+static int testSeqCntArena (TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_ARENA_CONFIG_T arenaConfig = {NULL, 0u, 0u, 0u, 0u, 0u, 1u, 1u, 0u};
+    PD_ELE_T            element;
+    TRDP_SLAB_T         *pFull;
+    UINT32              sender, memBlocks, noOfSlots;
+    UINT32              noOfSenders = TRDP_SEQ_CNT_START_ARRAY_SIZE;    /* twice what the start size holds */
+    int                 rc;
+
+    if (tlc_presetArenaSession(appHandle, &arenaConfig) != TRDP_NO_ERR)
+    {
+        printf("SeqCnt: tlc_presetArenaSession() failed\n");
+        return 1;
+    }
+    pFull = &appHandle->arena.slab[TRDP_ARENA_SEQ_CNT_FULL];
+
+    memset(&element, 0, sizeof(element));
+    element.addr.comId = BENCH_COMID_BASE;
+
+    memBlocks = memBlocksUsed();
+    for (sender = 0u; sender < noOfSenders; sender++)
+    {
+        (void) trdp_checkSequenceCounter(appHandle, &element, 1u, BENCH_SENDER_BASE + sender, TRDP_MSG_PD);
+    }
+    memBlocks = memBlocksUsed() - memBlocks;
+    noOfSlots = (element.pSeqCntList != NULL) ? element.pSeqCntList->maxNoOfEntries : 0u;
+    printf("SeqCnt %4u senders %16s: %5u slots, %u of %u full size lists, %u memory blocks allocated\n",
+           noOfSenders, "(arena)", noOfSlots, pFull->used, pFull->noOfBlocks, memBlocks);
+    rc = ((noOfSlots == TRDP_SEQ_CNT_MAX_ARRAY_SIZE) && (pFull->used == 1u) && (memBlocks == 0u)) ? 0 : 1;
+    if (element.pSeqCntList != NULL)
+    {
+        trdp_seqCntFree(appHandle, element.pSeqCntList);
+    }
+    /* back in its slab */
+    return ((rc == 0) && (pFull->used == 0u)) ? 0 : 1;
+}
+
+/* Sequence counter table of one subscription for 1 to BENCH_SENDERS senders */
+static int benchSeqCntAll (void)
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_PROCESS_CONFIG_T   procConfig = {"PdBenchSeq", "", 0u, 0u, TRDP_OPTION_NONE};
+    UINT32                  noOfSenders;
+    int                     rc = 0;
+
+    if (tlc_openSession(&appHandle, BENCH_LOOPBACK, 0u, NULL, NULL, NULL, &procConfig) != TRDP_NO_ERR)
+    {
+        printf("SeqCnt: tlc_openSession() failed\n");
+        return 1;
+    }
+    for (noOfSenders = 1u; noOfSenders <= BENCH_SENDERS; noOfSenders *= 4u)
+    {
+        rc |= benchSeqCnt(appHandle, noOfSenders);
+    }
+    rc |= testSeqCntEvict(appHandle);
+    rc |= testSeqCntArena(appHandle);
+    (void) tlc_closeSession(appHandle);
+    return rc;
+}
+
+/**********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+    TRDP_MEM_CONFIG_T   memConfig   = {NULL, BENCH_MEM_SIZE, {0}};
+    UINT32              noOfFrames  = 200000u;
+    UINT32              noOfComIds  = 64u;
+    int                 rc;
+
+    if (argc > 1)
+    {
+        noOfFrames = (UINT32) strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2)
+    {
+        noOfComIds = (UINT32) strtoul(argv[2], NULL, 10);
+    }
+    if ((noOfComIds == 0u) || (noOfComIds > BENCH_BURST))
+    {
+        printf("usage: %s [<frames> [<comIds 1..%u>]]\n", argv[0], BENCH_BURST);
+        return 1;
+    }
+
+    if (tlc_init(dbgOut, NULL, &memConfig) != TRDP_NO_ERR)
+    {
+        printf("tlc_init() failed\n");
+        return 1;
+    }
+
+    printf("PD benchmark, %u frames in bursts of %u, batch size %u\n",
+           noOfFrames, BENCH_BURST, VOS_MAX_SOCK_BATCH);
+    benchVOS(noOfFrames);
+    benchVOSSend(noOfFrames);
+    rc  = benchVOSPoll();
+    rc  |= benchStack(noOfFrames, noOfComIds, BENCH_DATA_SIZE, FALSE, FALSE);
+    rc  |= benchStack(noOfFrames, noOfComIds, BENCH_DATA_SIZE, TRUE, FALSE);
+    rc  |= benchStack(noOfFrames, noOfComIds, BENCH_DATA_SIZE, FALSE, TRUE);
+    rc  |= benchStack(noOfFrames, noOfComIds, TRDP_MAX_PD_DATA_SIZE, FALSE, FALSE);
+#ifdef HIGH_PERF_INDEXED
+    rc  |= benchStackSend(BENCH_TX_PUBS, FALSE);
+    rc  |= benchStackSend(BENCH_TX_PUBS, TRUE);
+#endif
+    rc  |= testPutCommit();
+    rc  |= testEventTimeout();
+    rc  |= benchSeqCntAll();
+
+    (void) tlc_terminate();
+    return rc;
+}
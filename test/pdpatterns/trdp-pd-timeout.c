@@ -0,0 +1,310 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-pd-timeout.c
+ *
+ * @brief           Test of the PD timeout detection latency with two sessions
+ *
+ * @details         Two sessions (127.0.0.1 and 127.0.0.2) publish telegrams with different cycle times to themselves
+ *                  and subscribe to them with a timeout of three cycles. Both sessions are processed by the same loop.
+ *                  After all publishers are removed, the time between the expected timeout (last reception plus
+ *                  timeout) and the reported timeout is measured for each subscription.
+ *                  Build with HIGH_PERF_INDEXED to check the indexed timeout supervision.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *      AG 2026-10-17: Created
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trdp_if_light.h"
+#include "vos_utils.h"
+#include "vos_thread.h"
+
+/* --- defines ----------------------------------------------------------------*/
+
+#define TO_NO_OF_SESSIONS   2u
+#define TO_NO_OF_TELEGRAMS  8u
+#define TO_COMID_BASE       30000u
+#define TO_DATA_SIZE        32u
+#define TO_LOOP_CYCLE       1000u           /* process cycle in us                      */
+#define TO_RUN_TIME         600000          /* time to run before publishers stop (us)  */
+#define TO_WAIT_TIME        2000000         /* max. time to wait for all timeouts (us)  */
+#define TO_MAX_LATENCY      10000           /* default max. accepted latency (us)       */
+#define TO_MEM_SIZE         (4u * 1024u * 1024u)
+
+/* --- types ------------------------------------------------------------------*/
+
+typedef struct
+{
+    TRDP_PUB_T      pubHandle;
+    TRDP_SUB_T      subHandle;
+    UINT32          timeout;                /* subscription timeout in us           */
+    VOS_TIMEVAL_T   lastRx;                 /* time of last valid reception         */
+    VOS_TIMEVAL_T   timedOut;               /* time the timeout was reported        */
+    UINT32          noOfRx;
+} TO_TELEGRAM_T;
+
+typedef struct
+{
+    TRDP_APP_SESSION_T  appHandle;
+    TRDP_IP_ADDR_T      ipAddr;
+    TO_TELEGRAM_T       tlg[TO_NO_OF_TELEGRAMS];
+} TO_SESSION_T;
+
+/* --- globals ----------------------------------------------------------------*/
+
+static TO_SESSION_T sSession[TO_NO_OF_SESSIONS];
+
+/* cycle times of the telegrams in us, subscriptions time out after three cycles */
+static const UINT32 cCycles[TO_NO_OF_TELEGRAMS] = {10000u, 10000u, 20000u, 20000u, 50000u, 50000u, 100000u, 200000u};
+
+/* --- local functions --------------------------------------------------------*/
+
+static void dbgOut (void *pRefCon, TRDP_LOG_T category, const CHAR8 *pTime, const CHAR8 *pFile, UINT16 lineNumber,
+                    const CHAR8 *pMsgStr)
+{
+    if (category == VOS_LOG_ERROR)
+    {
+        printf("%s %s:%u %s", pTime, pFile, (unsigned int) lineNumber, pMsgStr);
+    }
+}
+
+/* Record the time of each reception and of the first timeout */
+static void pdCallback (void *pRefCon, TRDP_APP_SESSION_T appHandle, const TRDP_PD_INFO_T *pMsg, UINT8 *pData,
+                        UINT32 dataSize)
+{
+    TO_TELEGRAM_T *pTlg = (TO_TELEGRAM_T *) pMsg->pUserRef;
+
+    if (pTlg == NULL)
+    {
+        return;
+    }
+    if (pMsg->resultCode == TRDP_NO_ERR)
+    {
+        vos_getTime(&pTlg->lastRx);
+        vos_clearTime(&pTlg->timedOut);
+        pTlg->noOfRx++;
+    }
+    else if ((pMsg->resultCode == TRDP_TIMEOUT_ERR) && !timerisset(&pTlg->timedOut))
+    {
+        vos_getTime(&pTlg->timedOut);
+    }
+}
+
+/* Process all sessions once, wait for input at most one loop cycle */
+static void processSessions (void)
+{
+    TRDP_FDS_T  rfds;
+    TRDP_TIME_T tv;
+    INT32       noDesc = 0;
+    INT32       rv;
+    UINT32      i;
+
+    FD_ZERO(&rfds);
+    for (i = 0u; i < TO_NO_OF_SESSIONS; i++)
+    {
+#ifdef HIGH_PERF_INDEXED
+        (void) tlp_processSend(sSession[i].appHandle);
+        (void) tlp_getInterval(sSession[i].appHandle, &tv, &rfds, &noDesc);
+#else
+        (void) tlc_getInterval(sSession[i].appHandle, &tv, &rfds, &noDesc);
+#endif
+    }
+    tv.tv_sec   = 0;
+    tv.tv_usec  = TO_LOOP_CYCLE;
+    rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+    for (i = 0u; i < TO_NO_OF_SESSIONS; i++)
+    {
+#ifdef HIGH_PERF_INDEXED
+        (void) tlp_processReceive(sSession[i].appHandle, &rfds, &rv);
+#else
+        (void) tlc_process(sSession[i].appHandle, &rfds, &rv);
+#endif
+    }
+}
+
+/* Process the sessions for some time, or until all subscriptions timed out */
+static void runFor (INT32 usec, BOOL8 untilTimedOut)
+{
+    VOS_TIMEVAL_T   end, now;
+    TRDP_TIME_T     duration = {0, 0};
+    UINT32          i, j;
+
+    duration.tv_sec     = usec / 1000000;
+    duration.tv_usec    = usec % 1000000;
+    vos_getTime(&end);
+    vos_addTime(&end, &duration);
+
+    do
+    {
+        processSessions();
+        if (untilTimedOut == TRUE)
+        {
+            BOOL8 allTimedOut = TRUE;
+
+            for (i = 0u; i < TO_NO_OF_SESSIONS; i++)
+            {
+                for (j = 0u; j < TO_NO_OF_TELEGRAMS; j++)
+                {
+                    if (!timerisset(&sSession[i].tlg[j].timedOut))
+                    {
+                        allTimedOut = FALSE;
+                    }
+                }
+            }
+            if (allTimedOut == TRUE)
+            {
+                break;
+            }
+        }
+        vos_getTime(&now);
+    }
+    while (timercmp(&now, &end, <));
+}
+
+static TRDP_ERR_T openSession (TO_SESSION_T *pSession, UINT32 sessionNo)
+{
+    TRDP_PD_CONFIG_T        pdConfig = {NULL, NULL, TRDP_PD_DEFAULT_SEND_PARAM, TRDP_FLAGS_CALLBACK, 1000000u,
+                                        TRDP_TO_SET_TO_ZERO, TRDP_PD_UDP_PORT};
+    TRDP_PROCESS_CONFIG_T   procConfig = {"PdTimeout", "", TO_LOOP_CYCLE, 0u, TRDP_OPTION_NONE};
+    UINT8                   data[TO_DATA_SIZE];
+    TRDP_ERR_T              err;
+    UINT32                  i;
+
+    memset(data, (int) sessionNo, sizeof(data));
+    err = tlc_openSession(&pSession->appHandle, pSession->ipAddr, 0u, NULL, &pdConfig, NULL, &procConfig);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+
+    for (i = 0u; (i < TO_NO_OF_TELEGRAMS) && (err == TRDP_NO_ERR); i++)
+    {
+        TO_TELEGRAM_T   *pTlg   = &pSession->tlg[i];
+        UINT32          comId   = TO_COMID_BASE + sessionNo * 100u + i;
+
+        pTlg->timeout = 3u * cCycles[i];
+        err = tlp_publish(pSession->appHandle, &pTlg->pubHandle, NULL, NULL, 0u, comId, 0u, 0u,
+                          pSession->ipAddr, pSession->ipAddr, cCycles[i], 0u, TRDP_FLAGS_NONE, NULL,
+                          data, TO_DATA_SIZE);
+        if (err == TRDP_NO_ERR)
+        {
+            err = tlp_subscribe(pSession->appHandle, &pTlg->subHandle, pTlg, pdCallback, 0u, comId, 0u, 0u,
+                                pSession->ipAddr, VOS_INADDR_ANY, VOS_INADDR_ANY,
+                                (TRDP_FLAGS_T) (TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB), NULL,
+                                pTlg->timeout, TRDP_TO_DEFAULT);
+        }
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        err = tlc_updateSession(pSession->appHandle);
+    }
+    return err;
+}
+
+/* Report the latencies of one session, returns the number of failed subscriptions */
+static UINT32 evaluate (const TO_SESSION_T *pSession, UINT32 sessionNo, INT32 maxLatency)
+{
+    UINT32  i, failed = 0u;
+    INT32   maxLat = 0;
+    double  sum = 0.0;
+
+    for (i = 0u; i < TO_NO_OF_TELEGRAMS; i++)
+    {
+        const TO_TELEGRAM_T *pTlg = &pSession->tlg[i];
+        VOS_TIMEVAL_T       expected = pTlg->lastRx;
+        TRDP_TIME_T         timeout;
+        INT32               latency;
+
+        timeout.tv_sec  = pTlg->timeout / 1000000u;
+        timeout.tv_usec = pTlg->timeout % 1000000u;
+        vos_addTime(&expected, &timeout);
+
+        if ((pTlg->noOfRx == 0u) || !timerisset(&pTlg->timedOut))
+        {
+            printf("Session %u, telegram %u: %s\n", sessionNo, i,
+                   (pTlg->noOfRx == 0u) ? "nothing received" : "timeout not reported");
+            failed++;
+            continue;
+        }
+        latency = (INT32) (pTlg->timedOut.tv_sec - expected.tv_sec) * 1000000 +
+                  (INT32) (pTlg->timedOut.tv_usec - expected.tv_usec);
+        if ((latency < -1000) || (latency > maxLatency))
+        {
+            printf("Session %u, telegram %u: timeout %u us reported with latency %d us\n",
+                   sessionNo, i, pTlg->timeout, latency);
+            failed++;
+        }
+        if (latency > maxLat)
+        {
+            maxLat = latency;
+        }
+        sum += (double) latency;
+    }
+    printf("Session %u: %u subscriptions, timeout latency avg %.0f us, max %d us\n",
+           sessionNo, TO_NO_OF_TELEGRAMS, sum / TO_NO_OF_TELEGRAMS, maxLat);
+    return failed;
+}
+
+/**********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+    TRDP_MEM_CONFIG_T   memConfig   = {NULL, TO_MEM_SIZE, {0}};
+    INT32               maxLatency  = TO_MAX_LATENCY;
+    UINT32              i, j, failed = 0u;
+
+    if (argc > 1)
+    {
+        maxLatency = (INT32) strtol(argv[1], NULL, 10);
+    }
+
+    if (tlc_init(dbgOut, NULL, &memConfig) != TRDP_NO_ERR)
+    {
+        printf("tlc_init() failed\n");
+        return 1;
+    }
+
+    memset(sSession, 0, sizeof(sSession));
+    for (i = 0u; i < TO_NO_OF_SESSIONS; i++)
+    {
+        sSession[i].ipAddr = 0x7F000001u + i;
+        if (openSession(&sSession[i], i) != TRDP_NO_ERR)
+        {
+            printf("Setting up session %u failed\n", i);
+            (void) tlc_terminate();
+            return 1;
+        }
+    }
+
+    /* let the telegrams flow, then stop all publishers at once */
+    runFor(TO_RUN_TIME, FALSE);
+    for (i = 0u; i < TO_NO_OF_SESSIONS; i++)
+    {
+        for (j = 0u; j < TO_NO_OF_TELEGRAMS; j++)
+        {
+            (void) tlp_unpublish(sSession[i].appHandle, sSession[i].tlg[j].pubHandle);
+        }
+    }
+    runFor(TO_WAIT_TIME, TRUE);
+
+    for (i = 0u; i < TO_NO_OF_SESSIONS; i++)
+    {
+        failed += evaluate(&sSession[i], i, maxLatency);
+        (void) tlc_closeSession(sSession[i].appHandle);
+    }
+    (void) tlc_terminate();
+
+    printf("Timeout detection %s (max. accepted latency %d us)\n", (failed == 0u) ? "OK" : "FAILED", maxLatency);
+    return (failed == 0u) ? 0 : 1;
+}